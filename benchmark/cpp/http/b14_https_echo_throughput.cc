@@ -1,7 +1,11 @@
 /**
  * @file b14_https.cc
  * @brief HTTPS 服务器压测程序（纯净版）
- * @details 提供 keep-alive 的 200 OK 文本响应，用于与 Go/Rust HTTPS 服务横向对比
+ * @details 提供 keep-alive 的 200 OK 文本响应，用于与 Go/Rust HTTPS 服务横向对比。
+ *          第 5 个参数为 ktls 时尝试把记录加解密交给内核 TLS，用于对比 kTLS 开关的吞吐
+ *
+ * 使用方法:
+ *   ./benchmark_http_https_echo_throughput [port] [io_threads] [cert] [key] [ktls|user]
  */
 
 #include <galay/cpp/galay-http/server/http_server.h>
@@ -61,6 +65,7 @@ int main(int argc, char* argv[]) {
     int io_threads = 4;
     std::string cert_path = "cert/test.crt";
     std::string key_path = "cert/test.key";
+    bool ktls = false;
 
     if (argc > 1) {
         port = static_cast<uint16_t>(std::atoi(argv[1]));
@@ -74,6 +79,9 @@ int main(int argc, char* argv[]) {
     if (argc > 4) {
         key_path = argv[4];
     }
+    if (argc > 5) {
+        ktls = std::string_view(argv[5]) == "ktls";
+    }
 
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
@@ -85,6 +93,7 @@ int main(int argc, char* argv[]) {
     std::cout << "IO Threads: " << io_threads << "\n";
     std::cout << "Cert: " << cert_path << "\n";
     std::cout << "Key:  " << key_path << "\n";
+    std::cout << "kTLS: " << (ktls ? "on" : "off") << "\n";
     std::cout << "Press Ctrl+C to stop\n";
     std::cout << "========================================\n\n";
 
@@ -94,6 +103,7 @@ int main(int argc, char* argv[]) {
             .port(port)
             .certPath(cert_path)
             .keyPath(key_path)
+            .ktls(ktls)
             .ioSchedulerCount(static_cast<size_t>(io_threads))
             .build());
 
@@ -7,16 +7,46 @@
  * 2. BM_ParseRareHeaders - 全部罕见 header（slow-path）
  * 3. BM_ParseMixedHeaders - 混合场景（常见 + 罕见）
  * 4. BM_HeaderLookup_Common - 常见 header 查询性能（O(1) vs O(log n)）
+ * 5. BM_ParseModeThroughput - Incremental / Vectorized / 零拷贝 View 三种模式的 GB/s
+ *    与每请求堆分配次数（替换全局 operator new 计数），View 按各扫描内核分别输出
  */
 
 #include <galay/cpp/galay-http/protoc/http_header.h>
+#include <galay/cpp/galay-http/protoc/http_header_view.h>
+#include <galay/cpp/galay-http/protoc/http_scan.h>
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <new>
 #include <vector>
 #include <numeric>
 #include <algorithm>
 
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 using namespace galay::http;
 using namespace std::chrono;
 
@@ -286,6 +316,106 @@ void BM_ParseResponseHeaders() {
     printResult(result);
 }
 
+// Benchmark 8: 三种解析模式的吞吐与分配
+struct ModeSample {
+    const char* name;
+    std::string request;
+};
+
+template<typename Func>
+void reportModeThroughput(const std::string& label, const std::string& request, size_t iterations, Func&& func) {
+    for (size_t i = 0; i < iterations / 10; ++i) {
+        func();
+    }
+    const size_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+    const auto start = high_resolution_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    const double elapsed_ns = duration<double, std::nano>(high_resolution_clock::now() - start).count();
+    const size_t allocations = g_allocations.load(std::memory_order_relaxed) - allocations_before;
+
+    std::cout << std::left << std::setw(42) << label
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << elapsed_ns / iterations << " ns/req"
+              << std::setw(10) << std::setprecision(3)
+              << static_cast<double>(request.size()) * iterations / elapsed_ns << " GB/s"
+              << std::setw(10) << std::setprecision(2)
+              << static_cast<double>(allocations) / iterations << " allocs/req"
+              << std::endl;
+}
+
+void BM_ParseModeThroughput() {
+    const std::vector<ModeSample> samples = {
+        {"Mixed",
+         "GET /api/data?id=42 HTTP/1.1\r\n"
+         "Host: api.example.com\r\n"
+         "Content-Type: application/json\r\n"
+         "Content-Length: 256\r\n"
+         "Authorization: Bearer token123\r\n"
+         "X-Api-Key: secret\r\n"
+         "X-Request-Id: req-456\r\n"
+         "User-Agent: CustomClient/1.0\r\n"
+         "\r\n"},
+        {"Browser",
+         "GET /static/app.js?v=20240101 HTTP/1.1\r\n"
+         "Host: www.example.com\r\n"
+         "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+         "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+         "Accept-Language: en-US,en;q=0.9,zh-CN;q=0.8\r\n"
+         "Accept-Encoding: gzip, deflate, br\r\n"
+         "Referer: https://www.example.com/products/catalog?page=3&sort=price\r\n"
+         "Cookie: session=3f8e2a9c4b1d7e6f5a0b9c8d7e6f5a4b; theme=dark; locale=en_US; _ga=GA1.2.123456789.1700000000\r\n"
+         "Cache-Control: no-cache\r\n"
+         "Connection: keep-alive\r\n"
+         "Sec-Fetch-Dest: script\r\n"
+         "Sec-Fetch-Mode: no-cors\r\n"
+         "Sec-Fetch-Site: same-origin\r\n"
+         "\r\n"},
+    };
+    constexpr size_t kIterations = 200000;
+
+    for (const auto& sample : samples) {
+        const std::vector<iovec> iovecs = {
+            {const_cast<char*>(sample.request.data()), sample.request.size()},
+        };
+        std::cout << "  " << sample.name << " (" << sample.request.size() << " bytes)" << std::endl;
+
+        for (auto mode : {RequestHeaderParseMode::Incremental, RequestHeaderParseMode::Vectorized}) {
+            HttpRequestHeader header;
+            header.setParseMode(mode);
+            const std::string label = mode == RequestHeaderParseMode::Incremental
+                ? "    owning/incremental"
+                : "    owning/vectorized";
+            reportModeThroughput(label, sample.request, kIterations, [&]() {
+                header.reset();
+                auto [err, consumed] = header.fromIOVec(iovecs);
+                asm volatile("" : : "r,m"(err) : "memory");
+                asm volatile("" : : "r,m"(consumed) : "memory");
+            });
+        }
+
+        const auto original_kernel = detail::activeHeaderScanKernel();
+        for (auto kernel : {detail::HeaderScanKernel::Swar,
+                            detail::HeaderScanKernel::Sse42,
+                            detail::HeaderScanKernel::Avx2}) {
+            if (!detail::setHeaderScanKernel(kernel)) {
+                continue;
+            }
+            HttpRequestHeaderView view;
+            reportModeThroughput("    view/" + std::string(detail::headerScanKernelName(kernel)),
+                                 sample.request, kIterations, [&]() {
+                auto [err, consumed] = view.fromIOVec(iovecs);
+                auto host = view.find(CommonHeaderIndex::Host);
+                asm volatile("" : : "r,m"(err) : "memory");
+                asm volatile("" : : "r,m"(consumed) : "memory");
+                asm volatile("" : : "r,m"(host) : "memory");
+            });
+        }
+        detail::setHeaderScanKernel(original_kernel);
+    }
+}
+
 int main() {
     printHeader();
 
@@ -300,6 +430,9 @@ int main() {
     BM_HeaderLookup_Common();
     BM_HeaderLookup_Rare();
 
+    std::cout << "\n[Phase 3: Parse Mode Throughput - Owning vs Zero-copy View]\n" << std::endl;
+    BM_ParseModeThroughput();
+
     std::cout << "\n" << std::string(120, '=') << std::endl;
     std::cout << "Benchmark completed successfully!" << std::endl;
     std::cout << std::string(120, '=') << std::endl;
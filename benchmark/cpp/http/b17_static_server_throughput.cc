@@ -4,16 +4,20 @@
  * @details 与 b1 相同的服务器骨架，但 handler 每请求做真实 stat+open+read+close
  *          读取磁盘文件并回显，镜像 Apache httpd 静态文件服务的每请求工作量，
  *          用于 galay-static vs httpd-static 的公平对比（而非 b1 的内存固定响应）。
+ *          mode 为 mount / mount-cache 时改用 HttpRouter::mount 把文件所在目录挂到 /static，
+ *          mount-cache 额外打开 StaticFileCache，用于对比每请求读盘与缓存命中的开销。
  *
  * 使用方法:
- *   ./benchmark_http_static_server_throughput [port] [io_threads] [file_path]
+ *   ./benchmark_http_static_server_throughput [port] [io_threads] [file_path] [raw|mount|mount-cache]
  */
 
+#include <galay/cpp/galay-http/server/http_router.h>
 #include <galay/cpp/galay-http/server/http_server.h>
 #include <galay/cpp/galay-http/kernel/http_conn.h>
 #include <galay/cpp/galay-http/protoc/http_request.h>
 #include <iostream>
 #include <csignal>
+#include <filesystem>
 #include <string>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -95,6 +99,11 @@ int main(int argc, char* argv[]) {
     if (argc > 1) port = static_cast<uint16_t>(std::atoi(argv[1]));
     if (argc > 2) io_threads = std::atoi(argv[2]);
     if (argc > 3) g_file_path = argv[3];
+    const std::string mode = argc > 4 ? argv[4] : "raw";
+    if (mode != "raw" && mode != "mount" && mode != "mount-cache") {
+        std::cerr << "mode must be raw, mount or mount-cache\n";
+        return 1;
+    }
 
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
@@ -106,12 +115,26 @@ int main(int argc, char* argv[]) {
             .ioSchedulerCount(static_cast<size_t>(io_threads))
             .computeSchedulerCount(0)
             .build());
-        server.start(handleStaticRequest);
+        const std::filesystem::path file(g_file_path);
+        if (mode == "raw") {
+            server.start(handleStaticRequest);
+        } else {
+            StaticFileSetting setting;
+            setting.setTransferMode(FileTransferMode::MEMORY);
+            setting.setEnableCache(mode == "mount-cache");
+            HttpRouter router;
+            router.mount("/static", file.parent_path().string(), setting);
+            server.start(std::move(router));
+        }
 
         std::cout << "========================================\n"
                   << "HTTP Static-File Server Benchmark\n"
                   << "Port: " << port << "\nIO Threads: " << io_threads
-                  << "\nFile: " << g_file_path << "\n========================================\n";
+                  << "\nFile: " << g_file_path << "\nMode: " << mode;
+        if (mode != "raw") {
+            std::cout << "\nURL: /static/" << file.filename().string();
+        }
+        std::cout << "\n========================================\n";
 
         while (g_running) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
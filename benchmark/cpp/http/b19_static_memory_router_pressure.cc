@@ -3,9 +3,11 @@
  * @brief HTTP/1 静态文件 MEMORY 模式真实路由压测。
  * @details 启动 HttpRouter::mount(..., MEMORY) 服务端，用多客户端通过 loopback
  *          发起 GET 请求，覆盖 blocking executor 异步读文件路径和响应发送路径。
+ *          第四个参数为 cache 时启用 StaticFileCache，同一服务端连续跑两轮：
+ *          cold 轮包含首次读文件填充缓存，warm 轮全部命中缓存。
  *
  * 使用方法:
- *   ./benchmark_http_static_memory_router_pressure [requests] [concurrency] [file_kib]
+ *   ./benchmark_http_static_memory_router_pressure [requests] [concurrency] [file_kib] [nocache|cache]
  */
 
 #include <arpa/inet.h>
@@ -324,6 +326,79 @@ int64_t percentile(std::vector<int64_t>& values, double pct)
     return values[index];
 }
 
+struct PhaseResult
+{
+    size_t success = 0;
+    size_t failure = 0;
+    bool worker_start_failed = false;
+    double elapsed_sec = 0.0;
+    std::vector<int64_t> latencies;
+};
+
+PhaseResult runPhase(uint16_t port, size_t file_size, size_t total_requests, size_t concurrency)
+{
+    PhaseResult phase;
+    std::vector<ThreadResult> results(concurrency);
+    std::vector<std::thread> workers;
+    workers.reserve(concurrency);
+
+    const size_t base_requests = total_requests / concurrency;
+    const size_t extra_requests = total_requests % concurrency;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < concurrency; ++i) {
+        const size_t worker_requests = base_requests + (i < extra_requests ? 1 : 0);
+        const bool print_first_failure = i == 0;
+        auto& worker = workers.emplace_back([port, file_size, worker_requests, print_first_failure, &results, i]() {
+            results[i] = runWorker(port, file_size, worker_requests, print_first_failure);
+        });
+        if (!worker.joinable()) {
+            std::cerr << "worker thread is not joinable\n";
+            phase.worker_start_failed = true;
+            break;
+        }
+    }
+
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    const auto stop = std::chrono::steady_clock::now();
+
+    phase.latencies.reserve(total_requests);
+    for (ThreadResult& result : results) {
+        phase.success += result.success;
+        phase.failure += result.failure;
+        for (int64_t latency : result.latencies_us) {
+            phase.latencies.push_back(latency);
+        }
+    }
+    const auto elapsed_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+    phase.elapsed_sec = static_cast<double>(elapsed_us) / 1'000'000.0;
+    return phase;
+}
+
+void printPhase(std::string_view name, PhaseResult& phase, size_t file_size)
+{
+    const double elapsed_sec = phase.elapsed_sec;
+    const double rps = elapsed_sec > 0.0 ? static_cast<double>(phase.success) / elapsed_sec : 0.0;
+    const double mib = static_cast<double>(phase.success * file_size) / (1024.0 * 1024.0);
+    const double mib_per_sec = elapsed_sec > 0.0 ? mib / elapsed_sec : 0.0;
+
+    const int64_t p50 = percentile(phase.latencies, 0.50);
+    const int64_t p99 = percentile(phase.latencies, 0.99);
+
+    std::cout << "  [" << name << "]\n"
+              << "    success: " << phase.success << "\n"
+              << "    failure: " << phase.failure << "\n"
+              << "    elapsed_sec: " << elapsed_sec << "\n"
+              << "    requests_per_sec: " << rps << "\n"
+              << "    throughput_mib_per_sec: " << mib_per_sec << "\n"
+              << "    p50_us: " << p50 << "\n"
+              << "    p99_us: " << p99 << "\n";
+}
+
 bool cleanupDirectory(const std::string& dir)
 {
     const std::string path = dir + "/payload.bin";
@@ -357,6 +432,15 @@ int main(int argc, char** argv)
     if (argc > 3) {
         file_kib = static_cast<size_t>(std::strtoull(argv[3], nullptr, 10));
     }
+    bool enable_cache = false;
+    if (argc > 4) {
+        const std::string_view mode = argv[4];
+        if (mode != "cache" && mode != "nocache") {
+            std::cerr << "cache mode must be cache or nocache\n";
+            return 1;
+        }
+        enable_cache = mode == "cache";
+    }
     if (total_requests == 0 || concurrency == 0 || file_kib == 0) {
         std::cerr << "requests, concurrency and file_kib must be positive\n";
         return 1;
@@ -383,9 +467,13 @@ int main(int argc, char** argv)
     StaticFileSetting setting;
     setting.setTransferMode(FileTransferMode::MEMORY);
     setting.setEnableETag(false);
+    setting.setEnableCache(enable_cache);
+    // 单分片容量须大于文件大小，文件才能进入缓存
+    setting.setMaxCacheSize(std::max(setting.getMaxCacheSize(), file_size * 2 * StaticFileCache::kShardCount));
 
     HttpRouter router;
     router.mount("/static", dir, setting);
+    const auto caches = router.staticFileCaches();
 
     const uint16_t port = reserveFreePort();
     if (port == 0) {
@@ -404,35 +492,22 @@ int main(int argc, char** argv)
         .build();
     server.start(std::move(router));
 
-    std::vector<ThreadResult> results(concurrency);
-    std::vector<std::thread> workers;
-    workers.reserve(concurrency);
-
-    const size_t base_requests = total_requests / concurrency;
-    const size_t extra_requests = total_requests % concurrency;
-    const auto start = std::chrono::steady_clock::now();
-    bool worker_start_failed = false;
-    for (size_t i = 0; i < concurrency; ++i) {
-        const size_t worker_requests = base_requests + (i < extra_requests ? 1 : 0);
-        const bool print_first_failure = i == 0;
-        auto& worker = workers.emplace_back([port, file_size, worker_requests, print_first_failure, &results, i]() {
-            results[i] = runWorker(port, file_size, worker_requests, print_first_failure);
-        });
-        if (!worker.joinable()) {
-            std::cerr << "worker thread is not joinable\n";
-            worker_start_failed = true;
-            break;
-        }
-    }
-
-    for (std::thread& worker : workers) {
-        if (worker.joinable()) {
-            worker.join();
-        }
+    // cache 模式下 cold 轮负责填充缓存，warm 轮测量纯命中路径；nocache 只跑一轮
+    std::vector<std::pair<std::string_view, PhaseResult>> phases;
+    phases.emplace_back(enable_cache ? "cold" : "run",
+                        runPhase(port, file_size, total_requests, concurrency));
+    if (enable_cache && !phases.back().second.worker_start_failed) {
+        phases.emplace_back("warm", runPhase(port, file_size, total_requests, concurrency));
     }
-    const auto stop = std::chrono::steady_clock::now();
+    const StaticFileCacheStats cache_stats = caches.empty() ? StaticFileCacheStats{} : caches.front()->stats();
 
     server.stop();
+    bool worker_start_failed = false;
+    size_t failure = 0;
+    for (const auto& [name, phase] : phases) {
+        worker_start_failed = worker_start_failed || phase.worker_start_failed;
+        failure += phase.failure;
+    }
     if (worker_start_failed) {
         const bool cleaned = cleanupDirectory(dir);
         if (!cleaned) {
@@ -447,39 +522,19 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    size_t success = 0;
-    size_t failure = 0;
-    std::vector<int64_t> latencies;
-    latencies.reserve(total_requests);
-    for (ThreadResult& result : results) {
-        success += result.success;
-        failure += result.failure;
-        for (int64_t latency : result.latencies_us) {
-            latencies.push_back(latency);
-        }
-    }
-
-    const auto elapsed_us =
-        std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
-    const double elapsed_sec = static_cast<double>(elapsed_us) / 1'000'000.0;
-    const double rps = elapsed_sec > 0.0 ? static_cast<double>(success) / elapsed_sec : 0.0;
-    const double mib = static_cast<double>(success * file_size) / (1024.0 * 1024.0);
-    const double mib_per_sec = elapsed_sec > 0.0 ? mib / elapsed_sec : 0.0;
-
-    const int64_t p50 = percentile(latencies, 0.50);
-    const int64_t p99 = percentile(latencies, 0.99);
-
     std::cout << "http static memory router pressure\n"
               << "  requests: " << total_requests << "\n"
               << "  concurrency: " << concurrency << "\n"
               << "  file_kib: " << file_kib << "\n"
-              << "  success: " << success << "\n"
-              << "  failure: " << failure << "\n"
-              << "  elapsed_sec: " << elapsed_sec << "\n"
-              << "  requests_per_sec: " << rps << "\n"
-              << "  throughput_mib_per_sec: " << mib_per_sec << "\n"
-              << "  p50_us: " << p50 << "\n"
-              << "  p99_us: " << p99 << "\n";
+              << "  cache: " << (enable_cache ? "on" : "off") << "\n";
+    for (auto& [name, phase] : phases) {
+        printPhase(name, phase, file_size);
+    }
+    if (enable_cache) {
+        std::cout << "  cache_hits: " << cache_stats.hits << "\n"
+                  << "  cache_misses: " << cache_stats.misses << "\n"
+                  << "  cache_insertions: " << cache_stats.insertions << "\n";
+    }
 
     return failure == 0 ? 0 : 1;
 }
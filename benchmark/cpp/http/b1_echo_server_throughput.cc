@@ -5,13 +5,15 @@
  *          移除所有统计功能，由客户端负责统计
  *
  * 使用方法:
- *   ./benchmark/b1_http [port] [io_threads]
+ *   ./benchmark/b1_http [port] [io_threads] [pipeline]
  *   默认端口: 8080
  *   默认线程数: 4
+ *   第三个参数为 "pipeline" 时开启流水线响应合并
  *
  * 压测命令:
  *   wrk -t4 -c100 -d30s --latency http://127.0.0.1:8080/
  *   wrk -t8 -c500 -d30s --latency http://127.0.0.1:8080/
+ *   wrk -t4 -c100 -d30s --latency -s pipeline.lua http://127.0.0.1:8080/   # 流水线模式
  */
 
 #include <galay/cpp/galay-http/server/http_server.h>
@@ -24,6 +26,7 @@ using namespace galay::http;
 using namespace galay::kernel;
 
 static volatile bool g_running = true;
+static bool g_pipeline = false;
 static constexpr std::string_view kPlainTextOkResponse =
     "HTTP/1.1 200 OK\r\n"
     "Content-Type: text/plain\r\n"
@@ -54,6 +57,10 @@ Task<void> handleHttpRequest(HttpConn conn) {
             if (read_result.value()) break;
         }
 
+        // 缓冲区中已有下一个完整请求时暂存本响应，由该批最后一个响应一起写出
+        if (g_pipeline) {
+            conn.pipelineBatch().setDeferring(conn.hasBufferedRequest());
+        }
         auto result = co_await writer.sendView(kPlainTextOkResponse);
         if (!result) {
             co_return;
@@ -75,16 +82,23 @@ int main(int argc, char* argv[]) {
     if (argc > 2) {
         io_threads = std::atoi(argv[2]);
     }
+    if (argc > 3) {
+        g_pipeline = std::string_view(argv[3]) == "pipeline";
+    }
 
     std::cout << "========================================\n";
     std::cout << "HTTP Server Benchmark\n";
     std::cout << "========================================\n";
     std::cout << "Port: " << port << "\n";
     std::cout << "IO Threads: " << io_threads << "\n";
+    std::cout << "Pipeline: " << (g_pipeline ? "on" : "off") << "\n";
     std::cout << "Endpoint: http://127.0.0.1:" << port << "/\n";
     std::cout << "\nBenchmark commands:\n";
     std::cout << "  wrk -t4 -c100 -d30s --latency http://127.0.0.1:" << port << "/\n";
     std::cout << "  wrk -t8 -c500 -d30s --latency http://127.0.0.1:" << port << "/\n";
+    if (g_pipeline) {
+        std::cout << "  wrk -t4 -c100 -d30s --latency -s pipeline.lua http://127.0.0.1:" << port << "/\n";
+    }
     std::cout << "\nPress Ctrl+C to stop\n";
     std::cout << "========================================\n\n";
 
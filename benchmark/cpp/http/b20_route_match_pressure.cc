@@ -4,21 +4,56 @@
  *
  * 使用方法:
  *   ./benchmark_http_route_match_pressure [iterations]
+ *
+ * 说明:
+ *   BM_RouteTable3k* 在 3000 条合成 REST 路由（精确路径、:param、*、**）上对比
+ *   Trie 查找与 freeze() 之后的压缩基数树，输出 ns/op 与每次匹配的堆分配次数
+ *   （替换全局 operator new 计数）。
  */
 
 #include <galay/cpp/galay-http/server/http_router.h>
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <new>
 #include <string>
 #include <utility>
+#include <vector>
+
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
 
 using namespace galay::http;
 
 namespace {
 
+constexpr size_t kSyntheticVersions = 3;
+constexpr size_t kSyntheticResources = 250;
+
 galay::kernel::Task<void> routeHandler(HttpConn& conn, HttpRequest request)
 {
     co_return;
@@ -44,6 +79,98 @@ HttpRouter makeRouter()
     return router;
 }
 
+// 3 个版本 x 250 个资源 x 4 种形态 = 3000 条路由，另加静态资源通配符
+HttpRouter makeSyntheticRouter()
+{
+    HttpRouter router;
+    for (size_t v = 1; v <= kSyntheticVersions; ++v) {
+        for (size_t r = 0; r < kSyntheticResources; ++r) {
+            const std::string base = "/api/v" + std::to_string(v) + "/res" + std::to_string(r);
+            router.addHandler<HttpMethod::GET, HttpMethod::POST>(base, routeHandler);
+            router.addHandler<HttpMethod::GET, HttpMethod::PUT, HttpMethod::DELETE>(base + "/:id",
+                                                                                   routeHandler);
+            router.addHandler<HttpMethod::GET>(base + "/:id/items/:itemId", routeHandler);
+            router.addHandler<HttpMethod::GET>(base + "/:id/meta", routeHandler);
+        }
+    }
+    router.addHandler<HttpMethod::GET>("/assets/*/bundle", routeHandler);
+    router.addHandler<HttpMethod::GET>("/static/**", routeHandler);
+    return router;
+}
+
+std::vector<std::string> makeSyntheticRequests()
+{
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < 1024; ++i) {
+        const size_t v = 1 + i % kSyntheticVersions;
+        const size_t r = (i * 37) % kSyntheticResources;
+        const std::string base = "/api/v" + std::to_string(v) + "/res" + std::to_string(r);
+        switch (i % 8) {
+        case 0: paths.push_back(base); break;
+        case 1: paths.push_back(base + "/" + std::to_string(100000 + i)); break;
+        case 2: paths.push_back(base + "/u" + std::to_string(i) + "/items/" + std::to_string(i * 7)); break;
+        case 3: paths.push_back(base + "/u" + std::to_string(i) + "/meta"); break;
+        case 4: paths.push_back("/static/js/chunk-" + std::to_string(i) + ".js"); break;
+        case 5: paths.push_back("/assets/theme" + std::to_string(i % 5) + "/bundle"); break;
+        case 6: paths.push_back(base + "/missing/route/x"); break;
+        default: paths.push_back(base + "/" + std::to_string(i) + "/"); break;
+        }
+    }
+    return paths;
+}
+
+template <typename Func>
+bool runTableBench(const char* name, const std::vector<std::string>& paths, size_t iterations, Func&& func)
+{
+    size_t checksum = 0;
+    const size_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        checksum += func(paths[i % paths.size()]);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const size_t allocations = g_allocations.load(std::memory_order_relaxed) - allocations_before;
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    if (!require(checksum != 0, "checksum should not be zero")) {
+        return false;
+    }
+    std::cout << std::left << std::setw(36) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << ns / static_cast<double>(iterations) << " ns/op"
+              << std::setw(10) << std::setprecision(2)
+              << static_cast<double>(allocations) / static_cast<double>(iterations) << " allocs/op"
+              << "  checksum=" << checksum << "\n";
+    return true;
+}
+
+bool runSyntheticTable(size_t iterations)
+{
+    HttpRouter router = makeSyntheticRouter();
+    const std::vector<std::string> paths = makeSyntheticRequests();
+    std::cout << "route table: " << router.size() << " entries (method x pattern), " << paths.size() << " request paths\n";
+
+    auto viaRouteMatch = [&](const std::string& path) {
+        auto match = router.findHandler(HttpMethod::GET, path);
+        return match.handler == nullptr ? size_t{1} : match.params.size() + 2;
+    };
+    RouteParams params;
+    auto viaInPlace = [&](const std::string& path) {
+        HttpRouteHandler* handler = router.findHandler(HttpMethod::GET, path, params);
+        return handler == nullptr ? size_t{1} : params.size() + 2;
+    };
+
+    if (!runTableBench("BM_RouteTable3kTrie", paths, iterations, viaRouteMatch)) {
+        return false;
+    }
+    if (!require(router.freeze(), "freeze should succeed")) {
+        return false;
+    }
+    if (!runTableBench("BM_RouteTable3kFrozen", paths, iterations, viaRouteMatch)) {
+        return false;
+    }
+    return runTableBench("BM_RouteTable3kFrozenInPlace", paths, iterations, viaInPlace);
+}
+
 template <typename Func>
 bool runBench(const char* name, size_t iterations, Func&& func)
 {
@@ -110,5 +237,9 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    if (!runSyntheticTable(iterations)) {
+        return 1;
+    }
+
     return 0;
 }
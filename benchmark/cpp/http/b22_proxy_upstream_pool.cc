@@ -0,0 +1,374 @@
+/**
+ * @file b22_proxy_upstream_pool.cc
+ * @brief HTTP/1 反向代理上游连接池压测。
+ * @details 启动若干个上游服务端与一个代理服务端，代理上挂两个前缀：
+ *          /pooled 使用默认 HttpProxyPolicy（每个上游保留空闲 keep-alive 连接），
+ *          /nopool 挂载前把 max_idle_connections_per_upstream 设为 0，每个请求新建上游连接。
+ *          两个前缀都按轮询分摊到全部上游；客户端使用 keep-alive 连接顺序发请求，
+ *          输出两轮的 requests/sec、延迟分位与上游实际接受的连接数。
+ *
+ * 使用方法:
+ *   ./benchmark_http_proxy_upstream_pool [requests] [concurrency] [upstreams]
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <galay/cpp/galay-http/builder/http_builder.h>
+#include <galay/cpp/galay-http/server/http_router.h>
+#include <galay/cpp/galay-http/server/http_server.h>
+
+using namespace galay::http;
+
+namespace {
+
+constexpr std::string_view kPayload = "galay-proxy-upstream-pool";
+
+struct ThreadResult
+{
+    std::vector<int64_t> latencies_us;
+    size_t success = 0;
+    size_t failure = 0;
+};
+
+struct PhaseResult
+{
+    size_t success = 0;
+    size_t failure = 0;
+    double elapsed_sec = 0.0;
+    size_t upstream_connections = 0;
+    std::vector<int64_t> latencies;
+};
+
+/**
+ * @brief 上游连接统计：按对端端口去重，短连接下端口复用会使计数略偏少
+ */
+struct UpstreamPeers
+{
+    std::mutex mutex;
+    std::set<std::pair<uint16_t, uint16_t>> peers;
+
+    void record(uint16_t local_port, uint16_t peer_port)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        peers.emplace(local_port, peer_port);
+    }
+
+    size_t takeCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const size_t count = peers.size();
+        peers.clear();
+        return count;
+    }
+};
+
+uint16_t reserveFreePort()
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    uint16_t port = 0;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    ::close(fd);
+    return port;
+}
+
+int connectWithRetry(uint16_t port)
+{
+    for (int attempt = 0; attempt < 200; ++attempt) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        timeval timeout{};
+        timeout.tv_sec = 2;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return -1;
+}
+
+bool sendAll(int fd, std::string_view data)
+{
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, 0);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief 在 keep-alive 连接上读取一个带 content-length 的完整响应
+ */
+bool receiveResponse(int fd, std::string& pending, std::string& response)
+{
+    char buffer[16 * 1024];
+    while (true) {
+        const size_t header_end = pending.find("\r\n\r\n");
+        if (header_end != std::string::npos) {
+            const size_t length_pos = pending.find("content-length: ");
+            if (length_pos == std::string::npos || length_pos > header_end) {
+                return false;
+            }
+            const size_t body_size = static_cast<size_t>(
+                std::strtoull(pending.c_str() + length_pos + 16, nullptr, 10));
+            const size_t total = header_end + 4 + body_size;
+            if (pending.size() >= total) {
+                response.assign(pending, 0, total);
+                pending.erase(0, total);
+                return true;
+            }
+        }
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return false;
+        }
+        pending.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+ThreadResult runWorker(uint16_t port, std::string_view prefix, size_t requests, bool print_first_failure)
+{
+    ThreadResult result;
+    result.latencies_us.reserve(requests);
+    const std::string request = "GET " + std::string(prefix) + "/item HTTP/1.1\r\n"
+                                "Host: 127.0.0.1\r\n"
+                                "\r\n";
+    int fd = -1;
+    std::string pending;
+    std::string response;
+    for (size_t i = 0; i < requests; ++i) {
+        if (fd < 0) {
+            fd = connectWithRetry(port);
+            pending.clear();
+            if (fd < 0) {
+                ++result.failure;
+                continue;
+            }
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = sendAll(fd, request) && receiveResponse(fd, pending, response) &&
+                        response.compare(0, 12, "HTTP/1.1 200") == 0 &&
+                        response.ends_with(kPayload);
+        const auto stop = std::chrono::steady_clock::now();
+        if (ok) {
+            result.latencies_us.push_back(
+                std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count());
+            ++result.success;
+            continue;
+        }
+        if (print_first_failure && result.failure == 0) {
+            std::cerr << "first failed response sample=[" << response.substr(0, 256) << "]\n";
+        }
+        ++result.failure;
+        ::close(fd);
+        fd = -1;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return result;
+}
+
+int64_t percentile(std::vector<int64_t>& values, double pct)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto max_index = static_cast<double>(values.size() - 1);
+    return values[static_cast<size_t>(max_index * pct)];
+}
+
+PhaseResult runPhase(uint16_t port, std::string_view prefix, size_t total_requests, size_t concurrency,
+                     UpstreamPeers& peers)
+{
+    PhaseResult phase;
+    std::vector<ThreadResult> results(concurrency);
+    std::vector<std::thread> workers;
+    workers.reserve(concurrency);
+
+    peers.takeCount();
+    const size_t base_requests = total_requests / concurrency;
+    const size_t extra_requests = total_requests % concurrency;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < concurrency; ++i) {
+        const size_t worker_requests = base_requests + (i < extra_requests ? 1 : 0);
+        workers.emplace_back([port, prefix, worker_requests, &results, i]() {
+            results[i] = runWorker(port, prefix, worker_requests, i == 0);
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+
+    phase.upstream_connections = peers.takeCount();
+    phase.latencies.reserve(total_requests);
+    for (ThreadResult& result : results) {
+        phase.success += result.success;
+        phase.failure += result.failure;
+        phase.latencies.insert(phase.latencies.end(), result.latencies_us.begin(), result.latencies_us.end());
+    }
+    const auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+    phase.elapsed_sec = static_cast<double>(elapsed_us) / 1'000'000.0;
+    return phase;
+}
+
+void printPhase(std::string_view name, PhaseResult& phase)
+{
+    const double rps = phase.elapsed_sec > 0.0 ? static_cast<double>(phase.success) / phase.elapsed_sec : 0.0;
+    std::cout << "  [" << name << "]\n"
+              << "    success: " << phase.success << "\n"
+              << "    failure: " << phase.failure << "\n"
+              << "    elapsed_sec: " << phase.elapsed_sec << "\n"
+              << "    requests_per_sec: " << rps << "\n"
+              << "    p50_us: " << percentile(phase.latencies, 0.50) << "\n"
+              << "    p99_us: " << percentile(phase.latencies, 0.99) << "\n"
+              << "    upstream_connections: " << phase.upstream_connections << "\n";
+}
+
+std::unique_ptr<HttpServer> startUpstream(uint16_t port, UpstreamPeers& peers)
+{
+    HttpRouter router;
+    router.addHandler<HttpMethod::GET>("/**", [&peers, port](HttpConn& conn, HttpRequest) -> Task<void> {
+        sockaddr_in peer{};
+        socklen_t len = sizeof(peer);
+        if (::getpeername(conn.getSocket().handle().fd, reinterpret_cast<sockaddr*>(&peer), &len) == 0) {
+            peers.record(port, ntohs(peer.sin_port));
+        }
+        auto response = Http1_1ResponseBuilder::ok().text(std::string(kPayload)).buildMove();
+        auto writer = conn.getWriter();
+        while (true) {
+            auto result = co_await writer.sendResponse(response);
+            if (!result || result.value()) {
+                break;
+            }
+        }
+        co_return;
+    });
+
+    auto server = std::make_unique<HttpServer>(HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(1)
+        .buildConfig());
+    server->start(std::move(router));
+    return server;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t total_requests = 20000;
+    size_t concurrency = 16;
+    size_t upstream_count = 2;
+    if (argc > 1) {
+        total_requests = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+    if (argc > 2) {
+        concurrency = static_cast<size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+    if (argc > 3) {
+        upstream_count = static_cast<size_t>(std::strtoull(argv[3], nullptr, 10));
+    }
+    if (total_requests == 0 || concurrency == 0 || upstream_count == 0) {
+        std::cerr << "requests, concurrency and upstreams must be positive\n";
+        return 1;
+    }
+    if (concurrency > total_requests) {
+        concurrency = total_requests;
+    }
+
+    UpstreamPeers peers;
+    std::vector<std::unique_ptr<HttpServer>> upstream_servers;
+    std::vector<ProxyUpstream> upstreams;
+    for (size_t i = 0; i < upstream_count; ++i) {
+        const uint16_t upstream_port = reserveFreePort();
+        if (upstream_port == 0) {
+            std::cerr << "reserve upstream port failed\n";
+            return 1;
+        }
+        upstream_servers.push_back(startUpstream(upstream_port, peers));
+        upstreams.push_back(ProxyUpstream{"127.0.0.1", upstream_port, 1});
+    }
+
+    // 连接池容量在挂载时从 defaultPolicy().proxy 读取
+    HttpRouter router;
+    router.proxy("/pooled", upstreams);
+    HttpServerPolicy no_pool_policy = router.defaultPolicy();
+    no_pool_policy.proxy.max_idle_connections_per_upstream = 0;
+    router.setDefaultPolicy(no_pool_policy);
+    router.proxy("/nopool", upstreams);
+
+    const uint16_t port = reserveFreePort();
+    if (port == 0) {
+        std::cerr << "reserve proxy port failed\n";
+        return 1;
+    }
+    auto server = HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(2)
+        .computeSchedulerCount(1)
+        .build();
+    server.start(std::move(router));
+
+    PhaseResult no_pool = runPhase(port, "/nopool", total_requests, concurrency, peers);
+    PhaseResult pooled = runPhase(port, "/pooled", total_requests, concurrency, peers);
+
+    server.stop();
+    for (auto& upstream : upstream_servers) {
+        upstream->stop();
+    }
+
+    std::cout << "HTTP proxy upstream pool benchmark\n"
+              << "  requests: " << total_requests << "\n"
+              << "  concurrency: " << concurrency << "\n"
+              << "  upstreams: " << upstream_count << "\n";
+    printPhase("nopool", no_pool);
+    printPhase("pooled", pooled);
+    return no_pool.failure == 0 && pooled.failure == 0 ? 0 : 1;
+}
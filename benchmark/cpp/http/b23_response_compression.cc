@@ -0,0 +1,366 @@
+/**
+ * @file b23_response_compression.cc
+ * @brief HTTP/1 响应压缩压测：线上字节数与 requests/sec。
+ * @details 启动一个开启 policy.compression 的服务端，提供两类负载：
+ *          /api/items 返回约 16KB 的 JSON（HttpWriter 压缩阶段即时压缩），
+ *          /static/app.js 为约 64KB 的脚本（mount 即时压缩，结果进入压缩变体缓存）。
+ *          每类负载分别以不带 Accept-Encoding 与带 "Accept-Encoding: gzip" 两轮请求，
+ *          客户端使用 keep-alive 连接顺序发请求，输出每轮的 requests/sec、延迟分位、
+ *          平均每个响应的线上字节数（含响应头）以及静态挂载的压缩变体缓存命中数。
+ *
+ * 使用方法:
+ *   ./benchmark_http_response_compression [requests] [concurrency]
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <galay/cpp/galay-http/builder/http_builder.h>
+#include <galay/cpp/galay-http/common/http_compression.h>
+#include <galay/cpp/galay-http/server/http_router.h>
+#include <galay/cpp/galay-http/server/http_server.h>
+
+using namespace galay::http;
+
+namespace {
+
+constexpr size_t kJsonSize = 16 * 1024;
+constexpr size_t kScriptSize = 64 * 1024;
+
+struct ThreadResult
+{
+    std::vector<int64_t> latencies_us;
+    size_t success = 0;
+    size_t failure = 0;
+    size_t wire_bytes = 0;
+};
+
+struct PhaseResult
+{
+    size_t success = 0;
+    size_t failure = 0;
+    size_t wire_bytes = 0;
+    double elapsed_sec = 0.0;
+    std::vector<int64_t> latencies;
+};
+
+std::string makeJson(size_t bytes)
+{
+    std::string json = "[";
+    while (json.size() < bytes) {
+        json += "{\"id\":42,\"name\":\"galay\",\"price\":19.99,\"tags\":[\"http\",\"bench\"]},";
+    }
+    json.back() = ']';
+    return json;
+}
+
+uint16_t reserveFreePort()
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    uint16_t port = 0;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    ::close(fd);
+    return port;
+}
+
+int connectWithRetry(uint16_t port)
+{
+    for (int attempt = 0; attempt < 200; ++attempt) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        timeval timeout{};
+        timeout.tv_sec = 2;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return -1;
+}
+
+bool sendAll(int fd, std::string_view data)
+{
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, 0);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief 在 keep-alive 连接上读取一个带 Content-Length 的完整响应，返回其线上字节数
+ */
+size_t receiveResponse(int fd, std::string& pending, std::string& head)
+{
+    char buffer[64 * 1024];
+    while (true) {
+        const size_t header_end = pending.find("\r\n\r\n");
+        if (header_end != std::string::npos) {
+            head.assign(pending, 0, header_end + 4);
+            for (char& ch : head) {
+                ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+            }
+            const size_t length_pos = head.find("\r\ncontent-length: ");
+            if (length_pos == std::string::npos) {
+                return 0;
+            }
+            const size_t body_size = static_cast<size_t>(
+                std::strtoull(head.c_str() + length_pos + 18, nullptr, 10));
+            const size_t total = header_end + 4 + body_size;
+            if (pending.size() >= total) {
+                pending.erase(0, total);
+                return total;
+            }
+        }
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return 0;
+        }
+        pending.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+ThreadResult runWorker(uint16_t port, const std::string& request, bool expect_gzip, size_t requests)
+{
+    ThreadResult result;
+    result.latencies_us.reserve(requests);
+    int fd = -1;
+    std::string pending;
+    std::string head;
+    for (size_t i = 0; i < requests; ++i) {
+        if (fd < 0) {
+            fd = connectWithRetry(port);
+            pending.clear();
+            if (fd < 0) {
+                ++result.failure;
+                continue;
+            }
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const size_t wire = sendAll(fd, request) ? receiveResponse(fd, pending, head) : 0;
+        const auto stop = std::chrono::steady_clock::now();
+        const bool gzip = head.find("\r\ncontent-encoding: gzip\r\n") != std::string::npos;
+        if (wire > 0 && head.compare(0, 12, "http/1.1 200") == 0 && gzip == expect_gzip) {
+            result.latencies_us.push_back(
+                std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count());
+            result.wire_bytes += wire;
+            ++result.success;
+            continue;
+        }
+        ++result.failure;
+        ::close(fd);
+        fd = -1;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return result;
+}
+
+int64_t percentile(std::vector<int64_t>& values, double pct)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto max_index = static_cast<double>(values.size() - 1);
+    return values[static_cast<size_t>(max_index * pct)];
+}
+
+PhaseResult runPhase(uint16_t port, std::string_view path, bool gzip, size_t total_requests, size_t concurrency)
+{
+    const std::string request = "GET " + std::string(path) + " HTTP/1.1\r\n"
+                                "Host: 127.0.0.1\r\n" +
+                                std::string(gzip ? "Accept-Encoding: gzip\r\n" : "") +
+                                "\r\n";
+    PhaseResult phase;
+    std::vector<ThreadResult> results(concurrency);
+    std::vector<std::thread> workers;
+    workers.reserve(concurrency);
+
+    const size_t base_requests = total_requests / concurrency;
+    const size_t extra_requests = total_requests % concurrency;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < concurrency; ++i) {
+        const size_t worker_requests = base_requests + (i < extra_requests ? 1 : 0);
+        workers.emplace_back([port, &request, gzip, worker_requests, &results, i]() {
+            results[i] = runWorker(port, request, gzip, worker_requests);
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+
+    phase.latencies.reserve(total_requests);
+    for (ThreadResult& result : results) {
+        phase.success += result.success;
+        phase.failure += result.failure;
+        phase.wire_bytes += result.wire_bytes;
+        phase.latencies.insert(phase.latencies.end(), result.latencies_us.begin(), result.latencies_us.end());
+    }
+    const auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+    phase.elapsed_sec = static_cast<double>(elapsed_us) / 1'000'000.0;
+    return phase;
+}
+
+void printPhase(std::string_view name, PhaseResult& phase)
+{
+    const double rps = phase.elapsed_sec > 0.0 ? static_cast<double>(phase.success) / phase.elapsed_sec : 0.0;
+    const double bytes_per_response =
+        phase.success > 0 ? static_cast<double>(phase.wire_bytes) / static_cast<double>(phase.success) : 0.0;
+    std::cout << "  [" << name << "]\n"
+              << "    success: " << phase.success << "\n"
+              << "    failure: " << phase.failure << "\n"
+              << "    elapsed_sec: " << phase.elapsed_sec << "\n"
+              << "    requests_per_sec: " << rps << "\n"
+              << "    p50_us: " << percentile(phase.latencies, 0.50) << "\n"
+              << "    p99_us: " << percentile(phase.latencies, 0.99) << "\n"
+              << "    wire_bytes_per_response: " << bytes_per_response << "\n"
+              << "    wire_mib_total: " << static_cast<double>(phase.wire_bytes) / (1024.0 * 1024.0) << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t total_requests = 20000;
+    size_t concurrency = 16;
+    if (argc > 1) {
+        total_requests = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+    if (argc > 2) {
+        concurrency = static_cast<size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+    if (total_requests == 0 || concurrency == 0) {
+        std::cerr << "requests and concurrency must be positive\n";
+        return 1;
+    }
+    if (concurrency > total_requests) {
+        concurrency = total_requests;
+    }
+    if (!isContentCodingSupported(HttpContentCoding::Gzip)) {
+        std::cerr << "gzip is not compiled into this build (GALAY_HTTP_ENABLE_GZIP)\n";
+        return 1;
+    }
+
+    const std::filesystem::path root =
+        std::filesystem::temp_directory_path() / ("galay_b23_" + std::to_string(::getpid()));
+    std::filesystem::create_directories(root);
+    {
+        std::string script;
+        while (script.size() < kScriptSize) {
+            script += "export function render(items) { return items.map((item) => `<li>${item.name}</li>`); }\n";
+        }
+        std::ofstream(root / "app.js", std::ios::binary) << script;
+    }
+
+    HttpRouter router;
+    router.addHandler<HttpMethod::GET>("/api/items", [](HttpConn& conn, HttpRequest) -> Task<void> {
+        auto response = Http1_1ResponseBuilder().status(HttpStatusCode::OK_200)
+            .header("Content-Type", "application/json")
+            .body(makeJson(kJsonSize))
+            .buildMove();
+        auto writer = conn.getWriter();
+        while (true) {
+            auto result = co_await writer.sendResponse(response);
+            if (!result || result.value()) {
+                break;
+            }
+        }
+        co_return;
+    });
+
+    StaticFileSetting static_setting;
+    HttpCompressionSetting static_compression;
+    static_compression.setEnabled(true);
+    static_setting.setCompression(static_compression);
+    static_setting.setEnableCache(true);
+    static_setting.setTransferMode(FileTransferMode::MEMORY);
+    router.mount("/static", root.string(), static_setting);
+    const auto variant_caches = router.compressedVariantCaches();
+
+    HttpServerPolicy policy;
+    policy.compression.setEnabled(true);
+    const uint16_t port = reserveFreePort();
+    if (port == 0) {
+        std::cerr << "reserve port failed\n";
+        return 1;
+    }
+    auto server = HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(2)
+        .computeSchedulerCount(1)
+        .policy(policy)
+        .build();
+    server.start(std::move(router));
+
+    PhaseResult json_identity = runPhase(port, "/api/items", false, total_requests, concurrency);
+    PhaseResult json_gzip = runPhase(port, "/api/items", true, total_requests, concurrency);
+    PhaseResult static_identity = runPhase(port, "/static/app.js", false, total_requests, concurrency);
+    PhaseResult static_gzip = runPhase(port, "/static/app.js", true, total_requests, concurrency);
+
+    server.stop();
+    std::filesystem::remove_all(root);
+
+    std::cout << "HTTP response compression benchmark\n"
+              << "  requests: " << total_requests << "\n"
+              << "  concurrency: " << concurrency << "\n"
+              << "  json_bytes: " << makeJson(kJsonSize).size() << "\n"
+              << "  script_bytes: " << kScriptSize << "\n";
+    printPhase("json-identity", json_identity);
+    printPhase("json-gzip", json_gzip);
+    printPhase("static-identity", static_identity);
+    printPhase("static-gzip", static_gzip);
+    if (!variant_caches.empty()) {
+        const auto stats = variant_caches.front()->stats();
+        std::cout << "  variant_cache_hits: " << stats.hits << "\n"
+                  << "  variant_cache_misses: " << stats.misses << "\n"
+                  << "  variant_cache_bytes: " << stats.bytes << "\n";
+    }
+    const bool ok = json_identity.failure == 0 && json_gzip.failure == 0 &&
+                    static_identity.failure == 0 && static_gzip.failure == 0;
+    return ok ? 0 : 1;
+}
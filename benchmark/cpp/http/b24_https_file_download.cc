@@ -0,0 +1,207 @@
+/**
+ * @file b24_https_file_download.cc
+ * @brief HTTPS 大文件下载压测程序（kTLS sendfile vs 用户态加密）
+ * @details 每个请求返回同一个磁盘文件。mode 为 ktls 时开启 SslContext 的 kTLS：
+ *          连接发送方向切到内核后，响应体用 SslSocket::sendfile 直接把文件页交给内核加密；
+ *          内核没有 tls 模块或 mode 为 user 时，走 pread + SslSocket::send 的用户态加密路径。
+ *          用 curl/wrk 等外部工具下载，对比两种模式的吞吐与 CPU。
+ *
+ * 使用方法:
+ *   ./benchmark_http_https_file_download [port] [io_threads] [cert] [key] [file_path] [ktls|user]
+ */
+
+#include <galay/cpp/galay-http/server/http_server.h>
+#include <galay/cpp/galay-http/protoc/http_request.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef GALAY_SSL_FEATURE_ENABLED
+
+using namespace galay::http;
+using namespace galay::kernel;
+
+static volatile bool g_running = true;
+static std::string g_file_path;
+static std::atomic<uint64_t> g_sendfile_responses{0};
+static std::atomic<uint64_t> g_userspace_responses{0};
+
+static constexpr size_t kChunkSize = 64 * 1024;
+
+void signalHandler(int) {
+    g_running = false;
+}
+
+Task<bool> sendBodyWithSendfile(galay::ssl::SslSocket& socket, int fd, size_t size) {
+    off_t offset = 0;
+    while (static_cast<size_t>(offset) < size) {
+        auto result = co_await socket.sendfile(fd, offset, size - static_cast<size_t>(offset));
+        if (!result || result.value() == 0) {
+            co_return false;
+        }
+        offset += static_cast<off_t>(result.value());
+    }
+    co_return true;
+}
+
+Task<bool> sendBodyWithPread(galay::ssl::SslSocket& socket, int fd, size_t size, std::vector<char>& chunk) {
+    size_t offset = 0;
+    while (offset < size) {
+        const ssize_t n = ::pread(fd, chunk.data(), std::min(chunk.size(), size - offset), static_cast<off_t>(offset));
+        if (n <= 0) {
+            co_return false;
+        }
+        size_t sent = 0;
+        while (sent < static_cast<size_t>(n)) {
+            auto result = co_await socket.send(chunk.data() + sent, static_cast<size_t>(n) - sent);
+            if (!result || result.value() == 0) {
+                co_return false;
+            }
+            sent += result.value();
+        }
+        offset += static_cast<size_t>(n);
+    }
+    co_return true;
+}
+
+Task<void> handleHttpsRequest(HttpConnImpl<galay::ssl::SslSocket> conn) {
+    auto reader = conn.getReader();
+    auto writer = conn.getWriter();
+    std::vector<char> chunk(kChunkSize);
+    std::string header;
+
+    while (true) {
+        HttpRequest request;
+        while (true) {
+            auto read_result = co_await reader.getRequest(request);
+            if (!read_result) {
+                co_return;
+            }
+            if (read_result.value()) {
+                break;
+            }
+        }
+
+        const int fd = ::open(g_file_path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat st{};
+        if (fd < 0 || ::fstat(fd, &st) != 0) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            co_return;
+        }
+        const size_t size = static_cast<size_t>(st.st_size);
+        header = "HTTP/1.1 200 OK\r\n"
+                 "Content-Type: application/octet-stream\r\n"
+                 "Connection: keep-alive\r\n"
+                 "Content-Length: " + std::to_string(size) + "\r\n\r\n";
+
+        bool ok = static_cast<bool>(co_await writer.sendView(header));
+        if (ok) {
+            // 发送方向在用户态时 sendfile 会直接失败，必须按连接实际状态选路径
+            if (conn.getSocket().isKtlsTxEnabled()) {
+                ok = (co_await sendBodyWithSendfile(conn.getSocket(), fd, size)).value_or(false);
+                g_sendfile_responses.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                ok = (co_await sendBodyWithPread(conn.getSocket(), fd, size, chunk)).value_or(false);
+                g_userspace_responses.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        ::close(fd);
+        if (!ok) {
+            co_return;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    uint16_t port = 9445;
+    int io_threads = 4;
+    std::string cert_path = "cert/test.crt";
+    std::string key_path = "cert/test.key";
+    g_file_path = "/tmp/galay_https_download.bin";
+    std::string mode = "ktls";
+
+    if (argc > 1) {
+        port = static_cast<uint16_t>(std::atoi(argv[1]));
+    }
+    if (argc > 2) {
+        io_threads = std::atoi(argv[2]);
+    }
+    if (argc > 3) {
+        cert_path = argv[3];
+    }
+    if (argc > 4) {
+        key_path = argv[4];
+    }
+    if (argc > 5) {
+        g_file_path = argv[5];
+    }
+    if (argc > 6) {
+        mode = argv[6];
+    }
+    if (mode != "ktls" && mode != "user") {
+        std::cerr << "mode must be ktls or user\n";
+        return 1;
+    }
+    if (::access(g_file_path.c_str(), R_OK) != 0) {
+        std::cerr << "file not readable: " << g_file_path << "\n";
+        return 1;
+    }
+
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
+    std::cout << "========================================\n";
+    std::cout << "HTTPS File Download Benchmark\n";
+    std::cout << "========================================\n";
+    std::cout << "Port: " << port << "\n";
+    std::cout << "IO Threads: " << io_threads << "\n";
+    std::cout << "File: " << g_file_path << "\n";
+    std::cout << "Mode: " << mode << "\n";
+    std::cout << "Press Ctrl+C to stop\n";
+    std::cout << "========================================\n\n";
+
+    try {
+        HttpsServer server(HttpsServerBuilder()
+            .host("0.0.0.0")
+            .port(port)
+            .certPath(cert_path)
+            .keyPath(key_path)
+            .ktls(mode == "ktls")
+            .ioSchedulerCount(static_cast<size_t>(io_threads))
+            .build());
+
+        server.start(handleHttpsRequest);
+        while (g_running) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        server.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "sendfile responses: " << g_sendfile_responses.load() << "\n";
+    std::cout << "user-space responses: " << g_userspace_responses.load() << "\n";
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "SSL support is not enabled.\n";
+    std::cout << "Rebuild with -DGALAY_BUILD_SSL=ON\n";
+    return 0;
+}
+
+#endif
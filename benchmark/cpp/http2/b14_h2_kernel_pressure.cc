@@ -13,6 +13,7 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <sys/uio.h>
 
 using namespace galay::http2;
 
@@ -27,6 +28,9 @@ struct BenchResult
     size_t bytes_scheduler_bytes = 0;
     size_t bytes_scheduler_frames = 0;
     size_t bytes_scheduler_streams = 0;
+    size_t slice_scheduler_bytes = 0;
+    size_t slice_scheduler_frames = 0;
+    size_t slice_scheduler_streams = 0;
     size_t core_frame_bytes = 0;
     size_t core_frame_frames = 0;
     size_t core_frame_streams = 0;
@@ -39,6 +43,7 @@ struct BenchResult
     double elapsed_ms = 0.0;
     double scheduler_ms = 0.0;
     double bytes_scheduler_ms = 0.0;
+    double slice_scheduler_ms = 0.0;
     double core_frame_ms = 0.0;
     double core_bytes_ms = 0.0;
     double flow_ms = 0.0;
@@ -181,6 +186,38 @@ bool runBytesSchedulerPressure(size_t streams_count,
     return true;
 }
 
+bool runSliceSchedulerPressure(size_t streams_count,
+                               size_t payload_bytes,
+                               size_t frame_bytes,
+                               BenchResult& result)
+{
+    auto streams = makeStreams(streams_count, payload_bytes);
+    const size_t expected_bytes = streams_count * payload_bytes;
+    std::vector<struct iovec> iovecs;
+    while (result.slice_scheduler_bytes < expected_bytes) {
+        auto selected = Http2OutboundScheduler::pickSendableSlices(H2OutboundBudget{
+            .conn_window = static_cast<int32_t>(streams_count * frame_bytes),
+            .max_frame_size = static_cast<uint32_t>(frame_bytes)
+        }, streams, H2SchedulerConfig{
+            .base_quantum = frame_bytes
+        });
+        if (selected.frames.empty()) {
+            std::cerr << "slice scheduler made no progress\n";
+            return false;
+        }
+
+        result.slice_scheduler_bytes += selected.total_data_bytes;
+        result.slice_scheduler_frames += selected.frames.size();
+        // 与 bytes 调度对齐：包含组装 writev iovec 列表的开销
+        if (selected.fillIovecs(iovecs) < selected.frames.size()) {
+            std::cerr << "slice scheduler emitted frame without prelude\n";
+            return false;
+        }
+    }
+    result.slice_scheduler_streams = streams_count;
+    return true;
+}
+
 bool runCoreBytesPressure(size_t streams_count,
                           size_t payload_bytes,
                           size_t frame_bytes,
@@ -302,8 +339,13 @@ BenchResult runBench(size_t streams_count, size_t payload_bytes, size_t flow_rou
         runBytesSchedulerPressure(streams_count, payload_bytes, 16, result);
     const auto bytes_scheduler_end = std::chrono::steady_clock::now();
 
+    const auto slice_scheduler_start = std::chrono::steady_clock::now();
+    const bool slice_scheduler_ok = bytes_scheduler_ok &&
+        runSliceSchedulerPressure(streams_count, payload_bytes, 16, result);
+    const auto slice_scheduler_end = std::chrono::steady_clock::now();
+
     const auto core_frame_start = std::chrono::steady_clock::now();
-    const bool core_frame_ok = bytes_scheduler_ok &&
+    const bool core_frame_ok = slice_scheduler_ok &&
         runCoreFramePressure(streams_count, payload_bytes, 16, result);
     const auto core_frame_end = std::chrono::steady_clock::now();
 
@@ -323,6 +365,7 @@ BenchResult runBench(size_t streams_count, size_t payload_bytes, size_t flow_rou
     const auto end = std::chrono::steady_clock::now();
     result.scheduler_ms = std::chrono::duration<double, std::milli>(scheduler_end - scheduler_start).count();
     result.bytes_scheduler_ms = std::chrono::duration<double, std::milli>(bytes_scheduler_end - bytes_scheduler_start).count();
+    result.slice_scheduler_ms = std::chrono::duration<double, std::milli>(slice_scheduler_end - slice_scheduler_start).count();
     result.core_frame_ms = std::chrono::duration<double, std::milli>(core_frame_end - core_frame_start).count();
     result.core_bytes_ms = std::chrono::duration<double, std::milli>(core_bytes_end - core_bytes_start).count();
     result.flow_ms = std::chrono::duration<double, std::milli>(flow_end - flow_start).count();
@@ -416,6 +459,14 @@ int main(int argc, char* argv[])
               << " bytes_scheduler_mib_per_s="
               << mibPerSecond(result.bytes_scheduler_bytes, result.bytes_scheduler_ms)
               << "\n";
+    std::cout << "slice_scheduler_ms=" << result.slice_scheduler_ms
+              << " slice_scheduler_stream_qps="
+              << perSecond(result.slice_scheduler_streams, result.slice_scheduler_ms)
+              << " slice_scheduler_frame_qps="
+              << perSecond(result.slice_scheduler_frames, result.slice_scheduler_ms)
+              << " slice_scheduler_mib_per_s="
+              << mibPerSecond(result.slice_scheduler_bytes, result.slice_scheduler_ms)
+              << "\n";
     std::cout << "core_frame_ms=" << result.core_frame_ms
               << " core_frame_stream_qps=" << perSecond(result.core_frame_streams, result.core_frame_ms)
               << " core_frame_frame_qps=" << perSecond(result.core_frame_frames, result.core_frame_ms)
@@ -439,6 +490,9 @@ int main(int argc, char* argv[])
     std::cout << "bytes_scheduler_bytes=" << result.bytes_scheduler_bytes
               << " bytes_scheduler_frames=" << result.bytes_scheduler_frames
               << "\n";
+    std::cout << "slice_scheduler_bytes=" << result.slice_scheduler_bytes
+              << " slice_scheduler_frames=" << result.slice_scheduler_frames
+              << "\n";
     std::cout << "core_frame_bytes=" << result.core_frame_bytes
               << " core_frame_frames=" << result.core_frame_frames
               << "\n";
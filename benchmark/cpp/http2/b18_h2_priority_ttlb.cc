@@ -0,0 +1,183 @@
+/**
+ * @file b18_h2_priority_ttlb.cc
+ * @brief HTTP/2 出站调度：批量流压力下高 urgency 流的最后字节到达时间
+ *
+ * @details 在同一连接上放置若干大体积低优先级流（urgency 5）与若干小体积高优先级流（urgency 0），
+ *          每轮以固定连接窗口调用出站调度器，模拟每个 RTT 到达一次 WINDOW_UPDATE 的受限链路。
+ *          分别统计 WeightedDrr 与 Extensible 两种模式下，全部高优先级流发完所需的轮数
+ *          与此前连接上已发出的字节数（time-to-last-byte），以及全部流发完的总轮数。
+ *
+ * 用法: b18_h2_priority_ttlb [bulk_streams] [bulk_bytes] [urgent_streams] [urgent_bytes] [window] [iterations]
+ */
+
+#include <galay/cpp/galay-http2/kernel/out_scheduler.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace galay::http2;
+
+namespace
+{
+
+struct TtlbResult
+{
+    size_t urgent_rounds = 0;       ///< 高优先级流全部发完时的轮数
+    size_t urgent_wire_bytes = 0;   ///< 高优先级流全部发完时连接已发出的 DATA 字节
+    size_t total_rounds = 0;        ///< 全部流发完的轮数
+    size_t total_bytes = 0;         ///< 全部 DATA 字节
+    double elapsed_ms = 0.0;        ///< 调度耗时（全部迭代）
+};
+
+std::vector<H2StreamSendState> makeStreams(size_t bulk_streams, size_t bulk_bytes,
+                                           size_t urgent_streams, size_t urgent_bytes)
+{
+    std::vector<H2StreamSendState> streams;
+    streams.reserve(bulk_streams + urgent_streams);
+    uint32_t stream_id = 1;
+    auto add = [&](size_t bytes, uint8_t urgency) {
+        H2StreamSendState state;
+        state.pending.chunks.push_back(Http2PayloadSlice(std::string(bytes, 'x')));
+        state.pending.end_stream = true;
+        state.stream_id = stream_id;
+        state.stream_window = std::numeric_limits<int32_t>::max();
+        state.urgency = urgency;
+        streams.push_back(std::move(state));
+        stream_id += 2;
+    };
+    // 批量流先打开，占据调度轮转的前部
+    for (size_t i = 0; i < bulk_streams; ++i) {
+        add(bulk_bytes, 5);
+    }
+    for (size_t i = 0; i < urgent_streams; ++i) {
+        add(urgent_bytes, 0);
+    }
+    return streams;
+}
+
+TtlbResult runOnce(H2SchedulingMode mode, size_t bulk_streams, size_t bulk_bytes,
+                   size_t urgent_streams, size_t urgent_bytes, int32_t window)
+{
+    auto streams = makeStreams(bulk_streams, bulk_bytes, urgent_streams, urgent_bytes);
+    std::unordered_map<uint32_t, size_t> remaining;
+    for (const auto& stream : streams) {
+        remaining[stream.stream_id] = stream.pending.chunks.front().size();
+    }
+
+    const H2OutboundBudget budget{.conn_window = window, .max_frame_size = 16 * 1024};
+    const H2SchedulerConfig config{.mode = mode};
+    const uint32_t first_urgent_id = static_cast<uint32_t>(bulk_streams * 2 + 1);
+    size_t urgent_left = urgent_streams;
+    size_t streams_left = streams.size();
+
+    TtlbResult result;
+    while (streams_left > 0) {
+        auto selection = Http2OutboundScheduler::pickSendableSlices(budget, streams, config);
+        if (selection.frames.empty()) {
+            break;
+        }
+        ++result.total_rounds;
+        for (const auto& frame : selection.frames) {
+            const auto* p = reinterpret_cast<const uint8_t*>(frame.prelude.data());
+            const uint32_t id = ((static_cast<uint32_t>(p[5]) & 0x7fu) << 24) |
+                                (static_cast<uint32_t>(p[6]) << 16) |
+                                (static_cast<uint32_t>(p[7]) << 8) |
+                                static_cast<uint32_t>(p[8]);
+            result.total_bytes += frame.payload.size();
+            size_t& left = remaining[id];
+            left -= frame.payload.size();
+            if (left == 0) {
+                --streams_left;
+                if (id >= first_urgent_id && --urgent_left == 0) {
+                    result.urgent_rounds = result.total_rounds;
+                    result.urgent_wire_bytes = result.total_bytes;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+TtlbResult runBench(H2SchedulingMode mode, size_t bulk_streams, size_t bulk_bytes,
+                    size_t urgent_streams, size_t urgent_bytes, int32_t window, size_t iterations)
+{
+    TtlbResult result;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        result = runOnce(mode, bulk_streams, bulk_bytes, urgent_streams, urgent_bytes, window);
+    }
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void printResult(const char* name, const TtlbResult& result, size_t iterations)
+{
+    std::cout << name
+              << " urgent_ttlb_rounds=" << result.urgent_rounds
+              << " urgent_ttlb_bytes=" << result.urgent_wire_bytes
+              << " total_rounds=" << result.total_rounds
+              << " total_bytes=" << result.total_bytes
+              << " elapsed_ms=" << result.elapsed_ms
+              << " ms_per_run=" << (iterations == 0 ? 0.0 : result.elapsed_ms / iterations)
+              << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t bulk_streams = 8;
+    size_t bulk_bytes = 1024 * 1024;
+    size_t urgent_streams = 4;
+    size_t urgent_bytes = 32 * 1024;
+    int32_t window = 64 * 1024;
+    size_t iterations = 20;
+    if (argc > 1) {
+        bulk_streams = static_cast<size_t>(std::stoul(argv[1]));
+    }
+    if (argc > 2) {
+        bulk_bytes = static_cast<size_t>(std::stoul(argv[2]));
+    }
+    if (argc > 3) {
+        urgent_streams = static_cast<size_t>(std::stoul(argv[3]));
+    }
+    if (argc > 4) {
+        urgent_bytes = static_cast<size_t>(std::stoul(argv[4]));
+    }
+    if (argc > 5) {
+        window = static_cast<int32_t>(std::stol(argv[5]));
+    }
+    if (argc > 6) {
+        iterations = static_cast<size_t>(std::stoul(argv[6]));
+    }
+    if (bulk_bytes == 0 || urgent_streams == 0 || urgent_bytes == 0 || window <= 0) {
+        std::cerr << "bulk_bytes, urgent_streams, urgent_bytes and window must be positive\n";
+        return 1;
+    }
+
+    std::cout << "HTTP/2 priority time-to-last-byte benchmark\n";
+    std::cout << "bulk_streams=" << bulk_streams
+              << " bulk_bytes=" << bulk_bytes
+              << " urgent_streams=" << urgent_streams
+              << " urgent_bytes=" << urgent_bytes
+              << " window=" << window
+              << " iterations=" << iterations << "\n";
+
+    const auto drr = runBench(H2SchedulingMode::WeightedDrr, bulk_streams, bulk_bytes,
+                              urgent_streams, urgent_bytes, window, iterations);
+    const auto extensible = runBench(H2SchedulingMode::Extensible, bulk_streams, bulk_bytes,
+                                     urgent_streams, urgent_bytes, window, iterations);
+    printResult("weighted_drr", drr, iterations);
+    printResult("extensible", extensible, iterations);
+    if (extensible.urgent_rounds > 0) {
+        std::cout << "urgent_ttlb_speedup="
+                  << static_cast<double>(drr.urgent_rounds) / static_cast<double>(extensible.urgent_rounds)
+                  << "\n";
+    }
+    return 0;
+}
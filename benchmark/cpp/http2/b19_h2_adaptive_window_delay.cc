@@ -0,0 +1,370 @@
+/**
+ * @file b19_h2_adaptive_window_delay.cc
+ * @brief HTTP/2 固定接收窗口与 BDP 自适应接收窗口在高时延链路上的下载吞吐对比
+ *
+ * @details 进程内启动 h2c 服务端（处理器返回大响应体）与一个本地延迟代理：
+ *          代理对两个方向的每段字节按到达时间加上单向时延后再转发，不依赖 netem。
+ *          客户端经代理下载同一响应若干次，分别以固定窗口与 adaptiveWindow() 运行，输出 MiB/s。
+ *
+ * 用法: b19_h2_adaptive_window_delay [rtt_ms] [body_mib] [rounds] [max_window_mib]
+ */
+
+#include <galay/cpp/galay-http2/client/h2c_client.h>
+#include <galay/cpp/galay-http2/server/http2_server.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace galay::http2;
+using namespace galay::kernel;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 单向延迟管道：读线程打时间戳入队，写线程到期后转发
+ */
+class DelayPipe
+{
+public:
+    DelayPipe(int from_fd, int to_fd, Clock::duration delay)
+        : m_from(from_fd), m_to(to_fd), m_delay(delay) {}
+
+    void run() {
+        std::thread writer([this] { writeLoop(); });
+        std::vector<char> buffer(256 * 1024);
+        while (true) {
+            const ssize_t n = ::recv(m_from, buffer.data(), buffer.size(), 0);
+            if (n <= 0) {
+                break;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back({Clock::now() + m_delay, std::string(buffer.data(), static_cast<size_t>(n))});
+            m_cv.notify_one();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_cv.notify_one();
+        }
+        writer.join();
+        ::shutdown(m_to, SHUT_WR);
+    }
+
+private:
+    struct Segment {
+        Clock::time_point due;
+        std::string bytes;
+    };
+
+    void writeLoop() {
+        while (true) {
+            Segment segment;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_closed || !m_queue.empty(); });
+                if (m_queue.empty()) {
+                    return;
+                }
+                const auto due = m_queue.front().due;
+                if (Clock::now() < due) {
+                    m_cv.wait_until(lock, due);
+                    continue;
+                }
+                segment = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            size_t sent = 0;
+            while (sent < segment.bytes.size()) {
+                const ssize_t n = ::send(m_to, segment.bytes.data() + sent,
+                                         segment.bytes.size() - sent, MSG_NOSIGNAL);
+                if (n <= 0) {
+                    return;
+                }
+                sent += static_cast<size_t>(n);
+            }
+        }
+    }
+
+    int m_from;
+    int m_to;
+    Clock::duration m_delay;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Segment> m_queue;
+    bool m_closed = false;
+};
+
+/**
+ * @brief 本地延迟代理：每个接入连接建立一条到上游的连接，双向各加 rtt/2 时延
+ */
+class DelayProxy
+{
+public:
+    DelayProxy(uint16_t listen_port, uint16_t upstream_port, Clock::duration rtt)
+        : m_listen_port(listen_port), m_upstream_port(upstream_port), m_one_way(rtt / 2) {}
+
+    ~DelayProxy() { stop(); }
+
+    bool start() {
+        m_listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int on = 1;
+        ::setsockopt(m_listen_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in addr = loopback(m_listen_port);
+        if (::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(m_listen_fd, 16) != 0) {
+            return false;
+        }
+        m_acceptor = std::thread([this] { acceptLoop(); });
+        return true;
+    }
+
+    void stop() {
+        if (m_listen_fd >= 0) {
+            ::shutdown(m_listen_fd, SHUT_RDWR);
+            ::close(m_listen_fd);
+            m_listen_fd = -1;
+        }
+        if (m_acceptor.joinable()) {
+            m_acceptor.join();
+        }
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+private:
+    static sockaddr_in loopback(uint16_t port) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return addr;
+    }
+
+    void acceptLoop() {
+        while (true) {
+            const int client_fd = ::accept(m_listen_fd, nullptr, nullptr);
+            if (client_fd < 0) {
+                return;
+            }
+            const int upstream_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr = loopback(m_upstream_port);
+            if (::connect(upstream_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                ::close(upstream_fd);
+                ::close(client_fd);
+                continue;
+            }
+            int on = 1;
+            ::setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            ::setsockopt(upstream_fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            m_workers.emplace_back([this, client_fd, upstream_fd] {
+                DelayPipe up(client_fd, upstream_fd, m_one_way);
+                DelayPipe down(upstream_fd, client_fd, m_one_way);
+                std::thread down_thread([&down] { down.run(); });
+                up.run();
+                down_thread.join();
+                ::close(client_fd);
+                ::close(upstream_fd);
+            });
+        }
+    }
+
+    uint16_t m_listen_port;
+    uint16_t m_upstream_port;
+    Clock::duration m_one_way;
+    int m_listen_fd = -1;
+    std::thread m_acceptor;
+    std::vector<std::thread> m_workers;
+};
+
+std::shared_ptr<const std::string> g_body;
+
+/**
+ * @brief 大响应体走处理器发送：超出对端窗口的 DATA 暂存在流上，随 WINDOW_UPDATE 补发
+ */
+Task<void> bodyActiveHandler(Http2ConnContext& ctx)
+{
+    while (true) {
+        auto streams = co_await ctx.getActiveStreams(16);
+        if (!streams) {
+            break;
+        }
+        for (auto& stream : *streams) {
+            auto events = stream->takeEvents();
+            if (!hasHttp2StreamEvent(events, Http2StreamEvent::RequestComplete)) {
+                continue;
+            }
+            if (stream->request().path != "/body") {
+                stream->sendHeaders(
+                    Http2Headers().status(404).contentType("text/plain").contentLength(0),
+                    true,
+                    true);
+                continue;
+            }
+            stream->sendHeaders(
+                Http2Headers().status(200).contentType("application/octet-stream").contentLength(g_body->size()),
+                false,
+                true);
+            stream->sendData(g_body, true);
+        }
+    }
+    co_return;
+}
+
+struct DownloadResult {
+    std::atomic<bool> done{false};
+    bool ok = false;
+    size_t bytes = 0;
+    double seconds = 0.0;
+    uint32_t final_conn_target = 0;
+};
+
+Task<void> runDownloads(H2cClientConfig config, uint16_t port, size_t rounds,
+                        size_t body_bytes, DownloadResult* result)
+{
+    H2cClient<> client(config);
+    auto connect_result = co_await client.connect("127.0.0.1", port);
+    if (!connect_result) {
+        std::cerr << "connect failed: " << connect_result.error().message() << "\n";
+        result->done = true;
+        co_return;
+    }
+    auto upgrade_result = co_await client.upgrade("/ping");
+    if (!upgrade_result) {
+        std::cerr << "upgrade failed: " << upgrade_result.error().toString() << "\n";
+        result->done = true;
+        co_return;
+    }
+
+    const auto start = Clock::now();
+    bool ok = true;
+    for (size_t i = 0; i < rounds; ++i) {
+        auto stream = client.get("/body");
+        auto completed = co_await stream->waitResponseComplete();
+        if (!completed || stream->response().status != 200 ||
+            stream->response().body.size() != body_bytes) {
+            std::cerr << "download " << i << " failed completed=" << (completed ? 1 : 0)
+                      << " status=" << stream->response().status
+                      << " size=" << stream->response().body.size() << "\n";
+            ok = false;
+            break;
+        }
+        result->bytes += body_bytes;
+    }
+    result->seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result->final_conn_target = client.getConn()->windowTuner().connTarget();
+    result->ok = ok;
+    co_await client.shutdown();
+    result->done = true;
+    co_return;
+}
+
+bool runMode(const char* name, H2cClientConfig config, uint16_t port,
+             size_t rounds, size_t body_bytes)
+{
+    DownloadResult result;
+    Runtime runtime = RuntimeBuilder().ioSchedulerCount(1).computeSchedulerCount(0).build();
+    runtime.start();
+    scheduleTask(runtime.getNextIOScheduler(), runDownloads(config, port, rounds, body_bytes, &result));
+    while (!result.done.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    runtime.stop();
+
+    const double mib = static_cast<double>(result.bytes) / (1024.0 * 1024.0);
+    std::cout << name
+              << " ok=" << (result.ok ? 1 : 0)
+              << " bytes=" << result.bytes
+              << " seconds=" << result.seconds
+              << " mib_per_s=" << (result.seconds > 0.0 ? mib / result.seconds : 0.0)
+              << " final_conn_window=" << result.final_conn_target
+              << "\n";
+    return result.ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    size_t rtt_ms = 80;
+    size_t body_mib = 4;
+    size_t rounds = 2;
+    size_t max_window_mib = 16;
+    if (argc > 1) {
+        rtt_ms = static_cast<size_t>(std::stoul(argv[1]));
+    }
+    if (argc > 2) {
+        body_mib = static_cast<size_t>(std::stoul(argv[2]));
+    }
+    if (argc > 3) {
+        rounds = static_cast<size_t>(std::stoul(argv[3]));
+    }
+    if (argc > 4) {
+        max_window_mib = static_cast<size_t>(std::stoul(argv[4]));
+    }
+    const size_t body_bytes = body_mib * 1024 * 1024;
+
+    g_body = std::make_shared<const std::string>(body_bytes, 'b');
+
+    const uint16_t server_port = static_cast<uint16_t>(24000 + (::getpid() % 4000));
+    const uint16_t proxy_port = static_cast<uint16_t>(server_port + 4000);
+
+    H2cServer server(H2cServerBuilder()
+        .host("127.0.0.1")
+        .port(server_port)
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(0)
+        .staticResponse("/ping", H2StaticResponse{.content_type = "text/plain", .body = "pong"})
+        .activeConnHandler(bodyActiveHandler)
+        .build());
+    server.start();
+
+    DelayProxy proxy(proxy_port, server_port, std::chrono::milliseconds(rtt_ms));
+    if (!proxy.start()) {
+        std::cerr << "proxy listen failed\n";
+        server.stop();
+        return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::cout << "HTTP/2 adaptive receive window benchmark\n";
+    std::cout << "rtt_ms=" << rtt_ms
+              << " body_mib=" << body_mib
+              << " rounds=" << rounds
+              << " max_window_mib=" << max_window_mib << "\n";
+
+    const H2cClientConfig fixed = H2cClientBuilder().pingEnabled(false).buildConfig();
+    const H2cClientConfig adaptive = H2cClientBuilder()
+        .pingEnabled(false)
+        .adaptiveWindow(H2AdaptiveWindowConfig{
+            .enabled = true,
+            .max_window = static_cast<uint32_t>(max_window_mib * 1024 * 1024),
+            .max_stream_window = static_cast<uint32_t>(max_window_mib * 1024 * 1024),
+        })
+        .buildConfig();
+
+    const bool fixed_ok = runMode("fixed", fixed, proxy_port, rounds, body_bytes);
+    const bool adaptive_ok = runMode("adaptive", adaptive, proxy_port, rounds, body_bytes);
+
+    proxy.stop();
+    server.stop();
+    return fixed_ok && adaptive_ok ? 0 : 1;
+}
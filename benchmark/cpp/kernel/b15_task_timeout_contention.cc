@@ -5,12 +5,18 @@
  * 关键覆盖点：
  * - blocking callable 在成功和异常路径下的提交、完成、join 吞吐。
  * - timeout 与 IO completion 竞态裁决在 completion-wins / timeout-wins 两个分支下的开销。
+ * - 真实 socket 上 `.timeout()` 的截止时间开销：时间轮（wheel）与 io_uring LINK_TIMEOUT（linked）
+ *   两种模式下的 arm+cancel 往返吞吐和到期裁决吞吐；非 io_uring 后端只运行 wheel 模式。
  */
 
 #include <galay/cpp/galay-kernel/core/awaitable.h>
 #include <galay/cpp/galay-kernel/core/io_scheduler.hpp>
 #include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-kernel/async/async_tcp.h>
 
+#include <sys/socket.h>
+
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <iostream>
@@ -19,6 +25,7 @@
 
 #include "test/cpp/common/stdout_log.h"
 
+using namespace galay::async;
 using namespace galay::kernel;
 using namespace std::chrono_literals;
 
@@ -26,6 +33,8 @@ namespace {
 
 constexpr std::size_t kBlockingIterations = 20000;
 constexpr std::size_t kTimeoutIterations = 200000;
+constexpr std::size_t kDeadlineRoundTrips = 50000;
+constexpr std::size_t kDeadlineExpiries = 500;
 
 struct Sample {
     double elapsed_ms = 0.0;
@@ -197,6 +206,85 @@ void benchTimeoutWins()
             sample.ops_per_sec);
 }
 
+// 每次 send/readv 都带 1s 截止时间但总是先完成：测量截止时间的挂载与撤销开销。
+Task<std::size_t> deadlineRoundTrips(AsyncTcpSocket* writer, AsyncTcpSocket* reader)
+{
+    char out = 'x';
+    char in = 0;
+    std::array<struct iovec, 1> iovecs{{{&in, 1}}};
+    std::size_t completed = 0;
+    for (std::size_t i = 0; i < kDeadlineRoundTrips; ++i) {
+        auto sent = co_await writer->send(&out, 1).timeout(1s);
+        if (!sent.has_value()) {
+            break;
+        }
+        auto received = co_await reader->readv(iovecs).timeout(1s);
+        if (!received.has_value()) {
+            break;
+        }
+        ++completed;
+    }
+    co_return completed;
+}
+
+// 空 socket 上的 readv 必然到期：测量 timeout-wins 的完整裁决路径。
+Task<std::size_t> deadlineExpiries(AsyncTcpSocket* reader)
+{
+    char in = 0;
+    std::array<struct iovec, 1> iovecs{{{&in, 1}}};
+    std::size_t timed_out = 0;
+    for (std::size_t i = 0; i < kDeadlineExpiries; ++i) {
+        auto received = co_await reader->readv(iovecs).timeout(1ms);
+        if (!received.has_value() && IOError::contains(received.error().code(), kTimeout)) {
+            ++timed_out;
+        }
+    }
+    co_return timed_out;
+}
+
+void benchIODeadline(bool linked)
+{
+    const char* mode = linked ? "linked" : "wheel";
+    Runtime runtime = RuntimeBuilder()
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(0)
+        .ioUringLinkedTimeouts(linked)
+        .build();
+
+    int fds[2] = {-1, -1};
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) != 0) {
+        throw std::runtime_error("socketpair failed");
+    }
+    AsyncTcpSocket writer(GHandle{.fd = fds[0]});
+    AsyncTcpSocket reader(GHandle{.fd = fds[1]});
+
+    auto start = std::chrono::steady_clock::now();
+    auto completed = runtime.blockOn(deadlineRoundTrips(&writer, &reader));
+    if (!completed.has_value() || *completed != kDeadlineRoundTrips) {
+        throw std::runtime_error("deadline round trips did not complete");
+    }
+    const auto round_trip = makeSample(*completed, std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    auto expired = runtime.blockOn(deadlineExpiries(&reader));
+    if (!expired.has_value() || *expired != kDeadlineExpiries) {
+        throw std::runtime_error("deadline expiries did not all time out");
+    }
+    const auto expiry = makeSample(*expired, std::chrono::steady_clock::now() - start);
+    runtime.stop();
+
+    LogInfo("[IODeadline mode={}] round_trips={}, time={}ms, throughput={:.0f} rt/s",
+            mode,
+            *completed,
+            round_trip.elapsed_ms,
+            round_trip.ops_per_sec);
+    LogInfo("[IODeadline mode={}] expiries={}, time={}ms, avg={:.3f}ms/expiry",
+            mode,
+            *expired,
+            expiry.elapsed_ms,
+            expiry.elapsed_ms / static_cast<double>(*expired));
+}
+
 }  // namespace
 
 int main()
@@ -205,6 +293,10 @@ int main()
     benchSpawnBlockingException();
     benchTimeoutCompletionWins();
     benchTimeoutWins();
+    benchIODeadline(false);
+#if defined(USE_IOURING)
+    benchIODeadline(true);
+#endif
 
     std::cout << "B15-TaskTimeoutContention PASS\n";
     return 0;
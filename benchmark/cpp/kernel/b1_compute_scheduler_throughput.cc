@@ -1,7 +1,7 @@
 /**
  * @file b1_compute.cc
  * @brief 用途：压测 `ComputeScheduler` 在不同负载下的吞吐与延迟表现。
- * 关键覆盖点：空任务、轻重计算任务、不同调度器数量以及样本中位数统计。
+ * 关键覆盖点：空任务、轻重计算任务、不同调度器数量、倾斜负载下 work-stealing 池对比以及样本中位数统计。
  * 通过条件：预热与正式统计都能完成，输出性能结果且进程无崩溃、死锁或超时。
  */
 
@@ -16,6 +16,7 @@
 #include <iomanip>
 #include <thread>
 #include <memory>
+#include <span>
 #include "benchmark/cpp/common/benchmark_sync.h"
 #include <galay/cpp/galay-kernel/core/compute_scheduler.h>
 #include <galay/cpp/galay-kernel/core/task.h>
@@ -31,6 +32,7 @@ constexpr int HEAVY_THROUGHPUT_TASKS = 50000;
 constexpr int LATENCY_TASKS = 10000;         // 延迟测试任务数
 constexpr int COMPUTE_ITERATIONS = 1000;     // 计算密集型迭代次数
 constexpr std::size_t THROUGHPUT_SAMPLE_COUNT = 5;
+constexpr int SKEWED_TASKS = 20000;          // 倾斜负载任务数（全部提交给 0 号调度器）
 
 struct BenchState {
     std::atomic<int64_t> completed{0};
@@ -94,10 +96,17 @@ Task<void> latencyTask(BenchState* state,
 // ============== 多调度器管理器 ==============
 class SchedulerPool {
 public:
-    explicit SchedulerPool(int count) : m_count(count), m_next(0) {
+    explicit SchedulerPool(int count, bool work_stealing = false) : m_count(count), m_next(0) {
         m_schedulers.reserve(count);
         for (int i = 0; i < count; ++i) {
             m_schedulers.push_back(std::make_unique<ComputeScheduler>());
+            m_view.push_back(m_schedulers.back().get());
+        }
+        if (work_stealing) {
+            const std::span<ComputeScheduler* const> siblings{m_view.data(), m_view.size()};
+            for (size_t i = 0; i < siblings.size(); ++i) {
+                siblings[i]->configureStealDomain(siblings, i);
+            }
         }
     }
 
@@ -119,12 +128,25 @@ public:
         scheduleTask(*m_schedulers[idx], std::move(task));
     }
 
+    void spawnTo(int idx, Task<void> task) {
+        scheduleTask(*m_schedulers[idx % m_count], std::move(task));
+    }
+
+    uint64_t stealSuccesses() const {
+        uint64_t total = 0;
+        for (const auto& s : m_schedulers) {
+            total += s->stealStats().steal_successes;
+        }
+        return total;
+    }
+
     int count() const { return m_count; }
 
 private:
     int m_count;
     std::atomic<int> m_next;
     std::vector<std::unique_ptr<ComputeScheduler>> m_schedulers;
+    std::vector<ComputeScheduler*> m_view;
 };
 
 ThroughputSample measureThroughputSample(
@@ -264,6 +286,42 @@ void benchScalability() {
     }
 }
 
+// 倾斜负载测试：全部任务压到 0 号调度器，对比独立队列与 work-stealing 池
+void benchSkewed(int scheduler_count) {
+    LogInfo("--- Skewed Load Test (heavy compute, all tasks on scheduler 0) ---");
+
+    double baseline_throughput = 0;
+    for (bool stealing : {false, true}) {
+        SchedulerPool pool(scheduler_count, stealing);
+        pool.start();
+
+        galay::benchmark::CompletionLatch completion_latch(static_cast<std::size_t>(SKEWED_TASKS));
+        BenchState state;
+        state.completion_latch = &completion_latch;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < SKEWED_TASKS; ++i) {
+            pool.spawnTo(0, heavyComputeTask(&state));
+        }
+        completion_latch.wait();
+
+        const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        pool.stop();
+
+        const double throughput =
+            elapsed_ns > 0 ? (static_cast<double>(SKEWED_TASKS) * 1'000'000'000.0 / elapsed_ns) : 0.0;
+        if (!stealing) {
+            baseline_throughput = throughput;
+        }
+        LogInfo("  {}: schedulers={}, time={:.2f}ms, throughput={:.0f}/s, speedup={:.2f}x, steals={}",
+                stealing ? "stealing" : "isolated", scheduler_count,
+                static_cast<double>(elapsed_ns) / 1'000'000.0, throughput,
+                baseline_throughput > 0 ? throughput / baseline_throughput : 0.0,
+                pool.stealSuccesses());
+    }
+}
+
 // 持续压力测试
 void benchSustained(int scheduler_count, int duration_sec) {
     LogInfo("--- Sustained Load Test ({}s) ---", duration_sec);
@@ -356,7 +414,12 @@ int main(int argc, char* argv[]) {
 
     LogInfo("");
 
-    // 6. 持续压力测试
+    // 6. 倾斜负载测试
+    benchSkewed(scheduler_count);
+
+    LogInfo("");
+
+    // 7. 持续压力测试
     benchSustained(scheduler_count, 5);
 
     LogInfo("");
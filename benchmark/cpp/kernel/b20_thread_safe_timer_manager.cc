@@ -5,18 +5,46 @@
  * 关键覆盖点：
  * - future timer: push 后一次 tick 将 pending 队列批量入轮，不应提前触发。
  * - expired timer: push 后一次 tick 批量触发已过期定时器并清空 manager。
+ * - arm/cancel churn: 复用同一批定时器反复挂轮、取消、摘除，统计每次操作耗时与堆分配次数；
+ *   单线程时间轮走 erase() 即时解链，线程安全时间轮走 pending 入轮后惰性丢弃。
  */
 
+#include <galay/cpp/galay-kernel/common/timer_manager.hpp>
 #include <galay/cpp/galay-kernel/common/timer_manager_mt.hpp>
 
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <new>
 #include <vector>
 
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 using namespace galay::kernel;
 using namespace std::chrono_literals;
 
@@ -24,6 +52,8 @@ namespace {
 
 constexpr std::size_t kTimerCount = 100000;
 constexpr uint64_t kTickNs = 1'000'000ULL;
+constexpr std::size_t kChurnTimers = 4096;
+constexpr std::size_t kChurnRounds = 64;
 
 struct Sample {
     double elapsed_ms = 0.0;
@@ -130,6 +160,102 @@ bool benchExpiredPendingDrain()
     return true;
 }
 
+/**
+ * @brief 在计时区间之外预先构造 kChurnRounds 批定时器
+ * @details Timer 的过期时间首次查询后即固定，不能重新挂轮；把构造放到计时外，
+ *          churn 统计只反映挂轮/取消/摘除本身的开销与分配。
+ */
+std::vector<std::vector<Timer::ptr>> makeChurnBatches()
+{
+    std::vector<std::vector<Timer::ptr>> batches(kChurnRounds);
+    for (auto& batch : batches) {
+        batch.reserve(kChurnTimers);
+        for (std::size_t i = 0; i < kChurnTimers; ++i) {
+            // 分散在第1、2层，覆盖不同槽位的链接与解链
+            batch.push_back(std::make_shared<CBTimer>(
+                std::chrono::milliseconds(50 + (i % 2000)), []() {}));
+        }
+    }
+    return batches;
+}
+
+void printChurn(const char* name, std::size_t ops, std::size_t allocations,
+                std::chrono::steady_clock::duration elapsed)
+{
+    const auto elapsed_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::cout << name << " ops=" << ops
+              << " ns_per_op=" << std::fixed << std::setprecision(1)
+              << (ops > 0 ? static_cast<double>(elapsed_ns) / static_cast<double>(ops) : 0.0)
+              << " allocs_per_op=" << std::setprecision(3)
+              << (ops > 0 ? static_cast<double>(allocations) / static_cast<double>(ops) : 0.0)
+              << "\n";
+}
+
+bool benchWheelArmCancelChurn()
+{
+    TimingWheelTimerManager manager(kTickNs);
+    auto batches = makeChurnBatches();
+
+    const std::size_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto& batch : batches) {
+        for (auto& timer : batch) {
+            if (!manager.push(timer)) {
+                std::cerr << "[B20] wheel churn push failed\n";
+                return false;
+            }
+        }
+        for (auto& timer : batch) {
+            timer->cancel();
+            if (!manager.erase(*timer)) {
+                std::cerr << "[B20] wheel churn erase failed\n";
+                return false;
+            }
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const std::size_t allocations =
+        g_allocations.load(std::memory_order_relaxed) - allocations_before;
+
+    printChurn("TimingWheelArmCancelChurn", kChurnTimers * kChurnRounds * 2, allocations, elapsed);
+    if (!manager.empty() || allocations != 0) {
+        std::cerr << "[B20] wheel churn state mismatch size=" << manager.size()
+                  << " allocations=" << allocations << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool benchThreadSafeArmCancelChurn()
+{
+    ThreadSafeTimerManager manager(kTickNs);
+    auto batches = makeChurnBatches();
+
+    const std::size_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto& batch : batches) {
+        for (auto& timer : batch) {
+            if (!manager.push(timer)) {
+                std::cerr << "[B20] thread-safe churn push failed\n";
+                return false;
+            }
+        }
+        manager.tick();
+        for (auto& timer : batch) {
+            timer->cancel();
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const std::size_t allocations =
+        g_allocations.load(std::memory_order_relaxed) - allocations_before;
+
+    // 跨线程取消只置标志，已取消定时器仍占槽直到级联/到期时被丢弃。
+    printChurn("ThreadSafeArmCancelChurn", kChurnTimers * kChurnRounds * 2, allocations, elapsed);
+    std::cout << "ThreadSafeArmCancelChurn lazily_held=" << manager.wheelSize() << "\n";
+    return manager.pendingSize() == 0;
+}
+
 }  // namespace
 
 int main()
@@ -140,6 +266,12 @@ int main()
     if (!benchExpiredPendingDrain()) {
         return 1;
     }
+    if (!benchWheelArmCancelChurn()) {
+        return 1;
+    }
+    if (!benchThreadSafeArmCancelChurn()) {
+        return 1;
+    }
 
     std::cout << "B20-ThreadSafeTimerManager PASS\n";
     return 0;
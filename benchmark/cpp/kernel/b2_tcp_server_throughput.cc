@@ -154,12 +154,21 @@ int main(int argc, char* argv[]) {
     if (argc > 2) {
         scheduler_count = std::max(1, std::atoi(argv[2]));
     }
+    // 第三个参数：每个 ring 的 fixed file 表容量；仅 io_uring 生效，0 为普通 fd 提交。
+    uint32_t fixed_file_slots = 0;
+    if (argc > 3) {
+        fixed_file_slots = static_cast<uint32_t>(std::max(0, std::atoi(argv[3])));
+    }
+#if !defined(USE_IOURING)
+    fixed_file_slots = 0;
+#endif
 
     LogInfo("Benchmark Server starting on port {}", port);
-    LogInfo("meta: backend={}, build={}, role=server, io_mode=plain, scenario=tcp-echo",
+    LogInfo("meta: backend={}, build={}, role=server, io_mode={}, scenario=tcp-echo",
             benchmarkBackend(),
-            benchmarkBuildMode());
-    LogInfo("scheduler_count={}", scheduler_count);
+            benchmarkBuildMode(),
+            fixed_file_slots > 0 ? "fixed-file" : "plain");
+    LogInfo("scheduler_count={}, fixed_file_slots={}", scheduler_count, fixed_file_slots);
 
 #if defined(USE_KQUEUE)
     using IOSchedulerType = KqueueScheduler;
@@ -182,7 +191,14 @@ int main(int argc, char* argv[]) {
 
     Host bindHost(IPType::IPV4, "0.0.0.0", port);
     for (int i = 0; i < scheduler_count; ++i) {
+#if defined(USE_IOURING)
+        IOUringOptions uring_options;
+        uring_options.fixed_file_slots = fixed_file_slots;
+        auto scheduler = std::make_unique<IOSchedulerType>(
+            GALAY_SCHEDULER_QUEUE_DEPTH, GALAY_SCHEDULER_BATCH_SIZE, uring_options);
+#else
         auto scheduler = std::make_unique<IOSchedulerType>();
+#endif
         scheduler->start();
         schedulers.push_back(std::move(scheduler));
 
@@ -0,0 +1,199 @@
+/**
+ * @file b30_blocking_executor_throughput.cc
+ * @brief 用途：压测 `Runtime::spawnBlocking` 在大量协程并发提交时的吞吐与提交到执行延迟。
+ * 关键覆盖点：64 个提交协程分布在全部 IO scheduler 上、空阻塞任务吞吐、
+ * 提交到开始执行的 p50/p99/max 延迟、直接 BlockingExecutor::submit 的外部线程基线。
+ * 通过条件：所有任务完成并输出结果，进程无崩溃、死锁或超时。
+ *
+ * 用法：B30-BlockingExecutor [tasks_per_coroutine] [rounds]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "benchmark/cpp/common/benchmark_sync.h"
+#include <galay/cpp/galay-kernel/core/blocking_executor.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-kernel/core/task.h>
+#include "test/cpp/common/stdout_log.h"
+
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kSubmittingCoroutines = 64;
+constexpr int kDefaultTasksPerCoroutine = 2000;
+constexpr int kDefaultRounds = 3;
+constexpr int kExternalSubmitters = 8;
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchState {
+    std::vector<int64_t> latency_ns;  ///< 按任务编号写入，避免共享容器竞争
+    std::atomic<int> submitted{0};
+    std::atomic<int> rejected{0};
+    galay::benchmark::CompletionLatch latch;
+};
+
+int64_t sinceNs(Clock::time_point submitted_at)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - submitted_at).count();
+}
+
+Task<void> submitterTask(Runtime* runtime, BenchState* state, int first_id, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const int id = first_id + i;
+        const auto submitted_at = Clock::now();
+        auto handle = runtime->spawnBlocking([state, id, submitted_at]() {
+            state->latency_ns[static_cast<size_t>(id)] = sinceNs(submitted_at);
+            state->latch.arrive();
+        });
+        if (!handle) {
+            state->rejected.fetch_add(1, std::memory_order_relaxed);
+            state->latch.arrive();
+        }
+        state->submitted.fetch_add(1, std::memory_order_relaxed);
+    }
+    co_return;
+}
+
+struct RoundResult {
+    double elapsed_ms = 0.0;
+    double throughput = 0.0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+    bool valid = false;
+};
+
+RoundResult summarize(std::vector<int64_t>& latency_ns, Clock::time_point start)
+{
+    RoundResult result;
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    result.throughput = result.elapsed_ms > 0.0
+        ? static_cast<double>(latency_ns.size()) * 1000.0 / result.elapsed_ms
+        : 0.0;
+    std::sort(latency_ns.begin(), latency_ns.end());
+    const auto at = [&latency_ns](double quantile) {
+        const auto index = static_cast<size_t>(quantile * static_cast<double>(latency_ns.size() - 1));
+        return static_cast<double>(latency_ns[index]) / 1000.0;
+    };
+    result.p50_us = at(0.50);
+    result.p99_us = at(0.99);
+    result.max_us = at(1.0);
+    result.valid = true;
+    return result;
+}
+
+RoundResult runSpawnBlockingRound(Runtime& runtime, int tasks_per_coroutine)
+{
+    const int total = kSubmittingCoroutines * tasks_per_coroutine;
+    BenchState state;
+    state.latency_ns.assign(static_cast<size_t>(total), 0);
+    state.latch.reset(static_cast<size_t>(total));
+
+    const auto start = Clock::now();
+    for (int c = 0; c < kSubmittingCoroutines; ++c) {
+        auto* scheduler = runtime.getIOScheduler(static_cast<size_t>(c) % runtime.getIOSchedulerCount());
+        if (!scheduleTask(*scheduler, submitterTask(&runtime, &state, c * tasks_per_coroutine, tasks_per_coroutine))) {
+            LogError("failed to schedule submitter coroutine {}", c);
+            return {};
+        }
+    }
+    if (!state.latch.waitFor(60s)) {
+        LogError("spawnBlocking round timed out: submitted={}", state.submitted.load());
+        return {};
+    }
+    if (state.rejected.load() != 0) {
+        LogError("spawnBlocking rejected {} tasks", state.rejected.load());
+        return {};
+    }
+    return summarize(state.latency_ns, start);
+}
+
+RoundResult runExecutorRound(BlockingExecutor& executor, int total)
+{
+    const int per_thread = std::max(1, total / kExternalSubmitters);
+    BenchState state;
+    state.latency_ns.assign(static_cast<size_t>(per_thread * kExternalSubmitters), 0);
+    state.latch.reset(state.latency_ns.size());
+
+    const auto start = Clock::now();
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < kExternalSubmitters; ++t) {
+        submitters.emplace_back([&state, &executor, t, per_thread]() {
+            for (int i = 0; i < per_thread; ++i) {
+                const int id = t * per_thread + i;
+                const auto submitted_at = Clock::now();
+                auto submitted = executor.submit([&state, id, submitted_at]() {
+                    state.latency_ns[static_cast<size_t>(id)] = sinceNs(submitted_at);
+                    state.latch.arrive();
+                });
+                if (!submitted) {
+                    state.rejected.fetch_add(1, std::memory_order_relaxed);
+                    state.latch.arrive();
+                }
+            }
+        });
+    }
+    for (auto& submitter : submitters) {
+        submitter.join();
+    }
+    if (!state.latch.waitFor(60s) || state.rejected.load() != 0) {
+        LogError("executor round failed: rejected={}", state.rejected.load());
+        return {};
+    }
+    return summarize(state.latency_ns, start);
+}
+
+void report(const char* label, int round, const RoundResult& result)
+{
+    LogInfo("[{}] round={}, time={:.1f}ms, throughput={:.0f} tasks/s, submit_to_run p50={:.2f}us p99={:.2f}us max={:.2f}us",
+            label, round, result.elapsed_ms, result.throughput, result.p50_us, result.p99_us, result.max_us);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const int tasks_per_coroutine = argc > 1 ? std::max(1, std::atoi(argv[1])) : kDefaultTasksPerCoroutine;
+    const int rounds = argc > 2 ? std::max(1, std::atoi(argv[2])) : kDefaultRounds;
+
+    Runtime runtime = RuntimeBuilder().computeSchedulerCount(0).build();
+    if (!runtime.start()) {
+        LogError("runtime failed to start");
+        return 1;
+    }
+    LogInfo("[SpawnBlocking] io_schedulers={}, coroutines={}, tasks_per_coroutine={}",
+            runtime.getIOSchedulerCount(), kSubmittingCoroutines, tasks_per_coroutine);
+
+    (void)runSpawnBlockingRound(runtime, std::max(1, tasks_per_coroutine / 10));  // 预热：拉起工作线程
+    for (int round = 1; round <= rounds; ++round) {
+        const auto result = runSpawnBlockingRound(runtime, tasks_per_coroutine);
+        if (!result.valid) {
+            runtime.stop();
+            return 1;
+        }
+        report("SpawnBlocking", round, result);
+    }
+    runtime.stop();
+
+    BlockingExecutor executor;
+    const int total = kSubmittingCoroutines * tasks_per_coroutine;
+    (void)runExecutorRound(executor, total / 10);
+    for (int round = 1; round <= rounds; ++round) {
+        const auto result = runExecutorRound(executor, total);
+        if (!result.valid) {
+            return 1;
+        }
+        report("ExecutorSubmit", round, result);
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file b31_task_frame_pool.cc
+ * @brief 用途：压测嵌套 `co_await` 子任务时协程帧池对每请求堆分配次数与耗时的影响。
+ * 关键覆盖点：每个“请求”是一棵深度 kDepth、每层 kFanOut 个子任务的 co_await 树，
+ * 替换全局 operator new 统计请求期间的真实堆分配次数，并输出 TaskFramePoolStats。
+ * 通过条件：所有请求完成并输出结果；帧池开启时稳态每请求分配数应为 0。
+ *
+ * 用法：B31-TaskFramePool [requests] [rounds]
+ * 对照：以 -DGALAY_DISABLE_TASK_FRAME_POOL 重新编译后运行同一程序。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include <galay/cpp/galay-kernel/core/compute_scheduler.h>
+#include <galay/cpp/galay-kernel/core/task.h>
+
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (std::max(size, std::size_t{1}) + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kDepth = 4;
+constexpr int kFanOut = 2;
+constexpr int kDefaultRequests = 200000;
+constexpr int kDefaultRounds = 3;
+
+struct RoundResult {
+    std::size_t allocations = 0;
+    double elapsed_ms = 0.0;
+    TaskFramePoolStats before;
+    TaskFramePoolStats after;
+};
+
+Task<int> handlerTask(int depth, int seed)
+{
+    if (depth == 0) {
+        co_return seed & 0xff;
+    }
+    int sum = 0;
+    for (int i = 0; i < kFanOut; ++i) {
+        auto child = co_await handlerTask(depth - 1, seed * kFanOut + i);
+        sum += child.value_or(0);
+    }
+    co_return sum;
+}
+
+Task<void> driverTask(int requests, RoundResult* result, std::atomic<bool>* done)
+{
+    result->before = detail::currentThreadTaskFramePoolStats();
+    const std::size_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+    long long checksum = 0;
+    for (int r = 0; r < requests; ++r) {
+        auto value = co_await handlerTask(kDepth, r);
+        checksum += value.value_or(0);
+    }
+    result->elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    result->allocations = g_allocations.load(std::memory_order_relaxed) - allocations_before;
+    result->after = detail::currentThreadTaskFramePoolStats();
+    if (checksum < 0) {
+        std::cerr << "[B31] unexpected checksum\n";
+    }
+    done->store(true, std::memory_order_release);
+}
+
+bool runRound(ComputeScheduler& scheduler, int requests, RoundResult& result)
+{
+    std::atomic<bool> done{false};
+    if (!scheduleTask(scheduler, driverTask(requests, &result, &done))) {
+        std::cerr << "[B31] failed to schedule driver\n";
+        return false;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + 120s;
+    while (!done.load(std::memory_order_acquire)) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            std::cerr << "[B31] round timed out\n";
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+void report(int round, int requests, const RoundResult& result)
+{
+    constexpr int kFramesPerRequest = [] {
+        int frames = 0;
+        for (int level = 0, width = 1; level <= kDepth; ++level, width *= kFanOut) {
+            frames += width;
+        }
+        return frames;
+    }();
+    std::cout << "[NestedAwait] round=" << round
+              << " requests=" << requests
+              << " frames_per_request=" << kFramesPerRequest
+              << " time_ms=" << result.elapsed_ms
+              << " ns_per_request=" << result.elapsed_ms * 1e6 / requests
+              << " allocs_per_request=" << static_cast<double>(result.allocations) / requests
+              << " pool_hits=" << result.after.hits - result.before.hits
+              << " pool_misses=" << result.after.misses - result.before.misses
+              << " bytes_cached=" << result.after.bytes_cached
+              << " bytes_reserved=" << result.after.bytes_reserved << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const int requests = argc > 1 ? std::max(1, std::atoi(argv[1])) : kDefaultRequests;
+    const int rounds = argc > 2 ? std::max(1, std::atoi(argv[2])) : kDefaultRounds;
+
+#ifdef GALAY_DISABLE_TASK_FRAME_POOL
+    std::cout << "[B31] task frame pool: disabled\n";
+#else
+    std::cout << "[B31] task frame pool: enabled\n";
+#endif
+
+    ComputeScheduler scheduler;
+    if (!scheduler.start().has_value()) {
+        std::cerr << "[B31] scheduler failed to start\n";
+        return 1;
+    }
+
+    RoundResult warmup;
+    if (!runRound(scheduler, std::max(1, requests / 100), warmup)) {
+        scheduler.stop();
+        return 1;
+    }
+    for (int round = 1; round <= rounds; ++round) {
+        RoundResult result;
+        if (!runRound(scheduler, requests, result)) {
+            scheduler.stop();
+            return 1;
+        }
+        report(round, requests, result);
+    }
+    scheduler.stop();
+    return 0;
+}
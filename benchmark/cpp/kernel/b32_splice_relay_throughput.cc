@@ -0,0 +1,258 @@
+/**
+ * @file b32_splice_relay_throughput.cc
+ * @brief 用途：对比 `spliceRelay` 零拷贝转发与用户态 `recv+send` 拷贝转发的吞吐与 CPU 开销。
+ * 关键覆盖点：生产线程 → 回环 TCP → 调度器内转发协程 → 回环 TCP → 消费线程，
+ * 两种转发路径搬运相同字节数，分别统计墙钟吞吐、转发线程 CPU（RUSAGE_THREAD）与进程 CPU。
+ * 通过条件：两种路径都完整搬运全部字节并输出对比数据，进程返回 0。
+ *
+ * 用法：B32-SpliceRelayThroughput [megabytes] [chunk_kb]
+ * 说明：chunk_kb 同时决定拷贝缓冲区与 splice 管道容量（受 /proc/sys/fs/pipe-max-size 限制），默认 1024；
+ *       管道越大，每次 splice 搬运的 skb 片段越多，splice 路径的系统调用与 CPU 越少。
+ *       io_uring 后端的 splice 可能由内核 io-wq 线程执行，其 CPU 只计入进程 CPU。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <galay/cpp/galay-kernel/async/splice_relay.h>
+#include <galay/cpp/galay-kernel/core/task.h>
+
+#ifdef USE_KQUEUE
+#include <galay/cpp/galay-kernel/core/kqueue_scheduler.h>
+using IOSchedulerType = galay::kernel::KqueueScheduler;
+#endif
+
+#ifdef USE_EPOLL
+#include <galay/cpp/galay-kernel/core/epoll_scheduler.h>
+using IOSchedulerType = galay::kernel::EpollScheduler;
+#endif
+
+#ifdef USE_IOURING
+#include <galay/cpp/galay-kernel/core/uring_scheduler.h>
+using IOSchedulerType = galay::kernel::IOUringScheduler;
+#endif
+
+using namespace galay::async;
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t kDefaultMegabytes = 2048;
+constexpr size_t kDefaultChunkKb = 1024;
+
+struct RelayRun {
+    bool ok = false;
+    bool spliced = false;
+    size_t bytes = 0;
+    double relay_cpu_ms = 0.0;
+};
+
+double cpuMs(int who)
+{
+    rusage usage{};
+    if (::getrusage(who, &usage) != 0) {
+        return 0.0;
+    }
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+}
+
+bool makeTcpPair(int& a, int& b)
+{
+    a = -1;
+    b = -1;
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return false;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 1) != 0 ||
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        ::close(listener);
+        return false;
+    }
+    b = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (b < 0 || ::connect(b, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(listener);
+        return false;
+    }
+    a = ::accept(listener, nullptr, nullptr);
+    ::close(listener);
+    if (a < 0) {
+        return false;
+    }
+    const int flags = ::fcntl(a, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(a, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// 对照组：与 spliceRelay 退回路径相同的用户态拷贝循环
+Task<std::expected<size_t, IOError>> copyRelay(AsyncTcpSocket& from, AsyncTcpSocket& to, size_t chunk_size)
+{
+    std::vector<char> buffer(chunk_size);
+    size_t total = 0;
+    while (true) {
+        auto recv_result = co_await from.recv(buffer.data(), buffer.size());
+        if (!recv_result) {
+            co_return std::unexpected(recv_result.error());
+        }
+        const size_t bytes = recv_result.value();
+        if (bytes == 0) {
+            co_return total;
+        }
+        size_t offset = 0;
+        while (offset < bytes) {
+            auto send_result = co_await to.send(buffer.data() + offset, bytes - offset);
+            if (!send_result) {
+                co_return std::unexpected(send_result.error());
+            }
+            offset += send_result.value();
+        }
+        total += bytes;
+    }
+}
+
+Task<void> relayTask(int src, int dst, bool use_splice, size_t chunk_size,
+                     RelayRun* run, std::atomic<bool>* done)
+{
+    AsyncTcpSocket from{GHandle{.fd = src}};
+    AsyncTcpSocket to{GHandle{.fd = dst}};
+    const double cpu_before = cpuMs(RUSAGE_THREAD);
+
+    if (use_splice) {
+        SpliceRelayOptions options;
+        options.chunkSize = chunk_size;
+        options.shutdownWrite = true;
+        auto result = co_await spliceRelay(from, to, options);
+        if (result && result.value()) {
+            run->ok = true;
+            run->bytes = result.value().value().bytes;
+            run->spliced = result.value().value().spliced;
+        }
+    } else {
+        auto result = co_await copyRelay(from, to, chunk_size);
+        if (result && result.value()) {
+            run->ok = true;
+            run->bytes = result.value().value();
+        }
+        ::shutdown(dst, SHUT_WR);
+    }
+
+    run->relay_cpu_ms = cpuMs(RUSAGE_THREAD) - cpu_before;
+    co_await from.close();
+    co_await to.close();
+    done->store(true, std::memory_order_release);
+}
+
+bool runOnce(IOSchedulerType& scheduler, bool use_splice, size_t total_bytes, size_t chunk_size)
+{
+    int src = -1;
+    int src_peer = -1;
+    int dst = -1;
+    int dst_peer = -1;
+    if (!makeTcpPair(src, src_peer) || !makeTcpPair(dst, dst_peer)) {
+        std::cerr << "tcp pair failed\n";
+        return false;
+    }
+
+    std::atomic<size_t> received{0};
+    std::thread producer([src_peer, total_bytes] {
+        std::vector<char> chunk(256 * 1024, 'x');
+        size_t written = 0;
+        while (written < total_bytes) {
+            const size_t n = std::min(chunk.size(), total_bytes - written);
+            const ssize_t rc = ::send(src_peer, chunk.data(), n, MSG_NOSIGNAL);
+            if (rc <= 0) {
+                break;
+            }
+            written += static_cast<size_t>(rc);
+        }
+        ::close(src_peer);
+    });
+    std::thread consumer([dst_peer, &received] {
+        std::vector<char> chunk(256 * 1024);
+        while (true) {
+            const ssize_t rc = ::recv(dst_peer, chunk.data(), chunk.size(), 0);
+            if (rc <= 0) {
+                break;
+            }
+            received.fetch_add(static_cast<size_t>(rc), std::memory_order_relaxed);
+        }
+        ::close(dst_peer);
+    });
+
+    RelayRun run;
+    std::atomic<bool> done{false};
+    const double process_cpu_before = cpuMs(RUSAGE_SELF);
+    const auto start = std::chrono::steady_clock::now();
+    if (!scheduleTask(scheduler, relayTask(src, dst, use_splice, chunk_size, &run, &done))) {
+        std::cerr << "schedule failed\n";
+        return false;
+    }
+    while (!done.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(1ms);
+    }
+    producer.join();
+    consumer.join();
+    const double elapsed_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const double process_cpu_ms = cpuMs(RUSAGE_SELF) - process_cpu_before;
+
+    const double mib = static_cast<double>(run.bytes) / (1024.0 * 1024.0);
+    std::cout << std::left << std::setw(10) << (use_splice ? (run.spliced ? "splice" : "fallback") : "copy")
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << mib << " MiB"
+              << std::setw(10) << elapsed_ms << " ms"
+              << std::setw(10) << (mib * 1000.0 / elapsed_ms) << " MiB/s"
+              << "  relay-cpu " << std::setw(8) << run.relay_cpu_ms << " ms"
+              << "  process-cpu " << std::setw(8) << process_cpu_ms << " ms"
+              << "  cpu/GiB " << std::setw(7) << (run.relay_cpu_ms * 1024.0 / std::max(mib, 1.0)) << " ms\n";
+
+    return run.ok && run.bytes == total_bytes && received.load() == total_bytes;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : kDefaultMegabytes;
+    const size_t chunk_kb = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : kDefaultChunkKb;
+    const size_t total_bytes = std::max<size_t>(megabytes, 1) * 1024 * 1024;
+    const size_t chunk_size = std::max<size_t>(chunk_kb, 4) * 1024;
+
+    IOSchedulerType scheduler;
+    auto started = scheduler.start();
+    if (!started) {
+        std::cerr << "scheduler start failed: " << started.error().message() << "\n";
+        return 1;
+    }
+
+    std::cout << "B32-SpliceRelayThroughput bytes=" << total_bytes << " chunk=" << chunk_size << "\n";
+    const bool copy_ok = runOnce(scheduler, false, total_bytes, chunk_size);
+    const bool splice_ok = runOnce(scheduler, true, total_bytes, chunk_size);
+    scheduler.stop();
+
+    if (!copy_ok || !splice_ok) {
+        std::cerr << "relay incomplete\n";
+        return 1;
+    }
+    return 0;
+}
@@ -1,7 +1,8 @@
 /**
  * @file b4_udp.cc
  * @brief 用途：作为 UDP 压测服务端，承接高并发报文收发负载。
- * 关键覆盖点：端口绑定、报文接收与回发、多 worker 协作和字节统计。
+ * 关键覆盖点：端口绑定、报文接收与回发、多 worker 协作和字节统计；
+ * 批量大小 >1 时以 recvBatch/sendBatch 回发（常用 1/16/64 对比）。
  * 通过条件：服务端可持续响应压测流量并输出统计，停止后干净退出。
  */
 
@@ -10,8 +11,10 @@
 #include <atomic>
 #include <chrono>
 #include <csignal>
+#include <span>
 #include <string_view>
 #include <thread>
+#include <vector>
 #include <galay/cpp/galay-kernel/async/async_udp.h>
 #include <galay/cpp/galay-kernel/core/task.h>
 #include "test/cpp/common/stdout_log.h"
@@ -41,6 +44,8 @@ std::atomic<bool> g_running{true};
 // 配置参数
 constexpr int NUM_SERVER_WORKERS = 4;      // 服务器工作协程数量
 int g_server_port = 9090;                  // 服务器端口
+size_t g_batch_size = 1;                   // 批量大小；1 走 recvfrom/sendto
+constexpr size_t BATCH_SLOT_SIZE = 2048;   // 批量模式下每个接收槽位的缓冲大小
 
 // 全局调度器指针，用于信号处理
 IOScheduler* g_scheduler = nullptr;
@@ -75,8 +80,46 @@ Task<void> udpServerWorker(int worker_id) {
         LogInfo("UDP Server workers started on 0.0.0.0:{}", g_server_port);
     }
 
+    if (g_batch_size > 1) {
+        std::vector<char> storage(g_batch_size * BATCH_SLOT_SIZE);
+        std::vector<UdpRecvDatagram> slots(g_batch_size);
+        std::vector<UdpSendDatagram> replies(g_batch_size);
+        for (size_t i = 0; i < g_batch_size; ++i) {
+            slots[i].buffer = storage.data() + i * BATCH_SLOT_SIZE;
+            slots[i].capacity = BATCH_SLOT_SIZE;
+        }
+        while (g_running.load(std::memory_order_relaxed)) {
+            auto recvResult = co_await socket.recvBatch(slots);
+            if (!recvResult) {
+                break;
+            }
+            const size_t received = recvResult.value();
+            for (size_t i = 0; i < received; ++i) {
+                replies[i].buffer = slots[i].buffer;
+                replies[i].length = slots[i].length;
+                replies[i].to = slots[i].from;
+                g_total_bytes_received.fetch_add(slots[i].length, std::memory_order_relaxed);
+            }
+            g_total_received.fetch_add(received, std::memory_order_relaxed);
+
+            size_t offset = 0;
+            while (offset < received) {
+                auto sendResult = co_await socket.sendBatch(
+                    std::span<const UdpSendDatagram>(replies.data() + offset, received - offset));
+                if (!sendResult) {
+                    break;
+                }
+                for (size_t i = 0; i < sendResult.value(); ++i) {
+                    g_total_bytes_sent.fetch_add(replies[offset + i].length, std::memory_order_relaxed);
+                }
+                g_total_sent.fetch_add(sendResult.value(), std::memory_order_relaxed);
+                offset += sendResult.value();
+            }
+        }
+    }
+
     char buffer[65536];
-    while (g_running.load(std::memory_order_relaxed)) {
+    while (g_batch_size == 1 && g_running.load(std::memory_order_relaxed)) {
         Host from;
         auto recvResult = co_await socket.recvfrom(buffer, sizeof(buffer), &from);
 
@@ -147,21 +190,28 @@ void statsReporter() {
 
 int main(int argc, char* argv[]) {
     if (argc == 2 && std::string_view(argv[1]) == "--help") {
-        std::cout << "Usage: " << argv[0] << " [port]\n";
+        std::cout << "Usage: " << argv[0] << " [port] [batch]\n";
         return 0;
     }
-    if (argc > 2) {
+    if (argc > 3) {
         return 1;
     }
-    if (argc == 2) {
+    if (argc >= 2) {
         const int parsed_port = std::atoi(argv[1]);
         if (parsed_port < 1 || parsed_port > 65535) {
             return 1;
         }
         g_server_port = parsed_port;
     }
+    if (argc == 3) {
+        const int parsed_batch = std::atoi(argv[2]);
+        if (parsed_batch < 1 || parsed_batch > 1024) {
+            return 1;
+        }
+        g_batch_size = static_cast<size_t>(parsed_batch);
+    }
     LogInfo("UDP Echo Server (Benchmark Mode)");
-    LogInfo("Configuration: {} workers, port {}", NUM_SERVER_WORKERS, g_server_port);
+    LogInfo("Configuration: {} workers, port {}, batch {}", NUM_SERVER_WORKERS, g_server_port, g_batch_size);
 
     // 注册信号处理
     signal(SIGINT, signalHandler);
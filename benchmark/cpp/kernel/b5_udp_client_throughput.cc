@@ -1,16 +1,19 @@
 /**
  * @file b5_udp.cc
  * @brief 用途：作为 UDP 压测客户端，发起多客户端报文发送并统计回包结果。
- * 关键覆盖点：多客户端并发、报文大小与时长参数、收发计数与吞吐统计。
+ * 关键覆盖点：多客户端并发、报文大小与时长参数、收发计数与吞吐统计；
+ * -b 大于 1 时以 sendBatch/recvBatch 收发整条流水线（常用 1/16/64 对比）。
  * 通过条件：客户端完成设定压测周期并输出统计结果，进程干净退出。
  */
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <atomic>
 #include <chrono>
 #include <vector>
 #include <csignal>
+#include <span>
 #include <galay/cpp/galay-kernel/async/async_udp.h>
 #include <galay/cpp/galay-kernel/core/task.h>
 #include "test/cpp/common/stdout_log.h"
@@ -45,6 +48,7 @@ int g_message_size = 256;          // 消息大小（字节）
 int g_test_duration_sec = 5;       // 测试持续时间（秒）
 std::string g_server_host = "127.0.0.1";  // 服务器地址
 int g_server_port = 9090;          // 服务器端口
+int g_batch_size = 1;              // 批量大小；1 走 sendto/recvfrom
 
 // 全局调度器指针
 IOScheduler* g_scheduler = nullptr;
@@ -77,10 +81,54 @@ Task<void> udpBenchmarkClient(int client_id) {
     uint64_t local_sent = 0;
     uint64_t local_received = 0;
 
+    if (g_batch_size > 1) {
+        const size_t batch_size = static_cast<size_t>(g_batch_size);
+        std::vector<UdpSendDatagram> requests(batch_size);
+        for (auto& request : requests) {
+            request.buffer = message.data();
+            request.length = static_cast<size_t>(g_message_size);
+            request.to = serverHost;
+        }
+        // 回包与请求等长，槽位按消息大小分配，避免 64 路 × 多客户端各占 64KB
+        const size_t slot_size = std::max<size_t>(static_cast<size_t>(g_message_size), 2048);
+        std::vector<char> storage(batch_size * slot_size);
+        std::vector<UdpRecvDatagram> slots(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            slots[i].buffer = storage.data() + i * slot_size;
+            slots[i].capacity = slot_size;
+        }
+
+        for (int batch = 0; batch < g_messages_per_client / g_batch_size && g_running.load(std::memory_order_relaxed); ++batch) {
+            size_t offset = 0;
+            while (offset < batch_size) {
+                auto sendResult = co_await socket.sendBatch(
+                    std::span<const UdpSendDatagram>(requests.data() + offset, batch_size - offset));
+                if (!sendResult) {
+                    break;
+                }
+                offset += sendResult.value();
+            }
+            local_sent += offset;
+
+            // UDP 存在丢包，使用超时避免单个丢包导致客户端协程永久阻塞。
+            size_t received = 0;
+            while (received < offset && g_running.load(std::memory_order_relaxed)) {
+                auto recvResult = co_await socket.recvBatch(
+                    std::span<UdpRecvDatagram>(slots.data(), offset - received))
+                        .timeout(std::chrono::milliseconds(50));
+                if (!recvResult) {
+                    break;
+                }
+                received += recvResult.value();
+            }
+            local_received += received;
+        }
+    }
+
     // 流水线模式：先发送一批，再接收一批
     constexpr int PIPELINE_SIZE = 10;  // 流水线深度
 
-    for (int batch = 0; batch < g_messages_per_client / PIPELINE_SIZE && g_running.load(std::memory_order_relaxed); ++batch) {
+    for (int batch = 0; g_batch_size == 1 && batch < g_messages_per_client / PIPELINE_SIZE && g_running.load(std::memory_order_relaxed); ++batch) {
         // 批量发送
         for (int i = 0; i < PIPELINE_SIZE; ++i) {
             auto sendResult = co_await socket.sendto(message.data(), g_message_size, serverHost);
@@ -130,6 +178,7 @@ void printBenchmarkResults(std::chrono::steady_clock::time_point start_time) {
     LogInfo("Concurrent Clients: {}", g_num_clients);
     LogInfo("Messages per Client: {}", g_messages_per_client);
     LogInfo("Message Size: {} bytes", g_message_size);
+    LogInfo("Batch Size: {}", g_batch_size);
     LogInfo("");
     LogInfo("Total Packets Sent: {}", total_sent);
     LogInfo("Total Packets Received: {}", total_received);
@@ -158,6 +207,7 @@ void printUsage(const char* program_name) {
               << "  -m, --messages <num>    Messages per client (default: 1000)\n"
               << "  -s, --size <bytes>      Message size in bytes (default: 256)\n"
               << "  -d, --duration <sec>    Test duration in seconds (default: 5)\n"
+              << "  -b, --batch <num>       Datagrams per recvBatch/sendBatch, e.g. 1/16/64 (default: 1)\n"
               << "  --help                  Show this help message\n";
 }
 
@@ -180,6 +230,12 @@ int main(int argc, char* argv[]) {
             g_message_size = std::atoi(argv[++i]);
         } else if ((arg == "-d" || arg == "--duration") && i + 1 < argc) {
             g_test_duration_sec = std::atoi(argv[++i]);
+        } else if ((arg == "-b" || arg == "--batch") && i + 1 < argc) {
+            g_batch_size = std::atoi(argv[++i]);
+            if (g_batch_size < 1) {
+                std::cerr << "Invalid batch size: " << g_batch_size << "\n";
+                return 1;
+            }
         } else {
             std::cerr << "Unknown option: " << arg << "\n";
             printUsage(argv[0]);
@@ -188,8 +244,8 @@ int main(int argc, char* argv[]) {
     }
 
     LogInfo("UDP Benchmark Client");
-    LogInfo("Configuration: {} clients, {} messages/client, {} bytes/message",
-            g_num_clients, g_messages_per_client, g_message_size);
+    LogInfo("Configuration: {} clients, {} messages/client, {} bytes/message, batch {}",
+            g_num_clients, g_messages_per_client, g_message_size, g_batch_size);
     LogInfo("Target Server: {}:{}", g_server_host, g_server_port);
 
     // 注册信号处理
@@ -1,7 +1,8 @@
 /**
  * @file b6_udp.cc
  * @brief 用途：执行 UDP 自闭环压测，统计 runtime 模型下的整体收发性能。
- * 关键覆盖点：同进程 server/client 协作、吞吐与字节统计、完成同步与收尾。
+ * 关键覆盖点：同进程 server/client 协作、吞吐与字节统计、完成同步与收尾；
+ * 依次以批量大小 1（recvfrom/sendto）、16、64（recvBatch/sendBatch）各跑一轮。
  * 通过条件：预热与正式压测都能完成，输出结果且进程无异常退出。
  */
 
@@ -9,7 +10,9 @@
 #include <cstring>
 #include <atomic>
 #include <chrono>
+#include <array>
 #include <limits>
+#include <span>
 #include <vector>
 #include "benchmark/cpp/common/benchmark_sync.h"
 #include <galay/cpp/galay-kernel/async/async_udp.h>
@@ -55,6 +58,8 @@ constexpr int NUM_SERVER_WORKERS = 4;      // 服务器工作协程数量
 constexpr auto CLIENT_RECV_TIMEOUT = std::chrono::milliseconds(50);
 constexpr auto CLIENT_DRAIN_TIMEOUT = std::chrono::milliseconds(250);
 constexpr auto SERVER_RECV_TIMEOUT = std::chrono::milliseconds(100);
+constexpr std::array<size_t, 3> BATCH_SIZES{1, 16, 64};  // 每轮的批量大小；1 走单数据报 awaitable
+constexpr size_t BATCH_SLOT_SIZE = 2048;   // 批量模式下每个接收槽位的缓冲大小
 
 struct UdpStatsSnapshot {
     uint64_t client_sent = 0;
@@ -87,8 +92,55 @@ UdpStatsSnapshot snapshotStats() {
     };
 }
 
+// 批量 echo：一次 recvBatch 收取多条，再用 sendBatch 原样回发
+Task<void> udpServerBatchLoop(AsyncUdpSocket& socket, size_t batch) {
+    std::vector<char> storage(batch * BATCH_SLOT_SIZE);
+    std::vector<UdpRecvDatagram> slots(batch);
+    std::vector<UdpSendDatagram> replies(batch);
+    for (size_t i = 0; i < batch; ++i) {
+        slots[i].buffer = storage.data() + i * BATCH_SLOT_SIZE;
+        slots[i].capacity = BATCH_SLOT_SIZE;
+    }
+
+    while (g_running.load(std::memory_order_relaxed)) {
+        auto recvResult = co_await socket.recvBatch(slots).timeout(SERVER_RECV_TIMEOUT);
+        if (!recvResult) {
+            if (IOError::contains(recvResult.error().code(), kTimeout)) {
+                continue;
+            }
+            addCounter(g_errors);
+            break;
+        }
+
+        const size_t received = recvResult.value();
+        for (size_t i = 0; i < received; ++i) {
+            replies[i].buffer = slots[i].buffer;
+            replies[i].length = slots[i].length;
+            replies[i].to = slots[i].from;
+            addCounter(g_server_bytes_received, slots[i].length);
+        }
+        addCounter(g_server_received, received);
+
+        size_t offset = 0;
+        while (offset < received) {
+            auto sendResult = co_await socket.sendBatch(
+                std::span<const UdpSendDatagram>(replies.data() + offset, received - offset));
+            if (!sendResult) {
+                addCounter(g_errors);
+                break;
+            }
+            for (size_t i = 0; i < sendResult.value(); ++i) {
+                addCounter(g_server_bytes_sent, replies[offset + i].length);
+            }
+            addCounter(g_server_sent, sendResult.value());
+            offset += sendResult.value();
+        }
+    }
+    co_return;
+}
+
 // UDP Echo服务器工作协程 - 多协程并发处理
-Task<void> udpServerWorker(int worker_id) {
+Task<void> udpServerWorker(int worker_id, size_t batch) {
     auto socket_result = AsyncUdpSocket::create();
     if (!socket_result) {
         addCounter(g_errors);
@@ -141,8 +193,12 @@ Task<void> udpServerWorker(int worker_id) {
         LogInfo("UDP Server workers started on 127.0.0.1:9090");
     }
 
+    if (batch > 1) {
+        co_await udpServerBatchLoop(socket, batch);
+    }
+
     char buffer[65536];
-    while (g_running.load(std::memory_order_relaxed)) {
+    while (batch == 1 && g_running.load(std::memory_order_relaxed)) {
         Host from;
         auto recvResult = co_await socket.recvfrom(buffer, sizeof(buffer), &from)
                                 .timeout(SERVER_RECV_TIMEOUT);
@@ -179,8 +235,66 @@ Task<void> udpServerWorker(int worker_id) {
     co_return;
 }
 
+// 批量客户端：一次 sendBatch 发出整条流水线，再用 recvBatch 收回
+Task<void> udpClientBatchLoop(AsyncUdpSocket& socket,
+                              const Host& serverHost,
+                              const std::vector<char>& message,
+                              size_t batch,
+                              uint64_t& local_sent,
+                              uint64_t& local_received) {
+    std::vector<UdpSendDatagram> requests(batch);
+    for (auto& request : requests) {
+        request.buffer = message.data();
+        request.length = MESSAGE_SIZE;
+        request.to = serverHost;
+    }
+    std::vector<char> storage(batch * BATCH_SLOT_SIZE);
+    std::vector<UdpRecvDatagram> slots(batch);
+    for (size_t i = 0; i < batch; ++i) {
+        slots[i].buffer = storage.data() + i * BATCH_SLOT_SIZE;
+        slots[i].capacity = BATCH_SLOT_SIZE;
+    }
+
+    while (g_running.load(std::memory_order_relaxed)) {
+        size_t offset = 0;
+        while (offset < batch) {
+            auto sendResult = co_await socket.sendBatch(
+                std::span<const UdpSendDatagram>(requests.data() + offset, batch - offset));
+            if (!sendResult) {
+                addCounter(g_errors);
+                break;
+            }
+            offset += sendResult.value();
+        }
+        local_sent += offset;
+        addCounter(g_client_sent, offset);
+        addCounter(g_client_bytes_sent, offset * MESSAGE_SIZE);
+
+        // UDP 丢包时也要保证 benchmark 可以收敛退出，不要永久卡在 recvBatch。
+        size_t received = 0;
+        while (received < offset && g_running.load(std::memory_order_relaxed)) {
+            auto recvResult = co_await socket.recvBatch(
+                std::span<UdpRecvDatagram>(slots.data(), offset - received))
+                    .timeout(CLIENT_RECV_TIMEOUT);
+            if (!recvResult) {
+                if (!IOError::contains(recvResult.error().code(), kTimeout)) {
+                    addCounter(g_errors);
+                }
+                break;
+            }
+            for (size_t i = 0; i < recvResult.value(); ++i) {
+                addCounter(g_client_bytes_received, slots[i].length);
+            }
+            received += recvResult.value();
+            addCounter(g_client_received, recvResult.value());
+        }
+        local_received += received;
+    }
+    co_return;
+}
+
 // UDP客户端协程 - 流水线模式
-Task<void> udpBenchmarkClient(int client_id) {
+Task<void> udpBenchmarkClient(int client_id, size_t batch) {
     auto socket_result = AsyncUdpSocket::create();
     if (!socket_result) {
         addCounter(g_errors);
@@ -229,10 +343,14 @@ Task<void> udpBenchmarkClient(int client_id) {
     uint64_t local_sent = 0;
     uint64_t local_received = 0;
 
+    if (batch > 1) {
+        co_await udpClientBatchLoop(socket, serverHost, message, batch, local_sent, local_received);
+    }
+
     // 流水线模式：先发送一批，再接收一批
     constexpr int PIPELINE_SIZE = 10;  // 流水线深度
 
-    while (g_running.load(std::memory_order_relaxed)) {
+    while (batch == 1 && g_running.load(std::memory_order_relaxed)) {
         // 批量发送
         for (int i = 0; i < PIPELINE_SIZE; ++i) {
             if (!g_running.load(std::memory_order_relaxed)) {
@@ -295,7 +413,8 @@ Task<void> udpBenchmarkClient(int client_id) {
     co_return;
 }
 
-void printBenchmarkResults(std::chrono::steady_clock::time_point measurement_start,
+void printBenchmarkResults(size_t batch,
+                           std::chrono::steady_clock::time_point measurement_start,
                            std::chrono::steady_clock::time_point measurement_end,
                            const UdpStatsSnapshot& measured,
                            const UdpStatsSnapshot& settled) {
@@ -308,6 +427,7 @@ void printBenchmarkResults(std::chrono::steady_clock::time_point measurement_sta
     LogInfo("Concurrent Clients: {}", NUM_CLIENTS);
     LogInfo("Server Workers: {}", NUM_SERVER_WORKERS);
     LogInfo("Message Size: {} bytes", MESSAGE_SIZE);
+    LogInfo("Batch Size: {}{}", batch, batch == 1 ? " (recvfrom/sendto)" : " (recvBatch/sendBatch)");
     LogInfo("");
     LogInfo("Measurement window client: sent={} ({:.2f} pkt/s, {:.2f} MB/s), received={} ({:.2f} pkt/s, {:.2f} MB/s)",
             measured.client_sent,
@@ -334,32 +454,7 @@ void printBenchmarkResults(std::chrono::steady_clock::time_point measurement_sta
     LogInfo("=======================================================\n");
 }
 
-int main() {
-    LogInfo("UDP Socket Benchmark Test (Optimized)");
-    LogInfo("Configuration: {} clients, {} workers, {} bytes/message, {} seconds",
-            NUM_CLIENTS, NUM_SERVER_WORKERS, MESSAGE_SIZE, TEST_DURATION_SEC);
-
-#ifdef USE_KQUEUE
-    LogInfo("Using KqueueScheduler (macOS)");
-    KqueueScheduler scheduler;
-#elif defined(USE_EPOLL)
-    LogInfo("Using EpollScheduler (Linux)");
-    EpollScheduler scheduler;
-#elif defined(USE_IOURING)
-    LogInfo("Using IOUringScheduler (Linux io_uring)");
-    IOUringScheduler scheduler;
-#else
-    LogError("This benchmark requires kqueue (macOS), epoll or io_uring (Linux)");
-    return 1;
-#endif
-
-    const auto started = scheduler.start();
-    if (!started) {
-        LogError("Scheduler failed to start: {}", started.error().message());
-        return 1;
-    }
-    LogInfo("Scheduler started");
-
+bool runBenchmarkRound(IOScheduler& scheduler, size_t batch) {
     g_running.store(true, std::memory_order_relaxed);
     g_client_sent.store(0, std::memory_order_relaxed);
     g_client_received.store(0, std::memory_order_relaxed);
@@ -379,12 +474,12 @@ int main() {
 
     // 启动多个服务器工作协程
     for (int i = 0; i < NUM_SERVER_WORKERS; ++i) {
-        if (!scheduleTask(scheduler, udpServerWorker(i))) {
+        if (!scheduleTask(scheduler, udpServerWorker(i, batch))) {
             addCounter(g_errors);
             server_completion.arrive();
         }
     }
-    LogInfo("Started {} server workers", NUM_SERVER_WORKERS);
+    LogInfo("Started {} server workers (batch {})", NUM_SERVER_WORKERS, batch);
 
     if (!galay::benchmark::waitForFlag(g_server_ready, std::chrono::seconds(2))) {
         LogError("Server workers did not become ready before client start");
@@ -393,15 +488,16 @@ int main() {
         if (!servers_stopped) {
             LogError("Server workers did not stop before shutdown");
         }
-        scheduler.stop();
-        return 1;
+        g_client_completion = nullptr;
+        g_server_completion = nullptr;
+        return false;
     }
 
     // 启动多个客户端
     LogInfo("Starting {} clients...", NUM_CLIENTS);
     const auto measurement_start = std::chrono::steady_clock::now();
     for (int i = 0; i < NUM_CLIENTS; ++i) {
-        if (!scheduleTask(scheduler, udpBenchmarkClient(i))) {
+        if (!scheduleTask(scheduler, udpBenchmarkClient(i, batch))) {
             addCounter(g_errors);
             client_completion.arrive();
         }
@@ -417,17 +513,47 @@ int main() {
     const bool clients_completed = client_completion.waitFor(std::chrono::seconds(3));
     const bool servers_completed = server_completion.waitFor(std::chrono::seconds(3));
 
-    scheduler.stop();
-    LogInfo("Scheduler stopped");
-
     const auto settled = snapshotStats();
-    printBenchmarkResults(measurement_start, measurement_end, measured, settled);
+    printBenchmarkResults(batch, measurement_start, measurement_end, measured, settled);
 
     g_client_completion = nullptr;
     g_server_completion = nullptr;
-    if (!clients_completed || !servers_completed ||
-        g_errors.load(std::memory_order_relaxed) != 0) {
+    return clients_completed && servers_completed &&
+           g_errors.load(std::memory_order_relaxed) == 0;
+}
+
+int main() {
+    LogInfo("UDP Socket Benchmark Test (Optimized)");
+    LogInfo("Configuration: {} clients, {} workers, {} bytes/message, {} seconds per batch size",
+            NUM_CLIENTS, NUM_SERVER_WORKERS, MESSAGE_SIZE, TEST_DURATION_SEC);
+
+#ifdef USE_KQUEUE
+    LogInfo("Using KqueueScheduler (macOS)");
+    KqueueScheduler scheduler;
+#elif defined(USE_EPOLL)
+    LogInfo("Using EpollScheduler (Linux)");
+    EpollScheduler scheduler;
+#elif defined(USE_IOURING)
+    LogInfo("Using IOUringScheduler (Linux io_uring)");
+    IOUringScheduler scheduler;
+#else
+    LogError("This benchmark requires kqueue (macOS), epoll or io_uring (Linux)");
+    return 1;
+#endif
+
+    const auto started = scheduler.start();
+    if (!started) {
+        LogError("Scheduler failed to start: {}", started.error().message());
         return 1;
     }
-    return 0;
+    LogInfo("Scheduler started");
+
+    bool ok = true;
+    for (const size_t batch : BATCH_SIZES) {
+        ok = runBenchmarkRound(scheduler, batch) && ok;
+    }
+
+    scheduler.stop();
+    LogInfo("Scheduler stopped");
+    return ok ? 0 : 1;
 }
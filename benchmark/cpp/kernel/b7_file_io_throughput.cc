@@ -1,7 +1,8 @@
 /**
  * @file b7_fileio.cc
  * @brief 用途：压测并发异步文件读写路径的吞吐、字节量与错误率。
- * 关键覆盖点：不同 worker 数与块大小、读写操作计数、异常与错误统计。
+ * 关键覆盖点：不同 worker 数与块大小、读写操作计数、异常与错误统计；
+ * io_uring 下可用 `-mode registered` 对比注册缓冲池（READ_FIXED/WRITE_FIXED）与普通缓冲。
  * 通过条件：所有测量轮次正常完成并输出统计结果，进程返回 0。
  */
 
@@ -47,6 +48,7 @@ struct BenchConfig {
     size_t block_size = 4096;      // 块大小
     int batch_size = 1;            // 批量操作大小（仅 AIO）
     bool use_direct_io = true;     // 是否使用 O_DIRECT（仅 AIO）
+    bool registered_buffers = false; // 是否使用 leaseBuffer 切片（io_uring 下为注册缓冲池）
     std::string test_dir = "/tmp"; // 测试目录
 };
 
@@ -248,6 +250,55 @@ Task<void> benchmarkWorkerAsync(galay::async::AsyncFile* file, int worker_id, co
     co_return;
 }
 
+// 租借切片压测：io_uring 注册缓冲池时以 READ_FIXED/WRITE_FIXED 提交，其它情况回退堆切片
+Task<void> benchmarkWorkerRegistered(galay::async::AsyncFile* file, int worker_id, const BenchConfig& config) {
+    RegisteredBuffer write_buffer = co_await file->leaseBuffer(config.block_size);
+    RegisteredBuffer read_buffer = co_await file->leaseBuffer(config.block_size);
+    if (!write_buffer.registered() || !read_buffer.registered()) {
+        LogWarn("[Worker {}] registered buffer pool unavailable, using heap slices", worker_id);
+    }
+
+    for (size_t i = 0; i < config.block_size; ++i) {
+        write_buffer.data()[i] = 'A' + (i % 26);
+    }
+    write_buffer.resize(config.block_size);
+
+    int ops = 0;
+    while (g_running.load(std::memory_order_relaxed) && ops < config.operations_per_worker) {
+        off_t offset = (worker_id * config.operations_per_worker + ops) * config.block_size;
+
+        auto write_result = co_await file->write(write_buffer, offset);
+        if (!write_result) {
+            g_total_errors.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            g_total_writes.fetch_add(1, std::memory_order_relaxed);
+            g_total_bytes_written.fetch_add(write_result.value(), std::memory_order_relaxed);
+        }
+
+        auto read_result = co_await file->read(read_buffer, config.block_size, offset);
+        if (!read_result) {
+            g_total_errors.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            read_buffer.resize(read_result.value());
+            g_total_reads.fetch_add(1, std::memory_order_relaxed);
+            g_total_bytes_read.fetch_add(read_result.value(), std::memory_order_relaxed);
+        }
+
+        ops++;
+    }
+
+    co_return;
+}
+
+Task<void> benchmarkWorker(galay::async::AsyncFile* file, int worker_id, const BenchConfig& config) {
+    if (config.registered_buffers) {
+        co_await benchmarkWorkerRegistered(file, worker_id, config);
+    } else {
+        co_await benchmarkWorkerAsync(file, worker_id, config);
+    }
+    co_return;
+}
+
 #ifdef USE_KQUEUE
 void runKqueueBenchmark(const BenchConfig& config) {
     LogInfo("=== Kqueue File IO Benchmark ===");
@@ -278,7 +329,7 @@ void runKqueueBenchmark(const BenchConfig& config) {
 
     // 启动所有 worker
     for (size_t i = 0; i < files.size(); ++i) {
-        scheduleTask(scheduler, benchmarkWorkerAsync(files[i], i, config));
+        scheduleTask(scheduler, benchmarkWorker(files[i], i, config));
     }
 
     // 等待所有 worker 完成
@@ -335,10 +386,17 @@ void runKqueueBenchmark(const BenchConfig& config) {
 #ifdef USE_IOURING
 void runIOUringBenchmark(const BenchConfig& config) {
     LogInfo("=== io_uring File IO Benchmark ===");
-    LogInfo("Workers: {}, Operations per worker: {}, Block size: {}",
-            config.num_workers, config.operations_per_worker, config.block_size);
-
-    IOUringScheduler scheduler;
+    LogInfo("Workers: {}, Operations per worker: {}, Block size: {}, Mode: {}",
+            config.num_workers, config.operations_per_worker, config.block_size,
+            config.registered_buffers ? "registered" : "plain");
+
+    // 每个 worker 同时持有读/写两个切片
+    IOUringOptions options;
+    if (config.registered_buffers) {
+        options.registered_buffer_count = static_cast<uint32_t>(config.num_workers * 2);
+        options.registered_buffer_size = config.block_size;
+    }
+    IOUringScheduler scheduler(GALAY_SCHEDULER_QUEUE_DEPTH, GALAY_SCHEDULER_BATCH_SIZE, options);
     scheduler.start();
 
     std::vector<galay::async::AsyncFile*> files;
@@ -362,7 +420,7 @@ void runIOUringBenchmark(const BenchConfig& config) {
 
     // 启动所有 worker
     for (size_t i = 0; i < files.size(); ++i) {
-        scheduleTask(scheduler, benchmarkWorkerAsync(files[i], i, config));
+        scheduleTask(scheduler, benchmarkWorker(files[i], i, config));
     }
 
     // 等待所有 worker 完成
@@ -437,6 +495,8 @@ int main(int argc, char* argv[]) {
             config.batch_size = std::stoi(argv[++i]);
         } else if (arg == "-d" && i + 1 < argc) {
             config.test_dir = argv[++i];
+        } else if (arg == "-mode" && i + 1 < argc) {
+            config.registered_buffers = std::string(argv[++i]) == "registered";
         } else if (arg == "-h" || arg == "--help") {
             std::cout << "Usage: " << argv[0] << " [options]\n"
                       << "Options:\n"
@@ -445,6 +505,7 @@ int main(int argc, char* argv[]) {
                       << "  -b <size>     Block size in bytes (default: 4096)\n"
                       << "  -batch <num>  Batch size for AIO (default: 1)\n"
                       << "  -d <dir>      Test directory (default: /tmp)\n"
+                      << "  -mode <mode>  plain | registered (leaseBuffer slices, default: plain)\n"
                       << "  -h, --help    Show this help message\n";
             return 0;
         }
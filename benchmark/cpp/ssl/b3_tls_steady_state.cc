@@ -2,7 +2,10 @@
  * @file t11_steady.cc
  * @brief 用途：验证默认 SslContext（开启默认 session cache / ticket 行为）下的 steady-state echo 不会中途断流。
  * 关键覆盖点：`SslSocket::handshake/send/recv/shutdown` 在多连接默认 TLS 上下文下的长时间运行。
- * 通过条件：16 个连接持续 echo 1024B 负载，全部完成，无 send/recv/peer-closed/mismatch。
+ * 通过条件：16 个连接持续 echo 1024B 负载（可由第一个参数指定，如 16384），全部完成，无 send/recv/peer-closed/mismatch。
+ *
+ * 使用方法:
+ *   ./benchmark_ssl_b3_tls_steady_state [payload_bytes]
  */
 
 #include <galay/cpp/galay-ssl/async/ssl_socket.h>
@@ -11,6 +14,7 @@
 #include <galay/cpp/galay-kernel/core/task.h>
 #include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <string>
@@ -37,7 +41,9 @@ namespace {
 constexpr uint16_t kPort = 19446;
 constexpr int kConnections = 16;
 constexpr int kRoundsPerConn = 1000;
-constexpr size_t kPayloadSize = 1024;
+constexpr size_t kDefaultPayloadSize = 1024;
+
+size_t g_payload_size = kDefaultPayloadSize;
 
 struct SteadyState {
     std::atomic<bool> server_ready{false};
@@ -145,21 +151,25 @@ Task<void> handleAcceptedClient(SslContext* ctx, GHandle handle, SteadyState* st
     }
     state->server_handshake_done.fetch_add(1, std::memory_order_relaxed);
 
-    std::vector<char> recv_buffer(kPayloadSize);
+    std::vector<char> recv_buffer(g_payload_size);
     for (int round = 0; round < kRoundsPerConn; ++round) {
-        auto recv_result = co_await client.recv(recv_buffer.data(), recv_buffer.size());
-        if (!recv_result) {
-            fail(state, "server recv failed");
-            break;
+        // 大负载会跨多条 TLS 记录到达，收满一条消息再回显
+        size_t received = 0;
+        while (received < recv_buffer.size()) {
+            auto recv_result = co_await client.recv(recv_buffer.data() + received, recv_buffer.size() - received);
+            if (!recv_result || recv_result->size() == 0) {
+                fail(state, "server recv failed");
+                break;
+            }
+            received += recv_result->size();
         }
-        state->server_recv_ops.fetch_add(1, std::memory_order_relaxed);
-        if (recv_result->size() != kPayloadSize) {
-            fail(state, "server recv size mismatch");
+        if (received != recv_buffer.size()) {
             break;
         }
+        state->server_recv_ops.fetch_add(1, std::memory_order_relaxed);
 
-        auto send_result = co_await client.send(recv_buffer.data(), recv_result->size());
-        if (!send_result || send_result.value() != recv_result->size()) {
+        auto send_result = co_await client.send(recv_buffer.data(), received);
+        if (!send_result || send_result.value() != received) {
             fail(state, "server send failed");
             break;
         }
@@ -244,8 +254,8 @@ Task<void> runClient(SslContext* ctx, SteadyState* state, int client_id)
     }
     state->client_handshake_done.fetch_add(1, std::memory_order_relaxed);
 
-    std::string payload(kPayloadSize, static_cast<char>('A' + (client_id % 23)));
-    std::vector<char> recv_buffer(kPayloadSize);
+    std::string payload(g_payload_size, static_cast<char>('A' + (client_id % 23)));
+    std::vector<char> recv_buffer(g_payload_size);
     for (int round = 0; round < kRoundsPerConn; ++round) {
         auto send_result = co_await socket.send(payload.data(), payload.size());
         if (!send_result || send_result.value() != payload.size()) {
@@ -254,16 +264,19 @@ Task<void> runClient(SslContext* ctx, SteadyState* state, int client_id)
         }
         state->client_send_ops.fetch_add(1, std::memory_order_relaxed);
 
-        auto recv_result = co_await socket.recv(recv_buffer.data(), recv_buffer.size());
-        if (!recv_result) {
-            fail(state, "client recv failed");
-            break;
+        size_t received = 0;
+        while (received < recv_buffer.size()) {
+            auto recv_result = co_await socket.recv(recv_buffer.data() + received, recv_buffer.size() - received);
+            if (!recv_result || recv_result->size() == 0) {
+                fail(state, "client recv failed");
+                break;
+            }
+            received += recv_result->size();
         }
-        state->client_recv_ops.fetch_add(1, std::memory_order_relaxed);
-        if (recv_result->size() != payload.size()) {
-            fail(state, "client recv size mismatch");
+        if (received != recv_buffer.size()) {
             break;
         }
+        state->client_recv_ops.fetch_add(1, std::memory_order_relaxed);
         if (std::memcmp(recv_buffer.data(), payload.data(), payload.size()) != 0) {
             fail(state, "client payload mismatch");
             break;
@@ -277,8 +290,16 @@ Task<void> runClient(SslContext* ctx, SteadyState* state, int client_id)
 
 } // namespace
 
-int main()
+int main(int argc, char* argv[])
 {
+    if (argc > 1) {
+        g_payload_size = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+        if (g_payload_size == 0) {
+            std::cerr << "payload_bytes must be positive" << std::endl;
+            return 2;
+        }
+    }
+
     SteadyState state;
 
     SslContext server_ctx(SslMethod::TLS_Server);
@@ -340,7 +361,7 @@ int main()
     std::cout << "\nSSL steady-state hot-path benchmark:" << std::endl;
     std::cout << "Connections: " << kConnections
               << ", rounds/conn: " << kRoundsPerConn
-              << ", payload bytes: " << kPayloadSize << std::endl;
+              << ", payload bytes: " << g_payload_size << std::endl;
     std::cout << "Client send/recv ops: " << client_send_ops << "/" << client_recv_ops
               << ", server recv/send ops: " << server_recv_ops << "/" << server_send_ops
               << ", elapsed: " << elapsed_ms << " ms" << std::endl;
@@ -348,7 +369,7 @@ int main()
         const auto echo_rounds = std::min(client_send_ops, client_recv_ops);
         const double rps = static_cast<double>(echo_rounds) * 1000.0 /
                            static_cast<double>(elapsed_ms);
-        const double mib = static_cast<double>(echo_rounds * kPayloadSize * 2) /
+        const double mib = static_cast<double>(echo_rounds * g_payload_size * 2) /
                            1024.0 / 1024.0;
         const double throughput = mib * 1000.0 / static_cast<double>(elapsed_ms);
         std::cout << "Echo round-trips/sec: " << rps
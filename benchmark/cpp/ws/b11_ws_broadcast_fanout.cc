@@ -0,0 +1,385 @@
+/**
+ * @file b11_ws_broadcast_fanout.cc
+ * @brief WebSocket 广播扇出压测：一次编码共享帧 vs 每连接复制编码
+ * @details 子进程在本机建立 connections 条 TCP 连接并用 epoll 排空数据，父进程接受连接后
+ *          把每条连接交给 IO 调度器上的写出协程，再从主线程广播 messages 条 payload 字节的文本消息。
+ *          shared 模式走 WsBroadcastGroup：消息只编码一次，各连接 pump 以共享帧 writev；
+ *          copy 模式模拟逐连接发送：发布线程为每个连接复制一次负载，由各连接 sendText 各自编码。
+ *          两种模式各自重新建连，统计发布线程耗时与子进程收齐全部字节的端到端耗时。
+ *          进程 fd 上限不足时自动减少连接数。
+ * @usage benchmark_ws_broadcast_fanout [connections] [messages] [io_threads] [payload_bytes]
+ */
+
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-kernel/core/scheduler.hpp>
+#include <galay/cpp/galay-kernel/concurrency/mpsc/unbounded_channel.h>
+#include <galay/cpp/galay-ws/kernel/ws_writer.h>
+#include <galay/cpp/galay-ws/kernel/writer_cfg.h>
+#include <galay/cpp/galay-ws/protoc/ws_frame.h>
+#include <galay/cpp/galay-ws/server/ws_broadcast.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace galay::kernel;
+using namespace galay::websocket;
+using galay::async::AsyncTcpSocket;
+
+namespace
+{
+
+struct FanoutConfig
+{
+    size_t connections = 10000;
+    size_t messages = 100;
+    size_t io_threads = 4;
+    size_t payload_bytes = 1024;
+};
+
+struct FanoutResult
+{
+    size_t connections = 0;
+    double publish_ms = 0.0;        ///< 发布线程完成全部扇出的耗时
+    double delivered_ms = 0.0;      ///< 从首次发布到子进程收齐全部字节的耗时
+    size_t encodes = 0;             ///< 帧编码次数
+    size_t payload_copies = 0;      ///< 负载复制次数
+    WsBroadcastCounters counters;
+    bool ok = false;
+};
+
+std::atomic<size_t> g_finished_writers{0};
+
+size_t raiseFdLimit()
+{
+    rlimit limit{};
+    if (::getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return 1024;
+    }
+    limit.rlim_cur = limit.rlim_max;
+    (void)::setrlimit(RLIMIT_NOFILE, &limit);
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    return static_cast<size_t>(limit.rlim_cur);
+}
+
+int listenLoopback(uint16_t& port)
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    const int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 4096) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    port = ntohs(address.sin_port);
+    return fd;
+}
+
+/**
+ * @brief 子进程：建立连接并排空数据，全部收齐后向管道写一个字节
+ */
+[[noreturn]] void runDrainer(uint16_t port, size_t connections, size_t expected_per_connection, int done_fd)
+{
+    const int epoll_fd = ::epoll_create1(0);
+    std::vector<size_t> received(connections, 0);
+    std::vector<int> fds;
+    fds.reserve(connections);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    for (size_t i = 0; i < connections; ++i) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            std::_Exit(2);
+        }
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = i;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        fds.push_back(fd);
+    }
+
+    size_t completed = 0;
+    size_t closed = 0;
+    std::vector<epoll_event> events(1024);
+    std::vector<char> buffer(256 * 1024);
+    while (closed < connections) {
+        const int ready = ::epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), 10000);
+        if (ready <= 0) {
+            std::_Exit(3);
+        }
+        for (int i = 0; i < ready; ++i) {
+            const size_t index = events[i].data.u64;
+            while (true) {
+                const ssize_t n = ::read(fds[index], buffer.data(), buffer.size());
+                if (n > 0) {
+                    const size_t before = received[index];
+                    received[index] += static_cast<size_t>(n);
+                    if (before < expected_per_connection && received[index] >= expected_per_connection &&
+                        ++completed == connections) {
+                        const char done = 'D';
+                        (void)!::write(done_fd, &done, 1);
+                    }
+                    continue;
+                }
+                if (n == 0) {
+                    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fds[index], nullptr);
+                    ::close(fds[index]);
+                    ++closed;
+                }
+                break;
+            }
+        }
+    }
+    std::_Exit(0);
+}
+
+std::vector<int> acceptAll(int listen_fd, size_t connections)
+{
+    std::vector<int> fds;
+    fds.reserve(connections);
+    while (fds.size() < connections) {
+        pollfd poll_fd{listen_fd, POLLIN, 0};
+        if (::poll(&poll_fd, 1, 10000) <= 0) {
+            break;
+        }
+        const int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            break;
+        }
+        const int no_delay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fds.push_back(fd);
+    }
+    return fds;
+}
+
+Task<void> sharedWriter(WsBroadcastSubscription* subscription, int fd)
+{
+    AsyncTcpSocket socket(GHandle{fd});
+    WsWriter writer(WsWriterSetting::byServer(), socket);
+    (void)co_await subscription->pump(writer);
+    g_finished_writers.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief 对照组：每个连接一条字符串通道，发布线程逐连接复制负载
+ */
+struct CopyMember
+{
+    galay::mpsc::UnboundedChannel<std::string> channel;
+    galay::mpsc::UnboundedChannel<std::string>::ProducerToken token = channel.makeProducerToken();
+};
+
+Task<void> copyWriter(CopyMember* member, int fd)
+{
+    AsyncTcpSocket socket(GHandle{fd});
+    WsWriter writer(WsWriterSetting::byServer(), socket);
+    while (true) {
+        auto message = co_await member->channel.recv();
+        if (!message) {
+            break;
+        }
+        auto sent = co_await writer.sendText(std::move(*message));
+        if (!sent) {
+            break;
+        }
+    }
+    g_finished_writers.fetch_add(1, std::memory_order_release);
+}
+
+void waitWriters(size_t count)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (g_finished_writers.load(std::memory_order_acquire) < count &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+FanoutResult runMode(bool shared, const FanoutConfig& config)
+{
+    FanoutResult result;
+    uint16_t port = 0;
+    const int listen_fd = listenLoopback(port);
+    int done_pipe[2];
+    if (listen_fd < 0 || ::pipe(done_pipe) != 0) {
+        return result;
+    }
+
+    const std::string payload(config.payload_bytes, 'x');
+    const size_t frame_size = WsSharedFrame::encode(WsOpcode::Text, payload).size();
+    const pid_t child = ::fork();
+    if (child == 0) {
+        ::close(listen_fd);
+        ::close(done_pipe[0]);
+        runDrainer(port, config.connections, frame_size * config.messages, done_pipe[1]);
+    }
+    ::close(done_pipe[1]);
+
+    std::vector<int> fds = acceptAll(listen_fd, config.connections);
+    ::close(listen_fd);
+    result.connections = fds.size();
+    if (fds.size() != config.connections) {
+        for (int fd : fds) {
+            ::close(fd);
+        }
+        ::kill(child, SIGKILL);
+        ::waitpid(child, nullptr, 0);
+        ::close(done_pipe[0]);
+        return result;
+    }
+
+    Runtime runtime = RuntimeBuilder().ioSchedulerCount(config.io_threads).computeSchedulerCount(0).build();
+    (void)runtime.start();
+    g_finished_writers.store(0, std::memory_order_relaxed);
+
+    WsBroadcastGroup group;
+    std::vector<WsBroadcastSubscription> subscriptions;
+    std::vector<std::unique_ptr<CopyMember>> copy_members;
+    if (shared) {
+        subscriptions.reserve(fds.size());
+        for (int fd : fds) {
+            subscriptions.push_back(group.join(WsBroadcastMemberConfig{.max_pending = config.messages}));
+            scheduleTask(runtime.getNextIOScheduler(), sharedWriter(&subscriptions.back(), fd));
+        }
+    } else {
+        copy_members.reserve(fds.size());
+        for (int fd : fds) {
+            copy_members.push_back(std::make_unique<CopyMember>());
+            scheduleTask(runtime.getNextIOScheduler(), copyWriter(copy_members.back().get(), fd));
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < config.messages; ++i) {
+        if (shared) {
+            group.publishText(payload);
+            ++result.encodes;
+        } else {
+            for (auto& member : copy_members) {
+                (void)member->channel.send(member->token, std::string(payload));
+            }
+            result.encodes += copy_members.size();
+            result.payload_copies += copy_members.size();
+        }
+    }
+    const auto published = std::chrono::steady_clock::now();
+
+    char done = 0;
+    pollfd poll_fd{done_pipe[0], POLLIN, 0};
+    result.ok = ::poll(&poll_fd, 1, 60000) > 0 && ::read(done_pipe[0], &done, 1) == 1 && done == 'D';
+    const auto delivered = std::chrono::steady_clock::now();
+    result.publish_ms = std::chrono::duration<double, std::milli>(published - start).count();
+    result.delivered_ms = std::chrono::duration<double, std::milli>(delivered - start).count();
+
+    // 结束写出协程：共享模式退出广播组，对照组关闭通道；协程析构 socket 后子进程读到 EOF
+    result.counters = group.counters();
+    if (shared) {
+        group.close();
+    } else {
+        for (auto& member : copy_members) {
+            (void)member->channel.close();
+        }
+    }
+    waitWriters(fds.size());
+    runtime.stop();
+    subscriptions.clear();
+    copy_members.clear();
+
+    ::waitpid(child, nullptr, 0);
+    ::close(done_pipe[0]);
+    return result;
+}
+
+void printResult(const char* name, const FanoutResult& result, const FanoutConfig& config)
+{
+    const double deliveries = static_cast<double>(result.connections) * static_cast<double>(config.messages);
+    std::cout << name
+              << " ok=" << (result.ok ? 1 : 0)
+              << " connections=" << result.connections
+              << " publish_ms=" << result.publish_ms
+              << " publish_ns_per_delivery=" << (deliveries > 0 ? result.publish_ms * 1e6 / deliveries : 0.0)
+              << " delivered_ms=" << result.delivered_ms
+              << " deliveries_per_sec=" << (result.delivered_ms > 0 ? deliveries * 1000.0 / result.delivered_ms : 0.0)
+              << " encodes=" << result.encodes
+              << " payload_copies=" << result.payload_copies
+              << " dropped=" << result.counters.dropped
+              << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    FanoutConfig config;
+    if (argc > 1) {
+        config.connections = static_cast<size_t>(std::stoul(argv[1]));
+    }
+    if (argc > 2) {
+        config.messages = static_cast<size_t>(std::stoul(argv[2]));
+    }
+    if (argc > 3) {
+        config.io_threads = static_cast<size_t>(std::stoul(argv[3]));
+    }
+    if (argc > 4) {
+        config.payload_bytes = static_cast<size_t>(std::stoul(argv[4]));
+    }
+    if (config.connections == 0 || config.messages == 0 || config.io_threads == 0) {
+        std::cerr << "connections, messages and io_threads must be positive\n";
+        return 1;
+    }
+
+    // 父子进程各持有一端，每个进程需要 connections 个 fd 外加少量余量
+    const size_t fd_limit = raiseFdLimit();
+    if (config.connections + 64 > fd_limit) {
+        std::cerr << "fd limit " << fd_limit << " too low, connections reduced to " << fd_limit - 64 << "\n";
+        config.connections = fd_limit - 64;
+    }
+
+    std::cout << "WebSocket broadcast fan-out benchmark\n"
+              << "connections=" << config.connections
+              << " messages=" << config.messages
+              << " io_threads=" << config.io_threads
+              << " payload_bytes=" << config.payload_bytes << "\n";
+
+    const FanoutResult shared = runMode(true, config);
+    printResult("shared_frame", shared, config);
+    const FanoutResult copied = runMode(false, config);
+    printResult("per_connection_copy", copied, config);
+    if (shared.ok && copied.ok && shared.publish_ms > 0 && shared.delivered_ms > 0) {
+        std::cout << "publish_speedup=" << copied.publish_ms / shared.publish_ms
+                  << " delivery_speedup=" << copied.delivered_ms / shared.delivered_ms << "\n";
+    }
+    return shared.ok && copied.ok ? 0 : 1;
+}
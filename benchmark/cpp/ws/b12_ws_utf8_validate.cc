@@ -0,0 +1,202 @@
+/**
+ * @file b12_ws_utf8_validate.cc
+ * @brief WebSocket 文本 UTF-8 校验微基准：各校验内核 vs 旧实现（SSE2 ASCII 前缀 + 逐码点标量）
+ * @details 三类负载：纯 ASCII（JSON 行情）、中英混排（约一半字节为 CJK 三字节码点）、
+ *          以及末尾 16 字节内含非法字节的混排负载（必须扫到末尾才能判定）。
+ *          整段校验对比全部可用内核与旧实现；流式校验把混排负载切成固定大小的分片逐片 feed，
+ *          分片边界会切开码点，对照旧读取器在 FIN 后整条重扫的做法。结果以 GB/s 输出。
+ * @usage benchmark_ws_utf8_validate [payload_bytes] [iterations] [fragment_bytes]
+ */
+
+#include <galay/cpp/galay-ws/protoc/ws_utf8.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace galay::websocket;
+
+namespace
+{
+
+struct ValidateConfig
+{
+    size_t payload_bytes = 64 * 1024;
+    size_t iterations = 2000;
+    size_t fragment_bytes = 4096;
+};
+
+// 旧实现：16 字节 ASCII 前缀检测，遇到首个非 ASCII 字节后全程逐码点标量
+bool legacyValidate(const char* data, size_t len)
+{
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i high_bit_mask = _mm_set1_epi8(static_cast<char>(0x80));
+    for (; i + 16 <= len; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+        if (_mm_movemask_epi8(_mm_and_si128(chunk, high_bit_mask)) != 0) {
+            break;
+        }
+    }
+#endif
+    while (i < len) {
+        const uint8_t byte = ptr[i];
+        if (byte <= 0x7F) {
+            ++i;
+        } else if ((byte & 0xE0) == 0xC0) {
+            if (i + 1 >= len) return false;
+            const uint8_t byte2 = ptr[i + 1];
+            if ((byte2 & 0xC0) != 0x80) return false;
+            if ((((byte & 0x1F) << 6) | (byte2 & 0x3F)) < 0x80) return false;
+            i += 2;
+        } else if ((byte & 0xF0) == 0xE0) {
+            if (i + 2 >= len) return false;
+            const uint8_t byte2 = ptr[i + 1];
+            const uint8_t byte3 = ptr[i + 2];
+            if ((byte2 & 0xC0) != 0x80 || (byte3 & 0xC0) != 0x80) return false;
+            const uint32_t codepoint = ((byte & 0x0F) << 12) | ((byte2 & 0x3F) << 6) | (byte3 & 0x3F);
+            if (codepoint < 0x800 || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) return false;
+            i += 3;
+        } else if ((byte & 0xF8) == 0xF0) {
+            if (i + 3 >= len) return false;
+            const uint8_t byte2 = ptr[i + 1];
+            const uint8_t byte3 = ptr[i + 2];
+            const uint8_t byte4 = ptr[i + 3];
+            if ((byte2 & 0xC0) != 0x80 || (byte3 & 0xC0) != 0x80 || (byte4 & 0xC0) != 0x80) return false;
+            const uint32_t codepoint = ((byte & 0x07) << 18) | ((byte2 & 0x3F) << 12) |
+                                       ((byte3 & 0x3F) << 6) | (byte4 & 0x3F);
+            if (codepoint < 0x10000 || codepoint > 0x10FFFF) return false;
+            i += 4;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string makeAscii(size_t size)
+{
+    std::string out;
+    size_t seq = 0;
+    while (out.size() < size) {
+        out += "{\"type\":\"ticker\",\"symbol\":\"BTC-USDT\",\"seq\":" + std::to_string(seq++) +
+               ",\"bid\":\"64210.15\",\"ask\":\"64210.16\"}";
+    }
+    out.resize(size);
+    return out;
+}
+
+std::string makeMixed(size_t size)
+{
+    std::string out;
+    size_t seq = 0;
+    while (out.size() < size) {
+        out += "{\"user\":\"用户" + std::to_string(seq++) +
+               "\",\"text\":\"今天的行情波动很大，注意风险控制\",\"tag\":\"市场\"}";
+    }
+    // 截到完整码点边界
+    while (out.size() > size) {
+        out.pop_back();
+    }
+    while (!out.empty() && (static_cast<uint8_t>(out.back()) & 0xC0) == 0x80) {
+        out.pop_back();
+    }
+    if (!out.empty() && static_cast<uint8_t>(out.back()) >= 0xC0) {
+        out.pop_back();
+    }
+    return out;
+}
+
+template<typename Fn>
+double measureGbps(const std::string& payload, size_t iterations, bool expected, Fn&& validate)
+{
+    size_t mismatches = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        if (validate(payload) != expected) {
+            ++mismatches;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (mismatches != 0) {
+        std::cerr << "[benchmark_ws_utf8_validate] unexpected result x" << mismatches << "\n";
+        std::exit(1);
+    }
+    return elapsed > 0 ? static_cast<double>(payload.size()) * static_cast<double>(iterations) / elapsed / 1e9 : 0.0;
+}
+
+void printRow(const char* kernel, const char* input, double gbps)
+{
+    std::cout << std::left << std::setw(10) << kernel << std::setw(16) << input
+              << std::fixed << std::setprecision(2) << gbps << " GB/s\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    ValidateConfig config;
+    if (argc > 1) {
+        config.payload_bytes = static_cast<size_t>(std::stoul(argv[1]));
+    }
+    if (argc > 2) {
+        config.iterations = static_cast<size_t>(std::stoul(argv[2]));
+    }
+    if (argc > 3) {
+        config.fragment_bytes = static_cast<size_t>(std::stoul(argv[3]));
+    }
+    if (config.payload_bytes < 64 || config.iterations == 0 || config.fragment_bytes == 0) {
+        std::cerr << "payload_bytes must be >= 64, iterations and fragment_bytes must be positive\n";
+        return 1;
+    }
+
+    const std::string ascii = makeAscii(config.payload_bytes);
+    const std::string mixed = makeMixed(config.payload_bytes);
+    std::string invalid = mixed;
+    invalid[invalid.size() - 8] = static_cast<char>(0xC0);
+
+    const WsUtf8Kernel detected = activeWsUtf8Kernel();
+    std::cout << "WebSocket UTF-8 validation benchmark\n"
+              << "payload_bytes=" << config.payload_bytes
+              << " iterations=" << config.iterations
+              << " fragment_bytes=" << config.fragment_bytes
+              << " detected_kernel=" << wsUtf8KernelName(detected) << "\n";
+
+    const auto legacy = [](const std::string& text) { return legacyValidate(text.data(), text.size()); };
+    printRow("legacy", "ascii", measureGbps(ascii, config.iterations, true, legacy));
+    printRow("legacy", "mixed_cjk", measureGbps(mixed, config.iterations, true, legacy));
+    printRow("legacy", "invalid_tail", measureGbps(invalid, config.iterations, false, legacy));
+
+    const auto whole = [](const std::string& text) { return WsUtf8Validator::validate(text.data(), text.size()); };
+    const size_t fragment_bytes = config.fragment_bytes;
+    const auto streaming = [fragment_bytes](const std::string& text) {
+        WsUtf8Validator validator;
+        for (size_t offset = 0; offset < text.size(); offset += fragment_bytes) {
+            validator.feed(text.data() + offset, std::min(fragment_bytes, text.size() - offset));
+        }
+        return validator.finish();
+    };
+    for (WsUtf8Kernel kernel : {WsUtf8Kernel::Scalar, WsUtf8Kernel::Sse4, WsUtf8Kernel::Avx2, WsUtf8Kernel::Neon}) {
+        if (!setWsUtf8Kernel(kernel)) {
+            continue;
+        }
+        const std::string name(wsUtf8KernelName(kernel));
+        printRow(name.c_str(), "ascii", measureGbps(ascii, config.iterations, true, whole));
+        printRow(name.c_str(), "mixed_cjk", measureGbps(mixed, config.iterations, true, whole));
+        printRow(name.c_str(), "invalid_tail", measureGbps(invalid, config.iterations, false, whole));
+        printRow(name.c_str(), "mixed_stream", measureGbps(mixed, config.iterations, true, streaming));
+    }
+    setWsUtf8Kernel(detected);
+    return 0;
+}
@@ -1,8 +1,12 @@
 /**
  * @file B5-Websocket.cc
  * @brief WebSocket 服务器压测程序
- * @details 配合 B4-WebsocketClient 进行 WebSocket 性能测试
- * @usage benchmark_ws_ws_server_throughput [port] [io_threads] [nodelay:on|off]
+ * @details 配合 B4-WebsocketClient 进行 WebSocket 性能测试。
+ *          deflate=on 时与提议 permessage-deflate 的客户端协商压缩；
+ *          --compare-json 不启动服务器，在进程内对比同一批 JSON 行情消息
+ *          走原始帧与 permessage-deflate 帧时的线上字节数和编解码 msgs/s。
+ * @usage benchmark_ws_ws_server_throughput [port] [io_threads] [nodelay:on|off] [deflate:on|off]
+ * @usage benchmark_ws_ws_server_throughput --compare-json [messages] [compression_threshold]
  */
 
 #include <galay/cpp/galay-http/server/http_server.h>
@@ -12,15 +16,21 @@
 #include <galay/cpp/galay-http/protoc/http_response.h>
 #include <galay/cpp/galay-http/builder/http_builder.h>
 #include <galay/cpp/galay-ws/kernel/writer_cfg.h>
+#include <galay/cpp/galay-ws/protoc/ws_deflate.h>
+#include <galay/cpp/galay-ws/protoc/ws_frame.h>
+#include <galay/cpp/galay-ws/utils/ws_helper.h>
 #include "benchmark/cpp/ws/ws_benchmark_args.h"
 #include <iostream>
 #include <atomic>
 #include <signal.h>
 #include <cstdlib>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <thread>
 #include <chrono>
+#include <vector>
+#include <sys/uio.h>
 using namespace galay::http;
 using namespace galay::websocket;
 using namespace galay::kernel;
@@ -28,6 +38,7 @@ using namespace galay::kernel;
 // 统计信息
 std::atomic<int> total_connections{0};
 std::atomic<bool> g_running{true};
+WsDeflateConfig g_deflate_config;
 
 void signalHandler(int) {
     g_running = false;
@@ -111,7 +122,7 @@ Task<void> handleHttpRequest(HttpConn conn) {
 
     // 检查是否是 WebSocket 升级请求
     if (request.header().uri() == "/ws" || request.header().uri() == "/") {
-        auto upgrade_result = WsUpgrade::handleUpgrade(request);
+        auto upgrade_result = WsUpgrade::handleUpgrade(request, g_deflate_config);
 
         if (!upgrade_result.success) {
             auto writer = conn.getWriter();
@@ -132,6 +143,13 @@ Task<void> handleHttpRequest(HttpConn conn) {
         }
 
         WsConn ws_conn = WsConn::from(std::move(conn), true);
+        if (upgrade_result.deflate) {
+            auto enabled = ws_conn.enablePerMessageDeflate(*upgrade_result.deflate, g_deflate_config);
+            if (!enabled) {
+                co_await ws_conn.close();
+                co_return;
+            }
+        }
 
         co_await handleWebSocketConnection(ws_conn);
     } else {
@@ -151,7 +169,161 @@ Task<void> handleHttpRequest(HttpConn conn) {
     co_return;
 }
 
+namespace {
+
+std::string makeTickJson(size_t seq)
+{
+    return "{\"type\":\"ticker\",\"symbol\":\"BTC-USDT\",\"seq\":" + std::to_string(seq) +
+           ",\"ts\":" + std::to_string(1700000000000ULL + seq * 7) +
+           ",\"bid\":\"" + std::to_string(64000 + seq % 997) + ".15\",\"ask\":\"" +
+           std::to_string(64000 + seq % 997) + ".16\",\"bid_size\":\"0.42\",\"ask_size\":\"1.07\","
+           "\"exchange\":\"galay\",\"channel\":\"spot.ticker\",\"status\":\"trading\"}";
+}
+
+struct JsonRunResult
+{
+    size_t messages = 0;
+    size_t payload_bytes = 0;       ///< 原始 JSON 字节
+    size_t wire_bytes = 0;          ///< 帧头 + 负载
+    size_t compressed_messages = 0; ///< 以 RSV1 帧发出的消息
+    double elapsed_ms = 0.0;        ///< 服务端编码 + 客户端解码耗时
+    bool ok = true;
+};
+
+/**
+ * @brief 服务端编码、客户端解码同一批消息
+ * @param deflate 为空时全部以原始帧发送
+ */
+JsonRunResult runJson(const std::vector<std::string>& messages,
+                      WsPerMessageDeflate* server,
+                      WsPerMessageDeflate* client)
+{
+    JsonRunResult result;
+    std::string wire;
+    std::string scratch;
+    std::string inflated;
+    WsFrame frame;
+    uint8_t masking_key[4] = {0, 0, 0, 0};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& message : messages) {
+        wire.clear();
+        if (server != nullptr && server->shouldCompress(message.size()) &&
+            server->compressMessage(message, scratch)) {
+            appendWsFrameHeader(wire, WsOpcode::Text, true, true, false, false,
+                                scratch.size(), false, masking_key);
+            wire.append(scratch);
+            ++result.compressed_messages;
+        } else {
+            WsFrameParser::encodeMessageInto(wire, WsOpcode::Text, message, true, false);
+        }
+
+        iovec iov{wire.data(), wire.size()};
+        auto parsed = WsFrameParser::fromIOVec(&iov, 1, frame, false, client != nullptr);
+        if (!parsed) {
+            result.ok = false;
+            break;
+        }
+        if (frame.header.rsv1) {
+            inflated.clear();
+            if (!client->inflateFrame(frame.payload, true, inflated, message.size()) || inflated != message) {
+                result.ok = false;
+                break;
+            }
+        } else if (frame.payload != message) {
+            result.ok = false;
+            break;
+        }
+
+        ++result.messages;
+        result.payload_bytes += message.size();
+        result.wire_bytes += wire.size();
+    }
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void printJsonRun(const char* name, const JsonRunResult& result)
+{
+    const double seconds = result.elapsed_ms / 1000.0;
+    std::cout << name
+              << " messages=" << result.messages
+              << " compressed=" << result.compressed_messages
+              << " payload_bytes=" << result.payload_bytes
+              << " bytes_on_wire=" << result.wire_bytes
+              << " wire_ratio=" << (result.payload_bytes == 0
+                                        ? 0.0
+                                        : static_cast<double>(result.wire_bytes) / result.payload_bytes)
+              << " msgs_per_sec=" << (seconds <= 0.0 ? 0.0 : result.messages / seconds)
+              << "\n";
+}
+
+int runCompareJson(int argc, char* argv[])
+{
+    size_t message_count = 200000;
+    size_t threshold = 128;
+    if (argc > 2) {
+        message_count = static_cast<size_t>(std::stoul(argv[2]));
+    }
+    if (argc > 3) {
+        threshold = static_cast<size_t>(std::stoul(argv[3]));
+    }
+
+    std::vector<std::string> messages;
+    messages.reserve(message_count);
+    for (size_t i = 0; i < message_count; ++i) {
+        messages.push_back(makeTickJson(i));
+    }
+
+    std::cout << "WebSocket JSON compressed vs raw" << std::endl;
+    std::cout << "messages=" << message_count << " compression_threshold=" << threshold << std::endl;
+
+    const auto raw = runJson(messages, nullptr, nullptr);
+    printJsonRun("raw", raw);
+
+    WsDeflateConfig config;
+    config.enabled = true;
+    config.compression_threshold = threshold;
+    const auto negotiated = negotiateWsDeflate("permessage-deflate; client_max_window_bits", config);
+    if (!negotiated) {
+        std::cout << "permessage-deflate unavailable (zlib not compiled)" << std::endl;
+        return raw.ok ? 0 : 1;
+    }
+
+    auto run_deflate = [&](const char* name, WsDeflateParams params) {
+        auto server = WsPerMessageDeflate::create(params, config, true);
+        auto client = WsPerMessageDeflate::create(params, config, false);
+        if (!server || !client) {
+            std::cerr << name << " setup failed" << std::endl;
+            return JsonRunResult{.ok = false};
+        }
+        auto result = runJson(messages, server->get(), client->get());
+        printJsonRun(name, result);
+        std::cout << "  deflate_memory_bytes=" << (*server)->memoryBytes() << std::endl;
+        return result;
+    };
+
+    const auto takeover = run_deflate("deflate_context_takeover", *negotiated);
+    WsDeflateParams isolated = *negotiated;
+    isolated.server_no_context_takeover = true;
+    const auto no_takeover = run_deflate("deflate_no_context_takeover", isolated);
+
+    if (takeover.wire_bytes > 0) {
+        std::cout << "wire_bytes_saved="
+                  << (1.0 - static_cast<double>(takeover.wire_bytes) / raw.wire_bytes) * 100.0
+                  << "%" << std::endl;
+    }
+    return raw.ok && takeover.ok && no_takeover.ok ? 0 : 1;
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::string_view(argv[1]) == "--compare-json") {
+        return runCompareJson(argc, argv);
+    }
+
     // 压测默认关闭日志，避免日志 IO 成为吞吐瓶颈。
     // 设置 GALAY_HTTP_BENCH_LOG=1 可开启文件日志。
     const char* bench_log = std::getenv("GALAY_HTTP_BENCH_LOG");
@@ -168,6 +340,7 @@ int main(int argc, char* argv[]) {
         io_threads = std::atoi(argv[2]);
     }
     const bool tcp_no_delay = galay::benchmark::ws::resolveBenchmarkServerNoDelay(argc, argv, 3);
+    g_deflate_config.enabled = galay::benchmark::ws::resolveBenchmarkServerDeflate(argc, argv, 4);
 
     std::cout << "========================================" << std::endl;
     std::cout << "WebSocket Benchmark Server" << std::endl;
@@ -175,6 +348,7 @@ int main(int argc, char* argv[]) {
     std::cout << "Port: " << port << std::endl;
     std::cout << "IO Threads: " << io_threads << std::endl;
     std::cout << "TCP_NODELAY: " << (tcp_no_delay ? "on" : "off") << std::endl;
+    std::cout << "permessage-deflate: " << (g_deflate_config.enabled ? "on" : "off") << std::endl;
     std::cout << "Configured Compute Threads: 0" << std::endl;
     std::cout << "WebSocket endpoint: ws://localhost:" << port << "/ws" << std::endl;
     std::cout << "Press Ctrl+C to stop" << std::endl;
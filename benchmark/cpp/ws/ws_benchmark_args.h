@@ -63,6 +63,24 @@ inline bool resolveBenchmarkServerNoDelay(int argc, char* argv[], int arg_index)
     return true;
 }
 
+/**
+ * @brief 解析 server benchmark 的 permessage-deflate 开关。
+ * @param argc main() argc。
+ * @param argv main() argv。
+ * @param arg_index deflate 参数所在 argv 下标。
+ * @return 未传、空值或无法识别时默认返回 false；on/true/1/yes/enable/enabled/deflate 返回 true。
+ */
+inline bool resolveBenchmarkServerDeflate(int argc, char* argv[], int arg_index)
+{
+    if (arg_index < 0 || argc <= arg_index || argv[arg_index] == nullptr || argv[arg_index][0] == '\0') {
+        return false;
+    }
+
+    const std::string value = detail::toLowerAscii(argv[arg_index]);
+    return value == "1" || value == "true" || value == "on" || value == "yes" ||
+           value == "enable" || value == "enabled" || value == "deflate";
+}
+
 } // namespace galay::benchmark::ws
 
 #endif // GALAY_BENCHMARK_CPP_WS_BENCHMARK_ARGS_H
@@ -278,3 +278,69 @@ function(galay_ensure_spdlog)
         )
     endif()
 endfunction()
+
+function(galay_find_zlib out_found)
+    if(TARGET ZLIB::ZLIB)
+        set(${out_found} ON PARENT_SCOPE)
+        return()
+    endif()
+
+    find_package(ZLIB QUIET)
+    if(TARGET ZLIB::ZLIB)
+        set(${out_found} ON PARENT_SCOPE)
+    else()
+        message(STATUS "zlib not found; gzip response compression disabled")
+        set(${out_found} OFF PARENT_SCOPE)
+    endif()
+endfunction()
+
+function(galay_find_zstd out_found)
+    if(TARGET zstd::libzstd)
+        set(${out_found} ON PARENT_SCOPE)
+        return()
+    endif()
+
+    find_package(PkgConfig QUIET)
+    if(PkgConfig_FOUND)
+        pkg_check_modules(GALAY_ZSTD QUIET IMPORTED_TARGET libzstd)
+        if(TARGET PkgConfig::GALAY_ZSTD)
+            add_library(zstd::libzstd INTERFACE IMPORTED GLOBAL)
+            set_target_properties(zstd::libzstd PROPERTIES
+                INTERFACE_LINK_LIBRARIES PkgConfig::GALAY_ZSTD
+            )
+            set(${out_found} ON PARENT_SCOPE)
+            return()
+        endif()
+    endif()
+
+    find_path(GALAY_ZSTD_INCLUDE_DIR
+        NAMES zstd.h
+        HINTS
+            "$ENV{ZSTD_ROOT}/include"
+            /opt/homebrew/include
+            /usr/local/include
+            /usr/include
+    )
+    find_library(GALAY_ZSTD_LIBRARY
+        NAMES zstd
+        HINTS
+            "$ENV{ZSTD_ROOT}/lib"
+            /opt/homebrew/lib
+            /usr/local/lib
+            /usr/lib
+            /usr/lib64
+    )
+
+    if(NOT GALAY_ZSTD_INCLUDE_DIR OR NOT GALAY_ZSTD_LIBRARY)
+        message(STATUS "libzstd not found; zstd response compression disabled")
+        set(${out_found} OFF PARENT_SCOPE)
+        return()
+    endif()
+
+    add_library(zstd::libzstd UNKNOWN IMPORTED GLOBAL)
+    set_target_properties(zstd::libzstd PROPERTIES
+        IMPORTED_LOCATION "${GALAY_ZSTD_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${GALAY_ZSTD_INCLUDE_DIR}"
+    )
+    set(${out_found} ON PARENT_SCOPE)
+endfunction()
@@ -36,10 +36,13 @@ option(GALAY_BUILD_C_API "Build C ABI wrapper targets" ON)
 option(GALAY_ENABLE_CPP23_MODULES "Build enabled module C++23 facade targets when supported" OFF)
 option(GALAY_BUILD_SHARED_LIBS "Build non-header modules as shared libraries" ON)
 option(GALAY_DISABLE_IOURING "Disable io_uring and use epoll on Linux" ON)
+option(GALAY_DISABLE_TASK_FRAME_POOL "Allocate Task coroutine frames from the global heap instead of per-thread slabs" OFF)
 
 option(GALAY_TRACING_ENABLE_SPDLOG "Enable the tracing spdlog adapter" OFF)
 option(GALAY_TRACING_ENABLE_GALAY_HTTP_OTLP_TRANSPORT "Enable the built-in galay-http OTLP transport" OFF)
 option(GALAY_RPC_ENABLE_ETCD "Compile the RPC etcd discovery adapter into galay::rpc" OFF)
+option(GALAY_HTTP_ENABLE_GZIP "Compile gzip response compression into galay::http when zlib is found" ON)
+option(GALAY_HTTP_ENABLE_ZSTD "Compile zstd response compression into galay::http when libzstd is found" ON)
 
 if(DEFINED GALAY_TRACING_ENABLE_OTLP_HTTP)
     message(DEPRECATION
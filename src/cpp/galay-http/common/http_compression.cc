@@ -0,0 +1,638 @@
+#include "http_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+#ifdef GALAY_HTTP_ENABLE_GZIP
+#include <zlib.h>
+#endif
+
+#ifdef GALAY_HTTP_ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace galay::http
+{
+
+namespace
+{
+
+constexpr size_t kCodecOutputStep = 16 * 1024;
+
+std::string_view trimOws(std::string_view value) noexcept
+{
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs) noexcept
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(lhs[i])) !=
+            std::tolower(static_cast<unsigned char>(rhs[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 解析 qvalue（RFC 9110 §12.4.2），返回千分比；格式非法返回 -1
+ */
+int parseQValue(std::string_view value) noexcept
+{
+    value = trimOws(value);
+    if (value.empty() || (value.front() != '0' && value.front() != '1')) {
+        return -1;
+    }
+    const bool one = value.front() == '1';
+    value.remove_prefix(1);
+    if (value.empty()) {
+        return one ? 1000 : 0;
+    }
+    if (value.front() != '.' || value.size() > 4) {
+        return -1;
+    }
+    value.remove_prefix(1);
+    int thousandths = 0;
+    int scale = 100;
+    for (char c : value) {
+        if (c < '0' || c > '9') {
+            return -1;
+        }
+        thousandths += (c - '0') * scale;
+        scale /= 10;
+    }
+    if (one) {
+        return thousandths == 0 ? 1000 : -1;
+    }
+    return thousandths;
+}
+
+/**
+ * @brief 从编码列表元素中取出 q 参数；没有 q 参数时为 1000
+ */
+int elementQValue(std::string_view params) noexcept
+{
+    while (!params.empty()) {
+        const size_t next = params.find(';');
+        std::string_view param = trimOws(params.substr(0, next));
+        params = next == std::string_view::npos ? std::string_view() : params.substr(next + 1);
+        const size_t eq = param.find('=');
+        if (eq == std::string_view::npos) {
+            continue;
+        }
+        if (equalsIgnoreCase(trimOws(param.substr(0, eq)), "q")) {
+            const int q = parseQValue(param.substr(eq + 1));
+            return q < 0 ? 0 : q;
+        }
+    }
+    return 1000;
+}
+
+HttpError codecUnavailable(HttpContentCoding coding)
+{
+    return HttpError(kNotImplemented,
+                     std::string("content coding not compiled: ") + std::string(contentCodingToken(coding)));
+}
+
+} // namespace
+
+std::string_view contentCodingToken(HttpContentCoding coding) noexcept
+{
+    switch (coding) {
+        case HttpContentCoding::Gzip: return "gzip";
+        case HttpContentCoding::Zstd: return "zstd";
+        default: return "identity";
+    }
+}
+
+bool isContentCodingSupported(HttpContentCoding coding) noexcept
+{
+    switch (coding) {
+        case HttpContentCoding::Identity:
+            return true;
+        case HttpContentCoding::Gzip:
+#ifdef GALAY_HTTP_ENABLE_GZIP
+            return true;
+#else
+            return false;
+#endif
+        case HttpContentCoding::Zstd:
+#ifdef GALAY_HTTP_ENABLE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+bool isCompressibleMimeType(std::string_view contentType) noexcept
+{
+    const size_t semicolon = contentType.find(';');
+    std::string_view media = trimOws(contentType.substr(0, semicolon));
+    if (media.empty() || media.size() > 128) {
+        return false;
+    }
+    std::array<char, 128> lowered{};
+    for (size_t i = 0; i < media.size(); ++i) {
+        lowered[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(media[i])));
+    }
+    const std::string_view type(lowered.data(), media.size());
+
+    if (type.starts_with("text/") || type.ends_with("+json") || type.ends_with("+xml")) {
+        return true;
+    }
+    static constexpr std::array<std::string_view, 10> kCompressible = {
+        "application/json",
+        "application/javascript",
+        "application/x-javascript",
+        "application/ecmascript",
+        "application/xml",
+        "application/wasm",
+        "application/vnd.ms-fontobject",
+        "font/ttf",
+        "font/otf",
+        "image/x-icon",
+    };
+    return std::find(kCompressible.begin(), kCompressible.end(), type) != kCompressible.end();
+}
+
+HttpContentCoding negotiateContentCoding(std::string_view acceptEncoding,
+                                         bool allowGzip,
+                                         bool allowZstd) noexcept
+{
+    acceptEncoding = trimOws(acceptEncoding);
+    if (acceptEncoding.empty()) {
+        return HttpContentCoding::Identity;
+    }
+
+    // -1 表示未在列表中出现
+    int gzip_q = -1;
+    int zstd_q = -1;
+    int identity_q = -1;
+    int star_q = -1;
+    while (!acceptEncoding.empty()) {
+        const size_t comma = acceptEncoding.find(',');
+        std::string_view element = acceptEncoding.substr(0, comma);
+        acceptEncoding = comma == std::string_view::npos ? std::string_view() : acceptEncoding.substr(comma + 1);
+
+        const size_t semicolon = element.find(';');
+        const std::string_view token = trimOws(element.substr(0, semicolon));
+        if (token.empty()) {
+            continue;
+        }
+        const int q = semicolon == std::string_view::npos ? 1000 : elementQValue(element.substr(semicolon + 1));
+        if (equalsIgnoreCase(token, "gzip") || equalsIgnoreCase(token, "x-gzip")) {
+            gzip_q = std::max(gzip_q, q);
+        } else if (equalsIgnoreCase(token, "zstd")) {
+            zstd_q = std::max(zstd_q, q);
+        } else if (equalsIgnoreCase(token, "identity")) {
+            identity_q = std::max(identity_q, q);
+        } else if (token == "*") {
+            star_q = std::max(star_q, q);
+        }
+    }
+
+    auto resolve = [star_q](int explicit_q) {
+        if (explicit_q >= 0) {
+            return explicit_q;
+        }
+        return star_q >= 0 ? star_q : 0;
+    };
+    const int gzip = allowGzip ? resolve(gzip_q) : 0;
+    const int zstd = allowZstd ? resolve(zstd_q) : 0;
+
+    HttpContentCoding best = HttpContentCoding::Zstd;
+    int best_q = zstd;
+    if (gzip > zstd) {
+        best = HttpContentCoding::Gzip;
+        best_q = gzip;
+    }
+    if (best_q == 0 || identity_q > best_q) {
+        return HttpContentCoding::Identity;
+    }
+    return best;
+}
+
+HttpContentCoding negotiateContentCoding(std::string_view acceptEncoding,
+                                         const HttpCompressionSetting& setting) noexcept
+{
+    if (!setting.isEnabled()) {
+        return HttpContentCoding::Identity;
+    }
+    return negotiateContentCoding(acceptEncoding,
+                                  setting.isGzipEnabled() && isContentCodingSupported(HttpContentCoding::Gzip),
+                                  setting.isZstdEnabled() && isContentCodingSupported(HttpContentCoding::Zstd));
+}
+
+// ==================== 流式压缩器 ====================
+
+struct HttpStreamCompressor::State {
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    z_stream zs{};
+    bool zlib_ready = false;
+#endif
+#ifdef GALAY_HTTP_ENABLE_ZSTD
+    ZSTD_CCtx* cctx = nullptr;
+#endif
+
+    ~State() {
+#ifdef GALAY_HTTP_ENABLE_GZIP
+        if (zlib_ready) {
+            deflateEnd(&zs);
+        }
+#endif
+#ifdef GALAY_HTTP_ENABLE_ZSTD
+        if (cctx != nullptr) {
+            ZSTD_freeCCtx(cctx);
+        }
+#endif
+    }
+};
+
+HttpStreamCompressor::HttpStreamCompressor(HttpContentCoding coding, std::unique_ptr<State> state) noexcept
+    : m_coding(coding)
+    , m_state(std::move(state))
+{
+}
+
+HttpStreamCompressor::HttpStreamCompressor(HttpStreamCompressor&&) noexcept = default;
+HttpStreamCompressor& HttpStreamCompressor::operator=(HttpStreamCompressor&&) noexcept = default;
+HttpStreamCompressor::~HttpStreamCompressor() = default;
+
+std::expected<HttpStreamCompressor, HttpError> HttpStreamCompressor::create(HttpContentCoding coding, int level)
+{
+    if (coding == HttpContentCoding::Identity || !isContentCodingSupported(coding)) {
+        return std::unexpected(codecUnavailable(coding));
+    }
+    auto state = std::make_unique<State>();
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    if (coding == HttpContentCoding::Gzip) {
+        // windowBits 15 + 16：输出 gzip 封装而不是 zlib 封装
+        const int rc = deflateInit2(&state->zs, std::clamp(level, 1, 9), Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+        if (rc != Z_OK) {
+            return std::unexpected(HttpError(kInternalError, "deflateInit2 failed"));
+        }
+        state->zlib_ready = true;
+    }
+#endif
+#ifdef GALAY_HTTP_ENABLE_ZSTD
+    if (coding == HttpContentCoding::Zstd) {
+        state->cctx = ZSTD_createCCtx();
+        if (state->cctx == nullptr ||
+            ZSTD_isError(ZSTD_CCtx_setParameter(state->cctx, ZSTD_c_compressionLevel, level))) {
+            return std::unexpected(HttpError(kInternalError, "ZSTD_createCCtx failed"));
+        }
+    }
+#endif
+    (void)level;
+    return HttpStreamCompressor(coding, std::move(state));
+}
+
+std::expected<std::string, HttpError> HttpStreamCompressor::update(std::string_view input, bool finish)
+{
+    if (m_finished) {
+        return std::unexpected(HttpError(kInternalError, "stream compressor already finished"));
+    }
+    std::string out;
+    // 空输入的同步刷新只会产出空块标记，直接跳过
+    if (input.empty() && !finish) {
+        return out;
+    }
+
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    if (m_coding == HttpContentCoding::Gzip) {
+        z_stream& zs = m_state->zs;
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        zs.avail_in = static_cast<uInt>(input.size());
+        const int flush = finish ? Z_FINISH : Z_SYNC_FLUSH;
+        out.reserve(std::min<size_t>(deflateBound(&zs, static_cast<uLong>(input.size())), 4 * kCodecOutputStep));
+        int rc = Z_OK;
+        do {
+            const size_t produced = out.size();
+            out.resize(produced + kCodecOutputStep);
+            zs.next_out = reinterpret_cast<Bytef*>(out.data() + produced);
+            zs.avail_out = static_cast<uInt>(kCodecOutputStep);
+            rc = deflate(&zs, flush);
+            out.resize(produced + kCodecOutputStep - zs.avail_out);
+            if (rc == Z_STREAM_ERROR) {
+                return std::unexpected(HttpError(kInternalError, "deflate failed"));
+            }
+        } while (zs.avail_out == 0 || (finish && rc != Z_STREAM_END));
+        m_finished = finish;
+        return out;
+    }
+#endif
+#ifdef GALAY_HTTP_ENABLE_ZSTD
+    if (m_coding == HttpContentCoding::Zstd) {
+        ZSTD_inBuffer in{input.data(), input.size(), 0};
+        const ZSTD_EndDirective mode = finish ? ZSTD_e_end : ZSTD_e_flush;
+        size_t remaining = 0;
+        do {
+            const size_t produced = out.size();
+            out.resize(produced + kCodecOutputStep);
+            ZSTD_outBuffer outBuffer{out.data() + produced, kCodecOutputStep, 0};
+            remaining = ZSTD_compressStream2(m_state->cctx, &outBuffer, &in, mode);
+            out.resize(produced + outBuffer.pos);
+            if (ZSTD_isError(remaining)) {
+                return std::unexpected(HttpError(kInternalError, ZSTD_getErrorName(remaining)));
+            }
+        } while (remaining != 0 || in.pos < in.size);
+        m_finished = finish;
+        return out;
+    }
+#endif
+    return std::unexpected(codecUnavailable(m_coding));
+}
+
+// ==================== 原始 DEFLATE 流 ====================
+
+struct HttpRawDeflateStream::State {
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    z_stream zs{};
+    bool zlib_ready = false;
+    bool compress = true;
+#endif
+
+    ~State() {
+#ifdef GALAY_HTTP_ENABLE_GZIP
+        if (zlib_ready) {
+            if (compress) {
+                deflateEnd(&zs);
+            } else {
+                inflateEnd(&zs);
+            }
+        }
+#endif
+    }
+};
+
+HttpRawDeflateStream::HttpRawDeflateStream(Direction direction, int windowBits, std::unique_ptr<State> state) noexcept
+    : m_direction(direction)
+    , m_window_bits(windowBits)
+    , m_state(std::move(state))
+{
+}
+
+HttpRawDeflateStream::HttpRawDeflateStream(HttpRawDeflateStream&&) noexcept = default;
+HttpRawDeflateStream& HttpRawDeflateStream::operator=(HttpRawDeflateStream&&) noexcept = default;
+HttpRawDeflateStream::~HttpRawDeflateStream() = default;
+
+bool HttpRawDeflateStream::isSupported() noexcept
+{
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t HttpRawDeflateStream::estimateMemory(Direction direction, int windowBits, int memLevel) noexcept
+{
+    windowBits = std::clamp(windowBits, 9, 15);
+    if (direction == Direction::Decompress) {
+        // zlib.h：inflate 使用 1 << windowBits 的窗口外加约 7 KB 状态
+        return (size_t{1} << windowBits) + 7 * 1024;
+    }
+    // zlib.h：deflate 使用 (1 << (windowBits + 2)) + (1 << (memLevel + 9))，另有约 6 KB 状态
+    memLevel = std::clamp(memLevel, 1, 9);
+    return (size_t{1} << (windowBits + 2)) + (size_t{1} << (memLevel + 9)) + 6 * 1024;
+}
+
+std::expected<HttpRawDeflateStream, HttpError> HttpRawDeflateStream::createCompressor(int level, int windowBits, int memLevel)
+{
+    // zlib 的原始 deflate 不支持 8 位窗口（会静默改成 9），统一收敛到 9–15
+    windowBits = std::clamp(windowBits, 9, 15);
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    auto state = std::make_unique<State>();
+    // 负 windowBits：输出不带 zlib 头尾的原始 DEFLATE 流
+    const int rc = deflateInit2(&state->zs, std::clamp(level, 1, 9), Z_DEFLATED, -windowBits,
+                                std::clamp(memLevel, 1, 9), Z_DEFAULT_STRATEGY);
+    if (rc != Z_OK) {
+        return std::unexpected(HttpError(kInternalError, "deflateInit2 failed"));
+    }
+    state->zlib_ready = true;
+    state->compress = true;
+    return HttpRawDeflateStream(Direction::Compress, windowBits, std::move(state));
+#else
+    (void)level;
+    (void)memLevel;
+    return std::unexpected(codecUnavailable(HttpContentCoding::Gzip));
+#endif
+}
+
+std::expected<HttpRawDeflateStream, HttpError> HttpRawDeflateStream::createDecompressor(int windowBits)
+{
+    windowBits = std::clamp(windowBits, 9, 15);
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    auto state = std::make_unique<State>();
+    if (inflateInit2(&state->zs, -windowBits) != Z_OK) {
+        return std::unexpected(HttpError(kInternalError, "inflateInit2 failed"));
+    }
+    state->zlib_ready = true;
+    state->compress = false;
+    return HttpRawDeflateStream(Direction::Decompress, windowBits, std::move(state));
+#else
+    return std::unexpected(codecUnavailable(HttpContentCoding::Gzip));
+#endif
+}
+
+std::expected<void, HttpError> HttpRawDeflateStream::compress(std::string_view input, std::string& out)
+{
+    if (m_direction != Direction::Compress || !m_state) {
+        return std::unexpected(HttpError(kInternalError, "raw deflate stream is not a compressor"));
+    }
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    z_stream& zs = m_state->zs;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    zs.avail_in = static_cast<uInt>(input.size());
+    // 首轮按 deflateBound 预留，同步刷新的结果通常一次写完
+    size_t step = deflateBound(&zs, static_cast<uLong>(input.size())) + 16;
+    do {
+        const size_t produced = out.size();
+        out.resize(produced + step);
+        zs.next_out = reinterpret_cast<Bytef*>(out.data() + produced);
+        zs.avail_out = static_cast<uInt>(step);
+        const int rc = deflate(&zs, Z_SYNC_FLUSH);
+        out.resize(produced + step - zs.avail_out);
+        if (rc == Z_STREAM_ERROR) {
+            return std::unexpected(HttpError(kInternalError, "deflate failed"));
+        }
+        step = kCodecOutputStep;
+    } while (zs.avail_out == 0);
+    return {};
+#else
+    (void)input;
+    (void)out;
+    return std::unexpected(codecUnavailable(HttpContentCoding::Gzip));
+#endif
+}
+
+std::expected<void, HttpError> HttpRawDeflateStream::decompress(std::string_view input, std::string& out, size_t maxOutput)
+{
+    if (m_direction != Direction::Decompress || !m_state) {
+        return std::unexpected(HttpError(kInternalError, "raw deflate stream is not a decompressor"));
+    }
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    z_stream& zs = m_state->zs;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    zs.avail_in = static_cast<uInt>(input.size());
+    while (true) {
+        const size_t produced = out.size();
+        out.resize(produced + kCodecOutputStep);
+        zs.next_out = reinterpret_cast<Bytef*>(out.data() + produced);
+        zs.avail_out = static_cast<uInt>(kCodecOutputStep);
+        const int rc = inflate(&zs, Z_SYNC_FLUSH);
+        out.resize(produced + kCodecOutputStep - zs.avail_out);
+        if (out.size() > maxOutput) {
+            return std::unexpected(HttpError(kRequestEntityTooLarge, "decoded body too large"));
+        }
+        if (rc == Z_STREAM_END) {
+            // 对端以 BFINAL 块结束了流：重置以接收下一段独立的流
+            inflateReset(&zs);
+            return {};
+        }
+        if (rc == Z_BUF_ERROR) {
+            // 没有可推进的输入：本段已全部消费
+            return {};
+        }
+        if (rc != Z_OK) {
+            return std::unexpected(HttpError(kBadRequest, "corrupt deflate stream"));
+        }
+        if (zs.avail_in == 0 && zs.avail_out != 0) {
+            return {};
+        }
+    }
+#else
+    (void)input;
+    (void)out;
+    (void)maxOutput;
+    return std::unexpected(codecUnavailable(HttpContentCoding::Gzip));
+#endif
+}
+
+std::expected<void, HttpError> HttpRawDeflateStream::reset()
+{
+    if (!m_state) {
+        return std::unexpected(HttpError(kInternalError, "raw deflate stream moved from"));
+    }
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    const int rc = m_direction == Direction::Compress ? deflateReset(&m_state->zs) : inflateReset(&m_state->zs);
+    if (rc != Z_OK) {
+        return std::unexpected(HttpError(kInternalError, "zlib reset failed"));
+    }
+    return {};
+#else
+    return std::unexpected(codecUnavailable(HttpContentCoding::Gzip));
+#endif
+}
+
+// ==================== 一次性压缩 / 解压 ====================
+
+std::expected<std::string, HttpError> compressContent(HttpContentCoding coding,
+                                                      std::string_view input,
+                                                      int level)
+{
+    auto compressor = HttpStreamCompressor::create(coding, level);
+    if (!compressor) {
+        return std::unexpected(compressor.error());
+    }
+    return compressor->update(input, true);
+}
+
+std::expected<std::string, HttpError> decompressContent(HttpContentCoding coding,
+                                                        std::string_view input,
+                                                        size_t maxOutput)
+{
+    if (coding == HttpContentCoding::Identity) {
+        if (input.size() > maxOutput) {
+            return std::unexpected(HttpError(kRequestEntityTooLarge, "decoded body too large"));
+        }
+        return std::string(input);
+    }
+    if (!isContentCodingSupported(coding)) {
+        return std::unexpected(codecUnavailable(coding));
+    }
+
+    std::string out;
+#ifdef GALAY_HTTP_ENABLE_GZIP
+    if (coding == HttpContentCoding::Gzip) {
+        z_stream zs{};
+        // windowBits 15 + 32：自动识别 gzip 与 zlib 封装
+        if (inflateInit2(&zs, 15 + 32) != Z_OK) {
+            return std::unexpected(HttpError(kInternalError, "inflateInit2 failed"));
+        }
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        zs.avail_in = static_cast<uInt>(input.size());
+        int rc = Z_OK;
+        while (rc != Z_STREAM_END) {
+            const size_t produced = out.size();
+            out.resize(produced + kCodecOutputStep);
+            zs.next_out = reinterpret_cast<Bytef*>(out.data() + produced);
+            zs.avail_out = static_cast<uInt>(kCodecOutputStep);
+            rc = inflate(&zs, Z_NO_FLUSH);
+            out.resize(produced + kCodecOutputStep - zs.avail_out);
+            if (out.size() > maxOutput) {
+                inflateEnd(&zs);
+                return std::unexpected(HttpError(kRequestEntityTooLarge, "decoded body too large"));
+            }
+            if (rc != Z_OK && rc != Z_STREAM_END) {
+                inflateEnd(&zs);
+                return std::unexpected(HttpError(kBadRequest, "corrupt gzip stream"));
+            }
+            if (rc == Z_OK && zs.avail_in == 0 && zs.avail_out != 0) {
+                inflateEnd(&zs);
+                return std::unexpected(HttpError(kBadRequest, "truncated gzip stream"));
+            }
+        }
+        inflateEnd(&zs);
+        return out;
+    }
+#endif
+#ifdef GALAY_HTTP_ENABLE_ZSTD
+    if (coding == HttpContentCoding::Zstd) {
+        ZSTD_DCtx* dctx = ZSTD_createDCtx();
+        if (dctx == nullptr) {
+            return std::unexpected(HttpError(kInternalError, "ZSTD_createDCtx failed"));
+        }
+        ZSTD_inBuffer in{input.data(), input.size(), 0};
+        size_t rc = 1;
+        bool output_full = false;
+        while (in.pos < in.size || output_full) {
+            const size_t produced = out.size();
+            out.resize(produced + kCodecOutputStep);
+            ZSTD_outBuffer outBuffer{out.data() + produced, kCodecOutputStep, 0};
+            rc = ZSTD_decompressStream(dctx, &outBuffer, &in);
+            out.resize(produced + outBuffer.pos);
+            output_full = outBuffer.pos == kCodecOutputStep;
+            if (ZSTD_isError(rc)) {
+                ZSTD_freeDCtx(dctx);
+                return std::unexpected(HttpError(kBadRequest, ZSTD_getErrorName(rc)));
+            }
+            if (out.size() > maxOutput) {
+                ZSTD_freeDCtx(dctx);
+                return std::unexpected(HttpError(kRequestEntityTooLarge, "decoded body too large"));
+            }
+        }
+        ZSTD_freeDCtx(dctx);
+        if (rc != 0) {
+            return std::unexpected(HttpError(kBadRequest, "truncated zstd stream"));
+        }
+        return out;
+    }
+#endif
+    return std::unexpected(codecUnavailable(coding));
+}
+
+} // namespace galay::http
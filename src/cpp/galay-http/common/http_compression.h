@@ -0,0 +1,396 @@
+/**
+ * @file http_compression.h
+ * @brief HTTP 响应内容编码（gzip / zstd）
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 提供 Accept-Encoding 协商、一次性压缩 / 解压、流式压缩器与原始 DEFLATE 流。
+ *          编解码器在构建时按依赖探测结果编译：找到 zlib 时启用 gzip（GALAY_HTTP_ENABLE_GZIP），
+ *          找到 libzstd 时启用 zstd（GALAY_HTTP_ENABLE_ZSTD）；未编译的编码不会被协商选中。
+ *
+ * @code
+ * HttpCompressionSetting setting;
+ * setting.setEnabled(true);
+ * auto coding = negotiateContentCoding(req.header().headerPairs().getValue("Accept-Encoding"), setting);
+ * if (coding != HttpContentCoding::Identity) {
+ *     auto body = compressContent(coding, json, setting);
+ * }
+ * @endcode
+ */
+
+#ifndef GALAY_HTTP_COMPRESSION_H
+#define GALAY_HTTP_COMPRESSION_H
+
+#include "../protoc/http_error.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace galay::http
+{
+
+/**
+ * @brief 响应内容编码
+ */
+enum class HttpContentCoding : uint8_t
+{
+    Identity, ///< 不编码
+    Gzip,     ///< gzip（RFC 1952）
+    Zstd,     ///< zstd（RFC 8878）
+};
+
+/**
+ * @brief 内容编码在 Content-Encoding / Accept-Encoding 中的记号
+ * @param coding 内容编码
+ * @return "identity"、"gzip" 或 "zstd"
+ */
+std::string_view contentCodingToken(HttpContentCoding coding) noexcept;
+
+/**
+ * @brief 判断内容编码是否已编译进当前构建
+ * @param coding 内容编码
+ * @return Identity 恒为 true；gzip / zstd 取决于构建时是否找到 zlib / libzstd
+ */
+bool isContentCodingSupported(HttpContentCoding coding) noexcept;
+
+/**
+ * @brief 判断 Content-Type 是否值得压缩
+ * @param contentType Content-Type 值，可带参数（如 "; charset=utf-8"）
+ * @return text 类、JSON、JavaScript、XML、SVG、wasm 等文本类类型返回 true；
+ *         图片、音视频、压缩包等已压缩格式返回 false
+ */
+bool isCompressibleMimeType(std::string_view contentType) noexcept;
+
+/**
+ * @brief 响应压缩配置
+ * @details 默认关闭。启用后，只有满足以下条件的响应会被压缩：
+ *          客户端 Accept-Encoding 接受、Content-Type 可压缩、响应体不小于 getMinLength()、
+ *          状态码不是 1xx / 204 / 206 / 304、且响应尚未带 Content-Encoding。
+ */
+class HttpCompressionSetting
+{
+public:
+    HttpCompressionSetting() = default;
+
+    /**
+     * @brief 设置是否启用压缩
+     * @param enable 是否启用
+     */
+    void setEnabled(bool enable) {
+        m_enabled = enable;
+    }
+
+    /**
+     * @brief 获取是否启用压缩
+     * @return 是否启用
+     */
+    bool isEnabled() const {
+        return m_enabled;
+    }
+
+    /**
+     * @brief 设置参与压缩的最小响应体长度
+     * @param length 字节数；更小的响应压缩收益抵不过头部与 CPU 开销
+     */
+    void setMinLength(size_t length) {
+        m_min_length = length;
+    }
+
+    /**
+     * @brief 获取参与压缩的最小响应体长度
+     * @return 字节数
+     */
+    size_t getMinLength() const {
+        return m_min_length;
+    }
+
+    /**
+     * @brief 设置 gzip 压缩级别
+     * @param level 1（最快）~ 9（最小）
+     */
+    void setGzipLevel(int level) {
+        m_gzip_level = level;
+    }
+
+    /**
+     * @brief 获取 gzip 压缩级别
+     * @return 压缩级别
+     */
+    int getGzipLevel() const {
+        return m_gzip_level;
+    }
+
+    /**
+     * @brief 设置 zstd 压缩级别
+     * @param level 1 ~ 22；默认 3 与 zstd 命令行一致
+     */
+    void setZstdLevel(int level) {
+        m_zstd_level = level;
+    }
+
+    /**
+     * @brief 获取 zstd 压缩级别
+     * @return 压缩级别
+     */
+    int getZstdLevel() const {
+        return m_zstd_level;
+    }
+
+    /**
+     * @brief 设置是否允许协商 zstd
+     * @param enable 是否允许；q 值相同时 zstd 优先于 gzip
+     */
+    void setZstdEnabled(bool enable) {
+        m_zstd_enabled = enable;
+    }
+
+    /**
+     * @brief 获取是否允许协商 zstd
+     * @return 是否允许
+     */
+    bool isZstdEnabled() const {
+        return m_zstd_enabled;
+    }
+
+    /**
+     * @brief 设置是否允许协商 gzip
+     * @param enable 是否允许
+     */
+    void setGzipEnabled(bool enable) {
+        m_gzip_enabled = enable;
+    }
+
+    /**
+     * @brief 获取是否允许协商 gzip
+     * @return 是否允许
+     */
+    bool isGzipEnabled() const {
+        return m_gzip_enabled;
+    }
+
+    /**
+     * @brief 获取编码对应的压缩级别
+     * @param coding 内容编码
+     * @return 压缩级别，Identity 返回 0
+     */
+    int levelFor(HttpContentCoding coding) const {
+        switch (coding) {
+            case HttpContentCoding::Gzip: return m_gzip_level;
+            case HttpContentCoding::Zstd: return m_zstd_level;
+            default: return 0;
+        }
+    }
+
+private:
+    size_t m_min_length = 1024;  ///< 最小压缩长度（字节）
+    int m_gzip_level = 6;        ///< gzip 压缩级别
+    int m_zstd_level = 3;        ///< zstd 压缩级别
+    bool m_enabled = false;      ///< 是否启用
+    bool m_gzip_enabled = true;  ///< 是否允许 gzip
+    bool m_zstd_enabled = true;  ///< 是否允许 zstd
+};
+
+/**
+ * @brief 按 Accept-Encoding 协商响应编码
+ * @param acceptEncoding 请求的 Accept-Encoding 值，空串表示请求未携带
+ * @param allowGzip 服务端是否可提供 gzip
+ * @param allowZstd 服务端是否可提供 zstd
+ * @return 选中的编码
+ * @details 遵循 RFC 9110 §12.5.3：记号大小写不敏感，"x-gzip" 视同 gzip；
+ *          未列出的编码取 "*" 的 q 值，"*" 也未列出时不可接受；q=0 表示拒绝。
+ *          取 q 值最高的可用编码，q 相同时 zstd 优先；identity 被显式列出且 q 更高时返回 Identity。
+ *          请求未携带 Accept-Encoding 时返回 Identity。
+ *          不检查编码是否编译进当前构建，预压缩文件等无需编解码器的场景可直接使用。
+ */
+HttpContentCoding negotiateContentCoding(std::string_view acceptEncoding,
+                                         bool allowGzip,
+                                         bool allowZstd) noexcept;
+
+/**
+ * @brief 按压缩配置协商响应编码
+ * @param acceptEncoding 请求的 Accept-Encoding 值
+ * @param setting 压缩配置；未启用时返回 Identity
+ * @return 选中的编码；未编译进当前构建的编码视为不可提供
+ */
+HttpContentCoding negotiateContentCoding(std::string_view acceptEncoding,
+                                         const HttpCompressionSetting& setting) noexcept;
+
+/**
+ * @brief 一次性压缩
+ * @param coding 目标编码，不能为 Identity
+ * @param input 原始内容
+ * @param level 压缩级别
+ * @return 压缩结果；编码未编译时返回 kNotImplemented，编解码器出错时返回 kInternalError
+ */
+std::expected<std::string, HttpError> compressContent(HttpContentCoding coding,
+                                                      std::string_view input,
+                                                      int level);
+
+/**
+ * @brief 一次性解压
+ * @param coding 内容编码，Identity 时原样返回
+ * @param input 压缩内容
+ * @param maxOutput 解压结果上限（字节），防止压缩炸弹
+ * @return 解压结果；超出上限返回 kRequestEntityTooLarge，数据损坏返回 kBadRequest
+ */
+std::expected<std::string, HttpError> decompressContent(HttpContentCoding coding,
+                                                        std::string_view input,
+                                                        size_t maxOutput);
+
+/**
+ * @brief 流式压缩器
+ * @details 用于 chunked 响应与 HTTP/2 DATA 帧：每次 update 都做一次同步刷新，
+ *          输出可以立即发给客户端并被增量解码；finish 为 true 时写出编码尾部。
+ *          只能由单个协程顺序使用；可移动不可复制。
+ */
+class HttpStreamCompressor
+{
+public:
+    /**
+     * @brief 创建流式压缩器
+     * @param coding 目标编码，不能为 Identity
+     * @param level 压缩级别
+     * @return 压缩器；编码未编译时返回 kNotImplemented，初始化失败返回 kInternalError
+     */
+    static std::expected<HttpStreamCompressor, HttpError> create(HttpContentCoding coding, int level);
+
+    HttpStreamCompressor(HttpStreamCompressor&&) noexcept;
+    HttpStreamCompressor& operator=(HttpStreamCompressor&&) noexcept;
+    ~HttpStreamCompressor();
+
+    /**
+     * @brief 压缩一段输入
+     * @param input 输入内容，可为空
+     * @param finish 是否为最后一段
+     * @return 本次产出的压缩字节；非最后一段时也可能为空
+     */
+    std::expected<std::string, HttpError> update(std::string_view input, bool finish);
+
+    /**
+     * @brief 获取目标编码
+     * @return 内容编码
+     */
+    HttpContentCoding coding() const noexcept { return m_coding; }
+
+    /**
+     * @brief 是否已写出编码尾部
+     * @return finish 之后返回 true
+     */
+    bool finished() const noexcept { return m_finished; }
+
+private:
+    struct State;
+
+    HttpStreamCompressor(HttpContentCoding coding, std::unique_ptr<State> state) noexcept;
+
+    HttpContentCoding m_coding = HttpContentCoding::Identity;
+    std::unique_ptr<State> m_state;
+    bool m_finished = false;
+};
+
+/**
+ * @brief 原始 DEFLATE 流（RFC 1951，无 zlib / gzip 封装）
+ * @details 供需要跨消息保留滑动窗口的协议复用，如 WebSocket permessage-deflate（RFC 7692）：
+ *          压缩端每次 compress 都做一次同步刷新，输出以空存储块 00 00 ff ff 结尾；
+ *          解压端可按任意字节边界分段喂入。reset 丢弃滑动窗口，对应 no_context_takeover。
+ *          依赖 zlib，未编译 gzip 时 create* 返回 kNotImplemented。只能由单个协程顺序使用；可移动不可复制。
+ */
+class HttpRawDeflateStream
+{
+public:
+    /**
+     * @brief 流方向
+     */
+    enum class Direction : uint8_t
+    {
+        Compress,   ///< 压缩
+        Decompress, ///< 解压
+    };
+
+    /**
+     * @brief 当前构建是否编译了原始 DEFLATE 编解码器
+     * @return 找到 zlib 时为 true
+     */
+    static bool isSupported() noexcept;
+
+    /**
+     * @brief 估算 zlib 状态占用的内存
+     * @param direction 流方向
+     * @param windowBits 滑动窗口位数（9–15）
+     * @param memLevel 压缩端 memLevel（1–9），解压端忽略
+     * @return 字节数，按 zlib 文档给出的公式计算
+     */
+    static size_t estimateMemory(Direction direction, int windowBits, int memLevel) noexcept;
+
+    /**
+     * @brief 创建压缩流
+     * @param level 压缩级别 1–9
+     * @param windowBits 滑动窗口位数 9–15
+     * @param memLevel 内部哈希表规模 1–9
+     * @return 压缩流；未编译返回 kNotImplemented，初始化失败返回 kInternalError
+     */
+    static std::expected<HttpRawDeflateStream, HttpError> createCompressor(int level, int windowBits, int memLevel);
+
+    /**
+     * @brief 创建解压流
+     * @param windowBits 滑动窗口位数 9–15，需不小于对端压缩时使用的窗口
+     * @return 解压流；未编译返回 kNotImplemented，初始化失败返回 kInternalError
+     */
+    static std::expected<HttpRawDeflateStream, HttpError> createDecompressor(int windowBits);
+
+    HttpRawDeflateStream(HttpRawDeflateStream&&) noexcept;
+    HttpRawDeflateStream& operator=(HttpRawDeflateStream&&) noexcept;
+    ~HttpRawDeflateStream();
+
+    /**
+     * @brief 压缩一段输入并同步刷新
+     * @param input 输入内容
+     * @param out 输出缓冲，压缩结果追加在末尾
+     * @return 非压缩流或 zlib 出错时返回错误
+     */
+    std::expected<void, HttpError> compress(std::string_view input, std::string& out);
+
+    /**
+     * @brief 解压一段输入
+     * @param input 压缩字节，可以是任意切分的片段
+     * @param out 输出缓冲，解压结果追加在末尾
+     * @param maxOutput out 的长度上限，防止压缩炸弹
+     * @return 超出上限返回 kRequestEntityTooLarge，数据损坏返回 kBadRequest
+     * @details 遇到 BFINAL 块时流自动重置，其后的输入被丢弃。
+     */
+    std::expected<void, HttpError> decompress(std::string_view input, std::string& out, size_t maxOutput);
+
+    /**
+     * @brief 丢弃滑动窗口与未完成的块，回到初始状态
+     * @return zlib 出错时返回 kInternalError
+     */
+    std::expected<void, HttpError> reset();
+
+    /**
+     * @brief 获取流方向
+     * @return 流方向
+     */
+    Direction direction() const noexcept { return m_direction; }
+
+    /**
+     * @brief 获取滑动窗口位数
+     * @return 创建时的 windowBits
+     */
+    int windowBits() const noexcept { return m_window_bits; }
+
+private:
+    struct State;
+
+    HttpRawDeflateStream(Direction direction, int windowBits, std::unique_ptr<State> state) noexcept;
+
+    Direction m_direction = Direction::Compress;
+    int m_window_bits = 15;
+    std::unique_ptr<State> m_state;
+};
+
+} // namespace galay::http
+
+#endif // GALAY_HTTP_COMPRESSION_H
@@ -15,6 +15,7 @@
 #include "http_writer.h"
 #include "../../galay-kernel/async/async_tcp.h"
 #include "../../galay-utils/cache/ring_buffer.hpp"
+#include <optional>
 
 namespace galay::websocket {
     template<typename SocketType>
@@ -106,7 +107,12 @@ public:
      * @return HttpWriterImpl<SocketType> Writer对象
      */
     HttpWriterImpl<SocketType> getWriter() {
-        return HttpWriterImpl<SocketType>(m_default_writer_setting, m_socket);
+        HttpWriterImpl<SocketType> writer(m_default_writer_setting, m_socket);
+        if (m_response_coding) {
+            writer.setResponseCoding(*m_response_coding);
+        }
+        writer.setPipelineBatch(&m_pipeline_batch);
+        return writer;
     }
 
     /**
@@ -115,7 +121,12 @@ public:
      * @return HttpWriterImpl<SocketType> Writer对象
      */
     HttpWriterImpl<SocketType> getWriter(const HttpWriterSetting& setting) {
-        return HttpWriterImpl<SocketType>(setting, m_socket);
+        HttpWriterImpl<SocketType> writer(setting, m_socket);
+        if (m_response_coding) {
+            writer.setResponseCoding(*m_response_coding);
+        }
+        writer.setPipelineBatch(&m_pipeline_batch);
+        return writer;
     }
 
     /**
@@ -134,10 +145,54 @@ public:
         return m_default_writer_setting;
     }
 
+    /**
+     * @brief 设置当前请求的响应编码
+     * @param coding 按请求 Accept-Encoding 协商出的编码
+     * @details 之后 getWriter() 创建的 writer 会对可压缩响应应用该编码；
+     *          route-mode 服务器在每个请求开始时按 HttpServerPolicy::compression 设置
+     */
+    void setResponseCoding(HttpContentCoding coding) {
+        m_response_coding = coding;
+    }
+
+    /**
+     * @brief 清除当前请求的响应编码
+     */
+    void clearResponseCoding() {
+        m_response_coding.reset();
+    }
+
+    /**
+     * @brief 获取当前请求的响应编码
+     * @return 未设置时返回 std::nullopt
+     */
+    std::optional<HttpContentCoding> responseCoding() const {
+        return m_response_coding;
+    }
+
+    /**
+     * @brief 获取连接级流水线合并缓冲
+     * @return 合并缓冲引用；route-mode 服务器按 HttpServerPolicy::pipeline 配置并逐请求开关暂存
+     * @details 自定义连接处理器可在读到请求后调用
+     *          pipelineBatch().setDeferring(hasBufferedRequest()) 合并流水线响应
+     */
+    HttpPipelineBatch& pipelineBatch() {
+        return m_pipeline_batch;
+    }
+
+    /**
+     * @brief 连接缓冲区中是否已有下一个完整请求
+     * @return 已有完整请求时返回 true，之后的 getRequest 不会等待网络数据
+     */
+    bool hasBufferedRequest() {
+        return m_pipeline_batch.hasBufferedRequest(m_ring_buffer);
+    }
+
     /**
      * @brief 获取底层 Socket 引用
      * @return SocketType 引用
-     * @note 用于需要直接访问底层 socket 的场景（如 WebSocket 升级后的处理）
+     * @note 用于需要直接访问底层 socket 的场景（如 WebSocket 升级后的处理）；
+     *       流水线暂存开启时，直接写 socket 之前先 co_await writer.flushPipelined()
      */
     SocketType& getSocket() { return m_socket; }
 
@@ -172,6 +227,8 @@ private:
     SocketType m_socket;
     RingBuffer<galay::utils::RingBufferBackendStrategy::Mmap, std::dynamic_extent> m_ring_buffer;
     HttpWriterSetting m_default_writer_setting;
+    std::optional<HttpContentCoding> m_response_coding; ///< 当前请求的响应编码
+    HttpPipelineBatch m_pipeline_batch;                 ///< 流水线响应合并缓冲
 };
 
 // 类型别名 - HTTP (AsyncTcpSocket)
@@ -0,0 +1,179 @@
+/**
+ * @file http_pipeline.h
+ * @brief HTTP/1.1 流水线响应合并缓冲
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 客户端流水线发送的多个请求常在一次读取中全部进入连接 RingBuffer。
+ *          HttpPipelineBatch 让 writer 暂存已序列化的完整响应，等到同批最后一个请求的响应
+ *          （或达到深度 / 字节上限）时以一次 writev 发出，把 N 次写系统调用合并为一次。
+ *          是否暂存由连接所有者按"缓冲区中已有下一个完整请求"决定，
+ *          保证暂存期间不会阻塞在读取上，响应顺序与请求顺序一致。
+ */
+
+#ifndef GALAY_HTTP_PIPELINE_H
+#define GALAY_HTTP_PIPELINE_H
+
+#include "../protoc/http_header_view.h"
+#include "../../galay-utils/cache/ring_buffer.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/uio.h>
+
+namespace galay::http
+{
+
+/**
+ * @brief 流水线合并缓冲
+ * @details 由 HttpConn 持有，getWriter() 创建的 writer 共享同一缓冲：
+ *          - 暂存开启且未超出上限时，sendResponse / sendView / sendViews 只把响应移入缓冲，立即完成；
+ *          - 否则 writer 把缓冲中的响应与本次数据拼成一次写出；
+ *          - sendHeader / send / sendChunk 等流式写入总是先带出缓冲内容。
+ *          直接操作 socket 的路径（sendfile、splice 转发）必须先 flushPipelined()。
+ *          只在单个连接协程内使用，不是线程安全的。
+ */
+class HttpPipelineBatch
+{
+public:
+    static constexpr size_t kDefaultMaxDepth = 16;          ///< 默认单批最大响应数
+    static constexpr size_t kDefaultMaxBytes = 64 * 1024;   ///< 默认单批最大字节数
+    static constexpr size_t kMaxDepthLimit = 512;           ///< 深度上限（每个响应至多两段 iovec，受 IOV_MAX 约束）
+
+    HttpPipelineBatch() = default;
+
+    /**
+     * @brief 设置合并上限
+     * @param max_depth 单次写出合并的最大响应数，1 表示不合并；超过 kMaxDepthLimit 时截断
+     * @param max_bytes 暂存的最大字节数；加入后会达到该值的响应触发写出
+     */
+    void configure(size_t max_depth, size_t max_bytes) {
+        m_max_depth = max_depth == 0 ? 1 : (max_depth > kMaxDepthLimit ? kMaxDepthLimit : max_depth);
+        m_max_bytes = max_bytes;
+    }
+
+    size_t maxDepth() const { return m_max_depth; } ///< 单批最大响应数
+    size_t maxBytes() const { return m_max_bytes; } ///< 单批最大字节数
+
+    /**
+     * @brief 设置之后的完整响应是否允许暂存
+     * @param deferring 仅当连接缓冲区已有下一个完整请求时才应为 true
+     */
+    void setDeferring(bool deferring) { m_deferring = deferring; }
+
+    bool isDeferring() const { return m_deferring; } ///< 是否允许暂存
+
+    /**
+     * @brief 判断一个响应能否暂存
+     * @param bytes 响应序列化后的字节数
+     * @return 暂存开启、暂存后响应数小于深度上限且字节数小于字节上限时返回 true
+     */
+    bool admits(size_t bytes) const {
+        return m_deferring &&
+               m_segments.size() / 2 + 1 < m_max_depth &&
+               m_bytes + bytes < m_max_bytes;
+    }
+
+    /**
+     * @brief 暂存一个已序列化的响应
+     * @param head 响应头（或完整响应）
+     * @param body 响应体，可为空
+     */
+    void append(std::string&& head, std::string&& body) {
+        m_bytes += head.size() + body.size();
+        m_segments.push_back(std::move(head));
+        m_segments.push_back(std::move(body));
+    }
+
+    bool empty() const { return m_segments.empty(); }           ///< 是否没有暂存响应
+    size_t bytes() const { return m_bytes; }                    ///< 暂存字节数
+    size_t responses() const { return m_segments.size() / 2; } ///< 暂存响应数
+
+    /**
+     * @brief 取出全部暂存段，清空缓冲
+     * @param out 接收暂存段；与内部容器交换以复用容量
+     */
+    void takeSegments(std::vector<std::string>& out) {
+        ++m_flushes;
+        m_coalesced += m_segments.size() / 2;
+        out.clear();
+        out.swap(m_segments);
+        m_bytes = 0;
+    }
+
+    /**
+     * @brief 取出全部暂存内容并拼接到 out 末尾
+     * @param out 输出缓冲
+     */
+    void drainTo(std::string& out) {
+        out.reserve(out.size() + m_bytes);
+        for (const std::string& segment : m_segments) {
+            out.append(segment);
+        }
+        ++m_flushes;
+        m_coalesced += m_segments.size() / 2;
+        m_segments.clear();
+        m_bytes = 0;
+    }
+
+    uint64_t flushes() const { return m_flushes; }     ///< 带出暂存响应的写出次数
+    uint64_t coalesced() const { return m_coalesced; } ///< 经暂存后合并写出的响应数
+
+    /**
+     * @brief 探测缓冲区中是否已有一个完整请求
+     * @param ring_buffer 连接接收缓冲区
+     * @return 请求头完整，且没有请求体或 Content-Length 请求体已全部到达时返回 true
+     * @details 非增量探测，不消耗字节；chunked 请求体、请求头不完整或解析失败时保守返回 false，
+     *          之后的读取照常报告错误。
+     */
+    bool hasBufferedRequest(
+        const ::galay::utils::RingBuffer<::galay::utils::RingBufferBackendStrategy::Mmap, std::dynamic_extent>& ring_buffer) {
+        const size_t readable = ring_buffer.readable();
+        if (readable == 0) {
+            return false;
+        }
+        std::array<struct iovec, 2> iovecs{};
+        if (ring_buffer.getReadIovecs(iovecs) != 1) {
+            return false;
+        }
+        const std::string_view data(static_cast<const char*>(iovecs[0].iov_base), iovecs[0].iov_len);
+        auto [error_code, header_bytes] = m_probe.parse(data);
+        if (error_code != kNoError || header_bytes <= 0) {
+            return false;
+        }
+        if (m_probe.has("transfer-encoding")) {
+            return false;
+        }
+        size_t body_bytes = 0;
+        if (m_probe.has(CommonHeaderIndex::ContentLength)) {
+            const std::string_view value = m_probe.find(CommonHeaderIndex::ContentLength);
+            if (value.empty() || value.size() > 18) {
+                return false;
+            }
+            for (const char c : value) {
+                if (c < '0' || c > '9') {
+                    return false;
+                }
+                body_bytes = body_bytes * 10 + static_cast<size_t>(c - '0');
+            }
+        }
+        return static_cast<size_t>(header_bytes) + body_bytes <= readable;
+    }
+
+private:
+    std::vector<std::string> m_segments;          ///< 暂存段，每个响应两段（头、体）
+    HttpRequestHeaderView m_probe;                ///< 请求探测视图，复用字段数组
+    size_t m_bytes = 0;                           ///< 暂存字节数
+    size_t m_max_depth = kDefaultMaxDepth;        ///< 单批最大响应数
+    size_t m_max_bytes = kDefaultMaxBytes;        ///< 单批最大字节数
+    uint64_t m_flushes = 0;                       ///< 带出暂存响应的写出次数
+    uint64_t m_coalesced = 0;                     ///< 经暂存后合并写出的响应数
+    bool m_deferring = false;                     ///< 是否允许暂存
+};
+
+} // namespace galay::http
+
+#endif // GALAY_HTTP_PIPELINE_H
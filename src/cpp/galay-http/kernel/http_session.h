@@ -25,6 +25,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #ifdef GALAY_SSL_FEATURE_ENABLED
 #include "../../galay-ssl/async/ssl_await.h"
@@ -218,15 +219,213 @@ struct HttpSessionState {
     std::optional<std::optional<HttpResponse>> m_response_value;        ///< 解析完成的响应值
 };
 
+/**
+ * @brief HTTP 流水线会话状态
+ * @details 同一连接上最多保持 depth 个未收到响应的请求：初始一次写出前 depth 个请求，
+ *          之后每收到一个响应就追加下一个请求，等当前批次写完后与其他新增请求一起写出。
+ *          响应按请求顺序解析；任一响应失败或连接关闭时整体返回错误。
+ */
+template<typename SocketType>
+struct HttpSessionPipelineState {
+    using ResultType = std::expected<std::vector<HttpResponse>, HttpError>; ///< 结果类型
+
+    /**
+     * @brief 构造函数
+     * @param session 所属会话
+     * @param requests 待发送的请求，按顺序发送并按顺序匹配响应
+     * @param depth 未收到响应的请求数上限
+     */
+    HttpSessionPipelineState(HttpSessionImpl<SocketType>& session,
+                             std::vector<HttpRequest>&& requests,
+                             size_t depth)
+        : m_session(&session)
+        , m_requests(std::move(requests))
+        , m_depth(depth == 0 ? 1 : depth) {
+        m_responses.reserve(m_requests.size());
+        for (auto& request : m_requests) {
+            const HttpMethod method = request.header().method();
+            // 响应解析不知道请求方法，HEAD / CONNECT 的响应无法在流水线中定界
+            if (method == HttpMethod::HEAD || method == HttpMethod::CONNECT) {
+                m_error = HttpError(kMethodNotAllow, "HEAD and CONNECT cannot be pipelined");
+                return;
+            }
+        }
+        fillSendBuffer();
+    }
+
+    bool sendCompleted() const { ///< 判断当前批次是否已完全发送
+        return m_send_offset >= m_send_buffer.size();
+    }
+
+    const char* sendBuffer() const { ///< 获取当前发送缓冲区指针
+        return m_send_buffer.data() + m_send_offset;
+    }
+
+    size_t sendRemaining() const { ///< 获取剩余待发送字节数
+        return m_send_buffer.size() - m_send_offset;
+    }
+
+    void onBytesSent(size_t sent) { ///< 处理已发送字节数，批次写完后追加待发请求
+        m_send_offset += sent;
+        if (sendCompleted()) {
+            m_send_buffer.clear();
+            m_send_offset = 0;
+            fillSendBuffer();
+        }
+    }
+
+    /**
+     * @brief 从 RingBuffer 中解析所有已完整到达的响应
+     * @return 全部响应收齐或出错时返回 true
+     */
+    bool parseFromRingBuffer() {
+        if (m_error.has_value()) {
+            return true;
+        }
+        while (m_responses.size() < m_requests.size()) {
+            auto read_iovecs = borrowReadIovecs(m_session->getRingBuffer());
+            if (read_iovecs.empty() || IoVecWindow::buildWindow(read_iovecs, m_parse_iovecs) == 0) {
+                return false;
+            }
+
+            auto [error_code, consumed] =
+                m_response.fromIOVec(m_parse_iovecs, m_session->getReaderSetting().getMaxBodySize());
+            if (consumed > 0) {
+                m_session->getRingBuffer().consume(static_cast<size_t>(consumed));
+            }
+
+            if (error_code == kHeaderInComplete || error_code == kIncomplete) {
+                if (m_total_received >= m_session->getReaderSetting().getMaxHeaderSize() &&
+                    !m_response.isComplete() && !m_response.header().isHeaderComplete()) {
+                    m_error = HttpError(kHeaderTooLarge);
+                    return true;
+                }
+                return false;
+            }
+            if (error_code != kNoError) {
+                m_error = HttpError(error_code);
+                return true;
+            }
+            if (!m_response.isComplete()) {
+                return false;
+            }
+
+            m_responses.push_back(std::move(m_response));
+            m_response = HttpResponse();
+            m_total_received = m_session->getRingBuffer().readable();
+            if (sendCompleted()) {
+                fillSendBuffer();
+            }
+        }
+        return true;
+    }
+
+    bool prepareRecvWindow() { ///< 准备 TCP 接收窗口
+        m_write_iovecs = borrowWriteIovecs(m_session->getRingBuffer());
+        if (m_write_iovecs.empty()) {
+            m_error = HttpError(kHeaderTooLarge);
+            return false;
+        }
+        return true;
+    }
+
+    bool prepareRecvWindow(char*& buffer, size_t& length) { ///< 准备 SSL 接收窗口
+        if (!prepareRecvWindow()) {
+            buffer = nullptr;
+            length = 0;
+            return false;
+        }
+        if (!IoVecWindow::bindFirstNonEmpty(m_write_iovecs, buffer, length)) {
+            m_error = HttpError(kHeaderTooLarge);
+            return false;
+        }
+        return true;
+    }
+
+    const struct iovec* recvIovecsData() const { return m_write_iovecs.data(); }
+    size_t recvIovecsCount() const { return m_write_iovecs.size(); }
+
+    void setSendError(const IOError& io_error) {
+        if (IOError::contains(io_error.code(), kTimeout)) {
+            m_error = HttpError(kRequestTimeOut, io_error.message());
+            return;
+        }
+        m_error = HttpError(kSendError, io_error.message());
+    }
+
+    void setRecvError(const IOError& io_error) {
+        if (IOError::contains(io_error.code(), kTimeout)) {
+            m_error = HttpError(kRequestTimeOut, io_error.message());
+            return;
+        }
+        if (IOError::contains(io_error.code(), kDisconnectError)) {
+            m_error = HttpError(kConnectionClose);
+            return;
+        }
+        m_error = HttpError(kTcpRecvError, io_error.message());
+    }
+
+#ifdef GALAY_SSL_FEATURE_ENABLED
+    void setSslSendError(const galay::ssl::SslError& error) {
+        m_error = HttpError(error);
+    }
+
+    void setSslRecvError(const galay::ssl::SslError& error) {
+        m_error = HttpError(error);
+    }
+#endif
+
+    void onPeerClosed() {
+        m_error = HttpError(kConnectionClose);
+    }
+
+    void onBytesReceived(size_t recv_bytes) {
+        m_session->getRingBuffer().produce(recv_bytes);
+        m_total_received += recv_bytes;
+    }
+
+    ResultType takeResult() {
+        if (m_error.has_value()) {
+            return std::unexpected(std::move(*m_error));
+        }
+        return std::move(m_responses);
+    }
+
+    /**
+     * @brief 把未发送的请求追加到发送缓冲，直到未收到响应的请求数达到 depth
+     */
+    void fillSendBuffer() {
+        while (m_next_request < m_requests.size() &&
+               m_next_request - m_responses.size() < m_depth) {
+            m_send_buffer += m_requests[m_next_request].toString();
+            ++m_next_request;
+        }
+    }
+
+    HttpSessionImpl<SocketType>* m_session;                             ///< 所属会话指针
+    std::vector<HttpRequest> m_requests;                                ///< 待发送的请求
+    std::vector<HttpResponse> m_responses;                              ///< 已收到的响应
+    HttpResponse m_response;                                            ///< 正在解析的响应
+    std::string m_send_buffer;                                          ///< 当前批次发送缓冲
+    size_t m_send_offset = 0;                                           ///< 当前批次已发送偏移量
+    size_t m_next_request = 0;                                          ///< 下一个待发送请求下标
+    size_t m_depth = 1;                                                 ///< 未收到响应的请求数上限
+    size_t m_total_received = 0;                                        ///< 当前响应已接收字节数
+    std::vector<iovec> m_parse_iovecs;                                  ///< 解析用 iovec 缓冲
+    BorrowedIovecs<2> m_write_iovecs;                                   ///< 接收窗口 iovec
+    std::optional<HttpError> m_error;                                   ///< HTTP 错误
+};
+
 /**
  * @brief HTTP 会话 TCP 状态机
  * @details 驱动请求发送（write）和响应接收（readv）的异步流程
+ * @tparam StateT 会话状态，单请求为 HttpSessionState，流水线为 HttpSessionPipelineState
  */
-template<typename SocketType>
+template<typename SocketType, typename StateT = HttpSessionState<SocketType>>
 struct HttpSessionTcpMachine {
-    using result_type = typename HttpSessionState<SocketType>::ResultType;
+    using result_type = typename StateT::ResultType;
 
-    explicit HttpSessionTcpMachine(std::shared_ptr<HttpSessionState<SocketType>> state)
+    explicit HttpSessionTcpMachine(std::shared_ptr<StateT> state)
         : m_state(std::move(state)) {}
 
     MachineAction<result_type> advance() {
@@ -245,6 +444,13 @@ struct HttpSessionTcpMachine {
             return MachineAction<result_type>::complete(std::move(*m_result));
         }
 
+        // 流水线解析出响应后可能追加了新请求，先写再读
+        if (!m_state->sendCompleted()) {
+            return MachineAction<result_type>::waitWrite(
+                m_state->sendBuffer(),
+                m_state->sendRemaining());
+        }
+
         if (!m_state->prepareRecvWindow()) {
             m_result = m_state->takeResult();
             return MachineAction<result_type>::complete(std::move(*m_result));
@@ -281,7 +487,7 @@ struct HttpSessionTcpMachine {
         m_state->onBytesSent(result.value());
     }
 
-    std::shared_ptr<HttpSessionState<SocketType>> m_state;
+    std::shared_ptr<StateT> m_state;
     std::optional<result_type> m_result;
 };
 
@@ -290,11 +496,11 @@ struct HttpSessionTcpMachine {
  * @brief HTTP 会话 SSL 状态机
  * @details SSL 版本的会话状态机，使用 SSL send/recv 驱动
  */
-template<typename SocketType>
+template<typename SocketType, typename StateT = HttpSessionState<SocketType>>
 struct HttpSessionSslMachine {
-    using result_type = typename HttpSessionState<SocketType>::ResultType;
+    using result_type = typename StateT::ResultType;
 
-    explicit HttpSessionSslMachine(std::shared_ptr<HttpSessionState<SocketType>> state)
+    explicit HttpSessionSslMachine(std::shared_ptr<StateT> state)
         : m_state(std::move(state)) {}
 
     galay::ssl::SslMachineAction<result_type> advance() {
@@ -313,6 +519,12 @@ struct HttpSessionSslMachine {
             return galay::ssl::SslMachineAction<result_type>::complete(std::move(*m_result));
         }
 
+        if (!m_state->sendCompleted()) {
+            return galay::ssl::SslMachineAction<result_type>::send(
+                m_state->sendBuffer(),
+                m_state->sendRemaining());
+        }
+
         char* recv_buffer = nullptr;
         size_t recv_length = 0;
         if (!m_state->prepareRecvWindow(recv_buffer, recv_length)) {
@@ -354,7 +566,7 @@ struct HttpSessionSslMachine {
 
     void onShutdown(std::expected<void, galay::ssl::SslError>) {}
 
-    std::shared_ptr<HttpSessionState<SocketType>> m_state;
+    std::shared_ptr<StateT> m_state;
     std::optional<result_type> m_result;
 };
 #endif
@@ -421,6 +633,40 @@ auto buildSessionOperation(HttpSessionImpl<SocketType>& session, std::string&& s
     }
 }
 
+/**
+ * @brief 构建 HTTP 流水线异步操作
+ * @tparam SocketType Socket 类型
+ * @param session HTTP 会话引用
+ * @param requests 待发送的请求
+ * @param depth 未收到响应的请求数上限
+ * @return 可 co_await 的异步操作对象
+ */
+template<typename SocketType>
+auto buildPipelineOperation(HttpSessionImpl<SocketType>& session,
+                            std::vector<HttpRequest>&& requests,
+                            size_t depth) {
+    using State = HttpSessionPipelineState<SocketType>;
+    using ResultType = typename State::ResultType;
+    auto state = std::make_shared<State>(session, std::move(requests), depth);
+
+    if constexpr (std::is_same_v<SocketType, AsyncTcpSocket>) {
+        return AwaitableBuilder<ResultType>::fromStateMachine(
+                   session.getSocket().controller(),
+                   HttpSessionTcpMachine<SocketType, State>(std::move(state)))
+            .build();
+    } else {
+#ifdef GALAY_SSL_FEATURE_ENABLED
+        return galay::ssl::SslAwaitableBuilder<ResultType>::fromStateMachine(
+                   session.getSocket().controller(),
+                   &session.getSocket(),
+                   HttpSessionSslMachine<SocketType, State>(std::move(state)))
+            .build();
+#else
+        static_assert(!sizeof(SocketType), "SSL support is disabled");
+#endif
+    }
+}
+
 } // namespace detail
 
 /**
@@ -604,6 +850,35 @@ public:
         return detail::buildSessionOperation(*this, std::move(request));
     }
 
+    /**
+     * @brief 设置流水线深度
+     * @param depth pipeline() 中未收到响应的请求数上限，0 按 1 处理（即逐个请求-响应）
+     */
+    void setPipelineDepth(size_t depth) {
+        m_pipeline_depth = depth == 0 ? 1 : depth;
+    }
+
+    /**
+     * @brief 获取流水线深度
+     * @return 未收到响应的请求数上限
+     */
+    size_t pipelineDepth() const {
+        return m_pipeline_depth;
+    }
+
+    /**
+     * @brief 以 HTTP/1.1 流水线发送一组请求
+     * @param requests 待发送的请求，所有权转移到 awaitable 内部
+     * @return 请求-响应一体化 awaitable；co_await 结果为
+     *         std::expected<std::vector<HttpResponse>, HttpError>，响应顺序与请求一致
+     * @details 最多 pipelineDepth() 个请求处于未响应状态，多个请求合并为一次写出。
+     *          HEAD 与 CONNECT 请求返回 kMethodNotAllow；服务端中途关闭连接时返回 kConnectionClose，
+     *          已收到的响应随之丢弃，调用方应在新连接上重发。
+     */
+    auto pipeline(std::vector<HttpRequest> requests) {
+        return detail::buildPipelineOperation(*this, std::move(requests), m_pipeline_depth);
+    }
+
     /**
      * @brief 异步接收 HTTP 响应
      * @param response 待填充的响应对象
@@ -678,6 +953,7 @@ private:
     HttpWriterSetting m_writer_setting;                      ///< 写入器配置
     HttpReaderImpl<SocketType> m_reader;                     ///< 读取器
     HttpWriterImpl<SocketType> m_writer;                     ///< 写入器
+    size_t m_pipeline_depth = 16;                            ///< 流水线深度
 };
 
 using HttpSession = HttpSessionImpl<AsyncTcpSocket>; ///< HTTP 明文会话类型别名
@@ -13,6 +13,7 @@
 #define GALAY_HTTP_WRITER_H
 
 #include "writer_settings.h"
+#include "http_pipeline.h"
 #include "../common/http_log.h"
 #include "../common/iovec_utils.h"
 #include "../protoc/http_response.h"
@@ -24,6 +25,7 @@
 #include <array>
 #include <chrono>
 #include <expected>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -297,7 +299,20 @@ public:
         if (m_remaining_bytes == 0) {
             logResponseStatus(response.header().code());
 
-            if constexpr (is_tcp_socket_v<SocketType>) {
+            if (isEncodableResponse(response.header(), response.bodyStr().size())) {
+                // 响应编码只作用于本次发送，不改写调用方的响应对象
+                HttpResponseHeader header = response.header().clone();
+                std::string body = response.bodyStr();
+                applyResponseCoding(header, body);
+                if constexpr (is_tcp_socket_v<SocketType>) {
+                    m_body_buffer = std::move(body);
+                    m_buffer = header.toString();
+                    prepareTcpSendLayout();
+                    pipelineResponseLayout(response.header().code());
+                } else {
+                    prepareSslSendLayout(header.toString(), body);
+                }
+            } else if constexpr (is_tcp_socket_v<SocketType>) {
                 m_body_buffer = response.bodyStr();
 
                 if (!response.header().isChunked()) {
@@ -306,6 +321,7 @@ public:
 
                 m_buffer = response.header().toString();
                 prepareTcpSendLayout();
+                pipelineResponseLayout(response.header().code());
             } else {
                 if (!response.header().isChunked()) {
                     ensureContentLength(response.header().headerPairs(), response.bodyStr().size());
@@ -334,12 +350,15 @@ public:
                 logResponseStatus(response.header().code());
                 m_body_buffer = response.getBodyStr();
 
-                if (!response.header().isChunked()) {
+                if (isEncodableResponse(response.header(), m_body_buffer.size())) {
+                    applyResponseCoding(response.header(), m_body_buffer);
+                } else if (!response.header().isChunked()) {
                     ensureContentLength(response.header().headerPairs(), m_body_buffer.size());
                 }
 
                 m_buffer = response.header().toString();
                 prepareTcpSendLayout();
+                pipelineResponseLayout(response.header().code());
             }
 
             return withConfiguredTimeout(makeWritevAwaitable());
@@ -412,12 +431,20 @@ public:
      * @return 可 co_await 的异步操作；co_await 结果为
      *         std::expected<bool, HttpError>，成功值为 true，失败时 error() 为 HttpError
      * @note 启动新发送时，待发送数据会在返回异步操作前保存到 writer，不持有 header 引用
+     * @note 已设置响应编码且 header 为 chunked 时，会附加 Content-Encoding 并让后续 sendChunk 流式压缩
      */
     auto sendHeader(HttpResponseHeader& header) {
         if (m_remaining_bytes == 0) {
             logResponseStatus(header.code());
-            m_buffer = header.toString();
+            if (isEncodableStream(header)) {
+                HttpResponseHeader encoded = header.clone();
+                armStreamCompressor(encoded);
+                m_buffer = encoded.toString();
+            } else {
+                m_buffer = header.toString();
+            }
             m_remaining_bytes = m_buffer.size();
+            prependPipelined();
         }
 
         return withConfiguredTimeout(makeSendAwaitable());
@@ -470,6 +497,7 @@ public:
             clearExternalBuffer();
             m_buffer = std::move(data);
             m_remaining_bytes = m_buffer.size();
+            prependPipelined();
         }
 
         return withConfiguredTimeout(makeSendAwaitable());
@@ -487,6 +515,7 @@ public:
             clearExternalBuffer();
             m_buffer.assign(buffer, length);
             m_remaining_bytes = m_buffer.size();
+            prependPipelined();
         }
 
         return withConfiguredTimeout(makeSendAwaitable());
@@ -508,28 +537,143 @@ public:
             m_external_buffer = data.data();
             m_external_buffer_size = data.size();
             m_remaining_bytes = data.size();
+            pipelineViewLayout(data);
         }
 
         return withConfiguredTimeout(makeSendAwaitable());
     }
 
+    /**
+     * @brief 以一次 writev 发送外部持有的响应头与响应体视图
+     * @param head 已渲染的响应头（含结尾空行）
+     * @param body 响应体视图，可为空
+     * @return 可 co_await 的异步操作；co_await 结果为
+     *         std::expected<bool, HttpError>，成功值为 true，失败时 error() 为 HttpError
+     * @note 调用方必须保证两段视图的底层存储在 await 完成前保持有效
+     * @note TCP 模式直接引用两段视图，不复制到 writer；SSL 模式需要合并为一段密文输入
+     */
+    auto sendViews(std::string_view head, std::string_view body) {
+        if (m_remaining_bytes == 0) {
+            if constexpr (is_tcp_socket_v<SocketType>) {
+                m_buffer.clear();
+                m_body_buffer.clear();
+                clearExternalBuffer();
+                std::array<iovec, 2> iovecs{};
+                size_t iov_count = 0;
+                if (!head.empty()) {
+                    iovecs[iov_count++] = {const_cast<char*>(head.data()), head.size()};
+                }
+                if (!body.empty()) {
+                    iovecs[iov_count++] = {const_cast<char*>(body.data()), body.size()};
+                }
+                m_writev_cursor.reset(iovecs, iov_count);
+                m_remaining_bytes = m_writev_cursor.remainingBytes();
+                pipelineViewsLayout(head, body);
+            } else {
+                prepareSslSendLayout(std::string(head), body);
+            }
+        }
+
+        if constexpr (is_tcp_socket_v<SocketType>) {
+            return withConfiguredTimeout(makeWritevAwaitable());
+        } else {
+            return withConfiguredTimeout(makeSendAwaitable());
+        }
+    }
+
     /**
      * @brief 异步发送 chunked 编码数据块
      * @param data 数据内容
      * @param is_last 是否为最后一个 chunk
      * @return 可 co_await 的异步操作；co_await 结果为
      *         std::expected<bool, HttpError>，成功值为 true，失败时 error() 为 HttpError
+     * @note 流式压缩时 data 先经压缩器同步刷新；压缩输出为空的中间块不会写出任何字节
      */
     auto sendChunk(const std::string& data, bool is_last = false) {
         if (m_remaining_bytes == 0) {
             clearExternalBuffer();
-            m_buffer = Chunk::toChunk(data, is_last);
+            if (m_stream_compressor) {
+                m_buffer = encodeChunk(data, is_last);
+            } else {
+                m_buffer = Chunk::toChunk(data, is_last);
+            }
             m_remaining_bytes = m_buffer.size();
+            prependPipelined();
         }
 
         return withConfiguredTimeout(makeSendAwaitable());
     }
 
+    /**
+     * @brief 按请求的 Accept-Encoding 协商并设置本 writer 的响应编码
+     * @param request HTTP 请求
+     * @return 协商结果；压缩未启用时返回 Identity
+     */
+    HttpContentCoding negotiateCompression(HttpRequest& request) {
+        const std::string* accept = request.header().headerPairs().getValuePtr("Accept-Encoding");
+        const HttpContentCoding coding = accept == nullptr
+            ? HttpContentCoding::Identity
+            : negotiateContentCoding(*accept, m_setting.getCompression());
+        if (m_setting.getCompression().isEnabled()) {
+            setResponseCoding(coding);
+        }
+        return coding;
+    }
+
+    /**
+     * @brief 设置响应编码
+     * @param coding 内容编码；Identity 表示不压缩但仍为可压缩响应附加 Vary: Accept-Encoding
+     * @details 之后的 sendResponse 与 chunked sendHeader 会对满足条件的响应应用该编码
+     */
+    void setResponseCoding(HttpContentCoding coding) {
+        m_response_coding = coding;
+    }
+
+    /**
+     * @brief 关闭本 writer 的响应编码
+     * @details 用于自行决定编码的路径（如静态文件的预压缩变体）
+     */
+    void disableCompression() {
+        m_response_coding.reset();
+        m_stream_compressor.reset();
+    }
+
+    /**
+     * @brief 获取已设置的响应编码
+     * @return 未设置时返回 std::nullopt
+     */
+    std::optional<HttpContentCoding> responseCoding() const {
+        return m_response_coding;
+    }
+
+    /**
+     * @brief 绑定连接级流水线合并缓冲
+     * @param batch 合并缓冲，nullptr 表示每次发送直接写出；仅 TCP 连接生效
+     * @details HttpConn::getWriter() 会自动绑定连接自身的缓冲
+     */
+    void setPipelineBatch(HttpPipelineBatch* batch) {
+        m_pipeline_batch = batch;
+    }
+
+    /**
+     * @brief 写出合并缓冲中暂存的响应
+     * @return 可 co_await 的异步操作；co_await 结果为
+     *         std::expected<bool, HttpError>，没有暂存响应时立即返回 true
+     * @note 直接操作 socket（sendfile、splice 等）之前必须调用，保证响应顺序
+     */
+    auto flushPipelined() {
+        if constexpr (is_tcp_socket_v<SocketType>) {
+            if (m_remaining_bytes == 0 && m_pipeline_batch != nullptr && !m_pipeline_batch->empty()) {
+                m_buffer.clear();
+                m_body_buffer.clear();
+                clearExternalBuffer();
+                m_writev_cursor.clear();
+                gatherPipelined();
+            }
+        }
+        return withConfiguredTimeout(makeWritevAwaitable());
+    }
+
     void updateRemaining(size_t bytes_sent) {
         if (bytes_sent >= m_remaining_bytes) {
             m_remaining_bytes = 0;
@@ -537,6 +681,7 @@ public:
             m_body_buffer.clear();
             clearExternalBuffer();
             m_writev_cursor.clear();
+            m_pipeline_segments.clear();
         } else {
             m_remaining_bytes -= bytes_sent;
         }
@@ -550,6 +695,7 @@ public:
             m_body_buffer.clear();
             clearExternalBuffer();
             m_writev_cursor.clear();
+            m_pipeline_segments.clear();
         } else {
             m_remaining_bytes -= advanced;
         }
@@ -657,6 +803,228 @@ private:
         ++m_fast_path_counters.ssl_coalesced_layout_hits;
     }
 
+    bool hasPipelined() const {
+        return is_tcp_socket_v<SocketType> && m_pipeline_batch != nullptr && !m_pipeline_batch->empty();
+    }
+
+    bool pipelineAdmits(HttpStatusCode code) const {
+        // 1xx 中间响应（如 101 升级）之后连接可能改由其他协议接管，不能暂存
+        return is_tcp_socket_v<SocketType> && m_pipeline_batch != nullptr &&
+               static_cast<int>(code) >= 200 && m_pipeline_batch->admits(m_remaining_bytes);
+    }
+
+    // sendResponse 布局完成后调用：能暂存则移入合并缓冲，否则与暂存响应一起写出
+    void pipelineResponseLayout(HttpStatusCode code) {
+        if (pipelineAdmits(code)) {
+            m_pipeline_batch->append(std::move(m_buffer), std::move(m_body_buffer));
+            m_buffer.clear();
+            m_body_buffer.clear();
+            m_writev_cursor.clear();
+            m_remaining_bytes = 0;
+        } else if (hasPipelined()) {
+            gatherPipelined();
+        }
+    }
+
+    // sendView 的单段视图：暂存时复制，写出时与暂存响应拼成一段
+    void pipelineViewLayout(std::string_view data) {
+        if (pipelineAdmits(HttpStatusCode::OK_200)) {
+            m_pipeline_batch->append(std::string(data), std::string());
+            clearExternalBuffer();
+            m_remaining_bytes = 0;
+        } else if (hasPipelined()) {
+            clearExternalBuffer();
+            m_buffer.clear();
+            m_pipeline_batch->drainTo(m_buffer);
+            m_buffer.append(data);
+            m_remaining_bytes = m_buffer.size();
+        }
+    }
+
+    // sendViews 的头、体视图：暂存时复制，写出时视图直接接在暂存段之后
+    void pipelineViewsLayout(std::string_view head, std::string_view body) {
+        if (pipelineAdmits(HttpStatusCode::OK_200)) {
+            m_pipeline_batch->append(std::string(head), std::string(body));
+            m_writev_cursor.clear();
+            m_remaining_bytes = 0;
+        } else if (hasPipelined()) {
+            gatherPipelined();
+        }
+    }
+
+    // 流式写入（头、chunk、原始字节）先带出暂存响应，保持响应顺序
+    void prependPipelined() {
+        if (!hasPipelined()) {
+            return;
+        }
+        std::string joined;
+        m_pipeline_batch->drainTo(joined);
+        if (m_external_buffer != nullptr) {
+            joined.append(m_external_buffer, m_external_buffer_size);
+            clearExternalBuffer();
+        } else {
+            joined.append(m_buffer);
+        }
+        m_buffer = std::move(joined);
+        m_remaining_bytes = m_buffer.size();
+    }
+
+    // 把暂存段放在当前 writev 窗口之前，一次写出
+    void gatherPipelined() {
+        m_writev_cursor.exportWindow(m_pipeline_tail);
+        m_pipeline_batch->takeSegments(m_pipeline_segments);
+        m_writev_cursor.clear();
+        m_writev_cursor.reserve(m_pipeline_segments.size() + m_pipeline_tail.size());
+        for (std::string& segment : m_pipeline_segments) {
+            m_writev_cursor.append({segment.data(), segment.size()});
+        }
+        for (const iovec& segment : m_pipeline_tail) {
+            m_writev_cursor.append(segment);
+        }
+        m_remaining_bytes = m_writev_cursor.remainingBytes();
+    }
+
+    // 响应状态与头部是否允许改写内容编码
+    bool isEncodableHeader(HttpResponseHeader& header) const {
+        if (!m_response_coding) {
+            return false;
+        }
+        const int status = static_cast<int>(header.code());
+        if (status < 200 || status == 204 || status == 206 || status == 304) {
+            return false;
+        }
+        HeaderPair& headers = header.headerPairs();
+        if (headers.hasKey("Content-Encoding") || headers.hasKey("Content-Range")) {
+            return false;
+        }
+        const std::string* cache_control = headers.getValuePtr("Cache-Control");
+        if (cache_control != nullptr && cache_control->find("no-transform") != std::string::npos) {
+            return false;
+        }
+        const std::string* content_type = headers.getValuePtr("Content-Type");
+        return content_type != nullptr && isCompressibleMimeType(*content_type);
+    }
+
+    bool isEncodableResponse(HttpResponseHeader& header, size_t body_size) const {
+        return !header.isChunked() &&
+               body_size >= m_setting.getCompression().getMinLength() &&
+               isEncodableHeader(header);
+    }
+
+    bool isEncodableStream(HttpResponseHeader& header) const {
+        return header.isChunked() && isEncodableHeader(header);
+    }
+
+    // 压缩 body 并改写响应头；压缩失败时按 identity 发送
+    void applyResponseCoding(HttpResponseHeader& header, std::string& body) {
+        HeaderPair& headers = header.headerPairs();
+        const HttpContentCoding coding = *m_response_coding;
+        if (coding != HttpContentCoding::Identity) {
+            auto compressed = compressContent(coding, body, m_setting.getCompression().levelFor(coding));
+            if (compressed) {
+                body = std::move(compressed.value());
+                headers.addHeaderPair("Content-Encoding", std::string(contentCodingToken(coding)));
+                headers.addHeaderPair("Content-Length", std::to_string(body.size()));
+                weakenEtag(headers);
+            } else {
+                HTTP_LOG_WARN("[writer] [compress-fail]", "coding={} msg={}",
+                              contentCodingToken(coding), compressed.error().message());
+            }
+        }
+        mergeVaryAcceptEncoding(headers);
+        ensureContentLength(headers, body.size());
+    }
+
+    void armStreamCompressor(HttpResponseHeader& header) {
+        HeaderPair& headers = header.headerPairs();
+        const HttpContentCoding coding = *m_response_coding;
+        if (coding != HttpContentCoding::Identity) {
+            auto compressor = HttpStreamCompressor::create(coding, m_setting.getCompression().levelFor(coding));
+            if (compressor) {
+                m_stream_compressor = std::make_shared<HttpStreamCompressor>(std::move(compressor.value()));
+                headers.addHeaderPair("Content-Encoding", std::string(contentCodingToken(coding)));
+                headers.removeHeaderPair("Content-Length");
+                weakenEtag(headers);
+            } else {
+                HTTP_LOG_WARN("[writer] [compress-fail]", "coding={} msg={}",
+                              contentCodingToken(coding), compressor.error().message());
+            }
+        }
+        mergeVaryAcceptEncoding(headers);
+    }
+
+    std::string encodeChunk(const std::string& data, bool is_last) {
+        auto encoded = m_stream_compressor->update(data, is_last);
+        if (!encoded) {
+            // 流已部分发出，无法退回 identity；只能结束压缩流并由客户端报告解码错误
+            HTTP_LOG_ERROR("[writer] [compress-fail]", "msg={}", encoded.error().message());
+            m_stream_compressor.reset();
+            return is_last ? Chunk::toChunk(std::string(), true) : std::string();
+        }
+        std::string out;
+        if (!encoded->empty()) {
+            out = Chunk::toChunk(*encoded, false);
+        }
+        if (is_last) {
+            out += Chunk::toChunk(std::string(), true);
+            m_stream_compressor.reset();
+        }
+        return out;
+    }
+
+    static void mergeVaryAcceptEncoding(HeaderPair& headers) {
+        const std::string* vary = headers.getValuePtr("Vary");
+        if (vary == nullptr || vary->empty()) {
+            headers.addHeaderPair("Vary", "Accept-Encoding");
+            return;
+        }
+        if (*vary == "*" || containsToken(*vary, "accept-encoding")) {
+            return;
+        }
+        headers.addHeaderPair("Vary", *vary + ", Accept-Encoding");
+    }
+
+    // 编码后的表示与原始字节不同，强 ETag 降为弱 ETag
+    static void weakenEtag(HeaderPair& headers) {
+        const std::string* etag = headers.getValuePtr("ETag");
+        if (etag != nullptr && !etag->empty() && etag->front() == '"') {
+            headers.addHeaderPair("ETag", "W/" + *etag);
+        }
+    }
+
+    static bool containsToken(std::string_view list, std::string_view token) {
+        size_t pos = 0;
+        while (pos < list.size()) {
+            size_t end = list.find(',', pos);
+            if (end == std::string_view::npos) {
+                end = list.size();
+            }
+            std::string_view item = list.substr(pos, end - pos);
+            while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) {
+                item.remove_prefix(1);
+            }
+            while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) {
+                item.remove_suffix(1);
+            }
+            if (item.size() == token.size()) {
+                bool equal = true;
+                for (size_t i = 0; i < item.size(); ++i) {
+                    const char c = item[i];
+                    const char lower = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+                    if (lower != token[i]) {
+                        equal = false;
+                        break;
+                    }
+                }
+                if (equal) {
+                    return true;
+                }
+            }
+            pos = end + 1;
+        }
+        return false;
+    }
+
     static void logResponseStatus(HttpStatusCode code) {
         const int status = static_cast<int>(code);
         if (status >= 500) {
@@ -686,6 +1054,11 @@ private:
     size_t m_external_buffer_size = 0;
     IoVecCursor m_writev_cursor;
     FastPathCounters m_fast_path_counters;
+    std::optional<HttpContentCoding> m_response_coding;             ///< 响应编码，未设置时不改写响应
+    std::shared_ptr<HttpStreamCompressor> m_stream_compressor;      ///< chunked 响应的流式压缩器
+    HttpPipelineBatch* m_pipeline_batch = nullptr;                  ///< 连接级流水线合并缓冲
+    std::vector<std::string> m_pipeline_segments;                   ///< 正在写出的暂存段
+    std::vector<iovec> m_pipeline_tail;                             ///< 合并写出时暂存原 writev 窗口
 };
 
 using HttpWriter = HttpWriterImpl<AsyncTcpSocket>;
@@ -1,6 +1,7 @@
 #ifndef GALAY_HTTP_WRITER_SETTING_H
 #define GALAY_HTTP_WRITER_SETTING_H
 
+#include "../common/http_compression.h"
 #include "../protoc/http_base.h"
 #include <cstddef>
 
@@ -81,7 +82,24 @@ public:
         return m_writev_coalesce_threshold;
     }
 
+    /**
+     * @brief 设置响应压缩配置
+     * @param setting 压缩配置；只有 writer 被设置了响应编码时才会生效
+     */
+    void setCompression(const HttpCompressionSetting& setting) {
+        m_compression = setting;
+    }
+
+    /**
+     * @brief 获取响应压缩配置
+     * @return 压缩配置
+     */
+    const HttpCompressionSetting& getCompression() const {
+        return m_compression;
+    }
+
 private:
+    HttpCompressionSetting m_compression;
     size_t m_max_response_size = DEFAULT_HTTP_MAX_BODY_SIZE;
     size_t m_writev_coalesce_threshold = 0;
     int m_send_timeout_ms = DEFAULT_HTTP_SEND_TIME_MS;
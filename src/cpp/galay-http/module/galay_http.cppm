@@ -10,13 +10,20 @@ export {
 #include "../protoc/http_chunk.h"
 #include "../protoc/http_error.h"
 #include "../protoc/http_header.h"
+#include "../protoc/http_header_view.h"
 #include "../protoc/http_request.h"
 #include "../protoc/http_response.h"
 
+#include "../common/http_compression.h"
+
 #include "../client/http_client.h"
+#include "../kernel/http_pipeline.h"
 #include "../kernel/http_conn.h"
 #include "../kernel/http_reader.h"
 #include "../server/http_router.h"
+#include "../server/static_file_cache.h"
+#include "../server/compressed_variant_cache.h"
+#include "../server/proxy_upstream.h"
 #include "../plugin/common/defn.h"
 #include "../plugin/common/conn_info_storage.hpp"
 #include "../plugin/blacklist/blacklist.hpp"
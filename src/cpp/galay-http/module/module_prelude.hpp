@@ -134,9 +134,15 @@
 #if __has_include("../common/http_log.h")
 #include "../common/http_log.h"
 #endif
+#if __has_include("../common/http_compression.h")
+#include "../common/http_compression.h"
+#endif
 #if __has_include("../common/iovec_utils.h")
 #include "../common/iovec_utils.h"
 #endif
+#if __has_include("../kernel/http_pipeline.h")
+#include "../kernel/http_pipeline.h"
+#endif
 #if __has_include("../kernel/http_conn.h")
 #include "../kernel/http_conn.h"
 #endif
@@ -146,6 +152,15 @@
 #if __has_include("../server/http_router.h")
 #include "../server/http_router.h"
 #endif
+#if __has_include("../server/static_file_cache.h")
+#include "../server/static_file_cache.h"
+#endif
+#if __has_include("../server/compressed_variant_cache.h")
+#include "../server/compressed_variant_cache.h"
+#endif
+#if __has_include("../server/proxy_upstream.h")
+#include "../server/proxy_upstream.h"
+#endif
 #if __has_include("../plugin/common/defn.h")
 #include "../plugin/common/defn.h"
 #endif
@@ -182,6 +197,9 @@
 #if __has_include("../protoc/http_header.h")
 #include "../protoc/http_header.h"
 #endif
+#if __has_include("../protoc/http_header_view.h")
+#include "../protoc/http_header_view.h"
+#endif
 #if __has_include("../protoc/http_request.h")
 #include "../protoc/http_request.h"
 #endif
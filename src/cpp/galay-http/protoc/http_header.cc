@@ -1,5 +1,6 @@
 #include "http_header.h"
 #include "parse_utils.h"
+#include "http_scan.h"
 #include <algorithm>
 #include <array>
 #include <cctype>
@@ -37,7 +38,7 @@ namespace galay::http
     }
 
     // 快速匹配常见 header（假设 key 已是小写）
-    CommonHeaderIndex matchCommonHeader(const std::string& key) {
+    CommonHeaderIndex matchCommonHeader(std::string_view key) {
         const size_t len = key.size();
         if (len < 4 || len > 19) return CommonHeaderIndex::NotCommon;
 
@@ -347,8 +348,26 @@ namespace galay::http
         return HttpVersion::HttpVersion_Unknown;
     }
 
+    constexpr size_t kMaxBatchedHeaderLines = 64; ///< 整块解析一次最多暂存的头部行数，超出时回退状态机
+
     } // namespace
 
+    namespace detail {
+
+    CommonHeaderIndex matchCommonHeaderIgnoreCase(std::string_view key)
+    {
+        std::array<char, 19> lowered;
+        if (key.size() < 4 || key.size() > lowered.size()) {
+            return CommonHeaderIndex::NotCommon;
+        }
+        for (size_t i = 0; i < key.size(); ++i) {
+            lowered[i] = toLowerAsciiChar(key[i]);
+        }
+        return matchCommonHeader(std::string_view(lowered.data(), key.size()));
+    }
+
+    } // namespace detail
+
     HeaderPair::HeaderPair(Mode mode)
         : m_commonHeaderPresent(0)  // 初始化为全 0
         , m_mode(mode)
@@ -704,6 +723,7 @@ namespace galay::http
         copy.m_method = m_method;
         copy.m_version = m_version;
         copy.m_parseState = m_parseState;
+        copy.m_parseMode = m_parseMode;
         copy.m_currentCommonHeaderIdx = m_currentCommonHeaderIdx;
         copy.m_uriDecodeError = m_uriDecodeError;
         copy.m_hasContentLength = m_hasContentLength;
@@ -768,6 +788,83 @@ namespace galay::http
         return kNoError;
     }
 
+    std::optional<std::pair<HttpErrorCode, ssize_t>>
+    HttpRequestHeader::parseContiguousHead(const char* data, size_t len)
+    {
+        struct HeaderLine {
+            std::string_view key;
+            std::string_view value;
+        };
+        struct Collector {
+            std::string_view method;
+            std::string_view target;
+            std::string_view version;
+            std::array<HeaderLine, kMaxBatchedHeaderLines> lines;
+            size_t count = 0;
+
+            bool onRequestLine(std::string_view m, std::string_view t, std::string_view v) {
+                method = m;
+                target = t;
+                version = v;
+                return true;
+            }
+            bool onHeader(std::string_view key, std::string_view value) {
+                if (count == lines.size()) {
+                    return false;
+                }
+                lines[count++] = {key, value};
+                return true;
+            }
+        } collector;
+
+        // 先只扫描定位，确认整块完整后才修改状态；否则交还状态机从头处理
+        const auto scan = detail::scanRequestHead(data, len, collector);
+        if (scan.status != detail::RequestHeadScanStatus::Complete) {
+            return std::nullopt;
+        }
+
+        // 以下校验顺序与状态机一致，保证两条路径的错误码相同
+        m_method = parseHttpMethodFast(collector.method);
+        if (m_maxUriSize != 0 && collector.target.size() > m_maxUriSize) {
+            return std::pair{kUriTooLong, ssize_t{-1}};
+        }
+        std::string full_uri = convertFromUri(collector.target, false);
+        if (m_uriDecodeError) {
+            return std::pair{kUriEncodeError, ssize_t{-1}};
+        }
+        parseArgs(full_uri);
+        if (m_uri.empty()) {
+            m_uri = std::move(full_uri);
+        }
+        m_version = parseHttpVersionFast(collector.version);
+        if (m_version != HttpVersion::HttpVersion_1_0 &&
+            m_version != HttpVersion::HttpVersion_1_1) {
+            return std::pair{kVersionNotSupport, ssize_t{-1}};
+        }
+
+        const bool server_side = m_headerPairs.mode() == HeaderPair::Mode::ServerSide;
+        for (size_t i = 0; i < collector.count; ++i) {
+            const HeaderLine& line = collector.lines[i];
+            if (server_side) {
+                m_parseHeaderKey.resize(line.key.size());
+                for (size_t j = 0; j < line.key.size(); ++j) {
+                    m_parseHeaderKey[j] = toLowerAsciiChar(line.key[j]);
+                }
+                m_currentCommonHeaderIdx = matchCommonHeader(m_parseHeaderKey);
+            } else {
+                m_parseHeaderKey.assign(line.key);
+            }
+            m_parseHeaderValue.assign(line.value);
+            if (auto err = commitParsedHeaderPair(); err != kNoError) {
+                return std::pair{err, ssize_t{-1}};
+            }
+        }
+
+        m_parseState = RequestParseState::Done;
+        m_parsedBytes += scan.consumed;
+        return std::pair{kNoError, static_cast<ssize_t>(scan.consumed)};
+    }
+
     HttpErrorCode HttpRequestHeader::parseChar(char c)
     {
         switch (m_parseState) {
@@ -966,6 +1063,12 @@ namespace galay::http
         if (m_parseState == RequestParseState::Done) {
             return {kNoError, 0};
         }
+        if (m_parseMode == RequestHeaderParseMode::Vectorized &&
+            m_parseState == RequestParseState::Method && m_parseMethodStr.empty()) {
+            if (auto result = parseContiguousHead(str.data(), str.size())) {
+                return *result;
+            }
+        }
         ssize_t consumed = 0;
         for (char c : str) {
             HttpErrorCode err = parseChar(c);
@@ -984,6 +1087,14 @@ namespace galay::http
         if (m_parseState == RequestParseState::Done) {
             return {kNoError, 0};
         }
+        // 整块请求头落在首个 iovec（mmap RingBuffer 总是如此）时走向量化路径
+        if (m_parseMode == RequestHeaderParseMode::Vectorized && !iovecs.empty() &&
+            m_parseState == RequestParseState::Method && m_parseMethodStr.empty()) {
+            if (auto result = parseContiguousHead(static_cast<const char*>(iovecs[0].iov_base),
+                                                  iovecs[0].iov_len)) {
+                return *result;
+            }
+        }
 
         auto appendHeaderKeyChunk = [&](const char* begin, size_t len) {
             if (len == 0) {
@@ -22,6 +22,7 @@
 #include <array>
 #include <bitset>
 #include <functional>
+#include <optional>
 
 
 namespace galay::http {
@@ -72,6 +73,17 @@ namespace galay::http {
         Done            ///< 解析完成
     };
 
+    /**
+     * @brief HTTP 请求头解析模式
+     * @details Vectorized 模式下，若首个 iovec 已包含完整请求头，则先用 SIMD 扫描整块定位分隔符，
+     *          再一次性提交字段；数据不完整或不在严格语法子集内时自动回退到逐字节状态机，
+     *          两种模式对同一输入的解析结果与错误码一致。
+     */
+    enum class RequestHeaderParseMode : uint8_t {
+        Incremental,    ///< 始终逐字节状态机
+        Vectorized      ///< 整块 SIMD 扫描优先，必要时回退状态机（默认）
+    };
+
     /**
      * @brief HTTP 响应头增量解析状态
      * @details 状态机枚举，用于逐字符解析状态行与头部字段
@@ -350,6 +362,18 @@ namespace galay::http {
                             size_t max_header_line_size,
                             size_t max_uri_size);
 
+        /**
+         * @brief 设置解析模式
+         * @param mode 解析模式，reset() 不会改变它
+         */
+        void setParseMode(RequestHeaderParseMode mode) { m_parseMode = mode; }
+
+        /**
+         * @brief 获取解析模式
+         * @return 当前解析模式
+         */
+        RequestHeaderParseMode parseMode() const { return m_parseMode; }
+
         /**
          * @brief 从另一个请求头拷贝内容
          * @param header 源请求头
@@ -369,6 +393,11 @@ namespace galay::http {
          */
         HttpErrorCode parseChar(char c);
         HttpErrorCode commitParsedHeaderPair(); ///< 提交当前解析中的头部键值对并校验限制
+        /**
+         * @brief 整块向量化解析连续内存中的请求头
+         * @return 完整解析（成功或确定的错误）时返回结果；数据不完整或需状态机判定时返回 nullopt 且不修改任何状态
+         */
+        std::optional<std::pair<HttpErrorCode, ssize_t>> parseContiguousHead(const char* data, size_t len);
         void parseArgs(std::string uri); ///< 解析 URI 中的查询参数
         std::string convertFromUri(std::string_view url, bool convert_plus_to_space); ///< URL 解码
         std::string convertToUri(std::string&& url) const; ///< URL 编码
@@ -393,6 +422,7 @@ namespace galay::http {
         HttpMethod m_method = HttpMethod::GET;               ///< 请求方法
         HttpVersion m_version = HttpVersion::HttpVersion_1_1; ///< HTTP 版本
         RequestParseState m_parseState = RequestParseState::Method; ///< 解析状态
+        RequestHeaderParseMode m_parseMode = RequestHeaderParseMode::Vectorized; ///< 解析模式
         CommonHeaderIndex m_currentCommonHeaderIdx = CommonHeaderIndex::NotCommon; ///< 当前解析的常见头部索引
         bool m_uriDecodeError = false;                        ///< URI 百分号解码是否失败
         bool m_hasContentLength = false;                      ///< 是否已经见过 Content-Length
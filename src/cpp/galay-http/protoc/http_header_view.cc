@@ -0,0 +1,240 @@
+#include "http_header_view.h"
+#include "http_scan.h"
+#include "parse_utils.h"
+#include <cstring>
+
+namespace galay::http
+{
+    namespace {
+
+    inline std::string_view rebaseView(std::string_view view, const char* old_base, const char* new_base)
+    {
+        if (view.data() == nullptr) {
+            return view;
+        }
+        return std::string_view(new_base + (view.data() - old_base), view.size());
+    }
+
+    } // namespace
+
+    void HttpRequestHeaderView::setParseLimits(size_t max_header_count,
+                                               size_t max_header_line_size,
+                                               size_t max_uri_size)
+    {
+        m_maxHeaderCount = max_header_count;
+        m_maxHeaderLineSize = max_header_line_size;
+        m_maxUriSize = max_uri_size;
+    }
+
+    void HttpRequestHeaderView::reset()
+    {
+        m_methodText = {};
+        m_target = {};
+        m_path = {};
+        m_query = {};
+        m_fields.clear();
+        m_commonFirst.fill(kNoField);
+        m_headerBytes = 0;
+        m_method = HttpMethod::UNKNOWN;
+        m_version = HttpVersion::HttpVersion_Unknown;
+        m_ownsStorage = false;
+        m_complete = false;
+    }
+
+    std::pair<HttpErrorCode, ssize_t> HttpRequestHeaderView::parse(std::string_view data)
+    {
+        return parseContiguous(data.data(), data.size());
+    }
+
+    std::pair<HttpErrorCode, ssize_t> HttpRequestHeaderView::fromIOVec(const std::vector<iovec>& iovecs)
+    {
+        if (iovecs.empty()) {
+            reset();
+            return {kIncomplete, 0};
+        }
+
+        auto result = parseContiguous(static_cast<const char*>(iovecs[0].iov_base), iovecs[0].iov_len);
+        if (result.first != kIncomplete || iovecs.size() == 1) {
+            return result;
+        }
+
+        // 请求头跨越回绕点：把各段拼接到自有存储后再解析
+        size_t total = 0;
+        for (const auto& iov : iovecs) {
+            total += iov.iov_len;
+        }
+        if (total == iovecs[0].iov_len) {
+            return result;
+        }
+        m_storage.resize(total);
+        size_t offset = 0;
+        for (const auto& iov : iovecs) {
+            if (iov.iov_len != 0) {
+                std::memcpy(m_storage.data() + offset, iov.iov_base, iov.iov_len);
+                offset += iov.iov_len;
+            }
+        }
+        result = parseContiguous(m_storage.data(), m_storage.size());
+        m_ownsStorage = result.first == kNoError;
+        return result;
+    }
+
+    std::pair<HttpErrorCode, ssize_t> HttpRequestHeaderView::parseContiguous(const char* data, size_t len)
+    {
+        reset();
+        if (m_fields.capacity() == 0) {
+            m_fields.reserve(32);
+        }
+
+        struct Builder {
+            HttpRequestHeaderView& view;
+            HttpErrorCode error = kNoError;
+            bool has_content_length = false;
+            size_t content_length = 0;
+
+            bool onRequestLine(std::string_view method, std::string_view target, std::string_view version) {
+                if (view.m_maxUriSize != 0 && target.size() > view.m_maxUriSize) {
+                    error = kUriTooLong;
+                    return false;
+                }
+                view.m_version = stringToHttpVersion(version);
+                if (view.m_version != HttpVersion::HttpVersion_1_0 &&
+                    view.m_version != HttpVersion::HttpVersion_1_1) {
+                    error = kVersionNotSupport;
+                    return false;
+                }
+                view.m_methodText = method;
+                view.m_method = stringToHttpMethod(method);
+                view.m_target = target;
+                const size_t query_pos = target.find('?');
+                if (query_pos == std::string_view::npos) {
+                    view.m_path = target;
+                } else {
+                    view.m_path = target.substr(0, query_pos);
+                    view.m_query = target.substr(query_pos + 1);
+                }
+                return true;
+            }
+
+            bool onHeader(std::string_view key, std::string_view value) {
+                if (view.m_maxHeaderLineSize != 0 && key.size() + 2 + value.size() > view.m_maxHeaderLineSize) {
+                    error = kHeaderTooLarge;
+                    return false;
+                }
+                if ((view.m_maxHeaderCount != 0 && view.m_fields.size() >= view.m_maxHeaderCount) ||
+                    view.m_fields.size() >= kNoField) {
+                    error = kHeaderTooLarge;
+                    return false;
+                }
+                const CommonHeaderIndex common = detail::matchCommonHeaderIgnoreCase(key);
+                if (common == CommonHeaderIndex::ContentLength) {
+                    auto parsed = detail::parseSizeTStrict(value);
+                    if (!parsed.has_value() || (has_content_length && content_length != parsed.value())) {
+                        error = kBadRequest;
+                        return false;
+                    }
+                    has_content_length = true;
+                    content_length = parsed.value();
+                }
+                if (common != CommonHeaderIndex::NotCommon) {
+                    auto& first = view.m_commonFirst[static_cast<size_t>(common)];
+                    if (first == kNoField) {
+                        first = static_cast<uint16_t>(view.m_fields.size());
+                    }
+                }
+                view.m_fields.push_back({key, value, common});
+                return true;
+            }
+        } builder{*this};
+
+        const auto scan = detail::scanRequestHead(data, len, builder);
+        switch (scan.status) {
+        case detail::RequestHeadScanStatus::Complete:
+            m_headerBytes = scan.consumed;
+            m_complete = true;
+            return {kNoError, static_cast<ssize_t>(scan.consumed)};
+        case detail::RequestHeadScanStatus::Incomplete:
+            reset();
+            return {kIncomplete, 0};
+        case detail::RequestHeadScanStatus::Rejected:
+            reset();
+            return {builder.error, -1};
+        case detail::RequestHeadScanStatus::Malformed:
+            break;
+        }
+        reset();
+        return {kBadRequest, -1};
+    }
+
+    void HttpRequestHeaderView::rebase(const char* old_base, const char* new_base)
+    {
+        m_methodText = rebaseView(m_methodText, old_base, new_base);
+        m_target = rebaseView(m_target, old_base, new_base);
+        m_path = rebaseView(m_path, old_base, new_base);
+        m_query = rebaseView(m_query, old_base, new_base);
+        for (auto& field : m_fields) {
+            field.name = rebaseView(field.name, old_base, new_base);
+            field.value = rebaseView(field.value, old_base, new_base);
+        }
+    }
+
+    void HttpRequestHeaderView::detach()
+    {
+        if (m_ownsStorage || !m_complete) {
+            return;
+        }
+        // 严格语法保证方法位于请求头首字节
+        const char* old_base = m_methodText.data();
+        std::vector<char> storage(old_base, old_base + m_headerBytes);
+        m_storage = std::move(storage);
+        rebase(old_base, m_storage.data());
+        m_ownsStorage = true;
+    }
+
+    std::string_view HttpRequestHeaderView::find(CommonHeaderIndex idx) const
+    {
+        if (idx == CommonHeaderIndex::NotCommon) {
+            return {};
+        }
+        const uint16_t pos = m_commonFirst[static_cast<size_t>(idx)];
+        if (pos >= m_fields.size()) {
+            return {};
+        }
+        return m_fields[pos].value;
+    }
+
+    bool HttpRequestHeaderView::has(CommonHeaderIndex idx) const
+    {
+        return idx != CommonHeaderIndex::NotCommon &&
+               m_commonFirst[static_cast<size_t>(idx)] < m_fields.size();
+    }
+
+    std::string_view HttpRequestHeaderView::find(std::string_view name) const
+    {
+        const CommonHeaderIndex common = detail::matchCommonHeaderIgnoreCase(name);
+        if (common != CommonHeaderIndex::NotCommon) {
+            return find(common);
+        }
+        for (const auto& field : m_fields) {
+            if (detail::equalsIgnoreCaseAscii(field.name, name)) {
+                return field.value;
+            }
+        }
+        return {};
+    }
+
+    bool HttpRequestHeaderView::has(std::string_view name) const
+    {
+        const CommonHeaderIndex common = detail::matchCommonHeaderIgnoreCase(name);
+        if (common != CommonHeaderIndex::NotCommon) {
+            return has(common);
+        }
+        for (const auto& field : m_fields) {
+            if (detail::equalsIgnoreCaseAscii(field.name, name)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
@@ -0,0 +1,144 @@
+/**
+ * @file http_header_view.h
+ * @brief 零拷贝 HTTP 请求头视图
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details HttpRequestHeaderView 用向量化扫描一次性解析完整请求头，
+ *          方法、目标、版本与各字段都以 string_view 形式直接指向输入缓冲区
+ *          （通常是 mmap RingBuffer 的双映射连续区）。只有请求头跨越多个
+ *          iovec（回绕点）或调用 detach() 时才拷贝到视图自有存储。
+ */
+
+#ifndef GALAY_HTTP_HEADER_VIEW_H
+#define GALAY_HTTP_HEADER_VIEW_H
+
+#include "http_header.h"
+#include <span>
+
+namespace galay::http {
+
+    /**
+     * @brief 请求头字段视图
+     */
+    struct HttpHeaderFieldView {
+        std::string_view name;   ///< 原始大小写的键名
+        std::string_view value;  ///< 去掉前导空格的值
+        CommonHeaderIndex common = CommonHeaderIndex::NotCommon; ///< 常见头部索引（忽略大小写匹配）
+    };
+
+    /**
+     * @brief 零拷贝请求头视图
+     * @details 非增量解析：数据不完整时返回 kIncomplete 且不消耗字节，
+     *          调用方在收到更多数据后以同一起点重新调用。
+     *          视图生命周期受输入缓冲区约束；缓冲区被 consume 或覆写前，
+     *          需要继续持有请求头的调用方必须先 detach()。
+     *          重复调用 parse() 复用内部字段数组，稳态下不分配内存。
+     */
+    class HttpRequestHeaderView
+    {
+    public:
+        HttpRequestHeaderView() = default;
+        HttpRequestHeaderView(HttpRequestHeaderView&&) noexcept = default; ///< 移动构造（自有存储随之转移，视图保持有效）
+        HttpRequestHeaderView& operator=(HttpRequestHeaderView&&) noexcept = default; ///< 移动赋值
+        HttpRequestHeaderView(const HttpRequestHeaderView&) = delete;
+        HttpRequestHeaderView& operator=(const HttpRequestHeaderView&) = delete;
+
+        /**
+         * @brief 从连续内存解析请求头
+         * @param data 输入字节，完整请求头之后的字节（请求体）不会被访问
+         * @return pair.first 为错误码，pair.second 为请求头字节数（>0 完成，0 不完整，-1 错误）
+         */
+        std::pair<HttpErrorCode, ssize_t> parse(std::string_view data);
+
+        /**
+         * @brief 从 iovec 数组解析请求头
+         * @details 请求头完整落在首个 iovec 内时零拷贝；否则把各段拼接到自有存储后解析。
+         * @param iovecs 离散缓冲区数组（RingBuffer::getReadIovecs 的结果）
+         * @return 同 parse
+         */
+        std::pair<HttpErrorCode, ssize_t> fromIOVec(const std::vector<iovec>& iovecs);
+
+        /**
+         * @brief 设置解析限制，语义与 HttpRequestHeader::setParseLimits 相同
+         * @param max_header_count 最大头字段数，0 表示不限制
+         * @param max_header_line_size 单个头字段行长度上限，0 表示不限制
+         * @param max_uri_size URI 长度上限，0 表示不限制
+         */
+        void setParseLimits(size_t max_header_count,
+                            size_t max_header_line_size,
+                            size_t max_uri_size);
+
+        /**
+         * @brief 把所有视图迁移到自有存储
+         * @details 用于请求生命周期超过输入缓冲区的场景；已经自有时不做任何事。
+         */
+        void detach();
+
+        /**
+         * @brief 视图是否指向自有存储
+         * @return 跨 iovec 拼接或 detach() 之后返回 true
+         */
+        bool ownsStorage() const { return m_ownsStorage; }
+
+        bool isHeaderComplete() const { return m_complete; } ///< 是否已解析出完整请求头
+        size_t headerBytes() const { return m_headerBytes; } ///< 请求头总字节数（含结尾空行）
+
+        HttpMethod method() const { return m_method; }                   ///< 请求方法
+        std::string_view methodText() const { return m_methodText; }     ///< 原始方法文本
+        std::string_view target() const { return m_target; }             ///< 原始请求目标（未解码）
+        std::string_view path() const { return m_path; }                 ///< 目标中 '?' 之前的部分
+        std::string_view query() const { return m_query; }               ///< 目标中 '?' 之后的部分，不含 '?'
+        HttpVersion version() const { return m_version; }                ///< HTTP 版本
+
+        /**
+         * @brief 获取全部头部字段（按出现顺序，重复字段各自保留）
+         * @return 字段视图区间
+         */
+        std::span<const HttpHeaderFieldView> fields() const { return m_fields; }
+
+        /**
+         * @brief 按键名查找首个匹配字段（忽略大小写）
+         * @param name 头部键名
+         * @return 值视图；不存在时返回空视图且 has() 为 false
+         */
+        std::string_view find(std::string_view name) const;
+
+        /**
+         * @brief 获取常见头部首个字段值
+         * @param idx 常见头部索引
+         * @return 值视图；不存在时返回空视图
+         */
+        std::string_view find(CommonHeaderIndex idx) const;
+
+        bool has(std::string_view name) const;    ///< 是否存在指定键名（忽略大小写）
+        bool has(CommonHeaderIndex idx) const;    ///< 是否存在指定常见头部
+
+        void reset(); ///< 清空解析结果，保留解析限制与已分配容量
+
+    private:
+        static constexpr uint16_t kNoField = 0xffff;
+
+        std::pair<HttpErrorCode, ssize_t> parseContiguous(const char* data, size_t len);
+        void rebase(const char* old_base, const char* new_base);
+
+        std::string_view m_methodText;                       ///< 方法文本
+        std::string_view m_target;                           ///< 请求目标
+        std::string_view m_path;                             ///< 路径部分
+        std::string_view m_query;                            ///< 查询串部分
+        std::vector<HttpHeaderFieldView> m_fields;           ///< 头部字段
+        std::vector<char> m_storage;                         ///< 自有存储（移动时缓冲区地址不变）
+        std::array<uint16_t, 15> m_commonFirst{};            ///< 常见头部首次出现的字段下标
+        size_t m_headerBytes = 0;                            ///< 请求头字节数
+        size_t m_maxHeaderCount = 0;                         ///< 最大头字段数，0 表示不限制
+        size_t m_maxHeaderLineSize = 0;                      ///< 单行头字段长度上限，0 表示不限制
+        size_t m_maxUriSize = 0;                             ///< URI 长度上限，0 表示不限制
+        HttpMethod m_method = HttpMethod::UNKNOWN;           ///< 请求方法
+        HttpVersion m_version = HttpVersion::HttpVersion_Unknown; ///< HTTP 版本
+        bool m_ownsStorage = false;                          ///< 视图是否指向 m_storage
+        bool m_complete = false;                             ///< 是否解析完成
+    };
+
+}
+
+#endif // GALAY_HTTP_HEADER_VIEW_H
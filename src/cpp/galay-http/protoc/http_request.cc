@@ -289,6 +289,12 @@ namespace galay::http
         m_routeParamMapCache.reset();
     }
 
+    RouteParams& HttpRequest::mutableRouteParams()
+    {
+        m_routeParamMapCache.reset();
+        return m_routeParams;
+    }
+
     const std::map<std::string, std::string>& HttpRequest::routeParams() const
     {
         if (!m_routeParamMapCache.has_value()) {
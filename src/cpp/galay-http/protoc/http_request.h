@@ -140,6 +140,12 @@ public:
      */
     void setRouteParams(RouteParams&& params);
 
+    /**
+     * @brief 获取可就地写入的路由参数容器
+     * @return 请求持有的参数容器，供 HttpRouter::findHandler 直接填充，免去一次移动
+     */
+    RouteParams& mutableRouteParams();
+
     /**
      * @brief 获取所有路由参数
      * @return 路由参数映射
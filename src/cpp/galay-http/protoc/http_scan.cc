@@ -0,0 +1,186 @@
+#include "http_scan.h"
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+// SIMD 支持检测：x86 上按函数粒度开启指令集，运行时再按 CPU 能力分派
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define GALAY_HTTP_SCAN_X86
+#endif
+
+namespace galay::http::detail
+{
+namespace {
+
+constexpr uint64_t kSwarOnes = 0x0101010101010101ULL;
+constexpr uint64_t kSwarHighs = 0x8080808080808080ULL;
+constexpr uint8_t kKernelUnresolved = 0xff;
+
+std::atomic<uint8_t> g_kernel{kKernelUnresolved};
+
+const char* findFirstOfScalar(const char* p, const char* end, char a, char b, char c) noexcept
+{
+    for (; p < end; ++p) {
+        if (*p == a || *p == b || *p == c) {
+            return p;
+        }
+    }
+    return end;
+}
+
+// 每个等于 0 的字节在结果中对应位置的最高位置 1（低位字节上的误报只会出现在真实命中之后）
+inline uint64_t swarZeroBytes(uint64_t word) noexcept
+{
+    return (word - kSwarOnes) & ~word & kSwarHighs;
+}
+
+const char* findFirstOfSwar(const char* p, const char* end, char a, char b, char c) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little) {
+        const uint64_t va = kSwarOnes * static_cast<uint8_t>(a);
+        const uint64_t vb = kSwarOnes * static_cast<uint8_t>(b);
+        const uint64_t vc = kSwarOnes * static_cast<uint8_t>(c);
+        while (end - p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            const uint64_t hits = swarZeroBytes(word ^ va) | swarZeroBytes(word ^ vb) | swarZeroBytes(word ^ vc);
+            if (hits != 0) {
+                return p + (std::countr_zero(hits) >> 3);
+            }
+            p += 8;
+        }
+    }
+    return findFirstOfScalar(p, end, a, b, c);
+}
+
+#if defined(GALAY_HTTP_SCAN_X86)
+__attribute__((target("sse4.2")))
+const char* findFirstOfSse42(const char* p, const char* end, char a, char b, char c) noexcept
+{
+    const __m128i needles = _mm_setr_epi8(a, b, c, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int index = _mm_cmpestri(needles, 3, block, 16,
+                                       _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+        if (index < 16) {
+            return p + index;
+        }
+        p += 16;
+    }
+    return findFirstOfSwar(p, end, a, b, c);
+}
+
+__attribute__((target("avx2")))
+const char* findFirstOfAvx2(const char* p, const char* end, char a, char b, char c) noexcept
+{
+    // 头部字段多在 16 字节内命中：先做一次 128 位比较，长值（Cookie、User-Agent）再进入 256 位循环
+    if (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(a)), _mm_cmpeq_epi8(block, _mm_set1_epi8(b))),
+            _mm_cmpeq_epi8(block, _mm_set1_epi8(c)));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + std::countr_zero(mask);
+        }
+        p += 16;
+    }
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    const __m256i vc = _mm256_set1_epi8(c);
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, va), _mm256_cmpeq_epi8(block, vb)),
+            _mm256_cmpeq_epi8(block, vc));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return p + std::countr_zero(mask);
+        }
+        p += 32;
+    }
+    return findFirstOfSwar(p, end, a, b, c);
+}
+#endif
+
+bool cpuSupports(HeaderScanKernel kernel) noexcept
+{
+    switch (kernel) {
+    case HeaderScanKernel::Swar:
+        return true;
+#if defined(GALAY_HTTP_SCAN_X86)
+    case HeaderScanKernel::Sse42:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.2");
+    case HeaderScanKernel::Avx2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+// 头部字段平均只有十几到几十字节，单次调用的 256 位寄存器准备开销盖过了更宽的比较，
+// b15 实测普通请求头上 SSE4.2 更快，因此默认优先 SSE4.2；长 Cookie / User-Agent 为主的流量可显式切到 AVX2
+HeaderScanKernel detectKernel() noexcept
+{
+    if (cpuSupports(HeaderScanKernel::Sse42)) {
+        return HeaderScanKernel::Sse42;
+    }
+    return HeaderScanKernel::Swar;
+}
+
+} // namespace
+
+HeaderScanKernel activeHeaderScanKernel() noexcept
+{
+    uint8_t kernel = g_kernel.load(std::memory_order_relaxed);
+    if (kernel == kKernelUnresolved) {
+        // 并发首次调用探测结果相同，重复写入无害
+        kernel = static_cast<uint8_t>(detectKernel());
+        g_kernel.store(kernel, std::memory_order_relaxed);
+    }
+    return static_cast<HeaderScanKernel>(kernel);
+}
+
+bool isHeaderScanKernelSupported(HeaderScanKernel kernel) noexcept
+{
+    return cpuSupports(kernel);
+}
+
+bool setHeaderScanKernel(HeaderScanKernel kernel) noexcept
+{
+    if (!isHeaderScanKernelSupported(kernel)) {
+        return false;
+    }
+    g_kernel.store(static_cast<uint8_t>(kernel), std::memory_order_relaxed);
+    return true;
+}
+
+std::string_view headerScanKernelName(HeaderScanKernel kernel) noexcept
+{
+    switch (kernel) {
+    case HeaderScanKernel::Swar:  return "swar";
+    case HeaderScanKernel::Sse42: return "sse4.2";
+    case HeaderScanKernel::Avx2:  return "avx2";
+    }
+    return "unknown";
+}
+
+const char* findFirstOf(const char* begin, const char* end, char a, char b, char c) noexcept
+{
+    switch (activeHeaderScanKernel()) {
+#if defined(GALAY_HTTP_SCAN_X86)
+    case HeaderScanKernel::Avx2:
+        return findFirstOfAvx2(begin, end, a, b, c);
+    case HeaderScanKernel::Sse42:
+        return findFirstOfSse42(begin, end, a, b, c);
+#endif
+    default:
+        return findFirstOfSwar(begin, end, a, b, c);
+    }
+}
+
+} // namespace galay::http::detail
@@ -0,0 +1,191 @@
+/**
+ * @file http_scan.h
+ * @brief HTTP 头部分隔符向量化扫描
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 提供按 CPU 能力运行时分派的分隔符查找（AVX2 / SSE4.2 / SWAR），
+ *          以及基于它的整块请求头扫描器。扫描器只产出指向输入的 string_view，
+ *          不做任何拷贝或分配，由调用方决定是直接引用还是提交到自有存储。
+ *          仅供内部模块使用。
+ */
+
+#ifndef GALAY_HTTP_SCAN_H
+#define GALAY_HTTP_SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace galay::http::detail
+{
+
+/**
+ * @brief 分隔符扫描内核
+ */
+enum class HeaderScanKernel : uint8_t {
+    Swar,   ///< 8 字节一组的 SWAR 位运算，所有平台可用
+    Sse42,  ///< SSE4.2 PCMPESTRI，一次比较 16 字节
+    Avx2,   ///< AVX2 按字节比较 + movemask，一次比较 32 字节
+};
+
+/**
+ * @brief 当前生效的扫描内核
+ * @return 首次调用时按 CPU 能力选择内核（SSE4.2 优先，否则 SWAR），之后返回缓存结果
+ */
+HeaderScanKernel activeHeaderScanKernel() noexcept;
+
+/**
+ * @brief 判断当前 CPU 是否支持指定内核
+ * @param kernel 扫描内核
+ * @return 支持返回 true
+ */
+bool isHeaderScanKernelSupported(HeaderScanKernel kernel) noexcept;
+
+/**
+ * @brief 强制切换扫描内核（测试与压测对照用）
+ * @param kernel 目标内核
+ * @return CPU 不支持时不切换并返回 false
+ */
+bool setHeaderScanKernel(HeaderScanKernel kernel) noexcept;
+
+/**
+ * @brief 获取扫描内核名称
+ * @param kernel 扫描内核
+ * @return "swar" / "sse4.2" / "avx2"
+ */
+std::string_view headerScanKernelName(HeaderScanKernel kernel) noexcept;
+
+/**
+ * @brief 查找 [begin, end) 中第一个等于 a、b、c 之一的字节
+ * @return 命中位置；未命中返回 end
+ * @note 只需两个分隔符时可令 c 与 b 相同
+ */
+const char* findFirstOf(const char* begin, const char* end, char a, char b, char c) noexcept;
+
+constexpr size_t kMaxRequestHeaderKeySize = 256; ///< 与增量状态机一致的头部键名长度上限
+
+/**
+ * @brief 整块请求头扫描结果状态
+ */
+enum class RequestHeadScanStatus : uint8_t {
+    Complete,   ///< 找到完整请求头（含结尾空行）
+    Incomplete, ///< 数据不足，需要更多字节
+    Malformed,  ///< 不符合严格语法，交由增量状态机给出精确错误
+    Rejected,   ///< visitor 主动中止
+};
+
+/**
+ * @brief 整块请求头扫描结果
+ */
+struct RequestHeadScanResult {
+    RequestHeadScanStatus status = RequestHeadScanStatus::Incomplete; ///< 扫描状态
+    size_t consumed = 0;                                              ///< Complete 时为请求头总字节数
+};
+
+/**
+ * @brief 向量化扫描一个完整的 HTTP/1.x 请求头
+ * @details 严格语法是增量状态机接受语法的子集：方法、目标、版本均非空，
+ *          键名非空、不以冒号起始且不超过 256 字节，值以 "\r\n" 结束。
+ *          不在子集内的输入一律报 Malformed，调用方应回退到状态机，
+ *          从而保证两条路径对同一输入的结果完全一致。
+ * @param data 输入起始
+ * @param len 输入长度
+ * @param visitor 需提供
+ *        `bool onRequestLine(std::string_view method, std::string_view target, std::string_view version)` 与
+ *        `bool onHeader(std::string_view key, std::string_view value)`，返回 false 时中止扫描
+ * @return 扫描结果；视图在 Complete 之前就已交给 visitor，Incomplete/Malformed 时调用方应丢弃
+ */
+template <typename Visitor>
+RequestHeadScanResult scanRequestHead(const char* data, size_t len, Visitor&& visitor)
+{
+    using Status = RequestHeadScanStatus;
+    const char* const end = data + len;
+    const char* p = data;
+
+    const char* method_end = findFirstOf(p, end, ' ', '\r', '\n');
+    if (method_end == end) {
+        return {Status::Incomplete, 0};
+    }
+    if (*method_end != ' ' || method_end == p) {
+        return {Status::Malformed, 0};
+    }
+    const std::string_view method(p, static_cast<size_t>(method_end - p));
+
+    p = method_end + 1;
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    const char* target_end = findFirstOf(p, end, ' ', '\r', '\n');
+    if (target_end == end) {
+        return {Status::Incomplete, 0};
+    }
+    if (*target_end != ' ' || target_end == p) {
+        return {Status::Malformed, 0};
+    }
+    const std::string_view target(p, static_cast<size_t>(target_end - p));
+
+    p = target_end + 1;
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    const char* version_end = findFirstOf(p, end, '\r', '\n', '\n');
+    if (version_end == end || version_end + 1 == end) {
+        return {Status::Incomplete, 0};
+    }
+    if (*version_end != '\r' || version_end == p || version_end[1] != '\n') {
+        return {Status::Malformed, 0};
+    }
+    if (!visitor.onRequestLine(method, target,
+                               std::string_view(p, static_cast<size_t>(version_end - p)))) {
+        return {Status::Rejected, 0};
+    }
+
+    p = version_end + 2;
+    for (;;) {
+        if (p == end) {
+            return {Status::Incomplete, 0};
+        }
+        if (*p == '\r') {
+            if (p + 1 == end) {
+                return {Status::Incomplete, 0};
+            }
+            if (p[1] != '\n') {
+                return {Status::Malformed, 0};
+            }
+            return {Status::Complete, static_cast<size_t>(p + 2 - data)};
+        }
+
+        const char* colon = findFirstOf(p, end, ':', '\r', '\n');
+        if (colon == end) {
+            return static_cast<size_t>(end - p) > kMaxRequestHeaderKeySize
+                ? RequestHeadScanResult{Status::Malformed, 0}
+                : RequestHeadScanResult{Status::Incomplete, 0};
+        }
+        if (*colon != ':' || colon == p ||
+            static_cast<size_t>(colon - p) > kMaxRequestHeaderKeySize) {
+            return {Status::Malformed, 0};
+        }
+        const std::string_view key(p, static_cast<size_t>(colon - p));
+
+        const char* value_begin = colon + 1;
+        while (value_begin < end && *value_begin == ' ') {
+            ++value_begin;
+        }
+        const char* cr = findFirstOf(value_begin, end, '\r', '\r', '\r');
+        if (cr == end || cr + 1 == end) {
+            return {Status::Incomplete, 0};
+        }
+        if (cr[1] != '\n') {
+            return {Status::Malformed, 0};
+        }
+        if (!visitor.onHeader(key, std::string_view(value_begin, static_cast<size_t>(cr - value_begin)))) {
+            return {Status::Rejected, 0};
+        }
+        p = cr + 2;
+    }
+}
+
+} // namespace galay::http::detail
+
+#endif // GALAY_HTTP_SCAN_H
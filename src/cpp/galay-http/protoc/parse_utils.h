@@ -108,6 +108,13 @@ inline bool headerValueContainsToken(std::string_view value, std::string_view to
     return false;
 }
 
+/**
+ * @brief 忽略大小写匹配常见 Header 键名
+ * @param key 头部键名（任意大小写）
+ * @return 常见头部索引，不是常见头部时返回 NotCommon
+ */
+CommonHeaderIndex matchCommonHeaderIgnoreCase(std::string_view key);
+
 /**
  * @brief 宽松模式获取 Header 值指针
  * @param headers HeaderPair 对象
@@ -197,10 +197,10 @@ private:
     RouteParams(const RouteParams&) = delete;
     RouteParams& operator=(const RouteParams&) = delete;
 
+    // 复用目标已有容量：clear() 后重复填充同一容器时不再分配
     static void assignString(std::string& target, std::string_view value)
     {
-        std::string next(value);
-        target.swap(next);
+        target.assign(value.data(), value.size());
     }
 
     static void upsertMap(std::map<std::string, std::string>& params, const Entry& entry)
@@ -0,0 +1,82 @@
+#include "compressed_variant_cache.h"
+
+namespace galay::http
+{
+
+CompressedVariantCache::CompressedVariantCache(size_t maxBytes)
+    : m_maxBytes(maxBytes)
+    , m_shardCapacity(maxBytes / kShardCount)
+{
+}
+
+std::string CompressedVariantCache::makeKey(HttpContentCoding coding, std::string_view etag)
+{
+    const std::string_view token = contentCodingToken(coding);
+    std::string key;
+    key.reserve(token.size() + 1 + etag.size());
+    key.append(token);
+    key.push_back(':');
+    key.append(etag);
+    return key;
+}
+
+CompressedVariantCache::BodyPtr CompressedVariantCache::find(std::string_view key)
+{
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return it->second->body;
+}
+
+bool CompressedVariantCache::insert(std::string key, BodyPtr body)
+{
+    const size_t charge = body->size() + key.size();
+    if (charge > m_shardCapacity) {
+        m_rejections.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (auto it = shard.index.find(key); it != shard.index.end()) {
+        shard.bytes -= it->second->charge;
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+    }
+    while (!shard.lru.empty() && shard.bytes + charge > m_shardCapacity) {
+        Node& victim = shard.lru.back();
+        shard.bytes -= victim.charge;
+        shard.index.erase(victim.key);
+        shard.lru.pop_back();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.lru.push_front(Node{key, std::move(body), charge});
+    shard.index.emplace(std::move(key), shard.lru.begin());
+    shard.bytes += charge;
+    m_insertions.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+CompressedVariantCacheStats CompressedVariantCache::stats() const
+{
+    CompressedVariantCacheStats stats;
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.insertions = m_insertions.load(std::memory_order_relaxed);
+    stats.rejections = m_rejections.load(std::memory_order_relaxed);
+    stats.evictions = m_evictions.load(std::memory_order_relaxed);
+    for (const Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.lru.size();
+        stats.bytes += shard.bytes;
+    }
+    return stats;
+}
+
+} // namespace galay::http
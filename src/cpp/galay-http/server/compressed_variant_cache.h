@@ -0,0 +1,135 @@
+/**
+ * @file compressed_variant_cache.h
+ * @brief 静态文件压缩变体缓存
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 为 mount / mountHardly 的即时压缩保存 gzip / zstd 结果，避免同一文件被反复压缩。
+ *          键由内容编码和文件的强 ETag 组成；强 ETag 已包含 inode、mtime 与大小，
+ *          文件变更后键随之变化，旧变体只会被 LRU 淘汰，不需要文件监听。
+ */
+
+#ifndef GALAY_HTTP_COMPRESSED_VARIANT_CACHE_H
+#define GALAY_HTTP_COMPRESSED_VARIANT_CACHE_H
+
+#include "../common/http_compression.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace galay::http
+{
+
+/**
+ * @brief 压缩变体缓存统计
+ */
+struct CompressedVariantCacheStats {
+    uint64_t hits = 0;       ///< 命中次数
+    uint64_t misses = 0;     ///< 未命中次数
+    uint64_t insertions = 0; ///< 成功插入次数
+    uint64_t rejections = 0; ///< 因超过单分片容量而拒绝插入的次数
+    uint64_t evictions = 0;  ///< LRU 淘汰条目数
+    size_t entries = 0;      ///< 当前条目数
+    size_t bytes = 0;        ///< 当前占用字节数
+};
+
+/**
+ * @brief 压缩变体缓存
+ * @details 线程安全：与 StaticFileCache 相同，按键哈希分成 kShardCount 个分片，
+ *          每个分片一把互斥锁和一条按字节限容的 LRU 链表。
+ *          变体以 shared_ptr 共享，被淘汰时正在发送它的请求仍持有引用。
+ */
+class CompressedVariantCache
+{
+public:
+    using BodyPtr = std::shared_ptr<const std::string>;
+
+    static constexpr size_t kShardCount = 16; ///< 分片数
+
+    /**
+     * @brief 构造缓存
+     * @param maxBytes 缓存总容量（字节）
+     */
+    explicit CompressedVariantCache(size_t maxBytes);
+
+    CompressedVariantCache(const CompressedVariantCache&) = delete;
+    CompressedVariantCache& operator=(const CompressedVariantCache&) = delete;
+
+    /**
+     * @brief 生成缓存键
+     * @param coding 内容编码
+     * @param etag 原始文件的强 ETag
+     * @return 形如 "gzip:\"...\"" 的键
+     */
+    static std::string makeKey(HttpContentCoding coding, std::string_view etag);
+
+    /**
+     * @brief 查找变体并标记为最近使用
+     * @param key 缓存键
+     * @return 命中返回压缩内容，未命中返回 nullptr
+     */
+    BodyPtr find(std::string_view key);
+
+    /**
+     * @brief 插入或替换变体
+     * @param key 缓存键
+     * @param body 压缩内容
+     * @return 插入成功返回 true；超过单分片容量时返回 false
+     */
+    bool insert(std::string key, BodyPtr body);
+
+    /**
+     * @brief 获取统计信息
+     * @return 统计快照
+     */
+    CompressedVariantCacheStats stats() const;
+
+    size_t maxBytes() const noexcept { return m_maxBytes; } ///< 缓存总容量
+
+private:
+    struct Node {
+        std::string key;
+        BodyPtr body;
+        size_t charge = 0;
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const noexcept {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Node> lru;  ///< 表头为最近使用
+        std::unordered_map<std::string, std::list<Node>::iterator, KeyHash, std::equal_to<>> index;
+        size_t bytes = 0;
+    };
+
+    Shard& shardFor(std::string_view key) {
+        return m_shards[KeyHash{}(key) % kShardCount];
+    }
+
+    size_t m_maxBytes;
+    size_t m_shardCapacity;
+    std::array<Shard, kShardCount> m_shards;
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_insertions{0};
+    std::atomic<uint64_t> m_rejections{0};
+    std::atomic<uint64_t> m_evictions{0};
+};
+
+} // namespace galay::http
+
+#endif // GALAY_HTTP_COMPRESSED_VARIANT_CACHE_H
@@ -1,6 +1,7 @@
 #ifndef GALAY_STATIC_FILE_CONFIG_H
 #define GALAY_STATIC_FILE_CONFIG_H
 
+#include "../common/http_compression.h"
 #include <cstddef>
 
 namespace galay::http
@@ -51,6 +52,7 @@ public:
      *          - 大文件阈值：1MB
      *          - Chunk 大小：64KB
      *          - ETag：启用
+     *          - 预压缩文件与即时压缩：关闭
      */
     StaticFileSetting()
         : m_small_file_threshold(64 * 1024)        // 64KB
@@ -58,9 +60,12 @@ public:
         , m_chunk_size(64 * 1024)                  // 64KB
         , m_sendfile_chunk_size(10 * 1024 * 1024) // 10MB
         , m_max_cache_size(100 * 1024 * 1024)     // 100MB
+        , m_compressed_cache_size(16 * 1024 * 1024) // 16MB
+        , m_max_compress_size(1024 * 1024)          // 1MB
         , m_transfer_mode(FileTransferMode::AUTO)
         , m_enable_cache(false)
         , m_enable_etag(true)
+        , m_enable_precompressed(false)
     {
     }
 
@@ -151,7 +156,7 @@ public:
     /**
      * @brief 设置是否启用文件缓存
      * @param enable 是否启用
-     * @note 仅对 mountHardly() 有效
+     * @note 对 mount() / mountHardly() / tryFiles() 有效；SENDFILE 模式的文件不进入缓存
      */
     void setEnableCache(bool enable) {
         m_enable_cache = enable;
@@ -185,6 +190,7 @@ public:
     /**
      * @brief 设置最大缓存大小
      * @param size 最大缓存大小（字节）
+     * @note 缓存分 16 个分片各自限容，单个文件须小于 size / 16 才会进入缓存；更大的文件照常按传输模式发送
      */
     void setMaxCacheSize(const size_t size) {
         m_max_cache_size = size;
@@ -198,6 +204,81 @@ public:
         return m_max_cache_size;
     }
 
+    /**
+     * @brief 设置是否查找预压缩的同名文件
+     * @param enable 是否启用
+     * @details 启用后，完整 GET / HEAD 请求会按 Accept-Encoding 选择同目录下的
+     *          "<file>.zst" 或 "<file>.gz"（修改时间不早于原文件），以 sendfile 发送并附加 Content-Encoding。
+     *          预压缩文件不依赖构建时的 zlib / libzstd。
+     */
+    void setEnablePrecompressed(const bool enable) {
+        m_enable_precompressed = enable;
+    }
+
+    /**
+     * @brief 获取是否查找预压缩的同名文件
+     * @return 是否启用
+     */
+    bool isEnablePrecompressed() const {
+        return m_enable_precompressed;
+    }
+
+    /**
+     * @brief 设置即时压缩配置
+     * @param setting 压缩配置；启用后没有预压缩文件的可压缩类型会被即时压缩并缓存
+     */
+    void setCompression(const HttpCompressionSetting& setting) {
+        m_compression = setting;
+    }
+
+    /**
+     * @brief 获取即时压缩配置
+     * @return 压缩配置
+     */
+    const HttpCompressionSetting& getCompression() const {
+        return m_compression;
+    }
+
+    /**
+     * @brief 设置压缩变体缓存容量
+     * @param size 容量（字节）；即时压缩的结果按 ETag 缓存，超出后 LRU 淘汰
+     */
+    void setCompressedCacheSize(const size_t size) {
+        m_compressed_cache_size = size;
+    }
+
+    /**
+     * @brief 获取压缩变体缓存容量
+     * @return 容量（字节）
+     */
+    size_t getCompressedCacheSize() const {
+        return m_compressed_cache_size;
+    }
+
+    /**
+     * @brief 设置即时压缩的文件大小上限
+     * @param size 上限（字节）；更大的文件按原样发送，应提供预压缩文件
+     */
+    void setMaxCompressSize(const size_t size) {
+        m_max_compress_size = size;
+    }
+
+    /**
+     * @brief 获取即时压缩的文件大小上限
+     * @return 上限（字节）
+     */
+    size_t getMaxCompressSize() const {
+        return m_max_compress_size;
+    }
+
+    /**
+     * @brief 是否启用了任何响应编码（预压缩文件或即时压缩）
+     * @return 是否启用
+     */
+    bool isContentCodingEnabled() const {
+        return m_enable_precompressed || m_compression.isEnabled();
+    }
+
     /**
      * @brief 根据文件大小决定传输模式（用于 AUTO 模式）
      * @param file_size 文件大小（字节）
@@ -224,9 +305,13 @@ private:
     size_t m_chunk_size;                 ///< Chunk 大小（字节）
     size_t m_sendfile_chunk_size;        ///< SendFile 块大小（字节）
     size_t m_max_cache_size;             ///< 最大缓存大小（字节）
+    size_t m_compressed_cache_size;      ///< 压缩变体缓存容量（字节）
+    size_t m_max_compress_size;          ///< 即时压缩的文件大小上限（字节）
+    HttpCompressionSetting m_compression; ///< 即时压缩配置
     FileTransferMode m_transfer_mode;    ///< 文件传输模式
     bool m_enable_cache;                 ///< 是否启用缓存
     bool m_enable_etag;                  ///< 是否启用 ETag 条件请求
+    bool m_enable_precompressed;         ///< 是否查找预压缩的同名文件
 };
 
 } // namespace galay::http
@@ -13,6 +13,7 @@
 #ifndef GALAY_HTTP_POLICY_H
 #define GALAY_HTTP_POLICY_H
 
+#include "../common/http_compression.h"
 #include "../protoc/http_base.h"
 
 #include <chrono>
@@ -70,10 +71,26 @@ struct HttpKeepAlivePolicy
     bool enabled = true; ///< 是否允许 route-mode 使用 keep-alive。
 };
 
+/**
+ * @brief HTTP/1.1 流水线响应合并策略。
+ * @details
+ * 连接缓冲区中已有下一个完整请求时，route-mode 把当前响应暂存到连接级合并缓冲，
+ * 同批请求的响应以一次 writev 写出；非流水线请求不受影响。
+ * 默认关闭：暂存的响应要等同批后续请求处理完才写出，后续处理器较慢时已就绪的响应
+ * 也随之延迟（队头阻塞）。处理器都很快、客户端确实流水线发送时再开启。
+ */
+struct HttpPipelinePolicy
+{
+    size_t max_depth = 16;              ///< 单次写出合并的最大响应数，1 表示不合并。
+    size_t max_batch_bytes = 64 * 1024; ///< 暂存响应的字节上限，达到后立即写出。
+    bool enabled = false;               ///< 是否合并流水线响应；默认关闭。
+};
+
 /**
  * @brief 反向代理默认策略。
  * @details
- * Task 1 仅暴露配置面；代理池、超时、健康状态和流式背压在后续任务中接入。
+ * HttpRouter::proxy 挂载时读取空闲连接池容量、idle_ttl 与 stale 连接重试语义；
+ * 超时和流式背压在后续任务中接入。
  */
 struct HttpProxyPolicy
 {
@@ -111,8 +128,10 @@ struct HttpServerPolicy
     HttpResponseLimits response_limits; ///< 响应写入限制。
     HttpTimeoutPolicy timeouts;         ///< 请求/响应超时策略。
     HttpKeepAlivePolicy keep_alive;     ///< Keep-Alive 生命周期策略。
+    HttpPipelinePolicy pipeline;        ///< 流水线响应合并策略。
     HttpProxyPolicy proxy;              ///< 反向代理默认策略。
     HttpStaticPolicy static_files;      ///< 静态文件默认策略。
+    HttpCompressionSetting compression; ///< 动态响应压缩策略，默认关闭。
 };
 
 } // namespace galay::http
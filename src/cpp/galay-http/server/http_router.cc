@@ -3,14 +3,18 @@
 #include <galay/cpp/galay-http/common/http_log.h>
 #include <galay/cpp/galay-kernel/common/file_descriptor.h>
 #include <galay/cpp/galay-kernel/async/async_waiter.h>
+#include <galay/cpp/galay-kernel/async/splice_relay.h>
 #include <galay/cpp/galay-kernel/core/runtime.h>
 #include "http_etag.h"
 #include "http_range.h"
+#include "static_file_cache.h"
+#include <galay/cpp/galay-http/common/http_compression.h>
 #include <galay/cpp/galay-http/protoc/http_response.h>
 #include <galay/cpp/galay-http/builder/http_builder.h>
 #include <algorithm>
 #include <array>
 #include <cerrno>
+#include <cstring>
 #include <expected>
 #include <set>
 #include <cctype>
@@ -36,9 +40,14 @@ using galay::kernel::FileDescriptor;
 
 namespace {
 
-constexpr size_t kProxyMaxIdleConnectionsPerUpstream = 32;
-constexpr size_t kProxyRawRelayBufferSize = 16 * 1024;
-thread_local std::unordered_map<std::string, std::vector<std::unique_ptr<HttpClient>>> g_proxyClientPools;
+struct ProxyIdleClient
+{
+    std::unique_ptr<HttpClient> client;
+    std::chrono::steady_clock::time_point idle_since;
+};
+
+// 每个调度线程即一个 IO 调度器，空闲连接池按 "host:port" 分桶，尾部为最近归还的连接
+thread_local std::unordered_map<std::string, std::vector<ProxyIdleClient>> g_proxyClientPools;
 
 enum class StaticFileReadErrorCode : uint8_t
 {
@@ -245,10 +254,6 @@ std::string normalizeRoutePrefix(std::string routePrefix) {
     return routePrefix;
 }
 
-std::string buildUpstreamKey(const std::string& host, uint16_t port) {
-    return host + ":" + std::to_string(port);
-}
-
 std::string getClientIpFromConn(HttpConn& conn) {
     sockaddr_storage addr{};
     socklen_t len = sizeof(addr);
@@ -323,6 +328,22 @@ std::string rewriteProxyUri(const std::string& routePrefix, const std::string& r
     return requestUri;
 }
 
+// RFC 9110 §9.2.2：幂等方法可在连接意外断开后自动重发
+bool isIdempotentMethod(HttpMethod method)
+{
+    switch (method) {
+        case HttpMethod::GET:
+        case HttpMethod::HEAD:
+        case HttpMethod::PUT:
+        case HttpMethod::DELETE:
+        case HttpMethod::OPTIONS:
+        case HttpMethod::TRACE:
+            return true;
+        default:
+            return false;
+    }
+}
+
 bool isLikelyStreamingRequest(const std::string& uri, const HeaderPair& headers)
 {
     const std::string accept = toLowerAscii(getHeaderValueLoose(headers, "Accept"));
@@ -375,16 +396,22 @@ Task<void> connectProxyUpstream(HttpClient& client,
     ok = false;
     err_msg.clear();
 
+    // 外层是子任务结果，内层才是连接本身的结果
     auto connect_result = co_await client.connect(url);
     if (!connect_result) {
         err_msg = connect_result.error().message();
         co_return;
     }
+    if (!connect_result.value()) {
+        err_msg = connect_result.value().error().message();
+        co_return;
+    }
     ok = true;
 
     co_return;
 }
 
+// 上游响应原样转发给客户端：优先 splice 零拷贝，不支持时 spliceRelay 内部退回用户态拷贝
 Task<void> relayRawUpstreamToDownstream(AsyncTcpSocket& upstream,
                                         AsyncTcpSocket& downstream,
                                         std::chrono::milliseconds downstream_write_timeout,
@@ -394,44 +421,436 @@ Task<void> relayRawUpstreamToDownstream(AsyncTcpSocket& upstream,
     ok = false;
     err_msg.clear();
 
-    std::array<char, kProxyRawRelayBufferSize> buffer{};
-    while (true) {
-        auto recv_result = co_await upstream.recv(buffer.data(), buffer.size());
-        if (!recv_result) {
-            err_msg = recv_result.error().message();
+    galay::async::SpliceRelayOptions options;
+    options.writeTimeout = downstream_write_timeout;
+    auto relay_result = co_await galay::async::spliceRelay(upstream, downstream, options);
+    if (!relay_result) {
+        err_msg = relay_result.error().message();
+        co_return;
+    }
+    if (!relay_result.value()) {
+        err_msg = relay_result.value().error().message();
+        co_return;
+    }
+    ok = true;
+}
+
+Task<void> closeProxyClient(HttpClient& client, const char* context)
+{
+    auto close_result = co_await client.close();
+    if (!close_result) {
+        HTTP_LOG_WARN("[proxy] [client-close-fail]",
+                      "context={} error={}",
+                      context,
+                      close_result.error().message());
+    }
+    co_return;
+}
+
+std::string buildUpstreamConnectUrl(const ProxyUpstream& upstream)
+{
+    return "http://" + upstream.host + ":" + std::to_string(upstream.port) + "/";
+}
+
+/**
+ * @brief 从上游组选择上游并取得连接
+ * @details 从第 attempt 次选择开始，直到取得连接或选满 group.size() 次；
+ *          use_pool 时优先复用本调度器的空闲连接并顺带丢弃超过 idle_ttl 的连接，
+ *          新建连接失败计入该上游的失败次数后换下一个上游。
+ */
+Task<void> acquireProxyClient(ProxyUpstreamGroup& group,
+                              const std::string& hash_key,
+                              const HttpProxyPolicy& policy,
+                              bool use_pool,
+                              size_t& attempt,
+                              std::unique_ptr<HttpClient>& client,
+                              size_t& index,
+                              bool& borrowed)
+{
+    borrowed = false;
+    while (!client && attempt < group.size()) {
+        auto selected = group.select(hash_key, attempt++);
+        if (!selected) {
             co_return;
         }
+        index = selected.value();
+
+        if (use_pool) {
+            auto& pool = g_proxyClientPools[group.upstreamKey(index)];
+            const auto now = std::chrono::steady_clock::now();
+            while (!pool.empty()) {
+                ProxyIdleClient idle = std::move(pool.back());
+                pool.pop_back();
+                if (now - idle.idle_since < policy.idle_ttl) {
+                    client = std::move(idle.client);
+                    borrowed = true;
+                    co_return;
+                }
+                co_await closeProxyClient(*idle.client, "idle-expired");
+            }
+        }
 
-        const size_t bytes = recv_result.value();
-        if (bytes == 0) {
-            ok = true;
-            co_return;
+        auto fresh = std::make_unique<HttpClient>();
+        const std::string connect_url = buildUpstreamConnectUrl(group.upstream(index));
+        bool connect_ok = false;
+        std::string connect_err;
+        co_await connectProxyUpstream(*fresh, connect_url, connect_ok, connect_err);
+        if (!connect_ok) {
+            group.reportFailure(index);
+            HTTP_LOG_ERROR("[proxy] [connect-fail]",
+                           "upstream={} error={}",
+                           group.upstreamKey(index),
+                           connect_err);
+            continue;
         }
+        client = std::move(fresh);
+    }
+    co_return;
+}
 
-        size_t offset = 0;
-        while (offset < bytes) {
-            const char* data = buffer.data() + offset;
-            auto send_result = co_await downstream.send(data, bytes - offset)
-                .timeout(downstream_write_timeout);
-            if (!send_result) {
-                err_msg = send_result.error().message();
-                co_return;
+std::string joinUpstreamKeys(const ProxyUpstreamGroup& group)
+{
+    std::string keys;
+    for (size_t i = 0; i < group.size(); ++i) {
+        if (i != 0) {
+            keys += ',';
+        }
+        keys += group.upstreamKey(i);
+    }
+    return keys;
+}
+
+std::chrono::milliseconds responseWriteTimeoutFromConn(const HttpConn& conn)
+{
+    return std::chrono::milliseconds(conn.defaultWriterSetting().getSendTimeout());
+}
+
+std::time_t resolveLastModified(const std::string& filePath)
+{
+    namespace fs = std::filesystem;
+    std::time_t lastModified = 0;
+#ifdef _WIN32
+    {
+        std::error_code ec;
+        auto ftime = fs::last_write_time(filePath, ec);
+        if (!ec) {
+            auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+                ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
+            );
+            lastModified = std::chrono::system_clock::to_time_t(sctp);
+        }
+    }
+#else
+    struct stat st;
+    if (stat(filePath.c_str(), &st) == 0) {
+        lastModified = st.st_mtime;
+    } else {
+        std::error_code ec;
+        auto ftime = fs::last_write_time(filePath, ec);
+        if (!ec) {
+            auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+                ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
+            );
+            lastModified = std::chrono::system_clock::to_time_t(sctp);
+        }
+    }
+#endif
+    if (lastModified == 0) {
+        // fallback: 使用当前时间，避免空值
+        lastModified = std::time(nullptr);
+    }
+    return lastModified;
+}
+
+/**
+ * @brief 捕获当前协程所属调度器
+ * @details 不挂起，只读取 promise 上绑定的调度器，用于把缓存监听协程提交到同一个 IO 调度器。
+ */
+class CurrentSchedulerAwaitable {
+public:
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        m_scheduler = handle.promise().taskRefView().belongScheduler();
+        return false;
+    }
+
+    galay::kernel::Scheduler* await_resume() const noexcept { return m_scheduler; }
+
+private:
+    galay::kernel::Scheduler* m_scheduler = nullptr;
+};
+
+// 与 sendFileContent 完整响应路径产出的响应头逐字节一致
+std::string renderStaticFileHeader(const StaticFileCacheEntry& entry)
+{
+    Http1_1ResponseBuilder responseBuilder;
+    responseBuilder
+        .status(HttpStatusCode::OK_200)
+        .header("Content-Type", entry.mimeType)
+        .header("Last-Modified", entry.lastModified)
+        .header("Accept-Ranges", "bytes");
+    if (!entry.etag.empty()) {
+        responseBuilder.header("ETag", entry.etag);
+    }
+    responseBuilder.header("Content-Length", std::to_string(entry.body.size()));
+    return responseBuilder.buildMove().header().toString();
+}
+
+/**
+ * @brief 读入文件并生成缓存条目，随后尝试写入缓存
+ * @param requestedPath 按请求拼出的路径，用于符号链接被替换时的失效匹配
+ * @return 条目；读取失败返回 nullptr，由调用方回到不经缓存的发送路径并报告错误
+ */
+Task<StaticFileCache::EntryPtr> loadStaticFileEntry(StaticFileCache& cache,
+                                                    std::string key,
+                                                    std::string requestedPath,
+                                                    std::string filePath,
+                                                    size_t fileSize,
+                                                    std::string mimeType,
+                                                    bool enableEtag)
+{
+    namespace fs = std::filesystem;
+
+    auto runtime = galay::kernel::RuntimeHandle::current();
+    if (!runtime.has_value()) {
+        co_return nullptr;
+    }
+
+    auto entry = std::make_shared<StaticFileCacheEntry>();
+    entry->filePath = std::move(filePath);
+    const fs::path requested(requestedPath);
+    std::error_code link_dir_error;
+    const fs::path linkDir = fs::canonical(requested.parent_path(), link_dir_error);
+    if (link_dir_error) {
+        entry->linkPath = std::move(requestedPath);
+    } else {
+        entry->linkPath = (linkDir / requested.filename()).string();
+    }
+    // 代数必须在 stat / read 之前取得，期间这两个路径的任何变更都会让插入失败
+    const uint64_t generation = cache.generation(entry->filePath, entry->linkPath);
+    entry->mimeType = std::move(mimeType);
+    entry->lastModifiedTime = resolveLastModified(entry->filePath);
+    entry->lastModified = ETagGenerator::formatHttpDate(entry->lastModifiedTime);
+    if (enableEtag) {
+        entry->etag = ETagGenerator::generateStrong(entry->filePath, fileSize, entry->lastModifiedTime);
+    }
+
+    using StaticFileReadResult = std::expected<std::string, StaticFileReadError>;
+    auto read_waiter = std::make_shared<galay::kernel::AsyncWaiter<StaticFileReadResult>>();
+    auto blocking_task = runtime->spawnBlocking(
+        [path = entry->filePath, fileSize, read_waiter]() mutable {
+            const bool notified = read_waiter->notify(readStaticFileBlocking(path, fileSize));
+            if (!notified) {
+                HTTP_LOG_WARN("[static-cache] [async-read-notify-duplicate]", "path={}", path);
             }
+        });
+    if (!blocking_task.has_value() || !blocking_task->isValid()) {
+        co_return nullptr;
+    }
+    auto awaited_read = co_await read_waiter->wait();
+    if (!awaited_read.has_value() || !awaited_read.value().has_value()) {
+        co_return nullptr;
+    }
 
-            const size_t sent = send_result.value();
-            if (sent == 0) {
-                err_msg = "downstream send returned 0";
-                co_return;
+    entry->body = std::move(awaited_read.value().value());
+    entry->header = renderStaticFileHeader(*entry);
+    StaticFileCache::EntryPtr shared = std::move(entry);
+    if (!cache.insert(std::move(key), shared, generation)) {
+        HTTP_LOG_DEBUG("[static-cache] [insert-skip]", "path={}", shared->filePath);
+    }
+    co_return shared;
+}
+
+/**
+ * @brief 预压缩的同名文件（"<file>.zst" / "<file>.gz"）
+ */
+struct PrecompressedSibling {
+    std::string path;
+    size_t size = 0;
+    std::time_t lastModified = 0;
+    HttpContentCoding coding = HttpContentCoding::Identity;
+};
+
+// 同名文件比原文件旧时内容可能已过期，不使用
+bool statPrecompressedSibling(const std::string& path, std::time_t original, size_t& size, std::time_t& lastModified)
+{
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode) || st.st_mtime < original) {
+        return false;
+    }
+    size = static_cast<size_t>(st.st_size);
+    lastModified = st.st_mtime;
+    return true;
+}
+
+/**
+ * @brief 按 Accept-Encoding 选择预压缩的同名文件
+ * @param available 输出：是否存在可用的同名文件，存在时响应需要附加 Vary
+ * @return 选中的同名文件；客户端不接受任何可用编码时返回空
+ */
+std::optional<PrecompressedSibling> selectPrecompressedSibling(const std::string& filePath,
+                                                               std::time_t lastModified,
+                                                               std::string_view acceptEncoding,
+                                                               bool& available)
+{
+    PrecompressedSibling zstd{filePath + ".zst"};
+    PrecompressedSibling gzip{filePath + ".gz"};
+    const bool hasZstd = statPrecompressedSibling(zstd.path, lastModified, zstd.size, zstd.lastModified);
+    const bool hasGzip = statPrecompressedSibling(gzip.path, lastModified, gzip.size, gzip.lastModified);
+    available = hasZstd || hasGzip;
+    if (!available) {
+        return std::nullopt;
+    }
+    switch (negotiateContentCoding(acceptEncoding, hasGzip, hasZstd)) {
+        case HttpContentCoding::Zstd:
+            zstd.coding = HttpContentCoding::Zstd;
+            return zstd;
+        case HttpContentCoding::Gzip:
+            gzip.coding = HttpContentCoding::Gzip;
+            return gzip;
+        default:
+            return std::nullopt;
+    }
+}
+
+// 在缓存的预渲染响应头结尾空行之前插入 Vary
+std::string withVaryAcceptEncoding(const std::string& header)
+{
+    std::string out = header;
+    out.insert(out.size() - 2, "Vary: Accept-Encoding\r\n");
+    return out;
+}
+
+/**
+ * @brief 在 blocking executor 上压缩文件，随后写入压缩变体缓存
+ * @param cached 文件缓存条目；非空时直接压缩其中的内容，不再读文件
+ * @return 压缩内容；读取或压缩失败返回 nullptr，由调用方按 identity 发送
+ */
+Task<CompressedVariantCache::BodyPtr> loadCompressedVariant(CompressedVariantCache& variants,
+                                                            std::string key,
+                                                            std::string filePath,
+                                                            size_t fileSize,
+                                                            StaticFileCache::EntryPtr cached,
+                                                            HttpContentCoding coding,
+                                                            int level)
+{
+    auto runtime = galay::kernel::RuntimeHandle::current();
+    if (!runtime.has_value()) {
+        co_return nullptr;
+    }
+
+    using CompressResult = std::expected<std::string, HttpError>;
+    auto compress_waiter = std::make_shared<galay::kernel::AsyncWaiter<CompressResult>>();
+    auto blocking_task = runtime->spawnBlocking(
+        [filePath, fileSize, cached, coding, level, compress_waiter]() mutable {
+            CompressResult result;
+            if (cached) {
+                result = compressContent(coding, cached->body, level);
+            } else {
+                auto content = readStaticFileBlocking(filePath, fileSize);
+                if (content.has_value()) {
+                    result = compressContent(coding, content.value(), level);
+                } else {
+                    result = std::unexpected(HttpError(kInternalError, "read failed"));
+                }
             }
+            const bool notified = compress_waiter->notify(std::move(result));
+            if (!notified) {
+                HTTP_LOG_WARN("[static-compress] [notify-duplicate]", "path={}", filePath);
+            }
+        });
+    if (!blocking_task.has_value() || !blocking_task->isValid()) {
+        co_return nullptr;
+    }
+    auto awaited = co_await compress_waiter->wait();
+    if (!awaited.has_value()) {
+        co_return nullptr;
+    }
+    if (!awaited.value().has_value()) {
+        HTTP_LOG_WARN("[static-compress] [fail]",
+                      "path={} coding={} error={}",
+                      filePath,
+                      contentCodingToken(coding),
+                      awaited.value().error().message());
+        co_return nullptr;
+    }
 
-            offset += sent;
+    auto body = std::make_shared<const std::string>(std::move(awaited.value().value()));
+    if (!variants.insert(std::move(key), body)) {
+        HTTP_LOG_DEBUG("[static-compress] [insert-skip]", "path={}", filePath);
+    }
+    co_return body;
+}
+
+/**
+ * @brief 解析 CONNECT 请求目标（authority-form：host:port 或 [v6]:port）
+ */
+bool parseConnectAuthority(std::string_view authority, std::string& host, uint16_t& port)
+{
+    const size_t colon = authority.rfind(':');
+    if (colon == std::string_view::npos || colon == 0 || colon + 1 >= authority.size()) {
+        return false;
+    }
+    std::string_view host_part = authority.substr(0, colon);
+    if (host_part.front() == '[') {
+        if (host_part.size() < 3 || host_part.back() != ']') {
+            return false;
+        }
+        host_part = host_part.substr(1, host_part.size() - 2);
+    } else if (host_part.find(':') != std::string_view::npos) {
+        return false;
+    }
+
+    uint32_t value = 0;
+    for (char c : authority.substr(colon + 1)) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<uint32_t>(c - '0');
+        if (value > 65535) {
+            return false;
         }
     }
+    if (value == 0) {
+        return false;
+    }
+    host.assign(host_part);
+    port = static_cast<uint16_t>(value);
+    return true;
 }
 
-std::chrono::milliseconds responseWriteTimeoutFromConn(const HttpConn& conn)
+bool connectTargetAllowed(const ConnectTunnelSetting& setting, const std::string& host, uint16_t port)
 {
-    return std::chrono::milliseconds(conn.defaultWriterSetting().getSendTimeout());
+    if (!setting.allowedPorts.empty() &&
+        std::find(setting.allowedPorts.begin(), setting.allowedPorts.end(), port) == setting.allowedPorts.end()) {
+        return false;
+    }
+    if (setting.allowedHosts.empty()) {
+        return true;
+    }
+    const std::string lower_host = toLowerAscii(host);
+    for (const auto& allowed : setting.allowedHosts) {
+        if (toLowerAscii(allowed) == lower_host) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Task<void> sendRawBytes(AsyncTcpSocket& socket, const char* data, size_t length, bool& ok)
+{
+    ok = false;
+    size_t offset = 0;
+    while (offset < length) {
+        auto send_result = co_await socket.send(data + offset, length - offset);
+        if (!send_result || send_result.value() == 0) {
+            co_return;
+        }
+        offset += send_result.value();
+    }
+    ok = true;
 }
 
 } // namespace
@@ -452,6 +871,9 @@ void HttpRouter::addHandlerInternal(HttpMethod method, const std::string& path,
         return;
     }
 
+    // 路由表变化后冻结表失效，需要重新 freeze()
+    m_frozen.reset();
+
     if (isFuzzyPattern(path)) {
         // 模糊匹配路由 - 使用Trie树
         auto& root = m_fuzzyRoutes[method];
@@ -488,6 +910,11 @@ RouteMatch HttpRouter::findHandler(HttpMethod method, const std::string& path)
 {
     RouteMatch result;
 
+    if (m_frozen) {
+        result.handler = searchFrozen(method, path, result.params);
+        return result;
+    }
+
     // 1. 先尝试精确匹配（O(1)）
     auto methodIt = m_exactRoutes.find(method);
     if (methodIt != m_exactRoutes.end()) {
@@ -507,6 +934,17 @@ RouteMatch HttpRouter::findHandler(HttpMethod method, const std::string& path)
     return result;  // 未找到，handler为nullptr
 }
 
+HttpRouteHandler* HttpRouter::findHandler(HttpMethod method, std::string_view path, RouteParams& params)
+{
+    if (m_frozen) {
+        return searchFrozen(method, path, params);
+    }
+    params.clear();
+    RouteMatch match = findHandler(method, std::string(path));
+    params = std::move(match.params);
+    return match.handler;
+}
+
 bool HttpRouter::delHandler(HttpMethod method, const std::string& path)
 {
     // 尝试从精确匹配中移除
@@ -514,6 +952,7 @@ bool HttpRouter::delHandler(HttpMethod method, const std::string& path)
     if (methodIt != m_exactRoutes.end()) {
         auto removed = methodIt->second.erase(path);
         if (removed > 0) {
+            m_frozen.reset();
             m_routeCount--;
             return true;
         }
@@ -527,11 +966,15 @@ bool HttpRouter::delHandler(HttpMethod method, const std::string& path)
 
 void HttpRouter::clear()
 {
+    m_frozen.reset();
     m_exactRoutes.clear();
     m_fuzzyRoutes.clear();
+    m_staticFileCaches.clear();
+    m_compressedVariantCaches.clear();
     if (m_fallbackProxyHandlerState) {
         m_fallbackProxyHandlerState->reset();
     }
+    m_connectTunnelHandler.reset();
     m_routeCount = 0;
 }
 
@@ -775,28 +1218,418 @@ HttpRouteHandler* HttpRouter::searchRoutePathRecursive(
         if (result != nullptr) {
             return result;
         }
-        paramValues.pop_back();
+        paramValues.pop_back();
+    }
+
+    if (auto wildcardIt = node->children.find("*"); wildcardIt != node->children.end()) {
+        auto* result = searchRoutePathRecursive(wildcardIt->second.get(),
+                                                path,
+                                                next_offset,
+                                                paramValues,
+                                                params);
+        if (result != nullptr) {
+            return result;
+        }
+    }
+
+    if (auto greedyIt = node->children.find("**"); greedyIt != node->children.end()) {
+        auto* greedyNode = greedyIt->second.get();
+        if (greedyNode != nullptr && greedyNode->isEnd) {
+            return &greedyNode->handler;
+        }
+    }
+
+    return nullptr;
+}
+
+// ==================== 冻结路由表（压缩基数树） ====================
+
+namespace {
+
+constexpr uint8_t kFrozenSlotMask =
+    FrozenRouteNode::kHasParam | FrozenRouteNode::kHasWildcard | FrozenRouteNode::kHasGreedy;
+constexpr size_t kFrozenPathBufferSize = 4096;
+
+/**
+ * 编译期使用的逐字节 Trie 节点。路由按 "/" + 各段以 '/' 连接的规范形式展开，
+ * `:param` / `*` / `**` 作为段起点（'/' 之后）上的独立槽位。
+ */
+struct FrozenBuildNode
+{
+    std::map<char, std::unique_ptr<FrozenBuildNode>> children;
+    std::unique_ptr<FrozenBuildNode> param;
+    std::unique_ptr<FrozenBuildNode> wildcard;
+    std::unique_ptr<FrozenBuildNode> greedy;
+    HttpRouteHandler* handler = nullptr;
+    const std::vector<std::string>* paramNames = nullptr;
+    uint8_t terminal = FrozenRouteNode::kTerminalNone;
+
+    FrozenBuildNode* walk(char c)
+    {
+        auto& child = children[c];
+        if (!child) {
+            child = std::make_unique<FrozenBuildNode>();
+        }
+        return child.get();
+    }
+
+    FrozenBuildNode* walk(std::string_view bytes)
+    {
+        FrozenBuildNode* node = this;
+        for (char c : bytes) {
+            node = node->walk(c);
+        }
+        return node;
+    }
+
+    static FrozenBuildNode* slot(std::unique_ptr<FrozenBuildNode>& child)
+    {
+        if (!child) {
+            child = std::make_unique<FrozenBuildNode>();
+        }
+        return child.get();
+    }
+
+    bool compressible() const
+    {
+        return children.size() == 1 && !param && !wildcard && !greedy &&
+               terminal == FrozenRouteNode::kTerminalNone;
+    }
+};
+
+// 请求路径已是规范形式（"/" 或以 '/' 开头、无连续 '/'、无结尾 '/'）时可直接匹配，无需拷贝
+bool isCanonicalRoutePath(std::string_view path)
+{
+    if (path.empty() || path.front() != '/') {
+        return false;
+    }
+    if (path.size() == 1) {
+        return true;
+    }
+    return path.back() != '/' && path.find("//") == std::string_view::npos;
+}
+
+bool buildFrozenFromTrie(FrozenBuildNode* build, RouteTrieNode* trie)
+{
+    if (trie->isEnd) {
+        if (trie->paramNames.size() > HttpRouter::kMaxFrozenRouteParams) {
+            return false;
+        }
+        build->terminal = FrozenRouteNode::kTerminalFuzzy;
+        build->handler = &trie->handler;
+        build->paramNames = &trie->paramNames;
+    }
+    for (const auto& [key, child] : trie->children) {
+        FrozenBuildNode* segmentStart = build->walk('/');
+        FrozenBuildNode* next = nullptr;
+        if (child->isParam) {
+            next = FrozenBuildNode::slot(segmentStart->param);
+        } else if (child->isWildcard && key == "*") {
+            next = FrozenBuildNode::slot(segmentStart->wildcard);
+        } else if (child->isWildcard) {
+            next = FrozenBuildNode::slot(segmentStart->greedy);
+        } else {
+            next = segmentStart->walk(key);
+        }
+        if (!buildFrozenFromTrie(next, child.get())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 按广度优先把逐字节 Trie 压缩并平铺到连续数组，保证同一节点的子节点相邻
+void layoutFrozenTable(FrozenRouteTable& table, FrozenBuildNode* root, uint32_t rootIndex)
+{
+    struct Pending {
+        FrozenBuildNode* build;
+        uint32_t index;
+    };
+    std::vector<Pending> queue;
+    queue.push_back({root, rootIndex});
+
+    auto appendNode = [&table, &queue](FrozenBuildNode* build, std::string_view label) {
+        const uint32_t index = static_cast<uint32_t>(table.nodes.size());
+        FrozenRouteNode& node = table.nodes.emplace_back();
+        node.labelOffset = static_cast<uint32_t>(table.labels.size());
+        node.labelLength = static_cast<uint16_t>(label.size());
+        table.labels.append(label.data(), label.size());
+        table.firstBytes.push_back(label.empty() ? '\0' : label.front());
+        queue.push_back({build, index});
+    };
+
+    std::string label;
+    for (size_t cursor = 0; cursor < queue.size(); ++cursor) {
+        const Pending pending = queue[cursor];
+        FrozenBuildNode* build = pending.build;
+
+        const uint32_t firstChild = static_cast<uint32_t>(table.nodes.size());
+        uint16_t staticCount = 0;
+        for (auto& [byte, child] : build->children) {
+            label.assign(1, byte);
+            FrozenBuildNode* tail = child.get();
+            while (tail->compressible()) {
+                auto only = tail->children.begin();
+                label.push_back(only->first);
+                tail = only->second.get();
+            }
+            appendNode(tail, label);
+            ++staticCount;
+        }
+
+        uint8_t flags = 0;
+        if (build->param) {
+            appendNode(build->param.get(), {});
+            flags |= FrozenRouteNode::kHasParam;
+        }
+        if (build->wildcard) {
+            appendNode(build->wildcard.get(), {});
+            flags |= FrozenRouteNode::kHasWildcard;
+        }
+        if (build->greedy) {
+            appendNode(build->greedy.get(), {});
+            flags |= FrozenRouteNode::kHasGreedy;
+        }
+
+        FrozenRouteNode& node = table.nodes[pending.index];
+        node.staticCount = staticCount;
+        node.flags = flags;
+        if (staticCount != 0 || flags != 0) {
+            node.firstChild = firstChild;
+        }
+        if (build->terminal != FrozenRouteNode::kTerminalNone) {
+            node.terminal = build->terminal;
+            node.handler = static_cast<uint32_t>(table.handlers.size());
+            table.handlers.push_back(build->handler);
+            if (build->paramNames != nullptr) {
+                node.paramNameOffset = static_cast<uint32_t>(table.paramNames.size());
+                node.paramNameCount = static_cast<uint16_t>(build->paramNames->size());
+                table.paramNames.insert(table.paramNames.end(),
+                                        build->paramNames->begin(),
+                                        build->paramNames->end());
+            }
+        }
+    }
+}
+
+struct FrozenMatchContext
+{
+    const FrozenRouteTable& table;
+    std::string_view path;
+    bool canonical = false;
+    bool greedy = false;
+    size_t valueCount = 0;
+    std::array<std::string_view, HttpRouter::kMaxFrozenRouteParams> values;
+};
+
+/**
+ * 返回命中的终点节点下标。只在存在 `:param` / `*` / `**` 槽位的节点上递归
+ * （这些是唯一需要回溯的分支点），纯静态链路原地循环下降。
+ */
+uint32_t matchFrozenNode(FrozenMatchContext& ctx, uint32_t index, size_t offset)
+{
+    const FrozenRouteTable& table = ctx.table;
+    const std::string_view path = ctx.path;
+    for (;;) {
+        const FrozenRouteNode& node = table.nodes[index];
+        if (offset == path.size()) {
+            if (node.terminal == FrozenRouteNode::kTerminalFuzzy ||
+                (node.terminal == FrozenRouteNode::kTerminalExact && ctx.canonical)) {
+                return index;
+            }
+            return FrozenRouteNode::kNone;
+        }
+
+        uint32_t staticChild = FrozenRouteNode::kNone;
+        if (node.staticCount != 0) {
+            const char* first = table.firstBytes.data() + node.firstChild;
+            const void* hit = std::memchr(first, path[offset], node.staticCount);
+            if (hit != nullptr) {
+                const uint32_t childIndex =
+                    node.firstChild + static_cast<uint32_t>(static_cast<const char*>(hit) - first);
+                const FrozenRouteNode& child = table.nodes[childIndex];
+                if (path.size() - offset >= child.labelLength &&
+                    std::memcmp(path.data() + offset,
+                                table.labels.data() + child.labelOffset,
+                                child.labelLength) == 0) {
+                    staticChild = childIndex;
+                }
+            }
+        }
+
+        if ((node.flags & kFrozenSlotMask) == 0) {
+            if (staticChild == FrozenRouteNode::kNone) {
+                return FrozenRouteNode::kNone;
+            }
+            offset += table.nodes[staticChild].labelLength;
+            index = staticChild;
+            continue;
+        }
+
+        if (staticChild != FrozenRouteNode::kNone) {
+            const uint32_t result =
+                matchFrozenNode(ctx, staticChild, offset + table.nodes[staticChild].labelLength);
+            if (result != FrozenRouteNode::kNone) {
+                return result;
+            }
+        }
+
+        // 槽位只挂在段起点上，且规范路径没有空段，因此 [offset, segmentEnd) 非空
+        size_t segmentEnd = path.find('/', offset);
+        if (segmentEnd == std::string_view::npos) {
+            segmentEnd = path.size();
+        }
+        uint32_t slot = node.firstChild + node.staticCount;
+        if (node.flags & FrozenRouteNode::kHasParam) {
+            if (ctx.valueCount < ctx.values.size()) {
+                ctx.values[ctx.valueCount++] = path.substr(offset, segmentEnd - offset);
+                const uint32_t result = matchFrozenNode(ctx, slot, segmentEnd);
+                if (result != FrozenRouteNode::kNone) {
+                    return result;
+                }
+                --ctx.valueCount;
+            }
+            ++slot;
+        }
+        if (node.flags & FrozenRouteNode::kHasWildcard) {
+            const uint32_t result = matchFrozenNode(ctx, slot, segmentEnd);
+            if (result != FrozenRouteNode::kNone) {
+                return result;
+            }
+            ++slot;
+        }
+        if ((node.flags & FrozenRouteNode::kHasGreedy) &&
+            table.nodes[slot].terminal == FrozenRouteNode::kTerminalFuzzy) {
+            // 与 Trie 路径一致：贪婪通配符命中时不回填参数
+            ctx.greedy = true;
+            return slot;
+        }
+        return FrozenRouteNode::kNone;
+    }
+}
+
+} // namespace
+
+bool HttpRouter::freeze()
+{
+    FrozenRouteTable table;
+    table.roots.fill(FrozenRouteNode::kNone);
+
+    for (size_t slot = 0; slot < FrozenRouteTable::kMethodSlots; ++slot) {
+        const auto method = static_cast<HttpMethod>(slot);
+        FrozenBuildNode root;
+        bool hasRoutes = false;
+
+        if (auto exactIt = m_exactRoutes.find(method); exactIt != m_exactRoutes.end()) {
+            for (auto& [path, handler] : exactIt->second) {
+                if (!isCanonicalRoutePath(path)) {
+                    table.rawExactFallback = true;
+                    continue;
+                }
+                FrozenBuildNode* node = root.walk(path);
+                node->terminal = FrozenRouteNode::kTerminalExact;
+                node->handler = &handler;
+                hasRoutes = true;
+            }
+        }
+
+        if (auto fuzzyIt = m_fuzzyRoutes.find(method);
+            fuzzyIt != m_fuzzyRoutes.end() && fuzzyIt->second) {
+            if (!buildFrozenFromTrie(&root, fuzzyIt->second.get())) {
+                HTTP_LOG_WARN("[route] [freeze]",
+                              "method={} skipped: route has more than {} params",
+                              static_cast<int>(method),
+                              kMaxFrozenRouteParams);
+                m_frozen.reset();
+                return false;
+            }
+            hasRoutes = true;
+        }
+
+        if (!hasRoutes) {
+            continue;
+        }
+        table.roots[slot] = static_cast<uint32_t>(table.nodes.size());
+        table.nodes.emplace_back();
+        table.firstBytes.push_back('\0');
+        layoutFrozenTable(table, &root, table.roots[slot]);
+    }
+
+    m_frozen.emplace(std::move(table));
+    return true;
+}
+
+HttpRouteHandler* HttpRouter::searchFrozen(HttpMethod method, std::string_view path, RouteParams& params)
+{
+    params.clear();
+    const FrozenRouteTable& table = *m_frozen;
+    const size_t slot = static_cast<size_t>(method);
+    if (slot >= FrozenRouteTable::kMethodSlots) {
+        return nullptr;
+    }
+
+    const bool canonical = isCanonicalRoutePath(path);
+    if (!canonical && table.rawExactFallback) {
+        // 非规范形式的精确路由（如 "/docs/"）不进入基数树，按原语义回查精确表
+        if (auto methodIt = m_exactRoutes.find(method); methodIt != m_exactRoutes.end()) {
+            if (auto pathIt = methodIt->second.find(std::string(path)); pathIt != methodIt->second.end()) {
+                return &pathIt->second;
+            }
+        }
+    }
+
+    const uint32_t root = table.roots[slot];
+    if (root == FrozenRouteNode::kNone) {
+        return nullptr;
+    }
+
+    std::string_view normalized = path;
+    std::array<char, kFrozenPathBufferSize> buffer;
+    if (!canonical) {
+        // 折叠连续 '/'、去掉结尾 '/'，与 nextRouteSegment 的分段语义一致
+        size_t length = 0;
+        buffer[length++] = '/';
+        std::string_view segment;
+        size_t offset = 0;
+        size_t nextOffset = 0;
+        while (nextRouteSegment(path, offset, segment, nextOffset)) {
+            const size_t needed = segment.size() + (length > 1 ? 1 : 0);
+            if (buffer.size() - length < needed) {
+                // 超长非规范路径极少见，交回 Trie 处理
+                auto fuzzyIt = m_fuzzyRoutes.find(method);
+                if (fuzzyIt == m_fuzzyRoutes.end() || !fuzzyIt->second) {
+                    return nullptr;
+                }
+                return searchRoutePath(fuzzyIt->second.get(), path, params);
+            }
+            if (length > 1) {
+                buffer[length++] = '/';
+            }
+            std::memcpy(buffer.data() + length, segment.data(), segment.size());
+            length += segment.size();
+            offset = nextOffset;
+        }
+        normalized = std::string_view(buffer.data(), length);
     }
 
-    if (auto wildcardIt = node->children.find("*"); wildcardIt != node->children.end()) {
-        auto* result = searchRoutePathRecursive(wildcardIt->second.get(),
-                                                path,
-                                                next_offset,
-                                                paramValues,
-                                                params);
-        if (result != nullptr) {
-            return result;
-        }
+    FrozenMatchContext ctx{table, normalized};
+    ctx.canonical = canonical;
+    const uint32_t index = matchFrozenNode(ctx, root, 0);
+    if (index == FrozenRouteNode::kNone) {
+        return nullptr;
     }
 
-    if (auto greedyIt = node->children.find("**"); greedyIt != node->children.end()) {
-        auto* greedyNode = greedyIt->second.get();
-        if (greedyNode != nullptr && greedyNode->isEnd) {
-            return &greedyNode->handler;
+    const FrozenRouteNode& node = table.nodes[index];
+    if (!ctx.greedy) {
+        const size_t count = std::min<size_t>(node.paramNameCount, ctx.valueCount);
+        for (size_t i = 0; i < count; ++i) {
+            const bool inserted = params.emplace(table.paramNames[node.paramNameOffset + i], ctx.values[i]);
+            if (!inserted) {
+                return nullptr;
+            }
         }
     }
-
-    return nullptr;
+    return table.handlers[node.handler];
 }
 
 bool HttpRouter::validatePath(const std::string& path, std::string& error) const
@@ -962,8 +1795,23 @@ void HttpRouter::mountHardly(const std::string& routePrefix, const std::string&
         return;
     }
 
+    std::shared_ptr<StaticFileCache> cache;
+    if (config.isEnableCache()) {
+        std::error_code canonical_dir_error;
+        fs::path canonicalDir = fs::canonical(dirPath, canonical_dir_error);
+        cache = std::make_shared<StaticFileCache>(
+            canonical_dir_error ? dirPath : canonicalDir.string(), config.getMaxCacheSize());
+        m_staticFileCaches.push_back(cache);
+    }
+
+    std::shared_ptr<CompressedVariantCache> variants;
+    if (config.getCompression().isEnabled()) {
+        variants = std::make_shared<CompressedVariantCache>(config.getCompressedCacheSize());
+        m_compressedVariantCaches.push_back(variants);
+    }
+
     // 递归遍历目录并注册所有文件
-    registerFilesRecursively(routePrefix, dirPath, config, "");
+    registerFilesRecursively(routePrefix, dirPath, config, "", cache, variants);
 
     HTTP_LOG_INFO("[mount-hard]", "dir={} route={}", dirPath, routePrefix);
 }
@@ -991,7 +1839,9 @@ void HttpRouter::tryFiles(const std::string& routePrefix,
     }
 
     std::string normalizedPrefix = normalizeRoutePrefix(routePrefix);
-    auto fallbackProxy = createProxyHandler("/", upstreamHost, upstreamPort, mode);
+    auto group = std::make_shared<ProxyUpstreamGroup>(
+        std::vector<ProxyUpstream>{ProxyUpstream{upstreamHost, upstreamPort}});
+    auto fallbackProxy = createProxyHandler("/", std::move(group), m_defaultPolicy.proxy, mode);
     auto handler = createStaticFileHandler(normalizedPrefix, dirPath, config, std::move(fallbackProxy));
 
     std::string wildcardPath = normalizedPrefix;
@@ -1026,8 +1876,35 @@ void HttpRouter::proxy(const std::string& routePrefix,
         return;
     }
 
+    proxy(routePrefix,
+          std::vector<ProxyUpstream>{ProxyUpstream{upstreamHost, upstreamPort}},
+          ProxyUpstreamSetting(),
+          mode);
+}
+
+void HttpRouter::proxy(const std::string& routePrefix,
+                       std::vector<ProxyUpstream> upstreams,
+                       const ProxyUpstreamSetting& setting,
+                       ProxyMode mode)
+{
+    if (upstreams.empty()) {
+        HTTP_LOG_ERROR("[proxy] [invalid-upstream]", "route={} upstreams=0", routePrefix);
+        return;
+    }
+    for (const auto& upstream : upstreams) {
+        if (upstream.host.empty() || upstream.port == 0) {
+            HTTP_LOG_ERROR("[proxy] [invalid-upstream]",
+                           "host={} port={}",
+                           upstream.host,
+                           upstream.port);
+            return;
+        }
+    }
+
     std::string normalizedPrefix = normalizeRoutePrefix(routePrefix);
-    auto handler = createProxyHandler(normalizedPrefix, upstreamHost, upstreamPort, mode);
+    auto group = std::make_shared<ProxyUpstreamGroup>(std::move(upstreams), setting);
+    const std::string upstreamKeys = joinUpstreamKeys(*group);
+    auto handler = createProxyHandler(normalizedPrefix, std::move(group), m_defaultPolicy.proxy, mode);
 
     std::string wildcardPath = normalizedPrefix == "/" ? "/**" : normalizedPrefix + "/**";
     addHandler<HttpMethod::GET, HttpMethod::POST, HttpMethod::PUT,
@@ -1044,18 +1921,16 @@ void HttpRouter::proxy(const std::string& routePrefix,
         if (!m_fallbackProxyHandlerState) {
             m_fallbackProxyHandlerState = std::make_shared<std::optional<HttpRouteHandler>>();
         }
-        *m_fallbackProxyHandlerState = createProxyHandler("/", upstreamHost, upstreamPort, mode);
+        *m_fallbackProxyHandlerState = handler;
         HTTP_LOG_INFO("[proxy-fallback] [enable]",
-                      "upstream={}:{} mode={}",
-                      upstreamHost,
-                      upstreamPort,
+                      "upstream={} mode={}",
+                      upstreamKeys,
                       mode == ProxyMode::Raw ? "raw" : "http");
     }
 
     HTTP_LOG_INFO("[proxy] [mount]",
-                  "upstream={}:{} route={}",
-                  upstreamHost,
-                  upstreamPort,
+                  "upstream={} route={}",
+                  upstreamKeys,
                   normalizedPrefix);
 }
 
@@ -1072,6 +1947,20 @@ HttpRouteHandler* HttpRouter::fallbackProxyHandler()
     return &m_fallbackProxyHandlerState->value();
 }
 
+void HttpRouter::connectTunnel(const ConnectTunnelSetting& setting)
+{
+    m_connectTunnelHandler = createConnectTunnelHandler(setting);
+    HTTP_LOG_INFO("[connect] [enable]",
+                  "hosts={} ports={}",
+                  setting.allowedHosts.size(),
+                  setting.allowedPorts.size());
+}
+
+HttpRouteHandler* HttpRouter::connectTunnelHandler()
+{
+    return m_connectTunnelHandler ? &m_connectTunnelHandler.value() : nullptr;
+}
+
 HttpRouteHandler HttpRouter::createStaticFileHandler(const std::string& routePrefix,
                                                      const std::string& dirPath,
                                                      const StaticFileSetting& config,
@@ -1085,8 +1974,20 @@ HttpRouteHandler HttpRouter::createStaticFileHandler(const std::string& routePre
         canonicalDir = fs::path(dirPath);
     }
 
+    std::shared_ptr<StaticFileCache> cache;
+    if (config.isEnableCache()) {
+        cache = std::make_shared<StaticFileCache>(canonicalDir.string(), config.getMaxCacheSize());
+        m_staticFileCaches.push_back(cache);
+    }
+
+    std::shared_ptr<CompressedVariantCache> variants;
+    if (config.getCompression().isEnabled()) {
+        variants = std::make_shared<CompressedVariantCache>(config.getCompressedCacheSize());
+        m_compressedVariantCaches.push_back(variants);
+    }
+
     // 捕获 routePrefix、dirPath 和 config，返回一个协程处理器
-    return [routePrefix, dirPath, canonicalDir, config, fallbackHandler](HttpConn& conn, HttpRequest req) -> Task<void> {
+    return [routePrefix, dirPath, canonicalDir, config, fallbackHandler, cache, variants](HttpConn& conn, HttpRequest req) -> Task<void> {
         namespace fs = std::filesystem;
 
         // 获取请求的路径参数（通配符匹配的部分）
@@ -1104,6 +2005,20 @@ HttpRouteHandler HttpRouter::createStaticFileHandler(const std::string& routePre
             relativePath = requestPath.substr(start);
         }
 
+        // 缓存命中：条目只在通过下面的存在性与路径遍历检查后写入，可直接发送
+        bool useCache = false;
+        if (cache) {
+            auto* scheduler = co_await CurrentSchedulerAwaitable{};
+            useCache = cache->ensureWatching(scheduler);
+        }
+        if (useCache) {
+            if (auto cached = cache->find(relativePath)) {
+                co_await sendFileContent(conn, req, cached->filePath, cached->body.size(),
+                                         cached->mimeType, config, cached, variants);
+                co_return;
+            }
+        }
+
         // 构建完整文件路径
         fs::path fullPath = fs::path(dirPath) / relativePath;
 
@@ -1202,7 +2117,22 @@ HttpRouteHandler HttpRouter::createStaticFileHandler(const std::string& routePre
                        canonicalFile.string(),
                        fileSize,
                        mimeType);
-        co_await sendFileContent(conn, req, canonicalFile.string(), fileSize, mimeType, config);
+        if (useCache && cache->admits(fileSize) &&
+            config.decideTransferMode(fileSize) != FileTransferMode::SENDFILE) {
+            auto loaded = co_await loadStaticFileEntry(*cache,
+                                                       relativePath,
+                                                       (canonicalDir / relativePath).string(),
+                                                       canonicalFile.string(),
+                                                       fileSize,
+                                                       mimeType,
+                                                       config.isEnableETag());
+            if (loaded.has_value() && loaded.value()) {
+                StaticFileCache::EntryPtr cached = std::move(loaded.value());
+                co_await sendFileContent(conn, req, cached->filePath, fileSize, mimeType, config, cached, variants);
+                co_return;
+            }
+        }
+        co_await sendFileContent(conn, req, canonicalFile.string(), fileSize, mimeType, config, nullptr, variants);
         co_return;
     };
 }
@@ -1210,7 +2140,9 @@ HttpRouteHandler HttpRouter::createStaticFileHandler(const std::string& routePre
 void HttpRouter::registerFilesRecursively(const std::string& routePrefix,
                                           const std::string& dirPath,
                                           const StaticFileSetting& config,
-                                          const std::string& currentPath)
+                                          const std::string& currentPath,
+                                          const std::shared_ptr<StaticFileCache>& cache,
+                                          const std::shared_ptr<CompressedVariantCache>& variants)
 {
     namespace fs = std::filesystem;
 
@@ -1250,7 +2182,7 @@ void HttpRouter::registerFilesRecursively(const std::string& routePrefix,
                 continue;
             }
             // 递归处理子目录
-            registerFilesRecursively(routePrefix, dirPath, config, relativePath);
+            registerFilesRecursively(routePrefix, dirPath, config, relativePath, cache, variants);
             continue;
         }
 
@@ -1271,7 +2203,7 @@ void HttpRouter::registerFilesRecursively(const std::string& routePrefix,
 
             // 创建文件处理器
             std::string filePath = entry.path().string();
-            auto handler = createSingleFileHandler(filePath, config);
+            auto handler = createSingleFileHandler(filePath, config, cache, variants);
 
             // 注册路由
             addHandler<HttpMethod::GET, HttpMethod::HEAD>(routePath, handler);
@@ -1285,12 +2217,27 @@ void HttpRouter::registerFilesRecursively(const std::string& routePrefix,
 }
 
 HttpRouteHandler HttpRouter::createSingleFileHandler(const std::string& filePath,
-                                                     const StaticFileSetting& config)
+                                                     const StaticFileSetting& config,
+                                                     std::shared_ptr<StaticFileCache> cache,
+                                                     std::shared_ptr<CompressedVariantCache> variants)
 {
     // 捕获文件路径和配置
-    return [filePath, config](HttpConn& conn, HttpRequest req) -> Task<void> {
+    return [filePath, config, cache, variants](HttpConn& conn, HttpRequest req) -> Task<void> {
         namespace fs = std::filesystem;
 
+        bool useCache = false;
+        if (cache) {
+            auto* scheduler = co_await CurrentSchedulerAwaitable{};
+            useCache = cache->ensureWatching(scheduler);
+        }
+        if (useCache) {
+            if (auto cached = cache->find(filePath)) {
+                co_await sendFileContent(conn, req, cached->filePath, cached->body.size(),
+                                         cached->mimeType, config, cached, variants);
+                co_return;
+            }
+        }
+
         // 检查文件是否存在
         if (!fs::exists(filePath) || !fs::is_regular_file(filePath)) {
             auto response = Http1_1ResponseBuilder()
@@ -1314,37 +2261,159 @@ HttpRouteHandler HttpRouter::createSingleFileHandler(const std::string& filePath
         std::string ext = extension.empty() ? "" : extension.substr(1);
         std::string mimeType = MimeType::convertToMimeType(ext);
 
+        if (useCache && cache->admits(fileSize) &&
+            config.decideTransferMode(fileSize) != FileTransferMode::SENDFILE) {
+            std::error_code canonical_error;
+            fs::path canonicalFile = fs::canonical(path, canonical_error);
+            std::string realPath = filePath;
+            if (!canonical_error) {
+                realPath = canonicalFile.string();
+            }
+            auto loaded = co_await loadStaticFileEntry(*cache,
+                                                       filePath,
+                                                       filePath,
+                                                       std::move(realPath),
+                                                       fileSize,
+                                                       mimeType,
+                                                       config.isEnableETag());
+            if (loaded.has_value() && loaded.value()) {
+                StaticFileCache::EntryPtr cached = std::move(loaded.value());
+                co_await sendFileContent(conn, req, cached->filePath, fileSize, mimeType, config, cached, variants);
+                co_return;
+            }
+        }
+
         // 使用配置的传输方式发送文件
-        co_await sendFileContent(conn, req, filePath, fileSize, mimeType, config);
+        co_await sendFileContent(conn, req, filePath, fileSize, mimeType, config, nullptr, variants);
+        co_return;
+    };
+}
+
+HttpRouteHandler HttpRouter::createConnectTunnelHandler(const ConnectTunnelSetting& setting)
+{
+    return [setting](HttpConn& conn, HttpRequest req) -> Task<void> {
+        const ConnectTunnelSetting tunnel_setting = setting;
+        const std::string authority = req.header().uri();
+        std::string host;
+        uint16_t port = 0;
+        if (!parseConnectAuthority(authority, host, port)) {
+            co_await sendProxyError(conn, HttpStatusCode::BadRequest_400,
+                                    "Bad Request: invalid CONNECT target");
+            co_return;
+        }
+        if (!connectTargetAllowed(tunnel_setting, host, port)) {
+            HTTP_LOG_WARN("[connect] [deny]", "target={}", authority);
+            co_await sendProxyError(conn, HttpStatusCode::Forbidden_403,
+                                    "Forbidden: CONNECT target not allowed");
+            co_return;
+        }
+
+        HttpClient client;
+        std::string connect_url = "http://";
+        if (host.find(':') != std::string::npos) {
+            connect_url += "[" + host + "]";
+        } else {
+            connect_url += host;
+        }
+        connect_url += ":" + std::to_string(port) + "/";
+        bool connect_ok = false;
+        std::string connect_err;
+        co_await connectProxyUpstream(client, connect_url, connect_ok, connect_err);
+        if (!connect_ok) {
+            HTTP_LOG_ERROR("[connect] [connect-fail]", "target={} error={}", authority, connect_err);
+            co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
+                                    "Bad Gateway: connect target failed");
+            co_return;
+        }
+        auto upstream_socket = client.socket();
+        if (!upstream_socket) {
+            HTTP_LOG_ERROR("[connect] [socket-fail]", "error={}", upstream_socket.error().message());
+            co_await closeProxyClient(client, "connect-socket-fail");
+            co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
+                                    "Bad Gateway: connect target failed");
+            co_return;
+        }
+        AsyncTcpSocket& upstream = upstream_socket.value().get();
+        AsyncTcpSocket& downstream = conn.getSocket();
+
+        // 隧道建立后客户端连接不再承载 HTTP；任何失败都关闭两端，由服务器读循环收到 EOF 后结束连接
+        constexpr std::string_view kEstablished = "HTTP/1.1 200 Connection Established\r\n\r\n";
+        bool relay_ok = false;
+        co_await sendRawBytes(downstream, kEstablished.data(), kEstablished.size(), relay_ok);
+
+        // 客户端可能紧随 CONNECT 发出首包（如 TLS ClientHello），它已被读入连接缓冲区
+        auto& ring_buffer = conn.ringBuffer();
+        while (relay_ok && ring_buffer.readable() > 0) {
+            std::array<struct iovec, 2> buffered{};
+            const size_t count = ring_buffer.getReadIovecs(buffered);
+            size_t forwarded = 0;
+            for (size_t i = 0; i < count && relay_ok; ++i) {
+                co_await sendRawBytes(upstream, static_cast<const char*>(buffered[i].iov_base),
+                                      buffered[i].iov_len, relay_ok);
+                forwarded += buffered[i].iov_len;
+            }
+            ring_buffer.consume(forwarded);
+        }
+
+        if (relay_ok) {
+            galay::async::SpliceRelayOptions options;
+            options.writeTimeout = tunnel_setting.writeTimeout;
+            auto tunnel_result = co_await galay::async::spliceTunnel(downstream, upstream, options);
+            if (!tunnel_result) {
+                HTTP_LOG_WARN("[connect] [tunnel-fail]", "target={} error={}",
+                              authority, tunnel_result.error().message());
+            } else if (!tunnel_result.value()) {
+                HTTP_LOG_WARN("[connect] [tunnel-fail]", "target={} error={}",
+                              authority, tunnel_result.value().error().message());
+            } else {
+                HTTP_LOG_DEBUG("[connect] [tunnel-done]", "target={} up={} down={}",
+                               authority,
+                               tunnel_result.value().value().forward.bytes,
+                               tunnel_result.value().value().backward.bytes);
+            }
+        }
+
+        co_await closeProxyClient(client, "connect-complete");
+        const GHandle downstream_handle = downstream.handle();
+        if (downstream_handle != GHandle::invalid()) {
+            (void)::shutdown(downstream_handle.fd, SHUT_RDWR);
+        }
         co_return;
     };
 }
 
 HttpRouteHandler HttpRouter::createProxyHandler(const std::string& routePrefix,
-                                                const std::string& upstreamHost,
-                                                uint16_t upstreamPort,
+                                                std::shared_ptr<ProxyUpstreamGroup> group,
+                                                const HttpProxyPolicy& policy,
                                                 ProxyMode mode)
 {
-    return [routePrefix, upstreamHost, mode, upstreamPort](HttpConn& conn, HttpRequest req) -> Task<void> {
+    return [routePrefix, group = std::move(group), policy, mode](HttpConn& conn, HttpRequest req) -> Task<void> {
+        // 拷贝到协程帧，处理器对象在请求期间被替换也不会悬空
+        const std::shared_ptr<ProxyUpstreamGroup> upstream_group = group;
+        const HttpProxyPolicy proxy_policy = policy;
         const std::string request_uri = req.header().uri();
         const std::string upstream_uri = rewriteProxyUri(routePrefix, request_uri);
-        const std::string pool_key = buildUpstreamKey(upstreamHost, upstreamPort);
-        const std::string upstream_connect_url = "http://" + upstreamHost + ":" +
-                                                 std::to_string(upstreamPort) + "/";
 
         auto& headers = req.header().headerPairs();
         const std::string original_host = getHeaderValueLoose(headers, "Host");
         const std::string connection = getHeaderValueLoose(headers, "Connection");
         std::vector<std::string> hop_by_hop_tokens = splitConnectionTokens(connection);
 
+        // 一致性哈希键取自配置的请求头，缺失时退回客户端 IP；须在剥离逐跳头之前读取
+        std::string hash_key;
+        if (upstream_group->setting().strategy == ProxyBalanceStrategy::ConsistentHash) {
+            if (!upstream_group->setting().hashHeader.empty()) {
+                hash_key = getHeaderValueLoose(headers, upstream_group->setting().hashHeader);
+            }
+            if (hash_key.empty()) {
+                hash_key = getClientIpFromConn(conn);
+            }
+        }
+
         ProxyMode effective_mode = mode;
         if (mode == ProxyMode::Http && isLikelyStreamingRequest(upstream_uri, headers)) {
             effective_mode = ProxyMode::Raw;
-            HTTP_LOG_INFO("[proxy] [stream-upgrade]",
-                          "uri={} upstream={}:{}",
-                          upstream_uri,
-                          upstreamHost,
-                          upstreamPort);
+            HTTP_LOG_INFO("[proxy] [stream-upgrade]", "uri={}", upstream_uri);
         }
 
         removeHeaderPairLoose(headers, "Connection");
@@ -1360,32 +2429,32 @@ HttpRouteHandler HttpRouter::createProxyHandler(const std::string& routePrefix,
 
         applyForwardHeaders(conn, headers, original_host);
         removeHeaderPairLoose(headers, "Host");
-        headers.addHeaderPair("Host", upstreamHost + ":" + std::to_string(upstreamPort));
-        headers.addHeaderPair("Connection", effective_mode == ProxyMode::Raw ? "close" : "keep-alive");
 
         req.header().uri() = upstream_uri;
 
+        // 选择上游并取得连接：Http 模式优先复用本调度器的空闲连接，连接失败换下一个上游
+        std::unique_ptr<HttpClient> client;
+        size_t upstream_index = 0;
+        size_t attempt = 0;
+        bool borrowed_from_pool = false;
+        co_await acquireProxyClient(*upstream_group, hash_key, proxy_policy,
+                                    effective_mode == ProxyMode::Http,
+                                    attempt, client, upstream_index, borrowed_from_pool);
+        if (!client) {
+            co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
+                                    "Bad Gateway: connect upstream failed");
+            co_return;
+        }
+
         if (effective_mode == ProxyMode::Raw) {
-            auto client = std::make_unique<HttpClient>();
-            bool connect_ok = false;
-            std::string connect_err;
-            co_await connectProxyUpstream(*client, upstream_connect_url, connect_ok, connect_err);
-            if (!connect_ok) {
-                HTTP_LOG_ERROR("[proxy-raw] [connect-fail]", "error={}", connect_err);
-                co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
-                                        "Bad Gateway: connect upstream failed");
-                co_return;
-            }
+            headers.addHeaderPair("Host", upstream_group->upstreamKey(upstream_index));
+            headers.addHeaderPair("Connection", "close");
 
             auto session_result = client->getSession();
             if (!session_result) {
                 HTTP_LOG_ERROR("[proxy-raw] [session-fail]", "error={}", session_result.error().message());
-                auto close_result = co_await client->close();
-                if (!close_result) {
-                    HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                                  "context=raw-session-fail error={}",
-                                  close_result.error().message());
-                }
+                upstream_group->reportFailure(upstream_index);
+                co_await closeProxyClient(*client, "raw-session-fail");
                 co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
                                         "Bad Gateway: upstream session failed");
                 co_return;
@@ -1407,32 +2476,32 @@ HttpRouteHandler HttpRouter::createProxyHandler(const std::string& routePrefix,
             }
 
             if (!send_ok) {
-                auto close_result = co_await client->close();
-                if (!close_result) {
-                    HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                                  "context=raw-send-fail error={}",
-                                  close_result.error().message());
-                }
+                upstream_group->reportFailure(upstream_index);
+                co_await closeProxyClient(*client, "raw-send-fail");
                 co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
                                         "Bad Gateway: send upstream failed");
                 co_return;
             }
+            upstream_group->reportSuccess(upstream_index);
 
             bool relay_ok = false;
             std::string relay_err;
             auto upstream_socket = client->socket();
             if (!upstream_socket) {
                 HTTP_LOG_ERROR("[proxy-raw] [socket-fail]", "error={}", upstream_socket.error().message());
-                auto close_result = co_await client->close();
-                if (!close_result) {
-                    HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                                  "context=raw-socket-fail error={}",
-                                  close_result.error().message());
-                }
+                co_await closeProxyClient(*client, "raw-socket-fail");
                 co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
                                         "Bad Gateway: upstream socket failed");
                 co_return;
             }
+            // 上游响应直接写入下游 socket，先写出之前流水线请求暂存的响应
+            auto flush_writer = conn.getWriter();
+            auto flush_result = co_await flush_writer.flushPipelined();
+            if (!flush_result) {
+                HTTP_LOG_WARN("[proxy-raw] [flush-fail]", "error={}", flush_result.error().message());
+                co_await closeProxyClient(*client, "raw-flush-fail");
+                co_return;
+            }
             co_await relayRawUpstreamToDownstream(upstream_socket.value().get(),
                                                   conn.getSocket(),
                                                   responseWriteTimeoutFromConn(conn),
@@ -1442,57 +2511,40 @@ HttpRouteHandler HttpRouter::createProxyHandler(const std::string& routePrefix,
                 HTTP_LOG_WARN("[proxy-raw] [relay-fail]", "error={}", relay_err);
             }
 
-            auto close_result = co_await client->close();
-            if (!close_result) {
-                HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                              "context=raw-complete error={}",
-                              close_result.error().message());
-            }
+            co_await closeProxyClient(*client, "raw-complete");
             co_return;
         }
-        
-        auto& pool = g_proxyClientPools[pool_key];
-        std::unique_ptr<HttpClient> client;
-        bool borrowed_from_pool = false;
-        if (!pool.empty()) {
-            client = std::move(pool.back());
-            pool.pop_back();
-            borrowed_from_pool = true;
-        }
-
-        if (!client) {
-            client = std::make_unique<HttpClient>();
-            bool connect_ok = false;
-            std::string connect_err;
-            co_await connectProxyUpstream(*client, upstream_connect_url, connect_ok, connect_err);
-            if (!connect_ok) {
-                HTTP_LOG_ERROR("[proxy] [connect-fail]", "error={}", connect_err);
-                co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
-                                        "Bad Gateway: connect upstream failed");
-                co_return;
-            }
-        }
 
         HttpResponse upstream_response;
-        bool request_ok = false;
         bool retried = false;
+        const bool idempotent = isIdempotentMethod(req.header().method());
+        headers.addHeaderPair("Connection", "keep-alive");
+
+        while (true) {
+            if (!client) {
+                co_await acquireProxyClient(*upstream_group, hash_key, proxy_policy, true,
+                                            attempt, client, upstream_index, borrowed_from_pool);
+                if (!client) {
+                    co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
+                                            "Bad Gateway: connect upstream failed");
+                    co_return;
+                }
+            }
+            removeHeaderPairLoose(headers, "Host");
+            headers.addHeaderPair("Host", upstream_group->upstreamKey(upstream_index));
 
-        while (!request_ok) {
             auto session_result = client->getSession();
             if (!session_result) {
                 HTTP_LOG_ERROR("[proxy] [session-fail]", "error={}", session_result.error().message());
-                auto close_result = co_await client->close();
-                if (!close_result) {
-                    HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                                  "context=session-fail error={}",
-                                  close_result.error().message());
-                }
+                upstream_group->reportFailure(upstream_index);
+                co_await closeProxyClient(*client, "session-fail");
                 co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
                                         "Bad Gateway: upstream session failed");
                 co_return;
             }
             auto& upstream_writer = session_result.value()->getWriter();
             bool send_ok = false;
+            bool wrote_any = false;
             while (true) {
                 auto send_result = co_await upstream_writer.sendRequest(req);
                 if (!send_result) {
@@ -1501,87 +2553,78 @@ HttpRouteHandler HttpRouter::createProxyHandler(const std::string& routePrefix,
                                   send_result.error().message());
                     break;
                 }
+                wrote_any = true;
                 if (send_result.value()) {
                     send_ok = true;
                     break;
                 }
             }
 
-            if (!send_ok) {
-                auto close_result = co_await client->close();
-                if (!close_result) {
-                    HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                                  "context=send-fail error={}",
-                                  close_result.error().message());
-                }
-                if (borrowed_from_pool && !retried) {
-                    retried = true;
-                    borrowed_from_pool = false;
-                    client = std::make_unique<HttpClient>();
-                    bool reconnect_ok = false;
-                    std::string reconnect_err;
-                    co_await connectProxyUpstream(*client, upstream_connect_url, reconnect_ok, reconnect_err);
-                    if (!reconnect_ok) {
-                        HTTP_LOG_ERROR("[proxy] [reconnect-fail]", "error={}", reconnect_err);
-                        co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
-                                                "Bad Gateway: send upstream failed");
-                        co_return;
+            bool recv_ok = false;
+            if (send_ok) {
+                auto& upstream_reader = session_result.value()->getReader();
+                upstream_response.reset();
+                while (true) {
+                    auto recv_result = co_await upstream_reader.getResponse(upstream_response);
+                    if (!recv_result) {
+                        HTTP_LOG_WARN("[proxy] [recv-fail]",
+                                      "error={}",
+                                      recv_result.error().message());
+                        break;
+                    }
+                    if (recv_result.value()) {
+                        recv_ok = true;
+                        break;
                     }
-                    continue;
                 }
-
-                co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
-                                        "Bad Gateway: send upstream failed");
-                co_return;
             }
-
-            auto& upstream_reader = session_result.value()->getReader();
-            upstream_response.reset();
-            bool recv_ok = false;
-            while (true) {
-                auto recv_result = co_await upstream_reader.getResponse(upstream_response);
-                if (!recv_result) {
-                    HTTP_LOG_WARN("[proxy] [recv-fail]",
-                                  "error={}",
-                                  recv_result.error().message());
-                    break;
-                }
-                if (recv_result.value()) {
-                    recv_ok = true;
-                    break;
-                }
+            if (recv_ok) {
+                break;
             }
 
-            if (!recv_ok) {
-                auto close_result = co_await client->close();
-                if (!close_result) {
-                    HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                                  "context=recv-fail error={}",
-                                  close_result.error().message());
-                }
-                if (borrowed_from_pool && !retried) {
-                    retried = true;
-                    borrowed_from_pool = false;
-                    client = std::make_unique<HttpClient>();
-                    bool reconnect_ok = false;
-                    std::string reconnect_err;
-                    co_await connectProxyUpstream(*client, upstream_connect_url, reconnect_ok, reconnect_err);
-                    if (!reconnect_ok) {
-                        HTTP_LOG_ERROR("[proxy] [reconnect-fail]", "error={}", reconnect_err);
-                        co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
-                                                "Bad Gateway: recv upstream failed");
-                        co_return;
-                    }
-                    continue;
+            if (send_ok) {
+                co_await closeProxyClient(*client, "recv-fail");
+            } else {
+                co_await closeProxyClient(*client, "send-fail");
+            }
+            client.reset();
+
+            // 池中连接可能已被上游按空闲超时关闭：先对同一上游新建连接重试一次，
+            // 新建连接也失败才计入失败并换下一个上游。非幂等请求只在一个字节都没写出时重发，
+            // 否则上游可能已经执行过它
+            const bool may_resend = idempotent || !wrote_any;
+            if (borrowed_from_pool && !retried && may_resend && proxy_policy.retry_stale_pooled_connection) {
+                retried = true;
+                borrowed_from_pool = false;
+                auto fresh = std::make_unique<HttpClient>();
+                const std::string reconnect_url = buildUpstreamConnectUrl(upstream_group->upstream(upstream_index));
+                bool reconnect_ok = false;
+                std::string reconnect_err;
+                co_await connectProxyUpstream(*fresh, reconnect_url, reconnect_ok, reconnect_err);
+                if (reconnect_ok) {
+                    client = std::move(fresh);
+                } else {
+                    HTTP_LOG_ERROR("[proxy] [reconnect-fail]",
+                                   "upstream={} error={}",
+                                   upstream_group->upstreamKey(upstream_index),
+                                   reconnect_err);
+                    upstream_group->reportFailure(upstream_index);
                 }
+                continue;
+            }
 
+            // 请求可能已被上游处理，不再转发给其它上游
+            upstream_group->reportFailure(upstream_index);
+            if (send_ok) {
                 co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
                                         "Bad Gateway: recv upstream failed");
-                co_return;
+            } else {
+                co_await sendProxyError(conn, HttpStatusCode::BadGateway_502,
+                                        "Bad Gateway: send upstream failed");
             }
-
-            request_ok = true;
+            co_return;
         }
+        upstream_group->reportSuccess(upstream_index);
 
         auto downstream_writer = conn.getWriter();
         bool downstream_ok = false;
@@ -1604,24 +2647,14 @@ HttpRouteHandler HttpRouter::createProxyHandler(const std::string& routePrefix,
                              !upstream_response.header().isConnectionClose();
 
         if (keep_upstream) {
-            auto& idle = g_proxyClientPools[pool_key];
-            if (idle.size() < kProxyMaxIdleConnectionsPerUpstream) {
-                idle.push_back(std::move(client));
-            } else if (client) {
-                auto close_result = co_await client->close();
-                if (!close_result) {
-                    HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                                  "context=pool-full error={}",
-                                  close_result.error().message());
-                }
-            }
-        } else if (client) {
-            auto close_result = co_await client->close();
-            if (!close_result) {
-                HTTP_LOG_WARN("[proxy] [client-close-fail]",
-                              "context=not-keepalive error={}",
-                              close_result.error().message());
+            auto& idle = g_proxyClientPools[upstream_group->upstreamKey(upstream_index)];
+            if (idle.size() < proxy_policy.max_idle_connections_per_upstream) {
+                idle.push_back(ProxyIdleClient{std::move(client), std::chrono::steady_clock::now()});
+            } else {
+                co_await closeProxyClient(*client, "pool-full");
             }
+        } else {
+            co_await closeProxyClient(*client, "not-keepalive");
         }
 
         co_return;
@@ -1635,50 +2668,30 @@ Task<void> HttpRouter::sendFileContent(HttpConn& conn,
                                        const std::string& filePath,
                                        size_t fileSize,
                                        const std::string& mimeType,
-                                       const StaticFileSetting& config)
+                                       const StaticFileSetting& config,
+                                       StaticFileCache::EntryPtr cached,
+                                       std::shared_ptr<CompressedVariantCache> variants)
 {
-    // 生成稳定 ETag（mtime + size + inode/路径哈希）
-    namespace fs = std::filesystem;
+    // 生成稳定 ETag（mtime + size + inode/路径哈希）；缓存条目里已有现成结果
+    const bool enableEtag = config.isEnableETag();
     std::time_t lastModified = 0;
-#ifdef _WIN32
-    {
-        std::error_code ec;
-        auto ftime = fs::last_write_time(filePath, ec);
-        if (!ec) {
-            auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-                ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
-            );
-            lastModified = std::chrono::system_clock::to_time_t(sctp);
-        }
-    }
-#else
-    struct stat st;
-    if (stat(filePath.c_str(), &st) == 0) {
-        lastModified = st.st_mtime;
+    std::string etag;
+    std::string lastModifiedStr;
+    if (cached) {
+        lastModified = cached->lastModifiedTime;
+        etag = cached->etag;
+        lastModifiedStr = cached->lastModified;
     } else {
-        std::error_code ec;
-        auto ftime = fs::last_write_time(filePath, ec);
-        if (!ec) {
-            auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-                ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
-            );
-            lastModified = std::chrono::system_clock::to_time_t(sctp);
+        lastModified = resolveLastModified(filePath);
+        if (enableEtag) {
+            etag = ETagGenerator::generateStrong(filePath, fileSize, lastModified);
         }
-    }
-#endif
-    if (lastModified == 0) {
-        // fallback: 使用当前时间，避免空值
-        lastModified = std::time(nullptr);
+        lastModifiedStr = ETagGenerator::formatHttpDate(lastModified);
     }
 
-    const bool enableEtag = config.isEnableETag();
-    std::string etag;
-    if (enableEtag) {
-        etag = ETagGenerator::generateStrong(filePath, fileSize, lastModified);
-    }
-    std::string lastModifiedStr = ETagGenerator::formatHttpDate(lastModified);
-
     auto writer = conn.getWriter();
+    // 静态文件按 StaticFileSetting 自行选择编码，不叠加连接级的动态响应压缩
+    writer.disableCompression();
     const bool isHeadRequest = req.header().method() == HttpMethod::HEAD;
 
     // 1. 处理 If-Match (前置条件)
@@ -1696,15 +2709,54 @@ Task<void> HttpRouter::sendFileContent(HttpConn& conn,
         co_return;
     }
 
-    // 2. 处理 If-None-Match (ETag 条件请求)
+    // 2. 内容编码协商：只作用于不带 Range 的完整请求；编码后的表示使用各自的 ETag
+    const std::string identityEtag = etag;
+    bool varyAcceptEncoding = false;
+    std::optional<PrecompressedSibling> sibling;
+    HttpContentCoding variantCoding = HttpContentCoding::Identity;
+    std::string variantKey;
+    if (config.isContentCodingEnabled() && !req.header().headerPairs().hasKey("Range")) {
+        const std::string acceptEncoding = req.header().headerPairs().getValue("Accept-Encoding");
+        if (config.isEnablePrecompressed()) {
+            sibling = selectPrecompressedSibling(filePath, lastModified, acceptEncoding, varyAcceptEncoding);
+        }
+        if (!sibling && variants &&
+            fileSize >= config.getCompression().getMinLength() &&
+            fileSize <= config.getMaxCompressSize() &&
+            isCompressibleMimeType(mimeType)) {
+            varyAcceptEncoding = true;
+            variantCoding = negotiateContentCoding(acceptEncoding, config.getCompression());
+        }
+        if (sibling) {
+            if (enableEtag) {
+                etag = ETagGenerator::generateStrong(sibling->path, sibling->size, sibling->lastModified);
+            }
+        } else if (variantCoding != HttpContentCoding::Identity) {
+            // 变体缓存键总是基于强 ETag，与是否对外发送 ETag 无关
+            std::string strongEtag = etag;
+            if (strongEtag.empty()) {
+                strongEtag = ETagGenerator::generateStrong(filePath, fileSize, lastModified);
+            }
+            variantKey = CompressedVariantCache::makeKey(variantCoding, strongEtag);
+            if (enableEtag) {
+                etag = "W/" + identityEtag;
+            }
+        }
+    }
+
+    // 3. 处理 If-None-Match (ETag 条件请求)
     std::string ifNoneMatch = req.header().headerPairs().getValue("If-None-Match");
     if (enableEtag && ETagGenerator::matchIfNoneMatch(etag, ifNoneMatch)) {
         // ETag 匹配，返回 304 Not Modified
-        auto response = Http1_1ResponseBuilder()
+        Http1_1ResponseBuilder notModifiedBuilder;
+        notModifiedBuilder
             .status(HttpStatusCode::NotModified_304)
             .header("ETag", etag)
-            .header("Last-Modified", lastModifiedStr)
-            .buildMove();
+            .header("Last-Modified", lastModifiedStr);
+        if (varyAcceptEncoding) {
+            notModifiedBuilder.header("Vary", "Accept-Encoding");
+        }
+        auto response = notModifiedBuilder.buildMove();
         while (true) {
             auto send_result = co_await writer.sendResponse(response);
             if (!send_result || send_result.value()) break;
@@ -1712,7 +2764,7 @@ Task<void> HttpRouter::sendFileContent(HttpConn& conn,
         co_return;
     }
 
-    // 3. 处理 Range 请求
+    // 4. 处理 Range 请求
     std::string rangeHeader = req.header().headerPairs().getValue("Range");
     bool hasRange = !rangeHeader.empty();
     RangeParseResult rangeResult;
@@ -1721,7 +2773,7 @@ Task<void> HttpRouter::sendFileContent(HttpConn& conn,
         // 解析 Range 请求
         rangeResult = HttpRangeParser::parse(rangeHeader, fileSize);
 
-        // 3. 处理 If-Range 条件请求
+        // 处理 If-Range 条件请求
         std::string ifRangeHeader = req.header().headerPairs().getValue("If-Range");
         if (!ifRangeHeader.empty()) {
             // 检查 If-Range 条件
@@ -1758,12 +2810,12 @@ Task<void> HttpRouter::sendFileContent(HttpConn& conn,
         }
     }
 
-    // 4. 根据是否有 Range 请求决定响应方式
+    // 5. 根据是否有 Range 请求决定响应方式
     if (hasRange && rangeResult.isValid()) {
         // 处理 Range 请求
         if (rangeResult.type == RangeType::SINGLE_RANGE) {
             // 单范围请求
-            co_await sendSingleRange(conn, req, filePath, fileSize, mimeType, etag, lastModifiedStr, rangeResult.ranges[0], config);
+            co_await sendSingleRange(conn, req, filePath, fileSize, mimeType, etag, lastModifiedStr, rangeResult.ranges[0], config, cached);
         } else if (rangeResult.type == RangeType::MULTIPLE_RANGES) {
             // 多范围请求 (multipart/byteranges)
             co_await sendMultipleRanges(conn, req, filePath, fileSize, mimeType, etag, lastModifiedStr, rangeResult, config);
@@ -1771,7 +2823,132 @@ Task<void> HttpRouter::sendFileContent(HttpConn& conn,
         co_return;
     }
 
-    // 5. 发送完整文件（无 Range 请求或 Range 无效）
+    // 6. 预压缩的同名文件：以 sendfile 发送，不经过内存
+    if (sibling) {
+        Http1_1ResponseBuilder siblingBuilder;
+        siblingBuilder
+            .status(HttpStatusCode::OK_200)
+            .header("Content-Type", mimeType)
+            .header("Content-Encoding", std::string(contentCodingToken(sibling->coding)))
+            .header("Content-Length", std::to_string(sibling->size))
+            .header("Last-Modified", lastModifiedStr)
+            .header("Vary", "Accept-Encoding");
+        if (enableEtag) {
+            siblingBuilder.header("ETag", etag);
+        }
+        auto siblingResponse = siblingBuilder.buildMove();
+        HttpResponseHeader header = siblingResponse.header().clone();
+        while (true) {
+            auto result = co_await writer.sendHeader(header);
+            if (!result) {
+                HTTP_LOG_ERROR("[send] [precompressed-header-fail]",
+                               "error={}",
+                               result.error().message());
+                co_return;
+            }
+            if (result.value()) {
+                break;
+            }
+        }
+        if (isHeadRequest) {
+            co_return;
+        }
+
+        FileDescriptor fd;
+        auto open_result = fd.open(sibling->path.c_str(), O_RDONLY);
+        if (!open_result) {
+            HTTP_LOG_ERROR("[file] [open-fail] [precompressed]",
+                           "path={} error={}",
+                           sibling->path,
+                           open_result.error().message());
+            co_return;
+        }
+        off_t offset = 0;
+        size_t remaining = sibling->size;
+        const size_t sendfileChunkSize = config.getSendFileChunkSize();
+        const auto response_write_timeout = responseWriteTimeoutFromConn(conn);
+        while (remaining > 0) {
+            const size_t toSend = std::min(remaining, sendfileChunkSize);
+            auto result = co_await conn.socket().sendfile(fd.get(), offset, toSend)
+                .timeout(response_write_timeout);
+            if (!result) {
+                HTTP_LOG_ERROR("[sendfile] [fail]",
+                               "error={}",
+                               result.error().message());
+                break;
+            }
+            const size_t sent = result.value();
+            if (sent == 0) {
+                HTTP_LOG_WARN("[sendfile] [zero]", "file={}", sibling->path);
+                break;
+            }
+            offset += sent;
+            remaining -= sent;
+        }
+        co_return;
+    }
+
+    // 7. 即时压缩：变体缓存未命中时在 blocking executor 上压缩，失败则按 identity 发送
+    if (variantCoding != HttpContentCoding::Identity) {
+        CompressedVariantCache::BodyPtr encoded = variants->find(variantKey);
+        if (!encoded) {
+            const int level = config.getCompression().levelFor(variantCoding);
+            auto loaded = co_await loadCompressedVariant(*variants, variantKey, filePath, fileSize,
+                                                         cached, variantCoding, level);
+            if (loaded.has_value()) {
+                encoded = std::move(loaded.value());
+            }
+        }
+        if (encoded) {
+            Http1_1ResponseBuilder variantBuilder;
+            variantBuilder
+                .status(HttpStatusCode::OK_200)
+                .header("Content-Type", mimeType)
+                .header("Content-Encoding", std::string(contentCodingToken(variantCoding)))
+                .header("Content-Length", std::to_string(encoded->size()))
+                .header("Last-Modified", lastModifiedStr)
+                .header("Vary", "Accept-Encoding");
+            if (enableEtag) {
+                variantBuilder.header("ETag", etag);
+            }
+            auto variantResponse = variantBuilder.buildMove();
+            const std::string head = variantResponse.header().toString();
+            std::string_view body;
+            if (!isHeadRequest) {
+                body = *encoded;
+            }
+            auto result = co_await writer.sendViews(head, body);
+            if (!result) {
+                HTTP_LOG_ERROR("[send] [compressed-fail]",
+                               "file={} error={}",
+                               filePath,
+                               result.error().message());
+            }
+            co_return;
+        }
+        etag = identityEtag;
+    }
+
+    // 8. 缓存命中：预渲染响应头与文件内容一次 writev 发出
+    if (cached) {
+        const std::string_view body = isHeadRequest ? std::string_view() : std::string_view(cached->body);
+        std::string varyHeader;
+        std::string_view head = cached->header;
+        if (varyAcceptEncoding) {
+            varyHeader = withVaryAcceptEncoding(cached->header);
+            head = varyHeader;
+        }
+        auto result = co_await writer.sendViews(head, body);
+        if (!result) {
+            HTTP_LOG_ERROR("[send] [cached-fail]",
+                           "file={} error={}",
+                           filePath,
+                           result.error().message());
+        }
+        co_return;
+    }
+
+    // 9. 发送完整文件（无 Range 请求或 Range 无效）
     // 根据配置决定传输模式
     FileTransferMode mode = config.decideTransferMode(fileSize);
     // 构建响应头
@@ -1784,6 +2961,9 @@ Task<void> HttpRouter::sendFileContent(HttpConn& conn,
     if (enableEtag) {
         responseBuilder.header("ETag", etag);
     }
+    if (varyAcceptEncoding) {
+        responseBuilder.header("Vary", "Accept-Encoding");
+    }
     auto response = responseBuilder.buildMove();
     HTTP_LOG_DEBUG("[send]",
                    "file={} size={} mode={}",
@@ -2073,7 +3253,8 @@ Task<void> HttpRouter::sendSingleRange(HttpConn& conn,
                                        const std::string& etag,
                                        const std::string& lastModified,
                                        const HttpRange& range,
-                                       const StaticFileSetting& config)
+                                       const StaticFileSetting& config,
+                                       StaticFileCache::EntryPtr cached)
 {
     auto writer = conn.getWriter();
 
@@ -2091,6 +3272,22 @@ Task<void> HttpRouter::sendSingleRange(HttpConn& conn,
     }
     auto response = responseBuilder.buildMove();
 
+    if (cached) {
+        // 范围内容直接引用缓存条目，与响应头一起 writev
+        const std::string head = response.header().toString();
+        const std::string_view body = req.header().method() == HttpMethod::HEAD
+            ? std::string_view()
+            : std::string_view(cached->body).substr(range.start, range.length);
+        auto result = co_await writer.sendViews(head, body);
+        if (!result) {
+            HTTP_LOG_ERROR("[send] [cached-range-fail]",
+                           "file={} error={}",
+                           filePath,
+                           result.error().message());
+        }
+        co_return;
+    }
+
     // 发送响应头
     HttpResponseHeader header = response.header().clone();
     auto headerResult = co_await writer.sendHeader(std::move(header));
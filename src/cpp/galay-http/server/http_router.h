@@ -6,6 +6,7 @@
  *
  * @details 提供基于 HTTP 方法和路径的路由功能，使用混合策略：
  *          精确匹配（unordered_map，O(1)）和模糊匹配（Trie 树，O(k)）。
+ *          注册完成后可调用 freeze() 把整张路由表编译为连续数组上的压缩基数树。
  *          支持路径参数、通配符、静态文件挂载和反向代理。
  */
 
@@ -16,6 +17,9 @@
 #include "file_settings.h"
 #include "http_policy.h"
 #include "http_range.h"
+#include "compressed_variant_cache.h"
+#include "proxy_upstream.h"
+#include "static_file_cache.h"
 #include "../protoc/http_request.h"
 #include "../protoc/http_base.h"
 #include "../../galay-kernel/core/task.h"
@@ -26,6 +30,8 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <optional>
 
@@ -55,6 +61,18 @@ enum class ProxyMode
     Raw   ///< 原始字节流回包透传（更适合流式响应）
 };
 
+/**
+ * @brief CONNECT 隧道配置
+ * @details 目标须同时满足 allowedHosts 与 allowedPorts；列表为空表示该项不限制。
+ *          默认只放行 443 端口，避免被当作任意端口的开放代理。
+ */
+struct ConnectTunnelSetting
+{
+    std::vector<std::string> allowedHosts;      ///< 允许的目标主机（精确匹配，不区分大小写）；为空表示不限
+    std::vector<uint16_t> allowedPorts = {443}; ///< 允许的目标端口；为空表示不限
+    std::chrono::milliseconds writeTimeout{-1}; ///< 隧道单次写超时；<=0 表示不限
+};
+
 /**
  * @brief 路由匹配结果
  */
@@ -77,6 +95,53 @@ struct RouteTrieNode
     bool isWildcard = false;                                                    ///< 是否为通配符节点（*）
 };
 
+/**
+ * @brief 冻结路由表节点（压缩基数树，字节级边标签）
+ * @details 节点的全部子节点在 FrozenRouteTable::nodes 中连续存放：
+ *          先是按标签首字节升序的静态子节点，随后依次是存在的
+ *          `:param`、`*`、`**` 子节点（标签为空）。
+ */
+struct FrozenRouteNode
+{
+    static constexpr uint32_t kNone = 0xffffffffu;
+
+    static constexpr uint8_t kHasParam = 0x01;     ///< 存在 `:param` 子节点
+    static constexpr uint8_t kHasWildcard = 0x02;  ///< 存在 `*` 子节点
+    static constexpr uint8_t kHasGreedy = 0x04;    ///< 存在 `**` 子节点
+
+    static constexpr uint8_t kTerminalNone = 0;    ///< 非路径终点
+    static constexpr uint8_t kTerminalExact = 1;   ///< 精确路由终点（请求路径需为规范形式）
+    static constexpr uint8_t kTerminalFuzzy = 2;   ///< 模糊路由终点
+
+    uint32_t labelOffset = 0;          ///< 边标签在 FrozenRouteTable::labels 中的偏移
+    uint16_t labelLength = 0;          ///< 边标签字节数
+    uint16_t staticCount = 0;          ///< 静态子节点数
+    uint32_t firstChild = kNone;       ///< 首个子节点下标
+    uint32_t handler = kNone;          ///< 处理器在 FrozenRouteTable::handlers 中的下标
+    uint32_t paramNameOffset = 0;      ///< 参数名在 FrozenRouteTable::paramNames 中的偏移
+    uint16_t paramNameCount = 0;       ///< 参数名个数
+    uint8_t flags = 0;                 ///< kHas* 位
+    uint8_t terminal = kTerminalNone;  ///< 终点类型
+};
+
+/**
+ * @brief 冻结路由表
+ * @details 所有方法的节点共用一个数组，按方法记录根节点；firstBytes 与 nodes
+ *          一一对应，保存每个节点标签的首字节，使静态子节点分派只扫描一段连续字节。
+ */
+struct FrozenRouteTable
+{
+    static constexpr size_t kMethodSlots = static_cast<size_t>(HttpMethod::UNKNOWN) + 1;
+
+    std::vector<FrozenRouteNode> nodes;            ///< 全部节点
+    std::vector<char> firstBytes;                  ///< 各节点标签首字节
+    std::string labels;                            ///< 全部边标签拼接
+    std::vector<std::string> paramNames;           ///< 各终点的参数名序列拼接
+    std::vector<HttpRouteHandler*> handlers;       ///< 处理器指针（指向原路由表中的对象）
+    std::array<uint32_t, kMethodSlots> roots{};    ///< 方法 -> 根节点下标，kNone 表示无路由
+    bool rawExactFallback = false;                 ///< 是否存在非规范形式的精确路由，需要回查原表
+};
+
 /**
  * @brief HTTP路由器类（Drogon策略实现）
  * @details 提供基于HTTP方法和路径的路由功能，使用混合策略：
@@ -136,6 +201,39 @@ public:
      */
     RouteMatch findHandler(HttpMethod method, const std::string& path);
 
+    /**
+     * @brief 查找路由处理器，把路径参数就地写入调用方持有的容器
+     * @param method HTTP方法
+     * @param path 请求路径；只在本次调用内借用
+     * @param params 输出参数：先清空再写入，已分配的字符串容量会被复用
+     * @return 处理函数指针，未找到返回nullptr
+     * @details 冻结后匹配过程不分配内存（参数值超过 std::string SSO 长度且容器
+     *          容量不足时除外）；未冻结时走 Trie 路径。
+     */
+    HttpRouteHandler* findHandler(HttpMethod method, std::string_view path, RouteParams& params);
+
+    /**
+     * @brief 把当前路由表编译为只读的压缩基数树
+     * @return 编译成功返回 true；存在参数个数超过 kMaxFrozenRouteParams 的路由时返回 false，
+     *         此时保持未冻结状态，查找继续走 Trie
+     * @details 精确路由与模糊路由合并到同一棵按字节分支的基数树中，节点存放在一个
+     *          连续数组里，`:param` / `*` / `**` 子节点紧跟在静态子节点之后。
+     *          匹配优先级与未冻结时一致：精确 > 静态段 > `:param` > `*` > `**`。
+     *          addHandler / delHandler / clear / mount 等修改路由的操作会自动解冻，
+     *          需要时重新调用 freeze()。HttpServer::start(HttpRouter&&) 会自动冻结。
+     */
+    bool freeze();
+
+    /**
+     * @brief 是否处于冻结状态
+     * @return 冻结表生效时返回 true
+     */
+    bool isFrozen() const {
+        return m_frozen.has_value();
+    }
+
+    static constexpr size_t kMaxFrozenRouteParams = 32; ///< 冻结表单条路由支持的最大参数个数
+
     /**
      * @brief 移除路由处理器
      * @param method HTTP方法
@@ -186,6 +284,14 @@ public:
      *          - CHUNK: 使用 HTTP chunked 编码分块传输（适合中等文件）
      *          - SENDFILE: 使用零拷贝 sendfile 系统调用（适合大文件）
      *          - AUTO: 根据文件大小自动选择（默认）
+     *
+     *          setting.setEnableCache(true) 时本次挂载共享一个按 getMaxCacheSize() 限容的
+     *          内存缓存：非 SENDFILE 模式的文件首次访问后缓存内容与预渲染响应头，
+     *          之后的请求（含单范围请求）不再访问文件系统；文件变更由 inotify 监听自动失效。
+     *
+     *          setting.setEnablePrecompressed(true) 时完整请求优先发送 "<file>.zst" / "<file>.gz"；
+     *          setting.setCompression(...) 启用后，没有预压缩文件的可压缩类型会被即时压缩，
+     *          结果按 ETag 存入本次挂载共享的压缩变体缓存。两者都会附加 Vary: Accept-Encoding。
      */
     void mount(const std::string& routePrefix, const std::string& dirPath,
                const StaticFileSetting& setting = StaticFileSetting());
@@ -199,11 +305,27 @@ public:
      *          例如：mountHardly("/static", "./public")
      *          会为 ./public 下的所有文件创建精确路由
      *
-     *          支持三种传输模式（同 mount）
+     *          支持三种传输模式与文件缓存（同 mount）
      */
     void mountHardly(const std::string& routePrefix, const std::string& dirPath,
                      const StaticFileSetting& setting = StaticFileSetting());
 
+    /**
+     * @brief 获取启用了缓存的挂载所创建的文件缓存
+     * @return 每次启用缓存的 mount / mountHardly / tryFiles 对应一个缓存，可用于读取命中统计
+     */
+    std::vector<std::shared_ptr<const StaticFileCache>> staticFileCaches() const {
+        return {m_staticFileCaches.begin(), m_staticFileCaches.end()};
+    }
+
+    /**
+     * @brief 获取启用了即时压缩的挂载所创建的压缩变体缓存
+     * @return 每次启用即时压缩的 mount / mountHardly / tryFiles 对应一个缓存，可用于读取命中统计
+     */
+    std::vector<std::shared_ptr<const CompressedVariantCache>> compressedVariantCaches() const {
+        return {m_compressedVariantCaches.begin(), m_compressedVariantCaches.end()};
+    }
+
     /**
      * @brief Nginx 风格 try_files（静态命中优先，未命中回源代理）
      * @param routePrefix 路由前缀，例如 "/static"
@@ -238,9 +360,37 @@ public:
                uint16_t upstreamPort,
                ProxyMode mode = ProxyMode::Http);
 
+    /**
+     * @brief 挂载多上游反向代理路由
+     * @param routePrefix 路由前缀，例如 "/api" 或 "/"（全量代理）
+     * @param upstreams 上游列表（不可为空）
+     * @param setting 负载均衡策略与被动健康检查配置
+     * @param mode
+     * @details 每个请求按 setting.strategy 选择上游；连接失败会换下一个上游重试，
+     *          连续失败 setting.maxFails 次的上游被摘除 setting.failTimeout 后再探测。
+     *          Http 模式下每个 IO 调度器为每个上游维护独立的 keep-alive 空闲连接池，
+     *          容量与保留时长取自挂载时的 defaultPolicy().proxy。
+     *          例如：proxy("/api", {{"10.0.0.1", 8080}, {"10.0.0.2", 8080}})
+     */
+    void proxy(const std::string& routePrefix,
+               std::vector<ProxyUpstream> upstreams,
+               const ProxyUpstreamSetting& setting = ProxyUpstreamSetting(),
+               ProxyMode mode = ProxyMode::Http);
+
+    /**
+     * @brief 启用 HTTP CONNECT 隧道（正向代理）
+     * @param setting 目标白名单与写超时
+     * @details 未命中本地路由的 CONNECT host:port 请求会连接目标，回复
+     *          "200 Connection Established" 后在客户端与目标之间双向透传字节流，
+     *          转发走 galay::async::spliceTunnel（Linux 上为 splice 零拷贝）。
+     *          目标不在白名单返回 403，连接失败返回 502；隧道结束后关闭客户端连接。
+     */
+    void connectTunnel(const ConnectTunnelSetting& setting = ConnectTunnelSetting());
+
 private:
     bool hasFallbackProxy() const;
     HttpRouteHandler* fallbackProxyHandler();
+    HttpRouteHandler* connectTunnelHandler();
 
     /**
      * @brief 内部添加路由处理器的实现
@@ -308,6 +458,15 @@ private:
                                                std::vector<std::string_view>& paramValues,
                                                RouteParams& params);
 
+    /**
+     * @brief 在冻结表中查找路由
+     * @param method HTTP方法
+     * @param path 请求路径
+     * @param params 输出参数：提取的路径参数
+     * @return 处理函数指针，未找到返回nullptr
+     */
+    HttpRouteHandler* searchFrozen(HttpMethod method, std::string_view path, RouteParams& params);
+
     /**
      * @brief 创建静态文件服务处理器（动态查找）
      * @param routePrefix 路由前缀
@@ -326,33 +485,48 @@ private:
      * @param dirPath 文件系统目录路径
      * @param config 静态文件传输配置
      * @param currentPath 当前遍历的相对路径
+     * @param cache 本次挂载共享的文件缓存，未启用缓存时为空
+     * @param variants 本次挂载共享的压缩变体缓存，未启用即时压缩时为空
      */
     void registerFilesRecursively(const std::string& routePrefix,
                                    const std::string& dirPath,
                                    const StaticFileSetting& config,
-                                   const std::string& currentPath = "");
+                                   const std::string& currentPath = "",
+                                   const std::shared_ptr<StaticFileCache>& cache = nullptr,
+                                   const std::shared_ptr<CompressedVariantCache>& variants = nullptr);
 
     /**
      * @brief 创建单个文件的处理器
      * @param filePath 文件完整路径
      * @param config 静态文件传输配置
+     * @param cache 本次挂载共享的文件缓存，未启用缓存时为空
+     * @param variants 本次挂载共享的压缩变体缓存，未启用即时压缩时为空
      * @return 处理函数
      */
     HttpRouteHandler createSingleFileHandler(const std::string& filePath,
-                                             const StaticFileSetting& config);
+                                             const StaticFileSetting& config,
+                                             std::shared_ptr<StaticFileCache> cache = nullptr,
+                                             std::shared_ptr<CompressedVariantCache> variants = nullptr);
 
     /**
      * @brief 创建反向代理处理器
      * @param routePrefix 路由前缀
-     * @param upstreamHost 上游主机
-     * @param upstreamPort 上游端口
+     * @param group 上游组（同一前缀的各处理器共享）
+     * @param policy 连接池策略
      * @return 处理函数
      */
     HttpRouteHandler createProxyHandler(const std::string& routePrefix,
-                                        const std::string& upstreamHost,
-                                        uint16_t upstreamPort,
+                                        std::shared_ptr<ProxyUpstreamGroup> group,
+                                        const HttpProxyPolicy& policy,
                                         ProxyMode mode);
 
+    /**
+     * @brief 创建 CONNECT 隧道处理器
+     * @param setting 隧道配置
+     * @return 处理函数
+     */
+    HttpRouteHandler createConnectTunnelHandler(const ConnectTunnelSetting& setting);
+
     /**
      * @brief 发送文件内容（根据配置选择传输方式）
      * @param conn HTTP连接
@@ -361,6 +535,8 @@ private:
      * @param fileSize 文件大小
      * @param mimeType MIME类型
      * @param config 静态文件传输配置
+     * @param cached 缓存条目；非空时直接用其中的内容与预渲染响应头，不再访问文件系统
+     * @param variants 压缩变体缓存；非空时可压缩类型按协商结果即时压缩
      * @return 协程
      */
     static Task<void> sendFileContent(HttpConn& conn,
@@ -368,7 +544,9 @@ private:
                                       const std::string& filePath,
                                       size_t fileSize,
                                       const std::string& mimeType,
-                                      const StaticFileSetting& config);
+                                      const StaticFileSetting& config,
+                                      StaticFileCache::EntryPtr cached = nullptr,
+                                      std::shared_ptr<CompressedVariantCache> variants = nullptr);
 
     /**
      * @brief 发送单个 Range 响应（206 Partial Content）
@@ -381,6 +559,7 @@ private:
      * @param lastModified 最后修改时间
      * @param range Range 范围
      * @param config 静态文件传输配置
+     * @param cached 缓存条目；非空时范围内容直接取自缓存，与响应头一次 writev 发出
      * @return 协程
      */
     static Task<void> sendSingleRange(HttpConn& conn,
@@ -391,7 +570,8 @@ private:
                                       const std::string& etag,
                                       const std::string& lastModified,
                                       const HttpRange& range,
-                                      const StaticFileSetting& config);
+                                      const StaticFileSetting& config,
+                                      StaticFileCache::EntryPtr cached = nullptr);
 
     /**
      * @brief 发送多个 Range 响应（206 Partial Content with multipart/byteranges）
@@ -425,12 +605,24 @@ private:
     // 使用 Trie树 实现 O(k) 查找（k为路径段数）
     std::unordered_map<HttpMethod, std::unique_ptr<RouteTrieNode>> m_fuzzyRoutes;
 
+    // 冻结后的压缩基数树；修改路由时清空
+    std::optional<FrozenRouteTable> m_frozen;
+
     // 动态挂载的目录映射：路由前缀 -> 文件系统目录路径
     std::unordered_map<std::string, std::string> m_mountedDirs;
 
+    // 启用缓存的挂载所创建的文件缓存（处理器各自持有一份引用）
+    std::vector<std::shared_ptr<StaticFileCache>> m_staticFileCaches;
+
+    // 启用即时压缩的挂载所创建的压缩变体缓存
+    std::vector<std::shared_ptr<CompressedVariantCache>> m_compressedVariantCaches;
+
     // 默认回退代理（本地路由 miss 或 mount 文件未命中时使用）
     std::shared_ptr<std::optional<HttpRouteHandler>> m_fallbackProxyHandlerState;
 
+    // CONNECT 隧道处理器（connectTunnel() 启用后存在）
+    std::optional<HttpRouteHandler> m_connectTunnelHandler;
+
     // route-mode 默认生产策略；Task 1 只保存，不改变行为
     HttpServerPolicy m_defaultPolicy;
 
@@ -180,13 +180,15 @@ public:
      * @details 框架会负责：
      * - 持续读取 HTTP 请求
      * - 处理 Keep-Alive / Connection: close
-     * - 进行路由匹配和缺省 404 响应
+     * - 冻结路由表（HttpRouter::freeze）后进行路由匹配和缺省 404 响应
      * - 在循环结束后关闭连接
      *
      * 该模式当前仅支持明文 `AsyncTcpSocket` 路由处理；HTTPS 仍应通过显式 handler 控制读写流程。
      */
     void start(HttpRouter&& router) {
         m_router = std::move(router);
+        // 启动后路由表只读，编译为压缩基数树；失败时保持 Trie 查找
+        (void)m_router->freeze();
 
         m_handler = [this](HttpConnImpl<SocketType> conn) -> Task<void> {
             bool keep_alive = true;
@@ -200,9 +202,15 @@ public:
             HttpWriterSetting writer_setting;
             writer_setting.setSendTimeout(
                 static_cast<int>(m_config.policy.timeouts.response_write_timeout.count()));
+            writer_setting.setCompression(m_config.policy.compression);
             conn.setDefaultWriterSetting(writer_setting);
+            const bool compression_enabled = m_config.policy.compression.isEnabled();
+            HttpPipelineBatch& pipeline = conn.pipelineBatch();
+            pipeline.configure(m_config.policy.pipeline.max_depth, m_config.policy.pipeline.max_batch_bytes);
+            const bool pipeline_enabled = m_config.policy.pipeline.enabled && pipeline.maxDepth() > 1;
 
             while (keep_alive) {
+                pipeline.setDeferring(false);
                 const bool waiting_for_initial_request = handled_requests == 0;
                 const auto read_timeout = waiting_for_initial_request
                     ? m_config.policy.timeouts.request_header_timeout
@@ -265,8 +273,40 @@ public:
                 keep_alive = request.header().isKeepAlive() && !request.header().isConnectionClose();
                 ++handled_requests;
 
-                auto [handler, params] = m_router->findHandler(request.header().method(), request.header().uri());
-                request.setRouteParams(std::move(params));
+                // CONNECT 与协议升级之后连接不再承载 HTTP 响应，暂存的响应须在交出 socket 前写出
+                const bool takes_over_socket =
+                    request.header().method() == HttpMethod::CONNECT ||
+                    request.header().headerPairs().hasKey("Upgrade");
+                if (pipeline_enabled) {
+                    pipeline.setDeferring(keep_alive && !takes_over_socket && conn.hasBufferedRequest());
+                }
+                if (takes_over_socket && !pipeline.empty()) {
+                    auto writer = conn.getWriter();
+                    auto flush_result = co_await writer.flushPipelined();
+                    if (!flush_result) {
+                        HTTP_LOG_WARN("[send] [fail]", "code={} msg={}",
+                                      static_cast<int>(flush_result.error().code()),
+                                      flush_result.error().message());
+                        break;
+                    }
+                }
+
+                if (compression_enabled) {
+                    const std::string* accept_encoding =
+                        request.header().headerPairs().getValuePtr("Accept-Encoding");
+                    if (accept_encoding != nullptr) {
+                        conn.setResponseCoding(negotiateContentCoding(*accept_encoding, m_config.policy.compression));
+                    } else {
+                        conn.setResponseCoding(HttpContentCoding::Identity);
+                    }
+                }
+
+                HttpRouteHandler* handler = m_router->findHandler(
+                    request.header().method(), request.header().uri(), request.mutableRouteParams());
+
+                if (!handler && request.header().method() == HttpMethod::CONNECT) {
+                    handler = m_router->connectTunnelHandler();
+                }
 
                 if (!handler && m_router->hasFallbackProxy()) {
                     handler = m_router->fallbackProxyHandler();
@@ -289,6 +329,16 @@ public:
                     if (!keep_alive) {
                         break;
                     }
+                    if (!pipeline.empty() && !conn.hasBufferedRequest()) {
+                        auto flush_writer = conn.getWriter();
+                        auto flush_result = co_await flush_writer.flushPipelined();
+                        if (!flush_result) {
+                            HTTP_LOG_WARN("[send] [fail]", "code={} msg={}",
+                                          static_cast<int>(flush_result.error().code()),
+                                          flush_result.error().message());
+                            break;
+                        }
+                    }
                     continue;
                 }
 
@@ -301,6 +351,27 @@ public:
                 if (!keep_alive) {
                     break;
                 }
+                // 下一个请求尚未完整到达时，读取前写出本批暂存的响应
+                if (!pipeline.empty() && !conn.hasBufferedRequest()) {
+                    auto writer = conn.getWriter();
+                    auto flush_result = co_await writer.flushPipelined();
+                    if (!flush_result) {
+                        HTTP_LOG_WARN("[send] [fail]", "code={} msg={}",
+                                      static_cast<int>(flush_result.error().code()),
+                                      flush_result.error().message());
+                        break;
+                    }
+                }
+            }
+
+            if (!pipeline.empty()) {
+                auto writer = conn.getWriter();
+                auto flush_result = co_await writer.flushPipelined();
+                if (!flush_result) {
+                    HTTP_LOG_WARN("[send] [fail]", "code={} msg={}",
+                                  static_cast<int>(flush_result.error().code()),
+                                  flush_result.error().message());
+                }
             }
 
             auto close_result = co_await conn.close();
@@ -636,6 +707,7 @@ struct HttpsServerConfig
     uint16_t port = 443;                        ///< 监听端口
     bool tcp_no_delay = true;                   ///< 是否为已接受连接启用 TCP_NODELAY
     bool verify_peer = false;                   ///< 是否校验客户端证书
+    bool ktls = false;                          ///< 是否尝试把记录加解密交给内核 TLS（不支持时自动留在用户态）
 };
 
 class HttpsServer;
@@ -673,6 +745,7 @@ public:
     HttpsServerBuilder& caPath(std::string v)            { m_config.ca_path = std::move(v); return *this; } ///< 设置 CA 证书路径
     HttpsServerBuilder& verifyPeer(bool v)               { m_config.verify_peer = v; return *this; } ///< 设置是否校验客户端证书
     HttpsServerBuilder& verifyDepth(int v)               { m_config.verify_depth = v; return *this; } ///< 设置证书链校验深度
+    HttpsServerBuilder& ktls(bool v)                     { m_config.ktls = v; return *this; } ///< 设置是否尝试启用 kTLS
     HttpsServer build() const; ///< 构建 HTTPS 服务器实例
     HttpsServerConfig buildConfig() const                { return m_config; } ///< 导出配置
 private:
@@ -861,6 +934,11 @@ private:
             m_ssl_ctx.setVerifyMode(galay::ssl::SslVerifyMode::None);
         }
 
+        // kTLS 只是加速路径，OpenSSL 不支持时继续使用用户态加解密
+        if (m_https_config.ktls && !m_ssl_ctx.setKtlsEnabled(true)) {
+            HTTP_LOG_WARN("[ssl] [ktls] [unsupported]", "falling back to user-space TLS");
+        }
+
         return true;
     }
 
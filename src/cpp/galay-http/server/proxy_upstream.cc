@@ -0,0 +1,142 @@
+#include "proxy_upstream.h"
+#include <algorithm>
+#include <numeric>
+
+namespace galay::http
+{
+
+ProxyUpstreamGroup::Node::Node(ProxyUpstream value, galay::utils::CircuitBreakerConfig config)
+    : upstream(std::move(value))
+    , key(upstream.host + ":" + std::to_string(upstream.port))
+    , breaker(config)
+{
+}
+
+ProxyUpstreamGroup::ProxyUpstreamGroup(std::vector<ProxyUpstream> upstreams, ProxyUpstreamSetting setting)
+    : m_setting(std::move(setting))
+{
+    galay::utils::CircuitBreakerConfig breaker_config;
+    breaker_config.failureThreshold = m_setting.maxFails;
+    breaker_config.successThreshold = 1;
+    breaker_config.halfOpenMaxRequests = 1;
+    breaker_config.resetTimeout = m_setting.failTimeout;
+
+    std::vector<size_t> indices(upstreams.size());
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    std::vector<uint32_t> weights;
+    weights.reserve(upstreams.size());
+    m_nodes.reserve(upstreams.size());
+    for (auto& upstream : upstreams) {
+        weights.push_back(upstream.weight == 0 ? 1 : upstream.weight);
+        m_nodes.push_back(std::make_unique<Node>(std::move(upstream), breaker_config));
+    }
+
+    switch (m_setting.strategy) {
+        case ProxyBalanceStrategy::RoundRobin:
+            m_roundRobin.emplace(std::move(indices));
+            break;
+        case ProxyBalanceStrategy::Weighted:
+            m_weighted.emplace(std::move(indices), weights);
+            break;
+        case ProxyBalanceStrategy::ConsistentHash:
+            // 虚拟节点键与 galay::utils::ConsistentHash 一致（"<下标>#<序号>"，每权重 150 个），
+            // 映射结果不变；环在此一次建好，选择时只做二分查找
+            for (size_t i = 0; i < m_nodes.size(); ++i) {
+                const size_t vnodes = kVirtualNodesPerWeight * weights[i];
+                for (size_t v = 0; v < vnodes; ++v) {
+                    const std::string virtual_key = std::to_string(i) + "#" + std::to_string(v);
+                    m_ring.push_back({galay::utils::MurmurHash3::hash32(virtual_key), static_cast<uint32_t>(i)});
+                }
+            }
+            // 哈希冲突时后加入的节点覆盖先加入的，与 std::map 版本相同
+            std::stable_sort(m_ring.begin(), m_ring.end(),
+                             [](const RingPoint& a, const RingPoint& b) { return a.hash < b.hash; });
+            m_ring.erase(m_ring.begin(),
+                         std::unique(m_ring.rbegin(), m_ring.rend(),
+                                     [](const RingPoint& a, const RingPoint& b) { return a.hash == b.hash; })
+                             .base());
+            break;
+    }
+}
+
+size_t ProxyUpstreamGroup::pick(std::string_view hashKey, size_t attempt)
+{
+    std::optional<size_t> selected;
+    switch (m_setting.strategy) {
+        case ProxyBalanceStrategy::RoundRobin:
+            selected = m_roundRobin->select();
+            break;
+        case ProxyBalanceStrategy::Weighted: {
+            std::lock_guard<std::mutex> lock(m_weightedMutex);
+            selected = m_weighted->select();
+            break;
+        }
+        case ProxyBalanceStrategy::ConsistentHash:
+            selected = ringPick(hashKey, attempt);
+            break;
+    }
+    return selected.value_or(0);
+}
+
+size_t ProxyUpstreamGroup::ringPick(std::string_view hashKey, size_t attempt) const
+{
+    if (m_ring.empty()) {
+        return 0;
+    }
+    const uint32_t hash = galay::utils::MurmurHash3::hash32(hashKey.data(), hashKey.size());
+    auto it = std::lower_bound(m_ring.begin(), m_ring.end(), hash,
+                               [](const RingPoint& point, uint32_t value) { return point.hash < value; });
+    size_t pos = it == m_ring.end() ? 0 : static_cast<size_t>(it - m_ring.begin());
+    size_t skip = attempt % m_nodes.size();
+    if (skip == 0) {
+        return m_ring[pos].node;
+    }
+
+    // 沿哈希环取第 attempt 个不同节点，重试时不会落回同一个上游
+    thread_local std::vector<uint8_t> seen;
+    seen.assign(m_nodes.size(), 0);
+    for (size_t step = 0; step < m_ring.size(); ++step, pos = (pos + 1 == m_ring.size() ? 0 : pos + 1)) {
+        const uint32_t node = m_ring[pos].node;
+        if (seen[node] != 0) {
+            continue;
+        }
+        if (skip == 0) {
+            return node;
+        }
+        seen[node] = 1;
+        --skip;
+    }
+    return m_ring[pos].node;
+}
+
+std::optional<size_t> ProxyUpstreamGroup::select(std::string_view hashKey, size_t attempt)
+{
+    if (m_nodes.empty()) {
+        return std::nullopt;
+    }
+    for (size_t probe = 0; probe < m_nodes.size(); ++probe) {
+        const size_t index = pick(hashKey, attempt + probe);
+        if (m_nodes[index]->breaker.allowRequest()) {
+            return index;
+        }
+    }
+    // 全部被摘除：仍然转发，由上游的实际状态决定结果
+    return pick(hashKey, attempt);
+}
+
+void ProxyUpstreamGroup::reportSuccess(size_t index)
+{
+    m_nodes[index]->breaker.onSuccess();
+}
+
+void ProxyUpstreamGroup::reportFailure(size_t index)
+{
+    m_nodes[index]->breaker.onFailure();
+}
+
+bool ProxyUpstreamGroup::isEjected(size_t index) const
+{
+    return m_nodes[index]->breaker.state() == galay::utils::CircuitState::Open;
+}
+
+} // namespace galay::http
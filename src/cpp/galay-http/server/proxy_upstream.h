@@ -0,0 +1,143 @@
+/**
+ * @file proxy_upstream.h
+ * @brief 反向代理上游组
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 为 HttpRouter::proxy 提供多上游负载均衡与被动健康检查。
+ *          选择策略复用 galay-utils 的轮询 / 平滑加权轮询负载均衡器与一致性哈希环；
+ *          每个上游挂一个熔断器：连续失败达到阈值后摘除，超时后放行一个探测请求，
+ *          探测成功即恢复。
+ */
+
+#ifndef GALAY_HTTP_PROXY_UPSTREAM_H
+#define GALAY_HTTP_PROXY_UPSTREAM_H
+
+#include "../../galay-utils/algorithm/consistent_hash.hpp"
+#include "../../galay-utils/tool/balancer.hpp"
+#include "../../galay-utils/tool/circuit_breaker.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace galay::http
+{
+
+/**
+ * @brief 上游节点
+ */
+struct ProxyUpstream {
+    std::string host;    ///< 上游主机
+    uint16_t port = 0;   ///< 上游端口
+    uint32_t weight = 1; ///< 权重（仅 Weighted 策略使用）
+};
+
+/**
+ * @brief 上游选择策略
+ */
+enum class ProxyBalanceStrategy
+{
+    RoundRobin,     ///< 轮询
+    Weighted,       ///< 平滑加权轮询
+    ConsistentHash, ///< 按请求头（缺省为客户端 IP）做一致性哈希
+};
+
+/**
+ * @brief 上游组配置
+ * @note 空闲连接池的容量与保留时长取自 HttpProxyPolicy
+ */
+struct ProxyUpstreamSetting {
+    ProxyBalanceStrategy strategy = ProxyBalanceStrategy::RoundRobin; ///< 选择策略
+    std::string hashHeader;                    ///< ConsistentHash 使用的请求头；为空或请求中缺失时使用客户端 IP
+    size_t maxFails = 3;                       ///< 连续失败多少次后摘除上游
+    std::chrono::seconds failTimeout{10};      ///< 摘除后多久放行探测请求
+};
+
+/**
+ * @brief 上游组
+ * @details 线程安全，由同一前缀下的代理处理器在各 IO 调度器间共享。
+ *          select() 跳过已摘除的上游；全部摘除时仍按策略返回一个上游，
+ *          避免瞬时故障把整组流量变成 502。每次 select() 成功都必须以
+ *          reportSuccess() 或 reportFailure() 收尾，以归还半开探测名额。
+ */
+class ProxyUpstreamGroup
+{
+public:
+    /**
+     * @brief 构造上游组
+     * @param upstreams 上游列表（不可为空）
+     * @param setting 组配置
+     */
+    ProxyUpstreamGroup(std::vector<ProxyUpstream> upstreams, ProxyUpstreamSetting setting = ProxyUpstreamSetting());
+
+    ProxyUpstreamGroup(const ProxyUpstreamGroup&) = delete;
+    ProxyUpstreamGroup& operator=(const ProxyUpstreamGroup&) = delete;
+
+    /**
+     * @brief 选择一个上游
+     * @param hashKey ConsistentHash 策略的哈希键，其余策略忽略
+     * @param attempt 同一请求内的第几次选择；ConsistentHash 据此沿哈希环顺延到下一个不同上游
+     * @return 上游下标；组为空时返回 std::nullopt
+     */
+    std::optional<size_t> select(std::string_view hashKey, size_t attempt = 0);
+
+    /**
+     * @brief 报告一次成功（收到完整响应）
+     * @param index 上游下标
+     */
+    void reportSuccess(size_t index);
+
+    /**
+     * @brief 报告一次失败（连接、发送或接收失败）
+     * @param index 上游下标
+     */
+    void reportFailure(size_t index);
+
+    /**
+     * @brief 判断上游当前是否被摘除
+     * @param index 上游下标
+     * @return 熔断打开（尚未进入探测）时返回 true
+     */
+    bool isEjected(size_t index) const;
+
+    const ProxyUpstream& upstream(size_t index) const { return m_nodes[index]->upstream; } ///< 上游节点
+    const std::string& upstreamKey(size_t index) const { return m_nodes[index]->key; }     ///< "host:port"，连接池键
+    size_t size() const noexcept { return m_nodes.size(); }                             ///< 上游数量
+    const ProxyUpstreamSetting& setting() const noexcept { return m_setting; }         ///< 组配置
+
+private:
+    struct Node {
+        ProxyUpstream upstream;
+        std::string key;
+        galay::utils::CircuitBreaker breaker;
+
+        Node(ProxyUpstream value, galay::utils::CircuitBreakerConfig config);
+    };
+
+    struct RingPoint {
+        uint32_t hash; ///< 虚拟节点哈希
+        uint32_t node; ///< 上游下标
+    };
+
+    static constexpr size_t kVirtualNodesPerWeight = 150; ///< 每单位权重的虚拟节点数
+
+    size_t pick(std::string_view hashKey, size_t attempt);
+    size_t ringPick(std::string_view hashKey, size_t attempt) const;
+
+    ProxyUpstreamSetting m_setting;
+    std::vector<std::unique_ptr<Node>> m_nodes;
+    std::optional<galay::utils::RoundRobinLoadBalancer<size_t>> m_roundRobin;
+    std::optional<galay::utils::WeightRoundRobinLoadBalancer<size_t>> m_weighted;
+    std::mutex m_weightedMutex; ///< 平滑加权轮询的状态非线程安全
+    std::vector<RingPoint> m_ring; ///< ConsistentHash 虚拟节点环，构造时按哈希排序，之后只读
+};
+
+} // namespace galay::http
+
+#endif // GALAY_HTTP_PROXY_UPSTREAM_H
@@ -0,0 +1,304 @@
+#include "static_file_cache.h"
+#include <galay/cpp/galay-http/common/http_log.h>
+#include <galay/cpp/galay-kernel/async/async_file_watcher.h>
+#include <galay/cpp/galay-kernel/core/scheduler.hpp>
+#include <galay/cpp/galay-kernel/core/task.h>
+#include <filesystem>
+#include <iterator>
+#include <system_error>
+
+namespace galay::http
+{
+
+using galay::kernel::FileWatchEvent;
+using galay::kernel::Task;
+
+StaticFileCache::StaticFileCache(std::string rootDir, size_t maxBytes)
+    : m_rootDir(std::move(rootDir))
+    , m_maxBytes(maxBytes)
+    , m_shardCapacity(maxBytes / kShardCount)
+{
+}
+
+StaticFileCache::EntryPtr StaticFileCache::find(std::string_view key)
+{
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return it->second->entry;
+}
+
+bool StaticFileCache::insert(std::string key, EntryPtr entry, uint64_t generation)
+{
+    const size_t charge = entry->charge() + key.size();
+    if (charge > m_shardCapacity) {
+        m_rejections.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // 旧条目先注销路径再登记新条目，同键同路径的引用计数不会互相抵消
+    if (auto it = shard.index.find(key); it != shard.index.end()) {
+        removeNode(shard, it->second);
+    }
+    if (!registerPaths(key, *entry, generation)) {
+        m_rejections.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    while (!shard.lru.empty() && shard.bytes + charge > m_shardCapacity) {
+        removeNode(shard, std::prev(shard.lru.end()));
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.lru.push_front(Node{key, std::move(entry), charge});
+    shard.index.emplace(std::move(key), shard.lru.begin());
+    shard.bytes += charge;
+    m_insertions.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool StaticFileCache::registerPaths(const std::string& key, const StaticFileCacheEntry& entry, uint64_t generation)
+{
+    PathShard& file_shard = pathShardFor(entry.filePath);
+    PathShard& link_shard = pathShardFor(entry.linkPath);
+    // 两把路径锁按地址顺序获取；失效先持锁递增代数再摘取索引，
+    // 代数检查与登记在同一临界区内，失效要么看到本次登记，要么让本次检查失败
+    PathShard* first = &file_shard;
+    PathShard* second = &link_shard;
+    if (second < first) {
+        std::swap(first, second);
+    }
+    std::unique_lock<std::mutex> first_lock(first->mutex);
+    std::unique_lock<std::mutex> second_lock;
+    if (second != first) {
+        second_lock = std::unique_lock<std::mutex>(second->mutex);
+    }
+    if (file_shard.generation.load(std::memory_order_relaxed) +
+            link_shard.generation.load(std::memory_order_relaxed) != generation) {
+        return false;
+    }
+    ++file_shard.keys[entry.filePath][key];
+    ++link_shard.keys[entry.linkPath][key];
+    return true;
+}
+
+void StaticFileCache::unregisterPath(std::string_view path, std::string_view key)
+{
+    PathShard& path_shard = pathShardFor(path);
+    std::lock_guard<std::mutex> lock(path_shard.mutex);
+    auto path_it = path_shard.keys.find(path);
+    if (path_it == path_shard.keys.end()) {
+        return;  // 已被 invalidate() 整体摘走
+    }
+    auto key_it = path_it->second.find(key);
+    if (key_it == path_it->second.end()) {
+        return;
+    }
+    if (--key_it->second == 0) {
+        path_it->second.erase(key_it);
+        if (path_it->second.empty()) {
+            path_shard.keys.erase(path_it);
+        }
+    }
+}
+
+void StaticFileCache::removeNode(Shard& shard, std::list<Node>::iterator node)
+{
+    unregisterPath(node->entry->filePath, node->key);
+    unregisterPath(node->entry->linkPath, node->key);
+    shard.bytes -= node->charge;
+    shard.index.erase(node->key);
+    shard.lru.erase(node);
+}
+
+size_t StaticFileCache::invalidate(std::string_view path)
+{
+    KeyRefs keys;
+    {
+        PathShard& path_shard = pathShardFor(path);
+        std::lock_guard<std::mutex> lock(path_shard.mutex);
+        path_shard.generation.fetch_add(1, std::memory_order_acq_rel);
+        if (auto it = path_shard.keys.find(path); it != path_shard.keys.end()) {
+            keys = std::move(it->second);
+            path_shard.keys.erase(it);
+        }
+    }
+
+    size_t removed = 0;
+    for (const auto& [key, refs] : keys) {
+        (void)refs;
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            continue;
+        }
+        const StaticFileCacheEntry& entry = *it->second->entry;
+        if (entry.filePath != path && entry.linkPath != path) {
+            continue;
+        }
+        removeNode(shard, it->second);
+        ++removed;
+    }
+    m_invalidations.fetch_add(removed, std::memory_order_relaxed);
+    return removed;
+}
+
+void StaticFileCache::invalidateAll()
+{
+    for (PathShard& path_shard : m_pathShards) {
+        std::lock_guard<std::mutex> lock(path_shard.mutex);
+        path_shard.generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+    size_t removed = 0;
+    for (Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        removed += shard.lru.size();
+        while (!shard.lru.empty()) {
+            removeNode(shard, shard.lru.begin());
+        }
+    }
+    m_invalidations.fetch_add(removed, std::memory_order_relaxed);
+}
+
+StaticFileCacheStats StaticFileCache::stats() const
+{
+    StaticFileCacheStats stats;
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.insertions = m_insertions.load(std::memory_order_relaxed);
+    stats.rejections = m_rejections.load(std::memory_order_relaxed);
+    stats.evictions = m_evictions.load(std::memory_order_relaxed);
+    stats.invalidations = m_invalidations.load(std::memory_order_relaxed);
+    for (const Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.lru.size();
+        stats.bytes += shard.bytes;
+    }
+    return stats;
+}
+
+#if defined(USE_IOURING) || defined(USE_EPOLL)
+
+/**
+ * @brief 缓存失效监听协程
+ * @details 监听协程独占 AsyncFileWatcher，只在处理事件的瞬间提升缓存的弱引用。
+ */
+struct StaticFileCacheWatcher {
+    static bool watchTree(galay::async::AsyncFileWatcher& watcher, const std::string& dir)
+    {
+        namespace fs = std::filesystem;
+        const FileWatchEvent kEvents =
+            FileWatchEvent::Modify | FileWatchEvent::Attrib | FileWatchEvent::CloseWrite |
+            FileWatchEvent::MovedFrom | FileWatchEvent::MovedTo | FileWatchEvent::Create |
+            FileWatchEvent::Delete | FileWatchEvent::DeleteSelf | FileWatchEvent::MoveSelf;
+        if (!watcher.addWatch(dir, kEvents)) {
+            return false;
+        }
+        std::error_code ec;
+        fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            std::error_code type_error;
+            if (it->is_directory(type_error) && !it->is_symlink(type_error)) {
+                if (!watcher.addWatch(it->path().string(), kEvents)) {
+                    return false;
+                }
+            }
+        }
+        return !ec;
+    }
+
+    static Task<void> run(std::weak_ptr<StaticFileCache> weak, std::string rootDir)
+    {
+        galay::async::AsyncFileWatcher watcher;
+        if (!watcher.isValid() || !watchTree(watcher, rootDir)) {
+            HTTP_LOG_WARN("[static-cache] [watch-unavailable]", "dir={}", rootDir);
+            if (auto cache = weak.lock()) {
+                cache->markWatchState(StaticFileCache::WatchState::Failed);
+            }
+            co_return;
+        }
+        if (auto cache = weak.lock()) {
+            cache->markWatchState(StaticFileCache::WatchState::Ready);
+        } else {
+            co_return;
+        }
+
+        while (true) {
+            auto event = co_await watcher.watch();
+            auto cache = weak.lock();
+            if (!cache) {
+                co_return;
+            }
+            if (!event) {
+                HTTP_LOG_WARN("[static-cache] [watch-fail]",
+                              "dir={} error={}",
+                              rootDir,
+                              event.error().message());
+                cache->markWatchState(StaticFileCache::WatchState::Failed);
+                cache->invalidateAll();
+                co_return;
+            }
+
+            // 队列溢出（wd 为 -1）、目录本身被删除/移动或子目录变化：无法精确定位，整体清空
+            std::string dir;
+            if (event->wd >= 0) {
+                dir = watcher.getPath(event->wd);
+            }
+            if (dir.empty() || event->name.empty() || event->isDir ||
+                event->has(FileWatchEvent::DeleteSelf) || event->has(FileWatchEvent::MoveSelf)) {
+                if (!dir.empty() && event->isDir &&
+                    (event->has(FileWatchEvent::Create) || event->has(FileWatchEvent::MovedTo))) {
+                    // 先挂上新目录的监听再清空，监听建立前读入的文件不会残留
+                    if (!watchTree(watcher, dir + "/" + event->name)) {
+                        HTTP_LOG_WARN("[static-cache] [watch-subdir-fail]", "dir={}/{}", dir, event->name);
+                        cache->markWatchState(StaticFileCache::WatchState::Failed);
+                    }
+                }
+                cache->invalidateAll();
+                continue;
+            }
+            cache->invalidate(dir + "/" + event->name);
+        }
+    }
+};
+
+bool StaticFileCache::ensureWatching(galay::kernel::Scheduler* scheduler)
+{
+    WatchState state = m_watchState.load(std::memory_order_acquire);
+    if (state == WatchState::Ready) {
+        return true;
+    }
+    // 监听器依赖 IO 调度器的事件循环，不能交给 Runtime 默认挑选的计算调度器
+    if (state != WatchState::Idle || scheduler == nullptr ||
+        scheduler->type() != galay::kernel::kIOScheduler ||
+        !m_watchState.compare_exchange_strong(state, WatchState::Starting, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    if (!galay::kernel::scheduleTask(scheduler, StaticFileCacheWatcher::run(weak_from_this(), m_rootDir))) {
+        HTTP_LOG_WARN("[static-cache] [watch-schedule-fail]", "dir={}", m_rootDir);
+        markWatchState(WatchState::Failed);
+    }
+    return false;
+}
+
+#else
+
+bool StaticFileCache::ensureWatching(galay::kernel::Scheduler*)
+{
+    // kqueue 监听器只能跟踪单个描述符，无法覆盖整棵目录树，缓存保持关闭
+    return false;
+}
+
+#endif
+
+} // namespace galay::http
@@ -0,0 +1,251 @@
+/**
+ * @file static_file_cache.h
+ * @brief 静态文件内存缓存
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 为 mount / mountHardly 提供跨连接共享、按字节数限容的文件缓存。
+ *          每个条目保存文件内容和预渲染好的 200 响应头（Content-Type、Last-Modified、
+ *          Accept-Ranges、ETag、Content-Length），命中时可直接以 writev 发送，
+ *          不再 open / stat / read，也不再为每个请求构建响应头。
+ *          条目按 16 个分片各自维护 LRU；失效由 AsyncFileWatcher 监听挂载目录驱动。
+ */
+
+#ifndef GALAY_HTTP_STATIC_FILE_CACHE_H
+#define GALAY_HTTP_STATIC_FILE_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace galay::kernel
+{
+class Scheduler;
+}
+
+namespace galay::http
+{
+
+/**
+ * @brief 静态文件缓存条目
+ * @details 条目创建后只读，通过 shared_ptr 在多个连接间共享；
+ *          被淘汰或失效时正在发送它的请求仍持有引用，不会读到悬空内存。
+ */
+struct StaticFileCacheEntry {
+    std::string filePath;             ///< 规范化后的真实文件路径
+    std::string linkPath;             ///< 请求路径在规范化目录下的位置（经过符号链接时与 filePath 不同）
+    std::string body;                 ///< 文件内容
+    std::string header;               ///< 预渲染的 200 响应头（含 Content-Length 与结尾空行）
+    std::string etag;                 ///< ETag，未启用 ETag 时为空
+    std::string lastModified;         ///< Last-Modified（HTTP 日期格式）
+    std::string mimeType;             ///< Content-Type
+    std::time_t lastModifiedTime = 0; ///< 最后修改时间（If-Range 比较用）
+
+    /**
+     * @brief 条目占用的缓存预算
+     * @return 字节数
+     */
+    size_t charge() const {
+        return body.size() + header.size() + filePath.size() + linkPath.size() +
+               etag.size() + lastModified.size() + mimeType.size();
+    }
+};
+
+/**
+ * @brief 静态文件缓存统计
+ */
+struct StaticFileCacheStats {
+    uint64_t hits = 0;          ///< 命中次数
+    uint64_t misses = 0;        ///< 未命中次数
+    uint64_t insertions = 0;    ///< 成功插入次数
+    uint64_t rejections = 0;    ///< 因超限或加载期间发生失效而拒绝插入的次数
+    uint64_t evictions = 0;     ///< LRU 淘汰条目数
+    uint64_t invalidations = 0; ///< 因文件变更被移除的条目数
+    size_t entries = 0;         ///< 当前条目数
+    size_t bytes = 0;           ///< 当前占用字节数
+};
+
+/**
+ * @brief 静态文件缓存
+ * @details 线程安全：按键哈希分成 kShardCount 个分片，每个分片一把互斥锁和一条 LRU 链表，
+ *          各分片的容量为 maxBytes / kShardCount。单个条目（文件内容加响应头等元数据）
+ *          不小于单分片容量时不会被缓存，即单个文件上限约为 maxBytes / 16。
+ *
+ *          失效按路径进行：另有 kShardCount 个按路径哈希的路径分片，各自维护
+ *          “路径 → 缓存键”索引与一个代数。调用方在读文件之前以条目的两个路径取 generation()，
+ *          插入时这两个路径所在分片的代数已变化（期间其中之一被修改）则拒绝插入，避免把旧内容写回缓存；
+ *          其它路径的变更不影响插入。invalidate() 只经索引移除匹配的条目。
+ *
+ *          ensureWatching() 在首次调用时向调用方所在的 IO 调度器提交一个监听协程，
+ *          用 inotify 监听根目录及全部子目录；文件被修改、替换、删除时按路径失效，
+ *          目录结构变化或事件队列溢出时整体清空。监听协程只持有缓存的弱引用。
+ *          监听不可用（不在 IO 调度器上、inotify 不可用、监听数达到系统上限、kqueue 后端只能监听
+ *          单个描述符）时 ensureWatching() 返回 false，调用方应绕过缓存。
+ */
+class StaticFileCache : public std::enable_shared_from_this<StaticFileCache>
+{
+public:
+    using EntryPtr = std::shared_ptr<const StaticFileCacheEntry>;
+
+    static constexpr size_t kShardCount = 16; ///< 分片数
+
+    /**
+     * @brief 构造缓存
+     * @param rootDir 被监听的根目录（应为规范化路径）
+     * @param maxBytes 缓存总容量（字节）
+     */
+    StaticFileCache(std::string rootDir, size_t maxBytes);
+
+    StaticFileCache(const StaticFileCache&) = delete;
+    StaticFileCache& operator=(const StaticFileCache&) = delete;
+
+    /**
+     * @brief 查找条目并标记为最近使用
+     * @param key 缓存键（mount 使用请求相对路径，mountHardly 使用注册的文件路径）
+     * @return 命中返回条目，未命中返回 nullptr
+     */
+    EntryPtr find(std::string_view key);
+
+    /**
+     * @brief 获取条目路径当前的失效代数
+     * @param filePath 条目的 filePath
+     * @param linkPath 条目的 linkPath
+     * @return 两个路径所在路径分片的代数之和；任一路径失效或整体清空后都会变大
+     */
+    uint64_t generation(std::string_view filePath, std::string_view linkPath) const noexcept {
+        return pathShardFor(filePath).generation.load(std::memory_order_acquire) +
+               pathShardFor(linkPath).generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 插入或替换条目
+     * @param key 缓存键
+     * @param entry 条目
+     * @param generation 读取文件前以 entry 的 filePath / linkPath 取得的代数
+     * @return 插入成功返回 true；条目超过分片容量或期间这两个路径发生过失效时返回 false
+     */
+    bool insert(std::string key, EntryPtr entry, uint64_t generation);
+
+    /**
+     * @brief 判断指定大小的文件是否可能被缓存
+     * @param fileSize 文件大小
+     * @return 文件内容小于单分片容量（maxBytes / kShardCount）时返回 true
+     */
+    bool admits(size_t fileSize) const noexcept {
+        return fileSize < m_shardCapacity;
+    }
+
+    /**
+     * @brief 移除与文件路径关联的全部条目
+     * @param path 文件路径（与条目的 filePath 或 linkPath 比较）
+     * @return 移除的条目数
+     */
+    size_t invalidate(std::string_view path);
+
+    /**
+     * @brief 清空缓存
+     */
+    void invalidateAll();
+
+    /**
+     * @brief 确保文件变更监听已启动
+     * @param scheduler 调用方协程所属的调度器，监听协程提交到这里
+     * @return 监听已就绪返回 true；尚未就绪或不可用返回 false
+     * @note 首次调用的调度器必须是 IO 调度器；监听就绪之前的请求不会写入缓存
+     */
+    bool ensureWatching(galay::kernel::Scheduler* scheduler);
+
+    /**
+     * @brief 获取统计信息
+     * @return 统计快照
+     */
+    StaticFileCacheStats stats() const;
+
+    const std::string& rootDir() const noexcept { return m_rootDir; } ///< 被监听的根目录
+    size_t maxBytes() const noexcept { return m_maxBytes; }           ///< 缓存总容量
+
+private:
+    enum class WatchState : uint8_t {
+        Idle,     ///< 尚未启动
+        Starting, ///< 监听协程已提交，正在注册目录
+        Ready,    ///< 监听中，可以写入缓存
+        Failed,   ///< 监听不可用，缓存被绕过
+    };
+
+    struct Node {
+        std::string key;
+        EntryPtr entry;
+        size_t charge = 0;
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const noexcept {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Node> lru;  ///< 表头为最近使用
+        std::unordered_map<std::string, std::list<Node>::iterator, KeyHash, std::equal_to<>> index;
+        size_t bytes = 0;
+    };
+
+    using KeyRefs = std::unordered_map<std::string, uint32_t, KeyHash, std::equal_to<>>;
+
+    /**
+     * @brief 路径分片
+     * @details 锁顺序：持有键分片锁时可以再取路径分片锁，反之不行
+     */
+    struct PathShard {
+        mutable std::mutex mutex;
+        std::atomic<uint64_t> generation{0};  ///< 本分片内任一路径失效时递增（持锁修改）
+        std::unordered_map<std::string, KeyRefs, KeyHash, std::equal_to<>> keys;  ///< 路径 → 引用它的缓存键及引用次数
+    };
+
+    Shard& shardFor(std::string_view key) {
+        return m_shards[KeyHash{}(key) % kShardCount];
+    }
+
+    PathShard& pathShardFor(std::string_view path) const {
+        return m_pathShards[KeyHash{}(path) % kShardCount];
+    }
+
+    bool registerPaths(const std::string& key, const StaticFileCacheEntry& entry, uint64_t generation);
+    void unregisterPath(std::string_view path, std::string_view key);
+    void removeNode(Shard& shard, std::list<Node>::iterator node);
+
+    void markWatchState(WatchState state) noexcept {
+        m_watchState.store(state, std::memory_order_release);
+    }
+
+    friend struct StaticFileCacheWatcher;
+
+    std::string m_rootDir;
+    size_t m_maxBytes;
+    size_t m_shardCapacity;
+    std::array<Shard, kShardCount> m_shards;
+    mutable std::array<PathShard, kShardCount> m_pathShards;
+    std::atomic<WatchState> m_watchState{WatchState::Idle};
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_insertions{0};
+    std::atomic<uint64_t> m_rejections{0};
+    std::atomic<uint64_t> m_evictions{0};
+    std::atomic<uint64_t> m_invalidations{0};
+};
+
+} // namespace galay::http
+
+#endif // GALAY_HTTP_STATIC_FILE_CACHE_H
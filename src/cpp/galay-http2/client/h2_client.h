@@ -50,6 +50,7 @@ struct H2ClientConfig
     uint32_t max_header_list_size = 8192;
     bool verify_peer = false;
     std::string ca_path;
+    H2AdaptiveWindowConfig adaptive_window;  ///< 按 BDP 调整接收窗口，默认关闭
 };
 
 template<RingBufferBackendStrategy Strategy = RingBufferBackendStrategy::Mmap>
@@ -92,6 +93,7 @@ public:
     H2ClientBuilder& maxHeaderListSize(uint32_t v)    { m_config.max_header_list_size = v; return *this; }
     H2ClientBuilder& verifyPeer(bool v)               { m_config.verify_peer = v; return *this; }
     H2ClientBuilder& caPath(std::string v)            { m_config.ca_path = std::move(v); return *this; }
+    H2ClientBuilder& adaptiveWindow(H2AdaptiveWindowConfig v) { m_config.adaptive_window = v; return *this; }
     H2Client<> build() const;
     H2ClientConfig buildConfig() const {
         return Http2Conn::normalizeSettingsConfig(m_config);
@@ -367,6 +369,18 @@ private:
                 m_driver.sendContext().m_length);
         }
 
+        if (wait.kind == galay::ssl::SslOperationDriver::WaitKind::kReadv) {
+            return MachineAction<result_type>::waitReadv(
+                m_driver.readvContext().m_iovecs.data(),
+                m_driver.readvContext().m_iovecs.size());
+        }
+
+        if (wait.kind == galay::ssl::SslOperationDriver::WaitKind::kWritev) {
+            return MachineAction<result_type>::waitWritev(
+                m_driver.writevContext().m_iovecs.data(),
+                m_driver.writevContext().m_iovecs.size());
+        }
+
         fail("internal-fail", "ssl driver returned no wait action");
         return MachineAction<result_type>::complete(std::move(*m_result));
     }
@@ -57,6 +57,7 @@ struct H2cClientConfig
     std::chrono::milliseconds graceful_shutdown_timeout{5000};
     uint32_t flow_control_target_window = kDefaultInitialWindowSize;
     Http2FlowControlStrategy flow_control_strategy;
+    H2AdaptiveWindowConfig adaptive_window;  ///< 按 BDP 调整接收窗口，默认关闭
 };
 
 template<RingBufferBackendStrategy Strategy = RingBufferBackendStrategy::Mmap>
@@ -80,6 +81,15 @@ public:
         m_config.flow_control_strategy = std::move(v);
         return *this;
     }
+    /**
+     * @brief 设置接收窗口自适应。
+     * @param v 开启后以 PING 往返估算带宽时延积，在 max_window 内增长连接与 stream 接收窗口，空闲时回落。
+     * @return 当前 builder，支持链式调用。
+     */
+    H2cClientBuilder& adaptiveWindow(H2AdaptiveWindowConfig v) {
+        m_config.adaptive_window = v;
+        return *this;
+    }
     H2cClient<> build() const;
     H2cClientConfig buildConfig() const {
         return Http2Conn::normalizeSettingsConfig(m_config);
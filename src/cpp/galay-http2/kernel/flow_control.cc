@@ -1,6 +1,7 @@
 #include "flow_control.h"
 
 #include <algorithm>
+#include <cstring>
 
 namespace galay::http2
 {
@@ -13,6 +14,13 @@ bool wouldExceedMaxWindow(int64_t current, uint32_t increment)
     return current > kH2MaxFlowControlWindow - static_cast<int64_t>(increment);
 }
 
+constexpr uint8_t kWindowProbeTag = 0xbd; ///< 探测 PING 负载首字节，区别于保活 PING 的时间戳负载
+
+uint32_t clampWindow(uint64_t window)
+{
+    return static_cast<uint32_t>(std::min<uint64_t>(window, static_cast<uint64_t>(kH2MaxFlowControlWindow)));
+}
+
 } // namespace
 
 std::expected<void, H2FlowControlError> H2FlowController::ensureStream(uint32_t stream_id)
@@ -105,4 +113,119 @@ std::expected<void, H2FlowControlError> H2FlowController::consumeSendWindow(uint
     return {};
 }
 
+void H2RecvWindowTuner::configure(const H2AdaptiveWindowConfig& config,
+                                  uint32_t base_conn_window,
+                                  uint32_t base_stream_window)
+{
+    m_config = config;
+    m_config.max_window = clampWindow(std::max(config.max_window, base_conn_window));
+    m_config.max_stream_window = std::min(
+        m_config.max_window, std::max(config.max_stream_window, base_stream_window));
+    m_base_conn_window = base_conn_window;
+    m_base_stream_window = base_stream_window;
+    m_conn_target = base_conn_window;
+    m_stream_target = base_stream_window;
+    m_bdp = 0;
+    m_sample_bytes = 0;
+    m_min_rtt = {};
+    m_smoothed_rtt = {};
+    m_probe_in_flight = false;
+    m_last_data_at = {};
+}
+
+bool H2RecvWindowTuner::onDataReceived(size_t bytes, Clock::time_point now)
+{
+    if (!m_config.enabled) {
+        return false;
+    }
+    m_last_data_at = now;
+    if (m_probe_in_flight) {
+        m_sample_bytes += bytes;
+        return false;
+    }
+    // 已到上限时不再探测，避免无意义的 PING
+    if (m_conn_target >= m_config.max_window && m_stream_target >= m_config.max_stream_window) {
+        return false;
+    }
+    m_sample_bytes = bytes;
+    return true;
+}
+
+void H2RecvWindowTuner::onProbeSent(Clock::time_point now)
+{
+    ++m_probe_seq;
+    m_probe_payload[0] = kWindowProbeTag;
+    for (size_t i = 1; i < m_probe_payload.size(); ++i) {
+        m_probe_payload[i] = static_cast<uint8_t>((m_probe_seq >> ((7 - i) * 8)) & 0xFF);
+    }
+    m_probe_sent_at = now;
+    m_probe_in_flight = true;
+}
+
+bool H2RecvWindowTuner::isProbeAck(const uint8_t* opaque) const
+{
+    return m_probe_in_flight &&
+           std::memcmp(opaque, m_probe_payload.data(), m_probe_payload.size()) == 0;
+}
+
+bool H2RecvWindowTuner::onProbeAck(Clock::time_point now)
+{
+    if (!m_probe_in_flight) {
+        return false;
+    }
+    m_probe_in_flight = false;
+    onRttSample(now - m_probe_sent_at);
+
+    const size_t sample = m_sample_bytes;
+    m_sample_bytes = 0;
+    // 一个 RTT 内收到的字节接近当前窗口，说明窗口限制了吞吐
+    if (sample * 3 < static_cast<size_t>(m_conn_target) * 2 &&
+        sample * 3 < static_cast<size_t>(m_stream_target) * 2) {
+        return false;
+    }
+    const uint32_t next = clampWindow(static_cast<uint64_t>(sample) * 2);
+    const uint32_t next_conn = std::min(std::max(m_conn_target, next), m_config.max_window);
+    const uint32_t next_stream = std::min(std::max(m_stream_target, next), m_config.max_stream_window);
+    if (next_conn == m_conn_target && next_stream == m_stream_target) {
+        return false;
+    }
+    m_bdp = clampWindow(sample);
+    m_conn_target = next_conn;
+    m_stream_target = next_stream;
+    return true;
+}
+
+void H2RecvWindowTuner::onRttSample(Clock::duration rtt)
+{
+    if (rtt <= Clock::duration::zero()) {
+        return;
+    }
+    if (m_min_rtt == Clock::duration::zero() || rtt < m_min_rtt) {
+        m_min_rtt = rtt;
+    }
+    if (m_smoothed_rtt == Clock::duration::zero()) {
+        m_smoothed_rtt = rtt;
+    } else {
+        m_smoothed_rtt = m_smoothed_rtt - m_smoothed_rtt / 8 + rtt / 8;
+    }
+}
+
+bool H2RecvWindowTuner::onIdleCheck(Clock::time_point now)
+{
+    if (!m_config.enabled || m_config.idle_shrink_after.count() <= 0) {
+        return false;
+    }
+    if (m_conn_target <= m_base_conn_window && m_stream_target <= m_base_stream_window) {
+        return false;
+    }
+    if (now - m_last_data_at < m_config.idle_shrink_after) {
+        return false;
+    }
+    m_conn_target = std::max(m_base_conn_window, m_conn_target / 2);
+    m_stream_target = std::max(m_base_stream_window, m_stream_target / 2);
+    m_bdp = 0;
+    m_last_data_at = now;
+    return true;
+}
+
 } // namespace galay::http2
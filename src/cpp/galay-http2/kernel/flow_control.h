@@ -4,14 +4,16 @@
  * @author galay-http
  * @version 1.0.0
  *
- * @details 提供连接级和 stream 级发送窗口的独立状态机。
- *          该类型只计算窗口与可发送字节数，不执行 socket 写入，也不阻塞。
+ * @details 提供连接级和 stream 级发送窗口的独立状态机，以及按带宽时延积（BDP）调整接收窗口的调优器。
+ *          这些类型只计算窗口，不执行 socket 写入，也不阻塞。
  */
 
 #ifndef GALAY_HTTP2_FLOW_CONTROL_H
 #define GALAY_HTTP2_FLOW_CONTROL_H
 
 #include "../protoc/http2_base.h"
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
@@ -103,6 +105,108 @@ private:
     H2SendWindow m_window;
 };
 
+/**
+ * @brief 接收窗口自适应配置
+ */
+struct H2AdaptiveWindowConfig
+{
+    bool enabled = false;                               ///< 是否按 BDP 调整接收窗口
+    uint32_t max_window = 16 * 1024 * 1024;             ///< 连接接收窗口上限，即单连接接收缓冲的内存上限
+    uint32_t max_stream_window = 8 * 1024 * 1024;       ///< 单个 stream 接收窗口上限，不超过 max_window
+    std::chrono::milliseconds idle_shrink_after{2000};  ///< 连续无 DATA 超过该时长时窗口目标减半，直至回到基线
+};
+
+/**
+ * @brief HTTP/2 接收窗口调优器
+ * @details 以 PING 往返测量 RTT，以一个 RTT 内收到的 DATA 字节估算带宽时延积：
+ *          收到 DATA 且没有探测在途时发出一个探测 PING，ACK 到达时把期间收到的字节作为 BDP 样本；
+ *          样本达到当前窗口目标的 2/3 时，把连接与 stream 的窗口目标提升到样本的 2 倍（受上限约束）。
+ *          连续空闲时目标逐步减半回到基线；目标下降后不再补发超出目标的 WINDOW_UPDATE，
+ *          已授予对端的窗口随后续 DATA 自然消耗。
+ *          纯内存状态机，由连接所有者驱动，不发起 I/O，不是线程安全的。
+ */
+class H2RecvWindowTuner
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 设置配置与基线窗口，重置估计状态
+     * @param config 自适应配置
+     * @param base_conn_window 连接窗口基线（固定窗口模式下的目标）
+     * @param base_stream_window stream 窗口基线（本端 SETTINGS_INITIAL_WINDOW_SIZE）
+     */
+    void configure(const H2AdaptiveWindowConfig& config,
+                   uint32_t base_conn_window,
+                   uint32_t base_stream_window);
+
+    bool enabled() const { return m_config.enabled; }               ///< 是否开启
+    uint32_t connTarget() const { return m_conn_target; }           ///< 当前连接窗口目标
+    uint32_t streamTarget() const { return m_stream_target; }       ///< 当前 stream 窗口目标
+    uint32_t bdpEstimate() const { return m_bdp; }                  ///< 最近一次提升依据的 BDP 样本
+    Clock::duration minRtt() const { return m_min_rtt; }            ///< 观测到的最小 RTT
+    Clock::duration smoothedRtt() const { return m_smoothed_rtt; }  ///< 平滑 RTT（1/8 EWMA）
+    bool probeInFlight() const { return m_probe_in_flight; }        ///< 是否有探测 PING 在途
+
+    /**
+     * @brief 记录收到的 DATA
+     * @param bytes DATA 帧负载字节数（含填充）
+     * @param now 当前时间
+     * @return 需要立即发出探测 PING 时返回 true，调用方随后发送 probePayload() 并调用 onProbeSent()
+     */
+    bool onDataReceived(size_t bytes, Clock::time_point now);
+
+    /**
+     * @brief 探测 PING 已入队
+     * @param now 当前时间
+     */
+    void onProbeSent(Clock::time_point now);
+
+    const std::array<uint8_t, 8>& probePayload() const { return m_probe_payload; } ///< 探测 PING 负载
+
+    /**
+     * @brief 判断 PING ACK 是否为本调优器的探测
+     * @param opaque 8 字节 PING 负载
+     */
+    bool isProbeAck(const uint8_t* opaque) const;
+
+    /**
+     * @brief 探测 PING 的 ACK 到达
+     * @param now 当前时间
+     * @return 窗口目标提升时返回 true，调用方应立即补发连接级 WINDOW_UPDATE
+     */
+    bool onProbeAck(Clock::time_point now);
+
+    /**
+     * @brief 记录其它 PING（如保活）的往返时间
+     * @param rtt 往返时间
+     */
+    void onRttSample(Clock::duration rtt);
+
+    /**
+     * @brief 空闲检查，由连接的周期任务调用
+     * @param now 当前时间
+     * @return 窗口目标下降时返回 true
+     */
+    bool onIdleCheck(Clock::time_point now);
+
+private:
+    H2AdaptiveWindowConfig m_config;
+    uint32_t m_base_conn_window = kDefaultInitialWindowSize;   ///< 连接窗口基线
+    uint32_t m_base_stream_window = kDefaultInitialWindowSize; ///< stream 窗口基线
+    uint32_t m_conn_target = kDefaultInitialWindowSize;        ///< 连接窗口目标
+    uint32_t m_stream_target = kDefaultInitialWindowSize;      ///< stream 窗口目标
+    uint32_t m_bdp = 0;                                        ///< 最近一次提升依据的 BDP 样本
+    size_t m_sample_bytes = 0;                                 ///< 当前探测期间收到的字节
+    uint64_t m_probe_seq = 0;                                  ///< 探测序号，写入 PING 负载
+    Clock::time_point m_probe_sent_at{};                       ///< 探测发出时间
+    Clock::time_point m_last_data_at{};                        ///< 最近一次收到 DATA 的时间
+    Clock::duration m_min_rtt{};                               ///< 最小 RTT，0 表示尚无样本
+    Clock::duration m_smoothed_rtt{};                          ///< 平滑 RTT，0 表示尚无样本
+    std::array<uint8_t, 8> m_probe_payload{};                  ///< 在途探测的 PING 负载
+    bool m_probe_in_flight = false;                            ///< 是否有探测在途
+};
+
 } // namespace galay::http2
 
 #endif // GALAY_HTTP2_FLOW_CONTROL_H
@@ -47,7 +47,8 @@ bool requiresZeroStream(const Http2Frame& frame)
 {
     return frame.isSettings() ||
            frame.isPing() ||
-           frame.isGoAway();
+           frame.isGoAway() ||
+           frame.isPriorityUpdate();
 }
 
 bool isStreamFrame(const Http2Frame& frame)
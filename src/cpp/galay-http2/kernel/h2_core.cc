@@ -123,7 +123,7 @@ H2DispatchResult Http2ConnectionCore::receiveFrame(const Http2Frame& frame)
 }
 
 void Http2ConnectionCore::enqueueData(uint32_t stream_id,
-                                      std::string data,
+                                      Http2PayloadSlice data,
                                       bool end_stream,
                                       uint8_t weight)
 {
@@ -139,6 +139,17 @@ void Http2ConnectionCore::enqueueData(uint32_t stream_id,
     m_outbound_ready = true;
 }
 
+void Http2ConnectionCore::enqueueData(uint32_t stream_id,
+                                      Http2PayloadSlice data,
+                                      bool end_stream,
+                                      Http2PriorityParam priority)
+{
+    enqueueData(stream_id, std::move(data), end_stream);
+    auto& stream = m_outbound_queues.data_streams.back();
+    stream.urgency = priority.urgency;
+    stream.incremental = priority.incremental;
+}
+
 H2OutboundSelection Http2ConnectionCore::flushOutbound(H2OutboundBudget budget,
                                                        H2SchedulerConfig config)
 {
@@ -155,6 +166,14 @@ H2OutboundBytesSelection Http2ConnectionCore::flushOutboundBytes(H2OutboundBudge
     return selection;
 }
 
+H2OutboundSliceSelection Http2ConnectionCore::flushOutboundSlices(H2OutboundBudget budget,
+                                                                  H2SchedulerConfig config)
+{
+    auto selection = Http2OutboundScheduler::pickSendableSlices(budget, m_outbound_queues, config);
+    m_outbound_ready = hasOutboundWork();
+    return selection;
+}
+
 galay::kernel::Task<void> Http2ConnectionCore::run()
 {
     if (state() == State::Idle) {
@@ -115,11 +115,20 @@ public:
     /**
      * @brief 入队待发送 DATA
      * @param stream_id stream ID
-     * @param data DATA payload
+     * @param data DATA payload 切片；传入 std::string 时接管其存储，传入共享切片时不复制字节
      * @param end_stream 数据发送完后是否附带 END_STREAM
      * @param weight stream 调度权重
      */
-    void enqueueData(uint32_t stream_id, std::string data, bool end_stream, uint8_t weight = 16);
+    void enqueueData(uint32_t stream_id, Http2PayloadSlice data, bool end_stream, uint8_t weight = 16);
+
+    /**
+     * @brief 按可扩展优先级入队待发送 DATA
+     * @param stream_id stream ID
+     * @param data DATA payload 切片
+     * @param end_stream 数据发送完后是否附带 END_STREAM
+     * @param priority urgency / incremental，仅在 H2SchedulingMode::Extensible 下生效
+     */
+    void enqueueData(uint32_t stream_id, Http2PayloadSlice data, bool end_stream, Http2PriorityParam priority);
 
     /**
      * @brief 立即调度当前出站队列
@@ -140,6 +149,17 @@ public:
      */
     H2OutboundBytesSelection flushOutboundBytes(H2OutboundBudget budget, H2SchedulerConfig config = {});
 
+    /**
+     * @brief 立即调度当前出站队列并返回切片帧
+     * @details DATA 帧只生成 9 字节帧头，负载为入队切片的子切片；
+     *          调用方用 H2OutboundSliceSelection::fillIovecs() 组装一次 writev。
+     *          服务端连接写路径不经过此接口，由 Http2StreamManager 直接导出 Http2OutgoingFrame iovec。
+     * @param budget 本次发送预算
+     * @param config DRR 调度配置
+     * @return 本次选出的切片帧，写出完成前必须保持存活
+     */
+    H2OutboundSliceSelection flushOutboundSlices(H2OutboundBudget budget, H2SchedulerConfig config = {});
+
     galay::kernel::Task<void> run();
 
 private:
@@ -14,6 +14,7 @@
 
 #include "http2_stream.h"
 #include "h2_core.h"
+#include "flow_control.h"
 #include "../server/h2_static_file.h"
 #include "../protoc/http2_base.h"
 #include "../protoc/http2_frame.h"
@@ -236,6 +237,9 @@ struct Http2RuntimeConfig
     Http2FlowControlStrategy flow_control_strategy;
     std::vector<H2StaticRoute> static_routes;
     std::vector<H2StaticFileMount> static_file_mounts;
+    galay::http::HttpCompressionSetting compression;
+    H2SchedulingMode scheduling_mode = H2SchedulingMode::Extensible;
+    H2AdaptiveWindowConfig adaptive_window;
 
     template<typename Config>
     void from(const Config& config) {
@@ -269,6 +273,15 @@ struct Http2RuntimeConfig
                 prepareH2StaticRoute(route);
             }
         }
+        if constexpr (requires { config.compression; }) {
+            compression = config.compression;
+        }
+        if constexpr (requires { config.scheduling_mode; }) {
+            scheduling_mode = config.scheduling_mode;
+        }
+        if constexpr (requires { config.adaptive_window; }) {
+            adaptive_window = config.adaptive_window;
+        }
         if constexpr (requires { config.static_file_mounts; }) {
             static_file_mounts = config.static_file_mounts;
             for (auto& mount : static_file_mounts) {
@@ -390,6 +403,7 @@ inline bool isKnownHttp2FrameType(Http2FrameType type) {
         case Http2FrameType::GoAway:
         case Http2FrameType::WindowUpdate:
         case Http2FrameType::Continuation:
+        case Http2FrameType::PriorityUpdate:
             return true;
         default:
             return false;
@@ -1311,6 +1325,8 @@ public:
     Http2Settings& peerSettings() { return m_peer_settings; }
     Http2RuntimeConfig& runtimeConfig() { return m_runtime_config; }
     const Http2RuntimeConfig& runtimeConfig() const { return m_runtime_config; }
+    H2RecvWindowTuner& windowTuner() { return m_window_tuner; }
+    const H2RecvWindowTuner& windowTuner() const { return m_window_tuner; }
 
     /**
      * @brief 校验 SETTINGS 帧的连接级约束。
@@ -1539,6 +1555,10 @@ public:
         uint32_t stream_target = m_local_settings.initial_window_size == 0
             ? kDefaultInitialWindowSize
             : m_local_settings.initial_window_size;
+        if (m_window_tuner.enabled()) {
+            conn_target = std::max(conn_target, m_window_tuner.connTarget());
+            stream_target = std::max(stream_target, m_window_tuner.streamTarget());
+        }
 
         if (m_runtime_config.flow_control_strategy) {
             return m_runtime_config.flow_control_strategy(
@@ -1546,8 +1566,8 @@ public:
         }
 
         Http2FlowControlUpdate update;
-        const int32_t conn_low_watermark = static_cast<int32_t>((conn_target * 3) / 4);
-        const int32_t stream_low_watermark = static_cast<int32_t>((stream_target * 3) / 4);
+        const int32_t conn_low_watermark = static_cast<int32_t>((static_cast<uint64_t>(conn_target) * 3) / 4);
+        const int32_t stream_low_watermark = static_cast<int32_t>((static_cast<uint64_t>(stream_target) * 3) / 4);
         if (m_conn_recv_window < conn_low_watermark) {
             update.conn_increment = static_cast<uint32_t>(conn_target - m_conn_recv_window);
         }
@@ -2028,6 +2048,7 @@ private:
     Http2Settings m_local_settings;
     Http2Settings m_peer_settings;
     Http2RuntimeConfig m_runtime_config;
+    H2RecvWindowTuner m_window_tuner;  ///< 接收窗口自适应，未开启时目标恒为基线
     
     // 流管理
     std::unordered_map<uint32_t, Http2Stream::ptr> m_streams;
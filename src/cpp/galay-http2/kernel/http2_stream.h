@@ -16,6 +16,9 @@
 #include "../protoc/http2_frame.h"
 #include "../protoc/http2_hpack.h"
 #include "../protoc/http2_error.h"
+#include "../protoc/http2_priority.h"
+#include "payload_slice.h"
+#include "../../galay-http/common/http_compression.h"
 #include "../../galay-kernel/async/async_waiter.h"
 #include "../../galay-kernel/concurrency/mpsc/unbounded_channel.h"
 #include "../../galay-kernel/concurrency/spsc/unbounded_channel.h"
@@ -23,6 +26,7 @@
 #include <string_view>
 #include <vector>
 #include <algorithm>
+#include <cctype>
 #include <charconv>
 #include <deque>
 #include <limits>
@@ -61,9 +65,7 @@ struct Http2OutgoingFrame {
     std::string serialized;
     std::array<char, kHttp2FrameHeaderLength> header_bytes{};
     std::string owned_payload;
-    std::shared_ptr<const std::string> shared_payload;
-    size_t shared_payload_offset = 0;
-    size_t shared_payload_length = static_cast<size_t>(-1);
+    Http2PayloadSlice payload_slice;  ///< 引用计数负载切片，优先于 owned_payload
     bool segmented_packet = false;
     WaiterPtr waiter;
 
@@ -97,12 +99,7 @@ struct Http2OutgoingFrame {
     static Http2OutgoingFrame segmentedShared(std::array<char, kHttp2FrameHeaderLength> header,
                                               std::shared_ptr<const std::string> payload,
                                               WaiterPtr w = nullptr) {
-        Http2OutgoingFrame frame;
-        frame.header_bytes = std::move(header);
-        frame.shared_payload = std::move(payload);
-        frame.segmented_packet = true;
-        frame.waiter = std::move(w);
-        return frame;
+        return segmentedSlice(std::move(header), Http2PayloadSlice(std::move(payload)), std::move(w));
     }
 
     static Http2OutgoingFrame segmentedShared(std::array<char, kHttp2FrameHeaderLength> header,
@@ -110,9 +107,19 @@ struct Http2OutgoingFrame {
                                               size_t offset,
                                               size_t length,
                                               WaiterPtr w = nullptr) {
-        Http2OutgoingFrame frame = segmentedShared(std::move(header), std::move(payload), std::move(w));
-        frame.shared_payload_offset = offset;
-        frame.shared_payload_length = length;
+        return segmentedSlice(std::move(header),
+                              Http2PayloadSlice(std::move(payload), offset, length),
+                              std::move(w));
+    }
+
+    static Http2OutgoingFrame segmentedSlice(std::array<char, kHttp2FrameHeaderLength> header,
+                                             Http2PayloadSlice payload,
+                                             WaiterPtr w = nullptr) {
+        Http2OutgoingFrame frame;
+        frame.header_bytes = std::move(header);
+        frame.payload_slice = std::move(payload);
+        frame.segmented_packet = true;
+        frame.waiter = std::move(w);
         return frame;
     }
 
@@ -190,11 +197,8 @@ struct Http2OutgoingFrame {
 
 private:
     const char* payloadData() const {
-        if (shared_payload) {
-            if (shared_payload_offset >= shared_payload->size()) {
-                return nullptr;
-            }
-            return shared_payload->data() + shared_payload_offset;
+        if (!payload_slice.empty()) {
+            return payload_slice.data();
         }
         if (!owned_payload.empty()) {
             return owned_payload.data();
@@ -203,12 +207,8 @@ private:
     }
 
     size_t payloadSize() const {
-        if (shared_payload) {
-            if (shared_payload_offset >= shared_payload->size()) {
-                return 0;
-            }
-            const auto available = shared_payload->size() - shared_payload_offset;
-            return std::min(available, shared_payload_length);
+        if (!payload_slice.empty()) {
+            return payload_slice.size();
         }
         return owned_payload.size();
     }
@@ -887,7 +887,7 @@ public:
 
 private:
     struct PendingDataSend {
-        std::shared_ptr<const std::string> payload;
+        Http2PayloadSlice payload;
         size_t offset = 0;
         bool end_stream = false;
         Http2OutgoingFrame::WaiterPtr waiter;
@@ -915,7 +915,7 @@ private:
     }
 
     size_t availableDataChunkSize(const PendingDataSend& pending) const {
-        if (!pending.payload || pending.offset >= pending.payload->size()) {
+        if (pending.offset >= pending.payload.size()) {
             return 0;
         }
         const auto stream_window = std::max<int32_t>(m_send_window, 0);
@@ -924,7 +924,7 @@ private:
             return 0;
         }
         return std::min<size_t>({
-            pending.payload->size() - pending.offset,
+            pending.payload.size() - pending.offset,
             static_cast<size_t>(m_max_frame_size),
             static_cast<size_t>(stream_window),
             static_cast<size_t>(conn_window)
@@ -952,19 +952,16 @@ private:
     };
 
     PendingDataFlushResult flushPendingDataFront(PendingDataSend& pending) {
-        const size_t payload_size = pending.payload ? pending.payload->size() : 0;
+        const size_t payload_size = pending.payload.size();
         if (payload_size == 0) {
             auto header_bytes = Http2FrameBuilder::dataHeaderBytes(
                 m_stream_id, 0, pending.end_stream);
             if (pending.end_stream) {
                 onDataSent(true);
             }
-            auto payload = pending.payload
-                ? pending.payload
-                : std::make_shared<const std::string>();
             enqueueOutgoingDataFrame(
-                Http2OutgoingFrame::segmentedShared(
-                    std::move(header_bytes), std::move(payload), pending.waiter));
+                Http2OutgoingFrame::segmentedSlice(
+                    std::move(header_bytes), Http2PayloadSlice{}, pending.waiter));
             return PendingDataFlushResult::Complete;
         }
 
@@ -979,11 +976,9 @@ private:
             m_stream_id, chunk_size, frame_end_stream);
         auto waiter = final_chunk ? pending.waiter : nullptr;
         enqueueOutgoingDataFrame(
-            Http2OutgoingFrame::segmentedShared(
+            Http2OutgoingFrame::segmentedSlice(
                 std::move(header_bytes),
-                pending.payload,
-                pending.offset,
-                chunk_size,
+                pending.payload.subslice(pending.offset, chunk_size),
                 std::move(waiter)));
 
         consumeDataSendWindow(chunk_size);
@@ -995,6 +990,24 @@ private:
                            : PendingDataFlushResult::Progress;
     }
 
+    /**
+     * @brief 只补发一帧暂存 DATA，供 incremental 流轮转
+     * @return 是否发出了帧
+     */
+    bool flushPendingDataFrame() {
+        if (m_pending_data.empty() || (!m_send_queue && !m_send_channel)) {
+            return false;
+        }
+        auto result = flushPendingDataFront(m_pending_data.front());
+        if (result == PendingDataFlushResult::Blocked) {
+            return false;
+        }
+        if (result == PendingDataFlushResult::Complete) {
+            m_pending_data.pop_front();
+        }
+        return true;
+    }
+
     bool flushPendingData() {
         bool made_progress = false;
         while (!m_pending_data.empty() && (m_send_queue || m_send_channel)) {
@@ -1019,7 +1032,7 @@ private:
         m_pending_data.clear();
     }
 
-    void queueDataForSend(std::shared_ptr<const std::string> payload,
+    void queueDataForSend(Http2PayloadSlice payload,
                           bool end_stream,
                           const Http2OutgoingFrame::WaiterPtr& waiter) {
         if (!m_send_queue && !m_send_channel) {
@@ -1029,8 +1042,30 @@ private:
             return;
         }
 
+        if (m_stream_compressor) {
+            auto encoded = m_stream_compressor->update(payload.view(), end_stream);
+            if (!encoded) {
+                // 压缩流已无法继续，只能复位该流，避免客户端收到截断的编码数据
+                m_stream_compressor.reset();
+                sendRstStreamInternal(Http2ErrorCode::InternalError, nullptr);
+                if (waiter) {
+                    waiter->notify();
+                }
+                return;
+            }
+            if (end_stream) {
+                m_stream_compressor.reset();
+            } else if (encoded->empty()) {
+                if (waiter) {
+                    waiter->notify();
+                }
+                return;
+            }
+            payload = Http2PayloadSlice(std::move(encoded.value()));
+        }
+
         m_pending_data.push_back(PendingDataSend{
-            .payload = payload ? std::move(payload) : std::make_shared<const std::string>(),
+            .payload = std::move(payload),
             .offset = 0,
             .end_stream = end_stream,
             .waiter = waiter
@@ -1200,6 +1235,39 @@ public:
         return CompletionAwaitable(shared_from_this(), &m_response_waiter);
     }
 
+    // ==================== 响应压缩 ====================
+
+    /**
+     * @brief 按请求的 accept-encoding 协商本流响应的内容编码
+     * @param setting 压缩配置；未启用或协商结果为 identity 时不压缩
+     * @details 协商结果作用于随后发送的最终响应 HEADERS：可压缩的响应会改写
+     *          content-encoding / vary / etag 并去掉 content-length，其后的 DATA 经流式压缩器输出；
+     *          sendHeadersAndData* 一次给出完整响应体时整体压缩并重写 content-length。
+     *          预编码的头部块（sendEncodedHeaders*）不会被改写。
+     */
+    void negotiateResponseCoding(const galay::http::HttpCompressionSetting& setting) {
+        m_compression = setting;
+        m_response_coding = galay::http::negotiateContentCoding(
+            m_request.getHeader("accept-encoding"), setting);
+        m_response_coding_armed = m_response_coding != galay::http::HttpContentCoding::Identity;
+    }
+
+    /**
+     * @brief 关闭本流尚未生效的响应压缩
+     * @details 处理器自行设置 content-encoding 或发送已压缩内容时调用
+     */
+    void disableResponseCoding() {
+        m_response_coding_armed = false;
+    }
+
+    /**
+     * @brief 获取协商出的响应编码
+     * @return 未协商时返回 std::nullopt
+     */
+    std::optional<galay::http::HttpContentCoding> responseCoding() const {
+        return m_response_coding;
+    }
+
     // ==================== 发送接口 ====================
 
     /**
@@ -1243,6 +1311,15 @@ public:
         sendDataInternal(std::move(data), end_stream, nullptr);
     }
 
+    /**
+     * @brief 以引用计数切片发送 DATA 帧
+     * @details 按帧大小切分时只生成子切片，负载字节直到 writev 都不复制；
+     *          切片所有者在最后一帧写出后释放。
+     */
+    void sendDataSlice(Http2PayloadSlice data, bool end_stream = false) {
+        queueDataForSend(std::move(data), end_stream, nullptr);
+    }
+
     /**
      * @brief 发送 RST_STREAM 帧
      */
@@ -1357,6 +1434,15 @@ public:
         return ReplyAndWaitAwaitable(std::move(waiter));
     }
 
+    /**
+     * @brief 帧优先 API：以引用计数切片发送 DATA 并等待入队完成
+     */
+    ReplyAndWaitAwaitable replyDataSlice(Http2PayloadSlice data, bool end_stream = false) {
+        auto waiter = std::make_shared<Http2OutgoingFrame::Waiter>();
+        queueDataForSend(std::move(data), end_stream, waiter);
+        return ReplyAndWaitAwaitable(std::move(waiter));
+    }
+
     /**
      * @brief 帧优先 API：发送 RST_STREAM 并等待入队完成
      */
@@ -1469,6 +1555,22 @@ public:
         m_weight = weight;
     }
 
+    /**
+     * @brief RFC 9218 可扩展优先级
+     * @details 服务端由请求 `priority` 头部与 PRIORITY_UPDATE 帧设置；
+     *          连接窗口不足时，StreamManager 按 urgency / incremental 决定各流补发 DATA 的顺序。
+     */
+    Http2PriorityParam priorityParam() const { return m_priority_param; }
+    uint8_t urgency() const { return m_priority_param.urgency; }
+    bool incremental() const { return m_priority_param.incremental; }
+
+    void setPriorityParam(Http2PriorityParam priority) {
+        priority.urgency = std::min<uint8_t>(priority.urgency, kHttp2UrgencyLevels - 1);
+        m_priority_param = priority;
+    }
+
+    bool hasPendingData() const { return !m_pending_data.empty(); }  ///< 是否有因窗口不足暂存的 DATA
+
 private:
     explicit Http2Stream(uint32_t stream_id)
         : m_stream_id(stream_id)
@@ -1553,6 +1655,8 @@ private:
     uint8_t m_weight = 16;
     uint32_t m_stream_dependency = 0;
     bool m_exclusive = false;
+    Http2PriorityParam m_priority_param;    ///< RFC 9218 urgency / incremental
+    uint64_t m_priority_served = 0;         ///< 最近一次按优先级补发的序号，用于 incremental 轮转
 
     // 发送队列和编解码器（由 StreamManager 绑定）
     galay::mpsc::UnboundedChannel<Http2OutgoingFrame>* m_send_channel = nullptr;
@@ -1566,6 +1670,12 @@ private:
     bool m_io_attached = false;
     std::function<void(uint32_t)> m_retire_callback;
 
+    // 响应压缩
+    galay::http::HttpCompressionSetting m_compression;
+    std::optional<galay::http::HttpContentCoding> m_response_coding;
+    bool m_response_coding_armed = false;                               ///< 下一个最终响应 HEADERS 是否参与压缩
+    std::optional<galay::http::HttpStreamCompressor> m_stream_compressor; ///< 流式响应体压缩器
+
     template<typename SocketType, ::galay::utils::RingBufferBackendStrategy Strategy>
     friend class Http2StreamManagerImpl;
     template<typename SocketType, ::galay::utils::RingBufferBackendStrategy Strategy>
@@ -1610,6 +1720,8 @@ private:
         m_weight = 16;
         m_stream_dependency = 0;
         m_exclusive = false;
+        m_priority_param = {};
+        m_priority_served = 0;
 
         m_send_channel = nullptr;
         m_send_queue = nullptr;
@@ -1621,6 +1733,11 @@ private:
         m_pending_data.clear();
         m_io_attached = false;
         m_retire_callback = nullptr;
+
+        m_compression = galay::http::HttpCompressionSetting{};
+        m_response_coding.reset();
+        m_response_coding_armed = false;
+        m_stream_compressor.reset();
     }
 
     void sendHeadersInternal(const std::vector<Http2HeaderField>& headers,
@@ -1629,10 +1746,149 @@ private:
                              const Http2OutgoingFrame::WaiterPtr& waiter) {
         if ((!m_send_queue && !m_send_channel) || !m_encoder) return;
 
+        if (m_stream_compressor && end_stream) {
+            // trailers 之前先写出压缩尾部
+            auto tail = m_stream_compressor->update({}, true);
+            m_stream_compressor.reset();
+            if (tail && !tail->empty()) {
+                queueDataForSend(std::make_shared<const std::string>(std::move(tail.value())), false, nullptr);
+            }
+        }
+
+        if (m_response_coding_armed && !end_stream && isFinalResponseHeaders(headers)) {
+            m_response_coding_armed = false;
+            if (isEncodableResponseHeaders(headers)) {
+                auto created = galay::http::HttpStreamCompressor::create(
+                    *m_response_coding, m_compression.levelFor(*m_response_coding));
+                if (created) {
+                    m_stream_compressor.emplace(std::move(created.value()));
+                    auto encoded_headers = rewriteEncodedResponseHeaders(headers, std::nullopt);
+                    std::string header_block = m_encoder->encode(encoded_headers);
+                    sendEncodedHeadersInternal(std::move(header_block), end_stream, end_headers, waiter);
+                    return;
+                }
+            }
+        }
+
         std::string header_block = m_encoder->encode(headers);
         sendEncodedHeadersInternal(std::move(header_block), end_stream, end_headers, waiter);
     }
 
+    static std::string_view findHeaderValue(const std::vector<Http2HeaderField>& headers,
+                                            std::string_view name) {
+        for (const auto& field : headers) {
+            if (field.name == name) {
+                return field.value;
+            }
+        }
+        return {};
+    }
+
+    static bool isFinalResponseHeaders(const std::vector<Http2HeaderField>& headers) {
+        const auto status = findHeaderValue(headers, ":status");
+        return !status.empty() && status.front() != '1';
+    }
+
+    static bool containsToken(std::string_view value, std::string_view token) {
+        size_t pos = 0;
+        while (pos <= value.size()) {
+            size_t end = value.find(',', pos);
+            if (end == std::string_view::npos) {
+                end = value.size();
+            }
+            auto item = value.substr(pos, end - pos);
+            while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) item.remove_prefix(1);
+            while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) item.remove_suffix(1);
+            if (item.size() == token.size() &&
+                std::equal(item.begin(), item.end(), token.begin(), [](char a, char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) ==
+                           std::tolower(static_cast<unsigned char>(b));
+                })) {
+                return true;
+            }
+            pos = end + 1;
+        }
+        return false;
+    }
+
+    // 与 HttpWriter 相同的压缩条件：2xx/3xx/4xx/5xx 中排除 204/206/304，
+    // 未自带编码与 Content-Range，未声明 no-transform，且 Content-Type 可压缩
+    static bool isEncodableResponseHeaders(const std::vector<Http2HeaderField>& headers) {
+        const auto status = findHeaderValue(headers, ":status");
+        if (status == "204" || status == "206" || status == "304") {
+            return false;
+        }
+        bool has_type = false;
+        for (const auto& field : headers) {
+            if (field.name == "content-encoding" || field.name == "content-range") {
+                return false;
+            }
+            if (field.name == "cache-control" && containsToken(field.value, "no-transform")) {
+                return false;
+            }
+            if (field.name == "content-type") {
+                if (!galay::http::isCompressibleMimeType(field.value)) {
+                    return false;
+                }
+                has_type = true;
+            }
+        }
+        return has_type;
+    }
+
+    std::vector<Http2HeaderField> rewriteEncodedResponseHeaders(
+        const std::vector<Http2HeaderField>& headers,
+        std::optional<size_t> content_length) const {
+        std::vector<Http2HeaderField> rewritten;
+        rewritten.reserve(headers.size() + 2);
+        bool has_vary = false;
+        for (const auto& field : headers) {
+            if (field.name == "content-length") {
+                continue;
+            }
+            if (field.name == "vary") {
+                has_vary = true;
+                if (!containsToken(field.value, "accept-encoding") && !containsToken(field.value, "*")) {
+                    rewritten.push_back({field.name, field.value + ", accept-encoding"});
+                    continue;
+                }
+            } else if (field.name == "etag" && !field.value.starts_with("W/")) {
+                // 编码后的表示与原表示字节不同，强 ETag 必须弱化
+                rewritten.push_back({field.name, "W/" + field.value});
+                continue;
+            }
+            rewritten.push_back(field);
+        }
+        rewritten.push_back({"content-encoding", std::string(galay::http::contentCodingToken(*m_response_coding))});
+        if (!has_vary) {
+            rewritten.push_back({"vary", "accept-encoding"});
+        }
+        if (content_length.has_value()) {
+            rewritten.push_back({"content-length", std::to_string(*content_length)});
+        }
+        return rewritten;
+    }
+
+    // 完整响应体一次性压缩；返回改写后的头部，不压缩时返回 std::nullopt
+    std::optional<std::vector<Http2HeaderField>> encodeWholeResponse(
+        const std::vector<Http2HeaderField>& headers,
+        std::string& data) {
+        if (!m_response_coding_armed || !isFinalResponseHeaders(headers)) {
+            return std::nullopt;
+        }
+        m_response_coding_armed = false;
+        if (data.size() < m_compression.getMinLength() || !isEncodableResponseHeaders(headers)) {
+            return std::nullopt;
+        }
+        auto encoded = galay::http::compressContent(
+            *m_response_coding, data, m_compression.levelFor(*m_response_coding));
+        if (!encoded) {
+            return std::nullopt;
+        }
+        data = std::move(encoded.value());
+        return rewriteEncodedResponseHeaders(headers, data.size());
+    }
+
     void sendEncodedHeadersInternal(const std::string& header_block,
                                     bool end_stream,
                                     bool end_headers,
@@ -1779,6 +2035,15 @@ private:
             return;
         }
 
+        if (m_response_coding_armed) {
+            if (auto encoded_headers = encodeWholeResponse(headers, data)) {
+                auto header_block = m_encoder->encode(*encoded_headers);
+                sendEncodedHeadersAndDataInternal(
+                    std::move(header_block), std::move(data), end_headers, waiter);
+                return;
+            }
+        }
+
         auto header_block = m_encoder->encode(headers);
         sendEncodedHeadersAndDataInternal(std::move(header_block), std::move(data), end_headers, waiter);
     }
@@ -1794,6 +2059,34 @@ private:
             return;
         }
 
+        if (m_response_coding_armed && chunks.size() > 1) {
+            size_t total = 0;
+            for (const auto& chunk : chunks) {
+                total += chunk.size();
+            }
+            if (total < m_compression.getMinLength() || !isEncodableResponseHeaders(headers)) {
+                m_response_coding_armed = !isFinalResponseHeaders(headers);
+                auto header_block = m_encoder->encode(headers);
+                sendEncodedHeadersAndDataChunksInternal(
+                    std::move(header_block), std::move(chunks), end_headers, waiter);
+                return;
+            }
+            std::string body;
+            body.reserve(total);
+            for (const auto& chunk : chunks) {
+                body.append(chunk);
+            }
+            if (auto encoded_headers = encodeWholeResponse(headers, body)) {
+                auto header_block = m_encoder->encode(*encoded_headers);
+                sendEncodedHeadersAndDataInternal(
+                    std::move(header_block), std::move(body), end_headers, waiter);
+                return;
+            }
+        } else if (m_response_coding_armed && chunks.size() == 1) {
+            sendHeadersAndDataInternal(headers, std::move(chunks.front()), end_headers, waiter);
+            return;
+        }
+
         auto header_block = m_encoder->encode(headers);
         sendEncodedHeadersAndDataChunksInternal(
             std::move(header_block), std::move(chunks), end_headers, waiter);
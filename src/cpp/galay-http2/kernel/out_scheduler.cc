@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <limits>
 #include <string_view>
+#include <utility>
 
 namespace galay::http2
 {
@@ -27,15 +28,6 @@ size_t frontPendingSize(const H2PendingData& pending)
     return pending.chunks.front().size() - pending.front_offset;
 }
 
-std::string takeFrontData(H2PendingData& pending, size_t bytes)
-{
-    const auto& front = pending.chunks.front();
-    std::string out = front.substr(pending.front_offset, bytes);
-    pending.front_offset += bytes;
-    normalizePending(pending);
-    return out;
-}
-
 bool shouldSendEndStreamOnly(const H2PendingData& pending)
 {
     return pending.end_stream && pending.chunks.empty();
@@ -92,25 +84,23 @@ void drainFrameQueueBytes(std::deque<Http2Frame::uptr>& queue, H2OutboundBytesSe
     }
 }
 
-} // namespace
-
-H2OutboundSelection Http2OutboundScheduler::pickSendableFrames(H2OutboundBudget budget,
-                                                                std::vector<H2StreamSendState>& streams,
-                                                                H2SchedulerConfig config)
+/**
+ * DRR 选择 DATA：emit(stream_id, payload, end_stream) 接收每个选中帧的负载子切片，
+ * 负载为空且 end_stream 为 true 的调用表示只发送 END_STREAM。
+ */
+template<typename Emit>
+size_t selectDataWeighted(H2OutboundBudget budget,
+                          std::vector<H2StreamSendState>& streams,
+                          const H2SchedulerConfig& config,
+                          Emit&& emit)
 {
-    H2OutboundSelection out;
-    if (budget.max_frame_size == 0) {
-        return out;
-    }
-    out.frames.reserve(estimateDataFrameReserve(budget));
-
+    size_t total_data_bytes = 0;
     for (auto& stream : streams) {
         normalizePending(stream.pending);
 
         if (shouldSendEndStreamOnly(stream.pending)) {
-            auto frame = Http2FrameBuilder::data(stream.stream_id, "", true);
+            emit(stream.stream_id, Http2PayloadSlice{}, true);
             stream.pending.end_stream = false;
-            out.frames.push_back(std::move(frame));
             continue;
         }
     }
@@ -145,24 +135,23 @@ H2OutboundSelection Http2OutboundScheduler::pickSendableFrames(H2OutboundBudget
                     break;
                 }
 
-                auto payload = takeFrontData(stream.pending, chunk);
-                auto frame = Http2FrameBuilder::data(stream.stream_id,
-                                                     std::move(payload),
-                                                     false);
-
+                const auto& front = stream.pending.chunks.front();
+                const bool send_end = stream.pending.end_stream &&
+                                      stream.pending.chunks.size() == 1 &&
+                                      stream.pending.front_offset + chunk == front.size();
+                emit(stream.stream_id, front.subslice(stream.pending.front_offset, chunk), send_end);
+                stream.pending.front_offset += chunk;
+                normalizePending(stream.pending);
                 budget.conn_window -= static_cast<int32_t>(chunk);
                 stream.stream_window -= static_cast<int32_t>(chunk);
                 stream.deficit -= chunk;
-                out.total_data_bytes += chunk;
+                total_data_bytes += chunk;
                 progressed = true;
 
-                const bool send_end = stream.pending.end_stream && stream.pending.chunks.empty();
                 if (send_end) {
                     stream.pending.end_stream = false;
                     stream.queued = false;
                 }
-                frame->setEndStream(send_end);
-                out.frames.push_back(std::move(frame));
 
                 if (budget.conn_window <= 0) {
                     break;
@@ -177,7 +166,146 @@ H2OutboundSelection Http2OutboundScheduler::pickSendableFrames(H2OutboundBudget
             break;
         }
     }
+    return total_data_bytes;
+}
+
+/**
+ * RFC 9218 选择 DATA：每次取最高 urgency 环的队首发送一帧；
+ * 非 incremental 流留在队首直到发完或被窗口阻塞，incremental 流发送一帧后轮转到环尾。
+ */
+template<typename Emit>
+size_t selectDataExtensible(H2OutboundBudget budget,
+                            std::vector<H2StreamSendState>& streams,
+                            Emit&& emit)
+{
+    size_t total_data_bytes = 0;
+    uint64_t served_seq = 0;
+    H2UrgencyBuckets<size_t> buckets;
+    for (size_t i = 0; i < streams.size(); ++i) {
+        auto& stream = streams[i];
+        normalizePending(stream.pending);
+        served_seq = std::max(served_seq, stream.last_served);
+
+        if (shouldSendEndStreamOnly(stream.pending)) {
+            emit(stream.stream_id, Http2PayloadSlice{}, true);
+            stream.pending.end_stream = false;
+            stream.queued = false;
+            continue;
+        }
+
+        stream.queued = !stream.pending.chunks.empty() && stream.stream_window > 0;
+        if (stream.queued) {
+            buckets.push(i, Http2PriorityParam{stream.urgency, stream.incremental}, stream.last_served);
+        }
+    }
+    buckets.arrange();
+
+    while (budget.conn_window > 0 && !buckets.empty()) {
+        auto& stream = streams[buckets.front()];
+        const size_t chunk = std::min<size_t>({
+            static_cast<size_t>(budget.conn_window),
+            static_cast<size_t>(std::max<int32_t>(stream.stream_window, 0)),
+            static_cast<size_t>(budget.max_frame_size),
+            frontPendingSize(stream.pending)
+        });
+        if (chunk == 0) {
+            stream.queued = false;
+            buckets.popFront();
+            continue;
+        }
 
+        const auto& front = stream.pending.chunks.front();
+        const bool send_end = stream.pending.end_stream &&
+                              stream.pending.chunks.size() == 1 &&
+                              stream.pending.front_offset + chunk == front.size();
+        emit(stream.stream_id, front.subslice(stream.pending.front_offset, chunk), send_end);
+        stream.pending.front_offset += chunk;
+        normalizePending(stream.pending);
+        budget.conn_window -= static_cast<int32_t>(chunk);
+        stream.stream_window -= static_cast<int32_t>(chunk);
+        stream.last_served = ++served_seq;
+        total_data_bytes += chunk;
+        if (send_end) {
+            stream.pending.end_stream = false;
+        }
+
+        if (stream.pending.chunks.empty() || stream.stream_window <= 0) {
+            stream.queued = false;
+            buckets.popFront();
+        } else if (buckets.frontIncremental()) {
+            buckets.rotateFront();
+        }
+    }
+    return total_data_bytes;
+}
+
+template<typename Emit>
+size_t selectData(H2OutboundBudget budget,
+                  std::vector<H2StreamSendState>& streams,
+                  const H2SchedulerConfig& config,
+                  Emit&& emit)
+{
+    if (config.mode == H2SchedulingMode::Extensible) {
+        return selectDataExtensible(budget, streams, std::forward<Emit>(emit));
+    }
+    return selectDataWeighted(budget, streams, config, std::forward<Emit>(emit));
+}
+
+void drainFrameQueueSlices(std::deque<Http2Frame::uptr>& queue, H2OutboundSliceSelection& out)
+{
+    while (!queue.empty()) {
+        H2OutboundSliceFrame frame;
+        frame.payload = Http2PayloadSlice(queue.front()->serialize());
+        out.frames.push_back(std::move(frame));
+        queue.pop_front();
+    }
+}
+
+} // namespace
+
+size_t H2OutboundSliceSelection::fillIovecs(std::vector<struct iovec>& out) const
+{
+    out.clear();
+    out.reserve(frames.size() * 2);
+    for (const auto& frame : frames) {
+        if (frame.prelude_length > 0) {
+            out.push_back({
+                .iov_base = const_cast<char*>(frame.prelude.data()),
+                .iov_len = frame.prelude_length,
+            });
+        }
+        if (!frame.payload.empty()) {
+            out.push_back({
+                .iov_base = const_cast<char*>(frame.payload.data()),
+                .iov_len = frame.payload.size(),
+            });
+        }
+    }
+    return out.size();
+}
+
+size_t H2OutboundSliceSelection::wireBytes() const
+{
+    size_t bytes = 0;
+    for (const auto& frame : frames) {
+        bytes += frame.prelude_length + frame.payload.size();
+    }
+    return bytes;
+}
+
+H2OutboundSelection Http2OutboundScheduler::pickSendableFrames(H2OutboundBudget budget,
+                                                                std::vector<H2StreamSendState>& streams,
+                                                                H2SchedulerConfig config)
+{
+    H2OutboundSelection out;
+    if (budget.max_frame_size == 0) {
+        return out;
+    }
+    out.frames.reserve(estimateDataFrameReserve(budget));
+    out.total_data_bytes = selectData(budget, streams, config,
+        [&out](uint32_t stream_id, const Http2PayloadSlice& payload, bool end_stream) {
+            out.frames.push_back(Http2FrameBuilder::data(stream_id, std::string(payload.view()), end_stream));
+        });
     return out;
 }
 
@@ -228,81 +356,49 @@ H2OutboundBytesSelection Http2OutboundScheduler::pickSendableBytes(H2OutboundBud
         return out;
     }
     out.frames.reserve(estimateDataFrameReserve(budget));
+    out.total_data_bytes = selectData(budget, streams, config,
+        [&out](uint32_t stream_id, const Http2PayloadSlice& payload, bool end_stream) {
+            out.frames.push_back(Http2FrameBuilder::dataBytes(stream_id, payload.view(), end_stream));
+        });
+    return out;
+}
 
-    for (auto& stream : streams) {
-        normalizePending(stream.pending);
+H2OutboundSliceSelection Http2OutboundScheduler::pickSendableSlices(H2OutboundBudget budget,
+                                                                     H2OutboundQueues& queues,
+                                                                     H2SchedulerConfig config)
+{
+    H2OutboundSliceSelection out;
+    out.frames.reserve(saturatedAdd(
+        saturatedAdd(queues.control_frames.size(), queues.header_frames.size()),
+        estimateDataFrameReserve(budget)));
+    drainFrameQueueSlices(queues.control_frames, out);
+    drainFrameQueueSlices(queues.header_frames, out);
 
-        if (shouldSendEndStreamOnly(stream.pending)) {
-            out.frames.push_back(Http2FrameBuilder::dataBytes(stream.stream_id, "", true));
-            stream.pending.end_stream = false;
-            continue;
-        }
+    auto data = pickSendableSlices(budget, queues.data_streams, config);
+    out.total_data_bytes = data.total_data_bytes;
+    for (auto& frame : data.frames) {
+        out.frames.push_back(std::move(frame));
     }
+    return out;
+}
 
-    while (budget.conn_window > 0) {
-        bool progressed = false;
-
-        for (auto& stream : streams) {
-            normalizePending(stream.pending);
-            if (stream.pending.chunks.empty() || stream.stream_window <= 0) {
-                stream.queued = false;
-                continue;
-            }
-
-            stream.queued = true;
-            const size_t quantum = quantumFor(stream, config);
-            stream.deficit = std::min(std::numeric_limits<size_t>::max() - quantum,
-                                      stream.deficit) + quantum;
-
-            while (!stream.pending.chunks.empty() &&
-                   stream.stream_window > 0 &&
-                   budget.conn_window > 0 &&
-                   stream.deficit > 0) {
-                const size_t chunk = std::min<size_t>({
-                    static_cast<size_t>(budget.conn_window),
-                    static_cast<size_t>(stream.stream_window),
-                    static_cast<size_t>(budget.max_frame_size),
-                    frontPendingSize(stream.pending),
-                    stream.deficit
-                });
-                if (chunk == 0) {
-                    break;
-                }
-
-                const auto& front = stream.pending.chunks.front();
-                const std::string_view payload(front.data() + stream.pending.front_offset, chunk);
-                const bool send_end = stream.pending.end_stream &&
-                                      stream.pending.chunks.size() == 1 &&
-                                      stream.pending.front_offset + chunk == front.size();
-                auto frame = Http2FrameBuilder::dataBytes(stream.stream_id, payload, send_end);
-                stream.pending.front_offset += chunk;
-                normalizePending(stream.pending);
-                budget.conn_window -= static_cast<int32_t>(chunk);
-                stream.stream_window -= static_cast<int32_t>(chunk);
-                stream.deficit -= chunk;
-                out.total_data_bytes += chunk;
-                progressed = true;
-
-                if (send_end) {
-                    stream.pending.end_stream = false;
-                    stream.queued = false;
-                }
-                out.frames.push_back(std::move(frame));
-
-                if (budget.conn_window <= 0) {
-                    break;
-                }
-            }
-            if (budget.conn_window <= 0) {
-                break;
-            }
-        }
-
-        if (!progressed) {
-            break;
-        }
+H2OutboundSliceSelection Http2OutboundScheduler::pickSendableSlices(H2OutboundBudget budget,
+                                                                     std::vector<H2StreamSendState>& streams,
+                                                                     H2SchedulerConfig config)
+{
+    H2OutboundSliceSelection out;
+    if (budget.max_frame_size == 0) {
+        return out;
     }
-
+    out.frames.reserve(estimateDataFrameReserve(budget));
+    out.total_data_bytes = selectData(budget, streams, config,
+        [&out](uint32_t stream_id, Http2PayloadSlice&& payload, bool end_stream) {
+            H2OutboundSliceFrame frame;
+            frame.prelude = Http2FrameBuilder::dataHeaderBytes(stream_id, payload.size(), end_stream);
+            frame.prelude_length = static_cast<uint8_t>(kHttp2FrameHeaderLength);
+            frame.payload = std::move(payload);
+            out.frames.push_back(std::move(frame));
+        });
     return out;
 }
 
@@ -6,17 +6,26 @@
  *
  * @details 提供 Http2OutboundScheduler，负责 HTTP/2 出站帧的调度，
  *          管理连接级和流级的流量控制窗口，决定哪些流可以发送 DATA 帧。
+ *          DATA 负载以 Http2PayloadSlice 排队，pickSendableSlices 只产出 9 字节帧头与负载切片，
+ *          由调用方一次 writev 写出，负载字节不再复制。
+ *          DATA 选择支持两种模式：按 weight 的 DRR，以及 RFC 9218 可扩展优先级（urgency + incremental）。
  */
 
 #ifndef GALAY_HTTP2_OUTBOUND_SCHEDULER_H
 #define GALAY_HTTP2_OUTBOUND_SCHEDULER_H
 
+#include "payload_slice.h"
 #include "../protoc/http2_frame.h"
+#include "../protoc/http2_priority.h"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <string>
 #include <vector>
+#include <sys/uio.h>
 
 namespace galay::http2
 {
@@ -33,36 +42,141 @@ struct H2OutboundBudget
 
 /**
  * @brief HTTP/2 待发送 DATA 缓冲
- * @details chunks 保存原始数据块，front_offset 表示首块已发送偏移，
- *          避免通过字符串头部 erase 搬移剩余数据。
+ * @details chunks 保存引用计数的负载切片，front_offset 表示首块已发送偏移，
+ *          按帧切分时只取子切片，不复制负载。
  */
 struct H2PendingData
 {
-    std::deque<std::string> chunks;         ///< 待发送数据块
+    std::deque<Http2PayloadSlice> chunks;   ///< 待发送数据块
     size_t front_offset = 0;                ///< 首块已发送偏移
     bool end_stream = false;                ///< 数据发送完后是否发送 END_STREAM
 };
 
 /**
  * @brief HTTP/2 流发送状态
- * @details 单个流的发送窗口、待发送数据和优先级权重
+ * @details 单个流的发送窗口、待发送数据和优先级（DRR 权重 / 可扩展优先级参数）
  */
 struct H2StreamSendState
 {
     H2PendingData pending;                  ///< 待发送 DATA 缓冲
     size_t deficit = 0;                     ///< DRR 当前可用发送额度
+    uint64_t last_served = 0;               ///< 可扩展优先级模式下最近一次被选中的序号，用于跨调用延续轮转
     uint32_t stream_id = 0;                 ///< 流 ID
     int32_t stream_window = 0;              ///< 流级流量控制窗口
     uint8_t weight = 16;                    ///< 流优先级权重
+    uint8_t urgency = kHttp2DefaultUrgency; ///< RFC 9218 urgency，0 最高
+    bool incremental = false;               ///< RFC 9218 incremental
     bool queued = false;                    ///< 是否已经进入调度轮转
 };
 
+/**
+ * @brief DATA 调度模式
+ */
+enum class H2SchedulingMode : uint8_t
+{
+    WeightedDrr,    ///< 按 weight 的赤字轮转（RFC 7540 权重语义）
+    Extensible,     ///< RFC 9218：urgency 严格优先，同级非 incremental 逐个发完、incremental 轮转
+};
+
 /**
  * @brief HTTP/2 出站调度配置
  */
 struct H2SchedulerConfig
 {
     size_t base_quantum = 16 * 1024;        ///< DRR 基础 quantum，实际额度乘以 stream weight
+    H2SchedulingMode mode = H2SchedulingMode::WeightedDrr; ///< DATA 调度模式
+};
+
+/**
+ * @brief 可扩展优先级的 urgency 桶环
+ * @details 每个 urgency 两个环：非 incremental 流按加入顺序逐个发完，incremental 流轮转交错。
+ *          环下标为 urgency * 2 + incremental，位图记录非空环，countr_zero 直接得到当前最优先的环，
+ *          front / popFront / rotateFront 均为 O(1)。同一 urgency 下非 incremental 先于 incremental。
+ * @tparam T 环元素（流下标或流指针）
+ */
+template<typename T>
+class H2UrgencyBuckets
+{
+public:
+    static constexpr size_t kRingCount = static_cast<size_t>(kHttp2UrgencyLevels) * 2;
+
+    /**
+     * @brief 加入一个待调度元素
+     * @param item 元素
+     * @param priority 优先级参数，urgency 超出 0–7 时按 7 处理
+     * @param last_served 最近一次被选中的序号；incremental 环在 arrange() 后按其升序排列
+     */
+    void push(T item, Http2PriorityParam priority, uint64_t last_served = 0) {
+        const size_t urgency = std::min<size_t>(priority.urgency, kHttp2UrgencyLevels - 1);
+        const size_t ring = urgency * 2 + (priority.incremental ? 1 : 0);
+        m_rings[ring].push_back(Entry{std::move(item), last_served});
+        m_mask |= static_cast<uint16_t>(1u << ring);
+        ++m_size;
+    }
+
+    /**
+     * @brief 整理 incremental 环，使最久未被选中的元素在前
+     * @details 调度器每次重建桶时调用，保证跨调用的轮转不从同一个流重新开始。
+     */
+    void arrange() {
+        for (size_t ring = 1; ring < kRingCount; ring += 2) {
+            std::stable_sort(m_rings[ring].begin(), m_rings[ring].end(),
+                             [](const Entry& lhs, const Entry& rhs) {
+                                 return lhs.last_served < rhs.last_served;
+                             });
+        }
+    }
+
+    bool empty() const { return m_mask == 0; }     ///< 是否没有待调度元素
+    size_t size() const { return m_size; }         ///< 待调度元素数
+
+    T& front() { return m_rings[topRing()].front().item; }                 ///< 当前最优先元素
+    bool frontIncremental() const { return (topRing() & 1u) != 0; }        ///< 当前元素是否 incremental
+    uint8_t frontUrgency() const { return static_cast<uint8_t>(topRing() / 2); } ///< 当前元素 urgency
+
+    /**
+     * @brief 移除当前元素
+     */
+    void popFront() {
+        const size_t ring = topRing();
+        m_rings[ring].pop_front();
+        --m_size;
+        if (m_rings[ring].empty()) {
+            m_mask &= static_cast<uint16_t>(~(1u << ring));
+        }
+    }
+
+    /**
+     * @brief 清空全部环，保留已分配容量
+     */
+    void clear() {
+        for (auto& ring : m_rings) {
+            ring.clear();
+        }
+        m_size = 0;
+        m_mask = 0;
+    }
+
+    /**
+     * @brief 当前元素移到所在环尾部（incremental 轮转）
+     */
+    void rotateFront() {
+        auto& ring = m_rings[topRing()];
+        ring.push_back(std::move(ring.front()));
+        ring.pop_front();
+    }
+
+private:
+    struct Entry {
+        T item;
+        uint64_t last_served = 0;
+    };
+
+    size_t topRing() const { return static_cast<size_t>(std::countr_zero(m_mask)); }
+
+    std::array<std::deque<Entry>, kRingCount> m_rings;  ///< 按 urgency / incremental 分组的环
+    size_t m_size = 0;                                  ///< 元素总数
+    uint16_t m_mask = 0;                                ///< 非空环位图
 };
 
 /**
@@ -85,6 +199,41 @@ struct H2OutboundBytesSelection
     size_t total_data_bytes = 0;            ///< 总 DATA payload 字节数
 };
 
+/**
+ * @brief HTTP/2 出站切片帧
+ * @details DATA 帧由 prelude 中的 9 字节帧头与负载切片组成；控制帧与 HEADERS 帧已整体序列化，
+ *          prelude_length 为 0，全部字节都在 payload 中。
+ */
+struct H2OutboundSliceFrame
+{
+    std::array<char, kHttp2FrameHeaderLength> prelude{}; ///< DATA 帧头
+    uint8_t prelude_length = 0;             ///< prelude 有效字节数，0 或 kHttp2FrameHeaderLength
+    Http2PayloadSlice payload;              ///< 负载切片（或整帧字节）
+};
+
+/**
+ * @brief HTTP/2 出站切片调度选择结果
+ * @details frames 连续存放帧头，作为本次写出的帧头 arena；选择完成后不再增删，
+ *          fillIovecs 导出的 iovec 在 selection 存活期间有效。
+ */
+struct H2OutboundSliceSelection
+{
+    std::vector<H2OutboundSliceFrame> frames; ///< 选中的帧
+    size_t total_data_bytes = 0;            ///< 总 DATA payload 字节数
+
+    /**
+     * @brief 导出本次写出的 iovec 列表
+     * @param out 输出容器，先清空；调用方可复用其容量
+     * @return iovec 数量
+     */
+    size_t fillIovecs(std::vector<struct iovec>& out) const;
+
+    /**
+     * @brief 线上总字节数（帧头 + 负载）
+     */
+    size_t wireBytes() const;
+};
+
 /**
  * @brief HTTP/2 出站队列
  * @details 控制帧和 HEADERS 不受 DATA flow control 阻塞，DATA 由 data_streams 调度。
@@ -117,6 +266,19 @@ public:
     static H2OutboundBytesSelection pickSendableBytes(H2OutboundBudget budget,
                                                       std::vector<H2StreamSendState>& streams,
                                                       H2SchedulerConfig config = {});
+
+    /**
+     * @brief 调度出站队列并产出切片帧
+     * @details 与 pickSendableBytes 的调度顺序与 DRR 额度一致；DATA 帧只生成帧头，
+     *          负载为待发送切片的子切片，不复制字节。
+     */
+    static H2OutboundSliceSelection pickSendableSlices(H2OutboundBudget budget,
+                                                       H2OutboundQueues& queues,
+                                                       H2SchedulerConfig config = {});
+
+    static H2OutboundSliceSelection pickSendableSlices(H2OutboundBudget budget,
+                                                       std::vector<H2StreamSendState>& streams,
+                                                       H2SchedulerConfig config = {});
 };
 
 } // namespace galay::http2
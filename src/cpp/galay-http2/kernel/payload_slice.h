@@ -0,0 +1,127 @@
+/**
+ * @file payload_slice.h
+ * @brief HTTP/2 DATA 负载的引用计数切片
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details Http2PayloadSlice 是对一段只读内存的视图，同时持有该内存所有者的引用。
+ *          DATA 帧按帧大小切分、跨队列转移或被多个流共享时只复制切片（指针 + 长度 + 引用计数），
+ *          不复制负载字节；所有者可以是 std::string，也可以是任意以 shared_ptr 管理的区域。
+ */
+
+#ifndef GALAY_HTTP2_PAYLOAD_SLICE_H
+#define GALAY_HTTP2_PAYLOAD_SLICE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace galay::http2
+{
+
+/**
+ * @brief 引用计数的只读负载切片
+ * @details 复制切片只增加所有者引用计数；子切片与原切片共享同一所有者。
+ *          切片不可修改底层字节，所有者在最后一个切片析构时释放。
+ */
+class Http2PayloadSlice
+{
+public:
+    Http2PayloadSlice() = default;
+
+    /**
+     * @brief 接管字符串作为切片所有者
+     * @param data 负载字节，移动到共享存储中；空字符串不分配
+     */
+    Http2PayloadSlice(std::string data) {
+        if (data.empty()) {
+            return;
+        }
+        auto owner = std::make_shared<const std::string>(std::move(data));
+        m_data = owner->data();
+        m_size = owner->size();
+        m_owner = std::move(owner);
+    }
+
+    /**
+     * @brief 复制 C 字符串作为切片所有者
+     * @param data 以 '\0' 结尾的负载
+     */
+    Http2PayloadSlice(const char* data)
+        : Http2PayloadSlice(std::string(data == nullptr ? "" : data)) {}
+
+    /**
+     * @brief 引用共享字符串的全部内容
+     * @param owner 共享负载，可为空
+     */
+    Http2PayloadSlice(std::shared_ptr<const std::string> owner)
+        : Http2PayloadSlice(std::move(owner), 0, std::string::npos) {}
+
+    /**
+     * @brief 引用共享字符串的一段区间
+     * @param owner 共享负载，可为空
+     * @param offset 起始偏移，超出末尾时得到空切片
+     * @param length 长度，超出剩余字节时截断
+     */
+    Http2PayloadSlice(std::shared_ptr<const std::string> owner, size_t offset, size_t length) {
+        if (!owner || offset >= owner->size()) {
+            return;
+        }
+        m_data = owner->data() + offset;
+        m_size = std::min(length, owner->size() - offset);
+        m_owner = std::move(owner);
+    }
+
+    /**
+     * @brief 引用任意所有者管理的内存区域
+     * @param owner 区域所有者（如文件映射、内存池块），切片存活期间保持引用
+     * @param data 区域起始地址，必须在 owner 的生命周期内有效
+     * @param size 区域字节数
+     * @return 切片
+     */
+    static Http2PayloadSlice fromRegion(std::shared_ptr<const void> owner, const char* data, size_t size) {
+        Http2PayloadSlice slice;
+        if (data == nullptr || size == 0) {
+            return slice;
+        }
+        slice.m_owner = std::move(owner);
+        slice.m_data = data;
+        slice.m_size = size;
+        return slice;
+    }
+
+    const char* data() const noexcept { return m_data; }                        ///< 负载起始地址
+    size_t size() const noexcept { return m_size; }                            ///< 负载字节数
+    bool empty() const noexcept { return m_size == 0; }                         ///< 是否为空
+    std::string_view view() const noexcept { return {m_data, m_size}; }         ///< 负载视图
+    const std::shared_ptr<const void>& owner() const noexcept { return m_owner; } ///< 所有者引用
+
+    /**
+     * @brief 取子切片，与本切片共享所有者
+     * @param offset 相对本切片的起始偏移
+     * @param length 长度，超出剩余字节时截断
+     * @return 子切片；offset 超出末尾时为空切片
+     */
+    Http2PayloadSlice subslice(size_t offset, size_t length = std::string::npos) const {
+        if (offset >= m_size) {
+            return {};
+        }
+        return fromRegion(m_owner, m_data + offset, std::min(length, m_size - offset));
+    }
+
+    friend bool operator==(const Http2PayloadSlice& lhs, std::string_view rhs) noexcept {
+        return lhs.view() == rhs;
+    }
+
+private:
+    std::shared_ptr<const void> m_owner;    ///< 底层内存所有者
+    const char* m_data = nullptr;           ///< 切片起始地址
+    size_t m_size = 0;                      ///< 切片字节数
+};
+
+} // namespace galay::http2
+
+#endif // GALAY_HTTP2_PAYLOAD_SLICE_H
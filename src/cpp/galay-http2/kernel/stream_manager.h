@@ -608,6 +608,14 @@ private:
         if (m_next_local_stream_id == 0) {
             m_next_local_stream_id = m_conn.isClient() ? 3 : 2;
         }
+        const uint32_t local_initial_window = m_conn.localSettings().initial_window_size == 0
+            ? kDefaultInitialWindowSize
+            : m_conn.localSettings().initial_window_size;
+        const uint32_t base_conn_window = m_conn.runtimeConfig().flow_control_target_window == 0
+            ? local_initial_window
+            : m_conn.runtimeConfig().flow_control_target_window;
+        m_conn.windowTuner().configure(
+            m_conn.runtimeConfig().adaptive_window, base_conn_window, local_initial_window);
         if (!m_conn.isClient()) {
             const uint32_t target_window = m_conn.runtimeConfig().flow_control_target_window;
             const int32_t current_window = m_conn.connRecvWindow();
@@ -1039,6 +1047,7 @@ private:
 
                 // 连接级帧
                 if (frame->isSettings() || frame->isPing() || frame->isGoAway() ||
+                    frame->isPriorityUpdate() ||
                     (frame->isWindowUpdate() && stream_id == 0)) {
                     handleConnectionFrame(std::move(frame));
                     continue;
@@ -1222,6 +1231,7 @@ private:
                     }
 
                     if (frame->isSettings() || frame->isPing() || frame->isGoAway() ||
+                        frame->isPriorityUpdate() ||
                         (frame->isWindowUpdate() && stream_id == 0)) {
                         handleConnectionFrame(std::move(frame));
                         continue;
@@ -1416,6 +1426,8 @@ private:
                 break;
             }
 
+            m_conn.windowTuner().onIdleCheck(now);
+
             if (!m_conn.runtimeConfig().ping_enabled ||
                 m_conn.runtimeConfig().ping_interval.count() <= 0) {
                 continue;
@@ -1668,9 +1680,8 @@ private:
                         stream->m_max_frame_size = m_conn.peerSettings().max_frame_size;
                         stream->m_max_header_list_size =
                             m_conn.peerSettings().max_header_list_size;
-                        const bool made_progress = stream->flushPendingData();
-                        // made_progress only reports whether queued DATA was flushed now.
                     });
+                    flushBlockedStreams();
 
                     Http2SettingsFrame ack;
                     ack.setAck(true);
@@ -1690,9 +1701,14 @@ private:
                     pong.setOpaqueData(ping->opaqueData());
                     pong.setAck(true);
                     enqueueSendFrame(std::move(pong));
+                } else if (m_conn.windowTuner().isProbeAck(ping->opaqueData())) {
+                    if (m_conn.windowTuner().onProbeAck(std::chrono::steady_clock::now())) {
+                        growConnRecvWindow();
+                    }
                 } else if (m_waiting_ping_ack &&
                            std::memcmp(ping->opaqueData(), m_last_ping_payload.data(), 8) == 0) {
                     m_waiting_ping_ack = false;
+                    m_conn.windowTuner().onRttSample(std::chrono::steady_clock::now() - m_last_ping_sent_at);
                 }
                 break;
             }
@@ -1741,9 +1757,31 @@ private:
                     stream->m_max_frame_size = m_conn.peerSettings().max_frame_size;
                     stream->m_max_header_list_size =
                         m_conn.peerSettings().max_header_list_size;
-                    const bool made_progress = stream->flushPendingData();
-                    // made_progress only reports whether queued DATA was flushed now.
                 });
+                flushBlockedStreams();
+                break;
+            }
+
+            case Http2FrameType::PriorityUpdate: {
+                // RFC 9218 §7.1：只能由客户端在 0 号流上发送，且不能指向 0 号流
+                auto* update = frame->asPriorityUpdate();
+                const uint32_t prioritized_id = update->prioritizedStreamId();
+                if (m_conn.isClient() || frame->streamId() != 0 || prioritized_id == 0) {
+                    enqueueGoawayAction(Http2ErrorCode::ProtocolError);
+                    return;
+                }
+                if (m_conn.runtimeConfig().scheduling_mode != H2SchedulingMode::Extensible) {
+                    break;
+                }
+                const auto priority = parseHttp2PriorityField(update->fieldValue());
+                if (auto stream = findAttachedStream(prioritized_id)) {
+                    stream->setPriorityParam(priority);
+                } else if (prioritized_id > m_conn.lastPeerStreamId() &&
+                           (m_pending_priority_updates.contains(prioritized_id) ||
+                            m_pending_priority_updates.size() < kMaxPendingPriorityUpdates)) {
+                    // 流尚未打开：暂存，HEADERS 到达时覆盖 priority 头部；已关闭的流直接忽略
+                    m_pending_priority_updates[prioritized_id] = priority;
+                }
                 break;
             }
 
@@ -1752,6 +1790,52 @@ private:
         }
     }
 
+    /**
+     * @brief 连接窗口增加后补发各流暂存的 DATA
+     * @details WeightedDrr 模式按流表顺序逐流补发；Extensible 模式按 RFC 9218 排序：
+     *          urgency 小的先发，同 urgency 下非 incremental 流逐个发完，incremental 流每轮一帧轮转，
+     *          轮转位置跨多次窗口更新保持（最近服务过的流排在后面）。连接窗口耗尽即停止。
+     */
+    void flushBlockedStreams() {
+        if (m_conn.runtimeConfig().scheduling_mode != H2SchedulingMode::Extensible) {
+            m_conn.forEachStream([](uint32_t, Http2Stream::ptr& stream) {
+                if (stream) {
+                    const bool made_progress = stream->flushPendingData();
+                    // made_progress only reports whether queued DATA was flushed now.
+                }
+            });
+            return;
+        }
+
+        m_blocked_streams.clear();
+        m_conn.forEachStream([this](uint32_t, Http2Stream::ptr& stream) {
+            if (stream && stream->hasPendingData()) {
+                m_blocked_streams.push(stream.get(), stream->priorityParam(), stream->m_priority_served);
+            }
+        });
+        m_blocked_streams.arrange();
+
+        while (!m_blocked_streams.empty() && m_conn.connSendWindow() > 0) {
+            Http2Stream* stream = m_blocked_streams.front();
+            if (!m_blocked_streams.frontIncremental()) {
+                stream->flushPendingData();
+                m_blocked_streams.popFront();
+                continue;
+            }
+            if (!stream->flushPendingDataFrame()) {
+                m_blocked_streams.popFront();
+                continue;
+            }
+            stream->m_priority_served = ++m_priority_seq;
+            if (stream->hasPendingData()) {
+                m_blocked_streams.rotateFront();
+            } else {
+                m_blocked_streams.popFront();
+            }
+        }
+        m_blocked_streams.clear();
+    }
+
     /**
      * @brief 分发流级帧到对应 Http2Stream 的帧队列
      */
@@ -1931,74 +2015,84 @@ private:
         kClose,
     };
 
-    static std::expected<std::vector<std::string>, H2StaticFileBodyReadError>
+    /**
+     * @brief 一次读取的静态文件区间
+     * @details 区间读入单块连续缓冲 bytes，chunks 是按帧大小切出的子切片，与 bytes 共享所有权；
+     *          DATA 帧直接引用该缓冲，完整文件时 bytes 同时作为缓存正文，不再拼接复制。
+     */
+    struct H2StaticFileBody {
+        std::shared_ptr<const std::string> bytes;  ///< 区间字节
+        std::vector<Http2PayloadSlice> chunks;     ///< 帧大小的子切片
+    };
+
+    static std::expected<H2StaticFileBody, H2StaticFileBodyReadError>
     readStaticFileChunksBlocking(const std::string& path,
                                  uintmax_t offset,
                                  uintmax_t length,
                                  uint32_t max_frame_size) {
         if (max_frame_size == 0 ||
-            offset > static_cast<uintmax_t>(std::numeric_limits<off_t>::max())) {
+            offset > static_cast<uintmax_t>(std::numeric_limits<off_t>::max()) ||
+            length > static_cast<uintmax_t>(std::numeric_limits<size_t>::max())) {
             return std::unexpected(H2StaticFileBodyReadError::kInvalidRange);
         }
 
-        std::vector<std::string> chunks;
         const auto frame_size = std::max<uint32_t>(max_frame_size, 1);
-        chunks.reserve(static_cast<size_t>((length + frame_size - 1) / frame_size));
+        const auto total = static_cast<size_t>(length);
+        std::string buffer(total, '\0');
 
         const int fd = ::open(path.c_str(), O_RDONLY);
         if (fd < 0) {
             return std::unexpected(H2StaticFileBodyReadError::kOpen);
         }
 
-        uintmax_t remaining = length;
+        size_t buffer_offset = 0;
         uintmax_t current_offset = offset;
-        while (remaining > 0) {
-            const auto chunk_size = static_cast<size_t>(
-                std::min<uintmax_t>(remaining, frame_size));
-            std::string chunk(chunk_size, '\0');
-
-            size_t chunk_offset = 0;
-            while (chunk_offset < chunk_size) {
-                if (current_offset > static_cast<uintmax_t>(std::numeric_limits<off_t>::max())) {
-                    const int close_result = ::close(fd);
-                    if (close_result != 0) {
-                        return std::unexpected(H2StaticFileBodyReadError::kClose);
-                    }
-                    return std::unexpected(H2StaticFileBodyReadError::kInvalidRange);
+        while (buffer_offset < total) {
+            if (current_offset > static_cast<uintmax_t>(std::numeric_limits<off_t>::max())) {
+                const int close_result = ::close(fd);
+                if (close_result != 0) {
+                    return std::unexpected(H2StaticFileBodyReadError::kClose);
                 }
-                const ssize_t read_count = ::pread(fd,
-                                                   chunk.data() + chunk_offset,
-                                                   chunk_size - chunk_offset,
-                                                   static_cast<off_t>(current_offset));
-                if (read_count < 0) {
-                    if (errno == EINTR) {
-                        continue;
-                    }
-                    const int close_result = ::close(fd);
-                    if (close_result != 0) {
-                        return std::unexpected(H2StaticFileBodyReadError::kClose);
-                    }
-                    return std::unexpected(H2StaticFileBodyReadError::kRead);
+                return std::unexpected(H2StaticFileBodyReadError::kInvalidRange);
+            }
+            const ssize_t read_count = ::pread(fd,
+                                               buffer.data() + buffer_offset,
+                                               total - buffer_offset,
+                                               static_cast<off_t>(current_offset));
+            if (read_count < 0) {
+                if (errno == EINTR) {
+                    continue;
                 }
-                if (read_count == 0) {
-                    const int close_result = ::close(fd);
-                    if (close_result != 0) {
-                        return std::unexpected(H2StaticFileBodyReadError::kClose);
-                    }
-                    return std::unexpected(H2StaticFileBodyReadError::kShortRead);
+                const int close_result = ::close(fd);
+                if (close_result != 0) {
+                    return std::unexpected(H2StaticFileBodyReadError::kClose);
                 }
-                const auto advanced = static_cast<size_t>(read_count);
-                chunk_offset += advanced;
-                current_offset += static_cast<uintmax_t>(advanced);
+                return std::unexpected(H2StaticFileBodyReadError::kRead);
             }
-            remaining -= static_cast<uintmax_t>(chunk_size);
-            chunks.push_back(std::move(chunk));
+            if (read_count == 0) {
+                const int close_result = ::close(fd);
+                if (close_result != 0) {
+                    return std::unexpected(H2StaticFileBodyReadError::kClose);
+                }
+                return std::unexpected(H2StaticFileBodyReadError::kShortRead);
+            }
+            const auto advanced = static_cast<size_t>(read_count);
+            buffer_offset += advanced;
+            current_offset += static_cast<uintmax_t>(advanced);
         }
         const int close_result = ::close(fd);
         if (close_result != 0) {
             return std::unexpected(H2StaticFileBodyReadError::kClose);
         }
-        return chunks;
+
+        H2StaticFileBody body;
+        body.bytes = std::make_shared<const std::string>(std::move(buffer));
+        const Http2PayloadSlice whole(body.bytes);
+        body.chunks.reserve((total + frame_size - 1) / frame_size);
+        for (size_t chunk_offset = 0; chunk_offset < total; chunk_offset += frame_size) {
+            body.chunks.push_back(whole.subslice(chunk_offset, frame_size));
+        }
+        return body;
     }
 
     bool canSendStaticFileBodyNow(uintmax_t length) const {
@@ -2028,26 +2122,24 @@ private:
     }
 
     void appendStaticFileSharedDataFrames(uint32_t stream_id,
-                                          std::shared_ptr<const std::string> body) {
-        if (!body || body->empty()) {
+                                          const Http2PayloadSlice& body) {
+        if (body.empty()) {
             return;
         }
 
-        uintmax_t total = 0;
         const auto frame_size = std::max<uint32_t>(m_conn.peerSettings().max_frame_size, 1);
         size_t offset = 0;
-        while (offset < body->size()) {
-            const auto chunk_size = std::min<size_t>(body->size() - offset, frame_size);
-            const bool end_stream = offset + chunk_size == body->size();
+        while (offset < body.size()) {
+            const auto chunk_size = std::min<size_t>(body.size() - offset, frame_size);
+            const bool end_stream = offset + chunk_size == body.size();
             auto data_header = Http2FrameBuilder::dataHeaderBytes(
                 stream_id, chunk_size, end_stream);
-            total += chunk_size;
             m_static_response_batch.push_back(
-                Http2OutgoingFrame::segmentedShared(
-                    std::move(data_header), body, offset, chunk_size));
+                Http2OutgoingFrame::segmentedSlice(
+                    std::move(data_header), body.subslice(offset, chunk_size)));
             offset += chunk_size;
         }
-        m_conn.adjustConnSendWindow(-static_cast<int32_t>(total));
+        m_conn.adjustConnSendWindow(-static_cast<int32_t>(body.size()));
     }
 
     static bool enqueueStaticFileReadFailure(galay::mpsc::UnboundedChannel<Http2OutgoingFrame>* send_channel,
@@ -2106,53 +2198,27 @@ private:
                     return;
                 }
 
-                auto& chunks = chunks_result.value();
-                std::shared_ptr<const std::string> cached_body;
+                auto& body = chunks_result.value();
                 if (body_cache_slot && offset == 0 &&
-                    length <= static_cast<uintmax_t>(std::numeric_limits<size_t>::max())) {
-                    auto body = std::make_shared<std::string>();
-                    body->reserve(static_cast<size_t>(length));
-                    bool append_ok = true;
-                    for (const auto& chunk : chunks) {
-                        std::string& appended = body->append(chunk);
-                        if (&appended != body.get()) {
-                            append_ok = false;
-                            break;
-                        }
-                    }
-                    if (append_ok && body->size() == static_cast<size_t>(length)) {
-                        cached_body = body;
-                        const bool stored = body_cache_slot->storeIfEmpty(cached_body);
-                        if (!stored) {
-                            cached_body = body_cache_slot->load();
-                        }
+                    body.bytes->size() == static_cast<size_t>(length)) {
+                    // 整文件读取的缓冲直接作为缓存正文；缓存已被其他读取填充时，本次缓冲随最后一帧写出后释放
+                    const bool stored = body_cache_slot->storeIfEmpty(body.bytes);
+                    if (!stored) {
+                        body.bytes.reset();
                     }
                 }
 
                 std::vector<Http2OutgoingFrame> frames;
-                frames.reserve(chunks.size() + 1);
+                frames.reserve(body.chunks.size() + 1);
                 frames.push_back(
                     Http2OutgoingFrame::segmentedShared(std::move(header_bytes),
                                                         std::move(header_block)));
-                if (cached_body) {
-                    size_t body_offset = 0;
-                    for (size_t i = 0; i < chunks.size(); ++i) {
-                        const bool end_stream = i + 1 == chunks.size();
-                        const size_t chunk_size = chunks[i].size();
-                        auto data_header = Http2FrameBuilder::dataHeaderBytes(
-                            stream_id, chunk_size, end_stream);
-                        frames.push_back(Http2OutgoingFrame::segmentedShared(
-                            std::move(data_header), cached_body, body_offset, chunk_size));
-                        body_offset += chunk_size;
-                    }
-                } else {
-                    for (size_t i = 0; i < chunks.size(); ++i) {
-                        const bool end_stream = i + 1 == chunks.size();
-                        auto data_header = Http2FrameBuilder::dataHeaderBytes(
-                            stream_id, chunks[i].size(), end_stream);
-                        frames.push_back(Http2OutgoingFrame::segmented(
-                            std::move(data_header), std::move(chunks[i])));
-                    }
+                for (size_t i = 0; i < body.chunks.size(); ++i) {
+                    const bool end_stream = i + 1 == body.chunks.size();
+                    auto data_header = Http2FrameBuilder::dataHeaderBytes(
+                        stream_id, body.chunks[i].size(), end_stream);
+                    frames.push_back(Http2OutgoingFrame::segmentedSlice(
+                        std::move(data_header), std::move(body.chunks[i])));
                 }
                 const bool sent = send_channel->sendBatch(std::move(frames));
                 if (!sent) {
@@ -2203,7 +2269,9 @@ private:
         }
 
         if (lookup.body) {
-            appendStaticFileSharedDataFrames(stream_id, lookup.body);
+            appendStaticFileSharedDataFrames(
+                stream_id,
+                Http2PayloadSlice(lookup.body, lookup.body_offset, static_cast<size_t>(length)));
         }
         return true;
     }
@@ -2396,6 +2464,24 @@ private:
         return true;
     }
 
+    /**
+     * @brief 按请求 `priority` 头部设置流优先级，先到的 PRIORITY_UPDATE 优先
+     */
+    void applyRequestPriority(const Http2Stream::ptr& stream) {
+        if (!m_pending_priority_updates.empty()) {
+            auto it = m_pending_priority_updates.find(stream->streamId());
+            if (it != m_pending_priority_updates.end()) {
+                stream->setPriorityParam(it->second);
+                m_pending_priority_updates.erase(it);
+                return;
+            }
+        }
+        const std::string priority = stream->request().getHeader("priority");
+        if (!priority.empty()) {
+            stream->setPriorityParam(parseHttp2PriorityField(priority));
+        }
+    }
+
     void completeDecodedHeaders(const Http2Stream::ptr& stream, bool end_stream) {
         if (m_conn.isClient()) {
             stream->consumeDecodedHeadersAsResponse();
@@ -2409,6 +2495,9 @@ private:
         }
 
         stream->consumeDecodedHeadersAsRequest();
+        if (m_conn.runtimeConfig().scheduling_mode == H2SchedulingMode::Extensible) {
+            applyRequestPriority(stream);
+        }
         auto events = Http2StreamEvent::HeadersReady;
         if (end_stream) {
             stream->markRequestCompleted();
@@ -2420,6 +2509,9 @@ private:
         if (trySendStaticFile(stream)) {
             return;
         }
+        if (m_conn.runtimeConfig().compression.isEnabled()) {
+            stream->negotiateResponseCoding(m_conn.runtimeConfig().compression);
+        }
         if (m_active_conn_mode) {
             if (shouldDeferHeadersOnlyActiveDelivery(stream, end_stream)) {
                 stream->m_pending_events |= events;
@@ -2437,6 +2529,9 @@ private:
     }
 
     void applyRecvWindowUpdate(const Http2Stream::ptr& stream, uint32_t stream_id, size_t data_size) {
+        if (m_conn.windowTuner().onDataReceived(data_size, m_last_frame_recv_at)) {
+            sendWindowProbe();
+        }
         auto update = m_conn.evaluateRecvWindowUpdate(stream->recvWindow(), data_size);
         if (update.conn_increment > 0) {
             enqueueWindowUpdateAction(0, update.conn_increment);
@@ -2448,6 +2543,29 @@ private:
         }
     }
 
+    /**
+     * @brief 发出 BDP 探测 PING，ACK 到达时由窗口调优器结算本轮收到的字节
+     */
+    void sendWindowProbe() {
+        auto& tuner = m_conn.windowTuner();
+        tuner.onProbeSent(m_last_frame_recv_at);
+        Http2PingFrame ping;
+        ping.setOpaqueData(tuner.probePayload().data());
+        enqueueSendFrame(std::move(ping));
+    }
+
+    /**
+     * @brief 窗口目标提升后立即把连接接收窗口补到新目标
+     */
+    void growConnRecvWindow() {
+        const int64_t increment = static_cast<int64_t>(m_conn.windowTuner().connTarget()) -
+                                  static_cast<int64_t>(m_conn.connRecvWindow());
+        if (increment > 0) {
+            enqueueWindowUpdateAction(0, static_cast<uint32_t>(increment));
+            m_conn.adjustConnRecvWindow(static_cast<int32_t>(increment));
+        }
+    }
+
     void appendStreamDataAndMarkEvents(const Http2Stream::ptr& stream, Http2DataFrame* data) {
         auto events = Http2StreamEvent::DataArrived;
         if (m_conn.isClient()) {
@@ -3120,6 +3238,12 @@ private:
 
     // 待 spawn 的流队列（按优先级排序）
     std::priority_queue<Http2Stream::ptr, std::vector<Http2Stream::ptr>, StreamPriorityCompare> m_pending_spawns;
+
+    // RFC 9218 可扩展优先级
+    static constexpr size_t kMaxPendingPriorityUpdates = 128;                   ///< 未打开流的 PRIORITY_UPDATE 暂存上限
+    std::unordered_map<uint32_t, Http2PriorityParam> m_pending_priority_updates; ///< 先于 HEADERS 到达的 PRIORITY_UPDATE
+    H2UrgencyBuckets<Http2Stream*> m_blocked_streams;                           ///< 补发 DATA 的优先级桶，复用容量
+    uint64_t m_priority_seq = 0;                                                ///< incremental 轮转序号
     galay::mpsc::UnboundedChannel<uint32_t> m_retire_stream_channel;
 };
 
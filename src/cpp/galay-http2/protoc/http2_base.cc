@@ -16,6 +16,7 @@ std::string http2FrameTypeToString(Http2FrameType type)
         case Http2FrameType::GoAway: return "GOAWAY";
         case Http2FrameType::WindowUpdate: return "WINDOW_UPDATE";
         case Http2FrameType::Continuation: return "CONTINUATION";
+        case Http2FrameType::PriorityUpdate: return "PRIORITY_UPDATE";
         default: return "UNKNOWN";
     }
 }
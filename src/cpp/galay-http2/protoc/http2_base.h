@@ -56,6 +56,7 @@ enum class Http2FrameType : uint8_t
     GoAway = 0x7,          ///< GOAWAY 帧，发起连接关闭
     WindowUpdate = 0x8,    ///< WINDOW_UPDATE 帧，流量控制
     Continuation = 0x9,    ///< CONTINUATION 帧，继续传输头部块
+    PriorityUpdate = 0x10, ///< PRIORITY_UPDATE 帧，更新可扩展优先级（RFC 9218）
     Unknown = 0xFF         ///< 未知帧类型
 };
 
@@ -83,7 +84,8 @@ enum class Http2SettingsId : uint16_t
     MaxConcurrentStreams = 0x3,    ///< 最大并发流数
     InitialWindowSize = 0x4,      ///< 初始窗口大小
     MaxFrameSize = 0x5,           ///< 最大帧大小
-    MaxHeaderListSize = 0x6       ///< 最大头部列表大小
+    MaxHeaderListSize = 0x6,      ///< 最大头部列表大小
+    NoRfc7540Priorities = 0x9     ///< 不使用 RFC 7540 优先级（RFC 9218）
 };
 
 /**
@@ -594,6 +594,42 @@ Http2ErrorCode Http2ContinuationFrame::parsePayload(const uint8_t* data, size_t
     return Http2ErrorCode::NoError;
 }
 
+// ==================== Http2PriorityUpdateFrame ====================
+
+std::string Http2PriorityUpdateFrame::serialize() const
+{
+    std::string result;
+    result.resize(kHttp2FrameHeaderLength + 4 + m_field_value.size());
+
+    Http2FrameHeader header = m_header;
+    header.length = static_cast<uint32_t>(4 + m_field_value.size());
+    header.serialize(reinterpret_cast<uint8_t*>(result.data()));
+
+    size_t offset = kHttp2FrameHeaderLength;
+    result[offset++] = (m_prioritized_stream_id >> 24) & 0x7F;
+    result[offset++] = (m_prioritized_stream_id >> 16) & 0xFF;
+    result[offset++] = (m_prioritized_stream_id >> 8) & 0xFF;
+    result[offset++] = m_prioritized_stream_id & 0xFF;
+    std::memcpy(result.data() + offset, m_field_value.data(), m_field_value.size());
+
+    return result;
+}
+
+Http2ErrorCode Http2PriorityUpdateFrame::parsePayload(const uint8_t* data, size_t length)
+{
+    if (length < 4) {
+        return Http2ErrorCode::FrameSizeError;
+    }
+
+    m_prioritized_stream_id = ((static_cast<uint32_t>(data[0]) << 24) |
+                               (static_cast<uint32_t>(data[1]) << 16) |
+                               (static_cast<uint32_t>(data[2]) << 8) |
+                               static_cast<uint32_t>(data[3])) & 0x7FFFFFFF;
+    m_field_value.assign(reinterpret_cast<const char*>(data + 4), length - 4);
+
+    return Http2ErrorCode::NoError;
+}
+
 // ==================== Http2FrameParser ====================
 
 Http2FrameHeader Http2FrameParser::parseHeader(const uint8_t* data)
@@ -624,6 +660,8 @@ Http2Frame::uptr Http2FrameParser::createFrame(Http2FrameType type)
             return std::make_unique<Http2WindowUpdateFrame>();
         case Http2FrameType::Continuation:
             return std::make_unique<Http2ContinuationFrame>();
+        case Http2FrameType::PriorityUpdate:
+            return std::make_unique<Http2PriorityUpdateFrame>();
         default:
             return nullptr;
     }
@@ -5,7 +5,7 @@
  * @version 1.0.0
  *
  * @details 定义 HTTP/2 所有帧类型（DATA/HEADERS/PRIORITY/RST_STREAM/SETTINGS/
- *          PUSH_PROMISE/PING/GOAWAY/WINDOW_UPDATE/CONTINUATION），
+ *          PUSH_PROMISE/PING/GOAWAY/WINDOW_UPDATE/CONTINUATION/PRIORITY_UPDATE），
  *          提供帧解析器及编解码统一入口。
  */
 
@@ -62,6 +62,7 @@ class Http2PingFrame;
 class Http2GoAwayFrame;
 class Http2WindowUpdateFrame;
 class Http2ContinuationFrame;
+class Http2PriorityUpdateFrame;
 
 /**
  * @brief HTTP/2 帧基类
@@ -97,6 +98,7 @@ public:
     bool isGoAway() const { return m_header.type == Http2FrameType::GoAway; }
     bool isWindowUpdate() const { return m_header.type == Http2FrameType::WindowUpdate; }
     bool isContinuation() const { return m_header.type == Http2FrameType::Continuation; }
+    bool isPriorityUpdate() const { return m_header.type == Http2FrameType::PriorityUpdate; }
 
     // END_STREAM 判断（DATA 和 HEADERS 帧通用）
     bool isEndStream() const {
@@ -115,6 +117,7 @@ public:
     inline Http2GoAwayFrame* asGoAway();
     inline Http2WindowUpdateFrame* asWindowUpdate();
     inline Http2ContinuationFrame* asContinuation();
+    inline Http2PriorityUpdateFrame* asPriorityUpdate();
 
     inline const Http2DataFrame* asData() const;
     inline const Http2HeadersFrame* asHeaders() const;
@@ -126,6 +129,7 @@ public:
     inline const Http2GoAwayFrame* asGoAway() const;
     inline const Http2WindowUpdateFrame* asWindowUpdate() const;
     inline const Http2ContinuationFrame* asContinuation() const;
+    inline const Http2PriorityUpdateFrame* asPriorityUpdate() const;
 
     // 序列化整个帧
     virtual std::string serialize() const = 0;
@@ -586,6 +590,44 @@ private:
     std::string m_header_block;
 };
 
+/**
+ * @brief PRIORITY_UPDATE 帧（RFC 9218）
+ * @details 在流 0 上发送，更新 prioritized stream 的 urgency / incremental；
+ *          字段值与 `priority` 头部同格式。
+ */
+class Http2PriorityUpdateFrame : public Http2Frame
+{
+public:
+    Http2PriorityUpdateFrame() { m_header.type = Http2FrameType::PriorityUpdate; }
+    Http2PriorityUpdateFrame(Http2PriorityUpdateFrame&&) noexcept = default;
+    Http2PriorityUpdateFrame& operator=(Http2PriorityUpdateFrame&&) noexcept = default;
+
+    uint32_t prioritizedStreamId() const { return m_prioritized_stream_id; }
+    const std::string& fieldValue() const { return m_field_value; }
+
+    void setPriorityUpdate(uint32_t prioritized_stream_id, std::string field_value) {
+        m_prioritized_stream_id = prioritized_stream_id & 0x7FFFFFFF;
+        m_field_value = std::move(field_value);
+    }
+
+    std::string serialize() const override;
+    Http2ErrorCode parsePayload(const uint8_t* data, size_t length) override;
+    Http2PriorityUpdateFrame clone() const {
+        Http2PriorityUpdateFrame copy;
+        copy.m_header = m_header;
+        copy.m_prioritized_stream_id = m_prioritized_stream_id;
+        copy.m_field_value = m_field_value;
+        return copy;
+    }
+
+private:
+    Http2PriorityUpdateFrame(const Http2PriorityUpdateFrame&) = delete;
+    Http2PriorityUpdateFrame& operator=(const Http2PriorityUpdateFrame&) = delete;
+
+    uint32_t m_prioritized_stream_id = 0;
+    std::string m_field_value;
+};
+
 // ==================== Http2Frame::asXXX 内联定义 ====================
 
 inline Http2DataFrame* Http2Frame::asData() { return isData() ? static_cast<Http2DataFrame*>(this) : nullptr; }
@@ -598,6 +640,7 @@ inline Http2PingFrame* Http2Frame::asPing() { return isPing() ? static_cast<Http
 inline Http2GoAwayFrame* Http2Frame::asGoAway() { return isGoAway() ? static_cast<Http2GoAwayFrame*>(this) : nullptr; }
 inline Http2WindowUpdateFrame* Http2Frame::asWindowUpdate() { return isWindowUpdate() ? static_cast<Http2WindowUpdateFrame*>(this) : nullptr; }
 inline Http2ContinuationFrame* Http2Frame::asContinuation() { return isContinuation() ? static_cast<Http2ContinuationFrame*>(this) : nullptr; }
+inline Http2PriorityUpdateFrame* Http2Frame::asPriorityUpdate() { return isPriorityUpdate() ? static_cast<Http2PriorityUpdateFrame*>(this) : nullptr; }
 
 inline const Http2DataFrame* Http2Frame::asData() const { return isData() ? static_cast<const Http2DataFrame*>(this) : nullptr; }
 inline const Http2HeadersFrame* Http2Frame::asHeaders() const { return isHeaders() ? static_cast<const Http2HeadersFrame*>(this) : nullptr; }
@@ -609,6 +652,7 @@ inline const Http2PingFrame* Http2Frame::asPing() const { return isPing() ? stat
 inline const Http2GoAwayFrame* Http2Frame::asGoAway() const { return isGoAway() ? static_cast<const Http2GoAwayFrame*>(this) : nullptr; }
 inline const Http2WindowUpdateFrame* Http2Frame::asWindowUpdate() const { return isWindowUpdate() ? static_cast<const Http2WindowUpdateFrame*>(this) : nullptr; }
 inline const Http2ContinuationFrame* Http2Frame::asContinuation() const { return isContinuation() ? static_cast<const Http2ContinuationFrame*>(this) : nullptr; }
+inline const Http2PriorityUpdateFrame* Http2Frame::asPriorityUpdate() const { return isPriorityUpdate() ? static_cast<const Http2PriorityUpdateFrame*>(this) : nullptr; }
 
 /**
  * @brief HTTP/2 帧解析器
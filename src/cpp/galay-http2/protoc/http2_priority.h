@@ -0,0 +1,113 @@
+/**
+ * @file http2_priority.h
+ * @brief HTTP 可扩展优先级（RFC 9218）参数
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 定义 urgency（0–7，越小越优先）与 incremental 两个优先级参数，
+ *          以及 `priority` 头部 / PRIORITY_UPDATE 字段值（Structured Field 字典）的解析与格式化。
+ */
+
+#ifndef GALAY_HTTP2_PRIORITY_H
+#define GALAY_HTTP2_PRIORITY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace galay::http2
+{
+
+constexpr uint8_t kHttp2DefaultUrgency = 3;     ///< 默认 urgency（RFC 9218 §4.1）
+constexpr uint8_t kHttp2UrgencyLevels = 8;      ///< urgency 取值个数（0–7）
+
+/**
+ * @brief 可扩展优先级参数
+ */
+struct Http2PriorityParam
+{
+    uint8_t urgency = kHttp2DefaultUrgency;     ///< 0 最高，7 最低
+    bool incremental = false;                   ///< 是否可与同 urgency 流交错发送
+
+    bool operator==(const Http2PriorityParam&) const = default;
+};
+
+namespace detail
+{
+
+inline std::string_view trimPriorityOws(std::string_view value)
+{
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+} // namespace detail
+
+/**
+ * @brief 解析 `priority` 字段值
+ * @param value 字段值，如 "u=1, i"、"u=5"、"i=?0"
+ * @param base 字段中未出现的参数沿用的值；PRIORITY_UPDATE 覆盖时传入默认值
+ * @return 解析结果
+ * @details 按 RFC 9218 忽略未知键、越界 urgency 与类型不符的成员，不因单个成员格式错误拒绝整个字段。
+ */
+inline Http2PriorityParam parseHttp2PriorityField(std::string_view value,
+                                                  Http2PriorityParam base = {})
+{
+    Http2PriorityParam result = base;
+    while (!value.empty()) {
+        const size_t comma = value.find(',');
+        std::string_view member = detail::trimPriorityOws(value.substr(0, comma));
+        value = comma == std::string_view::npos ? std::string_view{} : value.substr(comma + 1);
+
+        // 成员参数（";..."）对 u / i 无意义，直接丢弃
+        member = detail::trimPriorityOws(member.substr(0, member.find(';')));
+        const size_t eq = member.find('=');
+        const std::string_view key = member.substr(0, eq);
+        const std::string_view item = eq == std::string_view::npos
+            ? std::string_view{"?1"}
+            : member.substr(eq + 1);
+
+        if (key == "u") {
+            if (item.size() == 1 && item[0] >= '0' && item[0] <= '7') {
+                result.urgency = static_cast<uint8_t>(item[0] - '0');
+            }
+        } else if (key == "i") {
+            if (item == "?1") {
+                result.incremental = true;
+            } else if (item == "?0") {
+                result.incremental = false;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 格式化为 `priority` 字段值
+ * @param param 优先级参数
+ * @return 省略默认值的字段值，均为默认值时返回空串
+ */
+inline std::string formatHttp2PriorityField(Http2PriorityParam param)
+{
+    std::string value;
+    if (param.urgency != kHttp2DefaultUrgency && param.urgency < kHttp2UrgencyLevels) {
+        value.append("u=");
+        value.push_back(static_cast<char>('0' + param.urgency));
+    }
+    if (param.incremental) {
+        if (!value.empty()) {
+            value.append(", ");
+        }
+        value.push_back('i');
+    }
+    return value;
+}
+
+} // namespace galay::http2
+
+#endif // GALAY_HTTP2_PRIORITY_H
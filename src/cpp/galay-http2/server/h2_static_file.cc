@@ -128,8 +128,9 @@ H2StaticFileLookup H2StaticFileCache::lookup(const H2StaticFileRequest& request)
         }
         auto cached_body = entry->body_cache_slot ? entry->body_cache_slot->load() : nullptr;
         if (cached_body) {
-            lookup.body = std::make_shared<const std::string>(
-                cached_body->substr(static_cast<size_t>(range.start), static_cast<size_t>(length)));
+            // 直接引用缓存正文，发送时按 body_offset 切片，避免复制 Range 区间
+            lookup.body = std::move(cached_body);
+            lookup.body_offset = static_cast<size_t>(range.start);
             lookup.body_cached = true;
         } else {
             lookup.body = nullptr;
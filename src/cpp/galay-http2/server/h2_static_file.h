@@ -72,7 +72,8 @@ struct H2StaticFileLookup {
     std::filesystem::path file_path;
     std::string etag;
     std::string content_type = "application/octet-stream";
-    std::shared_ptr<const std::string> body;
+    std::shared_ptr<const std::string> body;   ///< 缓存正文；Range 命中时为整个文件，正文区间由 body_offset 给出
+    size_t body_offset = 0;                    ///< 响应正文在 body 中的起始偏移
     std::shared_ptr<const std::string> encoded_headers;
     std::shared_ptr<H2StaticFileBodyCacheSlot> body_cache_slot;
     std::vector<Http2HeaderField> headers;
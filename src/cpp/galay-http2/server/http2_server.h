@@ -142,6 +142,9 @@ struct H2cServerConfig
     Http2ActiveConnHandler active_conn_handler;
     std::vector<H2StaticRoute> static_routes;
     std::vector<H2StaticFileMount> static_file_mounts;
+    galay::http::HttpCompressionSetting compression;  ///< 动态响应压缩策略，默认关闭
+    H2SchedulingMode scheduling_mode = H2SchedulingMode::Extensible;  ///< 窗口受限时 DATA 补发顺序
+    H2AdaptiveWindowConfig adaptive_window;  ///< 按 BDP 调整接收窗口，默认关闭
 };
 
 class H2cServer;
@@ -170,6 +173,35 @@ public:
         m_config.flow_control_strategy = std::move(v);
         return *this;
     }
+    /**
+     * @brief 设置动态响应压缩策略。
+     * @param v 压缩配置；启用后按请求 accept-encoding 协商，对处理器发出的可压缩响应做 gzip / zstd 编码。
+     * @return 当前 builder，支持链式调用。
+     * @note 静态响应与静态文件挂载不经过该策略。
+     */
+    H2cServerBuilder& compression(galay::http::HttpCompressionSetting v) {
+        m_config.compression = std::move(v);
+        return *this;
+    }
+    /**
+     * @brief 设置出站 DATA 调度模式。
+     * @param v Extensible 按 RFC 9218 urgency / incremental（priority 头与 PRIORITY_UPDATE）排序；
+     *          WeightedDrr 保持按流表顺序补发，不解析优先级信号。
+     * @return 当前 builder，支持链式调用。
+     */
+    H2cServerBuilder& schedulingMode(H2SchedulingMode v) {
+        m_config.scheduling_mode = v;
+        return *this;
+    }
+    /**
+     * @brief 设置接收窗口自适应。
+     * @param v 开启后以 PING 往返估算带宽时延积，在 max_window 内增长连接与 stream 接收窗口，空闲时回落。
+     * @return 当前 builder，支持链式调用。
+     */
+    H2cServerBuilder& adaptiveWindow(H2AdaptiveWindowConfig v) {
+        m_config.adaptive_window = v;
+        return *this;
+    }
     H2cServerBuilder& streamHandler(Http2ConnectionHandler handler) {
         m_config.stream_handler = std::move(handler);
         return *this;
@@ -986,6 +1018,9 @@ struct H2ServerConfig
     Http2ActiveConnHandler active_conn_handler;
     std::vector<H2StaticRoute> static_routes;
     std::vector<H2StaticFileMount> static_file_mounts;
+    galay::http::HttpCompressionSetting compression;  ///< 动态响应压缩策略，默认关闭
+    H2SchedulingMode scheduling_mode = H2SchedulingMode::Extensible;  ///< 窗口受限时 DATA 补发顺序
+    H2AdaptiveWindowConfig adaptive_window;  ///< 按 BDP 调整接收窗口，默认关闭
 };
 
 class H2Server;
@@ -1035,6 +1070,35 @@ public:
         m_config.flow_control_strategy = std::move(v);
         return *this;
     }
+    /**
+     * @brief 设置动态响应压缩策略。
+     * @param v 压缩配置；启用后按请求 accept-encoding 协商，对处理器发出的可压缩响应做 gzip / zstd 编码。
+     * @return 当前 builder，支持链式调用。
+     * @note 静态响应与静态文件挂载不经过该策略。
+     */
+    H2ServerBuilder& compression(galay::http::HttpCompressionSetting v) {
+        m_config.compression = std::move(v);
+        return *this;
+    }
+    /**
+     * @brief 设置出站 DATA 调度模式。
+     * @param v Extensible 按 RFC 9218 urgency / incremental（priority 头与 PRIORITY_UPDATE）排序；
+     *          WeightedDrr 保持按流表顺序补发，不解析优先级信号。
+     * @return 当前 builder，支持链式调用。
+     */
+    H2ServerBuilder& schedulingMode(H2SchedulingMode v) {
+        m_config.scheduling_mode = v;
+        return *this;
+    }
+    /**
+     * @brief 设置接收窗口自适应。
+     * @param v 开启后以 PING 往返估算带宽时延积，在 max_window 内增长连接与 stream 接收窗口，空闲时回落。
+     * @return 当前 builder，支持链式调用。
+     */
+    H2ServerBuilder& adaptiveWindow(H2AdaptiveWindowConfig v) {
+        m_config.adaptive_window = v;
+        return *this;
+    }
     H2ServerBuilder& streamHandler(Http2ConnectionHandler handler) {
         m_config.stream_handler = std::move(handler);
         return *this;
@@ -113,6 +113,39 @@ FileWriteAwaitable AsyncFile::write(const char* buffer, size_t length, off_t off
     return FileWriteAwaitable(&m_controller, buffer, length, offset);
 }
 
+/**
+ * @brief 创建租借文件 IO 切片的 RegisteredBufferLeaseAwaitable
+ * @param length 需要的最小容量
+ * @return co_await 后得到注册池切片或堆回退切片
+ */
+RegisteredBufferLeaseAwaitable AsyncFile::leaseBuffer(size_t length)
+{
+    return RegisteredBufferLeaseAwaitable(length);
+}
+
+/**
+ * @brief 创建读取到租借切片的 FileReadAwaitable
+ * @param buffer 目标切片
+ * @param length 读取字节数，超过切片容量时按容量截断
+ * @param offset 起始文件偏移量
+ * @return 绑定到该文件 IO 控制器的 FileReadAwaitable
+ */
+FileReadAwaitable AsyncFile::read(RegisteredBuffer& buffer, size_t length, off_t offset)
+{
+    return FileReadAwaitable(&m_controller, buffer, length, offset);
+}
+
+/**
+ * @brief 创建写出租借切片的 FileWriteAwaitable
+ * @param buffer 源切片，写入长度为其有效数据长度
+ * @param offset 起始文件偏移量
+ * @return 绑定到该文件 IO 控制器的 FileWriteAwaitable
+ */
+FileWriteAwaitable AsyncFile::write(const RegisteredBuffer& buffer, off_t offset)
+{
+    return FileWriteAwaitable(&m_controller, buffer, offset);
+}
+
 /**
  * @brief 创建用于异步文件关闭的 CloseAwaitable
  * @return 绑定到该文件 IO 控制器的 CloseAwaitable
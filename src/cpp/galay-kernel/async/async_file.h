@@ -5,7 +5,8 @@
  * @version 1.0.0
  *
  * @details 构建在 IO 调度器的可等待类型之上的简单异步文件抽象。
- * 支持 open、read、write、close、size 和 sync 操作。
+ * 支持 open、read、write、close、size 和 sync 操作；leaseBuffer() 租借的切片在 io_uring
+ * 上以 READ_FIXED/WRITE_FIXED 提交。
  * 仅在使用 USE_KQUEUE 或 USE_IOURING 编译时可用。
  * 对于基于 epoll 的系统，请使用 AsyncAio。
  */
@@ -118,6 +119,42 @@ public:
      */
     galay::kernel::FileWriteAwaitable write(const char* buffer, size_t length, off_t offset = 0);
 
+    /**
+     * @brief 租借一个至少 `length` 字节的文件 IO 切片
+     *
+     * @param length 需要的最小容量
+     * @return RegisteredBufferLeaseAwaitable，co_await 后得到 move-only 的 RegisteredBuffer
+     *
+     * @note
+     * - io_uring 且 RuntimeConfig::io_uring.registered_buffer_count > 0 时来自 ring 注册缓冲池
+     * - 其它后端、池耗尽或 length 超过单槽容量时回退为堆切片，读写接口不变
+     * - 切片可在任意线程释放；非调度器线程归还的槽位经加锁队列回到池中，调度器停止后的归还直接丢弃
+     */
+    galay::kernel::RegisteredBufferLeaseAwaitable leaseBuffer(size_t length);
+
+    /**
+     * @brief 异步读取文件到租借切片
+     *
+     * @param buffer leaseBuffer() 得到的切片
+     * @param length 读取字节数，超过切片容量时按容量截断
+     * @param offset 文件偏移
+     * @return FileReadAwaitable，co_await 后返回读取到的字节数
+     *
+     * @note 读取完成后由调用方按返回值调用 buffer.resize()
+     */
+    galay::kernel::FileReadAwaitable read(galay::kernel::RegisteredBuffer& buffer,
+                                          size_t length,
+                                          off_t offset = 0);
+
+    /**
+     * @brief 异步写出租借切片中的有效数据（buffer.size() 字节）
+     *
+     * @param buffer leaseBuffer() 得到的切片
+     * @param offset 文件偏移
+     * @return FileWriteAwaitable，解析为写入的字节数
+     */
+    galay::kernel::FileWriteAwaitable write(const galay::kernel::RegisteredBuffer& buffer, off_t offset = 0);
+
     /**
      * @brief 异步关闭文件句柄
      * @return CloseAwaitable，关闭操作完成时解析
@@ -397,6 +397,36 @@ public:
         return galay::kernel::SendFileAwaitable(&m_controller, file_fd, offset, count);
     }
 
+    /**
+     * @brief 异步把 socket 中的数据 splice 进管道
+     *
+     * @param pipe_write_fd 管道写端
+     * @param length 本次最多搬运的字节数
+     * @return SpliceInAwaitable 可等待对象，co_await后返回搬进管道的字节数，0 表示对端关闭
+     *
+     * @note
+     * - 数据不经过用户态，配合 spliceOut() 实现 socket → socket 零拷贝转发
+     * - 调用前管道必须有空余容量，否则会一直等待 socket 可读而无法推进
+     * - 占用读槽，不能与 recv/readv 并发
+     * - kqueue 平台不支持，立即返回 ENOSYS；完整转发循环见 spliceRelay()
+     */
+    galay::kernel::SpliceInAwaitable spliceIn(int pipe_write_fd, size_t length) {
+        return galay::kernel::SpliceInAwaitable(&m_controller, pipe_write_fd, length);
+    }
+
+    /**
+     * @brief 异步把管道中的数据 splice 到 socket
+     *
+     * @param pipe_read_fd 管道读端
+     * @param length 本次最多搬运的字节数（不应超过管道中已有的字节数）
+     * @return SpliceOutAwaitable 可等待对象，co_await后返回写入 socket 的字节数，可能小于 length
+     *
+     * @note 占用写槽，不能与 send/writev/sendfile 并发；kqueue 平台立即返回 ENOSYS
+     */
+    galay::kernel::SpliceOutAwaitable spliceOut(int pipe_read_fd, size_t length) {
+        return galay::kernel::SpliceOutAwaitable(&m_controller, pipe_read_fd, length);
+    }
+
     /**
      * @brief 异步关闭socket
      *
@@ -5,7 +5,7 @@
  * @version 1.0.0
  *
  * @details AsyncUdpSocket 生命周期（create、bind、move、destroy）的具体实现。
- * 异步操作（recvfrom、sendto、close）在此定义，委托给调度器的可等待对象。
+ * 异步操作（recvfrom、sendto、recvBatch、sendBatch、close）在此定义，委托给调度器的可等待对象。
  */
 
 #include "async_udp.h"
@@ -158,6 +158,26 @@ SendToAwaitable AsyncUdpSocket::sendto(const char* buffer, size_t length, const
     return SendToAwaitable(&m_controller, buffer, length, to);
 }
 
+/**
+ * @brief 创建用于批量数据报接收的 RecvBatchAwaitable
+ * @param datagrams 接收槽位
+ * @return 绑定到该套接字 IO 控制器的 RecvBatchAwaitable
+ */
+RecvBatchAwaitable AsyncUdpSocket::recvBatch(std::span<UdpRecvDatagram> datagrams)
+{
+    return RecvBatchAwaitable(&m_controller, datagrams);
+}
+
+/**
+ * @brief 创建用于批量数据报发送的 SendBatchAwaitable
+ * @param datagrams 发送条目
+ * @return 绑定到该套接字 IO 控制器的 SendBatchAwaitable
+ */
+SendBatchAwaitable AsyncUdpSocket::sendBatch(std::span<const UdpSendDatagram> datagrams)
+{
+    return SendBatchAwaitable(&m_controller, datagrams);
+}
+
 /**
  * @brief 创建用于异步套接字关闭的 CloseAwaitable
  * @return 绑定到该套接字 IO 控制器的 CloseAwaitable
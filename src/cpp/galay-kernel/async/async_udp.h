@@ -55,6 +55,7 @@
 #include "../core/awaitable.h"
 #include "../core/io_scheduler.hpp"
 #include <expected>
+#include <span>
 
 namespace galay::async
 {
@@ -220,6 +221,48 @@ public:
         size_t length,
         const galay::kernel::Host& to);
 
+    /**
+     * @brief 异步批量接收数据报
+     *
+     * @param datagrams 接收槽位；每个槽位提供 buffer/capacity，完成后写出 length/from
+     * @return RecvBatchAwaitable 可等待对象，co_await后返回填充的槽位数（>=1）
+     *
+     * @note
+     * - 至少有一个数据报就绪才恢复，随后尽量填满 span；不会为凑满而继续等待
+     * - epoll 使用 recvmmsg，io_uring 从 multishot recvmsg 的就绪队列批量取走
+     * - 开启 option().handleUdpGro() 后，合并数据报的段大小写入 segment_size，
+     *   通过 segmentCount()/segment() 原地拆分
+     * - 槽位与缓冲区生命周期必须持续到co_await完成
+     *
+     * @code
+     * std::array<std::array<char, 1500>, 16> buffers;
+     * std::array<UdpRecvDatagram, 16> slots;
+     * for (size_t i = 0; i < slots.size(); ++i) {
+     *     slots[i].buffer = buffers[i].data();
+     *     slots[i].capacity = buffers[i].size();
+     * }
+     * auto result = co_await socket.recvBatch(slots);
+     * for (size_t i = 0; result && i < result.value(); ++i) {
+     *     // slots[i].length、slots[i].from
+     * }
+     * @endcode
+     */
+    galay::kernel::RecvBatchAwaitable recvBatch(std::span<galay::kernel::UdpRecvDatagram> datagrams);
+
+    /**
+     * @brief 异步批量发送数据报
+     *
+     * @param datagrams 发送条目；segment_size > 0 的条目以 GSO（UDP_SEGMENT）发送
+     * @return SendBatchAwaitable 可等待对象，co_await后返回已发送的条目数
+     *
+     * @note
+     * - 返回值可能小于 span 大小（发送队列满），调用方应继续发送剩余条目
+     * - epoll 使用 sendmmsg；io_uring 内联 sendmmsg，队列满时等待 POLLOUT
+     * - GSO 仅 Linux 支持，其他平台返回 kSendFailed(EOPNOTSUPP)
+     * - 缓冲区生命周期必须持续到co_await完成
+     */
+    galay::kernel::SendBatchAwaitable sendBatch(std::span<const galay::kernel::UdpSendDatagram> datagrams);
+
     /**
      * @brief 异步关闭socket
      *
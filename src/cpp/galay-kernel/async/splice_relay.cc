@@ -0,0 +1,280 @@
+/**
+ * @file splice_relay.cc
+ * @brief splice 零拷贝转发实现
+ * @author galay-kernel
+ * @version 1.0.0
+ */
+
+#include "splice_relay.h"
+#include "async_waiter.h"
+#include "../core/scheduler.hpp"
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+#include <vector>
+
+namespace galay::async
+{
+
+using namespace galay::kernel;
+
+namespace
+{
+
+/**
+ * @brief 捕获当前协程所属调度器
+ * @details 不挂起，只读取 promise 上绑定的调度器，用于把隧道的反向转发提交到同一个 IO 调度器。
+ */
+class CurrentSchedulerAwaitable
+{
+public:
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        m_scheduler = handle.promise().taskRefView().belongScheduler();
+        return false;
+    }
+
+    Scheduler* await_resume() const noexcept { return m_scheduler; }
+
+private:
+    Scheduler* m_scheduler = nullptr;
+};
+
+using RelayOutcome = std::expected<SpliceRelayResult, IOError>;
+
+// 这些 errno 表示该 fd 组合不支持 splice，而不是连接本身出错
+bool spliceUnsupported(const IOError& error)
+{
+    const auto system_code = static_cast<uint32_t>(error.code() >> 32);
+    return system_code == EINVAL || system_code == ENOSYS || system_code == EOPNOTSUPP;
+}
+
+void shutdownSocket(AsyncTcpSocket& socket, int how) noexcept
+{
+    const GHandle handle = socket.handle();
+    if (handle != GHandle::invalid()) {
+        (void)::shutdown(handle.fd, how);
+    }
+}
+
+Task<void> relayAndNotify(AsyncTcpSocket& from,
+                          AsyncTcpSocket& to,
+                          SpliceRelayOptions options,
+                          AsyncWaiter<RelayOutcome>* waiter)
+{
+    auto relay_result = co_await spliceRelay(from, to, options);
+    RelayOutcome outcome = std::unexpected(IOError(kNotReady, 0));
+    if (relay_result) {
+        outcome = std::move(relay_result.value());
+    }
+    if (!outcome) {
+        shutdownSocket(from, SHUT_RDWR);
+        shutdownSocket(to, SHUT_RDWR);
+    }
+    waiter->notify(std::move(outcome));
+    co_return;
+}
+
+} // namespace
+
+std::expected<SplicePipe, IOError> SplicePipe::create(size_t capacity)
+{
+#if defined(__linux__)
+    SplicePipe pipe;
+    if (::pipe2(pipe.m_fds, O_NONBLOCK | O_CLOEXEC) != 0) {
+        return std::unexpected(IOError(kOpenFailed, static_cast<uint32_t>(errno)));
+    }
+    int actual = -1;
+#ifdef F_SETPIPE_SZ
+    actual = ::fcntl(pipe.m_fds[1], F_SETPIPE_SZ, static_cast<int>(capacity));
+#endif
+    if (actual <= 0) {
+#ifdef F_GETPIPE_SZ
+        actual = ::fcntl(pipe.m_fds[1], F_GETPIPE_SZ);
+#endif
+    }
+    pipe.m_capacity = actual > 0 ? static_cast<size_t>(actual) : capacity;
+    return pipe;
+#else
+    (void)capacity;
+    return std::unexpected(IOError(kOpenFailed, static_cast<uint32_t>(ENOSYS)));
+#endif
+}
+
+SplicePipe::SplicePipe(SplicePipe&& other) noexcept
+    : m_fds{std::exchange(other.m_fds[0], -1), std::exchange(other.m_fds[1], -1)}
+    , m_capacity(std::exchange(other.m_capacity, 0))
+{
+}
+
+SplicePipe& SplicePipe::operator=(SplicePipe&& other) noexcept
+{
+    if (this != &other) {
+        reset();
+        m_fds[0] = std::exchange(other.m_fds[0], -1);
+        m_fds[1] = std::exchange(other.m_fds[1], -1);
+        m_capacity = std::exchange(other.m_capacity, 0);
+    }
+    return *this;
+}
+
+SplicePipe::~SplicePipe()
+{
+    reset();
+}
+
+void SplicePipe::reset() noexcept
+{
+    for (int& fd : m_fds) {
+        if (fd >= 0) {
+            (void)::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+Task<std::expected<SpliceRelayResult, IOError>>
+spliceRelay(AsyncTcpSocket& from, AsyncTcpSocket& to, SpliceRelayOptions options)
+{
+    SpliceRelayResult result;
+    const size_t chunk_size = options.chunkSize > 0 ? options.chunkSize : kSpliceRelayDefaultChunkSize;
+    const bool timed_write = options.writeTimeout.count() > 0;
+    bool from_eof = false;
+    std::vector<char> buffer;
+    size_t carry = 0; // 退回拷贝时从管道取回、尚未写出的字节
+
+    auto pipe = SplicePipe::create(chunk_size);
+    if (pipe) {
+        result.spliced = true;
+        const size_t splice_chunk = std::min(chunk_size, pipe->capacity());
+        // 每轮先把管道排空再读 socket：spliceIn 要求管道有空余，否则会空等 socket 可读
+        while (result.spliced && !from_eof) {
+            auto in_result = co_await from.spliceIn(pipe->writeFd(), splice_chunk);
+            if (!in_result) {
+                if (result.bytes == 0 && spliceUnsupported(in_result.error())) {
+                    result.spliced = false;
+                    break;
+                }
+                co_return std::unexpected(in_result.error());
+            }
+            size_t pending = in_result.value();
+            if (pending == 0) {
+                from_eof = true;
+                break;
+            }
+            while (pending > 0) {
+                std::expected<size_t, IOError> out_result;
+                if (timed_write) {
+                    out_result = co_await to.spliceOut(pipe->readFd(), pending).timeout(options.writeTimeout);
+                } else {
+                    out_result = co_await to.spliceOut(pipe->readFd(), pending);
+                }
+                if (!out_result) {
+                    if (result.bytes != 0 || !spliceUnsupported(out_result.error())) {
+                        co_return std::unexpected(out_result.error());
+                    }
+                    // 目标端不支持 splice：把已进管道的数据取回，交给拷贝路径先写出
+                    buffer.resize(std::max(chunk_size, pending));
+                    const ssize_t drained = ::read(pipe->readFd(), buffer.data(), pending);
+                    if (drained < 0) {
+                        co_return std::unexpected(IOError(kReadFailed, static_cast<uint32_t>(errno)));
+                    }
+                    carry = static_cast<size_t>(drained);
+                    result.spliced = false;
+                    break;
+                }
+                if (out_result.value() == 0) {
+                    co_return std::unexpected(IOError(kSendFailed, 0));
+                }
+                pending -= out_result.value();
+                result.bytes += out_result.value();
+            }
+        }
+    }
+
+    if (!from_eof) {
+        buffer.resize(std::max(buffer.size(), chunk_size));
+        while (true) {
+            size_t bytes = carry;
+            carry = 0;
+            if (bytes == 0) {
+                auto recv_result = co_await from.recv(buffer.data(), chunk_size);
+                if (!recv_result) {
+                    co_return std::unexpected(recv_result.error());
+                }
+                bytes = recv_result.value();
+                if (bytes == 0) {
+                    break;
+                }
+            }
+
+            size_t offset = 0;
+            while (offset < bytes) {
+                const char* data = buffer.data() + offset;
+                std::expected<size_t, IOError> send_result;
+                if (timed_write) {
+                    send_result = co_await to.send(data, bytes - offset).timeout(options.writeTimeout);
+                } else {
+                    send_result = co_await to.send(data, bytes - offset);
+                }
+                if (!send_result) {
+                    co_return std::unexpected(send_result.error());
+                }
+                if (send_result.value() == 0) {
+                    co_return std::unexpected(IOError(kSendFailed, 0));
+                }
+                offset += send_result.value();
+            }
+            result.bytes += bytes;
+        }
+    }
+
+    if (options.shutdownWrite) {
+        shutdownSocket(to, SHUT_WR);
+    }
+    co_return result;
+}
+
+Task<std::expected<SpliceTunnelResult, IOError>>
+spliceTunnel(AsyncTcpSocket& a, AsyncTcpSocket& b, SpliceRelayOptions options)
+{
+    options.shutdownWrite = true;
+
+    AsyncWaiter<RelayOutcome> backward_waiter;
+    auto* scheduler = co_await CurrentSchedulerAwaitable{};
+    auto backward_task = relayAndNotify(b, a, options, &backward_waiter);
+    if (!scheduleTask(scheduler, std::move(backward_task))) {
+        co_return std::unexpected(IOError(kNotRunningOnIOScheduler, 0));
+    }
+
+    auto forward_result = co_await spliceRelay(a, b, options);
+    RelayOutcome forward = std::unexpected(IOError(kNotReady, 0));
+    if (forward_result) {
+        forward = std::move(forward_result.value());
+    }
+    if (!forward) {
+        shutdownSocket(a, SHUT_RDWR);
+        shutdownSocket(b, SHUT_RDWR);
+    }
+
+    auto backward_result = co_await backward_waiter.wait();
+    RelayOutcome backward = std::unexpected(IOError(kNotReady, 0));
+    if (backward_result) {
+        backward = std::move(backward_result.value());
+    }
+
+    if (!forward) {
+        co_return std::unexpected(forward.error());
+    }
+    if (!backward) {
+        co_return std::unexpected(backward.error());
+    }
+    co_return SpliceTunnelResult{forward.value(), backward.value()};
+}
+
+} // namespace galay::async
@@ -0,0 +1,121 @@
+/**
+ * @file splice_relay.h
+ * @brief 基于 splice 的 socket → socket 零拷贝转发
+ * @author galay-kernel
+ * @version 1.0.0
+ *
+ * @details 在两个 AsyncTcpSocket 之间搬运字节流：socket → 管道 → socket，
+ * 数据只在内核的 socket 缓冲区与管道页之间移动，不经过用户态缓冲区。
+ * - io_uring：每一段提交 POLL_ADD → IORING_OP_SPLICE 链接 SQE
+ * - epoll：就绪后执行非阻塞 splice
+ * - kqueue 或 splice 不可用（例如某一端不是普通 TCP socket）：退回用户态 recv/send 拷贝
+ *
+ * @code
+ * Task<void> tunnel(AsyncTcpSocket& client, AsyncTcpSocket& upstream) {
+ *     auto result = co_await spliceTunnel(client, upstream);
+ *     if (result) {
+ *         // result->forward.bytes / result->backward.bytes
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef GALAY_KERNEL_SPLICE_RELAY_H
+#define GALAY_KERNEL_SPLICE_RELAY_H
+
+#include "async_tcp.h"
+#include "../core/task.h"
+#include <chrono>
+#include <cstddef>
+#include <expected>
+
+namespace galay::async
+{
+
+inline constexpr size_t kSpliceRelayDefaultChunkSize = 64 * 1024;  ///< 默认单轮搬运量，同时作为管道容量
+
+/**
+ * @brief splice 中转管道
+ * @details 持有一对非阻塞、CLOEXEC 的管道 fd，析构时关闭。
+ *          Linux 上按 capacity 调整管道容量（F_SETPIPE_SZ），调整失败时沿用内核默认值。
+ */
+class SplicePipe
+{
+public:
+    /**
+     * @brief 创建中转管道
+     * @param capacity 期望的管道容量
+     * @return 成功返回管道；非 Linux 平台返回 ENOSYS，其余失败返回 pipe2 的 errno
+     */
+    static std::expected<SplicePipe, galay::kernel::IOError> create(size_t capacity = kSpliceRelayDefaultChunkSize);
+
+    SplicePipe(const SplicePipe&) = delete;
+    SplicePipe& operator=(const SplicePipe&) = delete;
+    SplicePipe(SplicePipe&& other) noexcept;
+    SplicePipe& operator=(SplicePipe&& other) noexcept;
+    ~SplicePipe();
+
+    int readFd() const noexcept { return m_fds[0]; }       ///< 管道读端
+    int writeFd() const noexcept { return m_fds[1]; }      ///< 管道写端
+    size_t capacity() const noexcept { return m_capacity; } ///< 实际管道容量
+
+private:
+    SplicePipe() = default;
+    void reset() noexcept;
+
+    int m_fds[2] = {-1, -1};
+    size_t m_capacity = 0;
+};
+
+/**
+ * @brief 单向转发配置
+ */
+struct SpliceRelayOptions {
+    size_t chunkSize = kSpliceRelayDefaultChunkSize; ///< 单轮最多搬运的字节数
+    std::chrono::milliseconds writeTimeout{-1};      ///< 单次写向目标 socket 的超时；<=0 表示不限
+    bool shutdownWrite = false;                      ///< 来源 EOF 后是否对目标执行 shutdown(SHUT_WR)，用于隧道半关闭
+};
+
+/**
+ * @brief 单向转发结果
+ */
+struct SpliceRelayResult {
+    size_t bytes = 0;     ///< 已转发字节数
+    bool spliced = false; ///< true 表示走了 splice 零拷贝路径，false 表示用户态拷贝
+};
+
+/**
+ * @brief 双向隧道结果
+ */
+struct SpliceTunnelResult {
+    SpliceRelayResult forward;  ///< a → b 方向
+    SpliceRelayResult backward; ///< b → a 方向
+};
+
+/**
+ * @brief 把 from 的字节流转发到 to，直到 from 到达 EOF
+ * @param from 来源 socket（占用其读槽）
+ * @param to 目标 socket（占用其写槽）
+ * @param options 转发配置
+ * @return 成功返回转发统计；任一端出错时返回 IOError
+ * @note 首次 splice 即报 EINVAL/ENOSYS/EOPNOTSUPP 时静默退回用户态拷贝，已搬运的字节不会丢失
+ */
+galay::kernel::Task<std::expected<SpliceRelayResult, galay::kernel::IOError>>
+spliceRelay(AsyncTcpSocket& from, AsyncTcpSocket& to, SpliceRelayOptions options = SpliceRelayOptions());
+
+/**
+ * @brief 在 a 与 b 之间建立双向隧道，两个方向都结束后返回
+ * @param a 一端 socket
+ * @param b 另一端 socket
+ * @param options 两个方向共用的转发配置；shutdownWrite 固定为 true
+ * @return 两个方向的转发统计；任一方向出错时返回首个 IOError
+ * @details b → a 方向作为独立任务提交到当前 IO 调度器，与 a → b 并发推进。
+ *          一个方向正常 EOF 时只半关闭对端写方向；出错时对两端执行 shutdown(SHUT_RDWR)，
+ *          让另一方向尽快结束。调用方仍负责关闭两个 socket。
+ */
+galay::kernel::Task<std::expected<SpliceTunnelResult, galay::kernel::IOError>>
+spliceTunnel(AsyncTcpSocket& a, AsyncTcpSocket& b, SpliceRelayOptions options = SpliceRelayOptions());
+
+} // namespace galay::async
+
+#endif // GALAY_KERNEL_SPLICE_RELAY_H
@@ -116,6 +116,8 @@
         RECVFROM    = 1u << 10,///< 等待 recvfrom()
         SENDTO      = 1u << 11,///< 等待 sendto()
         SEQUENCE    = 1u << 12,///< 复合顺序等待器
+        SPLICEIN    = 1u << 13,///< socket → 管道的 splice（占用读槽）
+        SPLICEOUT   = 1u << 14,///< 管道 → socket 的 splice（占用写槽）
     };
 
     inline IOEventType operator|(IOEventType a, IOEventType b) {  ///< 组合两个事件位掩码
@@ -18,6 +18,16 @@
 #include <ws2tcpip.h>
 #endif
 
+#if defined(__linux__)
+#include <netinet/udp.h>
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif
+
 namespace galay::kernel
 {
 
@@ -218,4 +228,27 @@ std::expected<void, IOError> HandleOption::handleTcpDeferAccept(int seconds)
     return {};
 }
 
+/**
+ * @brief 开启或关闭 UDP_GRO
+ * @param enabled 是否允许内核合并接收数据报
+ * @return 成功返回 void，失败返回 IOError
+ */
+std::expected<void, IOError> HandleOption::handleUdpGro(bool enabled)
+{
+    if (m_handle.fd < 0) {
+        return std::unexpected(IOError(kParamInvalid, 0));
+    }
+
+#if defined(__linux__)
+    int opt = enabled ? 1 : 0;
+    if (::setsockopt(m_handle.fd, SOL_UDP, UDP_GRO, &opt, sizeof(opt)) != 0) {
+        return std::unexpected(IOError(kBindFailed, errno));
+    }
+#else
+    (void)enabled;
+#endif
+
+    return {};
+}
+
 }
@@ -185,6 +185,21 @@ public:
      */
     std::expected<void, IOError> handleTcpDeferAccept(int seconds = 1);
 
+    /**
+     * @brief 开启或关闭 UDP_GRO（仅 Linux）
+     *
+     * @param enabled true 表示允许内核把同一流的连续数据报合并后一次交付
+     * @return std::expected<void, IOError> 成功返回 void，失败返回 IOError
+     *
+     * @details
+     * - Linux：设置 UDP_GRO；合并段大小通过 UdpRecvDatagram::segment_size 回报，
+     *   用 segmentCount()/segment() 拆分
+     * - 非 Linux：静默成功，不改变行为
+     *
+     * @note 仅对 recvBatch() 有意义；单个 recvfrom() 会把合并后的整块数据交付给调用方。
+     */
+    std::expected<void, IOError> handleUdpGro(bool enabled = true);
+
 private:
     GHandle m_handle;  ///< 要配置的套接字句柄
 };
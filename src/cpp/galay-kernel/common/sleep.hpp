@@ -82,7 +82,7 @@ struct SleepAwaitable
      */
     template<concepts::ChronoDuration Duration>
     SleepAwaitable(Duration duration)
-        :m_timer(std::make_shared<SleepTimer>(duration)) {}
+        :m_timer(detail::makeTimerNode<SleepTimer>(duration)) {}
 
     SleepAwaitable(SleepAwaitable&&) noexcept = default;
     SleepAwaitable& operator=(SleepAwaitable&&) noexcept = default;
@@ -7,6 +7,7 @@
  * @details 定义 galay-kernel 中所有定时器管理器使用的核心 Timer 抽象。
  * 每个 Timer 存储一个相对延迟（纳秒），并在首次查询时延迟计算绝对过期时间。
  * 支持通过原子标志取消。CBTimer 通过 std::function 回调扩展 Timer。
+ * Timer 内嵌时间轮侵入式链表节点，时间轮插入、级联与摘除均不分配内存。
  */
 
 #ifndef GALAY_TIMER_HPP
@@ -14,15 +15,38 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <utility>
 
 #include "concepts.h"
 
 namespace galay::kernel
 {
 
+class Timer;
+
+namespace detail
+{
+
+class TimerWheelSlot;
+
+/**
+ * @brief 时间轮侵入式双向链表节点
+ * @details 嵌在 Timer 中时 owner 指向所属 Timer；作为槽位哨兵时 owner 为空。
+ * 只由驱动该时间轮的单一线程读写。
+ */
+struct TimerWheelHook {
+    TimerWheelHook* prev = nullptr;
+    TimerWheelHook* next = nullptr;
+    Timer* owner = nullptr;
+    const void* wheel = nullptr;  ///< 所属时间轮标识；未链入任何时间轮时为空
+};
+
+} // namespace detail
+
 /**
  * @brief 跟踪定时器生命周期状态的位掩码标志
  */
@@ -127,8 +151,180 @@ protected:
     uint64_t m_delay = 0;                  ///< 相对延迟（纳秒）
     mutable uint64_t m_expireTime = 0;     ///< 绝对过期时间（纳秒，延迟计算）
     std::atomic<int> m_flag{0};
+
+private:
+    friend class detail::TimerWheelSlot;
+
+    detail::TimerWheelHook m_wheelHook{nullptr, nullptr, this, nullptr};  ///< 时间轮链表节点
+    ptr m_wheelRef;                        ///< 链入时间轮期间由时间轮持有的自引用
+};
+
+namespace detail
+{
+
+/**
+ * @brief 时间轮槽位：以哨兵节点组织的侵入式循环链表
+ *
+ * @details 链入时接管调用方传入的 Timer::ptr 并存入 Timer 自身，
+ * 摘除时交还，因此 push/erase/splice 都不分配内存。
+ * 哨兵自指，槽位对象不可拷贝也不可移动；放进 std::vector 时只能按数量构造。
+ */
+class TimerWheelSlot
+{
+public:
+    TimerWheelSlot() noexcept
+    {
+        m_head.prev = &m_head;
+        m_head.next = &m_head;
+    }
+
+    ~TimerWheelSlot()
+    {
+        clear();
+    }
+
+    TimerWheelSlot(const TimerWheelSlot&) = delete;
+    TimerWheelSlot& operator=(const TimerWheelSlot&) = delete;
+
+    bool empty() const noexcept { return m_head.next == &m_head; }
+
+    /**
+     * @brief 把定时器链到槽尾并接管其引用
+     * @param timer 非空且未链入任何时间轮的定时器
+     * @param wheel 所属时间轮标识，用于 linkedTo() 校验
+     */
+    void pushBack(Timer::ptr timer, const void* wheel) noexcept
+    {
+        Timer* raw = timer.get();
+        TimerWheelHook& hook = raw->m_wheelHook;
+        hook.prev = m_head.prev;
+        hook.next = &m_head;
+        m_head.prev->next = &hook;
+        m_head.prev = &hook;
+        hook.wheel = wheel;
+        raw->m_wheelRef = std::move(timer);
+    }
+
+    /**
+     * @brief 摘下槽首定时器并交还引用
+     * @return 槽为空时返回空指针
+     */
+    Timer::ptr popFront() noexcept
+    {
+        if (empty()) {
+            return {};
+        }
+        return unlink(*m_head.next->owner);
+    }
+
+    /**
+     * @brief O(1) 把 other 的全部定时器按原顺序接到本槽尾部
+     */
+    void spliceBack(TimerWheelSlot& other) noexcept
+    {
+        if (other.empty()) {
+            return;
+        }
+        TimerWheelHook* first = other.m_head.next;
+        TimerWheelHook* last = other.m_head.prev;
+        first->prev = m_head.prev;
+        m_head.prev->next = first;
+        last->next = &m_head;
+        m_head.prev = last;
+        other.m_head.prev = &other.m_head;
+        other.m_head.next = &other.m_head;
+    }
+
+    /**
+     * @brief 释放槽内全部定时器
+     * @return 释放的定时器数量
+     */
+    size_t clear() noexcept
+    {
+        size_t count = 0;
+        while (!empty()) {
+            (void)popFront();
+            ++count;
+        }
+        return count;
+    }
+
+    /** @brief 定时器当前是否链在 wheel 标识的时间轮上 */
+    static bool linkedTo(const Timer& timer, const void* wheel) noexcept
+    {
+        return wheel != nullptr && timer.m_wheelHook.wheel == wheel;
+    }
+
+    /** @brief 定时器当前是否链在任意时间轮上 */
+    static bool linked(const Timer& timer) noexcept
+    {
+        return timer.m_wheelHook.wheel != nullptr;
+    }
+
+    /**
+     * @brief O(1) 把定时器从所在槽解链并交还时间轮持有的引用
+     * @pre linked(timer) 为 true
+     */
+    static Timer::ptr unlink(Timer& timer) noexcept
+    {
+        TimerWheelHook& hook = timer.m_wheelHook;
+        hook.prev->next = hook.next;
+        hook.next->prev = hook.prev;
+        hook.prev = nullptr;
+        hook.next = nullptr;
+        hook.wheel = nullptr;
+        return std::move(timer.m_wheelRef);
+    }
+
+private:
+    TimerWheelHook m_head;  ///< 哨兵节点
+};
+
+void* allocateTaskFrame(std::size_t size);  ///< 定义于 core/task.cc
+void releaseTaskFrame(void* frame) noexcept;  ///< 定义于 core/task.cc
+
+/**
+ * @brief 定时器节点分配器：复用协程帧池的 per-thread size-class slab
+ *
+ * @details 供 std::allocate_shared 一次性分配控制块与定时器本体。
+ * 定时器常在 IO 线程创建、在另一线程随最后一个引用释放，归还走帧池的 remote-free 链。
+ */
+template <typename T>
+struct TimerNodeAllocator {
+    using value_type = T;
+
+    TimerNodeAllocator() noexcept = default;
+    template <typename U>
+    TimerNodeAllocator(const TimerNodeAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                      "timer node must fit the frame pool alignment");
+        return static_cast<T*>(allocateTaskFrame(n * sizeof(T)));
+    }
+    void deallocate(T* node, std::size_t) noexcept { releaseTaskFrame(node); }
+
+    template <typename U>
+    bool operator==(const TimerNodeAllocator<U>&) const noexcept { return true; }
 };
 
+/**
+ * @brief 创建 awaitable 私有的定时器节点
+ * @details 定义 GALAY_DISABLE_TASK_FRAME_POOL 时与协程帧一致退回全局堆。
+ */
+template <typename TimerT, typename... Args>
+std::shared_ptr<TimerT> makeTimerNode(Args&&... args)
+{
+#ifndef GALAY_DISABLE_TASK_FRAME_POOL
+    return std::allocate_shared<TimerT>(TimerNodeAllocator<TimerT>{}, std::forward<Args>(args)...);
+#else
+    return std::make_shared<TimerT>(std::forward<Args>(args)...);
+#endif
+}
+
+} // namespace detail
+
 /**
  * @brief 回调驱动定时器
  *
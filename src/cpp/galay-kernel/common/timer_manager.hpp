@@ -6,6 +6,7 @@
  *
  * @details 实现受时钟机制启发的五层时间轮（时/分/秒类比）。
  * 插入和取消操作为 O(1)。单线程：所有公共方法必须从同一线程调用。
+ * 槽位是 Timer 内嵌节点组成的侵入式链表，插入、级联、摘除均不分配内存。
  *
  * 默认 tick 粒度为 50 毫秒，覆盖范围约 6.8 年。
  * tick 时长可在构造时配置。
@@ -19,7 +20,6 @@
 #include "timer.hpp"
 #include <cstddef>
 #include <cstdint>
-#include <list>
 #include <vector>
 #include <chrono>
 
@@ -42,6 +42,8 @@ namespace galay::kernel
      *
      * @details 实现类似钟面的五层时间轮。插入和取消操作为 O(1)。
      * 单线程：所有公共方法必须从同一线程调用。
+     * 每个槽是 detail::TimerWheelSlot 侵入式链表，时间轮通过 Timer 内嵌的自引用持有定时器，
+     * erase() 可在到期前 O(1) 解链并立即释放引用。
      *
      * 默认 tick 粒度为 50 毫秒，覆盖约 6.8 年。
      * tick 时长可在构造时配置。
@@ -52,7 +54,7 @@ namespace galay::kernel
     {
     public:
         using ptr = std::shared_ptr<TimingWheelTimerManager>;
-        using TimerList = std::list<Timer::ptr>;
+        using TimerSlot = detail::TimerWheelSlot;
 
         // 时间轮配置
         static constexpr size_t WHEEL1_SIZE = 256;  ///< 第1层：256 个槽
@@ -146,34 +148,34 @@ namespace galay::kernel
                 return false;  // 超出范围
             }
 
-            // 根据延迟 tick 数选择合适的层
-            if (delayTicks < WHEEL1_SPAN) {
-                // 第1层：0-255 ticks
-                size_t slot = absoluteTick & (WHEEL1_SIZE - 1);
-                m_wheel1[slot].push_back(timer);
-            } else if (delayTicks < WHEEL2_SPAN) {
-                // 第2层：256-16383 ticks
-                size_t slot = (absoluteTick >> 8) & (WHEEL2_SIZE - 1);
-                m_wheel2[slot].push_back(timer);
-            } else if (delayTicks < WHEEL3_SPAN) {
-                // 第3层：16384-1048575 ticks
-                size_t slot = (absoluteTick >> 14) & (WHEEL3_SIZE - 1);
-                m_wheel3[slot].push_back(timer);
-            } else if (delayTicks < WHEEL4_SPAN) {
-                // 第4层：1048576-67108863 ticks
-                size_t slot = (absoluteTick >> 20) & (WHEEL4_SIZE - 1);
-                m_wheel4[slot].push_back(timer);
-            } else {
-                // 第5层：67108864-4294967295 ticks
-                size_t slot = (absoluteTick >> 26) & (WHEEL5_SIZE - 1);
-                m_wheel5[slot].push_back(timer);
+            if (detail::TimerWheelSlot::linked(*timer)) {
+                return false;  // 同一定时器不能同时挂在多个槽上
             }
 
+            place(std::move(timer), delayTicks, absoluteTick);
             ++m_size;
 
             return true;
         }
 
+        /**
+         * @brief 在到期前摘除定时器
+         * @param timer 待摘除的定时器
+         * @return true 定时器原本链在本时间轮上且已摘除；false 未链入或属于其他时间轮
+         *
+         * @details O(1) 解链并释放时间轮持有的引用，不分配内存。不修改取消标志，
+         * 调用方通常先 cancel() 再 erase()。必须从驱动 tick() 的线程调用。
+         */
+        bool erase(Timer& timer) noexcept
+        {
+            if (!detail::TimerWheelSlot::linkedTo(timer, wheelTag())) {
+                return false;
+            }
+            Timer::ptr released = detail::TimerWheelSlot::unlink(timer);
+            --m_size;
+            return true;
+        }
+
         /**
          * @brief 检查时间轮是否包含任何活跃定时器
          * @return 若没有待处理的定时器则返回 true
@@ -276,17 +278,15 @@ namespace galay::kernel
         void processWheel1()
         {
             size_t idx = m_currentTick & (WHEEL1_SIZE - 1);
-            auto& slot = m_wheel1[idx];
-
-            auto it = slot.begin();
-            while (it != slot.end()) {
-                auto timer = *it;
 
+            // 先整体摘到局部槽：回调中新加入同一槽的定时器留到下一圈，
+            // 回调中 erase() 的定时器仍能从局部槽正确解链。
+            TimerSlot due;
+            due.spliceBack(m_wheel1[idx]);
+            while (Timer::ptr timer = due.popFront()) {
+                --m_size;
                 // 第1层的定时器都应该到期，直接执行
                 timer->handleTimeout();
-
-                it = slot.erase(it);
-                --m_size;
             }
         }
 
@@ -333,12 +333,12 @@ namespace galay::kernel
          * @details 每个定时器被重新评估：若已过期则立即触发；
          * 否则插入到合适的时间轮层。
          */
-        void cascadeSlot(TimerList& slot, uint64_t nowNs)
+        void cascadeSlot(TimerSlot& slot, uint64_t nowNs)
         {
-            TimerList temp = std::move(slot);
-            slot.clear();
+            TimerSlot temp;
+            temp.spliceBack(slot);
 
-            for (auto& timer : temp) {
+            while (Timer::ptr timer = temp.popFront()) {
                 if (timer->done() || timer->cancelled()) {
                     --m_size;
                     continue;
@@ -371,21 +371,8 @@ namespace galay::kernel
                 uint64_t absoluteTick = m_currentTick + remainingTicks;
 
                 // 重新分配到合适的层（使用与 push 相同的逻辑）
-                if (remainingTicks < WHEEL1_SPAN) {
-                    size_t slot_idx = absoluteTick & (WHEEL1_SIZE - 1);
-                    m_wheel1[slot_idx].push_back(timer);
-                } else if (remainingTicks < WHEEL2_SPAN) {
-                    size_t slot_idx = (absoluteTick >> 8) & (WHEEL2_SIZE - 1);
-                    m_wheel2[slot_idx].push_back(timer);
-                } else if (remainingTicks < WHEEL3_SPAN) {
-                    size_t slot_idx = (absoluteTick >> 14) & (WHEEL3_SIZE - 1);
-                    m_wheel3[slot_idx].push_back(timer);
-                } else if (remainingTicks < WHEEL4_SPAN) {
-                    size_t slot_idx = (absoluteTick >> 20) & (WHEEL4_SIZE - 1);
-                    m_wheel4[slot_idx].push_back(timer);
-                } else if (remainingTicks < WHEEL5_SPAN) {
-                    size_t slot_idx = (absoluteTick >> 26) & (WHEEL5_SIZE - 1);
-                    m_wheel5[slot_idx].push_back(timer);
+                if (remainingTicks < WHEEL5_SPAN) {
+                    place(std::move(timer), remainingTicks, absoluteTick);
                 } else {
                     // 超出范围，丢弃
                     --m_size;
@@ -393,6 +380,41 @@ namespace galay::kernel
             }
         }
 
+        /**
+         * @brief 按延迟 tick 数把定时器链入对应层的槽
+         * @param timer 待链入的定时器，所有权转入时间轮
+         * @param delayTicks 距离到期的 tick 数，必须小于 WHEEL5_SPAN
+         * @param absoluteTick 绝对到期 tick
+         */
+        void place(Timer::ptr timer, uint64_t delayTicks, uint64_t absoluteTick) noexcept
+        {
+            const void* tag = wheelTag();
+            if (delayTicks < WHEEL1_SPAN) {
+                // 第1层：0-255 ticks
+                m_wheel1[absoluteTick & (WHEEL1_SIZE - 1)].pushBack(std::move(timer), tag);
+            } else if (delayTicks < WHEEL2_SPAN) {
+                // 第2层：256-16383 ticks
+                m_wheel2[(absoluteTick >> 8) & (WHEEL2_SIZE - 1)].pushBack(std::move(timer), tag);
+            } else if (delayTicks < WHEEL3_SPAN) {
+                // 第3层：16384-1048575 ticks
+                m_wheel3[(absoluteTick >> 14) & (WHEEL3_SIZE - 1)].pushBack(std::move(timer), tag);
+            } else if (delayTicks < WHEEL4_SPAN) {
+                // 第4层：1048576-67108863 ticks
+                m_wheel4[(absoluteTick >> 20) & (WHEEL4_SIZE - 1)].pushBack(std::move(timer), tag);
+            } else {
+                // 第5层：67108864-4294967295 ticks
+                m_wheel5[(absoluteTick >> 26) & (WHEEL5_SIZE - 1)].pushBack(std::move(timer), tag);
+            }
+        }
+
+        /**
+         * @brief 时间轮标识：第1层槽数组地址，在移动构造/赋值后保持不变
+         */
+        const void* wheelTag() const noexcept
+        {
+            return m_wheel1.data();
+        }
+
         /**
          * @brief 将时间轮的起始时间和当前 tick 重置为当前时刻
          */
@@ -406,11 +428,11 @@ namespace galay::kernel
         uint64_t m_tickDuration;                               ///< 每 tick 的纳秒数
         uint64_t m_currentTick;                                ///< 当前 tick 位置
 
-        std::vector<TimerList> m_wheel1;                       ///< 第1层时间轮
-        std::vector<TimerList> m_wheel2;                       ///< 第2层时间轮
-        std::vector<TimerList> m_wheel3;                       ///< 第3层时间轮
-        std::vector<TimerList> m_wheel4;                       ///< 第4层时间轮
-        std::vector<TimerList> m_wheel5;                       ///< 第5层时间轮
+        std::vector<TimerSlot> m_wheel1;                       ///< 第1层时间轮
+        std::vector<TimerSlot> m_wheel2;                       ///< 第2层时间轮
+        std::vector<TimerSlot> m_wheel3;                       ///< 第3层时间轮
+        std::vector<TimerSlot> m_wheel4;                       ///< 第4层时间轮
+        std::vector<TimerSlot> m_wheel5;                       ///< 第5层时间轮
 
         size_t m_size;                                         ///< 活跃定时器总数
         std::chrono::steady_clock::time_point m_startTime;     ///< 时间轮纪元时间点
@@ -8,6 +8,7 @@
  * - 添加路径：无锁 MPSC 队列（ConcurrentQueue）接收新定时器
  * - 处理路径：单线程批量出队和时间轮操作
  * - 取消：每个 Timer 上的原子标志
+ * - 槽位：Timer 内嵌节点组成的侵入式链表，入轮与级联不分配内存
  *
  * 性能特征：
  * - 添加定时器：O(1)，无锁
@@ -23,7 +24,6 @@
 #include <concurrentqueue/moodycamel/concurrentqueue.h>
 #include <cstddef>
 #include <cstdint>
-#include <list>
 #include <vector>
 #include <chrono>
 #include <atomic>
@@ -40,6 +40,7 @@ namespace galay::kernel
  * - push(): 多线程安全，可从任意线程调用
  * - tick(): 单线程调用，由定时器线程驱动
  * - size()/empty(): 近似值，用于监控
+ * - 取消跨线程发生，只设置原子标志；已取消定时器在级联或到期时被惰性丢弃
  *
  * 时间轮结构（默认 1ms tick）：
  * - 第1层：256个槽，每槽 1ms，覆盖 0-255ms
@@ -52,7 +53,7 @@ class ThreadSafeTimerManager
 {
 public:
     using ptr = std::shared_ptr<ThreadSafeTimerManager>;
-    using TimerList = std::list<Timer::ptr>;
+    using TimerSlot = detail::TimerWheelSlot;
 
     // 时间轮配置
     static constexpr size_t WHEEL1_SIZE = 256;
@@ -189,7 +190,7 @@ public:
 
         for (auto* wheel : {&m_wheel1, &m_wheel2, &m_wheel3, &m_wheel4, &m_wheel5}) {
             for (auto& slot : *wheel) {
-                slot.clear();
+                (void)slot.clear();
             }
         }
 
@@ -292,7 +293,8 @@ private:
      */
     void addTimerToWheel(Timer::ptr timer, uint64_t nowNs, uint64_t currentTickFromStart)
     {
-        if (!timer || timer->done() || timer->cancelled()) {
+        if (!timer || timer->done() || timer->cancelled() ||
+            detail::TimerWheelSlot::linked(*timer)) {
             return;
         }
 
@@ -324,24 +326,7 @@ private:
         // 计算绝对到期 tick
         uint64_t absoluteTick = currentTickFromStart + delayTicks;
 
-        // 根据延迟 tick 数选择合适的层
-        if (delayTicks < WHEEL1_SPAN) {
-            size_t slot = absoluteTick & (WHEEL1_SIZE - 1);
-            m_wheel1[slot].push_back(std::move(timer));
-        } else if (delayTicks < WHEEL2_SPAN) {
-            size_t slot = (absoluteTick >> 8) & (WHEEL2_SIZE - 1);
-            m_wheel2[slot].push_back(std::move(timer));
-        } else if (delayTicks < WHEEL3_SPAN) {
-            size_t slot = (absoluteTick >> 14) & (WHEEL3_SIZE - 1);
-            m_wheel3[slot].push_back(std::move(timer));
-        } else if (delayTicks < WHEEL4_SPAN) {
-            size_t slot = (absoluteTick >> 20) & (WHEEL4_SIZE - 1);
-            m_wheel4[slot].push_back(std::move(timer));
-        } else {
-            size_t slot = (absoluteTick >> 26) & (WHEEL5_SIZE - 1);
-            m_wheel5[slot].push_back(std::move(timer));
-        }
-
+        place(std::move(timer), delayTicks, absoluteTick);
         m_wheelSize.fetch_add(1, std::memory_order_relaxed);
     }
 
@@ -351,15 +336,15 @@ private:
     void processWheel1()
     {
         size_t idx = m_currentTick & (WHEEL1_SIZE - 1);
-        auto& slot = m_wheel1[idx];
+        TimerSlot due;
+        due.spliceBack(m_wheel1[idx]);
 
-        for (auto& timer : slot) {
+        while (Timer::ptr timer = due.popFront()) {
             if (!timer->done() && !timer->cancelled()) {
                 timer->handleTimeout();
             }
             m_wheelSize.fetch_sub(1, std::memory_order_relaxed);
         }
-        slot.clear();
     }
 
     /**
@@ -392,16 +377,16 @@ private:
     /**
      * @brief 将指定槽的定时器重新分配到合适的层
      */
-    void cascadeSlot(TimerList& slot)
+    void cascadeSlot(TimerSlot& slot)
     {
-        TimerList temp = std::move(slot);
-        slot.clear();
+        TimerSlot temp;
+        temp.spliceBack(slot);
 
         auto now = std::chrono::steady_clock::now();
         uint64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
             now.time_since_epoch()).count();
 
-        for (auto& timer : temp) {
+        while (Timer::ptr timer = temp.popFront()) {
             if (timer->done() || timer->cancelled()) {
                 m_wheelSize.fetch_sub(1, std::memory_order_relaxed);
                 continue;
@@ -427,21 +412,8 @@ private:
             uint64_t absoluteTick = m_currentTick + remainingTicks;
 
             // 重新分配到合适的层（不增加 wheelSize，因为已经在轮中）
-            if (remainingTicks < WHEEL1_SPAN) {
-                size_t slot_idx = absoluteTick & (WHEEL1_SIZE - 1);
-                m_wheel1[slot_idx].push_back(std::move(timer));
-            } else if (remainingTicks < WHEEL2_SPAN) {
-                size_t slot_idx = (absoluteTick >> 8) & (WHEEL2_SIZE - 1);
-                m_wheel2[slot_idx].push_back(std::move(timer));
-            } else if (remainingTicks < WHEEL3_SPAN) {
-                size_t slot_idx = (absoluteTick >> 14) & (WHEEL3_SIZE - 1);
-                m_wheel3[slot_idx].push_back(std::move(timer));
-            } else if (remainingTicks < WHEEL4_SPAN) {
-                size_t slot_idx = (absoluteTick >> 20) & (WHEEL4_SIZE - 1);
-                m_wheel4[slot_idx].push_back(std::move(timer));
-            } else if (remainingTicks < WHEEL5_SPAN) {
-                size_t slot_idx = (absoluteTick >> 26) & (WHEEL5_SIZE - 1);
-                m_wheel5[slot_idx].push_back(std::move(timer));
+            if (remainingTicks < WHEEL5_SPAN) {
+                place(std::move(timer), remainingTicks, absoluteTick);
             } else {
                 // 超出范围，丢弃
                 m_wheelSize.fetch_sub(1, std::memory_order_relaxed);
@@ -449,6 +421,25 @@ private:
         }
     }
 
+    /**
+     * @brief 按延迟 tick 数把定时器链入对应层的槽，所有权转入时间轮
+     */
+    void place(Timer::ptr timer, uint64_t delayTicks, uint64_t absoluteTick) noexcept
+    {
+        const void* tag = m_wheel1.data();
+        if (delayTicks < WHEEL1_SPAN) {
+            m_wheel1[absoluteTick & (WHEEL1_SIZE - 1)].pushBack(std::move(timer), tag);
+        } else if (delayTicks < WHEEL2_SPAN) {
+            m_wheel2[(absoluteTick >> 8) & (WHEEL2_SIZE - 1)].pushBack(std::move(timer), tag);
+        } else if (delayTicks < WHEEL3_SPAN) {
+            m_wheel3[(absoluteTick >> 14) & (WHEEL3_SIZE - 1)].pushBack(std::move(timer), tag);
+        } else if (delayTicks < WHEEL4_SPAN) {
+            m_wheel4[(absoluteTick >> 20) & (WHEEL4_SIZE - 1)].pushBack(std::move(timer), tag);
+        } else {
+            m_wheel5[(absoluteTick >> 26) & (WHEEL5_SIZE - 1)].pushBack(std::move(timer), tag);
+        }
+    }
+
     /**
      * @brief 重置时间轮
      */
@@ -467,11 +458,11 @@ private:
     uint64_t m_currentTick;
 
     // 时间轮（只由定时器线程访问，无需加锁）
-    std::vector<TimerList> m_wheel1;
-    std::vector<TimerList> m_wheel2;
-    std::vector<TimerList> m_wheel3;
-    std::vector<TimerList> m_wheel4;
-    std::vector<TimerList> m_wheel5;
+    std::vector<TimerSlot> m_wheel1;
+    std::vector<TimerSlot> m_wheel2;
+    std::vector<TimerSlot> m_wheel3;
+    std::vector<TimerSlot> m_wheel4;
+    std::vector<TimerSlot> m_wheel5;
 
     // 待处理队列（无锁 MPSC）
     moodycamel::ConcurrentQueue<Timer::ptr> m_pendingQueue;
@@ -1444,7 +1444,7 @@ private:
         stream.control.gate.store(
             ProducerGate::kPublished,
             std::memory_order_seq_cst);
-        return detachPublishedWaiter();
+        return detachPublishedWaiter(stream);
     }
 
     /**
@@ -1713,10 +1713,11 @@ private:
      * @brief waiter arming 后无分配检查是否已有可读消息。
      * @details 首次 stream 激活仍通过 m_readyStack 的 seq_cst 发布/摘取加入 waiter
      *          全序。随后扫描所有已注册 stream：kSending 的 producer 尚未执行
-     *          waiter 仲裁，consumer 可继续 arming；kPublished 表示数据和 ready
-     *          membership 已发布，必须取消挂起；kOpen 时 acquire published 计数。
+     *          waiter 仲裁，consumer 可继续 arming；kPublished 与 kOpen 都已发布
+     *          published 计数，只有计数超过本 consumer 已消费位置才取消挂起。
      *          gate 与 waiter phase 共用 SC 全序，因此返回 false 后的新发布必由
-     *          pending/armed 路径唤醒。
+     *          pending/armed 路径唤醒；已被取走的 kPublished 发送由
+     *          detachPublishedWaiter(stream) 跳过，不会无数据唤醒新 waiter。
      */
     [[nodiscard]] bool hasPublishedValueForWaiter() noexcept
     {
@@ -1736,22 +1737,12 @@ private:
         stream =
             m_streamHead.load(std::memory_order_acquire);
         while (stream != nullptr) {
-            const ProducerGate gate =
+            // gate 的 SC 读取参与 waiter 全序；读到 Sending 时当前 sender 的 gate
+            // 发布同步此前已完成的同 stream 发送，读到 Published/Open 时同步本次
+            // 发布，因此三种状态都只需比较 published 计数。kPublished 的数据
+            // 可能已被本 consumer 取走、仅剩 finishSend() 未执行，不能视为可读。
+            [[maybe_unused]] const ProducerGate gate =
                 stream->control.gate.load(std::memory_order_seq_cst);
-            if (gate == ProducerGate::kPublished) {
-                return true;
-            }
-            // 读取 Sending 后再次检查上一轮发布：当前 sender 的 gate 发布同步
-            // 此前已完成的同 stream 发送，避免旧数据与本轮预留失败共同留下一个
-            // 已经 armed、却再无 producer 仲裁的 waiter。
-            if (gate == ProducerGate::kSending) {
-                if (stream->consumer.localConsumed !=
-                    stream->shared.published.load(std::memory_order_acquire)) {
-                    return true;
-                }
-                stream = stream->next;
-                continue;
-            }
             if (stream->consumer.localConsumed !=
                 stream->shared.published.load(std::memory_order_acquire)) {
                 return true;
@@ -1792,6 +1783,40 @@ private:
         }
     }
 
+    /**
+     * @brief producer 发布后的 waiter 仲裁；跳过 consumer 已经取走的发布。
+     * @details consumer 取空后立即重新 arming 时，本次发布的数据可能已被取走。
+     *          consumer 在 arming CAS 之前写入 consumed 计数，读到 Arming/Armed
+     *          即同步该计数；计数已覆盖本次发布时既不置 kArmingPending，也不
+     *          唤醒新 waiter，避免其无数据恢复。
+     */
+    [[nodiscard]] TaskState* detachPublishedWaiter(
+        const ProducerStream& stream) noexcept
+    {
+        WaiterPhase phase = m_waiterPhase.load(std::memory_order_seq_cst);
+        for (;;) {
+            if (phase == WaiterPhase::kIdle ||
+                phase == WaiterPhase::kArmingPending ||
+                phase == WaiterPhase::kWaking) {
+                return nullptr;
+            }
+            if (stream.consumer.consumed.load(std::memory_order_acquire) >=
+                stream.producer.localPublished) {
+                return nullptr;
+            }
+            if (phase == WaiterPhase::kArmed) {
+                return detachArmedWaiter();
+            }
+            if (m_waiterPhase.compare_exchange_weak(
+                    phase,
+                    WaiterPhase::kArmingPending,
+                    std::memory_order_seq_cst,
+                    std::memory_order_seq_cst)) {
+                return nullptr;
+            }
+        }
+    }
+
     /**
      * @brief 在不访问 channel 的情况下接管 registration 引用并调度 waiter。
      * @param waiterState detachPublishedWaiter() 返回的非空 owning 指针。
@@ -1833,8 +1858,13 @@ private:
         }
     }
 
+    /**
+     * @brief 把已 begin 的 waiter 发布为 kArmed。
+     * @param timeoutTimer 成功时转交给 channel；失败时原样归还，调用方可重新 arming。
+     * @return 成功挂起返回 true；arming 被 producer/close 仲裁撤销返回 false。
+     */
     bool publishWaiter(TaskState* waiterState,
-                       TimeoutTimer::ptr timeoutTimer = {}) noexcept
+                       TimeoutTimer::ptr& timeoutTimer) noexcept
     {
         if (waiterState == nullptr) {
             cancelWaiterRegistration();
@@ -1850,7 +1880,7 @@ private:
         if (!m_waiterRegistration.arm(static_cast<void*>(registeredState))) {
             TaskRef releasedRegistration =
                 kernel::detail::TaskRefStorageAccess::adoptState(registeredState);
-            m_waiterTimer.reset();
+            timeoutTimer = std::move(m_waiterTimer);
             cancelWaiterRegistration();
             return false;
         }
@@ -1869,12 +1899,18 @@ private:
             TaskRef releasedRegistration =
                 kernel::detail::TaskRefStorageAccess::adoptState(registeredState);
         }
-        m_waiterTimer.reset();
+        timeoutTimer = std::move(m_waiterTimer);
         m_waiterRegistration.clearPendingWake();
         m_waiterPhase.store(WaiterPhase::kIdle, std::memory_order_release);
         return false;
     }
 
+    bool publishWaiter(TaskState* waiterState) noexcept
+    {
+        TimeoutTimer::ptr noTimer;
+        return publishWaiter(waiterState, noTimer);
+    }
+
     bool clearWaiter(TaskState* waiterState) noexcept
     {
         if (waiterState == nullptr) {
@@ -1982,24 +2018,31 @@ inline bool UnboundedRecvAwaitable<T>::await_suspend(
 {
     auto* channel = m_channel;
     TimeoutTimer::ptr timeoutTimer = std::move(m_timeoutTimer);
-    if (tryReceiveNow() || channel->isClosedAndDrained()) {
-        return false;
-    }
-
     TaskState* waiterState = handle.promise().taskRefView().state();
-    m_waiterState = waiterState;
-    if (!channel->beginWaiterRegistration()) {
-        m_waiterState = nullptr;
-        return false;
-    }
-    if (channel->hasPublishedValueForWaiter() ||
-        channel->isClosedAndDrained()) {
-        channel->cancelWaiterRegistration();
+    for (;;) {
+        if (tryReceiveNow() || channel->isClosedAndDrained()) {
+            return false;
+        }
+        m_waiterState = waiterState;
+        if (!channel->beginWaiterRegistration()) {
+            m_waiterState = nullptr;
+            return false;
+        }
+        if (channel->hasPublishedValueForWaiter() ||
+            channel->isClosedAndDrained()) {
+            channel->cancelWaiterRegistration();
+            m_waiterState = nullptr;
+            return false;
+        }
+        // 发布后生产者可立即恢复并销毁协程帧，因此成功时必须是最后一次访问 awaiter。
+        if (channel->publishWaiter(waiterState, timeoutTimer)) {
+            return true;
+        }
+        // kArmingPending 撤销了 arming：通常是新数据已发布，下一轮直接取走；
+        // 罕见的 phase ABA 下没有数据，则带着归还的 timer 重新 arming，
+        // 不能无数据恢复并被 await_resume() 报告为超时。
         m_waiterState = nullptr;
-        return false;
     }
-    // 发布后生产者可立即恢复并销毁协程帧，因此必须是最后一次访问 awaiter。
-    return channel->publishWaiter(waiterState, std::move(timeoutTimer));
 }
 
 template <UnboundedValue T>
@@ -2057,24 +2100,31 @@ inline bool UnboundedRecvBatchAwaitable<T>::await_suspend(
 {
     auto* channel = m_channel;
     TimeoutTimer::ptr timeoutTimer = std::move(m_timeoutTimer);
-    if (tryReceiveNow() || channel->isClosedAndDrained()) {
-        return false;
-    }
-
     TaskState* waiterState = handle.promise().taskRefView().state();
-    m_waiterState = waiterState;
-    if (!channel->beginWaiterRegistration()) {
-        m_waiterState = nullptr;
-        return false;
-    }
-    if (channel->hasPublishedValueForWaiter() ||
-        channel->isClosedAndDrained()) {
-        channel->cancelWaiterRegistration();
+    for (;;) {
+        if (tryReceiveNow() || channel->isClosedAndDrained()) {
+            return false;
+        }
+        m_waiterState = waiterState;
+        if (!channel->beginWaiterRegistration()) {
+            m_waiterState = nullptr;
+            return false;
+        }
+        if (channel->hasPublishedValueForWaiter() ||
+            channel->isClosedAndDrained()) {
+            channel->cancelWaiterRegistration();
+            m_waiterState = nullptr;
+            return false;
+        }
+        // 发布后生产者可立即恢复并销毁协程帧，因此成功时必须是最后一次访问 awaiter。
+        if (channel->publishWaiter(waiterState, timeoutTimer)) {
+            return true;
+        }
+        // kArmingPending 撤销了 arming：通常是新数据已发布，下一轮直接取走；
+        // 罕见的 phase ABA 下没有数据，则带着归还的 timer 重新 arming，
+        // 不能无数据恢复并被 await_resume() 报告为超时。
         m_waiterState = nullptr;
-        return false;
     }
-    // 发布后生产者可立即恢复并销毁协程帧，因此必须是最后一次访问 awaiter。
-    return channel->publishWaiter(waiterState, std::move(timeoutTimer));
 }
 
 template <UnboundedValue T>
@@ -2136,24 +2186,31 @@ inline bool UnboundedRecvBatchToAwaitable<T>::await_suspend(
 {
     auto* channel = m_channel;
     TimeoutTimer::ptr timeoutTimer = std::move(m_timeoutTimer);
-    if (tryReceiveNow() || channel->isClosedAndDrained()) {
-        return false;
-    }
-
     TaskState* waiterState = handle.promise().taskRefView().state();
-    m_waiterState = waiterState;
-    if (!channel->beginWaiterRegistration()) {
-        m_waiterState = nullptr;
-        return false;
-    }
-    if (channel->hasPublishedValueForWaiter() ||
-        channel->isClosedAndDrained()) {
-        channel->cancelWaiterRegistration();
+    for (;;) {
+        if (tryReceiveNow() || channel->isClosedAndDrained()) {
+            return false;
+        }
+        m_waiterState = waiterState;
+        if (!channel->beginWaiterRegistration()) {
+            m_waiterState = nullptr;
+            return false;
+        }
+        if (channel->hasPublishedValueForWaiter() ||
+            channel->isClosedAndDrained()) {
+            channel->cancelWaiterRegistration();
+            m_waiterState = nullptr;
+            return false;
+        }
+        // 发布后 producer 可立即恢复并销毁协程帧，因此成功时必须是最后一次访问 awaiter。
+        if (channel->publishWaiter(waiterState, timeoutTimer)) {
+            return true;
+        }
+        // kArmingPending 撤销了 arming：通常是新数据已发布，下一轮直接取走；
+        // 罕见的 phase ABA 下没有数据，则带着归还的 timer 重新 arming，
+        // 不能无数据恢复并被 await_resume() 报告为超时。
         m_waiterState = nullptr;
-        return false;
     }
-    // 发布后 producer 可立即恢复并销毁协程帧，因此必须是最后一次访问 awaiter。
-    return channel->publishWaiter(waiterState, std::move(timeoutTimer));
 }
 
 template <UnboundedValue T>
@@ -49,6 +49,10 @@ int registerIOSchedulerEvent(Scheduler* scheduler,
         return io_scheduler->addWritev(controller);
     case SENDFILE:
         return io_scheduler->addSendFile(controller);
+    case SPLICEIN:
+        return io_scheduler->addSpliceIn(controller);
+    case SPLICEOUT:
+        return io_scheduler->addSpliceOut(controller);
     case FILEREAD:
         return io_scheduler->addFileRead(controller);
     case FILEWRITE:
@@ -87,6 +91,14 @@ int removeTimedOutIORegistration(Scheduler* scheduler, IOController* controller)
     return static_cast<IOScheduler*>(scheduler)->remove(controller);
 }
 
+bool prefersLinkedTimeout(Scheduler* scheduler) noexcept
+{
+    if (scheduler == nullptr || scheduler->type() != kIOScheduler) {
+        return false;
+    }
+    return static_cast<IOScheduler*>(scheduler)->linkedTimeoutsEnabled();
+}
+
 } // namespace detail
 
 /**
@@ -166,6 +178,20 @@ std::expected<size_t, IOError> FileWriteAwaitable::await_resume() {
     return detail::resumeIOAwaitable<FILEWRITE>(*this);
 }
 
+/**
+ * @brief 向当前 IO 调度器租借注册缓冲切片
+ * @details 非 IO 调度器、后端未实现或池已耗尽时，回退为同容量的堆切片，调用方无需区分两种形态。
+ * @param scheduler 协程所属调度器
+ */
+void RegisteredBufferLeaseAwaitable::lease(Scheduler* scheduler) {
+    if (scheduler != nullptr && scheduler->type() == kIOScheduler) {
+        m_buffer = static_cast<IOScheduler*>(scheduler)->leaseRegisteredBuffer(m_length);
+    }
+    if (!m_buffer.valid()) {
+        m_buffer = RegisteredBuffer::heap(m_length);
+    }
+}
+
 /**
  * @brief 恢复 recvfrom awaitable 并返回已接收字节数
  * @return 成功时返回已接收字节数，失败时返回 IOError
@@ -182,6 +208,29 @@ std::expected<size_t, IOError> SendToAwaitable::await_resume() {
     return detail::resumeIOAwaitable<SENDTO>(*this);
 }
 
+/**
+ * @brief 恢复批量接收 awaitable 并返回填充的槽位数
+ * @details io_uring 上唤醒发生在 CQE 批处理中途，恢复时再把同一轮排队的数据报补入剩余槽位。
+ * @return 成功时返回填充的槽位数，失败时返回 IOError
+ */
+std::expected<size_t, IOError> RecvBatchAwaitable::await_resume() {
+    auto result = detail::resumeIOAwaitable<RECVFROM>(static_cast<RecvFromAwaitable&>(*this));
+#ifdef USE_IOURING
+    if (result && result.value() > 0 && result.value() < m_datagrams.size()) {
+        result = drainReadyDatagrams(m_controller, result.value());
+    }
+#endif
+    return result;
+}
+
+/**
+ * @brief 恢复批量发送 awaitable 并返回已发送的条目数
+ * @return 成功时返回已发送的条目数，失败时返回 IOError
+ */
+std::expected<size_t, IOError> SendBatchAwaitable::await_resume() {
+    return detail::resumeIOAwaitable<SENDTO>(static_cast<SendToAwaitable&>(*this));
+}
+
 /**
  * @brief 恢复文件监控 awaitable 并返回监控结果
  * @return 包含触发事件详情的 FileWatchResult，失败时返回 IOError
@@ -198,4 +247,20 @@ std::expected<size_t, IOError> SendFileAwaitable::await_resume() {
     return detail::resumeIOAwaitable<SENDFILE>(*this);
 }
 
+/**
+ * @brief 恢复 socket → 管道 splice awaitable
+ * @return 成功时返回搬进管道的字节数（0 表示对端 EOF），失败时返回 IOError
+ */
+std::expected<size_t, IOError> SpliceInAwaitable::await_resume() {
+    return detail::resumeIOAwaitable<SPLICEIN>(*this);
+}
+
+/**
+ * @brief 恢复管道 → socket splice awaitable
+ * @return 成功时返回写入 socket 的字节数，失败时返回 IOError
+ */
+std::expected<size_t, IOError> SpliceOutAwaitable::await_resume() {
+    return detail::resumeIOAwaitable<SPLICEOUT>(*this);
+}
+
 }
@@ -29,6 +29,9 @@
 #include "timeout.hpp"
 #include "watch_defs.hpp"
 #include "waker.h"
+#include "registered_buffer.h"
+#include "udp_batch.hpp"
+#include <algorithm>
 #include <cerrno>
 #include <concepts>
 #include <coroutine>
@@ -51,6 +54,10 @@
 #include <libaio.h>
 #endif
 
+#ifdef USE_IOURING
+#include <linux/time_types.h>
+#endif
+
 #include "io_handlers.hpp"
 
 #include "io_controller.hpp"
@@ -105,6 +112,67 @@ struct IOContextBase: public AwaitableBase {
     // SequenceAwaitable 调度时可由上下文动态指定下一次等待方向；
     // 返回 INVALID 表示沿用静态 task.type。
     virtual IOEventType type() const { return IOEventType::INVALID; }  ///< 返回动态事件方向；INVALID 表示沿用静态事件类型
+
+#ifdef USE_IOURING
+    /**
+     * @brief 未能挂上 LINK_TIMEOUT 时把截止时间交还时间轮的回调
+     * @param owner 注册回调时传入的 WithTimeout 对象
+     */
+    using LinkTimeoutFallback = void (*)(void* owner) noexcept;
+
+    /**
+     * @brief 请求 reactor 为本次一次性 SQE 链接 LINK_TIMEOUT（由 WithTimeout 调用）
+     * @param deadline_ns steady_clock 纪元下的绝对截止时间，即 CLOCK_MONOTONIC
+     * @param armed_report 可选；每次提交时同步写入是否挂上 LINK_TIMEOUT，须与本上下文同寿命
+     * @param fallback 可选；某次提交取不到 LINK_TIMEOUT SQE 时调用，让截止时间改由时间轮负责
+     * @param fallback_owner 传给 fallback 的对象，须与本上下文同寿命
+     * @note 重新提交（部分完成、EAGAIN）沿用同一绝对截止时间；multishot 路径不会挂载，
+     *       此时 m_link_timeout_armed 保持 false，WithTimeout 退回时间轮。
+     */
+    void requestLinkTimeout(uint64_t deadline_ns,
+                            bool* armed_report = nullptr,
+                            LinkTimeoutFallback fallback = nullptr,
+                            void* fallback_owner = nullptr) noexcept {
+        m_link_deadline.tv_sec = static_cast<long long>(deadline_ns / 1000000000ULL);
+        m_link_deadline.tv_nsec = static_cast<long long>(deadline_ns % 1000000000ULL);
+        m_link_timeout = true;
+        m_link_timeout_armed = false;
+        m_link_timeout_fired = false;
+        m_link_armed_report = armed_report;
+        m_link_fallback = fallback;
+        m_link_fallback_owner = fallback_owner;
+        if (armed_report != nullptr) {
+            *armed_report = false;
+        }
+    }
+
+    void setLinkTimeoutArmed(bool armed) noexcept {  ///< reactor 记录本次提交是否挂上 LINK_TIMEOUT
+        m_link_timeout_armed = armed;
+        if (m_link_armed_report != nullptr) {
+            *m_link_armed_report = armed;
+        }
+    }
+
+    /**
+     * @brief reactor 取不到 LINK_TIMEOUT SQE 时调用：本次及之后的提交不再链接，截止时间交给时间轮
+     * @details 首次提交与重新提交走同一入口，WithTimeout 负责保证时间轮只注册一次。
+     */
+    void fallBackFromLinkTimeout() noexcept {
+        m_link_timeout = false;
+        setLinkTimeoutArmed(false);
+        if (m_link_fallback != nullptr) {
+            m_link_fallback(m_link_fallback_owner);
+        }
+    }
+
+    struct __kernel_timespec m_link_deadline{};  ///< LINK_TIMEOUT 绝对截止时间，提交前必须保持有效
+    bool m_link_timeout = false;  ///< 是否请求内核侧截止时间
+    bool m_link_timeout_armed = false;  ///< 最近一次提交是否已挂上 LINK_TIMEOUT
+    bool m_link_timeout_fired = false;  ///< 操作是否因 LINK_TIMEOUT 到期被内核取消
+    bool* m_link_armed_report = nullptr;  ///< 提交时的挂载结果副本，供 WithTimeout 在发布 waiter 后读取
+    LinkTimeoutFallback m_link_fallback = nullptr;  ///< 退回时间轮的回调
+    void* m_link_fallback_owner = nullptr;  ///< m_link_fallback 的参数
+#endif
 };
 
 struct AcceptIOContext;
@@ -119,6 +187,7 @@ struct RecvFromIOContext;
 struct SendToIOContext;
 struct FileWatchIOContext;
 struct SendFileIOContext;
+struct SpliceIOContext;
 struct SequenceAwaitableBase;
 
 namespace detail {
@@ -259,10 +328,10 @@ constexpr bool sequenceEventUsesSlot(IOEventType type,
                                      IOController::Index slot) noexcept {
     const uint32_t t = static_cast<uint32_t>(type);
     if (slot == IOController::READ) {
-        return (t & (ACCEPT | RECV | READV | RECVFROM | FILEREAD | FILEWATCH)) != 0;
+        return (t & (ACCEPT | RECV | READV | RECVFROM | FILEREAD | FILEWATCH | SPLICEIN)) != 0;
     }
     if (slot == IOController::WRITE) {
-        return (t & (CONNECT | SEND | WRITEV | SENDTO | FILEWRITE | SENDFILE)) != 0;
+        return (t & (CONNECT | SEND | WRITEV | SENDTO | FILEWRITE | SENDFILE | SPLICEOUT)) != 0;
     }
     return false;
 }
@@ -744,6 +813,7 @@ struct RecvFromIOContext: public IOContextBase {
 
 #ifdef USE_IOURING
     bool handleComplete(struct io_uring_cqe* cqe, GHandle handle) override;  ///< 处理 io_uring recvfrom 完成事件
+    virtual bool consumeReadyDatagrams(IOController* controller);  ///< 从 multishot 就绪队列交付结果；false 表示队列为空
 #else
     bool handleComplete(GHandle handle) override;  ///< 处理传统后端 recvfrom 就绪事件
 #endif
@@ -790,6 +860,7 @@ struct SendToIOContext: public IOContextBase {
 
 #ifdef USE_IOURING
     bool handleComplete(struct io_uring_cqe* cqe, GHandle handle) override;  ///< 处理 io_uring sendto 完成事件
+    virtual bool sendsOnWritable() const noexcept { return false; }  ///< true 时 reactor 提交 POLLOUT，由 handleComplete 自行发送
 #else
     bool handleComplete(GHandle handle) override;  ///< 处理传统后端 sendto 就绪事件
 #endif
@@ -824,6 +895,88 @@ struct SendToAwaitable: public SendToIOContext, public TimeoutSupport<SendToAwai
     Waker m_waker;  ///< 恢复等待协程的唤醒器
 };
 
+// ---- RecvBatch / SendBatch ----
+
+/**
+ * @brief UDP 批量接收的可等待对象
+ * @details 复用 RECVFROM 槽位与各后端的 recvfrom 注册路径，一次完成填充多个槽位：
+ * epoll 就绪后执行 recvmmsg，kqueue 退化为 recvmsg 循环；io_uring 从 multishot
+ * recvmsg + provided buffer ring 的就绪队列一次取走多个数据报，恢复时再补齐
+ * 同一轮 CQE 中排队的数据报。`co_await` 返回填充的槽位数。
+ */
+struct RecvBatchAwaitable: public RecvFromAwaitable {
+    RecvBatchAwaitable(IOController* controller, std::span<UdpRecvDatagram> datagrams)
+        : RecvFromAwaitable(controller,
+                            datagrams.empty() ? nullptr : datagrams.front().buffer,
+                            datagrams.empty() ? 0 : datagrams.front().capacity,
+                            datagrams.empty() ? nullptr : &datagrams.front().from),
+          m_datagrams(datagrams) {}
+
+    bool await_ready() { return m_datagrams.empty(); }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) {
+        return detail::suspendRegisteredAwaitable<RecvFromAwaitable, RECVFROM, kRecvFailed>(
+            *this, handle);
+    }
+    std::expected<size_t, IOError> await_resume();  ///< 返回填充的槽位数或错误
+
+    auto timeout(std::chrono::milliseconds t) && {
+        return WithTimeout<RecvBatchAwaitable>{std::move(*this), t};
+    }
+    auto timeout(std::chrono::milliseconds t) & {
+        return WithTimeout<RecvBatchAwaitable>{*this, t};
+    }
+
+#ifdef USE_IOURING
+    bool handleComplete(struct io_uring_cqe* cqe, GHandle handle) override;  ///< one-shot 回退：首槽来自 CQE，其余槽位非阻塞补齐
+    bool consumeReadyDatagrams(IOController* controller) override;  ///< 从就绪队列批量交付
+    size_t drainReadyDatagrams(IOController* controller, size_t filled);  ///< 把队首连续数据报填入 filled 之后的槽位
+#else
+    bool handleComplete(GHandle handle) override;  ///< recvmmsg 批量读取
+#endif
+
+    std::span<UdpRecvDatagram> m_datagrams;  ///< 借用的接收槽位
+};
+
+/**
+ * @brief UDP 批量发送的可等待对象
+ * @details 复用 SENDTO 槽位：epoll/kqueue 上写就绪后执行 sendmmsg（kqueue 为 sendmsg 循环）；
+ * io_uring 没有 sendmmsg 操作码，先内联尝试 sendmmsg，发送队列满时提交 POLLOUT 再重试。
+ * 条目可带 segment_size 以 GSO 发送。`co_await` 返回已发送的条目数，可能少于 span 大小。
+ */
+struct SendBatchAwaitable: public SendToAwaitable {
+    SendBatchAwaitable(IOController* controller, std::span<const UdpSendDatagram> datagrams)
+        : SendToAwaitable(controller,
+                          datagrams.empty() ? nullptr : datagrams.front().buffer,
+                          datagrams.empty() ? 0 : datagrams.front().length,
+                          datagrams.empty() ? Host{} : datagrams.front().to),
+          m_datagrams(datagrams) {}
+
+    bool await_ready() { return m_datagrams.empty(); }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) {
+        return detail::suspendRegisteredAwaitable<SendToAwaitable, SENDTO, kSendFailed>(
+            *this, handle);
+    }
+    std::expected<size_t, IOError> await_resume();  ///< 返回已发送的条目数或错误
+
+    auto timeout(std::chrono::milliseconds t) && {
+        return WithTimeout<SendBatchAwaitable>{std::move(*this), t};
+    }
+    auto timeout(std::chrono::milliseconds t) & {
+        return WithTimeout<SendBatchAwaitable>{*this, t};
+    }
+
+#ifdef USE_IOURING
+    bool handleComplete(struct io_uring_cqe* cqe, GHandle handle) override;  ///< POLLOUT 完成后执行 sendmmsg
+    bool sendsOnWritable() const noexcept override { return true; }
+#else
+    bool handleComplete(GHandle handle) override;  ///< sendmmsg 批量发送
+#endif
+
+    std::span<const UdpSendDatagram> m_datagrams;  ///< 借用的发送条目
+};
+
 // ---- FileRead ----
 
 /**
@@ -850,6 +1003,10 @@ struct FileReadIOContext: public IOContextBase {
     size_t m_length;  ///< 请求读取的字节数
     off_t m_offset;  ///< 文件偏移
     std::expected<size_t, IOError> m_result;  ///< 实际读取字节数或错误
+#ifdef USE_IOURING
+    int32_t m_buf_index = -1;  ///< 注册缓冲区索引；>=0 且属于当前 ring 时以 READ_FIXED 提交
+    const void* m_buf_owner = nullptr;  ///< 注册缓冲区所属池
+#endif
 
 #ifdef USE_EPOLL
     int m_event_fd;  ///< epoll + libaio 模式下的 eventfd
@@ -874,6 +1031,15 @@ struct FileReadAwaitable: public FileReadIOContext, public TimeoutSupport<FileRe
                       char* buffer, size_t length, off_t offset)
         : FileReadIOContext(buffer, length, offset),
           m_controller(controller) {}
+    /// 读入 buffer（长度按容量截断）；注册池切片在 io_uring 上以 READ_FIXED 提交
+    FileReadAwaitable(IOController* controller, RegisteredBuffer& buffer, size_t length, off_t offset)
+        : FileReadIOContext(buffer.data(), std::min(length, buffer.capacity()), offset),
+          m_controller(controller) {
+#ifdef USE_IOURING
+        m_buf_index = buffer.index();
+        m_buf_owner = buffer.owner();
+#endif
+    }
 #endif
 
     bool await_ready() { return false; }
@@ -914,6 +1080,10 @@ struct FileWriteIOContext: public IOContextBase {
     size_t m_length;  ///< 请求写入的字节数
     off_t m_offset;  ///< 文件偏移
     std::expected<size_t, IOError> m_result;  ///< 实际写入字节数或错误
+#ifdef USE_IOURING
+    int32_t m_buf_index = -1;  ///< 注册缓冲区索引；>=0 且属于当前 ring 时以 WRITE_FIXED 提交
+    const void* m_buf_owner = nullptr;  ///< 注册缓冲区所属池
+#endif
 
 #ifdef USE_EPOLL
     int m_event_fd;  ///< epoll + libaio 模式下的 eventfd
@@ -938,6 +1108,15 @@ struct FileWriteAwaitable: public FileWriteIOContext, public TimeoutSupport<File
                        const char* buffer, size_t length, off_t offset)
         : FileWriteIOContext(buffer, length, offset),
           m_controller(controller) {}
+    /// 写出 buffer 的有效数据；注册池切片在 io_uring 上以 WRITE_FIXED 提交
+    FileWriteAwaitable(IOController* controller, const RegisteredBuffer& buffer, off_t offset)
+        : FileWriteIOContext(buffer.data(), buffer.size(), offset),
+          m_controller(controller) {
+#ifdef USE_IOURING
+        m_buf_index = buffer.index();
+        m_buf_owner = buffer.owner();
+#endif
+    }
 #endif
 
     bool await_ready() { return false; }
@@ -952,6 +1131,32 @@ struct FileWriteAwaitable: public FileWriteIOContext, public TimeoutSupport<File
     Waker m_waker;  ///< 恢复等待协程的唤醒器
 };
 
+// ---- RegisteredBufferLease ----
+
+/**
+ * @brief 从当前 IO 调度器租借文件 IO 切片的可等待对象
+ * @details 不会真正挂起：await_suspend 借协程句柄找到所属调度器并同步租借，
+ *          注册池不可用或已耗尽时回退为同容量的堆切片。
+ */
+struct RegisteredBufferLeaseAwaitable {
+    explicit RegisteredBufferLeaseAwaitable(size_t length)
+        : m_length(length) {}
+
+    bool await_ready() const noexcept { return false; }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) {
+        Waker waker(handle);
+        lease(waker.getScheduler());
+        return false;
+    }
+    RegisteredBuffer await_resume() noexcept { return std::move(m_buffer); }  ///< 返回租借到的切片
+
+    void lease(Scheduler* scheduler);  ///< 向调度器租借切片，失败时分配堆切片
+
+    size_t m_length;  ///< 请求的最小容量
+    RegisteredBuffer m_buffer;  ///< 租借结果
+};
+
 // ---- FileWatch ----
 
 /**
@@ -1068,6 +1273,68 @@ struct SendFileAwaitable: public SendFileIOContext, public TimeoutSupport<SendFi
     Waker m_waker;  ///< 恢复等待协程的唤醒器
 };
 
+// ---- Splice ----
+
+/**
+ * @brief socket 与管道之间 splice 操作的上下文
+ * @details 数据只在 socket 缓冲区与管道页之间移动，不经过用户态缓冲区。
+ *          io_uring 后端提交 POLL_ADD → IORING_OP_SPLICE 的链接 SQE，
+ *          epoll 后端在就绪后执行非阻塞 splice；kqueue 没有 splice，直接返回 ENOSYS。
+ */
+struct SpliceIOContext: public IOContextBase {
+    SpliceIOContext(int pipe_fd, size_t length, bool to_pipe)
+        : m_length(length), m_pipe_fd(pipe_fd), m_to_pipe(to_pipe) {}
+
+#ifdef USE_IOURING
+    bool handleComplete(struct io_uring_cqe* cqe, GHandle handle) override;  ///< 处理 io_uring splice 完成事件
+#else
+    bool handleComplete(GHandle handle) override;  ///< 处理传统后端 splice 就绪事件
+#endif
+
+    size_t m_length;  ///< 本次最多搬运的字节数
+    std::expected<size_t, IOError> m_result;  ///< 实际搬运字节数（0 表示来源 EOF）或错误
+    int m_pipe_fd;  ///< 管道 fd：SPLICEIN 为写端，SPLICEOUT 为读端
+    bool m_to_pipe;  ///< true 表示 socket → 管道，false 表示管道 → socket
+};
+
+/**
+ * @brief socket → 管道 splice 的可等待对象（占用读槽）
+ */
+struct SpliceInAwaitable: public SpliceIOContext, public TimeoutSupport<SpliceInAwaitable> {
+    SpliceInAwaitable(IOController* controller, int pipe_write_fd, size_t length)
+        : SpliceIOContext(pipe_write_fd, length, true), m_controller(controller) {}
+
+    bool await_ready() { return false; }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) {
+        return detail::suspendRegisteredAwaitable<SpliceInAwaitable, SPLICEIN, kRecvFailed>(
+            *this, handle);
+    }
+    std::expected<size_t, IOError> await_resume();  ///< 返回搬进管道的字节数或错误
+
+    IOController* m_controller;  ///< 关联的 IO 控制器
+    Waker m_waker;  ///< 恢复等待协程的唤醒器
+};
+
+/**
+ * @brief 管道 → socket splice 的可等待对象（占用写槽）
+ */
+struct SpliceOutAwaitable: public SpliceIOContext, public TimeoutSupport<SpliceOutAwaitable> {
+    SpliceOutAwaitable(IOController* controller, int pipe_read_fd, size_t length)
+        : SpliceIOContext(pipe_read_fd, length, false), m_controller(controller) {}
+
+    bool await_ready() { return false; }
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) {
+        return detail::suspendRegisteredAwaitable<SpliceOutAwaitable, SPLICEOUT, kSendFailed>(
+            *this, handle);
+    }
+    std::expected<size_t, IOError> await_resume();  ///< 返回写入 socket 的字节数或错误
+
+    IOController* m_controller;  ///< 关联的 IO 控制器
+    Waker m_waker;  ///< 恢复等待协程的唤醒器
+};
+
 /**
  * @brief Sequence awaitable 的推进结果
  */
@@ -77,6 +77,55 @@ inline bool SendToIOContext::handleComplete(struct io_uring_cqe* cqe,
     return true;
 }
 
+inline bool RecvFromIOContext::consumeReadyDatagrams(IOController* controller) {
+    return controller->tryConsumeReadyRecvFrom(m_buffer, m_length, m_from, m_result);
+}
+
+inline bool RecvBatchAwaitable::handleComplete(struct io_uring_cqe* cqe, GHandle handle) {
+    if (!RecvFromIOContext::handleComplete(cqe, handle)) return false;
+    if (!m_result) return true;
+    auto& first = m_datagrams.front();
+    first.length = m_result.value();
+    first.segment_size = 0;
+    first.truncated = (m_msg.msg_flags & MSG_TRUNC) != 0;
+    size_t filled = 1;
+    if (m_datagrams.size() > 1) {
+        auto more = io::recvDatagramBatch(handle.fd, m_datagrams.subspan(1));
+        if (more) filled += more.value();
+    }
+    m_result = filled;
+    return true;
+}
+
+inline bool RecvBatchAwaitable::consumeReadyDatagrams(IOController* controller) {
+    if (!controller->hasReadyRecvFromData()) {
+        // 队列为空返回 false；队首为错误时按单数据报语义交付该错误
+        return controller->tryConsumeReadyRecvFrom(nullptr, 0, nullptr, m_result);
+    }
+    m_result = drainReadyDatagrams(controller, 0);
+    return true;
+}
+
+inline size_t RecvBatchAwaitable::drainReadyDatagrams(IOController* controller, size_t filled) {
+    while (filled < m_datagrams.size() &&
+           controller->tryConsumeReadyRecvDatagram(m_datagrams[filled])) {
+        ++filled;
+    }
+    return filled;
+}
+
+inline bool SendBatchAwaitable::handleComplete(struct io_uring_cqe* cqe, GHandle handle) {
+    if (cqe->res < 0) {
+        if (io::detail::datagramWouldBlock(-cqe->res)) return false;
+        m_result = std::unexpected(IOError(kSendFailed, static_cast<uint32_t>(-cqe->res)));
+        return true;
+    }
+    auto result = io::sendDatagramBatch(handle.fd, m_datagrams);
+    if(!result && IOError::contains(result.error().code(), kNotReady)) return false;
+    m_result = std::move(result);
+    return true;
+}
+
 inline bool FileReadIOContext::handleComplete(struct io_uring_cqe* cqe,
                                               [[maybe_unused]] GHandle handle) {
     auto result = io::handleFileRead(cqe, m_buffer);
@@ -126,6 +175,15 @@ inline bool SendFileIOContext::handleComplete(struct io_uring_cqe* cqe, GHandle
     return stored.has_value();
 }
 
+inline bool SpliceIOContext::handleComplete(struct io_uring_cqe* cqe,
+                                            [[maybe_unused]] GHandle handle) {
+    // EAGAIN 说明链接的 poll 之后数据又被取走，返回 false 由 reactor 重新提交整条链
+    auto result = io::handleSplice(cqe, m_to_pipe ? kRecvFailed : kSendFailed);
+    if(!result && IOError::contains(result.error().code(), kNotReady)) return false;
+    m_result = std::move(result);
+    return true;
+}
+
 #else // kqueue / epoll
 
 inline bool AcceptIOContext::handleComplete(GHandle handle) {
@@ -190,6 +248,20 @@ inline bool SendToIOContext::handleComplete(GHandle handle) {
     return true;
 }
 
+inline bool RecvBatchAwaitable::handleComplete(GHandle handle) {
+    auto result = io::recvDatagramBatch(handle.fd, m_datagrams);
+    if(!result && IOError::contains(result.error().code(), kNotReady)) return false;
+    m_result = std::move(result);
+    return true;
+}
+
+inline bool SendBatchAwaitable::handleComplete(GHandle handle) {
+    auto result = io::sendDatagramBatch(handle.fd, m_datagrams);
+    if(!result && IOError::contains(result.error().code(), kNotReady)) return false;
+    m_result = std::move(result);
+    return true;
+}
+
 inline bool FileReadIOContext::handleComplete(GHandle handle) {
     auto result = io::handleFileRead(handle, m_buffer, m_length, m_offset);
     if(!result && IOError::contains(result.error().code(), kNotReady)) return false;
@@ -233,6 +305,15 @@ inline bool SendFileIOContext::handleComplete(GHandle handle) {
     return stored.has_value();
 }
 
+inline bool SpliceIOContext::handleComplete(GHandle handle) {
+    const int fd_in = m_to_pipe ? handle.fd : m_pipe_fd;
+    const int fd_out = m_to_pipe ? m_pipe_fd : handle.fd;
+    auto result = io::handleSplice(fd_in, fd_out, m_length, m_to_pipe ? kRecvFailed : kSendFailed);
+    if(!result && IOError::contains(result.error().code(), kNotReady)) return false;
+    m_result = std::move(result);
+    return true;
+}
+
 #endif // USE_IOURING
 
 }
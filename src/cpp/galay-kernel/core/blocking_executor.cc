@@ -6,9 +6,16 @@
  *
  * @details 实现动态伸缩的 BlockingExecutor 线程池。
  * 工作线程按需创建，遵循可配置的保活超时，空闲时自动收缩到最小线程数。
+ *
+ * 提交与唤醒之间的可见性靠两组 seq_cst 配对保证：
+ * - 提交方先递增 m_pending 再读 m_idleWorkers；停泊方先递增 m_idleWorkers 再读 m_pending。
+ * - 退出方先递减 m_workerCount 再读 m_pending；提交方先递增 m_pending 再预留线程名额。
+ * 任一方必然看到对方，因此已入队的任务不会在没有工作线程的情况下滞留。
  */
 
 #include "blocking_executor.h"
+#include <algorithm>
+#include <bit>
 #include <thread>
 #include <utility>
 
@@ -21,6 +28,15 @@ namespace
 /// 多余线程退出前的默认空闲超时时间
 constexpr auto kDefaultBlockingKeepAlive = std::chrono::milliseconds(5000);
 
+/// 为提交线程分配固定分片，使同一线程的连续提交落在同一个环上
+std::atomic<size_t> g_nextSubmitShard{0};
+
+size_t submitShardHint() noexcept
+{
+    thread_local const size_t hint = g_nextSubmitShard.fetch_add(1, std::memory_order_relaxed);
+    return hint;
+}
+
 } // namespace
 
 /**
@@ -43,7 +59,10 @@ BlockingExecutor::BlockingExecutor(size_t minWorkers,
                                    std::chrono::milliseconds keepAlive)
     : m_minWorkers(minWorkers),
       m_maxWorkers(maxWorkers > 0 ? maxWorkers : 1),
-      m_keepAlive(keepAlive)
+      m_keepAlive(keepAlive),
+      m_shardMask(std::bit_ceil(std::min(m_maxWorkers, kMaxShards)) - 1),
+      m_shards(std::make_unique<Shard[]>(m_shardMask + 1)),
+      m_slots(std::make_unique<WorkerSlot[]>(m_maxWorkers))
 {
     if (m_minWorkers > m_maxWorkers) {
         m_minWorkers = m_maxWorkers;
@@ -55,10 +74,70 @@ BlockingExecutor::BlockingExecutor(size_t minWorkers,
  */
 BlockingExecutor::~BlockingExecutor()
 {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    m_stopping = true;
-    m_taskCv.notify_all();
-    m_shutdownCv.wait(lock, [this]() { return m_workerCount == 0; });
+    m_stopping.store(true, std::memory_order_seq_cst);
+    for (size_t i = 0; i < m_maxWorkers; ++i) {
+        WorkerSlot& slot = m_slots[i];
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            if (slot.state.load(std::memory_order_relaxed) == WorkerState::kParked) {
+                slot.state.store(WorkerState::kNotified, std::memory_order_relaxed);
+            }
+        }
+        slot.cv.notify_one();
+    }
+
+    std::unique_lock<std::mutex> lock(m_shutdownMutex);
+    m_shutdownCv.wait(lock, [this]() { return m_workerCount.load(std::memory_order_acquire) == 0; });
+}
+
+BlockingExecutor::Shard::Shard()
+    : cells(std::make_unique<Cell[]>(kShardCapacity))
+{
+    for (size_t i = 0; i < kShardCapacity; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool BlockingExecutor::Shard::push(BlockingTask& task) noexcept
+{
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & (kShardCapacity - 1)];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.task = std::move(task);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool BlockingExecutor::Shard::pop(BlockingTask& task) noexcept
+{
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & (kShardCapacity - 1)];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                task = std::move(cell.task);
+                cell.sequence.store(pos + kShardCapacity, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
 }
 
 /**
@@ -75,121 +154,251 @@ size_t BlockingExecutor::defaultMaxWorkers()
 /**
  * @brief 提交一个阻塞任务
  *
- * @details 若存在空闲工作线程，任务入队并唤醒一个线程；
- * 若线程池未达到上限，则创建新的分离线程并以该任务作为初始工作；
- * 否则任务入队等待工作线程可用时处理。
+ * @details 没有停泊线程且线程池未达上限时，直接拉起新线程并以该任务作为初始工作；
+ * 否则任务写入分片环，并唤醒一个停泊线程。唤醒落空（停泊线程恰好超时退出）时
+ * 再尝试补一个线程，保证积压任务总有线程处理。
  *
- * @param task  待执行的非空调用对象
+ * @param task  待执行的任务；空任务直接成功返回
  *
  * @return 成功时返回空 expected；执行器停止时返回 BlockingExecutorError
  */
-std::expected<void, BlockingExecutorError> BlockingExecutor::submit(std::function<void()> task)
+std::expected<void, BlockingExecutorError> BlockingExecutor::submit(BlockingTask task)
 {
     if (!task) {
         return {};
     }
+    if (m_stopping.load(std::memory_order_acquire)) {
+        return std::unexpected(BlockingExecutorError(BlockingExecutorErrorCode::kStopping));
+    }
 
-    bool shouldNotify = false;
-    bool shouldSpawn = false;
+    if (m_idleWorkers.load(std::memory_order_seq_cst) == 0 && tryReserveWorker()) {
+        spawnWorker(std::move(task));
+        return {};
+    }
+
+    enqueue(std::move(task));
+    if (!wakeParkedWorker() && tryReserveWorker()) {
+        spawnWorker(BlockingTask{});
+    }
+    return {};
+}
 
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_stopping) {
-            return std::unexpected(BlockingExecutorError(BlockingExecutorErrorCode::kStopping));
+/**
+ * @brief 根据线程计数预留一个工作线程名额
+ */
+bool BlockingExecutor::tryReserveWorker() noexcept
+{
+    size_t count = m_workerCount.load(std::memory_order_seq_cst);
+    while (count < m_maxWorkers) {
+        if (m_workerCount.compare_exchange_weak(count, count + 1, std::memory_order_seq_cst)) {
+            return true;
         }
+    }
+    return false;
+}
 
-        if (m_idleWorkers > 0) {
-            m_tasks.push_back(std::move(task));
-            shouldNotify = true;
-        } else if (m_workerCount < m_maxWorkers) {
-            ++m_workerCount;
-            shouldSpawn = true;
-        } else {
-            m_tasks.push_back(std::move(task));
+/**
+ * @brief 占用一个空闲槽位并拉起分离工作线程
+ *
+ * @note 退出线程递减计数后随即释放槽位，预留成功后至多短暂自旋即可拿到空闲槽位。
+ */
+void BlockingExecutor::spawnWorker(BlockingTask initialTask)
+{
+    size_t slot = 0;
+    for (;; slot = (slot + 1) % m_maxWorkers) {
+        auto expected = WorkerState::kFree;
+        if (m_slots[slot].state.compare_exchange_strong(expected, WorkerState::kRunning,
+                                                        std::memory_order_acq_rel)) {
+            break;
         }
     }
 
-    if (shouldNotify) {
-        m_taskCv.notify_one();
-        return {};
+    std::thread([this, slot, initialTask = std::move(initialTask)]() mutable {
+        workerLoop(slot, std::move(initialTask));
+    }).detach();
+}
+
+/**
+ * @brief 唤醒一个停泊中的工作线程
+ *
+ * @details 只锁被唤醒线程自己的槽位；没有停泊线程时不触碰任何锁。
+ */
+bool BlockingExecutor::wakeParkedWorker() noexcept
+{
+    if (m_idleWorkers.load(std::memory_order_seq_cst) == 0) {
+        return false;
     }
+    const size_t start = submitShardHint();
+    for (size_t probe = 0; probe < m_maxWorkers; ++probe) {
+        WorkerSlot& slot = m_slots[(start + probe) % m_maxWorkers];
+        if (slot.state.load(std::memory_order_acquire) != WorkerState::kParked) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            if (slot.state.load(std::memory_order_relaxed) != WorkerState::kParked) {
+                continue;
+            }
+            slot.state.store(WorkerState::kNotified, std::memory_order_relaxed);
+        }
+        slot.cv.notify_one();
+        return true;
+    }
+    return false;
+}
 
-    if (!shouldSpawn) {
-        return {};
+/**
+ * @brief 把任务写入提交线程的分片
+ *
+ * @details 先写本线程分片，满了依次尝试其它分片，全部写满才进入带锁溢出队列。
+ * m_pending 先于写入递增，工作线程看到计数后可能短暂自旋等待写入完成。
+ */
+void BlockingExecutor::enqueue(BlockingTask task)
+{
+    m_pending.fetch_add(1, std::memory_order_seq_cst);
+    const size_t start = submitShardHint();
+    for (size_t probe = 0; probe <= m_shardMask; ++probe) {
+        if (m_shards[(start + probe) & m_shardMask].push(task)) {
+            return;
+        }
     }
+    std::lock_guard<std::mutex> lock(m_overflowMutex);
+    m_overflow.push_back(std::move(task));
+}
 
-    std::thread([this, initialTask = std::move(task)]() mutable {
-        workerLoop(std::move(initialTask));
-    }).detach();
-    return {};
+/**
+ * @brief 为工作线程取出一个任务
+ *
+ * @param slot  工作线程槽位，决定首先探测的分片
+ * @param task  输出任务
+ */
+bool BlockingExecutor::tryDequeue(size_t slot, BlockingTask& task)
+{
+    if (m_pending.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    for (size_t probe = 0; probe <= m_shardMask; ++probe) {
+        if (m_shards[(slot + probe) & m_shardMask].pop(task)) {
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_overflowMutex);
+    if (m_overflow.empty()) {
+        return false;
+    }
+    task = std::move(m_overflow.front());
+    m_overflow.pop_front();
+    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
 }
 
 /**
  * @brief 工作线程主循环
  *
- * @details 执行初始任务后进入循环等待新任务。
- * 超过最小线程数的空闲线程在保活超时后退出。
- * 关闭时排空剩余任务后退出。
+ * @details 执行初始任务后循环取任务；取不到时在自己的槽位上停泊。
+ * 超过最小线程数的线程在保活超时后退出；关闭时排空剩余任务后退出。
  *
- * @param initialTask  首个执行的任务（来自创建该线程的 submit() 调用）
+ * @param slot         工作线程占用的停泊槽
+ * @param initialTask  首个执行的任务（来自创建该线程的 submit() 调用），可以为空
  */
-void BlockingExecutor::workerLoop(std::function<void()> initialTask)
+void BlockingExecutor::workerLoop(size_t slot, BlockingTask initialTask)
 {
-    std::function<void()> task = std::move(initialTask);
+    BlockingTask task = std::move(initialTask);
+    WorkerSlot& self = m_slots[slot];
 
     for (;;) {
         if (task) {
             task();
-            task = {};
+            task.reset();
         }
-
-        std::unique_lock<std::mutex> lock(m_mutex);
-        while (m_tasks.empty() && !m_stopping) {
-            ++m_idleWorkers;
-            const bool canTimeOut = m_workerCount > m_minWorkers;
-
-            bool ready = true;
-            if (canTimeOut) {
-                ready = m_taskCv.wait_for(lock, m_keepAlive, [this]() {
-                    return m_stopping || !m_tasks.empty();
-                });
-            } else {
-                m_taskCv.wait(lock, [this]() {
-                    return m_stopping || !m_tasks.empty();
-                });
-            }
-
-            --m_idleWorkers;
-
-            if (!ready && m_tasks.empty() && m_workerCount > m_minWorkers) {
-                retireWorkerLocked();
-                return;
+        if (tryDequeue(slot, task)) {
+            continue;
+        }
+        if (m_stopping.load(std::memory_order_acquire)) {
+            if (m_pending.load(std::memory_order_acquire) > 0) {
+                std::this_thread::yield();
+                continue;
             }
+            retireWorker(slot);
+            return;
         }
-
-        if (m_stopping && m_tasks.empty()) {
-            retireWorkerLocked();
+        if (!park(self) && tryRetire(slot)) {
             return;
         }
+    }
+}
 
-        if (m_tasks.empty()) {
-            continue;
+/**
+ * @brief 在线程自己的槽位上停泊
+ *
+ * @details 先发布 kParked 与空闲计数，再复查积压与停止标志，避免与 submit() 的唤醒错过。
+ *
+ * @return 被唤醒或无需停泊时返回 true；保活超时返回 false
+ */
+bool BlockingExecutor::park(WorkerSlot& self)
+{
+    std::unique_lock<std::mutex> lock(self.mutex);
+    self.state.store(WorkerState::kParked, std::memory_order_seq_cst);
+    m_idleWorkers.fetch_add(1, std::memory_order_seq_cst);
+
+    bool woken = true;
+    if (m_pending.load(std::memory_order_seq_cst) == 0 && !m_stopping.load(std::memory_order_seq_cst)) {
+        const auto notified = [&self]() {
+            return self.state.load(std::memory_order_relaxed) != WorkerState::kParked;
+        };
+        if (m_workerCount.load(std::memory_order_acquire) > m_minWorkers) {
+            woken = self.cv.wait_for(lock, m_keepAlive, notified);
+        } else {
+            self.cv.wait(lock, notified);
         }
+    }
+
+    self.state.store(WorkerState::kRunning, std::memory_order_relaxed);
+    m_idleWorkers.fetch_sub(1, std::memory_order_seq_cst);
+    return woken;
+}
 
-        task = std::move(m_tasks.front());
-        m_tasks.pop_front();
+/**
+ * @brief 保活超时后尝试退出
+ *
+ * @details 先递减线程计数再复查积压：若此时恰有新任务且 submit() 因名额已满没有补线程，
+ * 则重新预留名额继续服务，避免任务滞留。整个过程持 m_shutdownMutex，
+ * 与 retireWorker() 一样保证析构方观察到 0 时本线程已不再访问执行器。
+ */
+bool BlockingExecutor::tryRetire(size_t slot)
+{
+    std::lock_guard<std::mutex> lock(m_shutdownMutex);
+    size_t count = m_workerCount.load(std::memory_order_seq_cst);
+    if (count <= m_minWorkers || m_pending.load(std::memory_order_seq_cst) > 0) {
+        return false;
+    }
+    if (!m_workerCount.compare_exchange_strong(count, count - 1, std::memory_order_seq_cst)) {
+        return false;
+    }
+    if (m_pending.load(std::memory_order_seq_cst) > 0 && tryReserveWorker()) {
+        return false;
+    }
+
+    m_slots[slot].state.store(WorkerState::kFree, std::memory_order_release);
+    if (count == 1 && m_stopping.load(std::memory_order_acquire)) {
+        m_shutdownCv.notify_all();
     }
+    return true;
 }
 
 /**
- * @brief 在持锁状态下递减工作线程计数，必要时通知关闭等待
+ * @brief 递减工作线程计数并释放槽位，必要时通知关闭等待
  *
- * @note 必须在持有 m_mutex 时调用
+ * @note 在 m_shutdownMutex 内完成：析构方只有在本线程释放该锁后才能观察到 0，
+ *       之后本线程不再访问执行器。
  */
-void BlockingExecutor::retireWorkerLocked()
+void BlockingExecutor::retireWorker(size_t slot)
 {
-    --m_workerCount;
-    if (m_stopping && m_workerCount == 0) {
+    std::lock_guard<std::mutex> lock(m_shutdownMutex);
+    const size_t previous = m_workerCount.fetch_sub(1, std::memory_order_acq_rel);
+    m_slots[slot].state.store(WorkerState::kFree, std::memory_order_release);
+    if (previous == 1 && m_stopping.load(std::memory_order_acquire)) {
         m_shutdownCv.notify_all();
     }
 }
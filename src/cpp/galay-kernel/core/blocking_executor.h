@@ -6,21 +6,31 @@
  *
  * @details 提供按需伸缩的线程池，当线程空闲超过配置的保活超时后自动收缩。
  * 由 Runtime::spawnBlocking() 用于卸载不可协程化的阻塞调用。
+ *
+ * 提交路径不持全局锁：任务以 BlockingTask（小缓冲 move-only 可调用对象）写入
+ * 按提交线程分片的 Vyukov 有界环；每个工作线程有独立的停泊槽，提交方只唤醒
+ * 一个已停泊的线程。所有分片写满时才退回带锁的溢出队列。
  */
 
 #ifndef GALAY_KERNEL_BLOCKING_EXECUTOR_H
 #define GALAY_KERNEL_BLOCKING_EXECUTOR_H
 
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <concepts>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <expected>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace galay::kernel
 {
@@ -61,9 +71,120 @@ private:
     BlockingExecutorErrorCode m_code;
 };
 
+/**
+ * @brief 阻塞执行器使用的 move-only 可调用对象
+ * @details 不超过 kInlineSize 且 nothrow 可移动的可调用对象直接存放在内部缓冲区，
+ * 不做堆分配；更大的对象退回堆上存放。只能调用一次的语义由执行器保证。
+ */
+class BlockingTask
+{
+public:
+    static constexpr size_t kInlineSize = 48;  ///< 内联缓冲区字节数；spawnBlocking 的包装 lambda 加 24 字节以内的用户闭包可内联
+
+    BlockingTask() noexcept = default;
+
+    template <typename F>
+        requires(!std::same_as<std::decay_t<F>, BlockingTask> && std::invocable<std::decay_t<F>&>)
+    BlockingTask(F&& function)  ///< 从任意可调用对象构造；空的 std::function / 空函数指针得到空任务
+    {
+        using Fn = std::decay_t<F>;
+        if constexpr (std::is_pointer_v<Fn> || std::same_as<Fn, std::function<void()>>) {
+            if (!function) {
+                return;
+            }
+        }
+        if constexpr (kStoredInline<Fn>) {
+            ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(function));
+            m_ops = &kInlineOps<Fn>;
+        } else {
+            ::new (static_cast<void*>(m_storage)) Fn*(new Fn(std::forward<F>(function)));
+            m_ops = &kHeapOps<Fn>;
+        }
+    }
+
+    BlockingTask(BlockingTask&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    BlockingTask& operator=(BlockingTask&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    BlockingTask(const BlockingTask&) = delete;
+    BlockingTask& operator=(const BlockingTask&) = delete;
+
+    ~BlockingTask() { reset(); }
+
+    explicit operator bool() const noexcept { return m_ops != nullptr; }  ///< 是否持有可调用对象
+    bool storedInline() const noexcept { return m_ops != nullptr && m_ops->inline_storage; }  ///< 可调用对象是否存放在内联缓冲区
+
+    void operator()() { m_ops->invoke(m_storage); }  ///< 调用持有的对象；调用方保证非空
+
+    void reset() noexcept  ///< 销毁持有的可调用对象并置空
+    {
+        if (m_ops != nullptr) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*relocate)(void* destination, void* source) noexcept;  ///< 移动构造到 destination 并销毁 source
+        void (*destroy)(void* storage) noexcept;
+        bool inline_storage;
+    };
+
+    template <typename Fn>
+    static constexpr bool kStoredInline = sizeof(Fn) <= kInlineSize &&
+        alignof(Fn) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Fn>;
+
+    template <typename Fn>
+    static constexpr Ops kInlineOps{
+        [](void* storage) { std::invoke(*std::launder(static_cast<Fn*>(storage))); },
+        [](void* destination, void* source) noexcept {
+            Fn* from = std::launder(static_cast<Fn*>(source));
+            ::new (destination) Fn(std::move(*from));
+            from->~Fn();
+        },
+        [](void* storage) noexcept { std::launder(static_cast<Fn*>(storage))->~Fn(); },
+        true,
+    };
+
+    template <typename Fn>
+    static constexpr Ops kHeapOps{
+        [](void* storage) { std::invoke(**std::launder(static_cast<Fn**>(storage))); },
+        [](void* destination, void* source) noexcept {
+            ::new (destination) Fn*(*std::launder(static_cast<Fn**>(source)));
+        },
+        [](void* storage) noexcept { delete *std::launder(static_cast<Fn**>(storage)); },
+        false,
+    };
+
+    void moveFrom(BlockingTask& other) noexcept
+    {
+        if (other.m_ops != nullptr) {
+            other.m_ops->relocate(m_storage, other.m_storage);
+            m_ops = std::exchange(other.m_ops, nullptr);
+        }
+    }
+
+    alignas(std::max_align_t) std::byte m_storage[kInlineSize];  ///< 内联对象或堆对象指针
+    const Ops* m_ops = nullptr;  ///< 类型擦除操作表；为空表示没有任务
+};
+
 /**
  * @brief 自适应阻塞任务执行器
  * @details 为 Runtime 的 `spawnBlocking()` 提供线程池，适合执行不可协程化的阻塞调用。
+ * 线程数在 [minWorkers, maxWorkers] 间弹性伸缩：没有空闲线程时按需拉起，
+ * 多出 minWorkers 的线程空闲超过 keepAlive 后退出。
  */
 class BlockingExecutor
 {
@@ -75,25 +196,90 @@ public:
     BlockingExecutor(const BlockingExecutor&) = delete;
     BlockingExecutor& operator=(const BlockingExecutor&) = delete;
 
-    std::expected<void, BlockingExecutorError> submit(std::function<void()> task);  ///< 提交一个阻塞任务；必要时会拉起额外工作线程
+    /**
+     * @brief 提交一个阻塞任务；必要时会拉起额外工作线程
+     * @details 可调用对象就地构造为 BlockingTask，小闭包不做堆分配。
+     */
+    template <typename F>
+        requires(!std::same_as<std::decay_t<F>, BlockingTask> && std::invocable<std::decay_t<F>&>)
+    std::expected<void, BlockingExecutorError> submit(F&& task)
+    {
+        return submit(BlockingTask(std::forward<F>(task)));
+    }
+
+    std::expected<void, BlockingExecutorError> submit(BlockingTask task);  ///< 提交已构造的任务；空任务直接成功返回
+
+    size_t workerCount() const noexcept { return m_workerCount.load(std::memory_order_acquire); }  ///< 当前存活的工作线程数
+    size_t idleWorkerCount() const noexcept { return m_idleWorkers.load(std::memory_order_acquire); }  ///< 当前停泊中的工作线程数
 
 private:
-    void workerLoop(std::function<void()> initialTask);  ///< 工作线程主循环，持续拉取并执行阻塞任务
-    void retireWorkerLocked();  ///< 在持锁状态下回收一个空闲工作线程计数
+    static constexpr size_t kShardCapacity = 512;  ///< 每个分片环的槽位数，必须是 2 的幂
+    static constexpr size_t kMaxShards = 8;  ///< 分片数上限
+
+    /**
+     * @brief Vyukov 有界 MPMC 环
+     */
+    struct Shard {
+        struct Cell {
+            std::atomic<size_t> sequence{0};  ///< 槽位序号；等于 pos 可写，等于 pos+1 可读
+            BlockingTask task;  ///< 槽位中的任务
+        };
+
+        Shard();
+
+        bool push(BlockingTask& task) noexcept;  ///< 写入成功时移走 task；环满返回 false
+        bool pop(BlockingTask& task) noexcept;  ///< 取出一个任务；环空返回 false
+
+        alignas(64) std::atomic<size_t> enqueue_pos{0};  ///< 下一个写入位置
+        alignas(64) std::atomic<size_t> dequeue_pos{0};  ///< 下一个读取位置
+        std::unique_ptr<Cell[]> cells;  ///< kShardCapacity 个槽位
+    };
+
+    enum class WorkerState : uint8_t {
+        kFree,      ///< 槽位未被工作线程占用
+        kRunning,   ///< 工作线程正在执行或查找任务
+        kParked,    ///< 工作线程在 cv 上停泊
+        kNotified,  ///< 提交方已把停泊线程标记为待唤醒
+    };
+
+    /**
+     * @brief 每个工作线程独立的停泊槽
+     */
+    struct alignas(64) WorkerSlot {
+        std::atomic<WorkerState> state{WorkerState::kFree};  ///< 槽位状态；kParked -> kNotified 只在持 mutex 时发生
+        std::mutex mutex;  ///< 只保护本槽位的停泊与唤醒
+        std::condition_variable cv;  ///< 本线程的停泊条件变量
+    };
+
+    void workerLoop(size_t slot, BlockingTask initialTask);  ///< 工作线程主循环，持续拉取并执行阻塞任务
+    void spawnWorker(BlockingTask initialTask);  ///< 占用空闲槽位并拉起一个分离线程；调用前须已预留线程计数
+    bool tryReserveWorker() noexcept;  ///< 线程数未达上限时预留一个名额
+    bool wakeParkedWorker() noexcept;  ///< 唤醒一个停泊线程；没有可唤醒线程时返回 false
+    bool park(WorkerSlot& self);  ///< 停泊直到被唤醒或保活超时；超时返回 false
+    bool tryRetire(size_t slot);  ///< 保活超时后尝试退出；仍有积压或线程数已到下限时返回 false
+    void retireWorker(size_t slot);  ///< 释放槽位并递减线程计数，必要时通知关闭等待
+    void enqueue(BlockingTask task);  ///< 写入提交线程的分片，分片全满时写入溢出队列
+    bool tryDequeue(size_t slot, BlockingTask& task);  ///< 先取本线程分片，再依次扫描其它分片与溢出队列
     static size_t defaultMaxWorkers();  ///< 根据当前机器并发度推导默认最大线程数
 
     size_t m_minWorkers;  ///< 最少保留的工作线程数
     size_t m_maxWorkers;  ///< 允许扩张到的最大工作线程数
     std::chrono::milliseconds m_keepAlive;  ///< 空闲线程超过该时间后允许退出
 
-    std::mutex m_mutex;  ///< 保护任务队列和线程状态
-    std::condition_variable m_taskCv;  ///< 新任务到达时唤醒工作线程
-    std::condition_variable m_shutdownCv;  ///< 析构等待所有线程退出时使用
-    std::deque<std::function<void()>> m_tasks;  ///< 待执行阻塞任务队列
+    size_t m_shardMask;  ///< 分片数减一
+    std::unique_ptr<Shard[]> m_shards;  ///< 提交分片
+    std::unique_ptr<WorkerSlot[]> m_slots;  ///< m_maxWorkers 个工作线程停泊槽
 
-    size_t m_workerCount{0};  ///< 当前已创建的工作线程数
-    size_t m_idleWorkers{0};  ///< 当前空闲工作线程数
-    bool m_stopping{false};  ///< 执行器是否处于停止中
+    alignas(64) std::atomic<size_t> m_pending{0};  ///< 已提交尚未被取走的任务数
+    alignas(64) std::atomic<size_t> m_workerCount{0};  ///< 当前已创建（含已预留）的工作线程数
+    std::atomic<size_t> m_idleWorkers{0};  ///< 当前停泊中的工作线程数
+    std::atomic<bool> m_stopping{false};  ///< 执行器是否处于停止中
+
+    std::mutex m_overflowMutex;  ///< 保护溢出队列
+    std::deque<BlockingTask> m_overflow;  ///< 所有分片写满时的后备队列
+
+    std::mutex m_shutdownMutex;  ///< 线程退出与析构等待的同步点
+    std::condition_variable m_shutdownCv;  ///< 析构等待所有线程退出时使用
 };
 
 } // namespace galay::kernel
@@ -5,22 +5,48 @@
  * @version 1.0.0
  *
  * @details 实现单线程 ComputeScheduler，通过阻塞并发队列在专用工作线程上
- * 驱动 CPU 密集型协程。
+ * 驱动 CPU 密集型协程；加入 steal-domain 后改用 IOSchedulerWorkerState 的
+ * 本地 ring 与随机 victim 窃取，空闲线程先自旋再停泊在 futex 字上。
  */
 
 #include "compute_scheduler.h"
 
 #include <future>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#endif
+
 namespace galay::kernel
 {
 
+namespace
+{
+
+// 停泊前的空转轮数；每轮做一次窃取探测，覆盖短间隔突发的唤醒延迟。
+constexpr uint32_t kComputeSpinRounds = 64;
+
+inline void computeCpuPause() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+} // namespace
+
 /**
  * @brief 默认构造函数；初始化延迟到 start() 执行
  */
 ComputeScheduler::ComputeScheduler()
+    : m_worker(GALAY_SCHEDULER_BATCH_SIZE)
+    , m_core(m_worker, GALAY_SCHEDULER_BATCH_SIZE)
 {
     m_resumeQueue.close();
+    m_worker.setStealingEnabled(false);
+    m_worker.closeResumeAdmission();
 }
 
 /**
@@ -43,7 +69,8 @@ std::expected<void, IOError> ComputeScheduler::start()
     if (!m_running.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
         return {};  // 已经在运行
     }
-    if (!m_resumeQueue.reopen()) {
+    const bool reopened = m_pooled ? m_worker.reopenResumeAdmission() : m_resumeQueue.reopen();
+    if (!reopened) {
         m_running.store(false, std::memory_order_release);
         return std::unexpected(IOError(kNotReady, 0));
     }
@@ -55,7 +82,12 @@ std::expected<void, IOError> ComputeScheduler::start()
         m_threadId = std::this_thread::get_id();  // 设置调度器线程ID
         thread_ready.set_value();
         (void)applyConfiguredAffinity();
-        workerLoop();
+        (void)applyConfiguredNumaPlacement();
+        if (m_pooled) {
+            pooledWorkerLoop();
+        } else {
+            workerLoop();
+        }
     });
     ready.wait();
     return {};
@@ -70,10 +102,14 @@ std::expected<void, IOError> ComputeScheduler::start()
 void ComputeScheduler::stop()
 {
     m_resumeQueue.close();
+    m_worker.closeResumeAdmission();
     bool expected = true;
     if (!m_running.compare_exchange_strong(expected, false, std::memory_order_acq_rel)) {
         return;  // 已经停止
     }
+    if (m_pooled) {
+        unpark();
+    }
 
     // 等待线程结束
     if (m_thread.joinable()) {
@@ -92,7 +128,28 @@ bool ComputeScheduler::schedule(TaskRef task) noexcept
     if (!bindTask(task)) {
         return false;
     }
-    return m_queue.enqueue(ComputeTask{std::move(task)});
+    if (!m_pooled) {
+        return m_queue.enqueue(ComputeTask{std::move(task)});
+    }
+
+    if (std::this_thread::get_id() == m_threadId) {
+        // 本线程派生的任务先进 LIFO 槽；被挤出的旧任务进入 ring 后即可被窃取。
+        m_worker.scheduleLocal(std::move(task));
+        wakeSiblingForBacklog();
+        return true;
+    }
+
+    if (!m_worker.scheduleInjected(std::move(task)).has_value()) {
+        return false;
+    }
+    // 与 park() 中的栅栏配对：要么 owner 重检时看到新任务，要么这里看到 m_parked。
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_parked.load(std::memory_order_relaxed)) {
+        unpark();
+    } else if (m_worker.injected_outstanding.load(std::memory_order_relaxed) > 1) {
+        wakeIdleSibling();
+    }
+    return true;
 }
 
 bool ComputeScheduler::scheduleResume(TaskRef task) noexcept
@@ -100,7 +157,40 @@ bool ComputeScheduler::scheduleResume(TaskRef task) noexcept
     if (!bindTask(task)) {
         return false;
     }
-    return m_resumeQueue.push(std::move(task));
+    if (!m_pooled) {
+        return m_resumeQueue.push(std::move(task));
+    }
+
+    if (std::this_thread::get_id() == m_threadId) {
+        m_worker.scheduleLocal(std::move(task));
+        return true;
+    }
+    if (!m_worker.scheduleResume(std::move(task)).has_value()) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_parked.load(std::memory_order_relaxed)) {
+        unpark();
+    }
+    return true;
+}
+
+/**
+ * @brief 配置计算池 steal-domain
+ *
+ * @details 只记录视图并切换模式；运行中调用会被忽略，避免工作线程与
+ * 调用方对 m_pooled 的观察不一致。
+ */
+void ComputeScheduler::configureStealDomain(std::span<ComputeScheduler* const> siblings,
+                                            size_t self_index) noexcept
+{
+    if (isRunning()) {
+        return;
+    }
+    m_pooled = siblings.size() > 1 && self_index < siblings.size();
+    m_steal_siblings = m_pooled ? siblings : std::span<ComputeScheduler* const>{};
+    m_worker.self_index = m_pooled ? self_index : 0;
+    m_worker.setStealingEnabled(m_pooled);
 }
 
 /**
@@ -166,6 +256,94 @@ void ComputeScheduler::workerLoop()
     drainResumeQueue();
 }
 
+/**
+ * @brief 池模式工作线程主循环
+ *
+ * @details 每轮先跑一个有预算的本地 ready pass；本地与注入队列都为空时
+ * 随机探测 sibling 窃取其积压的一半，连续 kComputeSpinRounds 轮落空后停泊。
+ * 每轮过后本地 ring 仍有积压时唤醒一个停泊的 sibling 来分担。
+ * 收到停止信号后只排空本地已接纳任务，不再窃取。
+ */
+void ComputeScheduler::pooledWorkerLoop()
+{
+    auto resume_fn = [this](detail::ReadyEntry& entry) { Scheduler::resume(entry); };
+    uint32_t idle_rounds = 0;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        if (m_core.runReadyPass(resume_fn) > 0) {
+            // ready pass 会把注入任务与窃取所得搬进 ring；留下的积压同样要叫醒空闲 sibling，
+            // 否则在此之前已停泊的 worker 要等下一次 submit 才会醒来。
+            wakeSiblingForBacklog();
+            idle_rounds = 0;
+            continue;
+        }
+        if (m_worker.tryStealFrom(m_steal_siblings)) {
+            idle_rounds = 0;
+            continue;
+        }
+        if (++idle_rounds < kComputeSpinRounds) {
+            computeCpuPause();
+            continue;
+        }
+        idle_rounds = 0;
+        park();
+    }
+
+    while (m_core.hasPendingWork()) {
+        m_core.runReadyPass(resume_fn);
+    }
+}
+
+void ComputeScheduler::park()
+{
+    const uint32_t epoch = m_park_epoch.load(std::memory_order_acquire);
+    m_parked.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // 与 wakeSiblingForBacklog() 的栅栏配对：要么这里看到 sibling 的积压，要么对方看到 m_parked。
+    if (!m_core.hasPendingWork() && !siblingHasBacklog() &&
+        m_running.load(std::memory_order_acquire)) {
+        m_park_epoch.wait(epoch, std::memory_order_acquire);
+    }
+    m_parked.store(false, std::memory_order_relaxed);
+}
+
+void ComputeScheduler::unpark() noexcept
+{
+    m_park_epoch.fetch_add(1, std::memory_order_release);
+    m_park_epoch.notify_one();
+}
+
+void ComputeScheduler::wakeIdleSibling() noexcept
+{
+    const size_t count = m_steal_siblings.size();
+    for (size_t probe = 1; probe < count; ++probe) {
+        ComputeScheduler* const sibling = m_steal_siblings[(m_worker.self_index + probe) % count];
+        if (sibling != nullptr && sibling->m_parked.load(std::memory_order_relaxed)) {
+            sibling->unpark();
+            return;
+        }
+    }
+}
+
+void ComputeScheduler::wakeSiblingForBacklog() noexcept
+{
+    if (m_worker.local_ring.empty()) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wakeIdleSibling();
+}
+
+bool ComputeScheduler::siblingHasBacklog() const noexcept
+{
+    for (ComputeScheduler* const sibling : m_steal_siblings) {
+        if (sibling != nullptr && sibling != this && !sibling->m_worker.local_ring.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void ComputeScheduler::drainResumeQueue()
 {
     TaskState* ready = detail::TaskResumeQueue::reverse(
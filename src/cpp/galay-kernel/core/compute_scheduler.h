@@ -6,6 +6,7 @@
  *
  * @details 基于单线程的计算任务调度器，用于处理 CPU 密集型任务。
  * 不涉及 IO 事件驱动，纯粹用于协程的计算任务调度。
+ * 多个调度器可通过 configureStealDomain() 组成 work-stealing 计算池。
  *
  * 使用方式：
  * @code
@@ -21,9 +22,11 @@
 #define GALAY_KERNEL_COMPUTE_SCHEDULER_H
 
 #include "scheduler.hpp"
+#include "scheduler_core.h"
 #include "timer_scheduler.h"
 #include <thread>
 #include <atomic>
+#include <span>
 #include <concurrentqueue/moodycamel/blockingconcurrentqueue.h>
 
 namespace galay::kernel
@@ -47,6 +50,8 @@ struct ComputeTask {
  * - 单线程执行协程
  * - BlockingConcurrentQueue 实现高效阻塞等待
  * - 计算完成后自动 spawn 回原调度器
+ * - 加入 steal-domain 后切换为池模式：本地 LIFO 槽 + Chase-Lev ring，
+ *   空闲时随机选择 sibling 窃取，先自旋再 futex 停泊
  *
  * @note 不支持 IO 操作，仅用于纯计算任务
  */
@@ -127,6 +132,30 @@ public:
      */
     bool isRunning() const { return m_running.load(std::memory_order_acquire); }
 
+    /**
+     * @brief 配置计算池 steal-domain
+     * @param siblings 同一计算池的只读调度器视图（含自身），需在调度器存活期间保持有效
+     * @param self_index 自身在 siblings 中的位置
+     * @note 仅在 start() 前调用；siblings 不少于 2 个时切换为池模式，否则回到单线程队列模式
+     */
+    void configureStealDomain(std::span<ComputeScheduler* const> siblings, size_t self_index) noexcept;
+
+    /**
+     * @brief 是否以 work-stealing 池模式运行
+     */
+    bool isPooled() const noexcept { return m_pooled; }
+
+    /**
+     * @brief 返回 stealing 路径使用的 worker 状态，供 sibling 窃取
+     */
+    IOSchedulerWorkerState* stealWorkerState() noexcept { return &m_worker; }
+
+    /**
+     * @brief 返回 stealing 统计快照
+     * @details 结果只在调度器已停止或外部同步后有定义；单线程队列模式恒为 0。
+     */
+    IOSchedulerStealStats stealStats() const noexcept { return m_worker.snapshotStealStats(); }
+
 
     /**
      * @brief 注册定时器
@@ -148,11 +177,36 @@ private:
     /** @brief 工作线程函数 */
     void workerLoop();
 
+    /** @brief 池模式工作线程函数：本地 ready pass -> 窃取 -> 自旋 -> 停泊 */
+    void pooledWorkerLoop();
+
+    /** @brief 池模式下无待办时停泊在 m_park_epoch 上，直到被 unpark() 唤醒 */
+    void park();
+
+    /** @brief 唤醒停泊中的池模式工作线程 */
+    void unpark() noexcept;
+
+    /** @brief 本调度器有可窃取积压时唤醒一个停泊中的 sibling */
+    void wakeIdleSibling() noexcept;
+
+    /** @brief 本地 ring 仍有可窃取积压时唤醒一个停泊中的 sibling；与 park() 的栅栏配对 */
+    void wakeSiblingForBacklog() noexcept;
+
+    /** @brief 任一 sibling 的本地 ring 是否有可窃取积压 */
+    bool siblingHasBacklog() const noexcept;
+
 private:
     std::thread m_thread;                                       ///< 工作线程
     moodycamel::BlockingConcurrentQueue<ComputeTask> m_queue;   ///< 任务队列（阻塞）
     detail::TaskResumeQueue m_resumeQueue;                       ///< Waker 专用无分配恢复队列
     std::atomic<bool> m_running{false};                         ///< 运行状态
+
+    IOSchedulerWorkerState m_worker;                            ///< 池模式本地队列、注入队列与窃取状态
+    SchedulerCore m_core;                                       ///< 池模式 ready pass 驱动
+    std::span<ComputeScheduler* const> m_steal_siblings{};      ///< 池模式 steal-domain 视图
+    std::atomic<uint32_t> m_park_epoch{0};                      ///< 停泊 futex 字，unpark() 递增
+    std::atomic<bool> m_parked{false};                          ///< 工作线程是否已停泊或正准备停泊
+    bool m_pooled = false;                                      ///< 是否以池模式运行
 };
 
 } // namespace galay::kernel
@@ -33,10 +33,10 @@ constexpr int kImmediateReady = 1;
 uint32_t ioTypeToEpollEvents(IOEventType type) {
     uint32_t events = EPOLLET;
     const uint32_t t = static_cast<uint32_t>(type);
-    if (t & (ACCEPT | RECV | READV | RECVFROM | FILEREAD | FILEWATCH)) {
+    if (t & (ACCEPT | RECV | READV | RECVFROM | FILEREAD | FILEWATCH | SPLICEIN)) {
         events |= EPOLLIN;
     }
-    if (t & (CONNECT | SEND | WRITEV | SENDTO | SENDFILE | FILEWRITE)) {
+    if (t & (CONNECT | SEND | WRITEV | SENDTO | SENDFILE | FILEWRITE | SPLICEOUT)) {
         events |= EPOLLOUT;
     }
     return events;
@@ -407,6 +407,24 @@ int EpollReactor::addSendFile(IOController* controller) {
     return applyEvents(controller, buildEvents(controller));
 }
 
+int EpollReactor::addSpliceIn(IOController* controller) {
+    auto* awaitable = controller->getAwaitable<SpliceInAwaitable>();
+    if (awaitable == nullptr) return -1;
+    if (awaitable->handleComplete(controller->m_handle)) {
+        return kImmediateReady;
+    }
+    return applyEvents(controller, buildEvents(controller));
+}
+
+int EpollReactor::addSpliceOut(IOController* controller) {
+    auto* awaitable = controller->getAwaitable<SpliceOutAwaitable>();
+    if (awaitable == nullptr) return -1;
+    if (awaitable->handleComplete(controller->m_handle)) {
+        return kImmediateReady;
+    }
+    return applyEvents(controller, buildEvents(controller));
+}
+
 int EpollReactor::addClose(IOController* controller) {
     if (controller == nullptr || controller->m_handle == GHandle::invalid()) {
         return 0;
@@ -567,6 +585,8 @@ void EpollReactor::processEvent(struct epoll_event& ev) {
             (void)complete_one_shot(controller->getAwaitable<ReadvAwaitable>(), READV);
         } else if (t & RECVFROM) {
             (void)complete_one_shot(controller->getAwaitable<RecvFromAwaitable>(), RECVFROM);
+        } else if (t & SPLICEIN) {
+            (void)complete_one_shot(controller->getAwaitable<SpliceInAwaitable>(), SPLICEIN);
         } else if (t & FILEREAD) {
             auto* aio_awaitable =
                 static_cast<galay::async::AioCommitAwaitable*>(controller->m_awaitable[IOController::READ]);
@@ -708,6 +728,8 @@ void EpollReactor::processEvent(struct epoll_event& ev) {
             (void)complete_one_shot(controller->getAwaitable<FileWriteAwaitable>(), FILEWRITE);
         } else if (after_read_type & SENDFILE) {
             (void)complete_one_shot(controller->getAwaitable<SendFileAwaitable>(), SENDFILE);
+        } else if (after_read_type & SPLICEOUT) {
+            (void)complete_one_shot(controller->getAwaitable<SpliceOutAwaitable>(), SPLICEOUT);
         }
     }
 
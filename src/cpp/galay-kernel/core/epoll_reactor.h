@@ -58,6 +58,8 @@ public:
     int addSendTo(IOController* controller);  ///< 注册 sendto 等待；1=立即完成，0=已登记，<0=错误
     int addFileWatch(IOController* controller);  ///< 注册文件监控等待；1=立即完成，0=已登记，<0=错误
     int addSendFile(IOController* controller);  ///< 注册 sendfile 等待；1=立即完成，0=已登记，<0=错误
+    int addSpliceIn(IOController* controller);  ///< 注册 socket→管道 splice 等待；1=立即完成，0=已登记，<0=错误
+    int addSpliceOut(IOController* controller); ///< 注册管道→socket splice 等待；1=立即完成，0=已登记，<0=错误
     int addSequence(IOController* controller);  ///< 注册组合式序列等待；1=立即完成，0=已登记，<0=错误
     int remove(IOController* controller);  ///< 删除控制器相关的所有 epoll 注册事件
     int flushPendingChanges();  ///< 把本地 pending 注册/反注册请求批量提交到内核
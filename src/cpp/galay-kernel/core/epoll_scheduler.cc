@@ -8,6 +8,7 @@
  */
 
 #include "epoll_scheduler.h"
+#include "numa_topology.h"
 #include "sched_loop.hpp"
 
 #ifdef USE_EPOLL
@@ -43,7 +44,12 @@ std::expected<void, IOError> EpollScheduler::start()
         return {};
     }
     m_last_error_code.store(0, std::memory_order_release);
-    auto reactor_ready = m_reactor.start();
+    std::expected<void, IOError> reactor_ready;
+    {
+        // reactor 的缓冲池在构造时即被触碰，需在所属 NUMA 节点上完成首次分配。
+        detail::NumaMemoryPolicyScope placement(numaNode());
+        reactor_ready = m_reactor.start();
+    }
     if (!reactor_ready) {
         m_running.store(false, std::memory_order_release);
         return std::unexpected(reactor_ready.error());
@@ -60,6 +66,7 @@ std::expected<void, IOError> EpollScheduler::start()
         m_threadId = std::this_thread::get_id();
         thread_ready.set_value();
         (void)applyConfiguredAffinity();
+        (void)applyConfiguredNumaPlacement();
         eventLoop();
     });
     ready.wait();
@@ -150,6 +157,16 @@ int EpollScheduler::addSendFile(IOController* controller)
     return m_reactor.addSendFile(controller);
 }
 
+int EpollScheduler::addSpliceIn(IOController* controller)
+{
+    return m_reactor.addSpliceIn(controller);
+}
+
+int EpollScheduler::addSpliceOut(IOController* controller)
+{
+    return m_reactor.addSpliceOut(controller);
+}
+
 int EpollScheduler::addSequence(IOController* controller)
 {
     return m_reactor.addSequence(controller);
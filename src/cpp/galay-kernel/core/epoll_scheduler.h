@@ -81,6 +81,8 @@ public:
     int addFileWatch(IOController* controller) override;  ///< 注册文件监控等待；1=立即完成，0=已挂起，<0=错误
 
     int addSendFile(IOController* controller) override;   ///< 注册 sendfile 等待；1=立即完成，0=已挂起，<0=错误
+    int addSpliceIn(IOController* controller) override;   ///< 注册 socket→管道 splice 等待；1=立即完成，0=已挂起，<0=错误
+    int addSpliceOut(IOController* controller) override;  ///< 注册管道→socket splice 等待；1=立即完成，0=已挂起，<0=错误
 
     int addSequence(IOController* controller) override;   ///< 注册组合式序列 IO；1=立即完成，0=已挂起，<0=错误
 
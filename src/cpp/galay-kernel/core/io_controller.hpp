@@ -6,7 +6,7 @@
  *
  * @details 定义 IOController，追踪每个 fd 的 IO 状态（事件类型、awaitable 槽位、
  * sequence 所有权）。在 io_uring 模式下还管理 SQE 代追踪、multishot accept/recv 队列、
- * 以及 provided-buffer recv 数据块缓存。
+ * provided-buffer recv 数据块缓存，以及 fixed-file 模式下的 fixed file 表槽位。
  *
  * @note IOController 非线程安全；只能在所属调度器线程上访问。
  */
@@ -28,6 +28,7 @@
 #include <expected>
 #include <memory>
 #include <utility>
+#include "udp_batch.hpp"
 #endif
 
 namespace galay::kernel
@@ -302,6 +303,8 @@ struct ReadyRecvDatagram {
     char* data = nullptr;  ///< 数据报 payload 起始地址
     size_t length = 0;  ///< 当前数据报 payload 长度
     uint16_t bid = 0;  ///< provided buffer id 标识
+    uint16_t segment_size = 0;  ///< UDP_GRO 合并段大小；0 表示未合并
+    bool truncated = false;  ///< 内核报告 MSG_TRUNC
     Kind kind = Kind::Buffer;  ///< 数据报类型
 
     void release() noexcept
@@ -329,17 +332,99 @@ private:
         data = other.data;
         length = other.length;
         bid = other.bid;
+        segment_size = other.segment_size;
+        truncated = other.truncated;
         kind = other.kind;
 
         other.owner.reset();
         other.data = nullptr;
         other.length = 0;
         other.bid = 0;
+        other.segment_size = 0;
+        other.truncated = false;
         other.kind = Kind::Buffer;
         other.result = size_t{0};
         other.recycle = nullptr;
     }
 };
+
+/**
+ * @brief socket 在 io_uring fixed file 表中的登记槽位
+ * @details 由 reactor 在 fixed-file 模式下首次提交 SQE 时填充。controller 析构、被移动覆盖
+ *          或 close 时归还槽位，避免 fixed file 表继续持有已关闭 socket 的文件引用。
+ *          release() 可能在任意线程调用，回调只把槽位交回 owner reactor 的退役队列；
+ *          清空表项与回收槽位都在 owner 线程完成。
+ */
+struct FixedFileSlot {
+    FixedFileSlot() = default;
+
+    FixedFileSlot(FixedFileSlot&& other) noexcept
+    {
+        moveFrom(std::move(other));
+    }
+
+    FixedFileSlot& operator=(FixedFileSlot&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            moveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    ~FixedFileSlot()
+    {
+        release();
+    }
+
+    std::shared_ptr<void> owner;  ///< 持有 reactor fixed file 表生命周期
+    void (*recycle)(const std::shared_ptr<void>&, uint32_t) noexcept = nullptr;  ///< 归还槽位到 fixed file 表的回调
+    int fd = -1;  ///< 登记时对应的普通 fd，用于识别 controller 句柄被替换
+    int32_t index = -1;  ///< fixed file 表下标；-1 表示未登记
+
+    bool registered() const noexcept { return index >= 0 && owner != nullptr; }  ///< 当前是否持有有效槽位
+
+    void release() noexcept
+    {
+        if (recycle != nullptr && owner && index >= 0) {
+            recycle(owner, static_cast<uint32_t>(index));
+        }
+        owner.reset();
+        recycle = nullptr;
+        fd = -1;
+        index = -1;
+    }
+
+    /**
+     * @brief 放弃槽位但不触发回调，由 owner reactor 在自身线程直接退役
+     * @return 原槽位下标
+     */
+    int32_t detach() noexcept
+    {
+        const int32_t detached = index;
+        owner.reset();
+        recycle = nullptr;
+        fd = -1;
+        index = -1;
+        return detached;
+    }
+
+private:
+    FixedFileSlot(const FixedFileSlot&) = delete;
+    FixedFileSlot& operator=(const FixedFileSlot&) = delete;
+
+    void moveFrom(FixedFileSlot&& other) noexcept
+    {
+        owner = std::move(other.owner);
+        recycle = other.recycle;
+        fd = other.fd;
+        index = other.index;
+
+        other.recycle = nullptr;
+        other.fd = -1;
+        other.index = -1;
+    }
+};
 #endif
 
 struct IOController {
@@ -417,6 +502,7 @@ struct IOController {
         , m_ready_accepts(std::move(other.m_ready_accepts))
         , m_ready_recvs(std::move(other.m_ready_recvs))
         , m_ready_recvfrom(std::move(other.m_ready_recvfrom))
+        , m_fixed_file(std::move(other.m_fixed_file))
         , m_accept_multishot_handle(other.m_accept_multishot_handle)
         , m_recv_multishot_handle(other.m_recv_multishot_handle)
         , m_recvfrom_multishot_handle(other.m_recvfrom_multishot_handle)
@@ -479,6 +565,7 @@ struct IOController {
             m_ready_accepts = std::move(other.m_ready_accepts);
             m_ready_recvs = std::move(other.m_ready_recvs);
             m_ready_recvfrom = std::move(other.m_ready_recvfrom);
+            m_fixed_file = std::move(other.m_fixed_file);
             m_accept_multishot_handle = other.m_accept_multishot_handle;
             m_recv_multishot_handle = other.m_recv_multishot_handle;
             m_recvfrom_multishot_handle = other.m_recvfrom_multishot_handle;
@@ -571,6 +658,7 @@ struct IOController {
         m_ready_accepts.clear();
         m_ready_recvs.clear();
         m_ready_recvfrom.clear();
+        m_fixed_file.release();
         m_accept_multishot_handle = nullptr;
         m_recv_multishot_handle = nullptr;
         m_recvfrom_multishot_handle = nullptr;
@@ -785,6 +873,41 @@ struct IOController {
         return true;
     }
 
+    /**
+     * @brief 队首是否为可交付的数据报（而非错误）
+     * @details 批量接收据此决定是否继续填充后续槽位；错误留在队首交给下一次接收。
+     */
+    bool hasReadyRecvFromData() const noexcept
+    {
+        return !m_ready_recvfrom.empty() &&
+               m_ready_recvfrom.front().kind == ReadyRecvDatagram::Kind::Buffer;
+    }
+
+    /**
+     * @brief 将队首数据报连同 GRO 段大小、截断标记消费到批量接收槽位
+     * @param out 批量接收槽位
+     * @return true 表示消费了一个数据报；false 表示队列为空或队首为错误
+     */
+    bool tryConsumeReadyRecvDatagram(UdpRecvDatagram& out)
+    {
+        if (!hasReadyRecvFromData()) {
+            return false;
+        }
+
+        auto& datagram = m_ready_recvfrom.front();
+        const size_t bytes = std::min(datagram.length, out.capacity);
+        if (bytes > 0) {
+            std::memcpy(out.buffer, datagram.data, bytes);
+        }
+        out.from = Host::fromSockAddr(datagram.source);
+        out.length = bytes;
+        out.segment_size = datagram.segment_size;
+        out.truncated = datagram.truncated || datagram.length > out.capacity;
+        datagram.release();
+        m_ready_recvfrom.pop_front();
+        return true;
+    }
+
     /**
      * @brief 归还所有尚未交付的 UDP provided buffers
      */
@@ -834,6 +957,7 @@ struct IOController {
     std::deque<GHandle> m_ready_accepts;  ///< listener 缓存的 accepted fd，供下一次 accept() 直接消费
     std::deque<ReadyRecvChunk> m_ready_recvs;  ///< socket 缓存的 ready recv 片段，供下一次 recv() 直接消费
     std::deque<ReadyRecvDatagram> m_ready_recvfrom;  ///< UDP socket 缓存的完整数据报
+    FixedFileSlot m_fixed_file;  ///< fixed-file 模式下该 socket 在 ring fixed file 表中的槽位
     SqeRequestHandle* m_accept_multishot_handle = nullptr;  ///< 当前 listener 持有的 multishot accept handle
     SqeRequestHandle* m_recv_multishot_handle = nullptr;  ///< 当前 socket 持有的 multishot recv handle
     SqeRequestHandle* m_recvfrom_multishot_handle = nullptr;  ///< 当前 UDP socket 持有的 multishot recvmsg handle
@@ -5,7 +5,7 @@
  * @version 1.0.0
  *
  * @details 提供 POSIX 和平台相关 IO 系统调用（accept、recv、send、readv、writev、
- * connect、sendfile 等）的薄内联封装，将错误码转换为 galay::kernel::IOError。
+ * connect、sendfile、splice 等）的薄内联封装，将错误码转换为 galay::kernel::IOError。
  * 在 io_uring 模式下，封装通过消费完成队列条目（CQE）而非直接执行系统调用。
  */
 
@@ -25,7 +25,11 @@
 #include <sys/socket.h>
 #include <sys/uio.h>
 #ifdef USE_EPOLL
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
 #include <sys/sendfile.h>
+#include <ctime>
 #endif
 #include <unistd.h>
 #include <cerrno>
@@ -234,11 +238,57 @@ inline std::expected<size_t, IOError> handleSendFile(GHandle socket_handle, int
 #endif
 }
 
+/**
+ * @brief 在 socket 与管道之间执行一次非阻塞 splice
+ * @param fd_in 数据来源 fd（socket 或管道读端）
+ * @param fd_out 数据去向 fd（管道写端或 socket）
+ * @param length 本次最多搬运的字节数
+ * @param fail_code 失败时使用的错误类别（读向 kRecvFailed，写向 kSendFailed）
+ * @return 实际搬运的字节数；0 表示来源到达 EOF
+ * @note
+ * - splice 写 socket 时无法携带 MSG_NOSIGNAL，对端已关闭会向当前线程投递 SIGPIPE；
+ *   写向（kSendFailed）首次调用时在当前 IO 线程屏蔽 SIGPIPE 并保持屏蔽，遇到 EPIPE 时取走挂起的信号。
+ *   只影响该调度线程的信号掩码，不改动进程的全局信号处理方式；逐次屏蔽/恢复会让每次写多出两次系统调用
+ * - kqueue 平台没有 splice，固定返回 ENOSYS，由上层退回用户态拷贝
+ */
+inline std::expected<size_t, IOError> handleSplice(int fd_in, int fd_out, size_t length, IOErrorCode fail_code)
+{
+#ifdef USE_EPOLL
+    const bool to_socket = fail_code == kSendFailed;
+    sigset_t sigpipe_mask;
+    sigemptyset(&sigpipe_mask);
+    sigaddset(&sigpipe_mask, SIGPIPE);
+    thread_local bool sigpipe_blocked = false;
+    if (to_socket && !sigpipe_blocked) {
+        sigpipe_blocked = pthread_sigmask(SIG_BLOCK, &sigpipe_mask, nullptr) == 0;
+    }
+    ssize_t moved = ::splice(fd_in, nullptr, fd_out, nullptr, length, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    const int saved_errno = errno;
+    if (to_socket && moved < 0 && saved_errno == EPIPE) {
+        const struct timespec no_wait{};
+        (void)sigtimedwait(&sigpipe_mask, nullptr, &no_wait);
+    }
+    if (moved >= 0) {
+        return static_cast<size_t>(moved);
+    }
+    if (saved_errno == EAGAIN || saved_errno == EWOULDBLOCK || saved_errno == EINTR) {
+        return std::unexpected(IOError(kNotReady, 0));
+    }
+    return std::unexpected(IOError(fail_code, static_cast<uint32_t>(saved_errno)));
+#else
+    (void)fd_in;
+    (void)fd_out;
+    (void)length;
+    return std::unexpected(IOError(fail_code, static_cast<uint32_t>(ENOSYS)));
+#endif
+}
+
 #ifdef USE_EPOLL
 inline FileWatchResult makeInotifyWatchResult(const struct inotify_event& event)
 {
     FileWatchResult result{};
     result.isDir = (event.mask & IN_ISDIR) != 0;
+    result.wd = event.wd;
     if (event.len > 0) {
         result.name = std::string(event.name);
     }
@@ -444,6 +494,7 @@ inline FileWatchResult makeInotifyWatchResult(const struct inotify_event& event)
 {
     FileWatchResult result{};
     result.isDir = (event.mask & IN_ISDIR) != 0;
+    result.wd = event.wd;
     if (event.len > 0) {
         result.name = std::string(event.name);
     }
@@ -533,6 +584,25 @@ inline std::expected<size_t, IOError> handleSendFile(struct io_uring_cqe* cqe, G
     return std::unexpected(IOError(kSendFailed, static_cast<uint32_t>(errno)));
 }
 
+/**
+ * @brief 解析 IORING_OP_SPLICE 的完成结果
+ * @param cqe splice SQE 的完成项（前置的 poll SQE 不携带 user_data，不会走到这里）
+ * @param fail_code 失败时使用的错误类别
+ * @return 实际搬运的字节数；0 表示来源到达 EOF
+ * @note splice 在 io-wq 线程中执行，这些内核线程屏蔽了 SIGPIPE，写已关闭的 socket 只得到 -EPIPE
+ */
+inline std::expected<size_t, IOError> handleSplice(struct io_uring_cqe* cqe, IOErrorCode fail_code)
+{
+    int res = cqe->res;
+    if (res >= 0) {
+        return static_cast<size_t>(res);
+    }
+    if (-res == EAGAIN || -res == EWOULDBLOCK || -res == EINTR) {
+        return std::unexpected(IOError(kNotReady, 0));
+    }
+    return std::unexpected(IOError(fail_code, static_cast<uint32_t>(-res)));
+}
+
 } // namespace galay::kernel::io
 
 #endif // defined(USE_IOURING)
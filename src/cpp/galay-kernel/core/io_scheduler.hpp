@@ -20,6 +20,8 @@
 #include "scheduler.hpp"
 #include "io_controller.hpp"
 #include "awaitable.h"
+#include "registered_buffer.h"
+#include "uring_options.h"
 #include "../common/timer_manager.hpp"
 #include <algorithm>
 #include <array>
@@ -317,6 +319,9 @@ class IOScheduler;
 struct IOSchedulerStealStats {
     uint64_t steal_attempts = 0;
     uint64_t steal_successes = 0;
+    uint64_t same_node_steals = 0;  ///< 从同一 NUMA 节点 victim 窃取成功的次数；未配置 NUMA 时等于 steal_successes
+    uint64_t cross_node_steals = 0;  ///< 退避后从其它 NUMA 节点 victim 窃取成功的次数
+    uint32_t numa_node = 0;  ///< worker 所属 NUMA 节点；未配置时为 0
 };
 
 /**
@@ -678,10 +683,22 @@ struct IOSchedulerWorkerState {
      */
     bool trySteal();
 
+    /**
+     * @brief 在任意 steal-domain 中随机选择 victim 并窃取其积压的一半
+     * @tparam Sibling 暴露 `IOSchedulerWorkerState* stealWorkerState()` 的调度器类型
+     * @param domain 含自身在内的只读 sibling 视图；自身位置由 self_index 给出
+     * @return true 表示 stealing 成功，应立即回到 ready pass
+     */
+    template <typename Sibling>
+    bool tryStealFrom(std::span<Sibling* const> domain);
+
     IOSchedulerStealStats snapshotStealStats() const noexcept {
         return IOSchedulerStealStats{
             .steal_attempts = steal_attempts,
             .steal_successes = steal_successes,
+            .same_node_steals = same_node_steals,
+            .cross_node_steals = cross_node_steals,
+            .numa_node = numa_node,
         };
     }
 
@@ -703,6 +720,19 @@ struct IOSchedulerWorkerState {
         siblings = view;
     }
 
+    /**
+     * @brief 让 stealing 优先选择同一 NUMA 节点的 victim
+     * @param node 本 worker 所属节点；victim 所属节点取自其 worker state
+     * @param cross_node_backoff 连续多少轮同节点窃取落空后才探测一次跨节点 victim；0 表示同轮立即跨节点
+     */
+    void configureNumaStealing(uint32_t node, uint32_t cross_node_backoff) noexcept
+    {
+        numa_node = node;
+        numa_cross_node_backoff = cross_node_backoff;
+        numa_same_node_misses = 0;
+        numa_aware = true;
+    }
+
     void setStealingEnabled(bool enabled) noexcept {
         stealing_enabled = enabled;
         local_ring.setStealingEnabled(enabled);
@@ -713,6 +743,11 @@ struct IOSchedulerWorkerState {
     std::atomic<uint64_t> injected_outstanding{0};  ///< 尚未搬运到本地队列的注入任务数
     uint64_t steal_attempts = 0;  ///< trySteal() 进入真实 sibling 探测的次数
     uint64_t steal_successes = 0;  ///< trySteal() 成功窃取至少一个任务的次数
+    uint64_t same_node_steals = 0;  ///< 同节点 victim 窃取成功次数
+    uint64_t cross_node_steals = 0;  ///< 跨节点 victim 窃取成功次数
+    uint32_t numa_node = 0;  ///< worker 所属 NUMA 节点
+    uint32_t numa_cross_node_backoff = 0;  ///< 跨节点探测前需要连续落空的同节点窃取轮数
+    uint32_t numa_same_node_misses = 0;  ///< 当前连续落空的同节点窃取轮数
     uint32_t consecutive_lifo_polls = 0;  ///< 连续命中 ready_lifo_slot 的次数
     uint32_t lifo_poll_limit = 8;  ///< 允许连续走 LIFO 的最大次数
     uint32_t polls_since_inject = 0;  ///< 距离上次检查 ready_inject_queue 已轮询的任务数
@@ -720,9 +755,14 @@ struct IOSchedulerWorkerState {
     std::atomic<bool> owner_drained_injected_once{false};  ///< owner 线程是否已处理过注入队列
     bool lifo_enabled = true;  ///< 是否允许优先从 ready_lifo_slot 取任务
     bool stealing_enabled = true;  ///< 当前后端是否允许在 sibling 线程上恢复 stolen task
+    bool numa_aware = false;  ///< 是否区分同节点 / 跨节点 victim
     bool prefer_resume_on_single_slot = true;  ///< 普通注入与 resume 同时积压时轮换最后一个 ring 槽
 
 private:
+    template <typename Sibling>
+    size_t stealFromDomain(std::span<Sibling* const> domain, size_t local_capacity, bool same_node);  ///< 按节点过滤探测一轮 victim；返回窃取数量
+    size_t stealFromVictim(IOSchedulerWorkerState& victim, size_t local_capacity);  ///< 从单个 victim 窃取其积压的一半
+
     void clearPendingReadyEntries() noexcept {
         ready_lifo_slot.reset();
         local_ring.clear();
@@ -838,6 +878,16 @@ inline auto IOController::getAwaitable() -> SendFileAwaitable* {
     return static_cast<SendFileAwaitable*>(m_awaitable[WRITE]);
 }
 
+template<>
+inline auto IOController::getAwaitable() -> SpliceInAwaitable* {
+    return static_cast<SpliceInAwaitable*>(m_awaitable[READ]);
+}
+
+template<>
+inline auto IOController::getAwaitable() -> SpliceOutAwaitable* {
+    return static_cast<SpliceOutAwaitable*>(m_awaitable[WRITE]);
+}
+
 /**
  * @brief 完成 awaitable 并在需要时唤醒关联协程
  * @tparam Awaitable 具体 awaitable 类型
@@ -967,6 +1017,22 @@ public:
      */
     virtual int addSendFile(IOController* controller) = 0;
 
+    /**
+     * @brief 注册 socket → 管道的 splice 事件
+     * @param controller IO控制器
+     * @return 1表示立即完成，0表示已注册等待，<0表示错误
+     * @note 默认实现返回 -EOPNOTSUPP，便于测试替身与第三方后端不必实现
+     */
+    virtual int addSpliceIn([[maybe_unused]] IOController* controller) { return -EOPNOTSUPP; }
+
+    /**
+     * @brief 注册管道 → socket 的 splice 事件
+     * @param controller IO控制器
+     * @return 1表示立即完成，0表示已注册等待，<0表示错误
+     * @note 默认实现返回 -EOPNOTSUPP
+     */
+    virtual int addSpliceOut([[maybe_unused]] IOController* controller) { return -EOPNOTSUPP; }
+
     /**
      * @brief 注册组合式序列 IO 事件
      * @param controller IO 控制器
@@ -990,6 +1056,25 @@ public:
         return std::nullopt;
     }
 
+    /**
+     * @brief 从调度器的注册缓冲池租借一个文件 IO 切片
+     * @param length 需要的最小容量（字节）
+     * @return 注册池切片；后端不支持、未启用或池已耗尽时返回无效切片
+     * @note 仅可在调度器线程调用；切片也应在该线程上释放
+     */
+    virtual RegisteredBuffer leaseRegisteredBuffer(size_t length) {
+        (void)length;
+        return {};
+    }
+
+    /**
+     * @brief 是否由内核 LINK_TIMEOUT 承担一次性 IO 的 `.timeout()` 截止时间
+     * @return 默认 false，表示统一使用时间轮
+     */
+    virtual bool linkedTimeoutsEnabled() const noexcept {
+        return false;
+    }
+
 
     /**
      * @brief 替换调度器的定时器管理器
@@ -1014,7 +1099,18 @@ public:
      * @return true 定时器已加入当前调度器的时间轮；false 插入失败
      */
     bool addTimer(Timer::ptr timer) override {
-        return m_timer_manager.push(timer);
+        return m_timer_manager.push(std::move(timer));
+    }
+
+    /**
+     * @brief 在调度器线程上 O(1) 摘除尚未到期的定时器
+     * @return true 定时器已从本调度器时间轮解链；非调度器线程调用时返回 false
+     */
+    bool removeTimer(Timer& timer) noexcept override {
+        if (std::this_thread::get_id() != m_threadId) {
+            return false;
+        }
+        return m_timer_manager.erase(timer);
     }
 
     /**
@@ -1045,14 +1141,24 @@ public:
         return {};
     }
 
+    /**
+     * @brief 返回 io_uring ring 最终生效的 setup
+     * @return 非 io_uring 后端返回 active=false 的默认值
+     */
+    virtual IOUringSetupStats ioUringSetupStats() const noexcept
+    {
+        return {};
+    }
+
 protected:
     TimingWheelTimerManager m_timer_manager;
     std::span<IOScheduler* const> m_steal_domain_siblings{};
     size_t m_steal_domain_self_index = 0;
 };
 
-inline bool IOSchedulerWorkerState::trySteal() {
-    if (!stealing_enabled || hasLocalWork() || hasPendingInjected() || siblings.size() <= 1) {
+template <typename Sibling>
+inline bool IOSchedulerWorkerState::tryStealFrom(std::span<Sibling* const> domain) {
+    if (!stealing_enabled || hasLocalWork() || hasPendingInjected() || domain.size() <= 1) {
         return false;
     }
 
@@ -1062,84 +1168,118 @@ inline bool IOSchedulerWorkerState::trySteal() {
     }
 
     ++steal_attempts;
-    std::uniform_int_distribution<size_t> start_dist(0, siblings.size() - 1);
+    bool cross_node = false;
+    size_t stolen = stealFromDomain(domain, local_capacity, true);
+    if (stolen == 0 && numa_aware) {
+        // 跨节点窃取会把任务帧与其缓冲区拉到远端节点，只在同节点持续落空后才尝试。
+        if (++numa_same_node_misses <= numa_cross_node_backoff) {
+            return false;
+        }
+        numa_same_node_misses = 0;
+        stolen = stealFromDomain(domain, local_capacity, false);
+        cross_node = true;
+    }
+    if (stolen == 0) {
+        return false;
+    }
+
+    lifo_enabled = true;
+    consecutive_lifo_polls = 0;
+    polls_since_inject = 0;
+    numa_same_node_misses = 0;
+    ++steal_successes;
+    if (cross_node) {
+        ++cross_node_steals;
+    } else {
+        ++same_node_steals;
+    }
+    return true;
+}
+
+template <typename Sibling>
+inline size_t IOSchedulerWorkerState::stealFromDomain(std::span<Sibling* const> domain,
+                                                      size_t local_capacity,
+                                                      bool same_node) {
+    std::uniform_int_distribution<size_t> start_dist(0, domain.size() - 1);
     const size_t start = start_dist(random_seed);
 
-    for (size_t probe = 0; probe < siblings.size(); ++probe) {
-        const size_t victim_index = (start + probe) % siblings.size();
+    for (size_t probe = 0; probe < domain.size(); ++probe) {
+        const size_t victim_index = (start + probe) % domain.size();
         if (victim_index == self_index) {
             continue;
         }
 
-        IOScheduler* const victim_scheduler = siblings[victim_index];
+        Sibling* const victim_scheduler = domain[victim_index];
         if (victim_scheduler == nullptr) {
             continue;
         }
 
         IOSchedulerWorkerState* const victim = victim_scheduler->stealWorkerState();
-        if (victim == nullptr) {
+        if (victim == nullptr || (victim->numa_node == numa_node) != same_node) {
             continue;
         }
 
-        size_t stolen = 0;
-        const size_t victim_size = victim->local_ring.size();
-        if (victim_size > 0) {
-            const size_t steal_target =
-                std::min(local_capacity, std::max<size_t>(1, victim_size / 2));
-            for (; stolen < steal_target; ++stolen) {
-                detail::ReadyEntry entry;
-                if (!victim->stealFront(entry)) {
-                    break;
-                }
-                if (!local_ring.push_back(entry)) {
-                    if (!detail::scheduleReadyEntry(entry) && entry.isValid()) {
-                        victim->fallbackToInject(entry);
-                    }
-                    break;
-                }
+        const size_t stolen = stealFromVictim(*victim, local_capacity);
+        if (stolen > 0) {
+            return stolen;
+        }
+    }
+
+    return 0;
+}
+
+inline size_t IOSchedulerWorkerState::stealFromVictim(IOSchedulerWorkerState& victim,
+                                                      size_t local_capacity) {
+    size_t stolen = 0;
+    const size_t victim_size = victim.local_ring.size();
+    if (victim_size > 0) {
+        const size_t steal_target =
+            std::min(local_capacity, std::max<size_t>(1, victim_size / 2));
+        for (; stolen < steal_target; ++stolen) {
+            detail::ReadyEntry entry;
+            if (!victim.stealFront(entry)) {
+                break;
             }
-        } else if (victim->hasOwnerDrainedInjected() && victim->hasPendingInjected()) {
-            size_t attempts = 0;
-            while (stolen < local_capacity && attempts < local_capacity) {
-                ++attempts;
-                detail::ReadyEntry entry;
-                if (!victim->ready_inject_queue.try_dequeue(entry)) {
-                    break;
+            if (!local_ring.push_back(entry)) {
+                if (!detail::scheduleReadyEntry(entry) && entry.isValid()) {
+                    victim.fallbackToInject(entry);
                 }
-                victim->injected_outstanding.fetch_sub(1, std::memory_order_acq_rel);
-                if (!entry.isValid()) {
-                    continue;
-                }
-                if (detail::readyEntryResumeOwnerOnly(entry)) {
-                    if (!detail::scheduleReadyEntry(entry) && entry.isValid()) {
-                        victim->fallbackToInject(entry);
-                    }
-                    continue;
+                break;
+            }
+        }
+    } else if (victim.hasOwnerDrainedInjected() && victim.hasPendingInjected()) {
+        size_t attempts = 0;
+        while (stolen < local_capacity && attempts < local_capacity) {
+            ++attempts;
+            detail::ReadyEntry entry;
+            if (!victim.ready_inject_queue.try_dequeue(entry)) {
+                break;
+            }
+            victim.injected_outstanding.fetch_sub(1, std::memory_order_acq_rel);
+            if (!entry.isValid()) {
+                continue;
+            }
+            if (detail::readyEntryResumeOwnerOnly(entry)) {
+                if (!detail::scheduleReadyEntry(entry) && entry.isValid()) {
+                    victim.fallbackToInject(entry);
                 }
-                if (!local_ring.push_back(entry)) {
-                    if (!detail::scheduleReadyEntry(entry) && entry.isValid()) {
-                        victim->fallbackToInject(entry);
-                    }
-                    break;
+                continue;
+            }
+            if (!local_ring.push_back(entry)) {
+                if (!detail::scheduleReadyEntry(entry) && entry.isValid()) {
+                    victim.fallbackToInject(entry);
                 }
-                ++stolen;
+                break;
             }
-        }
-
-        if (stolen == 0) {
-            continue;
-        }
-
-        if (stolen > 0) {
-            lifo_enabled = true;
-            consecutive_lifo_polls = 0;
-            polls_since_inject = 0;
-            ++steal_successes;
-            return true;
+            ++stolen;
         }
     }
 
-    return false;
+    return stolen;
+}
+
+inline bool IOSchedulerWorkerState::trySteal() {
+    return tryStealFrom(siblings);
 }
 
 
@@ -1150,14 +1290,16 @@ inline bool IOController::fillAwaitable(IOEventType type, void* awaitable) {
         static_cast<uint32_t>(IOEventType::READV) |
         static_cast<uint32_t>(IOEventType::FILEREAD) |
         static_cast<uint32_t>(IOEventType::FILEWATCH) |
-        static_cast<uint32_t>(IOEventType::RECVFROM);
+        static_cast<uint32_t>(IOEventType::RECVFROM) |
+        static_cast<uint32_t>(IOEventType::SPLICEIN);
     constexpr uint32_t kWriteSlotMask =
         static_cast<uint32_t>(IOEventType::CONNECT) |
         static_cast<uint32_t>(IOEventType::SEND) |
         static_cast<uint32_t>(IOEventType::WRITEV) |
         static_cast<uint32_t>(IOEventType::SENDFILE) |
         static_cast<uint32_t>(IOEventType::FILEWRITE) |
-        static_cast<uint32_t>(IOEventType::SENDTO);
+        static_cast<uint32_t>(IOEventType::SENDTO) |
+        static_cast<uint32_t>(IOEventType::SPLICEOUT);
 
     switch (type) {
     case IOEventType::RECV:
@@ -1172,6 +1314,7 @@ inline bool IOController::fillAwaitable(IOEventType type, void* awaitable) {
     case IOEventType::READV:
     case IOEventType::FILEREAD:
     case IOEventType::FILEWATCH:
+    case IOEventType::SPLICEIN:
         m_type = static_cast<IOEventType>(
             (static_cast<uint32_t>(m_type) & ~kReadSlotMask) |
             static_cast<uint32_t>(type));
@@ -1211,6 +1354,7 @@ inline bool IOController::fillAwaitable(IOEventType type, void* awaitable) {
     case IOEventType::SEND:
     case IOEventType::WRITEV:
     case IOEventType::SENDFILE:
+    case IOEventType::SPLICEOUT:
     case IOEventType::FILEWRITE:
     case IOEventType::SENDTO:
     case IOEventType::CONNECT:
@@ -1240,6 +1384,7 @@ inline void IOController::removeAwaitable(IOEventType type) {
     case IOEventType::READV:
     case IOEventType::FILEREAD:
     case IOEventType::FILEWATCH:
+    case IOEventType::SPLICEIN:
         m_awaitable[READ] = nullptr;
 #ifdef USE_IOURING
         advanceSqeGeneration(READ);
@@ -1269,6 +1414,7 @@ inline void IOController::removeAwaitable(IOEventType type) {
     case IOEventType::SEND:
     case IOEventType::WRITEV:
     case IOEventType::SENDFILE:
+    case IOEventType::SPLICEOUT:
     case IOEventType::FILEWRITE:
     case IOEventType::SENDTO:
     case IOEventType::CONNECT:
@@ -28,10 +28,10 @@ inline bool sequenceMaskUsesSlot(uint8_t mask, IOController::Index slot) {
 inline uint8_t simpleEventMask(IOEventType type) {
     const uint32_t value = static_cast<uint32_t>(type);
     uint8_t mask = 0;
-    if ((value & (ACCEPT | RECV | READV | RECVFROM | FILEREAD)) != 0) {
+    if ((value & (ACCEPT | RECV | READV | RECVFROM | FILEREAD | SPLICEIN)) != 0) {
         mask = static_cast<uint8_t>(mask | detail::sequenceSlotMask(IOController::READ));
     }
-    if ((value & (CONNECT | SEND | WRITEV | SENDTO | FILEWRITE | SENDFILE)) != 0) {
+    if ((value & (CONNECT | SEND | WRITEV | SENDTO | FILEWRITE | SENDFILE | SPLICEOUT)) != 0) {
         mask = static_cast<uint8_t>(mask | detail::sequenceSlotMask(IOController::WRITE));
     }
     return mask;
@@ -417,6 +417,21 @@ int KqueueReactor::addSendFile(IOController* controller) {
     return kevent(m_kqueue_fd, &ev, 1, nullptr, 0, nullptr);
 }
 
+int KqueueReactor::addSpliceIn(IOController* controller) {
+    // kqueue 平台没有 splice：handleComplete 总是立即给出 ENOSYS，不需要登记事件
+    auto* awaitable = controller->getAwaitable<SpliceInAwaitable>();
+    if (awaitable == nullptr) return -1;
+    (void)awaitable->handleComplete(controller->m_handle);
+    return 1;
+}
+
+int KqueueReactor::addSpliceOut(IOController* controller) {
+    auto* awaitable = controller->getAwaitable<SpliceOutAwaitable>();
+    if (awaitable == nullptr) return -1;
+    (void)awaitable->handleComplete(controller->m_handle);
+    return 1;
+}
+
 int KqueueReactor::addSequence(IOController* controller) {
     if (controller == nullptr) {
         return -1;
@@ -588,6 +603,7 @@ void KqueueReactor::processEvent(struct kevent& ev) {
             if (awaitable) {
                 FileWatchResult result;
                 result.isDir = false;
+                result.wd = static_cast<int>(ev.ident);
 
                 uint32_t mask = 0;
                 if (ev.fflags & NOTE_WRITE) mask |= static_cast<uint32_t>(FileWatchEvent::Modify);
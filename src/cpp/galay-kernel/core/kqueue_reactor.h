@@ -59,6 +59,8 @@ public:
     int addSendTo(IOController* controller);  ///< 注册 sendto 等待；1=立即完成，0=已登记，<0=错误
     int addFileWatch(IOController* controller);  ///< 注册文件监控等待；1=立即完成，0=已登记，<0=错误
     int addSendFile(IOController* controller);  ///< 注册 sendfile 等待；1=立即完成，0=已登记，<0=错误
+    int addSpliceIn(IOController* controller);  ///< splice 不受支持，立即以 ENOSYS 完成
+    int addSpliceOut(IOController* controller); ///< splice 不受支持，立即以 ENOSYS 完成
     int addSequence(IOController* controller);  ///< 注册组合式序列等待；1=立即完成，0=已登记，<0=错误
     int remove(IOController* controller);  ///< 删除控制器相关的所有 kqueue 注册事件
 
@@ -68,6 +68,7 @@ std::expected<void, IOError> KqueueScheduler::start()
         m_threadId = std::this_thread::get_id();  // 设置调度器线程ID
         thread_ready.set_value();
         (void)applyConfiguredAffinity();
+        (void)applyConfiguredNumaPlacement();
         eventLoop();
     });
     ready.wait();
@@ -143,6 +144,16 @@ int KqueueScheduler::addSendFile(IOController* controller)
     return m_reactor.addSendFile(controller);
 }
 
+int KqueueScheduler::addSpliceIn(IOController* controller)
+{
+    return m_reactor.addSpliceIn(controller);
+}
+
+int KqueueScheduler::addSpliceOut(IOController* controller)
+{
+    return m_reactor.addSpliceOut(controller);
+}
+
 int KqueueScheduler::addSequence(IOController* controller)
 {
     return m_reactor.addSequence(controller);
@@ -84,6 +84,8 @@ public:
     int addSendTo(IOController* controller) override;     ///< 注册 sendto 等待；1=立即完成，0=已挂起，<0=错误
     int addFileWatch(IOController* controller) override;  ///< 注册文件监控等待；1=立即完成，0=已挂起，<0=错误
     int addSendFile(IOController* controller) override;   ///< 注册 sendfile 等待；1=立即完成，0=已挂起，<0=错误
+    int addSpliceIn(IOController* controller) override;   ///< splice 不受支持，立即以 ENOSYS 完成
+    int addSpliceOut(IOController* controller) override;  ///< splice 不受支持，立即以 ENOSYS 完成
     int addSequence(IOController* controller) override;   ///< 注册组合式序列 IO；1=立即完成，0=已挂起，<0=错误
 
     int remove(IOController* controller) override;        ///< 删除控制器关联的所有已注册事件；0=成功，<0=失败
@@ -0,0 +1,228 @@
+/**
+ * @file numa_topology.cc
+ * @brief NUMA 拓扑发现与内存策略实现
+ * @author galay-kernel
+ * @version 1.0.0
+ *
+ * @details sysfs 解析只依赖标准库；内存策略直接走 set_mempolicy/get_mempolicy
+ * 系统调用，不引入 libnuma。
+ */
+
+#include "numa_topology.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace galay::kernel
+{
+
+namespace
+{
+
+#if defined(__linux__)
+constexpr int kMpolDefault = 0;    ///< MPOL_DEFAULT
+constexpr int kMpolPreferred = 1;  ///< MPOL_PREFERRED
+constexpr size_t kMaskWords = 16;  ///< 与 NumaMemoryPolicyScope 的 nodemask 一致，覆盖 1024 个节点
+constexpr unsigned long kWordBits = sizeof(unsigned long) * 8;
+constexpr unsigned long kMaskBits = kMaskWords * kWordBits;
+
+long setMemPolicy(int mode, const unsigned long* mask, unsigned long max_node) noexcept
+{
+    return ::syscall(SYS_set_mempolicy, mode, mask, max_node);
+}
+
+long getMemPolicy(int* mode, unsigned long* mask, unsigned long max_node) noexcept
+{
+    return ::syscall(SYS_get_mempolicy, mode, mask, max_node, nullptr, 0UL);
+}
+#endif
+
+std::optional<uint32_t> parseNodeId(std::string_view name)
+{
+    constexpr std::string_view kPrefix = "node";
+    if (name.size() <= kPrefix.size() || name.substr(0, kPrefix.size()) != kPrefix) {
+        return std::nullopt;
+    }
+    uint32_t id = 0;
+    const char* begin = name.data() + kPrefix.size();
+    const char* end = name.data() + name.size();
+    const auto [ptr, ec] = std::from_chars(begin, end, id);
+    if (ec != std::errc{} || ptr != end) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+} // namespace
+
+NumaTopology::NumaTopology(std::vector<NumaNode> nodes)
+    : m_nodes(std::move(nodes))
+{
+    std::erase_if(m_nodes, [](const NumaNode& node) { return node.cpus.empty(); });
+    std::sort(m_nodes.begin(), m_nodes.end(),
+              [](const NumaNode& lhs, const NumaNode& rhs) { return lhs.id < rhs.id; });
+}
+
+NumaTopology NumaTopology::discover(std::string_view sysfs_root)
+{
+    std::error_code ec;
+    const std::filesystem::path root(sysfs_root);
+    std::vector<NumaNode> nodes;
+    for (const auto& entry : std::filesystem::directory_iterator(root, ec)) {
+        const auto id = parseNodeId(entry.path().filename().string());
+        if (!id) {
+            continue;
+        }
+        std::ifstream input(entry.path() / "cpulist");
+        std::string line;
+        if (!input.is_open() || !std::getline(input, line)) {
+            continue;
+        }
+        nodes.push_back(NumaNode{.id = *id, .cpus = parseCpuList(line)});
+    }
+    return NumaTopology(std::move(nodes));
+}
+
+NumaTopology NumaTopology::current(uint32_t cpu_count)
+{
+    NumaTopology topology = discover();
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (!topology.empty() && ::sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        std::vector<NumaNode> usable;
+        for (auto node : topology.m_nodes) {
+            std::erase_if(node.cpus, [&allowed](uint32_t cpu) {
+                return cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed);
+            });
+            usable.push_back(std::move(node));
+        }
+        topology = NumaTopology(std::move(usable));
+    }
+#endif
+    if (topology.empty()) {
+        return singleNode(cpu_count);
+    }
+    return topology;
+}
+
+NumaTopology NumaTopology::singleNode(uint32_t cpu_count)
+{
+    NumaNode node;
+    node.cpus.reserve(std::max<uint32_t>(1, cpu_count));
+    for (uint32_t cpu = 0; cpu < std::max<uint32_t>(1, cpu_count); ++cpu) {
+        node.cpus.push_back(cpu);
+    }
+    return NumaTopology({std::move(node)});
+}
+
+std::vector<uint32_t> NumaTopology::parseCpuList(std::string_view text)
+{
+    std::vector<uint32_t> cpus;
+    while (!text.empty()) {
+        const size_t comma = text.find(',');
+        std::string_view range = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+
+        while (!range.empty() && (range.back() == '\n' || range.back() == ' ')) {
+            range.remove_suffix(1);
+        }
+        while (!range.empty() && range.front() == ' ') {
+            range.remove_prefix(1);
+        }
+        if (range.empty()) {
+            continue;
+        }
+
+        const size_t dash = range.find('-');
+        const std::string_view first_text = range.substr(0, dash);
+        const std::string_view last_text =
+            dash == std::string_view::npos ? first_text : range.substr(dash + 1);
+        uint32_t first = 0;
+        uint32_t last = 0;
+        const auto first_parsed =
+            std::from_chars(first_text.data(), first_text.data() + first_text.size(), first);
+        const auto last_parsed =
+            std::from_chars(last_text.data(), last_text.data() + last_text.size(), last);
+        if (first_parsed.ec != std::errc{} || first_parsed.ptr != first_text.data() + first_text.size() ||
+            last_parsed.ec != std::errc{} || last_parsed.ptr != last_text.data() + last_text.size() ||
+            last < first) {
+            continue;
+        }
+        for (uint32_t cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::optional<uint32_t> NumaTopology::nodeOfCpu(uint32_t cpu) const noexcept
+{
+    for (const auto& node : m_nodes) {
+        if (std::binary_search(node.cpus.begin(), node.cpus.end(), cpu)) {
+            return node.id;
+        }
+    }
+    return std::nullopt;
+}
+
+namespace detail
+{
+
+bool preferNumaNode(uint32_t node) noexcept
+{
+#if defined(__linux__)
+    if (node >= kMaskBits) {
+        return false;
+    }
+    std::array<unsigned long, kMaskWords> mask{};
+    mask[node / kWordBits] = 1UL << (node % kWordBits);
+    return setMemPolicy(kMpolPreferred, mask.data(), kMaskBits) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+NumaMemoryPolicyScope::NumaMemoryPolicyScope(std::optional<uint32_t> node) noexcept
+{
+#if defined(__linux__)
+    if (!node.has_value()) {
+        return;
+    }
+    if (getMemPolicy(&m_previous_mode, m_previous_mask.data(), kMaskBits) != 0) {
+        return;
+    }
+    m_active = preferNumaNode(*node);
+#else
+    (void)node;
+#endif
+}
+
+NumaMemoryPolicyScope::~NumaMemoryPolicyScope()
+{
+#if defined(__linux__)
+    if (!m_active) {
+        return;
+    }
+    if (setMemPolicy(m_previous_mode, m_previous_mask.data(), kMaskBits) != 0) {
+        (void)setMemPolicy(kMpolDefault, nullptr, 0);
+    }
+#endif
+}
+
+} // namespace detail
+
+} // namespace galay::kernel
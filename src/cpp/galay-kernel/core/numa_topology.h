@@ -0,0 +1,115 @@
+/**
+ * @file numa_topology.h
+ * @brief NUMA 拓扑发现与线程内存放置
+ * @author galay-kernel
+ * @version 1.0.0
+ *
+ * @details 定义 NumaTopology（从 sysfs `/sys/devices/system/node` 读取节点与 CPU 列表）
+ * 以及 detail::NumaMemoryPolicyScope / detail::preferNumaNode（通过 set_mempolicy
+ * 让当前线程的新分配优先落在指定节点）。
+ *
+ * Runtime 的 `RuntimeAffinityConfig::Mode::Numa` 用它把 scheduler 按节点分组绑核，
+ * 并让 reactor 缓冲池、TaskState free list 在所属节点上首次触碰。
+ * 非 Linux 平台或 sysfs 不可读时退化为单节点，内存策略为空操作。
+ */
+
+#ifndef GALAY_KERNEL_NUMA_TOPOLOGY_H
+#define GALAY_KERNEL_NUMA_TOPOLOGY_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace galay::kernel
+{
+
+/**
+ * @brief 单个 NUMA 节点
+ */
+struct NumaNode {
+    uint32_t id = 0;  ///< sysfs 节点编号（nodeN 中的 N）
+    std::vector<uint32_t> cpus;  ///< 该节点上可用的 CPU 编号，升序
+};
+
+/**
+ * @brief 机器的 NUMA 拓扑快照
+ * @details 只描述带 CPU 的节点；纯内存节点（CXL、HBM 等）不参与 scheduler 放置。
+ */
+class NumaTopology
+{
+public:
+    NumaTopology() = default;
+    explicit NumaTopology(std::vector<NumaNode> nodes);  ///< 用给定节点构造；丢弃空节点并按 id 排序
+
+    /**
+     * @brief 从 sysfs 读取拓扑
+     * @param sysfs_root 节点目录，默认 `/sys/devices/system/node`
+     * @return 读取到的节点；目录不存在或没有带 CPU 的节点时返回空拓扑
+     */
+    static NumaTopology discover(std::string_view sysfs_root = "/sys/devices/system/node");
+
+    /**
+     * @brief 发现当前进程可用的拓扑
+     * @details discover() 后与 sched_getaffinity 求交，剔除 cgroup/taskset 不允许的 CPU；
+     *          结果为空时退化为 cpu_count 个 CPU 的单节点。
+     */
+    static NumaTopology current(uint32_t cpu_count);
+
+    static NumaTopology singleNode(uint32_t cpu_count);  ///< 构造 0..cpu_count-1 的单节点拓扑
+
+    /**
+     * @brief 解析 sysfs cpulist 格式，如 `0-3,8,10-11`
+     * @return 升序去重后的 CPU 列表；格式错误的片段被忽略
+     */
+    static std::vector<uint32_t> parseCpuList(std::string_view text);
+
+    const std::vector<NumaNode>& nodes() const noexcept { return m_nodes; }  ///< 带 CPU 的节点，按 id 升序
+    size_t nodeCount() const noexcept { return m_nodes.size(); }  ///< 节点数
+    bool empty() const noexcept { return m_nodes.empty(); }  ///< 是否没有任何节点
+    std::optional<uint32_t> nodeOfCpu(uint32_t cpu) const noexcept;  ///< 返回 CPU 所属节点；未知时返回 std::nullopt
+
+private:
+    std::vector<NumaNode> m_nodes;
+};
+
+namespace detail
+{
+
+/**
+ * @brief 让当前线程之后的新分配优先落在 node（MPOL_PREFERRED）
+ * @return 设置成功返回 true；非 Linux 或内核拒绝时返回 false
+ * @note 只影响调用线程，适合在 scheduler 线程绑核后调用一次。
+ */
+bool preferNumaNode(uint32_t node) noexcept;
+
+/**
+ * @brief 作用域内临时把当前线程的内存策略切到 node，析构时恢复原策略
+ * @details 用于 scheduler 在启动线程上初始化 reactor 缓冲池：这些页在构造时即被触碰，
+ *          需要落在 scheduler 所属节点而不是调用 Runtime::start() 的线程所在节点。
+ */
+class NumaMemoryPolicyScope
+{
+public:
+    explicit NumaMemoryPolicyScope(std::optional<uint32_t> node) noexcept;  ///< node 为空时不做任何事
+    ~NumaMemoryPolicyScope();
+
+    NumaMemoryPolicyScope(const NumaMemoryPolicyScope&) = delete;
+    NumaMemoryPolicyScope& operator=(const NumaMemoryPolicyScope&) = delete;
+
+    bool active() const noexcept { return m_active; }  ///< 内存策略是否已切换
+
+private:
+    static constexpr size_t kMaskWords = 16;  ///< 支持 1024 个节点的 nodemask
+
+    std::array<unsigned long, kMaskWords> m_previous_mask{};  ///< 进入作用域前的 nodemask
+    int m_previous_mode = 0;  ///< 进入作用域前的 mempolicy 模式
+    bool m_active = false;  ///< 是否需要在析构时恢复
+};
+
+} // namespace detail
+
+} // namespace galay::kernel
+
+#endif // GALAY_KERNEL_NUMA_TOPOLOGY_H
@@ -0,0 +1,133 @@
+/**
+ * @file registered_buffer.h
+ * @brief 文件 IO 使用的 move-only 缓冲切片
+ * @author galay-kernel
+ * @version 1.0.0
+ *
+ * @details RegisteredBuffer 要么是从 io_uring 注册缓冲池租借的槽位（READ_FIXED/WRITE_FIXED
+ * 可直接使用，内核无需每次 pin/unpin 页面），要么是池不可用时的堆内存回退。两种形态对调用方
+ * 暴露同样的 data()/size()/capacity() 视图，析构时自动归还槽位或释放内存。
+ */
+
+#ifndef GALAY_KERNEL_REGISTERED_BUFFER_H
+#define GALAY_KERNEL_REGISTERED_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace galay::kernel
+{
+
+/**
+ * @brief 文件 IO 缓冲切片；注册缓冲池槽位或堆内存回退
+ *
+ * @note
+ * - 仅可移动；槽位在析构、release() 或被移动覆盖时归还所属池
+ * - 槽位索引只对租借它的 ring 有效；交给其它 scheduler 的 AsyncFile 时自动退回普通读写
+ */
+class RegisteredBuffer
+{
+public:
+    using RecycleFn = void (*)(const std::shared_ptr<void>&, uint32_t) noexcept;
+
+    RegisteredBuffer() = default;
+
+    /**
+     * @brief 构造指向注册缓冲池槽位的切片（供后端调用）
+     * @param owner 缓冲池所有者；持有它保证底层内存在切片存活期间有效
+     * @param recycle 归还槽位的回调
+     * @param data 槽位起始地址
+     * @param capacity 槽位容量
+     * @param index 注册时的缓冲区索引
+     */
+    RegisteredBuffer(std::shared_ptr<void> owner,
+                     RecycleFn recycle,
+                     char* data,
+                     size_t capacity,
+                     uint32_t index) noexcept
+        : m_owner(std::move(owner))
+        , m_recycle(recycle)
+        , m_data(data)
+        , m_capacity(capacity)
+        , m_index(static_cast<int32_t>(index)) {
+    }
+
+    ~RegisteredBuffer() { release(); }
+
+    RegisteredBuffer(const RegisteredBuffer&) = delete;
+    RegisteredBuffer& operator=(const RegisteredBuffer&) = delete;
+
+    RegisteredBuffer(RegisteredBuffer&& other) noexcept { moveFrom(other); }
+
+    RegisteredBuffer& operator=(RegisteredBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 分配不属于任何注册池的堆切片，作为注册池不可用时的回退
+     * @param capacity 切片容量（字节）
+     */
+    static RegisteredBuffer heap(size_t capacity) {
+        RegisteredBuffer buffer;
+        buffer.m_heap = std::make_unique<char[]>(capacity);
+        buffer.m_data = buffer.m_heap.get();
+        buffer.m_capacity = capacity;
+        return buffer;
+    }
+
+    char* data() noexcept { return m_data; }
+    const char* data() const noexcept { return m_data; }
+    size_t capacity() const noexcept { return m_capacity; }  ///< 切片可容纳的最大字节数
+    size_t size() const noexcept { return m_size; }  ///< 当前有效数据长度
+    void resize(size_t size) noexcept { m_size = std::min(size, m_capacity); }  ///< 设置有效长度，超出容量时截断
+    bool valid() const noexcept { return m_data != nullptr; }  ///< 是否持有可用内存
+    bool registered() const noexcept { return m_index >= 0; }  ///< 是否为注册缓冲池槽位
+    int32_t index() const noexcept { return m_index; }  ///< 注册缓冲区索引；堆切片为 -1
+    const void* owner() const noexcept { return m_owner.get(); }  ///< 所属缓冲池标识，用于校验 ring 归属
+
+    /**
+     * @brief 归还槽位或释放堆内存，切片变为无效
+     */
+    void release() noexcept {
+        if (m_owner && m_recycle != nullptr && m_index >= 0) {
+            m_recycle(m_owner, static_cast<uint32_t>(m_index));
+        }
+        m_owner.reset();
+        m_recycle = nullptr;
+        m_heap.reset();
+        m_data = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_index = -1;
+    }
+
+private:
+    void moveFrom(RegisteredBuffer& other) noexcept {
+        m_owner = std::move(other.m_owner);
+        m_recycle = std::exchange(other.m_recycle, nullptr);
+        m_heap = std::move(other.m_heap);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_size = std::exchange(other.m_size, 0);
+        m_index = std::exchange(other.m_index, -1);
+    }
+
+    std::shared_ptr<void> m_owner;  ///< 注册缓冲池所有者；堆切片为空
+    RecycleFn m_recycle = nullptr;  ///< 归还槽位的回调
+    std::unique_ptr<char[]> m_heap;  ///< 堆回退时持有的内存
+    char* m_data = nullptr;  ///< 切片起始地址
+    size_t m_capacity = 0;  ///< 切片容量
+    size_t m_size = 0;  ///< 有效数据长度
+    int32_t m_index = -1;  ///< 注册缓冲区索引；-1 表示非注册内存
+};
+
+} // namespace galay::kernel
+
+#endif // GALAY_KERNEL_REGISTERED_BUFFER_H
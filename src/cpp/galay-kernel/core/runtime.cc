@@ -4,12 +4,13 @@
  * @author galay-kernel
  * @version 1.0.0
  *
- * @details 实现 Runtime 生命周期管理、默认调度器创建、亲和性配置、
+ * @details 实现 Runtime 生命周期管理、默认调度器创建、亲和性与 NUMA 放置、
  * 工作窃取域设置以及线程局部 RuntimeHandle 访问器。
  */
 
 #include "runtime.h"
 #include "timer_scheduler.h"
+#include <algorithm>
 #include <span>
 #include <thread>
 
@@ -70,6 +71,7 @@ std::expected<void, RuntimeError> Runtime::start()
 
     applyAffinityConfig();
     configureIOSchedulerStealDomains();
+    configureComputeSchedulerStealDomains();
 
     TimerScheduler::getInstance()->start();
     for (auto& scheduler : m_io_schedulers) {
@@ -114,9 +116,56 @@ RuntimeStats Runtime::stats() const
 {
     RuntimeStats snapshot;
     snapshot.io_schedulers.reserve(m_io_schedulers.size());
+    snapshot.io_uring_setups.reserve(m_io_schedulers.size());
     for (const auto& scheduler : m_io_schedulers) {
         snapshot.io_schedulers.push_back(
             scheduler ? scheduler->stealStats() : IOSchedulerStealStats{});
+        snapshot.io_uring_setups.push_back(
+            scheduler ? scheduler->ioUringSetupStats() : IOUringSetupStats{});
+    }
+    snapshot.compute_schedulers.reserve(m_compute_schedulers.size());
+    for (const auto& scheduler : m_compute_schedulers) {
+        snapshot.compute_schedulers.push_back(
+            scheduler ? scheduler->stealStats() : IOSchedulerStealStats{});
+    }
+    snapshot.task_frames = taskFramePoolStats();
+
+    if (m_config.affinity.mode != RuntimeAffinityConfig::Mode::Numa) {
+        return snapshot;
+    }
+    snapshot.numa_nodes.reserve(m_numa_topology.nodeCount());
+    for (const auto& node : m_numa_topology.nodes()) {
+        snapshot.numa_nodes.push_back(RuntimeNumaNodeStats{.node = node.id});
+    }
+    auto accumulate = [&snapshot](const Scheduler* scheduler,
+                                  const IOSchedulerStealStats& steals,
+                                  size_t RuntimeNumaNodeStats::*counter) {
+        if (scheduler == nullptr) {
+            return;
+        }
+        const auto node = scheduler->numaNode();
+        if (!node) {
+            return;
+        }
+        const uint32_t node_id = *node;
+        auto it = std::find_if(snapshot.numa_nodes.begin(), snapshot.numa_nodes.end(),
+                               [node_id](const RuntimeNumaNodeStats& entry) {
+                                   return entry.node == node_id;
+                               });
+        if (it == snapshot.numa_nodes.end()) {
+            return;
+        }
+        ++((*it).*counter);
+        it->steal_attempts += steals.steal_attempts;
+        it->same_node_steals += steals.same_node_steals;
+        it->cross_node_steals += steals.cross_node_steals;
+    };
+    for (size_t i = 0; i < m_io_schedulers.size(); ++i) {
+        accumulate(m_io_schedulers[i].get(), snapshot.io_schedulers[i], &RuntimeNumaNodeStats::io_schedulers);
+    }
+    for (size_t i = 0; i < m_compute_schedulers.size(); ++i) {
+        accumulate(m_compute_schedulers[i].get(), snapshot.compute_schedulers[i],
+                   &RuntimeNumaNodeStats::compute_schedulers);
     }
     return snapshot;
 }
@@ -219,8 +268,20 @@ void Runtime::createDefaultSchedulers()
         ? cpu
         : m_config.compute_scheduler_count;
 
+#if defined(USE_IOURING)
+    if (m_config.io_uring.setup_mode == IOUringSetupMode::kSharedSqpoll &&
+        !m_config.io_uring.sqpoll_group) {
+        // 每个 Runtime 的默认 ring 共享同一个 SQPOLL 线程。
+        m_config.io_uring.sqpoll_group = std::make_shared<IOUringSqpollGroup>();
+    }
+#endif
     for (size_t i = 0; i < ioCount; ++i) {
+#if defined(USE_IOURING)
+        m_io_schedulers.push_back(std::make_unique<DefaultIOScheduler>(
+            GALAY_SCHEDULER_QUEUE_DEPTH, GALAY_SCHEDULER_BATCH_SIZE, m_config.io_uring));
+#else
         m_io_schedulers.push_back(std::make_unique<DefaultIOScheduler>());
+#endif
     }
     for (size_t i = 0; i < computeCount; ++i) {
         m_compute_schedulers.push_back(std::make_unique<ComputeScheduler>());
@@ -234,6 +295,11 @@ void Runtime::applyAffinityConfig()
         return;
     }
 
+    if (affinity.mode == RuntimeAffinityConfig::Mode::Numa) {
+        placeSchedulersOnNumaNodes();
+        return;
+    }
+
     const uint32_t cpuCount = static_cast<uint32_t>(getCPUCount());
 
     if (affinity.mode == RuntimeAffinityConfig::Mode::Sequential) {
@@ -263,6 +329,53 @@ void Runtime::applyAffinityConfig()
     }
 }
 
+void Runtime::placeSchedulersOnNumaNodes()
+{
+    m_numa_topology = NumaTopology::current(static_cast<uint32_t>(getCPUCount()));
+    const auto& nodes = m_numa_topology.nodes();
+    const uint32_t backoff = m_config.affinity.numa_cross_node_backoff;
+
+    // IO 与 compute 共用节点内游标：先占满不同 CPU，scheduler 多于 CPU 时才在节点内回绕。
+    std::vector<size_t> next_cpu(nodes.size(), 0);
+    auto place = [&](Scheduler& scheduler, size_t ordinal) -> uint32_t {
+        const size_t slot = ordinal % nodes.size();
+        const NumaNode& node = nodes[slot];
+        (void)scheduler.setAffinity(node.cpus[next_cpu[slot]++ % node.cpus.size()]);
+        scheduler.setNumaNode(node.id);
+        return node.id;
+    };
+
+    for (size_t i = 0; i < m_io_schedulers.size(); ++i) {
+        const uint32_t node = place(*m_io_schedulers[i], i);
+        if (auto* worker = m_io_schedulers[i]->stealWorkerState()) {
+            worker->configureNumaStealing(node, backoff);
+        }
+    }
+    for (size_t i = 0; i < m_compute_schedulers.size(); ++i) {
+        const uint32_t node = place(*m_compute_schedulers[i], i);
+        m_compute_schedulers[i]->stealWorkerState()->configureNumaStealing(node, backoff);
+    }
+}
+
+void Runtime::configureComputeSchedulerStealDomains()
+{
+    if (!m_config.compute_work_stealing) {
+        return;
+    }
+
+    m_compute_scheduler_sibling_view.clear();
+    m_compute_scheduler_sibling_view.reserve(m_compute_schedulers.size());
+    for (auto& scheduler : m_compute_schedulers) {
+        m_compute_scheduler_sibling_view.push_back(scheduler.get());
+    }
+
+    const std::span<ComputeScheduler* const> siblings{
+        m_compute_scheduler_sibling_view.data(), m_compute_scheduler_sibling_view.size()};
+    for (size_t index = 0; index < siblings.size(); ++index) {
+        siblings[index]->configureStealDomain(siblings, index);
+    }
+}
+
 void Runtime::configureIOSchedulerStealDomains()
 {
     const size_t io_count = m_io_schedulers.size();
@@ -8,7 +8,7 @@
  * RuntimeConfig（构造参数）和 RuntimeBuilder（流式配置 API）。
  *
  * Runtime 持有 IO 调度器、compute 调度器和阻塞执行器，
- * 支持 IO 调度器间的工作窃取和 CPU 亲和性绑定。
+ * 支持 IO 调度器间的工作窃取、CPU 亲和性绑定与 NUMA 感知放置。
  */
 
 #ifndef GALAY_KERNEL_RUNTIME_H
@@ -18,6 +18,8 @@
 #include "task.h"
 #include "compute_scheduler.h"
 #include "io_scheduler.hpp"
+#include "numa_topology.h"
+#include "uring_options.h"
 #include <array>
 #include <atomic>
 #include <cstdint>
@@ -44,13 +46,16 @@ namespace galay::kernel
  * - `Mode::None` 表示不主动绑核
  * - `Mode::Sequential` 按 0..N-1 顺序分配 CPU
  * - `Mode::Custom` 要求调用方提供与 scheduler 数量完全一致的 CPU 列表
+ * - `Mode::Numa` 从 sysfs 发现 NUMA 拓扑，IO / compute scheduler 按节点轮流放置并绑到节点内 CPU；
+ *   缓冲池与 TaskState free list 在所属节点首次触碰，stealing 优先同节点 victim
  */
 struct RuntimeAffinityConfig {
     std::vector<uint32_t> custom_io_cpus;  ///< Custom 模式下 IO scheduler 的目标 CPU 列表
     std::vector<uint32_t> custom_compute_cpus;  ///< Custom 模式下 compute scheduler 的目标 CPU 列表
     size_t seq_io_count = 0;  ///< Sequential 模式下参与分配的 IO scheduler 数
     size_t seq_compute_count = 0;  ///< Sequential 模式下参与分配的 compute scheduler 数
-    enum class Mode { None, Sequential, Custom } mode = Mode::None;  ///< 绑核分配模式
+    uint32_t numa_cross_node_backoff = 4;  ///< Numa 模式下连续多少轮同节点窃取落空后才探测跨节点 victim
+    enum class Mode { None, Sequential, Custom, Numa } mode = Mode::None;  ///< 绑核分配模式
 };
 
 /**
@@ -63,14 +68,33 @@ struct RuntimeConfig {
     size_t io_scheduler_count = GALAY_RUNTIME_SCHEDULER_COUNT_AUTO;  ///< IO scheduler 数；AUTO 表示按 CPU 自动推导
     size_t compute_scheduler_count = GALAY_RUNTIME_SCHEDULER_COUNT_AUTO;  ///< compute scheduler 数；AUTO 表示按 CPU 自动推导
     RuntimeAffinityConfig affinity;  ///< Runtime 的绑核策略
+    bool compute_work_stealing = false;  ///< compute scheduler 是否组成 work-stealing 池
+    IOUringOptions io_uring;  ///< io_uring 后端可选特性；其它后端忽略
+};
+
+/**
+ * @brief 单个 NUMA 节点上的 scheduler 分布与窃取汇总
+ * @details 窃取计数按窃取方（thief）所在节点累加。
+ */
+struct RuntimeNumaNodeStats {
+    uint32_t node = 0;  ///< NUMA 节点编号
+    size_t io_schedulers = 0;  ///< 放置在该节点的 IO scheduler 数
+    size_t compute_schedulers = 0;  ///< 放置在该节点的 compute scheduler 数
+    uint64_t steal_attempts = 0;  ///< 该节点 scheduler 的窃取尝试次数
+    uint64_t same_node_steals = 0;  ///< 从本节点 victim 窃取成功的次数
+    uint64_t cross_node_steals = 0;  ///< 从其它节点 victim 窃取成功的次数
 };
 
 /**
  * @brief Runtime 级别的调度统计快照
- * @details 当前只暴露 IO scheduler 的 work-stealing 计数。
+ * @details 暴露 IO / compute scheduler 的 work-stealing 计数、NUMA 节点汇总与 io_uring ring 最终生效的 setup。
  */
 struct RuntimeStats {
     std::vector<IOSchedulerStealStats> io_schedulers;  ///< 与 getIOScheduler(i) 对齐的 stealing 统计
+    std::vector<IOSchedulerStealStats> compute_schedulers;  ///< 与 getComputeScheduler(i) 对齐的 stealing 统计；未开启池模式时为 0
+    std::vector<IOUringSetupStats> io_uring_setups;  ///< 与 getIOScheduler(i) 对齐的 ring setup；非 io_uring 后端 active=false
+    std::vector<RuntimeNumaNodeStats> numa_nodes;  ///< 按节点编号升序的汇总；非 Numa 模式为空
+    TaskFramePoolStats task_frames;  ///< 进程级协程帧池计数，等同 taskFramePoolStats()
 };
 
 /**
@@ -275,6 +299,7 @@ public:
      */
     RuntimeHandle handle() noexcept;
     RuntimeStats stats() const;  ///< 返回 Runtime 管理的 scheduler 统计；应在 stop() 后或外部同步下调用
+    const NumaTopology& numaTopology() const noexcept { return m_numa_topology; }  ///< Numa 模式下启动时发现的拓扑；其它模式为空
 
     bool isRunning() const { return m_running.load(std::memory_order_acquire); }  ///< Runtime 当前是否已启动
     size_t getIOSchedulerCount() const { return m_io_schedulers.size(); }  ///< 返回当前受管 IO scheduler 数量
@@ -288,6 +313,7 @@ public:
 private:
     void createDefaultSchedulers();  ///< 按配置或 CPU 数生成默认 scheduler 集合
     void applyAffinityConfig();  ///< 把 RuntimeAffinityConfig 应用到所有已注册 scheduler
+    void placeSchedulersOnNumaNodes();  ///< Numa 模式：按节点轮流放置 scheduler 并配置同节点优先窃取
     std::expected<void, RuntimeError> ensureStarted();  ///< 若 Runtime 尚未启动则触发一次启动
     std::expected<Scheduler*, RuntimeError> acquireDefaultScheduler();  ///< 为根任务选出一个默认调度器
     void bindTaskToRuntime(const TaskRef& task, Scheduler* scheduler);  ///< 给根任务绑定 Runtime 与目标调度器
@@ -295,17 +321,20 @@ private:
     static size_t getCPUCount();  ///< 返回当前机器可用 CPU 数量
     static RuntimeError mapTaskResultError(const detail::TaskResultError& error) noexcept;  ///< 把任务消费错误映射为 RuntimeError
     void configureIOSchedulerStealDomains();  ///< 为 Runtime 管理的 IO scheduler 下发 steal-domain 配置
+    void configureComputeSchedulerStealDomains();  ///< 按配置把 compute scheduler 组成 work-stealing 池
 
     std::vector<std::unique_ptr<IOScheduler>> m_io_schedulers;  ///< Runtime 持有的 IO scheduler 集合
     std::vector<std::unique_ptr<ComputeScheduler>> m_compute_schedulers;  ///< Runtime 持有的 compute scheduler 集合
 
     std::vector<IOScheduler*> m_io_scheduler_sibling_view;  ///< Runtime 管理的 IO scheduler pointer view
+    std::vector<ComputeScheduler*> m_compute_scheduler_sibling_view;  ///< Runtime 管理的 compute scheduler pointer view
 
     std::atomic<uint32_t> m_io_index{0};  ///< IO scheduler 轮询游标
     std::atomic<uint32_t> m_compute_index{0};  ///< compute scheduler 轮询游标
 
     BlockingExecutor m_blockingExecutor;  ///< 阻塞任务线程池
     RuntimeConfig m_config;  ///< Runtime 启动和绑核配置
+    NumaTopology m_numa_topology;  ///< Numa 模式下发现的拓扑
     std::atomic<bool> m_running{false};  ///< Runtime 是否已经启动
 };
 
@@ -418,6 +447,19 @@ public:
         return true;
     }
 
+    /**
+     * @brief 按 NUMA 拓扑放置 scheduler。
+     * @param crossNodeBackoff 连续多少轮同节点窃取落空后才探测一次跨节点 victim
+     * @details 第 i 个 IO / compute scheduler 放到第 `i % 节点数` 个节点，绑到节点内尚未占用的 CPU；
+     *          节点汇总见 `RuntimeStats::numa_nodes`。拓扑不可读时退化为单节点。
+     */
+    RuntimeBuilder& numaAffinity(uint32_t crossNodeBackoff = 4)
+    {
+        m_config.affinity.mode = RuntimeAffinityConfig::Mode::Numa;
+        m_config.affinity.numa_cross_node_backoff = crossNodeBackoff;
+        return *this;
+    }
+
     /**
      * @brief 直接覆盖完整 affinity 配置。
      */
@@ -427,6 +469,70 @@ public:
         return *this;
     }
 
+    /**
+     * @brief 让 compute scheduler 组成 work-stealing 池（默认关闭）。
+     * @details 开启后空闲 compute 线程会从积压的 sibling 窃取任务，适合负载倾斜的提交模式；
+     *          窃取计数见 `RuntimeStats::compute_schedulers`。
+     */
+    RuntimeBuilder& computeWorkStealing(bool enabled)
+    {
+        m_config.compute_work_stealing = enabled;
+        return *this;
+    }
+
+    /**
+     * @brief 为每个 io_uring scheduler 开启 fixed-file 提交，`slots` 为每个 ring 的表容量。
+     * @details 传 0 关闭；非 io_uring 后端忽略该配置。
+     */
+    RuntimeBuilder& ioUringFixedFiles(uint32_t slots)
+    {
+        m_config.io_uring.fixed_file_slots = slots;
+        return *this;
+    }
+
+    /**
+     * @brief 为每个 io_uring scheduler 注册 `count` 个 `size` 字节的文件 IO 缓冲区。
+     * @details AsyncFile::leaseBuffer() 从中租借切片并以 READ_FIXED/WRITE_FIXED 提交；
+     *          传 0 关闭，非 io_uring 后端忽略该配置。
+     */
+    RuntimeBuilder& ioUringRegisteredBuffers(uint32_t count, size_t size = 64 * 1024)
+    {
+        m_config.io_uring.registered_buffer_count = count;
+        m_config.io_uring.registered_buffer_size = size;
+        return *this;
+    }
+
+    /**
+     * @brief 开关 io_uring 上一次性 IO `.timeout()` 的内核 LINK_TIMEOUT 路径（默认开启）。
+     * @details 关闭后所有超时统一进入时间轮；非 io_uring 后端忽略该配置。
+     */
+    RuntimeBuilder& ioUringLinkedTimeouts(bool enabled)
+    {
+        m_config.io_uring.linked_timeouts = enabled;
+        return *this;
+    }
+
+    /**
+     * @brief 选择 io_uring ring 的 setup 策略。
+     * @details `kSingleIssuer` 使用 SINGLE_ISSUER | DEFER_TASKRUN；`kSharedSqpoll` 让同一 Runtime
+     *          的 ring 共享一个 SQPOLL 线程。内核不支持时逐级回退，结果见 `RuntimeStats::io_uring_setups`。
+     */
+    RuntimeBuilder& ioUringSetupMode(IOUringSetupMode mode)
+    {
+        m_config.io_uring.setup_mode = mode;
+        return *this;
+    }
+
+    /**
+     * @brief 把 SQPOLL 线程绑定到 `cpu`（`IORING_SETUP_SQ_AFF`）；传 -1 取消绑定。
+     * @details 只对 `kDefault` / `kSharedSqpoll` 生效；共享模式下由第一个 ring 决定绑定。
+     */
+    RuntimeBuilder& ioUringSqThreadCpu(int32_t cpu)
+    {
+        m_config.io_uring.sq_thread_cpu = cpu;
+        return *this;
+    }
+
     /**
      * @brief 按当前 builder 配置构造 `Runtime`。
      */
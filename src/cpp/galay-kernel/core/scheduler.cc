@@ -5,11 +5,13 @@
  * @version 1.0.0
  *
  * @details 实现 setAffinity()（存储目标 CPU）和 applyConfiguredAffinity()
- * （在 Linux 上通过 pthread_setaffinity_np 应用）。
+ * （在 Linux 上通过 pthread_setaffinity_np 应用），以及 setNumaNode() /
+ * applyConfiguredNumaPlacement()（线程内存策略 + TaskState free list 预热）。
  * 非 Linux 平台回退为空操作或不支持。
  */
 
 #include "scheduler.hpp"
+#include "numa_topology.h"
 
 #include <cstddef>
 
@@ -105,4 +107,36 @@ bool Scheduler::applyConfiguredAffinity()
 #endif
 }
 
+void Scheduler::setNumaNode(std::optional<uint32_t> node) noexcept
+{
+    m_numa_node.store(node.has_value() ? static_cast<int32_t>(*node) : kNoNumaNode,
+                      std::memory_order_release);
+}
+
+std::optional<uint32_t> Scheduler::numaNode() const noexcept
+{
+    const int32_t node = m_numa_node.load(std::memory_order_acquire);
+    if (node < 0) {
+        return std::nullopt;
+    }
+    return static_cast<uint32_t>(node);
+}
+
+/**
+ * @brief 让调度器线程的后续分配优先落在所属节点，并预热本线程 TaskState free list
+ *
+ * @return true 已应用或未配置节点；false 内核拒绝 set_mempolicy 或平台不支持
+ */
+bool Scheduler::applyConfiguredNumaPlacement()
+{
+    const auto node = numaNode();
+    if (!node.has_value()) {
+        return true;
+    }
+    const bool preferred = detail::preferNumaNode(*node);
+    // 绑核后首次触碰，free list 中的 TaskState 页面即使内核拒绝 mempolicy 也按 first-touch 落在本节点。
+    (void)detail::prewarmTaskStateFreeList(kNumaTaskStatePrewarm);
+    return preferred;
+}
+
 } // namespace galay::kernel
@@ -134,6 +134,18 @@ public:
      */
     virtual bool addTimer(Timer::ptr timer) = 0;
 
+    /**
+     * @brief 在到期前把定时器从本调度器的时间轮摘除
+     * @param timer 先前经 addTimer() 注册的定时器
+     * @return true 已 O(1) 解链并释放时间轮持有的引用；false 本调度器不支持或定时器不在轮上
+     * @note 只能在调度器线程调用；默认实现依赖 Timer::cancel() 的惰性丢弃
+     */
+    virtual bool removeTimer(Timer& timer) noexcept
+    {
+        (void)timer;
+        return false;
+    }
+
     /**
      * @brief 配置或取消调度器线程绑核
      * @param cpu_id 目标 CPU 核心编号（从 0 开始）；传 std::nullopt 表示取消绑核
@@ -143,6 +155,16 @@ public:
      */
     bool setAffinity(std::optional<uint32_t> cpu_id);
 
+    /**
+     * @brief 配置或清除调度器所属 NUMA 节点
+     * @param node 节点编号；传 std::nullopt 表示不做内存放置
+     * @note 在 start() 之前调用：reactor 缓冲池在所属节点上初始化，调度器线程的
+     *       后续分配与 TaskState free list 也优先落在该节点
+     */
+    void setNumaNode(std::optional<uint32_t> node) noexcept;
+
+    std::optional<uint32_t> numaNode() const noexcept;  ///< 返回 setNumaNode() 配置的节点；未配置时返回 std::nullopt
+
     /**
      * @brief 获取调度器所属线程ID
      * @return 线程ID
@@ -185,11 +207,21 @@ protected:
      * @note 只有在 setAffinity() 设定了具体 CPU 后该函数才会实际执行绑核
      */
     bool applyConfiguredAffinity();
+
+    /**
+     * @brief 在调度器线程上应用 setNumaNode() 配置的内存放置
+     * @return true 已应用或无需应用；false 平台不支持或内核拒绝
+     * @note 应在 applyConfiguredAffinity() 之后调用，使预热的 TaskState 存储在所属节点首次触碰
+     */
+    bool applyConfiguredNumaPlacement();
     std::thread::id m_threadId;  ///< 调度器所属线程ID，在 start() 时设置
 
 private:
     static constexpr int32_t kNoAffinity = -1;
+    static constexpr int32_t kNoNumaNode = -1;
+    static constexpr size_t kNumaTaskStatePrewarm = 256;  ///< NUMA 放置时每个调度器线程预热的 TaskState 数
     std::atomic<int32_t> m_affinity_cpu{kNoAffinity};
+    std::atomic<int32_t> m_numa_node{kNoNumaNode};
 };
 
 namespace detail {
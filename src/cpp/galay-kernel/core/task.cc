@@ -6,6 +6,7 @@
  *
  * @details 实现：
  * - TaskState 对象的线程局部空闲链分配器
+ * - TaskPromise 协程帧的线程局部 size-class slab 池与 remote-free 归还
  * - TaskRef 引用计数（retain/release）
  * - TaskState 析构函数和等待器清理
  * - 任务生命周期辅助函数：调度、完成、等待、continuation 附加
@@ -14,6 +15,10 @@
 
 #include "task.h"
 #include "scheduler.hpp"
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
 
 namespace galay::kernel
 {
@@ -59,6 +64,258 @@ void releaseTaskStateStorage(void* ptr, std::size_t size, std::align_val_t align
     ++g_taskStateFreeCount;
 }
 
+size_t fillTaskStateFreeList(size_t count) noexcept
+{
+    const auto alignment = std::align_val_t(alignof(TaskState));
+    size_t added = 0;
+    while (added < count && g_taskStateFreeCount < kTaskStateFreeListLimit) {
+        void* storage = ::operator new(sizeof(TaskState), alignment, std::nothrow);
+        if (storage == nullptr) {
+            break;
+        }
+        // 整块写一遍，让页面按当前线程的 NUMA 策略落位，而不是等首个任务才触碰。
+        std::memset(storage, 0, sizeof(TaskState));
+        releaseTaskStateStorage(storage, sizeof(TaskState), alignment);
+        ++added;
+    }
+    return added;
+}
+
+/*
+ * 协程帧池：每个线程一个 TaskFramePool，块长按 64 字节分 32 个 size-class，
+ * 从 64 KiB slab 顺序切出。块头记录 owner 池与 size-class；owner 线程释放时
+ * 直接压回本地空闲链，其他线程释放时 CAS 压入 owner 的 remote-free 栈，
+ * owner 在对应空闲链为空时一次性摘走整条栈（单消费者 exchange，无 ABA）。
+ *
+ * owner 线程退出后池转为孤儿：remote_balance 记入尚未归还的块数，
+ * 最后一个跨线程释放把计数降到 0 时连同 slab 一起回收。
+ */
+constexpr size_t kFrameBlockGranularity = 64;
+constexpr size_t kFrameSizeClasses = 32;
+constexpr size_t kFrameHeaderBytes = 16;
+constexpr size_t kFrameSlabBytes = 64 * 1024;
+constexpr size_t kFrameSlabBudgetBytes = 16 * 1024 * 1024;  // 单线程 slab 上限，超出后退回全局堆
+constexpr uint32_t kFrameHeapClass = UINT32_MAX;
+
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ <= kFrameHeaderBytes,
+              "frame header must preserve default new alignment");
+
+struct TaskFramePool;
+
+struct FrameHeader
+{
+    TaskFramePool* pool;  // nullptr 表示块直接来自全局堆
+    uint32_t size_class;
+};
+static_assert(sizeof(FrameHeader) <= kFrameHeaderBytes);
+
+struct FrameFreeNode
+{
+    FrameFreeNode* next;
+    uint32_t size_class;
+};
+
+struct FrameSlab
+{
+    FrameSlab* next;
+};
+
+struct TaskFramePool
+{
+    FrameFreeNode* free_lists[kFrameSizeClasses]{};
+    std::byte* slab_cursor = nullptr;
+    std::byte* slab_end = nullptr;
+    FrameSlab* slabs = nullptr;
+    uint64_t allocated = 0;    // 从 slab 交出去的块数，仅 owner 写
+    uint64_t local_frees = 0;  // owner 线程自己归还的块数，仅 owner 写
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> remote_frees{0};
+    std::atomic<size_t> bytes_cached{0};
+    std::atomic<size_t> bytes_reserved{0};
+
+    alignas(::galay::utils::kCacheLineSize) std::atomic<FrameFreeNode*> remote_head{nullptr};
+    std::atomic<int64_t> remote_balance{0};  // 孤儿化前为 -跨线程归还数，孤儿化后为未归还块数
+};
+
+struct FramePoolRegistry
+{
+    std::mutex mutex;
+    std::vector<TaskFramePool*> live;
+    TaskFramePoolStats retired;
+};
+
+FramePoolRegistry& framePoolRegistry() noexcept
+{
+    // 故意泄漏：线程退出可能晚于静态析构
+    static auto* registry = new FramePoolRegistry();
+    return *registry;
+}
+
+thread_local TaskFramePool* g_taskFramePool = nullptr;
+thread_local bool g_taskFramePoolRetired = false;
+
+inline void bumpFrameCounter(std::atomic<uint64_t>& counter, uint64_t delta = 1) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+inline void adjustCachedBytes(TaskFramePool& pool, size_t add, size_t sub) noexcept
+{
+    pool.bytes_cached.store(pool.bytes_cached.load(std::memory_order_relaxed) + add - sub,
+                            std::memory_order_relaxed);
+}
+
+constexpr size_t frameBlockBytes(uint32_t size_class) noexcept
+{
+    return (static_cast<size_t>(size_class) + 1) * kFrameBlockGranularity;
+}
+
+TaskFramePoolStats snapshotFramePool(const TaskFramePool& pool) noexcept
+{
+    TaskFramePoolStats stats;
+    stats.hits = pool.hits.load(std::memory_order_relaxed);
+    stats.misses = pool.misses.load(std::memory_order_relaxed);
+    stats.remote_frees = pool.remote_frees.load(std::memory_order_relaxed);
+    stats.bytes_cached = pool.bytes_cached.load(std::memory_order_relaxed);
+    stats.bytes_reserved = pool.bytes_reserved.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void destroyFramePool(TaskFramePool* pool) noexcept
+{
+    FrameSlab* slab = pool->slabs;
+    while (slab != nullptr) {
+        FrameSlab* next = slab->next;
+        ::operator delete(slab, std::align_val_t(kFrameBlockGranularity));
+        slab = next;
+    }
+    delete pool;
+}
+
+void retireFramePool(TaskFramePool* pool) noexcept
+{
+    auto& registry = framePoolRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        std::erase(registry.live, pool);
+        const auto stats = snapshotFramePool(*pool);
+        registry.retired.hits += stats.hits;
+        registry.retired.misses += stats.misses;
+        registry.retired.remote_frees += stats.remote_frees;
+    }
+    const auto outstanding = static_cast<int64_t>(pool->allocated - pool->local_frees);
+    if (pool->remote_balance.fetch_add(outstanding, std::memory_order_acq_rel) + outstanding == 0) {
+        destroyFramePool(pool);
+    }
+}
+
+struct FramePoolOwner
+{
+    ~FramePoolOwner()
+    {
+        TaskFramePool* pool = g_taskFramePool;
+        g_taskFramePool = nullptr;
+        g_taskFramePoolRetired = true;  // 之后的 TLS 析构再分配帧只走全局堆
+        if (pool != nullptr) {
+            retireFramePool(pool);
+        }
+    }
+};
+
+TaskFramePool* createLocalFramePool() noexcept
+{
+    auto* pool = new (std::nothrow) TaskFramePool();
+    if (pool == nullptr) {
+        return nullptr;
+    }
+    {
+        auto& registry = framePoolRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.live.push_back(pool);
+    }
+    thread_local FramePoolOwner owner;  // 首次进入时注册线程退出回收
+    (void)owner;
+    g_taskFramePool = pool;
+    return pool;
+}
+
+inline TaskFramePool* localFramePool() noexcept
+{
+    if (g_taskFramePool != nullptr) [[likely]] {
+        return g_taskFramePool;
+    }
+    if (g_taskFramePoolRetired) {
+        return nullptr;
+    }
+    return createLocalFramePool();
+}
+
+void drainRemoteFrames(TaskFramePool& pool) noexcept
+{
+    FrameFreeNode* node = pool.remote_head.exchange(nullptr, std::memory_order_acquire);
+    uint64_t count = 0;
+    size_t bytes = 0;
+    while (node != nullptr) {
+        FrameFreeNode* next = node->next;
+        node->next = pool.free_lists[node->size_class];
+        pool.free_lists[node->size_class] = node;
+        bytes += frameBlockBytes(node->size_class);
+        ++count;
+        node = next;
+    }
+    bumpFrameCounter(pool.remote_frees, count);
+    adjustCachedBytes(pool, bytes, 0);
+}
+
+std::byte* carveFrameBlock(TaskFramePool& pool, size_t block_bytes) noexcept
+{
+    if (static_cast<size_t>(pool.slab_end - pool.slab_cursor) < block_bytes) {
+        const size_t reserved = pool.bytes_reserved.load(std::memory_order_relaxed);
+        if (reserved + kFrameSlabBytes > kFrameSlabBudgetBytes) {
+            return nullptr;
+        }
+        void* storage = ::operator new(kFrameSlabBytes, std::align_val_t(kFrameBlockGranularity), std::nothrow);
+        if (storage == nullptr) {
+            return nullptr;
+        }
+        auto* slab = static_cast<FrameSlab*>(storage);
+        slab->next = pool.slabs;
+        pool.slabs = slab;
+        // slab 头独占第一个块宽，后续块保持 64 字节对齐
+        pool.slab_cursor = static_cast<std::byte*>(storage) + kFrameBlockGranularity;
+        pool.slab_end = static_cast<std::byte*>(storage) + kFrameSlabBytes;
+        pool.bytes_reserved.store(reserved + kFrameSlabBytes, std::memory_order_relaxed);
+    }
+    std::byte* block = pool.slab_cursor;
+    pool.slab_cursor += block_bytes;
+    return block;
+}
+
+void* finishFrame(void* block, TaskFramePool* pool, uint32_t size_class) noexcept
+{
+    auto* header = static_cast<FrameHeader*>(block);
+    header->pool = pool;
+    header->size_class = size_class;
+    return static_cast<std::byte*>(block) + kFrameHeaderBytes;
+}
+
+void pushRemoteFrame(TaskFramePool* pool, void* block, uint32_t size_class) noexcept
+{
+    auto* node = static_cast<FrameFreeNode*>(block);
+    node->size_class = size_class;
+    node->next = pool->remote_head.load(std::memory_order_relaxed);
+    while (!pool->remote_head.compare_exchange_weak(node->next, node,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed)) {
+    }
+    // 孤儿池的最后一个归还者负责回收；孤儿化之前计数恒 <= 0，不会误判
+    if (pool->remote_balance.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        destroyFramePool(pool);
+    }
+}
+
 } // namespace
 
 TaskState::~TaskState()
@@ -151,6 +408,69 @@ Runtime* swapCurrentRuntime(Runtime* runtime) noexcept
     return previous;
 }
 
+size_t prewarmTaskStateFreeList(size_t count) noexcept
+{
+    return fillTaskStateFreeList(count);
+}
+
+void* allocateTaskFrame(std::size_t size)
+{
+    const size_t total = size + kFrameHeaderBytes;
+    const size_t size_class = (total - 1) / kFrameBlockGranularity;
+    TaskFramePool* pool = size_class < kFrameSizeClasses ? localFramePool() : nullptr;
+    if (pool != nullptr) {
+        const auto cls = static_cast<uint32_t>(size_class);
+        FrameFreeNode* node = pool->free_lists[cls];
+        if (node == nullptr && pool->remote_head.load(std::memory_order_relaxed) != nullptr) {
+            drainRemoteFrames(*pool);
+            node = pool->free_lists[cls];
+        }
+        if (node != nullptr) {
+            pool->free_lists[cls] = node->next;
+            adjustCachedBytes(*pool, 0, frameBlockBytes(cls));
+            bumpFrameCounter(pool->hits);
+            ++pool->allocated;
+            return finishFrame(node, pool, cls);
+        }
+        bumpFrameCounter(pool->misses);
+        if (std::byte* block = carveFrameBlock(*pool, frameBlockBytes(cls))) {
+            ++pool->allocated;
+            return finishFrame(block, pool, cls);
+        }
+    } else if (g_taskFramePool != nullptr) {
+        bumpFrameCounter(g_taskFramePool->misses);
+    }
+    return finishFrame(::operator new(total), nullptr, kFrameHeapClass);
+}
+
+void releaseTaskFrame(void* frame) noexcept
+{
+    if (frame == nullptr) {
+        return;
+    }
+    void* block = static_cast<std::byte*>(frame) - kFrameHeaderBytes;
+    const FrameHeader header = *static_cast<FrameHeader*>(block);
+    if (header.pool == nullptr) {
+        ::operator delete(block);
+        return;
+    }
+    if (header.pool != g_taskFramePool) {
+        pushRemoteFrame(header.pool, block, header.size_class);
+        return;
+    }
+    auto& pool = *header.pool;
+    auto* node = static_cast<FrameFreeNode*>(block);
+    node->next = pool.free_lists[header.size_class];
+    pool.free_lists[header.size_class] = node;
+    ++pool.local_frees;
+    adjustCachedBytes(pool, frameBlockBytes(header.size_class), 0);
+}
+
+TaskFramePoolStats currentThreadTaskFramePoolStats() noexcept
+{
+    return g_taskFramePool != nullptr ? snapshotFramePool(*g_taskFramePool) : TaskFramePoolStats{};
+}
+
 bool scheduleTask(const TaskRef& task) noexcept
 {
     auto* scheduler = task.belongScheduler();
@@ -290,6 +610,22 @@ bool waitTaskCompletion(const TaskRef& task)
 
 } // namespace detail
 
+TaskFramePoolStats taskFramePoolStats() noexcept
+{
+    auto& registry = framePoolRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    TaskFramePoolStats total = registry.retired;
+    for (const TaskFramePool* pool : registry.live) {
+        const auto stats = snapshotFramePool(*pool);
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.remote_frees += stats.remote_frees;
+        total.bytes_cached += stats.bytes_cached;
+        total.bytes_reserved += stats.bytes_reserved;
+    }
+    return total;
+}
+
 TaskRef::TaskRef(TaskState* state, bool retainRef) noexcept
     : m_state(state)
 {
@@ -13,7 +13,11 @@
  * - TaskCompletionState<T>：用于阻塞 spawn 的线程安全结果/异常交付
  * - TaskAwaiter<T>：链接父子协程恢复的 awaiter
  *
- * 同时提供 TaskState 的线程局部空闲链分配器，以减少热路径上的分配开销。
+ * 同时提供 TaskState 的线程局部空闲链分配器，以及 TaskPromise 协程帧的
+ * 线程局部 size-class slab 池，以减少热路径上的分配开销。
+ *
+ * @note 定义 GALAY_DISABLE_TASK_FRAME_POOL 后 TaskPromise 不再声明 operator new/delete，
+ * 协程帧回到全局堆分配（CMake 选项同名）。
  */
 
 #ifndef GALAY_KERNEL_TASK_H
@@ -52,6 +56,21 @@ struct TaskState;  ///< 任务共享状态前置声明
 class TaskRef;  ///< 轻量任务引用前置声明
 struct TaskWaiter;  ///< 任务等待器前置声明
 
+/**
+ * @brief 协程帧池计数快照
+ * @details 每个分配协程帧的线程（通常即各 scheduler 线程）拥有一个帧池；
+ * 计数由 owner 线程单写，快照读取不加锁，跨字段不保证瞬时一致。
+ */
+struct TaskFramePoolStats {
+    uint64_t hits = 0;  ///< 直接从空闲链复用的帧数
+    uint64_t misses = 0;  ///< 需要从 slab 切新块或退回全局堆的帧数
+    uint64_t remote_frees = 0;  ///< 在其他线程释放、经 remote-free 链回到 owner 的帧数
+    size_t bytes_cached = 0;  ///< 当前挂在空闲链上可直接复用的字节数（不含尚未回收的 remote 链）
+    size_t bytes_reserved = 0;  ///< 已向全局堆申请的 slab 总字节数
+};
+
+TaskFramePoolStats taskFramePoolStats() noexcept;  ///< 汇总进程内全部帧池；已退出线程只保留 hits/misses/remote_frees 历史计数
+
 namespace detail
 {
 
@@ -115,6 +134,10 @@ void completeTaskState(const TaskRef& task) noexcept;  ///< 标记任务完成
 void attachTaskContinuation(const TaskRef& task, TaskRef next) noexcept;  ///< 为任务追加下一段 continuation
 bool waitTaskCompletion(const TaskRef& task);  ///< 阻塞等待任务完成；无有效任务状态时返回 false
 void storeTaskError(const TaskRef& task, TaskResultError error) noexcept;  ///< 写入任务错误
+size_t prewarmTaskStateFreeList(size_t count) noexcept;  ///< 在当前线程分配并首次触碰至多 count 个 TaskState 存储放入本线程 free list；返回新增数量
+void* allocateTaskFrame(std::size_t size);  ///< 从当前线程帧池分配协程帧；超出最大 size-class 或 slab 预算时退回全局堆
+void releaseTaskFrame(void* frame) noexcept;  ///< 归还协程帧；非 owner 线程释放时挂到 owner 的 remote-free 链
+TaskFramePoolStats currentThreadTaskFramePoolStats() noexcept;  ///< 读取当前线程帧池计数；尚未分配过帧时全为 0
 struct TaskAccess;  ///< 供内核实现访问 Task 私有状态的辅助入口
 template <typename T>
 class TaskAwaiter;  ///< `co_await Task<T>` 使用的 awaiter
@@ -1294,6 +1317,11 @@ public:
 
     int get_return_object_on_alloaction_failure() noexcept { return -1; }  ///< 协程分配失败时返回错误码占位
 
+#ifndef GALAY_DISABLE_TASK_FRAME_POOL
+    static void* operator new(std::size_t size) { return detail::allocateTaskFrame(size); }  ///< 协程帧从当前线程 size-class slab 分配
+    static void operator delete(void* frame, std::size_t) noexcept { detail::releaseTaskFrame(frame); }  ///< 协程帧归还到 owner 线程的帧池
+#endif
+
     Task<T> get_return_object() noexcept  ///< 构造并返回与该 promise 绑定的 Task
     {
         auto handle = std::coroutine_handle<TaskPromise<T>>::from_promise(*this);
@@ -1347,6 +1375,11 @@ public:
 
     int get_return_object_on_alloaction_failure() noexcept { return -1; }  ///< 协程分配失败时返回错误码占位
 
+#ifndef GALAY_DISABLE_TASK_FRAME_POOL
+    static void* operator new(std::size_t size) { return detail::allocateTaskFrame(size); }  ///< 协程帧从当前线程 size-class slab 分配
+    static void operator delete(void* frame, std::size_t) noexcept { detail::releaseTaskFrame(frame); }  ///< 协程帧归还到 owner 线程的帧池
+#endif
+
     Task<void> get_return_object() noexcept  ///< 构造并返回与该 promise 绑定的 Task
     {
         auto handle = std::coroutine_handle<TaskPromise<void>>::from_promise(*this);
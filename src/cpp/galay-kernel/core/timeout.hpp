@@ -135,6 +135,12 @@ private:
 
 int removeTimedOutIORegistration(Scheduler* scheduler, IOController* controller) noexcept;
 
+/**
+ * @brief 调度器是否把一次性 IO 的超时交给内核 LINK_TIMEOUT 处理
+ * @return 仅 io_uring 调度器且未关闭 IOUringOptions::linked_timeouts 时返回 true
+ */
+bool prefersLinkedTimeout(Scheduler* scheduler) noexcept;
+
 template <typename Awaitable>
 bool awaitableStillOwnsIORegistration(Awaitable& awaitable) noexcept
 {
@@ -348,6 +354,21 @@ public:
                 static_cast<int>(TimerFlag::kTimeout)) != 0;
     }
 
+#ifdef USE_IOURING
+    /**
+     * @brief reactor 回写 LINK_TIMEOUT 挂载结果的位置
+     * @details 与 inner awaitable 同寿命；WithTimeout 发布 waiter 后只读 timer 上的副本。
+     */
+    bool* linkTimeoutArmedFlag() noexcept { return &m_link_timeout_armed; }
+    bool linkTimeoutArmed() const noexcept { return m_link_timeout_armed; }  ///< 截止时间是否已交给内核 LINK_TIMEOUT
+
+    /**
+     * @brief 标记 timer 已进入时间轮
+     * @return 此前未进入时返回 true；LINK_TIMEOUT 回退与首次提交共用，保证只注册一次
+     */
+    bool markWheelArmed() noexcept { return !std::exchange(m_wheel_armed, true); }
+#endif
+
     /** @brief 由 timer manager 或测试入口触发一次 timeout 裁决。 */
     void handleTimeout() override {
         if (completeTimeout()) {
@@ -407,6 +428,10 @@ private:
 
     detail::DeferredWaker m_waker;
     std::atomic<Completion> m_completion{Completion::kPending};
+#ifdef USE_IOURING
+    bool m_link_timeout_armed = false;  ///< 由 reactor 在提交 SQE 时写入
+    bool m_wheel_armed = false;  ///< 是否已注册到调度器时间轮
+#endif
 };
 
 template<typename Awaitable>
@@ -433,9 +458,12 @@ struct TimeoutSupport {
 /**
  * @brief 超时包装器
  *
- * @details 对于 io_uring，使用独立的 timeout 操作；对于 epoll/kqueue，使用 timerfd。
- * 定时器状态存储在 IOController 中，生命周期与 AsyncTcpSocket 绑定。
- * @note 构造时通过 make_shared 分配 TimeoutTimer。timer manager 可能在取消后仍短暂
+ * @details 默认把 TimeoutTimer 放入调度器时间轮，到期后唤醒协程并移除 IO 注册。
+ * io_uring 上的一次性 SQE（send/writev/readv/connect/sendto/文件读写等）改为链接
+ * `IORING_OP_LINK_TIMEOUT`：到期与取消在内核一次往返内完成，不再占用时间轮；
+ * multishot recv/accept 等无法链接的路径仍走时间轮。
+ * @note 构造时通过 detail::makeTimerNode 从当前线程帧池分配 TimeoutTimer（控制块与节点
+ *       同一块）。timer manager 可能在取消后仍短暂
  *       持有 Timer::ptr，因此该对象不能安全改成 awaiter/channel 的裸成员。当前全局
  *       allocator OOM 不通过 inner awaitable 的 std::expected 返回。
  */
@@ -446,10 +474,10 @@ struct WithTimeout {
     Scheduler* m_scheduler = nullptr;
 
     WithTimeout(Awaitable&& inner, std::chrono::milliseconds timeout)
-        : m_inner(std::move(inner)), m_timer(std::make_shared<TimeoutTimer>(timeout)) {}
+        : m_inner(std::move(inner)), m_timer(detail::makeTimerNode<TimeoutTimer>(timeout)) {}
 
     WithTimeout(Awaitable& inner, std::chrono::milliseconds timeout)
-        : m_inner(std::move(inner)), m_timer(std::make_shared<TimeoutTimer>(timeout)) {}
+        : m_inner(std::move(inner)), m_timer(detail::makeTimerNode<TimeoutTimer>(timeout)) {}
 
     WithTimeout(WithTimeout&&) noexcept = default;
     WithTimeout& operator=(WithTimeout&&) noexcept = default;
@@ -491,11 +519,34 @@ struct WithTimeout {
             m_inner.bindTimeoutTimer(timer);
         }
 
+#ifdef USE_IOURING
+        if constexpr (requires(Awaitable& awaitable) {
+            awaitable.requestLinkTimeout(uint64_t{});
+        }) {
+            if (detail::prefersLinkedTimeout(scheduler)) {
+                m_inner.requestLinkTimeout(timer->getExpireTime(),
+                                           timer->linkTimeoutArmedFlag(),
+                                           &WithTimeout::fallBackToWheel,
+                                           this);
+            }
+        }
+#endif
+
         const bool suspended = m_inner.await_suspend(handle);
         if (!suspended) {
             timer->cancel();
             return false;
         }
+#ifdef USE_IOURING
+        if (timer->linkTimeoutArmed()) {
+            // 截止时间已由内核 LINK_TIMEOUT 负责，完成 CQE 会直接唤醒 inner waker。
+            return timer->armWaker();
+        }
+        if (!timer->markWheelArmed()) {
+            // 首次提交取不到 LINK_TIMEOUT SQE 时 fallBackToWheel() 已注册时间轮。
+            return timer->armWaker();
+        }
+#endif
         const bool timerAdded = scheduler->addTimer(timer);
         if (!timerAdded) {
             timer->timeoutNow();
@@ -505,6 +556,25 @@ struct WithTimeout {
     }
 
     auto await_resume() -> decltype(m_inner.await_resume()) {
+#ifdef USE_IOURING
+        if constexpr (requires(Awaitable& awaitable) {
+            awaitable.m_link_timeout_fired;
+        }) {
+            if (m_inner.m_link_timeout_fired) [[unlikely]] {
+                // LINK_TIMEOUT 已在内核取消目标 SQE，completion 也已消费，无需再移除注册。
+                m_timer->clearWaker();
+                m_timer->markTimeoutWithoutWake();
+                if constexpr (requires(Awaitable& awaitable) {
+                    awaitable.markTimeout();
+                }) {
+                    m_inner.markTimeout();
+                } else if constexpr (requires { m_inner.m_result; }) {
+                    m_inner.m_result = std::unexpected(IOError(kTimeout, 0));
+                }
+                return m_inner.await_resume();
+            }
+        }
+#endif
         const bool timedOut = m_timer->timeouted();
         // 当前协程已在执行，timer 不再需要保留独立 TaskRef。
         m_timer->clearWaker();
@@ -532,6 +602,10 @@ struct WithTimeout {
             }
         } else {
             m_timer->cancel();
+            if (m_scheduler != nullptr) {
+                // 操作先完成：立即从时间轮解链，避免 timer 挂到原定到期时刻才被释放。
+                (void)m_scheduler->removeTimer(*m_timer);
+            }
         }
         return m_inner.await_resume();
     }
@@ -539,6 +613,23 @@ struct WithTimeout {
 private:
     WithTimeout(const WithTimeout&) = delete;
     WithTimeout& operator=(const WithTimeout&) = delete;
+
+#ifdef USE_IOURING
+    /**
+     * @brief reactor 某次提交取不到 LINK_TIMEOUT SQE 时的回调
+     * @details 在调度器线程上、操作挂起期间调用（首次提交时位于 await_suspend 内部），
+     *          此时 awaiter 仍存活；重新提交丢失内核截止时间时由时间轮接管。
+     */
+    static void fallBackToWheel(void* owner) noexcept {
+        auto* self = static_cast<WithTimeout*>(owner);
+        if (!self->m_timer->markWheelArmed() || self->m_scheduler == nullptr) {
+            return;
+        }
+        if (!self->m_scheduler->addTimer(self->m_timer)) {
+            self->m_timer->timeoutNow();
+        }
+    }
+#endif
 };
 
 }
@@ -0,0 +1,301 @@
+/**
+ * @file udp_batch.hpp
+ * @brief UDP 批量收发的数据报描述与系统调用封装
+ * @author galay-kernel
+ * @version 1.0.0
+ *
+ * @details 为 RecvBatchAwaitable / SendBatchAwaitable 提供后端无关的部分：
+ * - UdpRecvDatagram / UdpSendDatagram：用户侧借用的数据报槽位
+ * - io::recvDatagramBatch / io::sendDatagramBatch：非阻塞批量收发
+ *
+ * Linux 上一次 recvmmsg/sendmmsg 处理最多 kUdpBatchChunk 个数据报，并支持：
+ * - GSO：UdpSendDatagram::segment_size > 0 时附带 UDP_SEGMENT，由内核/网卡切分
+ * - GRO：socket 开启 UDP_GRO 后，合并数据报的段大小写入 UdpRecvDatagram::segment_size，
+ *   通过 segmentCount()/segment() 原地拆分，不做额外拷贝
+ *
+ * 其他平台退化为逐个 recvmsg/sendmsg 循环，GSO 返回 EOPNOTSUPP。
+ */
+
+#ifndef GALAY_KERNEL_UDP_BATCH_HPP
+#define GALAY_KERNEL_UDP_BATCH_HPP
+
+#include "../common/defn.hpp"
+#include "../common/error.h"
+#include "../common/host.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif
+
+namespace galay::kernel
+{
+
+inline constexpr size_t kUdpBatchChunk = 64;  ///< 单次 recvmmsg/sendmmsg 的最大数据报数；更大的 span 分多次系统调用
+
+/**
+ * @brief 批量接收的单个数据报槽位
+ * @details buffer/capacity 由调用方提供；其余字段由接收操作写出。
+ */
+struct UdpRecvDatagram {
+    char* buffer = nullptr;  ///< 接收缓冲区
+    size_t capacity = 0;  ///< 缓冲区容量
+    size_t length = 0;  ///< 实际写入的字节数
+    Host from;  ///< 发送方地址
+    uint16_t segment_size = 0;  ///< GRO 合并段大小；0 表示未合并
+    bool truncated = false;  ///< 数据报超过 capacity 被截断
+
+    /**
+     * @brief 返回该槽位包含的逻辑数据报数量
+     * @return 未合并时为 1；GRO 合并时为按 segment_size 切分后的段数
+     */
+    size_t segmentCount() const noexcept {
+        if (segment_size == 0 || length <= segment_size) {
+            return 1;
+        }
+        return (length + segment_size - 1) / segment_size;
+    }
+
+    /**
+     * @brief 返回第 index 个逻辑数据报的视图；最后一段可能短于 segment_size
+     * @param index 段下标，须小于 segmentCount()
+     */
+    std::span<const char> segment(size_t index) const noexcept {
+        if (segment_size == 0) {
+            return index == 0 ? std::span<const char>(buffer, length) : std::span<const char>{};
+        }
+        const size_t offset = index * segment_size;
+        if (offset >= length) {
+            return index == 0 ? std::span<const char>(buffer, 0) : std::span<const char>{};
+        }
+        return {buffer + offset, std::min<size_t>(segment_size, length - offset)};
+    }
+};
+
+/**
+ * @brief 批量发送的单个数据报
+ * @details segment_size > 0 时该条目以 GSO 发送：buffer 按 segment_size 被切分为多个
+ * 线上数据报（最后一段可以更短），整体只占一次系统调用与一个 skb。
+ */
+struct UdpSendDatagram {
+    const char* buffer = nullptr;  ///< 发送缓冲区
+    size_t length = 0;  ///< 发送字节数
+    Host to;  ///< 目标地址
+    uint16_t segment_size = 0;  ///< GSO 段大小；0 表示普通数据报
+};
+
+namespace io
+{
+
+namespace detail {
+
+#if defined(__linux__)
+union UdpControlBuffer {
+    char bytes[CMSG_SPACE(sizeof(int))];
+    struct cmsghdr align;
+};
+
+inline uint16_t groSegmentSize(const struct msghdr& msg) noexcept {
+    for (auto* cmsg = CMSG_FIRSTHDR(const_cast<struct msghdr*>(&msg));
+         cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(&msg), cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int size = 0;
+            std::memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+            return size > 0 ? static_cast<uint16_t>(size) : 0;
+        }
+    }
+    return 0;
+}
+
+inline void attachGsoSegment(struct msghdr& msg, UdpControlBuffer& control, uint16_t segment_size) noexcept {
+    msg.msg_control = control.bytes;
+    msg.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+    auto* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+}
+#endif
+
+inline bool datagramWouldBlock(int error) noexcept {
+    return error == EAGAIN || error == EWOULDBLOCK || error == EINTR;
+}
+
+inline void prepareRecvMessage(struct msghdr& msg, struct iovec& iov, UdpRecvDatagram& datagram) noexcept {
+    iov.iov_base = datagram.buffer;
+    iov.iov_len = datagram.capacity;
+    msg.msg_name = datagram.from.sockAddr();
+    msg.msg_namelen = sizeof(sockaddr_storage);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+}
+
+inline void finishRecvMessage(const struct msghdr& msg, size_t bytes, UdpRecvDatagram& datagram) noexcept {
+    datagram.length = bytes;
+    *datagram.from.addrLen() = msg.msg_namelen;
+    datagram.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+#if defined(__linux__)
+    datagram.segment_size = groSegmentSize(msg);
+#else
+    datagram.segment_size = 0;
+#endif
+}
+
+inline void prepareSendMessage(struct msghdr& msg, struct iovec& iov, const UdpSendDatagram& datagram) noexcept {
+    iov.iov_base = const_cast<char*>(datagram.buffer);
+    iov.iov_len = datagram.length;
+    msg.msg_name = const_cast<sockaddr*>(datagram.to.sockAddr());
+    msg.msg_namelen = datagram.to.addrLen();
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+}
+
+}  // namespace detail
+
+/**
+ * @brief 非阻塞地把已就绪数据报批量读入 datagrams
+ * @return 成功返回填充的槽位数（>=1）；没有就绪数据返回 kNotReady；失败返回 kRecvFailed
+ * @note 已读到部分数据报后遇到错误时返回已读数量，错误留给下一次调用暴露。
+ */
+inline std::expected<size_t, IOError> recvDatagramBatch(int fd, std::span<UdpRecvDatagram> datagrams)
+{
+    size_t filled = 0;
+#if defined(__linux__)
+    while (filled < datagrams.size()) {
+        const size_t chunk = std::min(kUdpBatchChunk, datagrams.size() - filled);
+        std::array<struct mmsghdr, kUdpBatchChunk> headers;
+        std::array<struct iovec, kUdpBatchChunk> iovecs;
+        std::array<detail::UdpControlBuffer, kUdpBatchChunk> controls;
+        for (size_t i = 0; i < chunk; ++i) {
+            headers[i] = {};
+            auto& msg = headers[i].msg_hdr;
+            detail::prepareRecvMessage(msg, iovecs[i], datagrams[filled + i]);
+            msg.msg_control = controls[i].bytes;
+            msg.msg_controllen = sizeof(controls[i].bytes);
+        }
+        const int received = ::recvmmsg(fd, headers.data(), static_cast<unsigned>(chunk),
+                                        MSG_DONTWAIT, nullptr);
+        if (received <= 0) {
+            if (received < 0 && !detail::datagramWouldBlock(errno) && filled == 0) {
+                return std::unexpected(IOError(kRecvFailed, static_cast<uint32_t>(errno)));
+            }
+            break;
+        }
+        for (int i = 0; i < received; ++i) {
+            detail::finishRecvMessage(headers[i].msg_hdr, headers[i].msg_len, datagrams[filled + i]);
+        }
+        filled += static_cast<size_t>(received);
+        if (static_cast<size_t>(received) < chunk) {
+            break;
+        }
+    }
+#else
+    while (filled < datagrams.size()) {
+        struct msghdr msg{};
+        struct iovec iov{};
+        detail::prepareRecvMessage(msg, iov, datagrams[filled]);
+        const ssize_t bytes = ::recvmsg(fd, &msg, MSG_DONTWAIT);
+        if (bytes < 0) {
+            if (!detail::datagramWouldBlock(errno) && filled == 0) {
+                return std::unexpected(IOError(kRecvFailed, static_cast<uint32_t>(errno)));
+            }
+            break;
+        }
+        detail::finishRecvMessage(msg, static_cast<size_t>(bytes), datagrams[filled]);
+        ++filled;
+    }
+#endif
+    if (filled == 0) {
+        return std::unexpected(IOError(kNotReady, 0));
+    }
+    return filled;
+}
+
+/**
+ * @brief 非阻塞地批量发送 datagrams
+ * @return 成功返回已交给内核的条目数（>=1，可能少于 size）；发送队列满返回 kNotReady；
+ *         失败返回 kSendFailed
+ * @note 与 recvDatagramBatch 一致：已发出部分条目后遇到错误时返回已发数量。
+ */
+inline std::expected<size_t, IOError> sendDatagramBatch(int fd, std::span<const UdpSendDatagram> datagrams)
+{
+    size_t sent = 0;
+#if defined(__linux__)
+    while (sent < datagrams.size()) {
+        const size_t chunk = std::min(kUdpBatchChunk, datagrams.size() - sent);
+        std::array<struct mmsghdr, kUdpBatchChunk> headers;
+        std::array<struct iovec, kUdpBatchChunk> iovecs;
+        std::array<detail::UdpControlBuffer, kUdpBatchChunk> controls;
+        for (size_t i = 0; i < chunk; ++i) {
+            headers[i] = {};
+            const auto& datagram = datagrams[sent + i];
+            detail::prepareSendMessage(headers[i].msg_hdr, iovecs[i], datagram);
+            if (datagram.segment_size > 0) {
+                detail::attachGsoSegment(headers[i].msg_hdr, controls[i], datagram.segment_size);
+            }
+        }
+        const int written = ::sendmmsg(fd, headers.data(), static_cast<unsigned>(chunk),
+                                       MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (written <= 0) {
+            if (written < 0 && !detail::datagramWouldBlock(errno) && sent == 0) {
+                return std::unexpected(IOError(kSendFailed, static_cast<uint32_t>(errno)));
+            }
+            break;
+        }
+        sent += static_cast<size_t>(written);
+        if (static_cast<size_t>(written) < chunk) {
+            break;
+        }
+    }
+#else
+    while (sent < datagrams.size()) {
+        if (datagrams[sent].segment_size > 0) {
+            if (sent == 0) {
+                return std::unexpected(IOError(kSendFailed, static_cast<uint32_t>(EOPNOTSUPP)));
+            }
+            break;
+        }
+        struct msghdr msg{};
+        struct iovec iov{};
+        detail::prepareSendMessage(msg, iov, datagrams[sent]);
+        if (::sendmsg(fd, &msg, MSG_DONTWAIT) < 0) {
+            if (!detail::datagramWouldBlock(errno) && sent == 0) {
+                return std::unexpected(IOError(kSendFailed, static_cast<uint32_t>(errno)));
+            }
+            break;
+        }
+        ++sent;
+    }
+#endif
+    if (sent == 0) {
+        return std::unexpected(IOError(kNotReady, 0));
+    }
+    return sent;
+}
+
+}  // namespace io
+
+}  // namespace galay::kernel
+
+#endif  // GALAY_KERNEL_UDP_BATCH_HPP
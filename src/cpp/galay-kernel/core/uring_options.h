@@ -0,0 +1,106 @@
+/**
+ * @file uring_options.h
+ * @brief io_uring 后端的可选运行参数
+ * @author galay-kernel
+ * @version 1.0.0
+ *
+ * @details 定义与平台无关的 IOUringOptions，使 RuntimeConfig 可以在任意后端上携带
+ * io_uring 专属配置；epoll / kqueue 构建会忽略这些字段。
+ */
+
+#ifndef GALAY_KERNEL_URING_OPTIONS_H
+#define GALAY_KERNEL_URING_OPTIONS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace galay::kernel
+{
+
+/**
+ * @brief io_uring ring 的 setup 策略
+ * @details 每种策略都会按内核能力逐级探测，最终退回 COOP_TASKRUN 和无 flag 的 ring。
+ */
+enum class IOUringSetupMode : uint8_t {
+    kDefault,       ///< 旧行为：每个 ring 独占一个 SQPOLL 线程（SQPOLL | COOP_TASKRUN）
+    kSingleIssuer,  ///< SINGLE_ISSUER | DEFER_TASKRUN：不启 SQPOLL，task work 只在调度器线程等待完成时执行
+    kSharedSqpoll,  ///< 同一 Runtime 的 ring 通过 ATTACH_WQ 共享一个 SQPOLL 线程
+};
+
+/**
+ * @brief kSharedSqpoll 模式下兄弟 ring 共享的 SQPOLL 锚点
+ * @details 第一个成功创建 SQPOLL 的 ring 登记自己的 fd，之后启动的 ring 以
+ * `IORING_SETUP_ATTACH_WQ` 挂到该 fd 的 SQ 线程；锚点 ring 退出时清空登记，
+ * 已挂载的 ring 继续持有内核侧 SQ 线程引用。
+ */
+struct IOUringSqpollGroup {
+    std::mutex mutex;  ///< 保护 anchor_fd；只在 ring 创建/销毁时加锁
+    int anchor_fd = -1;  ///< 当前可供挂载的 SQPOLL ring fd；-1 表示尚无锚点
+};
+
+/**
+ * @brief 单个 io_uring scheduler 最终生效的 ring setup
+ * @details 通过 RuntimeStats::io_uring_setups 暴露，用于按主机类型比较各 setup 策略。
+ */
+struct IOUringSetupStats {
+    IOUringSetupMode requested = IOUringSetupMode::kDefault;  ///< 配置请求的策略
+    uint32_t flags = 0;  ///< 实际生效的 IORING_SETUP_* 位（不含 R_DISABLED）
+    int32_t sq_thread_cpu = -1;  ///< SQPOLL 线程绑定的 CPU；-1 表示未绑定或无 SQPOLL
+    bool active = false;  ///< 是否为已初始化的 io_uring ring；其它后端恒为 false
+    bool sq_thread_shared = false;  ///< 是否挂到了兄弟 ring 的 SQPOLL 线程
+    bool fallback = false;  ///< 请求的 setup 不被内核接受，已退回更保守的组合
+};
+
+/**
+ * @brief io_uring reactor 的可选特性配置
+ *
+ * @note
+ * - 除 linked_timeouts 外默认关闭，保持与旧版本一致的提交路径
+ * - 非 io_uring 后端不会读取该结构
+ */
+struct IOUringOptions {
+    /**
+     * @brief 每个 ring 注册的稀疏 fixed file 表容量；0 表示关闭 fixed-file 模式
+     * @details 开启后 socket 在首次提交 SQE 时登记进 ring 的 fixed file 表，登记以
+     * `IORING_OP_FILES_UPDATE` SQE 随同一批次提交，不额外发起系统调用；登记 CQE 到达后
+     * accept/connect/recv/send/readv/writev/sendfile/recvfrom/sendto 均以
+     * `IOSQE_FIXED_FILE` 提交，省去内核每个 SQE 的 fget/fput。close 时同样以 SQE 清空表项，
+     * 清空完成后槽位才会分给新连接。socket 仍保留普通 fd，
+     * setsockopt、getpeername、sendfile 等需要真实 fd 的路径不受影响；表满或登记失败时
+     * 自动回退普通 fd 提交。
+     */
+    uint32_t fixed_file_slots = 0;
+
+    /**
+     * @brief 每个 ring 通过 `io_uring_register_buffers` 注册的文件 IO 缓冲区个数；0 表示关闭
+     * @details AsyncFile 通过 leaseBuffer() 租借槽位后，读写以 READ_FIXED/WRITE_FIXED 提交，
+     * 内核不再为每个请求 pin/unpin 用户页。注册失败（如超出 RLIMIT_MEMLOCK）时退回堆缓冲。
+     */
+    uint32_t registered_buffer_count = 0;
+    size_t registered_buffer_size = 64 * 1024;  ///< 单个注册缓冲区容量（字节），按页对齐分配
+
+    /**
+     * @brief 一次性 IO 的 `.timeout()` 是否改用内核侧 `IORING_OP_LINK_TIMEOUT`
+     * @details 开启时 send/writev/readv/connect/sendto/文件读写等一次性 SQE 链接绝对截止时间，
+     * 到期由内核取消目标 SQE，不再进入时间轮；multishot recv/accept 仍使用时间轮。
+     * 内核不支持该 opcode 时自动退回时间轮。
+     */
+    bool linked_timeouts = true;
+
+    IOUringSetupMode setup_mode = IOUringSetupMode::kDefault;  ///< ring setup 策略，见 IOUringSetupMode
+    int32_t sq_thread_cpu = -1;  ///< SQPOLL 线程绑定的 CPU（`IORING_SETUP_SQ_AFF`）；-1 表示不绑定，非 SQPOLL 模式忽略
+    uint32_t sq_thread_idle_ms = 1000;  ///< SQPOLL 线程空闲多久后休眠（毫秒）
+
+    /**
+     * @brief kSharedSqpoll 模式的共享锚点
+     * @details 为空时 Runtime 在创建默认 scheduler 时为本 Runtime 分配一个；直接构造
+     * IOUringScheduler 时需调用方自行共享同一实例，否则每个 ring 仍各自创建 SQPOLL 线程。
+     */
+    std::shared_ptr<IOUringSqpollGroup> sqpoll_group;
+};
+
+} // namespace galay::kernel
+
+#endif // GALAY_KERNEL_URING_OPTIONS_H
@@ -5,7 +5,9 @@
  * @version 1.0.0
  *
  * @details 使用 Linux io_uring 实现 IO 事件注册、multishot accept/recv/recvmsg
- * （配合 provided buffer ring）、send_zc 门控、sequence SQE 提交和 CQE 处理。
+ * （配合 provided buffer ring）、send_zc 门控、fixed-file 提交、
+ * READ_FIXED/WRITE_FIXED 注册缓冲池、LINK_TIMEOUT 内核截止时间、SINGLE_ISSUER/共享 SQPOLL
+ * ring setup、sequence SQE 提交和 CQE 处理。
  */
 
 #include "uring_reactor.h"
@@ -14,7 +16,9 @@
 
 #include "awaitable.h"
 
+#include <fcntl.h>
 #include <sys/eventfd.h>
+#include <sys/mman.h>
 #include <sys/poll.h>
 #include <sys/socket.h>
 #include <sys/utsname.h>
@@ -22,11 +26,14 @@
 
 #include <algorithm>
 #include <charconv>
+#include <cstdlib>
 #include <cerrno>
 #include <cstring>
 #include <expected>
 #include <memory>
+#include <mutex>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #if IO_URING_VERSION_MAJOR > 2 || \
@@ -36,6 +43,12 @@
 #define GALAY_HAS_IO_URING_RECVMSG_MULTISHOT 0
 #endif
 
+#if defined(IORING_SETUP_SINGLE_ISSUER) && defined(IORING_SETUP_DEFER_TASKRUN)
+#define GALAY_HAS_IO_URING_DEFER_TASKRUN 1
+#else
+#define GALAY_HAS_IO_URING_DEFER_TASKRUN 0
+#endif
+
 namespace galay::kernel {
 
 namespace {
@@ -205,7 +218,11 @@ struct RecvBufferPool {
     void shutdown() noexcept {
         active = false;
         if (buf_ring != nullptr) {
-            (void)io_uring_free_buf_ring(ring, buf_ring, ring_entries, buffer_group);
+            if (io_uring_free_buf_ring(ring, buf_ring, ring_entries, buffer_group) < 0) {
+                // SINGLE_ISSUER ring 拒绝非 issuer 线程的注销；ring 退出时内核会一并释放登记，
+                // 这里只归还 liburing 为 buffer ring 建立的映射。
+                ::munmap(buf_ring, ring_entries * sizeof(struct io_uring_buf));
+            }
             buf_ring = nullptr;
         }
     }
@@ -231,6 +248,383 @@ inline auto recvBufferPool(const std::shared_ptr<void>& owner) -> RecvBufferPool
     return static_cast<RecvBufferPool*>(owner.get());
 }
 
+/**
+ * @brief ring 级稀疏 fixed file 表
+ * @details 登记与注销都以 `IORING_OP_FILES_UPDATE` SQE 搭在下一次 poll 的批量提交里，
+ *          不单独发起 register 系统调用，SINGLE_ISSUER ring 上也只由 owner 线程提交。
+ *          槽位状态机：
+ *          - acquire() 只在 owner 线程把槽位标记为待登记；登记 CQE 成功前 controller 仍以普通 fd 提交
+ *          - 归还时先排队清空表项，清空 CQE 到达后才回到 free list；在此之前已排队或
+ *            在途、仍以该下标提交的 SQE 不会被新连接的登记覆盖
+ *          - 跨线程归还（controller 在别的线程析构）只压入加锁的退役队列并唤醒 owner，
+ *            由 owner 在下一次 flush 时处理
+ */
+struct FixedFileTable {
+    enum class SlotState : uint8_t {
+        kFree,         ///< 在 free list 中
+        kStaged,       ///< 已分配，登记 SQE 尚未入队
+        kRegistering,  ///< 登记 SQE 已入队，等待 CQE
+        kLive,         ///< 表项指向 socket，可以 IOSQE_FIXED_FILE 提交
+        kFailed,       ///< 登记失败，controller 继续走普通 fd，归还时直接回收
+        kClearing,     ///< 清空 SQE 已入队，等待 CQE 后回收
+    };
+
+    FixedFileTable(struct io_uring* target_ring, uint32_t slots, int wake)
+        : ring(target_ring)
+        , capacity(slots)
+        , wake_fd(wake) {
+    }
+
+    std::expected<void, IOError> initialize() {
+        const int ret = io_uring_register_files_sparse(ring, capacity);
+        if (ret < 0) {
+            return std::unexpected(IOError(kOpenFailed, static_cast<uint32_t>(-ret)));
+        }
+        states.assign(capacity, SlotState::kFree);
+        retiring.assign(capacity, false);
+        update_fds.assign(capacity, -1);
+        free_slots.reserve(capacity);
+        staged.reserve(capacity);
+        local_retired.reserve(capacity);
+        remote_retired.reserve(capacity);
+        remote_drain.reserve(capacity);
+        for (uint32_t slot = capacity; slot > 0; --slot) {
+            free_slots.push_back(slot - 1);
+        }
+        return {};
+    }
+
+    /** @brief owner 线程分配槽位并排队登记；返回 -1 表示表满 */
+    int32_t acquire(int fd) noexcept {
+        if (!active || free_slots.empty()) {
+            return -1;
+        }
+        const uint32_t slot = free_slots.back();
+        free_slots.pop_back();
+        states[slot] = SlotState::kStaged;
+        retiring[slot] = false;
+        update_fds[slot] = fd;
+        staged.push_back(slot);
+        return static_cast<int32_t>(slot);
+    }
+
+    bool live(uint32_t slot) const noexcept {
+        return active && slot < capacity && states[slot] == SlotState::kLive;
+    }
+
+    /** @brief owner 线程归还槽位 */
+    void retireLocal(uint32_t slot) noexcept {
+        if (active && slot < capacity) {
+            local_retired.push_back(slot);
+        }
+    }
+
+    /** @brief 任意线程归还槽位；owner 在下一次 flush 时处理 */
+    void retireRemote(uint32_t slot) noexcept {
+        std::lock_guard<std::mutex> lock(remote_mutex);
+        if (!active || slot >= capacity) {
+            return;
+        }
+        const bool was_empty = remote_retired.empty();
+        remote_retired.push_back(slot);
+        if (was_empty && wake_fd >= 0) {
+            (void)eventfd_write(wake_fd, 1);
+        }
+    }
+
+    /**
+     * @brief 把待登记与待清空的表项转成 FILES_UPDATE SQE
+     * @details 只在 owner 线程、提交前调用。SQ 不足时留到下一轮，已入队的登记仍按顺序先于清空。
+     */
+    void flush() noexcept {
+        if (!active) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(remote_mutex);
+            remote_drain.swap(remote_retired);
+        }
+        for (const uint32_t slot : remote_drain) {
+            local_retired.push_back(slot);
+        }
+        remote_drain.clear();
+
+        size_t issued = 0;
+        for (; issued < staged.size(); ++issued) {
+            const uint32_t slot = staged[issued];
+            if (states[slot] != SlotState::kStaged) {
+                continue;  // 登记前已归还，retire 分支已直接回收
+            }
+            if (!queueUpdate(slot, update_fds[slot], false)) {
+                break;
+            }
+            states[slot] = SlotState::kRegistering;
+        }
+        staged.erase(staged.begin(), staged.begin() + static_cast<std::ptrdiff_t>(issued));
+
+        size_t retired = 0;
+        for (; retired < local_retired.size(); ++retired) {
+            if (!retire(local_retired[retired])) {
+                break;
+            }
+        }
+        local_retired.erase(local_retired.begin(),
+                            local_retired.begin() + static_cast<std::ptrdiff_t>(retired));
+    }
+
+    /** @brief 处理 FILES_UPDATE CQE */
+    void complete(uint32_t slot, bool clearing, int res) noexcept {
+        if (!active || slot >= capacity) {
+            return;
+        }
+        if (clearing) {
+            // 清空失败时表项仍指向旧 socket；继续留在退役队列重试，不能把槽位交给新连接。
+            if (res < 0) {
+                states[slot] = SlotState::kLive;
+                local_retired.push_back(slot);
+                return;
+            }
+            release(slot);
+            return;
+        }
+        states[slot] = res >= 1 ? SlotState::kLive : SlotState::kFailed;
+        if (retiring[slot]) {
+            retiring[slot] = false;
+            local_retired.push_back(slot);
+        }
+    }
+
+    void shutdown() noexcept {
+        // io_uring_queue_exit 会一并释放整张表，这里只阻止晚到的 controller 再触碰 ring。
+        std::lock_guard<std::mutex> lock(remote_mutex);
+        active = false;
+    }
+
+    static void* userData(uint32_t slot, bool clearing) noexcept {
+        return reinterpret_cast<void*>((static_cast<uintptr_t>(slot) << 3) |
+                                       (clearing ? uintptr_t{4} : uintptr_t{0}) | kUserDataTag);
+    }
+
+    static bool isUserData(const void* data) noexcept {
+        return (reinterpret_cast<uintptr_t>(data) & 0x3) == kUserDataTag;
+    }
+
+    static uint32_t slotOf(const void* data) noexcept {
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data) >> 3);
+    }
+
+    static bool clearingOf(const void* data) noexcept {
+        return (reinterpret_cast<uintptr_t>(data) & 4) != 0;
+    }
+
+    struct io_uring* ring = nullptr;
+    uint32_t capacity = 0;
+    int wake_fd = -1;
+    bool active = true;
+    std::vector<SlotState> states;
+    std::vector<bool> retiring;          // 登记 CQE 未到时已归还，CQE 到达后再清空
+    std::vector<int> update_fds;         // FILES_UPDATE 读取的 fd 数组，必须保持到 CQE
+    std::vector<uint32_t> free_slots;
+    std::vector<uint32_t> staged;
+    std::vector<uint32_t> local_retired;
+    std::mutex remote_mutex;
+    std::vector<uint32_t> remote_retired;
+    std::vector<uint32_t> remote_drain;
+
+private:
+    // SqeRequestHandle 指针至少 8 字节对齐（低两位 00），wakeUserData() 为全 1（低两位 11）。
+    static constexpr uintptr_t kUserDataTag = 0x2;
+
+    bool queueUpdate(uint32_t slot, int fd, bool clearing) noexcept {
+        struct io_uring_sqe* sqe = io_uring_get_sqe(ring);
+        if (!sqe) {
+            return false;
+        }
+        update_fds[slot] = fd;
+        io_uring_prep_files_update(sqe, &update_fds[slot], 1, static_cast<int>(slot));
+        io_uring_sqe_set_data(sqe, userData(slot, clearing));
+        return true;
+    }
+
+    bool retire(uint32_t slot) noexcept {
+        switch (states[slot]) {
+        case SlotState::kStaged:
+        case SlotState::kFailed:
+            // 表项从未指向 socket，无需清空。
+            release(slot);
+            return true;
+        case SlotState::kRegistering:
+            retiring[slot] = true;
+            return true;
+        case SlotState::kLive:
+            if (!queueUpdate(slot, -1, true)) {
+                return false;
+            }
+            states[slot] = SlotState::kClearing;
+            return true;
+        case SlotState::kFree:
+        case SlotState::kClearing:
+            return true;
+        }
+        return true;
+    }
+
+    void release(uint32_t slot) noexcept {
+        states[slot] = SlotState::kFree;
+        retiring[slot] = false;
+        update_fds[slot] = -1;
+        // reserve(capacity) 之后 push_back 不会重新分配。
+        free_slots.push_back(slot);
+    }
+};
+
+inline void recycleFixedFile(const std::shared_ptr<void>& owner, uint32_t slot) noexcept {
+    if (!owner) {
+        return;
+    }
+    static_cast<FixedFileTable*>(owner.get())->retireRemote(slot);
+}
+
+inline auto fixedFileTable(const std::shared_ptr<void>& owner) -> FixedFileTable* {
+    return static_cast<FixedFileTable*>(owner.get());
+}
+
+/**
+ * @brief ring 级文件 IO 注册缓冲池
+ * @details 一次性按页对齐分配连续内存并整体 `io_uring_register_buffers`，槽位通过 free list
+ *          租借；租出的 RegisteredBuffer 持有池的 shared_ptr，ring 退出后内存仍由最后一个切片释放。
+ *          - acquire() 与 owner 线程上的归还直接操作 free list
+ *          - 切片在别的线程（blocking/compute 线程等）析构时只压入加锁的远端归还队列，
+ *            owner 在 free list 耗尽时由 acquire() 取回
+ *          - shutdown() 之后到达的归还直接丢弃
+ */
+struct RegisteredBufferPool {
+    static constexpr size_t kPageSize = 4096;
+
+    RegisteredBufferPool(struct io_uring* target_ring, uint32_t count, size_t size)
+        : ring(target_ring)
+        , buffer_count(count)
+        , buffer_size((size + kPageSize - 1) / kPageSize * kPageSize)
+        , storage(nullptr, &std::free) {
+    }
+
+    std::expected<void, IOError> initialize() {
+        if (buffer_size == 0) {
+            return std::unexpected(IOError(kOpenFailed, static_cast<uint32_t>(EINVAL)));
+        }
+        storage.reset(static_cast<char*>(
+            std::aligned_alloc(kPageSize, buffer_size * static_cast<size_t>(buffer_count))));
+        if (!storage) {
+            return std::unexpected(IOError(kOpenFailed, static_cast<uint32_t>(ENOMEM)));
+        }
+
+        std::vector<struct iovec> iovecs(buffer_count);
+        for (uint32_t index = 0; index < buffer_count; ++index) {
+            iovecs[index].iov_base = storage.get() + static_cast<size_t>(index) * buffer_size;
+            iovecs[index].iov_len = buffer_size;
+        }
+        const int ret = io_uring_register_buffers(ring, iovecs.data(), buffer_count);
+        if (ret < 0) {
+            storage.reset();
+            return std::unexpected(IOError(kOpenFailed, static_cast<uint32_t>(-ret)));
+        }
+
+        free_slots.reserve(buffer_count);
+        remote_recycled.reserve(buffer_count);
+        for (uint32_t index = buffer_count; index > 0; --index) {
+            free_slots.push_back(index - 1);
+        }
+        return {};
+    }
+
+    char* data(uint32_t index) const noexcept {
+        return storage.get() + static_cast<size_t>(index) * buffer_size;
+    }
+
+    /** @brief owner 线程租借槽位；返回 -1 表示池已关闭、长度超出单槽或槽位耗尽 */
+    int32_t acquire(size_t length) noexcept {
+        if (!active || length > buffer_size) {
+            return -1;
+        }
+        if (free_slots.empty()) {
+            std::lock_guard<std::mutex> lock(remote_mutex);
+            // 两个列表合计不超过 buffer_count，reserve 之后 push_back 不会重新分配。
+            free_slots.swap(remote_recycled);
+        }
+        if (free_slots.empty()) {
+            return -1;
+        }
+        const uint32_t index = free_slots.back();
+        free_slots.pop_back();
+        return static_cast<int32_t>(index);
+    }
+
+    /** @brief 任意线程归还槽位 */
+    void recycle(uint32_t index) noexcept {
+        if (index >= buffer_count) {
+            return;
+        }
+        if (std::this_thread::get_id() == owner_thread) {
+            if (active) {
+                free_slots.push_back(index);
+            }
+            return;
+        }
+        std::lock_guard<std::mutex> lock(remote_mutex);
+        if (active) {
+            remote_recycled.push_back(index);
+        }
+    }
+
+    void shutdown() noexcept {
+        // 注册表随 io_uring_queue_exit 一起释放；之后不再租出槽位，晚到的归还直接丢弃。
+        std::lock_guard<std::mutex> lock(remote_mutex);
+        active = false;
+    }
+
+    struct io_uring* ring = nullptr;
+    uint32_t buffer_count = 0;
+    size_t buffer_size = 0;
+    bool active = true;
+    std::thread::id owner_thread;        // 事件循环线程；未绑定时所有归还都走远端队列
+    std::unique_ptr<char, decltype(&std::free)> storage;
+    std::vector<uint32_t> free_slots;
+    std::mutex remote_mutex;
+    std::vector<uint32_t> remote_recycled;
+};
+
+inline void recycleRegisteredBuffer(const std::shared_ptr<void>& owner, uint32_t index) noexcept {
+    if (!owner) {
+        return;
+    }
+    static_cast<RegisteredBufferPool*>(owner.get())->recycle(index);
+}
+
+inline auto registeredBufferPool(const std::shared_ptr<void>& owner) -> RegisteredBufferPool* {
+    return static_cast<RegisteredBufferPool*>(owner.get());
+}
+
+/**
+ * @brief 消费一次性 SQE 完成时的 LINK_TIMEOUT 状态
+ * @details 链接的 LINK_TIMEOUT 到期时内核以 -ECANCELED 取消目标 SQE；close/remove 的取消
+ *          会先让 request 失效，不会走到这里。返回 true 时由 WithTimeout 改写为 kTimeout。
+ */
+inline bool linkTimeoutExpired(IOContextBase* context, const struct io_uring_cqe* cqe) noexcept {
+    if (!context->m_link_timeout_armed) {
+        return false;
+    }
+    context->m_link_timeout_armed = false;
+    if (cqe->res != -ECANCELED) {
+        return false;
+    }
+    context->m_link_timeout_fired = true;
+    return true;
+}
+
+inline bool sequenceEventUsesSocket(IOEventType type) noexcept {
+    return type != FILEREAD && type != FILEWRITE && type != FILEWATCH;
+}
+
 inline auto cqeBufferId(const struct io_uring_cqe* cqe) -> uint16_t {
     return static_cast<uint16_t>(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
 }
@@ -263,14 +657,21 @@ inline bool tryImmediateReadv(int fd, ReadvIOContext* ctx, int& res) {
 
 }  // namespace
 
-IOUringReactor::IOUringReactor(int queue_depth, std::atomic<uint64_t>& last_error_code)
+IOUringReactor::IOUringReactor(int queue_depth,
+                               std::atomic<uint64_t>& last_error_code,
+                               const IOUringOptions& options)
     : m_queue_depth(queue_depth)
+    , m_options(options)
     , m_last_error_code(last_error_code) {}
 
 std::expected<void, IOError> IOUringReactor::start()
 {
     if (m_ring_initialized) {
-        return {};
+        if (!m_issuer_bound) {
+            return {};
+        }
+        // SINGLE_ISSUER ring 已绑定上一任事件循环线程，新线程无法继续提交，只能重建 ring。
+        shutdown();
     }
 
     m_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
@@ -279,27 +680,13 @@ std::expected<void, IOError> IOUringReactor::start()
         return std::unexpected(IOError(kOpenFailed, static_cast<uint32_t>(errno)));
     }
 
-    struct io_uring_params params;
-    std::memset(&params, 0, sizeof(params));
-    params.flags = IORING_SETUP_SQPOLL | IORING_SETUP_COOP_TASKRUN;
-    params.sq_thread_idle = 1000;
-
-    int init_result = io_uring_queue_init_params(m_queue_depth, &m_ring, &params);
+    const int init_result = initializeRing();
     if (init_result < 0) {
-        std::memset(&params, 0, sizeof(params));
-        params.flags = IORING_SETUP_COOP_TASKRUN;
-        init_result = io_uring_queue_init_params(m_queue_depth, &m_ring, &params);
-        if (init_result < 0) {
-            std::memset(&params, 0, sizeof(params));
-            init_result = io_uring_queue_init_params(m_queue_depth, &m_ring, &params);
-            if (init_result < 0) {
-                const uint32_t system_code = static_cast<uint32_t>(-init_result);
-                close(m_event_fd);
-                m_event_fd = -1;
-                detail::storeBackendError(m_last_error_code, kOpenFailed, system_code);
-                return std::unexpected(IOError(kOpenFailed, system_code));
-            }
-        }
+        const uint32_t system_code = static_cast<uint32_t>(-init_result);
+        close(m_event_fd);
+        m_event_fd = -1;
+        detail::storeBackendError(m_last_error_code, kOpenFailed, system_code);
+        return std::unexpected(IOError(kOpenFailed, system_code));
     }
     m_ring_initialized = true;
 
@@ -314,18 +701,46 @@ std::expected<void, IOError> IOUringReactor::start()
             m_last_error_code,
             ioErrorCodeFromError(error),
             systemCodeFromError(error));
+        releaseSqpollAnchor();
         io_uring_queue_exit(&m_ring);
         m_ring_initialized = false;
+        m_ring_disabled = false;
+        m_setup = IOUringSetupStats{};
         close(m_event_fd);
         m_event_fd = -1;
         return std::unexpected(error);
     }
     m_recv_buffer_pool = std::static_pointer_cast<void>(std::move(recv_pool));
 
+    if (m_options.fixed_file_slots > 0) {
+        auto fixed_ready = initializeFixedFiles();
+        if (!fixed_ready) {
+            // fixed-file 只是提交优化；内核不支持稀疏表时退回普通 fd 提交。
+            const auto error = fixed_ready.error();
+            detail::storeBackendError(
+                m_last_error_code,
+                ioErrorCodeFromError(error),
+                systemCodeFromError(error));
+        }
+    }
+
+    if (m_options.registered_buffer_count > 0) {
+        auto buffers_ready = initializeRegisteredBuffers();
+        if (!buffers_ready) {
+            // 注册缓冲只是文件 IO 优化；失败时 AsyncFile 租借回退到堆切片。
+            const auto error = buffers_ready.error();
+            detail::storeBackendError(
+                m_last_error_code,
+                ioErrorCodeFromError(error),
+                systemCodeFromError(error));
+        }
+    }
+
     bool recvmsg_opcode_supported = false;
     if (io_uring_probe* probe = io_uring_get_probe_ring(&m_ring); probe != nullptr) {
         m_send_zc_supported = io_uring_opcode_supported(probe, IORING_OP_SEND_ZC) != 0;
         recvmsg_opcode_supported = io_uring_opcode_supported(probe, IORING_OP_RECVMSG) != 0;
+        m_link_timeout_supported = io_uring_opcode_supported(probe, IORING_OP_LINK_TIMEOUT) != 0;
         io_uring_free_probe(probe);
     }
 
@@ -338,20 +753,167 @@ std::expected<void, IOError> IOUringReactor::start()
 }
 
 IOUringReactor::~IOUringReactor() {
+    shutdown();
+}
+
+void IOUringReactor::shutdown() noexcept {
+    if (m_fixed_files) {
+        fixedFileTable(m_fixed_files)->shutdown();
+        m_fixed_files.reset();
+    }
+    if (m_registered_buffers) {
+        registeredBufferPool(m_registered_buffers)->shutdown();
+        m_registered_buffers.reset();
+    }
     if (m_recvfrom_buffer_pool) {
         recvBufferPool(m_recvfrom_buffer_pool)->shutdown();
+        m_recvfrom_buffer_pool.reset();
     }
     if (m_recv_buffer_pool) {
         recvBufferPool(m_recv_buffer_pool)->shutdown();
+        m_recv_buffer_pool.reset();
     }
     if (m_ring_initialized) {
+        releaseSqpollAnchor();
         io_uring_queue_exit(&m_ring);
+        m_ring_initialized = false;
     }
     if (m_event_fd != -1) {
         close(m_event_fd);
+        m_event_fd = -1;
+    }
+    m_wake_read_armed = false;
+    m_ring_disabled = false;
+    m_issuer_bound = false;
+    m_recvmsg_multishot_confirmed = false;
+    m_setup = IOUringSetupStats{};
+}
+
+int IOUringReactor::tryInitializeRing(uint32_t flags, int attach_fd) noexcept {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    params.flags = flags;
+    if ((flags & IORING_SETUP_SQPOLL) != 0) {
+        params.sq_thread_idle = m_options.sq_thread_idle_ms;
+    }
+    if ((flags & IORING_SETUP_SQ_AFF) != 0) {
+        params.sq_thread_cpu = static_cast<uint32_t>(m_options.sq_thread_cpu);
+    }
+    if ((flags & IORING_SETUP_ATTACH_WQ) != 0) {
+        params.wq_fd = static_cast<uint32_t>(attach_fd);
+    }
+
+    const int ret = io_uring_queue_init_params(m_queue_depth, &m_ring, &params);
+    if (ret == 0) {
+        m_ring_disabled = (flags & IORING_SETUP_R_DISABLED) != 0;
+        m_setup.flags = flags & ~static_cast<uint32_t>(IORING_SETUP_R_DISABLED);
+        m_setup.sq_thread_cpu = (flags & IORING_SETUP_SQ_AFF) != 0 ? m_options.sq_thread_cpu : -1;
+        m_setup.sq_thread_shared = (flags & IORING_SETUP_ATTACH_WQ) != 0;
+        m_setup.active = true;
+    }
+    return ret;
+}
+
+int IOUringReactor::initializeRing() {
+    m_setup = IOUringSetupStats{};
+    m_setup.requested = m_options.setup_mode;
+
+    const uint32_t sq_affinity = m_options.sq_thread_cpu >= 0 ? IORING_SETUP_SQ_AFF : 0;
+    const uint32_t sqpoll_flags = IORING_SETUP_SQPOLL | IORING_SETUP_COOP_TASKRUN | sq_affinity;
+    int ret = -EINVAL;
+
+    switch (m_options.setup_mode) {
+    case IOUringSetupMode::kSingleIssuer:
+#if GALAY_HAS_IO_URING_DEFER_TASKRUN
+        // ring 在当前（启动）线程创建但保持禁用，由事件循环线程 bindIssuerThread() 启用，
+        // 使 SINGLE_ISSUER 记录的提交者正是唯一调用 io_uring_enter 的线程。
+        ret = tryInitializeRing(IORING_SETUP_SINGLE_ISSUER |
+                                IORING_SETUP_DEFER_TASKRUN |
+                                IORING_SETUP_R_DISABLED,
+                                -1);
+#endif
+        break;
+    case IOUringSetupMode::kSharedSqpoll: {
+        IOUringSqpollGroup* group = m_options.sqpoll_group.get();
+        if (group == nullptr) {
+            ret = tryInitializeRing(sqpoll_flags, -1);
+            break;
+        }
+        std::lock_guard<std::mutex> lock(group->mutex);
+        if (group->anchor_fd >= 0) {
+            // 挂载时 SQ 线程的 CPU 与 idle 由锚点 ring 决定。
+            ret = tryInitializeRing(IORING_SETUP_SQPOLL | IORING_SETUP_COOP_TASKRUN |
+                                    IORING_SETUP_ATTACH_WQ,
+                                    group->anchor_fd);
+        }
+        if (ret < 0) {
+            ret = tryInitializeRing(sqpoll_flags, -1);
+            if (ret == 0 && group->anchor_fd < 0) {
+                group->anchor_fd = m_ring.ring_fd;
+                m_sqpoll_anchor = true;
+            }
+        }
+        break;
+    }
+    case IOUringSetupMode::kDefault:
+        ret = tryInitializeRing(sqpoll_flags, -1);
+        break;
+    }
+
+    if (ret < 0) {
+        ret = tryInitializeRing(IORING_SETUP_COOP_TASKRUN, -1);
+    }
+    if (ret < 0) {
+        ret = tryInitializeRing(0, -1);
+    }
+    if (ret < 0) {
+        return ret;
+    }
+
+    switch (m_options.setup_mode) {
+    case IOUringSetupMode::kSingleIssuer:
+        m_setup.fallback = !m_ring_disabled;
+        break;
+    case IOUringSetupMode::kSharedSqpoll:
+    case IOUringSetupMode::kDefault:
+        m_setup.fallback = (m_setup.flags & IORING_SETUP_SQPOLL) == 0;
+        break;
+    }
+    return 0;
+}
+
+void IOUringReactor::releaseSqpollAnchor() noexcept {
+    if (!m_sqpoll_anchor) {
+        return;
+    }
+    m_sqpoll_anchor = false;
+    if (IOUringSqpollGroup* group = m_options.sqpoll_group.get(); group != nullptr) {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        if (group->anchor_fd == m_ring.ring_fd) {
+            group->anchor_fd = -1;
+        }
     }
 }
 
+std::expected<void, IOError> IOUringReactor::bindIssuerThread() {
+    if (m_registered_buffers) {
+        // 注册缓冲槽位只在事件循环线程租借与就地归还，其它线程的归还走加锁队列。
+        registeredBufferPool(m_registered_buffers)->owner_thread = std::this_thread::get_id();
+    }
+    if (!m_ring_disabled) {
+        return {};
+    }
+    const int ret = io_uring_enable_rings(&m_ring);
+    if (ret < 0) {
+        const uint32_t system_code = static_cast<uint32_t>(-ret);
+        detail::storeBackendError(m_last_error_code, kOpenFailed, system_code);
+        return std::unexpected(IOError(kOpenFailed, system_code));
+    }
+    m_ring_disabled = false;
+    m_issuer_bound = true;
+    return {};
+}
+
 void IOUringReactor::notify() {
     uint64_t val = 1;
     if (write(m_event_fd, &val, sizeof(val)) < 0) {
@@ -364,6 +926,121 @@ GHandle IOUringReactor::getHandle() const {
     return {m_event_fd};
 }
 
+std::expected<void, IOError> IOUringReactor::initializeFixedFiles()
+{
+    auto table = std::make_shared<FixedFileTable>(&m_ring, m_options.fixed_file_slots, m_event_fd);
+    auto table_ready = table->initialize();
+    if (!table_ready) {
+        return std::unexpected(table_ready.error());
+    }
+    m_fixed_files = std::static_pointer_cast<void>(std::move(table));
+    return {};
+}
+
+int32_t IOUringReactor::acquireFixedFile(IOController* controller) noexcept {
+    if (!m_fixed_files || controller == nullptr || controller->m_handle == GHandle::invalid()) {
+        return -1;
+    }
+
+    auto* table = fixedFileTable(m_fixed_files);
+    auto& slot = controller->m_fixed_file;
+    if (slot.registered()) {
+        if (slot.owner == m_fixed_files && slot.fd == controller->m_handle.fd) {
+            // 登记 CQE 到达前继续走普通 fd。
+            return table->live(static_cast<uint32_t>(slot.index)) ? slot.index : -1;
+        }
+        // handle 被替换或 controller 换到了另一条 ring：旧槽位必须先归还。
+        if (slot.owner == m_fixed_files) {
+            table->retireLocal(static_cast<uint32_t>(slot.detach()));
+        } else {
+            slot.release();
+        }
+    }
+
+    const int32_t index = table->acquire(controller->m_handle.fd);
+    if (index < 0) {
+        return -1;
+    }
+    slot.owner = m_fixed_files;
+    slot.recycle = recycleFixedFile;
+    slot.fd = controller->m_handle.fd;
+    slot.index = index;
+    return -1;
+}
+
+void IOUringReactor::applyFixedFile(struct io_uring_sqe* sqe,
+                                    IOController* controller) noexcept {
+    const int32_t index = acquireFixedFile(controller);
+    if (index < 0) {
+        return;
+    }
+    sqe->fd = index;
+    sqe->flags |= IOSQE_FIXED_FILE;
+}
+
+std::expected<void, IOError> IOUringReactor::initializeRegisteredBuffers()
+{
+    auto pool = std::make_shared<RegisteredBufferPool>(&m_ring,
+                                                       m_options.registered_buffer_count,
+                                                       m_options.registered_buffer_size);
+    auto pool_ready = pool->initialize();
+    if (!pool_ready) {
+        return std::unexpected(pool_ready.error());
+    }
+    m_registered_buffers = std::static_pointer_cast<void>(std::move(pool));
+    return {};
+}
+
+RegisteredBuffer IOUringReactor::leaseRegisteredBuffer(size_t length) {
+    if (!m_registered_buffers) {
+        return {};
+    }
+    auto* pool = registeredBufferPool(m_registered_buffers);
+    const int32_t index = pool->acquire(length);
+    if (index < 0) {
+        return {};
+    }
+    const auto slot = static_cast<uint32_t>(index);
+    return RegisteredBuffer(m_registered_buffers,
+                            recycleRegisteredBuffer,
+                            pool->data(slot),
+                            pool->buffer_size,
+                            slot);
+}
+
+bool IOUringReactor::usesRegisteredBuffer(int32_t index, const void* owner) const noexcept {
+    // 其它 ring 租出的切片索引在本 ring 无意义，只能按普通用户内存提交。
+    return index >= 0 && m_registered_buffers && owner == m_registered_buffers.get();
+}
+
+struct io_uring_sqe* IOUringReactor::getSqeFor(IOContextBase* context) noexcept {
+    // LINK_TIMEOUT 必须紧跟目标 SQE；SQ 只剩一个空位时先把已排队的 SQE 交给内核，
+    // 否则目标 SQE 占掉最后一个空位后 timeout 无处可放。
+    const unsigned needed =
+        context != nullptr && context->m_link_timeout && linkedTimeoutsEnabled() ? 2u : 1u;
+    if (io_uring_sq_space_left(&m_ring) < needed) {
+        (void)io_uring_submit(&m_ring);
+    }
+    return io_uring_get_sqe(&m_ring);
+}
+
+void IOUringReactor::linkTimeout(struct io_uring_sqe* sqe, IOContextBase* context) noexcept {
+    if (context == nullptr || !context->m_link_timeout || !linkedTimeoutsEnabled()) {
+        return;
+    }
+    // getSqeFor() 已预留两个空位；提交失败导致仍取不到时，截止时间交还时间轮，
+    // 首次提交与重新提交（部分完成、EAGAIN）都不会丢失。
+    struct io_uring_sqe* timeout_sqe = io_uring_get_sqe(&m_ring);
+    if (!timeout_sqe) {
+        context->fallBackFromLinkTimeout();
+        return;
+    }
+    sqe->flags |= IOSQE_IO_LINK;
+    io_uring_prep_link_timeout(timeout_sqe, &context->m_link_deadline, IORING_TIMEOUT_ABS);
+    io_uring_sqe_set_data(timeout_sqe, nullptr);
+    context->setLinkTimeoutArmed(true);
+}
+
 bool IOUringReactor::shouldUseSendZc(size_t length) const noexcept {
     return m_send_zc_supported && length >= kSendZcThreshold;
 }
@@ -433,6 +1110,7 @@ int IOUringReactor::submitMultishotAccept(IOController* controller) {
                                    nullptr,
                                    nullptr,
                                    SOCK_NONBLOCK | SOCK_CLOEXEC);
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
     handle->persistent = true;
     controller->m_accept_multishot_handle = handle;
@@ -448,7 +1126,7 @@ int IOUringReactor::addConnect(IOController* controller) {
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
@@ -458,7 +1136,9 @@ int IOUringReactor::addConnect(IOController* controller) {
                           controller->m_handle.fd,
                           awaitable->m_host.sockAddr(),
                           *awaitable->m_host.addrLen());
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
     return 0;
 }
 
@@ -501,6 +1181,7 @@ int IOUringReactor::submitMultishotRecv(IOController* controller) {
     io_uring_prep_recv_multishot(sqe, controller->m_handle.fd, nullptr, 0, 0);
     sqe->flags |= IOSQE_BUFFER_SELECT;
     sqe->buf_group = kRecvBufferGroup;
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
     handle->persistent = true;
     controller->m_recv_multishot_handle = handle;
@@ -516,7 +1197,7 @@ int IOUringReactor::addSend(IOController* controller) {
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
@@ -528,7 +1209,9 @@ int IOUringReactor::addSend(IOController* controller) {
                    awaitable->m_buffer,
                    awaitable->m_length,
                    0);
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
     return 0;
 }
 
@@ -540,7 +1223,7 @@ int IOUringReactor::addReadv(IOController* controller) {
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
@@ -556,7 +1239,9 @@ int IOUringReactor::addReadv(IOController* controller) {
     } else {
         io_uring_prep_recvmsg(sqe, controller->m_handle.fd, &awaitable->m_msg, 0);
     }
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
     return 0;
 }
 
@@ -568,7 +1253,7 @@ int IOUringReactor::addWritev(IOController* controller) {
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
@@ -584,7 +1269,9 @@ int IOUringReactor::addWritev(IOController* controller) {
     } else {
         io_uring_prep_sendmsg(sqe, controller->m_handle.fd, &awaitable->m_msg, kSendNoSignalFlag);
     }
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
     return 0;
 }
 
@@ -596,17 +1283,73 @@ int IOUringReactor::addSendFile(IOController* controller) {
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
     }
 
     io_uring_prep_poll_add(sqe, controller->m_handle.fd, POLLOUT);
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
+    return 0;
+}
+
+int IOUringReactor::submitSplice(IOController* controller,
+                                 SpliceIOContext* context,
+                                 IOController::Index slot,
+                                 unsigned poll_mask) {
+    // IORING_OP_SPLICE 不支持内核的 fast poll，socket 未就绪时只能在 io-wq 里阻塞；
+    // 先链接一个 POLL_ADD 等就绪，再以 SPLICE_F_NONBLOCK 搬运。splice 的短结果会
+    // 打断链接，所以 socket→管道 与 管道→socket 两段各自成链，不串成一条。
+    // LINK_TIMEOUT 只能守住紧邻的 SQE，挂在 splice 后面时守不住等待阶段，因此不链接，
+    // WithTimeout 据 m_link_timeout_armed=false 退回时间轮。
+    if (io_uring_sq_space_left(&m_ring) < 2) {
+        return -EAGAIN;
+    }
+    auto* handle = controller->makeSqeRequest(slot);
+    if (handle == nullptr) {
+        return -ENOMEM;
+    }
+
+    struct io_uring_sqe* poll_sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* splice_sqe = io_uring_get_sqe(&m_ring);
+    if (!poll_sqe || !splice_sqe) {
+        handle->recycle();
+        return -EAGAIN;
+    }
+
+    io_uring_prep_poll_add(poll_sqe, controller->m_handle.fd, poll_mask);
+    applyFixedFile(poll_sqe, controller);
+    poll_sqe->flags |= IOSQE_IO_LINK;
+    io_uring_sqe_set_data(poll_sqe, nullptr);
+
+    const int fd_in = context->m_to_pipe ? controller->m_handle.fd : context->m_pipe_fd;
+    const int fd_out = context->m_to_pipe ? context->m_pipe_fd : controller->m_handle.fd;
+    io_uring_prep_splice(splice_sqe,
+                         fd_in,
+                         -1,
+                         fd_out,
+                         -1,
+                         static_cast<unsigned>(context->m_length),
+                         SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    io_uring_sqe_set_data(splice_sqe, handle);
     return 0;
 }
 
+int IOUringReactor::addSpliceIn(IOController* controller) {
+    auto* awaitable = controller->getAwaitable<SpliceInAwaitable>();
+    if (awaitable == nullptr) return -1;
+    return submitSplice(controller, awaitable, IOController::READ, POLLIN);
+}
+
+int IOUringReactor::addSpliceOut(IOController* controller) {
+    auto* awaitable = controller->getAwaitable<SpliceOutAwaitable>();
+    if (awaitable == nullptr) return -1;
+    return submitSplice(controller, awaitable, IOController::WRITE, POLLOUT);
+}
+
 int IOUringReactor::addClose(IOController* controller) {
     if (controller == nullptr || controller->m_handle == GHandle::invalid()) {
         return 0;
@@ -627,6 +1370,13 @@ int IOUringReactor::addClose(IOController* controller) {
         io_uring_prep_close(close_sqe, fd);
         io_uring_sqe_set_data(close_sqe, nullptr);
     }
+    // 清空表项的 FILES_UPDATE 排在本批次 close 之后提交，CQE 到达前槽位不会分给新连接，
+    // 仍以该下标排队或在途的 SQE 不会落到别的 socket 上。
+    if (controller->m_fixed_file.registered() && controller->m_fixed_file.owner == m_fixed_files) {
+        fixedFileTable(m_fixed_files)->retireLocal(static_cast<uint32_t>(controller->m_fixed_file.detach()));
+    } else {
+        controller->m_fixed_file.release();
+    }
 
     controller->m_type = IOEventType::INVALID;
     controller->m_awaitable[IOController::READ] = nullptr;
@@ -644,18 +1394,28 @@ int IOUringReactor::addFileRead(IOController* controller) {
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
     }
 
-    io_uring_prep_read(sqe,
-                       controller->m_handle.fd,
-                       awaitable->m_buffer,
-                       awaitable->m_length,
-                       awaitable->m_offset);
+    if (usesRegisteredBuffer(awaitable->m_buf_index, awaitable->m_buf_owner)) {
+        io_uring_prep_read_fixed(sqe,
+                                 controller->m_handle.fd,
+                                 awaitable->m_buffer,
+                                 static_cast<unsigned>(awaitable->m_length),
+                                 awaitable->m_offset,
+                                 awaitable->m_buf_index);
+    } else {
+        io_uring_prep_read(sqe,
+                           controller->m_handle.fd,
+                           awaitable->m_buffer,
+                           awaitable->m_length,
+                           awaitable->m_offset);
+    }
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
     return 0;
 }
 
@@ -667,28 +1427,35 @@ int IOUringReactor::addFileWrite(IOController* controller) {
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
     }
 
-    io_uring_prep_write(sqe,
-                        controller->m_handle.fd,
-                        awaitable->m_buffer,
-                        awaitable->m_length,
-                        awaitable->m_offset);
+    if (usesRegisteredBuffer(awaitable->m_buf_index, awaitable->m_buf_owner)) {
+        io_uring_prep_write_fixed(sqe,
+                                  controller->m_handle.fd,
+                                  awaitable->m_buffer,
+                                  static_cast<unsigned>(awaitable->m_length),
+                                  awaitable->m_offset,
+                                  awaitable->m_buf_index);
+    } else {
+        io_uring_prep_write(sqe,
+                            controller->m_handle.fd,
+                            awaitable->m_buffer,
+                            awaitable->m_length,
+                            awaitable->m_offset);
+    }
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
     return 0;
 }
 
 int IOUringReactor::addRecvFrom(IOController* controller) {
     auto* awaitable = controller->getAwaitable<RecvFromAwaitable>();
     if (awaitable == nullptr) return -1;
-    if (controller->tryConsumeReadyRecvFrom(awaitable->m_buffer,
-                                            awaitable->m_length,
-                                            awaitable->m_from,
-                                            awaitable->m_result)) {
+    if (awaitable->consumeReadyDatagrams(controller)) {
         return kImmediateReady;
     }
     if (m_recvmsg_multishot_supported) {
@@ -759,10 +1526,13 @@ int IOUringReactor::submitMultishotRecvFrom(IOController* controller)
 
     std::memset(message, 0, sizeof(*message));
     message->msg_namelen = sizeof(sockaddr_storage);
+    // 预留一个 int cmsg：socket 开启 UDP_GRO 时内核在此回报合并段大小
+    message->msg_controllen = kRecvFromControlSize;
 
     io_uring_prep_recvmsg_multishot(sqe, controller->m_handle.fd, message, 0);
     sqe->flags |= IOSQE_BUFFER_SELECT;
     sqe->buf_group = kRecvFromBufferGroup;
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
     handle->persistent = true;
     controller->m_recvfrom_multishot_handle = handle;
@@ -782,7 +1552,7 @@ int IOUringReactor::addRecvFromOneShot(IOController* controller,
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
@@ -798,24 +1568,41 @@ int IOUringReactor::addRecvFromOneShot(IOController* controller,
     awaitable->m_msg.msg_namelen = sizeof(awaitable->m_addr);
 
     io_uring_prep_recvmsg(sqe, controller->m_handle.fd, &awaitable->m_msg, 0);
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
     return 0;
 }
 
 int IOUringReactor::addSendTo(IOController* controller) {
     auto* awaitable = controller->getAwaitable<SendToAwaitable>();
     if (awaitable == nullptr) return -1;
+    if (awaitable->sendsOnWritable()) {
+        // io_uring 没有 sendmmsg 操作码：先内联尝试，发送队列满时等待 POLLOUT 再由 handleComplete 发送
+        io_uring_cqe ready_cqe{};
+        ready_cqe.res = POLLOUT;
+        if (awaitable->handleComplete(&ready_cqe, controller->m_handle)) {
+            return kImmediateReady;
+        }
+    }
     auto* handle = controller->makeSqeRequest(IOController::WRITE);
     if (handle == nullptr) {
         return -ENOMEM;
     }
 
-    struct io_uring_sqe* sqe = io_uring_get_sqe(&m_ring);
+    struct io_uring_sqe* sqe = getSqeFor(awaitable);
     if (!sqe) {
         handle->recycle();
         return -EAGAIN;
     }
 
+    if (awaitable->sendsOnWritable()) {
+        io_uring_prep_poll_add(sqe, controller->m_handle.fd, POLLOUT);
+        io_uring_sqe_set_data(sqe, handle);
+        linkTimeout(sqe, awaitable);
+        return 0;
+    }
+
     std::memset(&awaitable->m_msg, 0, sizeof(awaitable->m_msg));
     awaitable->m_iov.iov_base = const_cast<char*>(awaitable->m_buffer);
     awaitable->m_iov.iov_len = awaitable->m_length;
@@ -825,7 +1612,9 @@ int IOUringReactor::addSendTo(IOController* controller) {
     awaitable->m_msg.msg_namelen = *awaitable->m_to.addrLen();
 
     io_uring_prep_sendmsg(sqe, controller->m_handle.fd, &awaitable->m_msg, kSendNoSignalFlag);
+    applyFixedFile(sqe, controller);
     io_uring_sqe_set_data(sqe, handle);
+    linkTimeout(sqe, awaitable);
     return 0;
 }
 
@@ -984,12 +1773,22 @@ int IOUringReactor::submitSequenceSqe(IOController::Index slot,
     }
     case FILEREAD: {
         auto* c = static_cast<FileReadIOContext*>(ctx);
-        io_uring_prep_read(sqe, controller->m_handle.fd, c->m_buffer, c->m_length, c->m_offset);
+        if (usesRegisteredBuffer(c->m_buf_index, c->m_buf_owner)) {
+            io_uring_prep_read_fixed(sqe, controller->m_handle.fd, c->m_buffer,
+                                     static_cast<unsigned>(c->m_length), c->m_offset, c->m_buf_index);
+        } else {
+            io_uring_prep_read(sqe, controller->m_handle.fd, c->m_buffer, c->m_length, c->m_offset);
+        }
         break;
     }
     case FILEWRITE: {
         auto* c = static_cast<FileWriteIOContext*>(ctx);
-        io_uring_prep_write(sqe, controller->m_handle.fd, c->m_buffer, c->m_length, c->m_offset);
+        if (usesRegisteredBuffer(c->m_buf_index, c->m_buf_owner)) {
+            io_uring_prep_write_fixed(sqe, controller->m_handle.fd, c->m_buffer,
+                                      static_cast<unsigned>(c->m_length), c->m_offset, c->m_buf_index);
+        } else {
+            io_uring_prep_write(sqe, controller->m_handle.fd, c->m_buffer, c->m_length, c->m_offset);
+        }
         break;
     }
     case RECVFROM: {
@@ -1030,6 +1829,9 @@ int IOUringReactor::submitSequenceSqe(IOController::Index slot,
         return -EINVAL;
     }
 
+    if (sequenceEventUsesSocket(type)) {
+        applyFixedFile(sqe, controller);
+    }
     owner->m_sqe_type = SEQUENCE;
     controller->m_awaitable[slot] = owner;
     io_uring_sqe_set_data(sqe, handle);
@@ -1068,6 +1870,9 @@ void IOUringReactor::ensureWakeReadArmed() {
 
 void IOUringReactor::poll(uint64_t timeout_ns, WakeCoordinator& wake_coordinator) {
     ensureWakeReadArmed();
+    if (m_fixed_files) {
+        fixedFileTable(m_fixed_files)->flush();
+    }
 
     struct io_uring_cqe* cqe = nullptr;
     struct __kernel_timespec timeout;
@@ -1093,6 +1898,12 @@ void IOUringReactor::poll(uint64_t timeout_ns, WakeCoordinator& wake_coordinator
         if (user_data == wakeUserData()) {
             wake_triggered = true;
             m_wake_read_armed = false;
+        } else if (FixedFileTable::isUserData(user_data)) {
+            if (m_fixed_files) {
+                fixedFileTable(m_fixed_files)->complete(FixedFileTable::slotOf(user_data),
+                                                        FixedFileTable::clearingOf(user_data),
+                                                        cqe->res);
+            }
         } else if (user_data != nullptr) {
             processCompletion(cqe);
         }
@@ -1175,7 +1986,8 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
     }
     case CONNECT: {
         auto* awaitable = static_cast<ConnectAwaitable*>(base);
-        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+        if (linkTimeoutExpired(awaitable, cqe) ||
+            awaitable->handleComplete(cqe, controller->m_handle)) {
             awaitable->m_waker.wakeUp();
         } else {
             const int ret = addConnect(controller);
@@ -1194,7 +2006,8 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
     }
     case SEND: {
         auto* awaitable = static_cast<SendAwaitable*>(base);
-        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+        if (linkTimeoutExpired(awaitable, cqe) ||
+            awaitable->handleComplete(cqe, controller->m_handle)) {
             awaitable->m_waker.wakeUp();
         } else {
             const int ret = addSend(controller);
@@ -1208,7 +2021,8 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
     }
     case READV: {
         auto* awaitable = static_cast<ReadvAwaitable*>(base);
-        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+        if (linkTimeoutExpired(awaitable, cqe) ||
+            awaitable->handleComplete(cqe, controller->m_handle)) {
             awaitable->m_waker.wakeUp();
         } else {
             const int ret = addReadv(controller);
@@ -1222,7 +2036,8 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
     }
     case WRITEV: {
         auto* awaitable = static_cast<WritevAwaitable*>(base);
-        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+        if (linkTimeoutExpired(awaitable, cqe) ||
+            awaitable->handleComplete(cqe, controller->m_handle)) {
             awaitable->m_waker.wakeUp();
         } else {
             const int ret = addWritev(controller);
@@ -1236,7 +2051,8 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
     }
     case FILEREAD: {
         auto* awaitable = static_cast<FileReadAwaitable*>(base);
-        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+        if (linkTimeoutExpired(awaitable, cqe) ||
+            awaitable->handleComplete(cqe, controller->m_handle)) {
             awaitable->m_waker.wakeUp();
         } else {
             const int ret = addFileRead(controller);
@@ -1250,7 +2066,8 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
     }
     case FILEWRITE: {
         auto* awaitable = static_cast<FileWriteAwaitable*>(base);
-        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+        if (linkTimeoutExpired(awaitable, cqe) ||
+            awaitable->handleComplete(cqe, controller->m_handle)) {
             awaitable->m_waker.wakeUp();
         } else {
             const int ret = addFileWrite(controller);
@@ -1267,7 +2084,8 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
         if (controller->m_recvfrom_multishot_armed) {
             processRecvFromCompletion(controller, awaitable, handle, cqe);
         } else {
-            if (awaitable->handleComplete(cqe, controller->m_handle)) {
+            if (linkTimeoutExpired(awaitable, cqe) ||
+                awaitable->handleComplete(cqe, controller->m_handle)) {
                 awaitable->m_waker.wakeUp();
             } else {
                 const int ret = addRecvFrom(controller);
@@ -1282,11 +2100,14 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
     }
     case SENDTO: {
         auto* awaitable = static_cast<SendToAwaitable*>(base);
-        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+        if (linkTimeoutExpired(awaitable, cqe) ||
+            awaitable->handleComplete(cqe, controller->m_handle)) {
             awaitable->m_waker.wakeUp();
         } else {
             const int ret = addSendTo(controller);
-            if (ret < 0) {
+            if (ret == kImmediateReady) {
+                awaitable->m_waker.wakeUp();
+            } else if (ret < 0) {
                 awaitable->m_result =
                     std::unexpected(IOError(kSendFailed, negativeRetOrErrno(ret)));
                 awaitable->m_waker.wakeUp();
@@ -1310,7 +2131,8 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
     }
     case SENDFILE: {
         auto* awaitable = static_cast<SendFileAwaitable*>(base);
-        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+        if (linkTimeoutExpired(awaitable, cqe) ||
+            awaitable->handleComplete(cqe, controller->m_handle)) {
             awaitable->m_waker.wakeUp();
         } else {
             const int ret = addSendFile(controller);
@@ -1322,6 +2144,34 @@ void IOUringReactor::processCompletion(struct io_uring_cqe* cqe) {
         }
         break;
     }
+    case SPLICEIN: {
+        auto* awaitable = static_cast<SpliceInAwaitable*>(base);
+        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+            awaitable->m_waker.wakeUp();
+        } else {
+            const int ret = addSpliceIn(controller);
+            if (ret < 0) {
+                awaitable->m_result =
+                    std::unexpected(IOError(kRecvFailed, negativeRetOrErrno(ret)));
+                awaitable->m_waker.wakeUp();
+            }
+        }
+        break;
+    }
+    case SPLICEOUT: {
+        auto* awaitable = static_cast<SpliceOutAwaitable*>(base);
+        if (awaitable->handleComplete(cqe, controller->m_handle)) {
+            awaitable->m_waker.wakeUp();
+        } else {
+            const int ret = addSpliceOut(controller);
+            if (ret < 0) {
+                awaitable->m_result =
+                    std::unexpected(IOError(kSendFailed, negativeRetOrErrno(ret)));
+                awaitable->m_waker.wakeUp();
+            }
+        }
+        break;
+    }
     case SEQUENCE: {
         auto* sequence = static_cast<SequenceAwaitableBase*>(base);
         const auto event_type = sequence->activeEventType();
@@ -1564,6 +2414,18 @@ void IOUringReactor::processRecvFromCompletion(IOController* controller,
                             source_length);
                 datagram.data = static_cast<char*>(io_uring_recvmsg_payload(output, message));
                 datagram.length = io_uring_recvmsg_payload_length(output, cqe->res, message);
+                datagram.truncated = (output->flags & MSG_TRUNC) != 0;
+                for (auto* cmsg = io_uring_recvmsg_cmsg_firsthdr(output, message);
+                     cmsg != nullptr;
+                     cmsg = io_uring_recvmsg_cmsg_nexthdr(output, message, cmsg)) {
+                    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                        int segment_size = 0;
+                        std::memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+                        datagram.segment_size = segment_size > 0
+                            ? static_cast<uint16_t>(segment_size)
+                            : 0;
+                    }
+                }
             }
         }
         controller->enqueueReadyRecvFrom(std::move(datagram));
@@ -1576,10 +2438,7 @@ void IOUringReactor::processRecvFromCompletion(IOController* controller,
     }
 
     if (awaitable != nullptr && !cancelled && !controller->m_recvfrom_result_assigned &&
-        controller->tryConsumeReadyRecvFrom(awaitable->m_buffer,
-                                            awaitable->m_length,
-                                            awaitable->m_from,
-                                            awaitable->m_result)) {
+        awaitable->consumeReadyDatagrams(controller)) {
         controller->m_recvfrom_result_assigned = true;
         awaitable->m_waker.wakeUp();
     }
@@ -6,7 +6,8 @@
  *
  * @details 使用 Linux io_uring 满足高吞吐异步 IO 的 ReactorType concept。
  * 支持 multishot accept/recv/recvmsg（配合 provided buffer ring）、
- * send_zc（用于大负载零拷贝发送）和 eventfd 跨线程唤醒。
+ * send_zc（用于大负载零拷贝发送）、可选 fixed-file 提交、可配置 ring setup
+ * （SINGLE_ISSUER/DEFER_TASKRUN、共享 SQPOLL）和 eventfd 跨线程唤醒。
  */
 
 #ifndef GALAY_KERNEL_IOURING_REACTOR_H
@@ -14,6 +15,7 @@
 
 #include "backend_reactor.h"
 #include "io_scheduler.hpp"
+#include "uring_options.h"
 #include "wake_coordinator.h"
 
 #ifdef USE_IOURING
@@ -39,7 +41,9 @@ namespace galay::kernel {
 class IOUringReactor
 {
 public:
-    IOUringReactor(int queue_depth, std::atomic<uint64_t>& last_error_code);  ///< 构造 io_uring reactor，并绑定错误输出槽位
+    IOUringReactor(int queue_depth,
+                   std::atomic<uint64_t>& last_error_code,
+                   const IOUringOptions& options = IOUringOptions{});  ///< 构造 io_uring reactor，并绑定错误输出槽位与可选特性
     ~IOUringReactor();  ///< 释放 io_uring ring 和唤醒 fd 资源
 
     IOUringReactor(const IOUringReactor&) = delete;
@@ -47,7 +51,13 @@ public:
 
     void notify();  ///< 从其他线程唤醒阻塞中的 io_uring wait
     GHandle getHandle() const;  ///< 返回测试可见的 eventfd 读端句柄
-    std::expected<void, IOError> start();  ///< 显式初始化 eventfd、io_uring ring 和 recv buffer ring
+    std::expected<void, IOError> start();  ///< 显式初始化 eventfd、io_uring ring、recv buffer ring 以及可选 fixed file 表和注册缓冲池
+    std::expected<void, IOError> bindIssuerThread();  ///< 在事件循环线程上启用 SINGLE_ISSUER ring，使其成为唯一提交者（其它 setup 为空操作），并把注册缓冲池绑定到该线程
+    IOUringSetupStats setupStats() const noexcept { return m_setup; }  ///< 返回 ring 最终生效的 setup
+    bool fixedFilesEnabled() const noexcept { return m_fixed_files != nullptr; }  ///< fixed-file 模式是否已在当前 ring 生效
+    bool registeredBuffersEnabled() const noexcept { return m_registered_buffers != nullptr; }  ///< 注册缓冲池是否已在当前 ring 生效
+    bool linkedTimeoutsEnabled() const noexcept { return m_options.linked_timeouts && m_link_timeout_supported; }  ///< 一次性 IO 超时是否走内核 LINK_TIMEOUT
+    RegisteredBuffer leaseRegisteredBuffer(size_t length);  ///< 从注册缓冲池租借切片；未启用、容量不足或耗尽时返回无效切片
 
     int addAccept(IOController* controller);  ///< 注册 accept 请求；1=立即完成，0=已提交，<0=错误
     int addConnect(IOController* controller);  ///< 注册 connect 请求；1=立即完成，0=已提交，<0=错误
@@ -62,18 +72,37 @@ public:
     int addSendTo(IOController* controller);  ///< 注册 sendto 请求；1=立即完成，0=已提交，<0=错误
     int addFileWatch(IOController* controller);  ///< 注册文件监控请求；1=立即完成，0=已提交，<0=错误
     int addSendFile(IOController* controller);  ///< 注册 sendfile 请求；1=立即完成，0=已提交，<0=错误
+    int addSpliceIn(IOController* controller);  ///< 提交 POLLIN → socket→管道 splice 链；0=已提交，<0=错误
+    int addSpliceOut(IOController* controller); ///< 提交 POLLOUT → 管道→socket splice 链；0=已提交，<0=错误
     int addSequence(IOController* controller);  ///< 注册组合式序列请求；0=已提交或已唤醒立即完成 owner，<0=错误
     int remove(IOController* controller);  ///< 使控制器关联的未完成请求失效或移除
 
     void poll(uint64_t timeout_ns, WakeCoordinator& wake_coordinator);  ///< 等待完成事件并通过 wake coordinator 分发唤醒
 
 private:
+    int initializeRing();  ///< 按 IOUringSetupMode 逐级探测创建 ring；0=成功，<0=最后一次尝试的 -errno
+    int tryInitializeRing(uint32_t flags, int attach_fd) noexcept;  ///< 以给定 IORING_SETUP_* 尝试创建 ring，成功时记录 setup 统计
+    void releaseSqpollAnchor() noexcept;  ///< 若本 ring 是共享 SQPOLL 锚点，则从 IOUringSqpollGroup 撤销登记
+    void shutdown() noexcept;  ///< 释放 ring 及其注册资源并复位状态；析构与 SINGLE_ISSUER 重建共用
     int submitMultishotAccept(IOController* controller);  ///< 为 listener 提交持久 multishot accept SQE
     int submitMultishotRecv(IOController* controller);  ///< 为 socket 提交持久 multishot recv SQE
     int submitMultishotRecvFrom(IOController* controller);  ///< 为 UDP socket 提交持久 multishot recvmsg SQE
     std::expected<void, IOError> initializeRecvFromBufferPool();  ///< 首次 UDP recvfrom 时惰性初始化 provided-buffer ring
     int addRecvFromOneShot(IOController* controller,
                            RecvFromAwaitable* awaitable);  ///< 能力不足时提交兼容 one-shot recvmsg SQE
+    std::expected<void, IOError> initializeFixedFiles();  ///< 按配置注册稀疏 fixed file 表
+    int32_t acquireFixedFile(IOController* controller) noexcept;  ///< 返回 controller 已登记生效的槽位；未启用、表满或登记 CQE 尚未到达时返回 -1（首次调用只排队登记）
+    void applyFixedFile(struct io_uring_sqe* sqe,
+                        IOController* controller) noexcept;  ///< 若 controller 已登记槽位，则把 SQE 改写为 IOSQE_FIXED_FILE 提交
+    std::expected<void, IOError> initializeRegisteredBuffers();  ///< 按配置分配并注册文件 IO 缓冲池
+    bool usesRegisteredBuffer(int32_t index, const void* owner) const noexcept;  ///< 切片是否属于当前 ring 的注册缓冲池
+    struct io_uring_sqe* getSqeFor(IOContextBase* context) noexcept;  ///< 取目标 SQE；context 需要 LINK_TIMEOUT 时先确保 SQ 留有两个空位
+    void linkTimeout(struct io_uring_sqe* sqe,
+                     IOContextBase* context) noexcept;  ///< 若 context 请求内核截止时间，则在 sqe 之后链接 LINK_TIMEOUT SQE；取不到时交还时间轮
+    int submitSplice(IOController* controller,
+                     SpliceIOContext* context,
+                     IOController::Index slot,
+                     unsigned poll_mask);  ///< 提交 POLL_ADD → IORING_OP_SPLICE 链接 SQE 对
     bool shouldUseSendZc(size_t length) const noexcept;  ///< 当前 send 请求是否应走 send_zc 路径
     void prepareSendSqe(struct io_uring_sqe* sqe,
                         SqeRequestHandle* handle,
@@ -104,8 +133,10 @@ private:
     static constexpr size_t kRecvBufferSize = 8192;  ///< 单个 provided buffer 的容量
     static constexpr uint16_t kRecvFromBufferGroup = 1;  ///< UDP recvmsg 使用的独立 buffer group id
     static constexpr uint16_t kRecvFromBufferCount = 256;  ///< UDP provided buffer ring 的 buffer 数量
+    static constexpr size_t kRecvFromControlSize = 32;  ///< multishot recvmsg 预留的 cmsg 空间，容纳 UDP_GRO 段大小
     static constexpr size_t kRecvFromBufferSize =
-        65536 + sizeof(uint32_t) * 4 + sizeof(sockaddr_storage);  ///< 覆盖最大 UDP payload 与 recvmsg 元数据
+        65536 + sizeof(uint32_t) * 4 + sizeof(sockaddr_storage) +
+        kRecvFromControlSize;  ///< 覆盖最大 UDP payload、recvmsg 元数据与 GRO cmsg
     static constexpr size_t kSendZcThreshold = 4096;  ///< 大于等于该阈值的 send 请求优先尝试 send_zc
 
     struct io_uring m_ring {};  ///< io_uring ring 实例
@@ -114,11 +145,19 @@ private:
     uint64_t m_eventfd_buf = 0;  ///< eventfd 读缓冲
     bool m_ring_initialized = false;  ///< io_uring ring 是否已经初始化
     bool m_wake_read_armed = false;  ///< eventfd 读请求是否已挂到 ring
+    bool m_ring_disabled = false;  ///< ring 以 R_DISABLED 创建且尚未由事件循环线程启用
+    bool m_issuer_bound = false;  ///< SINGLE_ISSUER ring 已绑定某个事件循环线程
+    bool m_sqpoll_anchor = false;  ///< 本 ring 是否登记为共享 SQPOLL 锚点
     bool m_send_zc_supported = false;  ///< 当前内核/liburing 是否支持 IORING_OP_SEND_ZC
+    bool m_link_timeout_supported = false;  ///< 当前内核是否支持 IORING_OP_LINK_TIMEOUT
     bool m_recvmsg_multishot_supported = false;  ///< 内核>=6.0、liburing 与 RECVMSG opcode 均支持 multishot
     bool m_recvmsg_multishot_confirmed = false;  ///< 是否已收到成功 CQE，避免把后续 EINVAL 误判为能力缺失
     std::shared_ptr<void> m_recv_buffer_pool;  ///< recv provided buffer ring 的共享所有权
     std::shared_ptr<void> m_recvfrom_buffer_pool;  ///< UDP recvmsg provided buffer ring 的共享所有权
+    std::shared_ptr<void> m_fixed_files;  ///< fixed file 表的共享所有权；为空表示 fixed-file 模式未启用
+    std::shared_ptr<void> m_registered_buffers;  ///< 注册缓冲池的共享所有权；租出的切片同样持有，保证内存晚于切片释放
+    IOUringOptions m_options;  ///< 构造时传入的可选特性配置
+    IOUringSetupStats m_setup;  ///< ring 最终生效的 setup，供 RuntimeStats 采样
     std::atomic<uint64_t>& m_last_error_code;  ///< 最近一次后端错误编码输出槽位
 };
 
@@ -9,6 +9,7 @@
  */
 
 #include "uring_scheduler.h"
+#include "numa_topology.h"
 #include "sched_loop.hpp"
 
 #ifdef USE_IOURING
@@ -18,14 +19,16 @@
 namespace galay::kernel
 {
 
-IOUringScheduler::IOUringScheduler(int queue_depth, int batch_size)
+IOUringScheduler::IOUringScheduler(int queue_depth,
+                                   int batch_size,
+                                   const IOUringOptions& options)
     : m_running(false)
     , m_queue_depth(queue_depth)
     , m_batch_size(batch_size)
     , m_worker(static_cast<size_t>(batch_size))
     , m_wake_coordinator(m_sleeping, m_wakeup_pending)
     , m_core(m_worker, static_cast<size_t>(batch_size))
-    , m_reactor(queue_depth, m_last_error_code)
+    , m_reactor(queue_depth, m_last_error_code, options)
 {
     // io_uring SQE 获取/提交在每个调度器内保持单线程；被窃取的协程
     // 仍可通过其所属 reactor 提交，因此跨线程窃取不安全。
@@ -44,7 +47,12 @@ std::expected<void, IOError> IOUringScheduler::start()
         return {};
     }
     m_last_error_code.store(0, std::memory_order_release);
-    auto reactor_ready = m_reactor.start();
+    std::expected<void, IOError> reactor_ready;
+    {
+        // reactor 的缓冲池在构造时即被触碰，需在所属 NUMA 节点上完成首次分配。
+        detail::NumaMemoryPolicyScope placement(numaNode());
+        reactor_ready = m_reactor.start();
+    }
     if (!reactor_ready) {
         m_running.store(false, std::memory_order_release);
         return std::unexpected(reactor_ready.error());
@@ -54,16 +62,29 @@ std::expected<void, IOError> IOUringScheduler::start()
         return std::unexpected(IOError(kNotReady, 0));
     }
 
-    std::promise<void> thread_ready;
+    std::promise<std::expected<void, IOError>> thread_ready;
     auto ready = thread_ready.get_future();
     m_thread = std::thread([this, thread_ready = std::move(thread_ready)]() mutable {
         detail::SchedulerThreadScope scheduler_thread_scope;
         m_threadId = std::this_thread::get_id();
-        thread_ready.set_value();
+        // SINGLE_ISSUER ring 只接受启用它的线程提交，必须在事件循环线程上启用。
+        auto issuer_bound = m_reactor.bindIssuerThread();
+        const bool bound = issuer_bound.has_value();
+        thread_ready.set_value(std::move(issuer_bound));
+        if (!bound) {
+            return;
+        }
         (void)applyConfiguredAffinity();
+        (void)applyConfiguredNumaPlacement();
         eventLoop();
     });
-    ready.wait();
+    auto bound = ready.get();
+    if (!bound) {
+        m_thread.join();
+        m_worker.closeResumeAdmission();
+        m_running.store(false, std::memory_order_release);
+        return std::unexpected(bound.error());
+    }
     return {};
 }
 
@@ -151,6 +172,16 @@ int IOUringScheduler::addSendFile(IOController* controller)
     return m_reactor.addSendFile(controller);
 }
 
+int IOUringScheduler::addSpliceIn(IOController* controller)
+{
+    return m_reactor.addSpliceIn(controller);
+}
+
+int IOUringScheduler::addSpliceOut(IOController* controller)
+{
+    return m_reactor.addSpliceOut(controller);
+}
+
 int IOUringScheduler::addSequence(IOController* controller)
 {
     return m_reactor.addSequence(controller);
@@ -166,6 +197,11 @@ std::optional<IOError> IOUringScheduler::lastError() const
     return detail::loadBackendError(m_last_error_code);
 }
 
+RegisteredBuffer IOUringScheduler::leaseRegisteredBuffer(size_t length)
+{
+    return m_reactor.leaseRegisteredBuffer(length);
+}
+
 bool IOUringScheduler::schedule(TaskRef task) noexcept
 {
     if (!bindTask(task)) {
@@ -52,9 +52,11 @@ public:
      * @brief 构造 io_uring 调度器
      * @param queue_depth io_uring 提交/完成队列深度
      * @param batch_size 跨线程注入任务的批处理大小
+     * @param options io_uring 可选特性（fixed-file 表、注册缓冲池、ring setup 策略等）
      */
     IOUringScheduler(int queue_depth = GALAY_SCHEDULER_QUEUE_DEPTH,
-                     int batch_size = GALAY_SCHEDULER_BATCH_SIZE);
+                     int batch_size = GALAY_SCHEDULER_BATCH_SIZE,
+                     const IOUringOptions& options = IOUringOptions{});
 
     /**
      * @brief 析构调度器
@@ -83,12 +85,16 @@ public:
     int addFileWatch(IOController* controller) override;  ///< 注册文件监控等待；1=立即完成，0=已挂起，<0=错误
 
     int addSendFile(IOController* controller) override;   ///< 注册 sendfile 等待；1=立即完成，0=已挂起，<0=错误
+    int addSpliceIn(IOController* controller) override;   ///< 提交 socket→管道 splice；1=立即完成，0=已挂起，<0=错误
+    int addSpliceOut(IOController* controller) override;  ///< 提交管道→socket splice；1=立即完成，0=已挂起，<0=错误
 
     int addSequence(IOController* controller) override;   ///< 注册组合式序列 IO；1=立即完成，0=已挂起，<0=错误
 
     int remove(IOController* controller) override;        ///< 删除控制器关联的所有已注册操作；0=成功，<0=失败
 
     std::optional<IOError> lastError() const override;    ///< 返回最近一次内部错误；无错误时返回 std::nullopt
+    bool linkedTimeoutsEnabled() const noexcept override { return m_reactor.linkedTimeoutsEnabled(); }  ///< 一次性 IO 超时是否走内核 LINK_TIMEOUT
+    RegisteredBuffer leaseRegisteredBuffer(size_t length) override;  ///< 从 ring 注册缓冲池租借文件 IO 切片；不可用时返回无效切片
 
     bool schedule(TaskRef task) noexcept override;        ///< 从任意线程注入任务；成功时必要时会唤醒事件循环
     bool scheduleResume(TaskRef task) noexcept override;  ///< 仅运行期无分配接纳 Waker 恢复并保持 owner 线程亲和
@@ -113,6 +119,11 @@ public:
         return m_worker.snapshotStealStats();
     }
 
+    IOUringSetupStats ioUringSetupStats() const noexcept override
+    {
+        return m_reactor.setupStats();
+    }
+
     friend struct SchedulerTestAccess;
 
 private:
@@ -52,6 +52,7 @@ struct FileWatchResult {
     std::string name;           ///< 相关文件名（目录监控时有效）
     FileWatchEvent event;       ///< 触发的事件类型
     bool isDir;                 ///< 是否是目录
+    int wd = -1;                ///< 触发事件的监控描述符（inotify 队列溢出时为 -1）
 
     /**
      * @brief 检查是否包含指定事件
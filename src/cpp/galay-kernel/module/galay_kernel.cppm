@@ -37,6 +37,7 @@ using ::galay::utils::ByteQueueView;
 #include "../async/async_mutex.h"
 #include "../async/async_waiter.h"
 #include "../async/async_tcp.h"
+#include "../async/splice_relay.h"
 #include "../async/async_udp.h"
 #include "../async/async_file_watcher.h"
 
@@ -844,6 +844,16 @@ namespace galay::redis
                     m_driver.sendContext().m_buffer,
                     m_driver.sendContext().m_length);
             }
+            if (wait.kind == galay::ssl::SslOperationDriver::WaitKind::kReadv) {
+                return galay::kernel::MachineAction<result_type>::waitReadv(
+                    m_driver.readvContext().m_iovecs.data(),
+                    m_driver.readvContext().m_iovecs.size());
+            }
+            if (wait.kind == galay::ssl::SslOperationDriver::WaitKind::kWritev) {
+                return galay::kernel::MachineAction<result_type>::waitWritev(
+                    m_driver.writevContext().m_iovecs.data(),
+                    m_driver.writevContext().m_iovecs.size());
+            }
 
             setError(RedisError(
                 RedisErrorType::REDIS_ERROR_TYPE_INTERNAL_ERROR,
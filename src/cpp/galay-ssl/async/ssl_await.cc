@@ -1,7 +1,9 @@
 #include "ssl_await.h"
 #include "ssl_socket.h"
+#include "../ssl/ssl_ktls.h"
 #include <galay/cpp/galay-ssl/common/ssl_log.h>
 #include <algorithm>
+#include <cerrno>
 #include <limits>
 #include <string_view>
 
@@ -10,50 +12,54 @@ namespace galay::ssl
 
 namespace {
 
-constexpr size_t kCipherBufSize = 16384;
-constexpr size_t kMaxDrainBytes = 64 * 1024;
+/// 一次写出的密文上限：超过后先 writev，再继续加密剩余明文
+constexpr size_t kMaxGatherBytes = 64 * 1024;
 
-bool ensureBufferSize(std::vector<char>& buffer, size_t required)
+} // namespace
+
+void SslKtlsRecvIOContext::recvRecord(GHandle handle)
 {
-    if (required == 0 || required <= buffer.size()) {
-        return true;
+    const ssize_t received = detail::recvKtlsRecord(handle.fd, m_buffer, m_length, m_record_type);
+    if (received >= 0) {
+        m_result = static_cast<size_t>(received);
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        m_result = std::unexpected(IOError(kNotReady, 0));
+    } else {
+        m_result = std::unexpected(IOError(kRecvFailed, static_cast<uint32_t>(errno)));
     }
+}
 
-    size_t new_size = buffer.size();
-    if (new_size < kCipherBufSize) {
-        new_size = kCipherBufSize;
+#ifdef USE_IOURING
+bool SslKtlsRecvIOContext::handleComplete(struct io_uring_cqe* cqe, GHandle handle)
+{
+    m_record_type = detail::kTlsRecordApplicationData;
+    if (!RecvIOContext::handleComplete(cqe, handle)) {
+        return false;
     }
-
-    while (new_size < required) {
-        if (new_size > std::numeric_limits<size_t>::max() / 2) {
-            new_size = required;
-            break;
-        }
-        new_size *= 2;
+    if (m_result || static_cast<int>(m_result.error().code() >> 32) != EIO) {
+        return true;
     }
-
-    if (new_size < required) {
-        return false;
+    recvRecord(handle);
+    if (!m_result && IOError::contains(m_result.error().code(), kNotReady)) {
+        // EIO 之后记录必然已在队列中；仍未就绪说明状态异常，按读失败处理
+        m_result = std::unexpected(IOError(kRecvFailed, EIO));
     }
-
-    buffer.resize(new_size);
     return true;
 }
-
-size_t drainChunkSize(size_t pending)
+#else
+bool SslKtlsRecvIOContext::handleComplete(GHandle handle)
 {
-    if (pending == 0) {
-        return kCipherBufSize;
-    }
-    return std::max(kCipherBufSize, std::min(pending, kMaxDrainBytes));
+    recvRecord(handle);
+    return m_result || !IOError::contains(m_result.error().code(), kNotReady);
 }
-
-} // namespace
+#endif
 
 SslOperationDriver::SslOperationDriver(SslSocket* socket)
     : m_socket(socket)
     , m_recv_context(nullptr, 0)
     , m_send_context(nullptr, 0)
+    , m_readv_context(std::span<const struct iovec>{})
+    , m_writev_context(std::span<const struct iovec>{})
 {}
 
 void SslOperationDriver::resetContexts()
@@ -62,6 +68,8 @@ void SslOperationDriver::resetContexts()
     m_recv_context.m_length = 0;
     m_send_context.m_buffer = nullptr;
     m_send_context.m_length = 0;
+    m_readv_context.m_iovecs = {};
+    m_writev_context.m_iovecs = {};
 }
 
 void SslOperationDriver::resetHandshakeState()
@@ -90,15 +98,6 @@ void SslOperationDriver::clearOperation()
     resetContexts();
 }
 
-void SslOperationDriver::clearTransientBuffers()
-{
-    m_handshake_buffer.clear();
-    m_shutdown_buffer.clear();
-    m_recv_cipher_buffer.clear();
-    m_send_cipher_buffer.clear();
-    resetContexts();
-}
-
 bool SslOperationDriver::completed() const
 {
     switch (m_operation) {
@@ -123,7 +122,6 @@ std::expected<void, SslError> SslOperationDriver::takeHandshakeResult()
         : std::unexpected(SslError(SslErrorCode::kHandshakeFailed));
     resetHandshakeState();
     clearOperation();
-    clearTransientBuffers();
     return result;
 }
 
@@ -134,7 +132,6 @@ std::expected<Bytes, SslError> SslOperationDriver::takeRecvResult()
         : std::unexpected(SslError(SslErrorCode::kReadFailed));
     resetRecvState();
     clearOperation();
-    clearTransientBuffers();
     return result;
 }
 
@@ -145,7 +142,6 @@ std::expected<size_t, SslError> SslOperationDriver::takeSendResult()
         : std::unexpected(SslError(SslErrorCode::kWriteFailed));
     resetSendState();
     clearOperation();
-    clearTransientBuffers();
     return result;
 }
 
@@ -156,7 +152,6 @@ std::expected<void, SslError> SslOperationDriver::takeShutdownResult()
         : std::expected<void, SslError>{};
     resetShutdownState();
     clearOperation();
-    clearTransientBuffers();
     return result;
 }
 
@@ -265,39 +260,40 @@ void SslOperationDriver::startShutdown()
     }
 }
 
-bool SslOperationDriver::prepareReadBuffer(std::vector<char>& buffer)
+bool SslOperationDriver::prepareCipherRead()
 {
-    if (!ensureBufferSize(buffer, kCipherBufSize)) {
+    const size_t count = m_socket->m_engine.prepareEncryptedInput(m_read_iovecs.data(), m_read_iovecs.size());
+    if (count == 0) {
         return false;
     }
-    m_recv_context.m_buffer = buffer.data();
-    m_recv_context.m_length = buffer.size();
+    m_readv_context.m_iovecs = std::span<const struct iovec>(m_read_iovecs.data(), count);
+#ifdef USE_IOURING
+    m_readv_context.initMsghdr();
+#endif
     return true;
 }
 
-bool SslOperationDriver::prepareWriteFromPending(std::vector<char>& buffer, size_t pending, SslErrorCode error_code)
+bool SslOperationDriver::prepareCipherWrite()
 {
-    (void)error_code;
-    if (pending == 0) {
-        return false;
-    }
-
-    const size_t desired = drainChunkSize(pending);
-    if (!ensureBufferSize(buffer, desired)) {
-        return false;
-    }
-
-    const size_t to_read = std::min(pending, buffer.size());
-    const auto extracted = m_socket->m_engine.extractEncryptedOutput(buffer.data(), to_read);
-    if (!extracted || *extracted == 0) {
+    const size_t count = m_socket->m_engine.peekEncryptedOutput(m_write_iovecs.data(), m_write_iovecs.size());
+    if (count == 0) {
+        m_writev_context.m_iovecs = {};
         return false;
     }
-
-    m_send_context.m_buffer = buffer.data();
-    m_send_context.m_length = *extracted;
+    m_writev_context.m_iovecs = std::span<const struct iovec>(m_write_iovecs.data(), count);
+#ifdef USE_IOURING
+    m_writev_context.initMsghdr();
+#endif
     return true;
 }
 
+bool SslOperationDriver::advanceCipherWrite(size_t sent)
+{
+    // 部分写出时剩余数据仍在环中，重新取视图即可续写
+    m_socket->m_engine.consumeEncryptedOutput(sent);
+    return prepareCipherWrite();
+}
+
 SslOperationDriver::RecvPollAction SslOperationDriver::drainRecvPlaintext()
 {
     size_t total_read = 0;
@@ -363,39 +359,38 @@ SslOperationDriver::RecvPollAction SslOperationDriver::drainRecvPlaintext()
     return RecvPollAction::kNeedRecv;
 }
 
-bool SslOperationDriver::prepareRecvSendChunk(size_t pending)
+void SslOperationDriver::completeHandshake()
 {
-    if (m_send_context.m_length > 0) {
-        return true;
-    }
+    // 握手记录已全部写出，此时切换发送方向不会与 OpenSSL 产生的密文交错
+    m_socket->m_engine.installKtls(m_socket->m_controller.m_handle.fd);
+    m_handshake.result = {};
+    m_handshake.result_set = true;
+}
 
-    if (pending == 0) {
-        pending = m_socket->m_engine.pendingEncryptedOutput();
+bool SslOperationDriver::prepareRecvSendChunk()
+{
+    if (cipherWritePending()) {
+        return true;
     }
-    if (pending == 0) {
-        setRecvFailure(SslError(SslErrorCode::kReadFailed));
-        return false;
-    }
-
-    if (!prepareWriteFromPending(m_recv_cipher_buffer, pending, SslErrorCode::kReadFailed)) {
+    if (!prepareCipherWrite()) {
         setRecvFailure(SslError(SslErrorCode::kReadFailed));
         return false;
     }
     return true;
 }
 
-bool SslOperationDriver::fillSendChunk(size_t pending)
+bool SslOperationDriver::fillSendChunk()
 {
+    SslEngine& engine = m_socket->m_engine;
     while (true) {
-        if (m_send_context.m_length > 0) {
+        if (cipherWritePending()) {
             return true;
         }
 
-        if (pending == 0) {
-            pending = m_socket->m_engine.pendingEncryptedOutput();
-        }
-        if (pending > 0) {
-            if (!prepareWriteFromPending(m_send_cipher_buffer, pending, SslErrorCode::kWriteFailed)) {
+        // 明文全部加密完或积累到上限时，一次 writev 写出输出环中的全部记录
+        const size_t pending = engine.pendingEncryptedOutput();
+        if (pending > 0 && (pending >= kMaxGatherBytes || m_send.plain_offset >= m_send.plain_length)) {
+            if (!prepareCipherWrite()) {
                 setSendFailure(SslError(SslErrorCode::kWriteFailed));
                 return false;
             }
@@ -408,32 +403,30 @@ bool SslOperationDriver::fillSendChunk(size_t pending)
             return false;
         }
 
+        const size_t remaining = std::min(m_send.plain_length - m_send.plain_offset, kMaxGatherBytes);
         size_t bytes_written = 0;
-        const SslIOResult ssl_ret = m_socket->m_engine.write(
+        const SslIOResult ssl_ret = engine.write(
             m_send.plain_buffer + m_send.plain_offset,
-            m_send.plain_length - m_send.plain_offset,
+            remaining,
             bytes_written
         );
 
         if (ssl_ret == SslIOResult::Success && bytes_written > 0) {
             m_send.plain_offset += bytes_written;
-            pending = 0;
             continue;
         }
 
-        if (ssl_ret == SslIOResult::WantRead) {
-            pending = m_socket->m_engine.pendingEncryptedOutput();
-            if (pending > 0) {
-                continue;
+        if (ssl_ret == SslIOResult::WantRead || ssl_ret == SslIOResult::WantWrite) {
+            if (engine.pendingEncryptedOutput() > 0) {
+                if (!prepareCipherWrite()) {
+                    setSendFailure(SslError(SslErrorCode::kWriteFailed));
+                    return false;
+                }
+                return true;
             }
-            m_send.read_pending = true;
-            return false;
-        }
-
-        if (ssl_ret == SslIOResult::WantWrite) {
-            pending = m_socket->m_engine.pendingEncryptedOutput();
-            if (pending > 0) {
-                continue;
+            if (ssl_ret == SslIOResult::WantRead) {
+                m_send.read_pending = true;
+                return false;
             }
         }
 
@@ -464,16 +457,16 @@ SslOperationDriver::WaitAction SslOperationDriver::pollHandshake()
     if (m_handshake.result_set) {
         return {};
     }
-    if (m_send_context.m_length > 0) {
-        return {&m_send_context, WaitKind::kWrite};
+    if (cipherWritePending()) {
+        return {&m_writev_context, WaitKind::kWritev};
     }
     if (m_handshake.read_pending) {
-        if (!prepareReadBuffer(m_handshake_buffer)) {
+        if (!prepareCipherRead()) {
             setHandshakeFailure(SslError(SslErrorCode::kHandshakeFailed));
             return {};
         }
         m_handshake.read_pending = false;
-        return {&m_recv_context, WaitKind::kRead};
+        return {&m_readv_context, WaitKind::kReadv};
     }
 
     const SslIOResult ret = m_socket->m_engine.doHandshake();
@@ -482,45 +475,41 @@ SslOperationDriver::WaitAction SslOperationDriver::pollHandshake()
         {
             const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
             if (pending > 0) {
-                if (!prepareWriteFromPending(m_handshake_buffer, pending, SslErrorCode::kHandshakeFailed)) {
+                if (!prepareCipherWrite()) {
                     setHandshakeFailure(SslError(SslErrorCode::kHandshakeFailed));
                     return {};
                 }
                 m_handshake.flush_success = true;
-                return {&m_send_context, WaitKind::kWrite};
+                return {&m_writev_context, WaitKind::kWritev};
             }
         }
-        m_handshake.result = {};
-        m_handshake.result_set = true;
+        completeHandshake();
         return {};
     case SslIOResult::WantWrite:
-        {
-            const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
-            if (!prepareWriteFromPending(m_handshake_buffer, pending, SslErrorCode::kHandshakeFailed)) {
-                setHandshakeFailure(SslError::fromOpenSSL(SslErrorCode::kHandshakeFailed));
-                return {};
-            }
+        if (!prepareCipherWrite()) {
+            setHandshakeFailure(SslError::fromOpenSSL(SslErrorCode::kHandshakeFailed));
+            return {};
         }
         m_handshake.flush_success = false;
         m_handshake.wait_read_after_write = false;
-        return {&m_send_context, WaitKind::kWrite};
+        return {&m_writev_context, WaitKind::kWritev};
     case SslIOResult::WantRead:
         {
             const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
             if (pending > 0) {
-                if (!prepareWriteFromPending(m_handshake_buffer, pending, SslErrorCode::kHandshakeFailed)) {
+                if (!prepareCipherWrite()) {
                     setHandshakeFailure(SslError::fromOpenSSL(SslErrorCode::kHandshakeFailed));
                     return {};
                 }
                 m_handshake.wait_read_after_write = true;
-                return {&m_send_context, WaitKind::kWrite};
+                return {&m_writev_context, WaitKind::kWritev};
             }
         }
-        if (!prepareReadBuffer(m_handshake_buffer)) {
+        if (!prepareCipherRead()) {
             setHandshakeFailure(SslError(SslErrorCode::kHandshakeFailed));
             return {};
         }
-        return {&m_recv_context, WaitKind::kRead};
+        return {&m_readv_context, WaitKind::kReadv};
     case SslIOResult::ZeroReturn:
         setHandshakeFailure(SslError(SslErrorCode::kPeerClosed));
         return {};
@@ -539,28 +528,44 @@ SslOperationDriver::WaitAction SslOperationDriver::pollRecv()
     if (m_recv.result_set) {
         return {};
     }
-    if (m_send_context.m_length > 0) {
-        return {&m_send_context, WaitKind::kWrite};
+    if (cipherWritePending()) {
+        return {&m_writev_context, WaitKind::kWritev};
     }
 
-    switch (drainRecvPlaintext()) {
-    case RecvPollAction::kCompleted:
-        return {};
-    case RecvPollAction::kNeedSend:
-        if (!prepareRecvSendChunk(0)) {
+    SslEngine& engine = m_socket->m_engine;
+    if (!engine.isKtlsActive(SslKtlsDirection::Rx)) {
+        switch (drainRecvPlaintext()) {
+        case RecvPollAction::kCompleted:
             return {};
+        case RecvPollAction::kNeedSend:
+            if (engine.isKtlsActive(SslKtlsDirection::Tx)) {
+                // 发送方向已在内核：OpenSSL 产生的记录（如 KeyUpdate 应答）序号与内核不一致，只能丢弃
+                engine.discardEncryptedOutput();
+                break;
+            }
+            if (!prepareRecvSendChunk()) {
+                return {};
+            }
+            return {&m_writev_context, WaitKind::kWritev};
+        case RecvPollAction::kNeedRecv:
+            break;
         }
-        return {&m_send_context, WaitKind::kWrite};
-    case RecvPollAction::kNeedRecv:
-        if (!prepareReadBuffer(m_recv_cipher_buffer)) {
-            setRecvFailure(SslError(SslErrorCode::kReadFailed));
-            return {};
+        // OpenSSL 已无明文可读；密文恰好停在记录边界时把接收方向交给内核
+        if (!engine.isKtlsPending(SslKtlsDirection::Rx) ||
+            !engine.installKtls(m_socket->m_controller.m_handle.fd) ||
+            !engine.isKtlsActive(SslKtlsDirection::Rx)) {
+            if (!prepareCipherRead()) {
+                setRecvFailure(SslError(SslErrorCode::kReadFailed));
+                return {};
+            }
+            return {&m_readv_context, WaitKind::kReadv};
         }
-        return {&m_recv_context, WaitKind::kRead};
     }
 
-    setRecvFailure(SslError(SslErrorCode::kReadFailed));
-    return {};
+    m_recv.kernel_plaintext = true;
+    m_recv_context.m_buffer = m_recv.plain_buffer;
+    m_recv_context.m_length = m_recv.plain_length;
+    return {&m_recv_context, WaitKind::kRead};
 }
 
 SslOperationDriver::WaitAction SslOperationDriver::pollSend()
@@ -569,19 +574,33 @@ SslOperationDriver::WaitAction SslOperationDriver::pollSend()
         return {};
     }
     if (m_send.read_pending) {
-        if (!prepareReadBuffer(m_send_cipher_buffer)) {
+        if (!prepareCipherRead()) {
             setSendFailure(SslError(SslErrorCode::kWriteFailed));
             return {};
         }
         m_send.read_pending = false;
-        return {&m_recv_context, WaitKind::kRead};
+        return {&m_readv_context, WaitKind::kReadv};
     }
     if (m_send_context.m_length > 0) {
         return {&m_send_context, WaitKind::kWrite};
     }
-    if (fillSendChunk()) {
+    if (cipherWritePending()) {
+        return {&m_writev_context, WaitKind::kWritev};
+    }
+    if (m_socket->m_engine.isKtlsActive(SslKtlsDirection::Tx)) {
+        if (m_send.plain_offset >= m_send.plain_length) {
+            m_send.result = m_send.plain_length;
+            m_send.result_set = true;
+            return {};
+        }
+        m_send.kernel_plaintext = true;
+        m_send_context.m_buffer = m_send.plain_buffer + m_send.plain_offset;
+        m_send_context.m_length = m_send.plain_length - m_send.plain_offset;
         return {&m_send_context, WaitKind::kWrite};
     }
+    if (fillSendChunk()) {
+        return {&m_writev_context, WaitKind::kWritev};
+    }
     return {};
 }
 
@@ -590,16 +609,22 @@ SslOperationDriver::WaitAction SslOperationDriver::pollShutdown()
     if (m_shutdown.result_set) {
         return {};
     }
-    if (m_send_context.m_length > 0) {
-        return {&m_send_context, WaitKind::kWrite};
+    if (cipherWritePending()) {
+        return {&m_writev_context, WaitKind::kWritev};
     }
     if (m_shutdown.read_pending) {
-        if (!prepareReadBuffer(m_shutdown_buffer)) {
+        if (!prepareCipherRead()) {
             setShutdownSuccess();
             return {};
         }
         m_shutdown.read_pending = false;
-        return {&m_recv_context, WaitKind::kRead};
+        return {&m_readv_context, WaitKind::kReadv};
+    }
+    if (m_socket->m_engine.isKtlsActive(SslKtlsDirection::Tx)) {
+        // 发送密钥在内核中，close_notify 只能经内核加密；不等待对端的 close_notify
+        m_socket->m_engine.sendKtlsCloseNotify(m_socket->m_controller.m_handle.fd);
+        setShutdownSuccess();
+        return {};
     }
 
     const SslIOResult ret = m_socket->m_engine.shutdown();
@@ -609,32 +634,29 @@ SslOperationDriver::WaitAction SslOperationDriver::pollShutdown()
         setShutdownSuccess();
         return {};
     case SslIOResult::WantWrite:
-        {
-            const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
-            if (!prepareWriteFromPending(m_shutdown_buffer, pending, SslErrorCode::kShutdownFailed)) {
-                setShutdownSuccess();
-                return {};
-            }
+        if (!prepareCipherWrite()) {
+            setShutdownSuccess();
+            return {};
         }
         m_shutdown.wait_read_after_write = false;
-        return {&m_send_context, WaitKind::kWrite};
+        return {&m_writev_context, WaitKind::kWritev};
     case SslIOResult::WantRead:
         {
             const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
             if (pending > 0) {
-                if (!prepareWriteFromPending(m_shutdown_buffer, pending, SslErrorCode::kShutdownFailed)) {
+                if (!prepareCipherWrite()) {
                     setShutdownSuccess();
                     return {};
                 }
                 m_shutdown.wait_read_after_write = true;
-                return {&m_send_context, WaitKind::kWrite};
+                return {&m_writev_context, WaitKind::kWritev};
             }
         }
-        if (!prepareReadBuffer(m_shutdown_buffer)) {
+        if (!prepareCipherRead()) {
             setShutdownSuccess();
             return {};
         }
-        return {&m_recv_context, WaitKind::kRead};
+        return {&m_readv_context, WaitKind::kReadv};
     case SslIOResult::Syscall:
     case SslIOResult::Error:
         setShutdownSuccess();
@@ -693,10 +715,7 @@ void SslOperationDriver::onHandshakeRead(std::expected<size_t, IOError> result)
         return;
     }
 
-    const auto fed = m_socket->m_engine.feedEncryptedInput(m_recv_context.m_buffer, result.value());
-    if (!fed || *fed == 0) {
-        setHandshakeFailure(SslError(SslErrorCode::kHandshakeFailed));
-    }
+    m_socket->m_engine.commitEncryptedInput(result.value());
 }
 
 void SslOperationDriver::onHandshakeWrite(std::expected<size_t, IOError> result)
@@ -706,28 +725,13 @@ void SslOperationDriver::onHandshakeWrite(std::expected<size_t, IOError> result)
         return;
     }
 
-    const size_t sent = result.value();
-    if (sent < m_send_context.m_length) {
-        m_send_context.m_buffer += sent;
-        m_send_context.m_length -= sent;
-        return;
-    }
-
-    m_send_context.m_buffer += m_send_context.m_length;
-    m_send_context.m_length = 0;
-
-    const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
-    if (pending > 0) {
-        if (!prepareWriteFromPending(m_handshake_buffer, pending, SslErrorCode::kHandshakeFailed)) {
-            setHandshakeFailure(SslError(SslErrorCode::kHandshakeFailed));
-        }
+    if (advanceCipherWrite(result.value())) {
         return;
     }
 
     if (m_handshake.flush_success) {
-        m_handshake.result = {};
-        m_handshake.result_set = true;
         m_handshake.flush_success = false;
+        completeHandshake();
         return;
     }
 
@@ -739,6 +743,39 @@ void SslOperationDriver::onHandshakeWrite(std::expected<size_t, IOError> result)
 
 void SslOperationDriver::onRecvRead(std::expected<size_t, IOError> result)
 {
+    if (m_recv.kernel_plaintext) {
+        m_recv.kernel_plaintext = false;
+        resetContexts();
+        if (!result) {
+            if (IOError::contains(result.error().code(), kDisconnectError)) {
+                m_recv.result = Bytes();
+                m_recv.result_set = true;
+            } else {
+                setRecvFailure(SslError(SslErrorCode::kReadFailed));
+            }
+            return;
+        }
+        // 只有 close_notify 是有序关闭；致命告警与 KeyUpdate 等握手记录无法在内核接收方向继续处理
+        switch (detail::classifyKtlsRecord(m_recv_context.m_record_type, m_recv.plain_buffer, result.value())) {
+        case detail::SslKtlsRecordAction::kData:
+            m_recv.result = result.value() == 0
+                ? Bytes()
+                : Bytes::fromString(std::string_view(m_recv.plain_buffer, result.value()));
+            m_recv.result_set = true;
+            return;
+        case detail::SslKtlsRecordAction::kCloseNotify:
+            m_recv.result = Bytes();
+            m_recv.result_set = true;
+            return;
+        case detail::SslKtlsRecordAction::kFail:
+            SSL_LOG_WARN("[ktls] [rx-record]", "type={} length={}",
+                         static_cast<int>(m_recv_context.m_record_type), result.value());
+            setRecvFailure(SslError(SslErrorCode::kReadFailed));
+            return;
+        }
+        return;
+    }
+
     if (!result) {
         if (IOError::contains(result.error().code(), kDisconnectError)) {
             m_recv.result = Bytes();
@@ -755,10 +792,7 @@ void SslOperationDriver::onRecvRead(std::expected<size_t, IOError> result)
         return;
     }
 
-    const auto fed = m_socket->m_engine.feedEncryptedInput(m_recv_context.m_buffer, result.value());
-    if (!fed || *fed == 0) {
-        setRecvFailure(SslError(SslErrorCode::kReadFailed));
-    }
+    m_socket->m_engine.commitEncryptedInput(result.value());
 }
 
 void SslOperationDriver::onRecvWrite(std::expected<size_t, IOError> result)
@@ -768,20 +802,7 @@ void SslOperationDriver::onRecvWrite(std::expected<size_t, IOError> result)
         return;
     }
 
-    const size_t sent = result.value();
-    if (sent < m_send_context.m_length) {
-        m_send_context.m_buffer += sent;
-        m_send_context.m_length -= sent;
-        return;
-    }
-
-    m_send_context.m_buffer += m_send_context.m_length;
-    m_send_context.m_length = 0;
-
-    const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
-    if (pending > 0) {
-        prepareRecvSendChunk(pending);
-    }
+    (void)advanceCipherWrite(result.value());
 }
 
 void SslOperationDriver::onSendRead(std::expected<size_t, IOError> result)
@@ -791,10 +812,7 @@ void SslOperationDriver::onSendRead(std::expected<size_t, IOError> result)
         return;
     }
 
-    const auto fed = m_socket->m_engine.feedEncryptedInput(m_recv_context.m_buffer, result.value());
-    if (!fed || *fed == 0) {
-        setSendFailure(SslError(SslErrorCode::kWriteFailed));
-    }
+    m_socket->m_engine.commitEncryptedInput(result.value());
 }
 
 void SslOperationDriver::onSendWrite(std::expected<size_t, IOError> result)
@@ -804,20 +822,19 @@ void SslOperationDriver::onSendWrite(std::expected<size_t, IOError> result)
         return;
     }
 
-    const size_t sent = result.value();
-    if (sent < m_send_context.m_length) {
-        m_send_context.m_buffer += sent;
-        m_send_context.m_length -= sent;
+    if (m_send.kernel_plaintext) {
+        m_send.kernel_plaintext = false;
+        m_send.plain_offset += std::min(result.value(), m_send_context.m_length);
+        resetContexts();
+        if (m_send.plain_offset >= m_send.plain_length) {
+            m_send.result = m_send.plain_length;
+            m_send.result_set = true;
+        }
         return;
     }
 
-    m_send_context.m_buffer += m_send_context.m_length;
-    m_send_context.m_length = 0;
-
-    const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
-    if (pending > 0) {
-        fillSendChunk(pending);
-    }
+    // 输出环写空后由 pollSend() 继续加密剩余明文
+    (void)advanceCipherWrite(result.value());
 }
 
 void SslOperationDriver::onShutdownRead(std::expected<size_t, IOError> result)
@@ -827,10 +844,7 @@ void SslOperationDriver::onShutdownRead(std::expected<size_t, IOError> result)
         return;
     }
 
-    const auto fed = m_socket->m_engine.feedEncryptedInput(m_recv_context.m_buffer, result.value());
-    if (!fed || *fed == 0) {
-        setShutdownSuccess();
-    }
+    m_socket->m_engine.commitEncryptedInput(result.value());
 }
 
 void SslOperationDriver::onShutdownWrite(std::expected<size_t, IOError> result)
@@ -840,21 +854,7 @@ void SslOperationDriver::onShutdownWrite(std::expected<size_t, IOError> result)
         return;
     }
 
-    const size_t sent = result.value();
-    if (sent < m_send_context.m_length) {
-        m_send_context.m_buffer += sent;
-        m_send_context.m_length -= sent;
-        return;
-    }
-
-    m_send_context.m_buffer += m_send_context.m_length;
-    m_send_context.m_length = 0;
-
-    const size_t pending = m_socket->m_engine.pendingEncryptedOutput();
-    if (pending > 0) {
-        if (!prepareWriteFromPending(m_shutdown_buffer, pending, SslErrorCode::kShutdownFailed)) {
-            setShutdownSuccess();
-        }
+    if (advanceCipherWrite(result.value())) {
         return;
     }
 
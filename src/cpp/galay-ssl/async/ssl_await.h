@@ -22,6 +22,7 @@
 #include "../../galay-utils/cache/bytes.hpp"
 #include "../../galay-kernel/core/awaitable.h"
 #include "../../galay-kernel/core/timeout.hpp"
+#include <array>
 #include <concepts>
 #include <coroutine>
 #include <cstddef>
@@ -416,8 +417,32 @@ private:
 /**
  * @brief SSL IO 操作驱动器
  * @details 驱动单个 SSL 操作（握手/接收/发送/关闭）的底层引擎，
- * 管理 SSL 引擎与网络 IO 之间的数据流转。
+ * 管理 SSL 引擎与网络 IO 之间的数据流转。密文收发直接读写 SslEngine 的密文环：
+ * 接收以 readv 落入输入环的空闲段，发送以 writev 写出输出环的待发段，不经过中转缓冲区。
+ * 某个方向切换到 kTLS 后，该方向的收发直接使用明文缓冲区，记录加解密由内核完成。
  */
+/**
+ * @brief kTLS 明文接收 IO 上下文
+ * @details 内核接收方向遇到非应用数据记录时，不带控制消息的 recv 只能得到 EIO；
+ *          这里以 recvmsg 携带 TLS_GET_RECORD_TYPE 读取，记录类型写入 m_record_type 供驱动器区分
+ *          close_notify、其他告警与握手记录。io_uring 后端提交的仍是普通 recv，
+ *          完成结果为 EIO 时该记录仍在内核队列中，再同步 recvmsg 取出。
+ */
+struct SslKtlsRecvIOContext: public RecvIOContext {
+    using RecvIOContext::RecvIOContext;
+
+#ifdef USE_IOURING
+    bool handleComplete(struct io_uring_cqe* cqe, GHandle handle) override;
+#else
+    bool handleComplete(GHandle handle) override;
+#endif
+
+    uint8_t m_record_type = 23;  ///< 本次读到的记录类型（ContentType），默认应用数据
+
+private:
+    void recvRecord(GHandle handle);  ///< 以 recvmsg 读取一条记录并写入 m_result；未就绪时写入 kNotReady
+};
+
 class SslOperationDriver
 {
 public:
@@ -426,8 +451,10 @@ public:
      */
     enum class WaitKind : uint8_t {
         kNone,   ///< 无需等待
-        kRead,   ///< 等待读取
-        kWrite,  ///< 等待写入
+        kRead,   ///< 等待读取（kTLS 明文，recvContext()）
+        kWrite,  ///< 等待写入（kTLS 明文，sendContext()）
+        kReadv,  ///< 等待密文读取（readvContext()）
+        kWritev, ///< 等待密文写入（writevContext()）
     };
 
     /**
@@ -538,6 +565,18 @@ public:
      */
     SendIOContext& sendContext() { return m_send_context; }
 
+    /**
+     * @brief 获取密文读取 IO 上下文
+     * @return readv 上下文引用，iovec 指向输入密文环的空闲段
+     */
+    ReadvIOContext& readvContext() { return m_readv_context; }
+
+    /**
+     * @brief 获取密文写入 IO 上下文
+     * @return writev 上下文引用，iovec 指向输出密文环的待发段
+     */
+    WritevIOContext& writevContext() { return m_writev_context; }
+
 private:
     /**
      * @brief 操作类型
@@ -580,21 +619,27 @@ private:
     void onShutdownRead(std::expected<size_t, IOError> result);    ///< 处理关闭读取完成
     void onShutdownWrite(std::expected<size_t, IOError> result);   ///< 处理关闭写入完成
 
-    bool prepareReadBuffer(std::vector<char>& buffer);                    ///< 准备读取缓冲区
-    bool prepareWriteFromPending(std::vector<char>& buffer, size_t pending, SslErrorCode error_code);  ///< 从待发送数据准备写入缓冲区
-    bool prepareRecvSendChunk(size_t pending);                            ///< 准备接收发送块
-    bool fillSendChunk(size_t pending = 0);                                ///< 填充发送块
+    bool prepareCipherRead();                                             ///< 以输入密文环的空闲段准备 readv
+    bool prepareCipherWrite();                                            ///< 以输出密文环的待发段准备 writev
+    bool cipherWritePending() const { return !m_writev_context.m_iovecs.empty(); }  ///< 是否有已准备的密文写入
+    bool advanceCipherWrite(size_t sent);                                 ///< 消费已写出的密文，仍有待发时返回 true
+    bool prepareRecvSendChunk();                                          ///< 准备接收过程中需要写出的密文
+    bool fillSendChunk();                                                 ///< 加密明文并准备写出
     RecvPollAction drainRecvPlaintext();                                  ///< 排空接收明文
+    void completeHandshake();                                             ///< 握手成功收尾，尝试切换 kTLS
 
     void setHandshakeFailure(SslError error);   ///< 设置握手失败
     void setRecvFailure(SslError error);        ///< 设置接收失败
     void setSendFailure(SslError error);        ///< 设置发送失败
     void setShutdownSuccess();                  ///< 设置关闭成功
-    void clearTransientBuffers();               ///< 清除临时缓冲区
 
     SslSocket* m_socket = nullptr;                     ///< SSL Socket 指针
-    RecvIOContext m_recv_context;                       ///< 接收 IO 上下文
-    SendIOContext m_send_context;                       ///< 发送 IO 上下文
+    SslKtlsRecvIOContext m_recv_context;                ///< kTLS 明文接收 IO 上下文
+    SendIOContext m_send_context;                       ///< kTLS 明文发送 IO 上下文
+    ReadvIOContext m_readv_context;                     ///< 密文接收 IO 上下文
+    WritevIOContext m_writev_context;                   ///< 密文发送 IO 上下文
+    std::array<struct iovec, 2> m_read_iovecs{};        ///< 输入密文环空闲段
+    std::array<struct iovec, 2> m_write_iovecs{};       ///< 输出密文环待发段
 
     /**
      * @brief 握手状态
@@ -615,6 +660,7 @@ private:
         size_t plain_length = 0;                         ///< 明文长度
         std::expected<Bytes, SslError> result{};         ///< 接收结果
         bool result_set = false;                         ///< 结果是否已设置
+        bool kernel_plaintext = false;                   ///< 本次直接收取内核解密后的明文（kTLS）
     } m_recv;
 
     /**
@@ -627,6 +673,7 @@ private:
         std::expected<size_t, SslError> result{};        ///< 发送结果
         bool read_pending = false;                       ///< 是否有待处理的读取
         bool result_set = false;                         ///< 结果是否已设置
+        bool kernel_plaintext = false;                   ///< 本次直接写出明文，由内核加密（kTLS）
     } m_send;
 
     /**
@@ -638,10 +685,6 @@ private:
         bool wait_read_after_write = false;              ///< 写入后是否等待读取
         bool read_pending = false;                       ///< 是否有待处理的读取
     } m_shutdown;
-    std::vector<char> m_handshake_buffer;                ///< 握手密文缓冲区
-    std::vector<char> m_shutdown_buffer;                 ///< 关闭密文缓冲区
-    std::vector<char> m_recv_cipher_buffer;              ///< 接收密文缓冲区
-    std::vector<char> m_send_cipher_buffer;              ///< 发送密文缓冲区
     OperationKind m_operation = OperationKind::kNone;    ///< 当前操作类型
 };
 
@@ -825,6 +868,24 @@ public:
             m_driver.onWrite(std::move(io_result));
             return pump();
         }
+        if (m_active_kind == ActiveKind::kReadv) {
+            if (!m_driver.readvContext().handleComplete(cqe, handle)) {
+                return SequenceProgress::kNeedWait;
+            }
+            auto io_result = std::move(m_driver.readvContext().m_result);
+            clearActiveTask();
+            m_driver.onRead(std::move(io_result));
+            return pump();
+        }
+        if (m_active_kind == ActiveKind::kWritev) {
+            if (!m_driver.writevContext().handleComplete(cqe, handle)) {
+                return SequenceProgress::kNeedWait;
+            }
+            auto io_result = std::move(m_driver.writevContext().m_result);
+            clearActiveTask();
+            m_driver.onWrite(std::move(io_result));
+            return pump();
+        }
         setFailure(SslError(SslErrorCode::kUnknown));
         return SequenceProgress::kCompleted;
     }
@@ -857,6 +918,24 @@ public:
                 m_driver.onWrite(std::move(io_result));
                 continue;
             }
+            if (m_active_kind == ActiveKind::kReadv) {
+                if (!m_driver.readvContext().handleComplete(handle)) {
+                    return SequenceProgress::kNeedWait;
+                }
+                auto io_result = std::move(m_driver.readvContext().m_result);
+                clearActiveTask();
+                m_driver.onRead(std::move(io_result));
+                continue;
+            }
+            if (m_active_kind == ActiveKind::kWritev) {
+                if (!m_driver.writevContext().handleComplete(handle)) {
+                    return SequenceProgress::kNeedWait;
+                }
+                auto io_result = std::move(m_driver.writevContext().m_result);
+                clearActiveTask();
+                m_driver.onWrite(std::move(io_result));
+                continue;
+            }
             setFailure(SslError(SslErrorCode::kUnknown));
             return SequenceProgress::kCompleted;
         }
@@ -888,6 +967,24 @@ public:
             m_driver.onWrite(std::move(io_result));
             return prepareForSubmit(handle);
         }
+        if (m_active_kind == ActiveKind::kReadv) {
+            if (!m_driver.readvContext().handleComplete(handle)) {
+                return SequenceProgress::kNeedWait;
+            }
+            auto io_result = std::move(m_driver.readvContext().m_result);
+            clearActiveTask();
+            m_driver.onRead(std::move(io_result));
+            return prepareForSubmit(handle);
+        }
+        if (m_active_kind == ActiveKind::kWritev) {
+            if (!m_driver.writevContext().handleComplete(handle)) {
+                return SequenceProgress::kNeedWait;
+            }
+            auto io_result = std::move(m_driver.writevContext().m_result);
+            clearActiveTask();
+            m_driver.onWrite(std::move(io_result));
+            return prepareForSubmit(handle);
+        }
         setFailure(SslError(SslErrorCode::kUnknown));
         return SequenceProgress::kCompleted;
     }
@@ -898,6 +995,8 @@ private:
         kNone,
         kRead,
         kWrite,
+        kReadv,
+        kWritev,
     };
 
     static constexpr size_t kInlineTransitionCap = 64;
@@ -944,6 +1043,20 @@ private:
         m_active_kind = ActiveKind::kWrite;
     }
 
+    void activateReadv()
+    {
+        m_active_task = IOTask{nullptr, &m_driver.readvContext(), READV};
+        m_has_active_task = true;
+        m_active_kind = ActiveKind::kReadv;
+    }
+
+    void activateWritev()
+    {
+        m_active_task = IOTask{nullptr, &m_driver.writevContext(), WRITEV};
+        m_has_active_task = true;
+        m_active_kind = ActiveKind::kWritev;
+    }
+
     void clearActiveTask()
     {
         m_active_task = IOTask{};
@@ -1042,6 +1155,14 @@ private:
                     activateWrite();
                     return SequenceProgress::kNeedWait;
                 }
+                if (wait.kind == SslOperationDriver::WaitKind::kReadv) {
+                    activateReadv();
+                    return SequenceProgress::kNeedWait;
+                }
+                if (wait.kind == SslOperationDriver::WaitKind::kWritev) {
+                    activateWritev();
+                    return SequenceProgress::kNeedWait;
+                }
                 setFailure(SslError(SslErrorCode::kUnknown));
                 return SequenceProgress::kCompleted;
             }
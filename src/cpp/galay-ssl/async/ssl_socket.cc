@@ -165,4 +165,11 @@ CloseAwaitable SslSocket::close()
     return CloseAwaitable(&m_controller);
 }
 
+SendFileAwaitable SslSocket::sendfile(int file_fd, off_t offset, size_t count)
+{
+    // 用户态加密时 sendfile 会绕过 SSL 写出明文，用无效描述符让这次调用直接失败
+    const int fd = isKtlsTxEnabled() ? file_fd : -1;
+    return SendFileAwaitable(&m_controller, fd, offset, count);
+}
+
 } // namespace galay::ssl
@@ -5,7 +5,9 @@
  * @version 1.0.0
  *
  * @details 封装 SSL/TLS 加密的异步 TCP Socket，提供协程友好的异步 IO 接口，
- * 支持连接、握手、收发和关闭等操作，使用 Memory BIO 模式解耦网络 IO 与 SSL。
+ * 支持连接、握手、收发和关闭等操作，使用密文环 BIO 解耦网络 IO 与 SSL。
+ * SslContext 开启 kTLS 且内核支持时，握手完成后记录加解密交给内核，
+ * 此时 sendfile() 可直接把文件页交给内核加密发送。
  */
 
 #ifndef GALAY_SSL_SOCKET_H
@@ -245,6 +247,35 @@ public:
      */
     CloseAwaitable close();
 
+    /**
+     * @brief 发送方向是否已交给内核 TLS
+     * @note 握手完成后才可能为 true；为 true 时 send() 直接写出明文，由内核加密
+     */
+    bool isKtlsTxEnabled() const { return m_engine.isKtlsActive(SslKtlsDirection::Tx); }
+
+    /**
+     * @brief 接收方向是否已交给内核 TLS
+     * @note 接收方向在第一次 recv() 读空 OpenSSL 缓冲且恰好处于记录边界时才切换
+     */
+    bool isKtlsRxEnabled() const { return m_engine.isKtlsActive(SslKtlsDirection::Rx); }
+
+    /**
+     * @brief 经内核 TLS 异步零拷贝发送文件
+     *
+     * @param file_fd 要发送的文件描述符
+     * @param offset 文件偏移量（发送起始位置）
+     * @param count 要发送的字节数
+     * @return SendFileAwaitable 可等待对象，co_await后返回实际发送的字节数
+     *
+     * @note
+     * - 仅在 isKtlsTxEnabled() 为 true 时真正发送，文件页由内核分片成 TLS 记录并加密
+     * - 发送方向仍在用户态时直接以 EBADF 失败，绝不会把明文写进 TLS 流；
+     *   调用方应先判断 isKtlsTxEnabled()，否则回退为 read + send()
+     * - 返回值可能小于 count，表示部分发送
+     * - 不要与同一连接上未完成的 send() 交错使用
+     */
+    SendFileAwaitable sendfile(int file_fd, off_t offset, size_t count);
+
     /**
      * @brief 获取对端证书
      * @return X509 证书指针，需要调用者释放
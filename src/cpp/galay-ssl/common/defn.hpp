@@ -53,6 +53,14 @@ enum class SslHandshakeState : uint8_t {
     Failed,         ///< 失败
 };
 
+/**
+ * @brief kTLS 记录方向
+ */
+enum class SslKtlsDirection : uint8_t {
+    Tx,     ///< 发送方向：内核加密记录
+    Rx,     ///< 接收方向：内核解密记录
+};
+
 /**
  * @brief SSL IO 操作结果
  */
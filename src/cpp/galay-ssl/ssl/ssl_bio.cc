@@ -0,0 +1,186 @@
+#include "ssl_bio.h"
+#include "ssl_ktls.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string>
+
+namespace galay::ssl::detail
+{
+
+namespace {
+
+int ringWrite(BIO* bio, const char* data, int length)
+{
+    BIO_clear_retry_flags(bio);
+    auto* ring = static_cast<SslCipherRing*>(BIO_get_data(bio));
+    if (ring == nullptr || data == nullptr || length < 0) {
+        return -1;
+    }
+    if (length == 0) {
+        return 0;
+    }
+    if (!ring->append(data, static_cast<size_t>(length))) {
+        return -1;
+    }
+    if (ring->ktls != nullptr) {
+        ring->ktls->counter.consume(reinterpret_cast<const unsigned char*>(data), static_cast<size_t>(length));
+    }
+    return length;
+}
+
+int ringRead(BIO* bio, char* data, int length)
+{
+    BIO_clear_retry_flags(bio);
+    auto* ring = static_cast<SslCipherRing*>(BIO_get_data(bio));
+    if (ring == nullptr || data == nullptr || length <= 0) {
+        return 0;
+    }
+    if (ring->readable() == 0) {
+        // 与 Memory BIO 的默认 eof 行为一致：空环表示“稍后再读”
+        BIO_set_retry_read(bio);
+        return -1;
+    }
+    const size_t read = ring->take(data, static_cast<size_t>(length));
+    if (ring->ktls != nullptr) {
+        ring->ktls->counter.consume(reinterpret_cast<const unsigned char*>(data), read);
+    }
+    return static_cast<int>(read);
+}
+
+int ringPuts(BIO* bio, const char* text)
+{
+    return ringWrite(bio, text, static_cast<int>(std::char_traits<char>::length(text)));
+}
+
+long ringCtrl(BIO* bio, int cmd, long larg, void* parg)
+{
+    auto* ring = static_cast<SslCipherRing*>(BIO_get_data(bio));
+    switch (cmd) {
+    case BIO_CTRL_PENDING:
+        return ring == nullptr ? 0 : static_cast<long>(ring->readable());
+    case BIO_CTRL_WPENDING:
+        return 0;
+    case BIO_CTRL_EOF:
+        return ring == nullptr || ring->readable() == 0 ? 1 : 0;
+    case BIO_CTRL_RESET:
+        if (ring != nullptr) {
+            ring->clear();
+        }
+        return 1;
+    case BIO_CTRL_FLUSH:
+    case BIO_CTRL_DUP:
+        return 1;
+    case BIO_CTRL_GET_CLOSE:
+        return BIO_get_shutdown(bio);
+    case BIO_CTRL_SET_CLOSE:
+        BIO_set_shutdown(bio, static_cast<int>(larg));
+        return 1;
+    case kBioCtrlSetKtls:
+        if (ring != nullptr && ring->ktls != nullptr && parg != nullptr) {
+            captureKtlsCryptoInfo(*ring->ktls, parg);
+        }
+        // 回报不支持：OpenSSL 继续在用户态加解密，直到 SslEngine 在握手后把密钥交给内核
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+int ringCreate(BIO* bio)
+{
+    BIO_set_shutdown(bio, 1);
+    BIO_set_init(bio, 1);
+    return 1;
+}
+
+int ringDestroy(BIO* bio)
+{
+    // 密文环归 SslEngine 所有，这里只解除引用
+    BIO_set_data(bio, nullptr);
+    BIO_set_init(bio, 0);
+    return 1;
+}
+
+const BIO_METHOD* ringMethod()
+{
+    static BIO_METHOD* method = [] {
+        BIO_METHOD* created = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "galay cipher ring");
+        if (created != nullptr) {
+            BIO_meth_set_write(created, ringWrite);
+            BIO_meth_set_read(created, ringRead);
+            BIO_meth_set_puts(created, ringPuts);
+            BIO_meth_set_ctrl(created, ringCtrl);
+            BIO_meth_set_create(created, ringCreate);
+            BIO_meth_set_destroy(created, ringDestroy);
+        }
+        return created;
+    }();
+    return method;
+}
+
+} // namespace
+
+SslCipherRing::SslCipherRing()
+    : m_ring(kInitialCapacity)
+{}
+
+bool SslCipherRing::reserve(size_t length)
+{
+    if (length <= m_ring.writable()) {
+        return true;
+    }
+    const size_t used = m_ring.readable();
+    if (length > std::numeric_limits<size_t>::max() - used) {
+        return false;
+    }
+    const size_t required = used + length;
+    size_t capacity = std::max(m_ring.capacity(), kInitialCapacity);
+    while (capacity < required) {
+        if (capacity > std::numeric_limits<size_t>::max() / 2) {
+            capacity = required;
+            break;
+        }
+        capacity *= 2;
+    }
+
+    // 扩容时把已有数据平移到新环开头，之后的可读/空闲段都是单段
+    Ring grown(capacity);
+    std::array<iovec, 2> segments{};
+    const size_t count = m_ring.getReadIovecs(segments.data(), segments.size());
+    for (size_t i = 0; i < count; ++i) {
+        (void)grown.tryWriteBatch(segments[i].iov_base, segments[i].iov_len);
+    }
+    m_ring = std::move(grown);
+    return true;
+}
+
+bool SslCipherRing::append(const char* data, size_t length)
+{
+    if (!reserve(length)) {
+        return false;
+    }
+    (void)m_ring.tryWriteBatch(data, length);
+    return true;
+}
+
+size_t SslCipherRing::take(char* buffer, size_t length)
+{
+    return m_ring.tryReadBatch(buffer, length);
+}
+
+BIO* newCipherRingBio(SslCipherRing* ring)
+{
+    const BIO_METHOD* method = ringMethod();
+    if (method == nullptr || ring == nullptr) {
+        return nullptr;
+    }
+    BIO* bio = BIO_new(method);
+    if (bio == nullptr) {
+        return nullptr;
+    }
+    BIO_set_data(bio, ring);
+    return bio;
+}
+
+} // namespace galay::ssl::detail
@@ -0,0 +1,105 @@
+/**
+ * @file ssl_bio.h
+ * @brief 基于 RingBuffer 的密文 BIO
+ * @author galay-ssl
+ * @version 1.0.0
+ *
+ * @details 替代 SslEngine 原先的一对 Memory BIO。每个方向一个密文环：
+ * - 输入环：socket 直接 recv/readv 进环的空闲段，OpenSSL 经 BIO 读回调从环中取记录
+ * - 输出环：OpenSSL 经 BIO 写回调把记录追加到环尾，socket 直接以环的可读段 writev
+ *
+ * 与 Memory BIO 相比，密文不再经过驱动器的临时缓冲区中转，每个字节少一次 memcpy；
+ * 输出环环绕时两段一次 writev 写出。写回调在空间不足时按倍数扩容，语义与 Memory BIO 一致，
+ * OpenSSL 不会因此看到 WantWrite。
+ *
+ * 启用 kTLS 时，两个回调同时按记录头统计流经的记录数，并在 BIO_CTRL_SET_KTLS 上截获密钥（见 ssl_ktls.h）。
+ */
+
+#ifndef GALAY_SSL_BIO_H
+#define GALAY_SSL_BIO_H
+
+#include "../../galay-utils/cache/ring_buffer.hpp"
+#include <openssl/bio.h>
+#include <cstddef>
+#include <span>
+
+namespace galay::ssl::detail
+{
+
+struct SslKtlsChannel;
+
+/**
+ * @brief 单个方向的密文环
+ */
+class SslCipherRing
+{
+public:
+    /// 初始容量：一条最大 TLS 记录（2^14 明文 + 2048 扩展 + 5 字节头）
+    static constexpr size_t kInitialCapacity = 16384 + 2048 + 5;
+
+    SslCipherRing();
+
+    /**
+     * @brief 确保至少有 length 字节空闲空间，不足时按倍数扩容并保留已有数据
+     * @return 容量溢出时返回 false
+     */
+    bool reserve(size_t length);
+
+    /**
+     * @brief 追加字节，空间不足时扩容
+     * @return 容量溢出时返回 false，环不变
+     */
+    bool append(const char* data, size_t length);
+
+    /**
+     * @brief 取出至多 length 字节
+     * @return 实际取出的字节数
+     */
+    size_t take(char* buffer, size_t length);
+
+    size_t readable() const noexcept { return m_ring.readable(); }
+    size_t writable() const noexcept { return m_ring.writable(); }
+    size_t capacity() const noexcept { return m_ring.capacity(); }
+
+    /**
+     * @brief 空闲段的 iovec 视图（最多两段）
+     */
+    size_t writeIovecs(struct iovec* out, size_t max) const noexcept { return m_ring.getWriteIovecs(out, max); }
+
+    /**
+     * @brief 已有数据的 iovec 视图（最多两段）
+     */
+    size_t readIovecs(struct iovec* out, size_t max) const noexcept { return m_ring.getReadIovecs(out, max); }
+
+    void produce(size_t length) noexcept { m_ring.produce(length); }
+    void consume(size_t length) noexcept { m_ring.consume(length); }
+    void clear() noexcept { m_ring.clear(); }
+
+    SslKtlsChannel* ktls = nullptr;     ///< 启用 kTLS 时统计记录、截获密钥的方向状态
+
+private:
+    using Ring = ::galay::utils::RingBuffer<::galay::utils::RingBufferBackendStrategy::Vector, std::dynamic_extent>;
+
+    Ring m_ring;                        ///< 密文字节
+};
+
+/**
+ * @brief 单个连接的两个密文环
+ * @details 由 SslEngine 堆上持有，BIO 以裸指针引用，引擎移动时地址不变。
+ */
+struct SslCipherRings
+{
+    SslCipherRing input;                ///< 网络 → OpenSSL
+    SslCipherRing output;               ///< OpenSSL → 网络
+};
+
+/**
+ * @brief 创建读写指定密文环的 BIO
+ * @param ring 密文环，生命周期须覆盖 BIO
+ * @return 新 BIO；失败返回 nullptr
+ */
+BIO* newCipherRingBio(SslCipherRing* ring);
+
+} // namespace galay::ssl::detail
+
+#endif // GALAY_SSL_BIO_H
@@ -433,4 +433,31 @@ void SslContext::disableSessionTickets()
     }
 }
 
+bool SslContext::setKtlsEnabled(bool enabled)
+{
+#ifdef SSL_OP_ENABLE_KTLS
+    if (!m_ctx) {
+        return false;
+    }
+    if (enabled) {
+        SSL_CTX_set_options(m_ctx, SSL_OP_ENABLE_KTLS);
+    } else {
+        SSL_CTX_clear_options(m_ctx, SSL_OP_ENABLE_KTLS);
+    }
+    return true;
+#else
+    (void)enabled;
+    return false;
+#endif
+}
+
+bool SslContext::isKtlsEnabled() const
+{
+#ifdef SSL_OP_ENABLE_KTLS
+    return m_ctx != nullptr && (SSL_CTX_get_options(m_ctx) & SSL_OP_ENABLE_KTLS) != 0;
+#else
+    return false;
+#endif
+}
+
 } // namespace galay::ssl
@@ -217,6 +217,20 @@ public:
      */
     void disableSessionTickets();
 
+    /**
+     * @brief 启用或关闭 kTLS（内核 TLS）
+     * @param enabled 是否启用
+     * @return OpenSSL 不支持 kTLS 时返回 false，配置不变
+     * @details 只影响之后创建的 SslSocket：握手完成后尝试把记录加解密交给内核，
+     *          内核缺少 tls ULP 或密码套件不受支持时该连接保持用户态加解密。
+     */
+    bool setKtlsEnabled(bool enabled);
+
+    /**
+     * @brief 是否启用了 kTLS
+     */
+    bool isKtlsEnabled() const;
+
     /**
      * @brief 获取创建时的错误
      */
@@ -1,5 +1,8 @@
 #include "ssl_engine.h"
+#include "ssl_bio.h"
+#include "ssl_ktls.h"
 #include <galay/cpp/galay-ssl/common/ssl_log.h>
+#include <cstring>
 #include <limits>
 
 namespace galay::ssl
@@ -42,6 +45,8 @@ SslEngine::SslEngine(SslEngine&& other) noexcept
     , m_ctx(other.m_ctx)
     , m_rbio(other.m_rbio)
     , m_wbio(other.m_wbio)
+    , m_rings(std::move(other.m_rings))
+    , m_ktls(std::move(other.m_ktls))
     , m_handshakeState(other.m_handshakeState)
 {
     other.m_ssl = nullptr;
@@ -62,6 +67,8 @@ SslEngine& SslEngine::operator=(SslEngine&& other) noexcept
         m_handshakeState = other.m_handshakeState;
         m_rbio = other.m_rbio;
         m_wbio = other.m_wbio;
+        m_rings = std::move(other.m_rings);
+        m_ktls = std::move(other.m_ktls);
         other.m_ssl = nullptr;
         other.m_ctx = nullptr;
         other.m_handshakeState = SslHandshakeState::NotStarted;
@@ -96,8 +103,9 @@ std::expected<void, SslError> SslEngine::initMemoryBIO()
         return std::unexpected(SslError(SslErrorCode::kSslCreateFailed));
     }
 
-    m_rbio = BIO_new(BIO_s_mem());
-    m_wbio = BIO_new(BIO_s_mem());
+    auto rings = std::make_unique<detail::SslCipherRings>();
+    m_rbio = detail::newCipherRingBio(&rings->input);
+    m_wbio = detail::newCipherRingBio(&rings->output);
     if (!m_rbio || !m_wbio) {
         SSL_LOG_ERROR("[engine] [bio]", "BIO_new failed");
         if (m_rbio) BIO_free(m_rbio);
@@ -106,48 +114,197 @@ std::expected<void, SslError> SslEngine::initMemoryBIO()
         m_wbio = nullptr;
         return std::unexpected(SslError(SslErrorCode::kSslCreateFailed));
     }
+    m_rings = std::move(rings);
 
-    // SSL_set_bio 接管 BIO 生命周期，SSL_free 时自动释放
+#ifdef SSL_OP_ENABLE_KTLS
+    if ((SSL_get_options(m_ssl) & SSL_OP_ENABLE_KTLS) != 0) {
+        // 密文环 BIO 在 OpenSSL 一侧截获密钥并统计记录；feed/extract 与驱动器直接访问密文环，不计入
+        m_ktls = std::make_unique<detail::SslKtlsState>();
+        m_rings->input.ktls = &m_ktls->rx;
+        m_rings->output.ktls = &m_ktls->tx;
+    }
+#endif
+
+    // SSL_set_bio 接管 BIO 生命周期，SSL_free 时自动释放；密文环由 m_rings 持有
     SSL_set_bio(m_ssl, m_rbio, m_wbio);
     return {};
 }
 
 std::expected<size_t, SslError> SslEngine::feedEncryptedInput(const char* data, size_t length)
 {
-    if (!m_rbio) {
+    if (!m_rings) {
         return std::unexpected(SslError(SslErrorCode::kReadFailed));
     }
     if (length > static_cast<size_t>(std::numeric_limits<int>::max())) {
         return std::unexpected(SslError(SslErrorCode::kBufferTooLarge));
     }
-
-    const int written = BIO_write(m_rbio, data, static_cast<int>(length));
-    if (written < 0) {
-        return std::unexpected(SslError::fromOpenSSL(SslErrorCode::kReadFailed));
+    if (!m_rings->input.append(data, length)) {
+        return std::unexpected(SslError(SslErrorCode::kReadFailed));
     }
-    return static_cast<size_t>(written);
+    return length;
 }
 
 std::expected<size_t, SslError> SslEngine::extractEncryptedOutput(char* buffer, size_t length)
 {
-    if (!m_wbio) {
+    if (!m_rings) {
         return std::unexpected(SslError(SslErrorCode::kWriteFailed));
     }
     if (length > static_cast<size_t>(std::numeric_limits<int>::max())) {
         return std::unexpected(SslError(SslErrorCode::kBufferTooLarge));
     }
+    return m_rings->output.take(buffer, length);
+}
+
+size_t SslEngine::prepareEncryptedInput(struct iovec* out, size_t max)
+{
+    if (!m_rings || out == nullptr || max == 0) {
+        return 0;
+    }
+    detail::SslCipherRing& input = m_rings->input;
+    if (input.writable() < kMinInputSpace && !input.reserve(kMinInputSpace)) {
+        return 0;
+    }
+    return input.writeIovecs(out, max);
+}
+
+void SslEngine::commitEncryptedInput(size_t length)
+{
+    if (m_rings) {
+        m_rings->input.produce(length);
+    }
+}
+
+size_t SslEngine::peekEncryptedOutput(struct iovec* out, size_t max) const
+{
+    if (!m_rings || out == nullptr || max == 0) {
+        return 0;
+    }
+    return m_rings->output.readIovecs(out, max);
+}
 
-    const int read = BIO_read(m_wbio, buffer, static_cast<int>(length));
-    if (read < 0) {
-        return std::unexpected(SslError::fromOpenSSL(SslErrorCode::kWriteFailed));
+void SslEngine::consumeEncryptedOutput(size_t length)
+{
+    if (m_rings) {
+        m_rings->output.consume(length);
     }
-    return static_cast<size_t>(read);
 }
 
 size_t SslEngine::pendingEncryptedOutput() const
 {
-    if (!m_wbio) return 0;
-    return BIO_ctrl_pending(m_wbio);
+    if (!m_rings) return 0;
+    return m_rings->output.readable();
+}
+
+void SslEngine::discardEncryptedOutput()
+{
+    if (m_rings) {
+        m_rings->output.clear();
+    }
+}
+
+bool SslEngine::installKtls(int fd)
+{
+    if (!m_ktls || m_ktls->unavailable || !m_ssl || !isHandshakeCompleted()) {
+        return false;
+    }
+
+    const auto attach = [this, fd]() {
+        if (m_ktls->ulp_attached) {
+            return true;
+        }
+        const int error = detail::attachTlsUlp(fd);
+        if (error != 0) {
+            m_ktls->unavailable = true;
+            SSL_LOG_INFO("[ktls] [unavailable]", "fd={} error={}", fd, std::strerror(error));
+            return false;
+        }
+        m_ktls->ulp_attached = true;
+        return true;
+    };
+
+    bool switched = false;
+    detail::SslKtlsChannel& tx = m_ktls->tx;
+    if (tx.ready() && tx.counter.atBoundary() && pendingEncryptedOutput() == 0) {
+        if (!attach()) {
+            return false;
+        }
+        const int error = detail::installKtlsChannel(fd, SslKtlsDirection::Tx, tx);
+        if (error == 0) {
+            tx.installed = true;
+            switched = true;
+            // 内核持有发送密钥后 OpenSSL 不能再产生握手记录
+            SSL_set_options(m_ssl, SSL_OP_NO_RENEGOTIATION);
+            SSL_LOG_INFO("[ktls] [tx]", "fd={} cipher={}", fd, getCipher());
+        } else {
+            tx.failed = true;
+            SSL_LOG_INFO("[ktls] [tx-fallback]", "fd={} cipher={} error={}", fd, getCipher(), std::strerror(error));
+        }
+    }
+
+    detail::SslKtlsChannel& rx = m_ktls->rx;
+    if (isKtlsPending(SslKtlsDirection::Rx) &&
+        rx.counter.atBoundary() &&
+        m_rings->input.readable() == 0 &&
+        SSL_pending(m_ssl) == 0 &&
+        SSL_has_pending(m_ssl) == 0) {
+        if (!attach()) {
+            return switched;
+        }
+        const int error = detail::installKtlsChannel(fd, SslKtlsDirection::Rx, rx);
+        if (error == 0) {
+            rx.installed = true;
+            switched = true;
+            SSL_LOG_INFO("[ktls] [rx]", "fd={} cipher={}", fd, getCipher());
+        } else {
+            rx.failed = true;
+            SSL_LOG_INFO("[ktls] [rx-fallback]", "fd={} cipher={} error={}", fd, getCipher(), std::strerror(error));
+        }
+    }
+    return switched;
+}
+
+bool SslEngine::isKtlsActive(SslKtlsDirection direction) const
+{
+    if (!m_ktls) {
+        return false;
+    }
+    return direction == SslKtlsDirection::Tx ? m_ktls->tx.installed : m_ktls->rx.installed;
+}
+
+bool SslEngine::isKtlsPending(SslKtlsDirection direction) const
+{
+    if (!m_ktls || m_ktls->unavailable || !m_ssl) {
+        return false;
+    }
+    if (direction == SslKtlsDirection::Tx) {
+        return m_ktls->tx.ready();
+    }
+    // TLS 1.3 客户端会在握手后收到 NewSessionTicket，内核接收方向遇到非应用数据记录只能报错
+    if (SSL_version(m_ssl) == TLS1_3_VERSION && !SSL_is_server(m_ssl)) {
+        return false;
+    }
+    return m_ktls->rx.ready();
+}
+
+std::optional<std::string> SslEngine::ktlsCryptoInfo(SslKtlsDirection direction) const
+{
+    if (!m_ktls) {
+        return std::nullopt;
+    }
+    const detail::SslKtlsChannel& channel = direction == SslKtlsDirection::Tx ? m_ktls->tx : m_ktls->rx;
+    if (!channel.captured() || channel.installed) {
+        return std::nullopt;
+    }
+    return channel.currentCryptoInfo();
+}
+
+bool SslEngine::sendKtlsCloseNotify(int fd)
+{
+    if (!isKtlsActive(SslKtlsDirection::Tx)) {
+        return false;
+    }
+    SSL_set_shutdown(m_ssl, SSL_get_shutdown(m_ssl) | SSL_SENT_SHUTDOWN);
+    return detail::sendKtlsCloseNotify(fd);
 }
 
 std::expected<void, SslError> SslEngine::setHostname(const std::string& hostname)
@@ -5,7 +5,7 @@
  * @version 1.0.0
  *
  * @details 封装单个 SSL 连接的状态和操作，提供非阻塞的握手、读写和关闭接口。
- * 使用 Memory BIO 模式将网络 IO 与 SSL 操作解耦，支持异步事件驱动架构。
+ * 使用基于 RingBuffer 的密文 BIO 将网络 IO 与 SSL 操作解耦，支持异步事件驱动架构。
  */
 
 #ifndef GALAY_SSL_ENGINE_H
@@ -15,11 +15,19 @@
 #include "../common/error.h"
 #include "ssl_context.h"
 #include <expected>
+#include <memory>
+#include <optional>
 #include <string>
+#include <sys/uio.h>
 
 namespace galay::ssl
 {
 
+namespace detail {
+struct SslKtlsState;
+struct SslCipherRings;
+}
+
 /**
  * @brief SSL 引擎类
  *
@@ -77,33 +85,108 @@ public:
     std::expected<void, SslError> setFd(int fd);
 
     /**
-     * @brief 使用 Memory BIO 初始化（IO 与 SSL 解耦）
+     * @brief 使用密文环 BIO 初始化（IO 与 SSL 解耦）
      * @return 成功返回 void，失败返回 SslError
+     * @details 接收、发送方向各一个密文环（见 ssl_bio.h），行为与 Memory BIO 一致，但网络 IO 可以直接读写环内存。
+     * SslContext 启用 kTLS 时，密文环 BIO 同时截获密钥（见 ssl_ktls.h）。
      */
     std::expected<void, SslError> initMemoryBIO();
 
     /**
-     * @brief 将从网络 recv 到的密文喂给 SSL（写入 rbio）
+     * @brief 将从网络 recv 到的密文喂给 SSL（复制进输入密文环）
      * @param data 密文数据
      * @param length 数据长度
-     * @return 成功返回实际写入 BIO 的字节数，失败返回 SslError；不会阻塞
+     * @return 成功返回实际写入的字节数，失败返回 SslError；不会阻塞
+     * @note 驱动器使用 prepareEncryptedInput()/commitEncryptedInput() 免复制收取，本接口用于内存管道等场景
      */
     std::expected<size_t, SslError> feedEncryptedInput(const char* data, size_t length);
 
     /**
-     * @brief 从 SSL 取出待发送的密文（读取 wbio）
+     * @brief 从 SSL 取出待发送的密文（复制出输出密文环）
      * @param buffer 输出缓冲区
      * @param length 缓冲区大小
      * @return 成功返回实际读取的字节数，失败返回 SslError；不会阻塞
+     * @note 驱动器使用 peekEncryptedOutput()/consumeEncryptedOutput() 免复制发送，本接口用于内存管道等场景
      */
     std::expected<size_t, SslError> extractEncryptedOutput(char* buffer, size_t length);
 
     /**
-     * @brief 检查 wbio 中是否有待发送的密文
+     * @brief 输入密文环的空闲段，socket 直接 recv/readv 到这里
+     * @param out iovec 输出数组
+     * @param max out 的容量（两段即可覆盖环绕）
+     * @return 段数；未初始化时返回 0
+     * @details 空闲空间不足 kMinInputSpace 时先扩容；收取完成后调用 commitEncryptedInput()
+     */
+    size_t prepareEncryptedInput(struct iovec* out, size_t max);
+
+    /**
+     * @brief 确认 socket 已写入 prepareEncryptedInput() 返回的前 length 字节
+     */
+    void commitEncryptedInput(size_t length);
+
+    /**
+     * @brief 输出密文环中待发送数据的视图，socket 直接 writev 这些段
+     * @param out iovec 输出数组
+     * @param max out 的容量（两段即可覆盖环绕）
+     * @return 段数；没有待发送密文时返回 0
+     * @details 视图在下一次 SSL 写操作或 consumeEncryptedOutput() 之前有效
+     */
+    size_t peekEncryptedOutput(struct iovec* out, size_t max) const;
+
+    /**
+     * @brief 从输出密文环头部移除已写出的 length 字节
+     */
+    void consumeEncryptedOutput(size_t length);
+
+    /**
+     * @brief 检查输出密文环中是否有待发送的密文
      * @return 待发送的密文字节数
      */
     size_t pendingEncryptedOutput() const;
 
+    /**
+     * @brief 丢弃输出密文环中尚未写出的密文
+     * @note 仅在发送方向已交给内核后使用：此后 OpenSSL 产生的记录序号与内核不一致，不能写出
+     */
+    void discardEncryptedOutput();
+
+    /**
+     * @brief 尝试把已截获的密钥交给内核（kTLS）
+     * @param fd 已完成握手的 TCP socket
+     * @return 本次至少切换了一个方向时返回 true
+     * @details 可重复调用，只处理尚未切换且满足条件的方向：
+     * - 发送方向：输出密文环中的密文已全部写出
+     * - 接收方向：输入密文环为空、已读入的密文恰好结束在记录边界、OpenSSL 中没有未读明文；
+     *   TLS 1.3 客户端不切换（会话票据等握手后消息内核无法处理）
+     *
+     * 内核没有 tls ULP 时整个连接保持用户态，之后的调用直接返回 false。
+     */
+    bool installKtls(int fd);
+
+    /**
+     * @brief 指定方向是否已由内核加解密
+     */
+    bool isKtlsActive(SslKtlsDirection direction) const;
+
+    /**
+     * @brief 指定方向的密钥已截获、尚待切换
+     * @details 接收方向要等到密文落在记录边界才能切换，读路径据此在每次收取前重试 installKtls()
+     */
+    bool isKtlsPending(SslKtlsDirection direction) const;
+
+    /**
+     * @brief 导出已截获密钥在当前记录序号下的内核 crypto_info
+     * @return struct tls12_crypto_info_* 的字节，可直接用于 setsockopt(SOL_TLS)；
+     *         未截获或已交给内核时返回 std::nullopt
+     */
+    std::optional<std::string> ktlsCryptoInfo(SslKtlsDirection direction) const;
+
+    /**
+     * @brief 发送方向已交给内核时，经内核写出 close_notify
+     * @return 告警已进入 socket 发送缓冲区时返回 true
+     */
+    bool sendKtlsCloseNotify(int fd);
+
     /**
      * @brief 设置 SNI 主机名
      * @param hostname 服务器主机名
@@ -224,11 +307,16 @@ public:
      */
     bool isSessionReused() const;
 
+    /// 每次收取前输入密文环至少保留的空闲字节（一条最大 TLS 记录）
+    static constexpr size_t kMinInputSpace = 16384 + 2048 + 5;
+
 private:
     SSL* m_ssl;                         ///< OpenSSL SSL 对象
     SslContext* m_ctx;                  ///< SSL 上下文（不拥有）
-    BIO* m_rbio = nullptr;             ///< read BIO（网络密文 → SSL）
-    BIO* m_wbio = nullptr;             ///< write BIO（SSL → 网络密文）
+    BIO* m_rbio = nullptr;             ///< read BIO（网络密文 → SSL），由 SSL 对象持有
+    BIO* m_wbio = nullptr;             ///< write BIO（SSL → 网络密文），由 SSL 对象持有
+    std::unique_ptr<detail::SslCipherRings> m_rings; ///< 两个方向的密文环，BIO 以裸指针引用
+    std::unique_ptr<detail::SslKtlsState> m_ktls; ///< kTLS 截获与切换状态，未启用时为空
     SslHandshakeState m_handshakeState; ///< 握手状态
 };
 
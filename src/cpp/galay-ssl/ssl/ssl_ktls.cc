@@ -0,0 +1,257 @@
+#include "ssl_ktls.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/tls.h>)
+#define GALAY_SSL_HAS_KTLS 1
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <cstddef>
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TLS_GET_RECORD_TYPE
+#define TLS_GET_RECORD_TYPE 2
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
+namespace galay::ssl::detail
+{
+
+namespace {
+
+uint64_t loadBigEndian64(const unsigned char* data)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+void storeBigEndian64(unsigned char* data, uint64_t value)
+{
+    for (size_t i = 8; i > 0; --i) {
+        data[i - 1] = static_cast<unsigned char>(value & 0xff);
+        value >>= 8;
+    }
+}
+
+#ifdef GALAY_SSL_HAS_KTLS
+/**
+ * @brief 按 cipher_type 确定内核 crypto_info 的长度与 rec_seq 偏移
+ * @return 内核不认识的套件返回 false
+ */
+bool cryptoInfoLayout(uint16_t cipher_type, size_t& size, size_t& rec_seq_offset)
+{
+    switch (cipher_type) {
+    case TLS_CIPHER_AES_GCM_128:
+        size = sizeof(tls12_crypto_info_aes_gcm_128);
+        rec_seq_offset = offsetof(tls12_crypto_info_aes_gcm_128, rec_seq);
+        return true;
+#ifdef TLS_CIPHER_AES_GCM_256
+    case TLS_CIPHER_AES_GCM_256:
+        size = sizeof(tls12_crypto_info_aes_gcm_256);
+        rec_seq_offset = offsetof(tls12_crypto_info_aes_gcm_256, rec_seq);
+        return true;
+#endif
+#ifdef TLS_CIPHER_AES_CCM_128
+    case TLS_CIPHER_AES_CCM_128:
+        size = sizeof(tls12_crypto_info_aes_ccm_128);
+        rec_seq_offset = offsetof(tls12_crypto_info_aes_ccm_128, rec_seq);
+        return true;
+#endif
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305:
+        size = sizeof(tls12_crypto_info_chacha20_poly1305);
+        rec_seq_offset = offsetof(tls12_crypto_info_chacha20_poly1305, rec_seq);
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+#endif
+
+} // namespace
+
+void SslRecordCounter::consume(const unsigned char* data, size_t length) noexcept
+{
+    while (length > 0) {
+        if (m_body_remaining > 0) {
+            const size_t step = std::min(m_body_remaining, length);
+            m_body_remaining -= step;
+            data += step;
+            length -= step;
+            if (m_body_remaining == 0) {
+                ++m_records;
+            }
+            continue;
+        }
+        const size_t step = std::min<size_t>(sizeof(m_header) - m_header_fill, length);
+        std::memcpy(m_header + m_header_fill, data, step);
+        m_header_fill = static_cast<uint8_t>(m_header_fill + step);
+        data += step;
+        length -= step;
+        if (m_header_fill == sizeof(m_header)) {
+            m_header_fill = 0;
+            m_body_remaining = (static_cast<size_t>(m_header[3]) << 8) | m_header[4];
+            if (m_body_remaining == 0) {
+                ++m_records;
+            }
+        }
+    }
+}
+
+std::string SslKtlsChannel::currentCryptoInfo() const
+{
+    if (!captured()) {
+        return {};
+    }
+    std::string info(reinterpret_cast<const char*>(crypto_info.data()), crypto_info_size);
+    auto* rec_seq = reinterpret_cast<unsigned char*>(info.data()) + rec_seq_offset;
+    storeBigEndian64(rec_seq, loadBigEndian64(rec_seq) + (counter.records() - records_at_capture));
+    return info;
+}
+
+void captureKtlsCryptoInfo(SslKtlsChannel& channel, const void* parg)
+{
+#ifdef GALAY_SSL_HAS_KTLS
+    tls_crypto_info header{};
+    std::memcpy(&header, parg, sizeof(header));
+    size_t size = 0;
+    size_t rec_seq_offset = 0;
+    if (!cryptoInfoLayout(header.cipher_type, size, rec_seq_offset) ||
+        size > SslKtlsChannel::kMaxCryptoInfoSize) {
+        return;
+    }
+    // 截获点之后的第一条记录必须从新密钥的 rec_seq 开始计数
+    if (!channel.counter.atBoundary()) {
+        channel.failed = true;
+        return;
+    }
+    std::memcpy(channel.crypto_info.data(), parg, size);
+    channel.crypto_info_size = size;
+    channel.rec_seq_offset = rec_seq_offset;
+    channel.records_at_capture = channel.counter.records();
+#else
+    (void)channel;
+    (void)parg;
+#endif
+}
+
+int attachTlsUlp(int fd) noexcept
+{
+#ifdef GALAY_SSL_HAS_KTLS
+    if (::setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0) {
+        return 0;
+    }
+    return errno;
+#else
+    (void)fd;
+    return ENOTSUP;
+#endif
+}
+
+int installKtlsChannel(int fd, SslKtlsDirection direction, const SslKtlsChannel& channel)
+{
+#ifdef GALAY_SSL_HAS_KTLS
+    const std::string info = channel.currentCryptoInfo();
+    if (info.empty()) {
+        return EINVAL;
+    }
+    const int optname = direction == SslKtlsDirection::Tx ? TLS_TX : TLS_RX;
+    if (::setsockopt(fd, SOL_TLS, optname, info.data(), static_cast<socklen_t>(info.size())) == 0) {
+        return 0;
+    }
+    return errno;
+#else
+    (void)fd;
+    (void)direction;
+    (void)channel;
+    return ENOTSUP;
+#endif
+}
+
+SslKtlsRecordAction classifyKtlsRecord(uint8_t record_type, const char* data, size_t length) noexcept
+{
+    switch (record_type) {
+    case kTlsRecordApplicationData:
+        return SslKtlsRecordAction::kData;
+    case kTlsRecordAlert:
+        // 告警负载为 level、description 两字节，description=0 即 close_notify
+        return length >= 2 && data[1] == 0 ? SslKtlsRecordAction::kCloseNotify : SslKtlsRecordAction::kFail;
+    default:
+        return SslKtlsRecordAction::kFail;
+    }
+}
+
+ssize_t recvKtlsRecord(int fd, char* buffer, size_t length, uint8_t& record_type) noexcept
+{
+    record_type = kTlsRecordApplicationData;
+#ifdef GALAY_SSL_HAS_KTLS
+    iovec iov{buffer, length};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(unsigned char))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    const ssize_t received = ::recvmsg(fd, &msg, MSG_DONTWAIT);
+    if (received < 0) {
+        return received;
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_TLS && cmsg->cmsg_type == TLS_GET_RECORD_TYPE) {
+            record_type = *CMSG_DATA(cmsg);
+        }
+    }
+    return received;
+#else
+    (void)fd;
+    (void)buffer;
+    (void)length;
+    errno = ENOTSUP;
+    return -1;
+#endif
+}
+
+bool sendKtlsRecord(int fd, uint8_t record_type, const void* data, size_t length) noexcept
+{
+#ifdef GALAY_SSL_HAS_KTLS
+    iovec iov{const_cast<void*>(data), length};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(unsigned char))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_TLS;
+    cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+    *CMSG_DATA(cmsg) = record_type;
+    return ::sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL) == static_cast<ssize_t>(length);
+#else
+    (void)fd;
+    (void)record_type;
+    (void)data;
+    (void)length;
+    return false;
+#endif
+}
+
+bool sendKtlsCloseNotify(int fd) noexcept
+{
+    // level=warning(1), description=close_notify(0)
+    const unsigned char alert[2] = {1, 0};
+    return sendKtlsRecord(fd, kTlsRecordAlert, alert, sizeof(alert));
+}
+
+} // namespace galay::ssl::detail
@@ -0,0 +1,162 @@
+/**
+ * @file ssl_ktls.h
+ * @brief kTLS（内核 TLS）密钥截获与安装
+ * @author galay-ssl
+ * @version 1.0.0
+ *
+ * @details OpenSSL 只在 socket BIO 上启用 kTLS，而 SslEngine 使用自己的密文环 BIO 解耦网络 IO（见 ssl_bio.h）。
+ * 设置了 SSL_OP_ENABLE_KTLS 的 SSL 对象在切换密钥时会向 BIO 下发内核格式的 crypto_info，
+ * 密文环 BIO 复制一份后回报“不支持”，OpenSSL 因而继续在用户态完成握手收尾（Finished、NewSessionTicket 等）；
+ * 密文环 BIO 同时按记录头统计之后流经的记录数。
+ * 握手完成、密文全部写出后，以截获时的序号加上已流经的记录数作为内核的起始序号，
+ * 经 setsockopt(SOL_TLS) 安装。
+ *
+ * 内核没有 tls ULP、密码套件不受支持或平台不是 Linux 时，对应方向保持用户态加解密。
+ */
+
+#ifndef GALAY_SSL_KTLS_H
+#define GALAY_SSL_KTLS_H
+
+#include "../common/defn.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+namespace galay::ssl::detail
+{
+
+/**
+ * @brief TLS 记录流计数器
+ * @details 按 5 字节记录头切分字节流，统计完整通过的记录数；记录可以跨多次调用到达。
+ */
+class SslRecordCounter
+{
+public:
+    /**
+     * @brief 统计一段流经 BIO 的字节
+     */
+    void consume(const unsigned char* data, size_t length) noexcept;
+
+    /**
+     * @brief 是否恰好位于两条记录之间
+     */
+    bool atBoundary() const noexcept { return m_header_fill == 0 && m_body_remaining == 0; }
+
+    /**
+     * @brief 已完整通过的记录数
+     */
+    uint64_t records() const noexcept { return m_records; }
+
+private:
+    uint64_t m_records = 0;             ///< 已完整通过的记录数
+    size_t m_body_remaining = 0;        ///< 当前记录尚未通过的负载字节数
+    unsigned char m_header[5] = {};     ///< 跨调用拼接中的记录头
+    uint8_t m_header_fill = 0;          ///< m_header 中的字节数
+};
+
+/**
+ * @brief 单个方向的 kTLS 状态
+ */
+struct SslKtlsChannel
+{
+    static constexpr size_t kMaxCryptoInfoSize = 64;
+
+    std::array<unsigned char, kMaxCryptoInfoSize> crypto_info{};  ///< 截获的 struct tls12_crypto_info_*
+    size_t crypto_info_size = 0;        ///< crypto_info 有效字节数，0 表示尚未截获
+    size_t rec_seq_offset = 0;          ///< rec_seq 字段在 crypto_info 中的偏移
+    uint64_t records_at_capture = 0;    ///< 截获时计数器已统计的记录数
+    SslRecordCounter counter;           ///< 流经该方向 BIO 的记录计数
+    bool installed = false;             ///< 已交给内核
+    bool failed = false;                ///< 截获时不在记录边界或内核拒绝安装，保持用户态
+
+    bool captured() const noexcept { return crypto_info_size != 0; }
+    bool ready() const noexcept { return captured() && !installed && !failed; }
+
+    /**
+     * @brief 当前记录序号下的 crypto_info
+     * @return 截获时的 rec_seq 加上之后流经的记录数；未截获时返回空串
+     */
+    std::string currentCryptoInfo() const;
+};
+
+/**
+ * @brief 单个连接的 kTLS 状态
+ * @details 由 SslEngine 堆上持有，密文环 BIO 以裸指针引用其中的 SslKtlsChannel，引擎移动时地址不变。
+ */
+struct SslKtlsState
+{
+    SslKtlsChannel tx;                  ///< 发送方向
+    SslKtlsChannel rx;                  ///< 接收方向
+    bool ulp_attached = false;          ///< 已挂载 tls ULP
+    bool unavailable = false;           ///< 内核没有 tls ULP，整个连接保持用户态
+};
+
+/// TLS 记录类型（ContentType），TLS 1.3 中为内层类型
+inline constexpr uint8_t kTlsRecordAlert = 21;
+inline constexpr uint8_t kTlsRecordHandshake = 22;
+inline constexpr uint8_t kTlsRecordApplicationData = 23;
+
+/**
+ * @brief 内核接收方向读到的一条记录应如何交付
+ */
+enum class SslKtlsRecordAction : uint8_t {
+    kData,          ///< 应用数据，按明文交付
+    kCloseNotify,   ///< 对端 close_notify，按有序关闭交付 EOF
+    kFail,          ///< 其他告警或握手记录（KeyUpdate、NewSessionTicket 等），连接无法继续
+};
+
+/**
+ * @brief 按记录类型与内容判定内核接收方向的一次读取结果
+ * @param record_type recvmsg 返回的 TLS_GET_RECORD_TYPE
+ * @param data 记录负载
+ * @param length 负载字节数
+ */
+SslKtlsRecordAction classifyKtlsRecord(uint8_t record_type, const char* data, size_t length) noexcept;
+
+/**
+ * @brief 从内核 TLS 接收方向读取一条记录
+ * @details 以 recvmsg 附带 TLS_GET_RECORD_TYPE 控制消息读取，内核不会把不同类型的记录合并到一次读取中；
+ *          没有控制消息时按应用数据处理
+ * @param record_type 输出记录类型
+ * @return 读取字节数；失败返回 -1 并保留 errno
+ */
+ssize_t recvKtlsRecord(int fd, char* buffer, size_t length, uint8_t& record_type) noexcept;
+
+/**
+ * @brief 经内核 TLS 发送方向写出一条指定类型的记录
+ * @return 记录已完整进入 socket 发送缓冲区时返回 true
+ */
+bool sendKtlsRecord(int fd, uint8_t record_type, const void* data, size_t length) noexcept;
+
+/// OpenSSL 内部的 BIO_CTRL_SET_KTLS，未导出到公共头文件：larg 为方向（非 0 表示发送），parg 为 crypto_info
+inline constexpr int kBioCtrlSetKtls = 72;
+
+/**
+ * @brief 记录 BIO_CTRL_SET_KTLS 下发的 crypto_info
+ * @details 截获时该方向必须恰好位于记录边界，否则标记 failed，该方向保持用户态
+ */
+void captureKtlsCryptoInfo(SslKtlsChannel& channel, const void* parg);
+
+/**
+ * @brief 为 socket 挂载 tls ULP
+ * @return 成功返回 0，否则返回 errno（ENOENT 表示内核没有 tls 模块）
+ */
+int attachTlsUlp(int fd) noexcept;
+
+/**
+ * @brief 以当前记录序号安装一个方向的密钥
+ * @return 成功返回 0，否则返回 errno
+ */
+int installKtlsChannel(int fd, SslKtlsDirection direction, const SslKtlsChannel& channel);
+
+/**
+ * @brief 经内核 TLS 发送方向写出 close_notify 告警
+ * @return 告警已进入 socket 发送缓冲区时返回 true
+ */
+bool sendKtlsCloseNotify(int fd) noexcept;
+
+} // namespace galay::ssl::detail
+
+#endif // GALAY_SSL_KTLS_H
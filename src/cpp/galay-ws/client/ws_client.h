@@ -65,6 +65,7 @@ struct WsClientConfig
 {
     bool tcp_no_delay = true; ///< 是否为连接 socket 启用 TCP_NODELAY
     HeaderPair::Mode header_mode = HeaderPair::Mode::ClientSide; ///< HTTP 头部归一化策略
+    WsDeflateConfig deflate;  ///< permessage-deflate 提议配置，默认不提议
 };
 
 /**
@@ -75,6 +76,7 @@ class WsClientBuilder {
 public:
     WsClientBuilder& tcpNoDelay(bool v) { m_config.tcp_no_delay = v; return *this; }
     WsClientBuilder& headerMode(HeaderPair::Mode v) { m_config.header_mode = v; return *this; }
+    WsClientBuilder& perMessageDeflate(WsDeflateConfig v) { m_config.deflate = v; return *this; }
     WsClientImpl<AsyncTcpSocket> build() const;
     WsClientConfig buildConfig() const { return m_config; }
 
@@ -671,7 +673,7 @@ public:
             return std::unexpected(WsError(kWsConnectionError, "WsClient not connected. Call connect() first."));
         }
         return std::make_unique<WsSessionImpl<SocketType>>(
-            *m_socket, m_url, writer_setting, ring_buffer_size, reader_setting);
+            *m_socket, m_url, writer_setting, ring_buffer_size, reader_setting, m_config.deflate);
     }
 
     /**
@@ -740,6 +742,7 @@ struct WssClientConfig
     int verify_depth = 4;           ///< 证书链校验深度
     bool tcp_no_delay = true;       ///< 是否为底层 TCP 连接启用 TCP_NODELAY
     HeaderPair::Mode header_mode = HeaderPair::Mode::ClientSide; ///< HTTP 头部归一化策略
+    WsDeflateConfig deflate;        ///< permessage-deflate 提议配置，默认不提议
 };
 
 class WssClient;
@@ -755,6 +758,7 @@ public:
     WssClientBuilder& verifyDepth(int v) { m_config.verify_depth = v; return *this; }
     WssClientBuilder& tcpNoDelay(bool v) { m_config.tcp_no_delay = v; return *this; }
     WssClientBuilder& headerMode(HeaderPair::Mode v) { m_config.header_mode = v; return *this; }
+    WssClientBuilder& perMessageDeflate(WsDeflateConfig v) { m_config.deflate = v; return *this; }
     WssClient build() const;
     WssClientConfig buildConfig() const { return m_config; }
 
@@ -857,6 +861,7 @@ private:
         WsClientConfig base_config;
         base_config.tcp_no_delay = config.tcp_no_delay;
         base_config.header_mode = config.header_mode;
+        base_config.deflate = config.deflate;
         return base_config;
     }
 
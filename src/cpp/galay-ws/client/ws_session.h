@@ -215,6 +215,12 @@ public:
                 return ParseStatus::kCompleted;
             }
 
+            auto extensions = session.applyUpgradeExtensions(m_upgrade_response);
+            if (!extensions) {
+                ops.complete(std::unexpected(std::move(extensions.error())));
+                return ParseStatus::kCompleted;
+            }
+
             session.m_upgraded = true;
             ops.complete(true);
             return ParseStatus::kCompleted;
@@ -231,6 +237,7 @@ public:
                 .header("Sec-WebSocket-Key", m_ws_key)
                 .header("Sec-WebSocket-Version", "13")
                 .build();
+            session.appendExtensionOffer(request);
 
             m_send_buffer = request.toString();
         }
@@ -499,6 +506,12 @@ public:
                 return true;
             }
 
+            auto extensions = session.applyUpgradeExtensions(m_upgrade_response);
+            if (!extensions) {
+                m_error = std::move(extensions.error());
+                return true;
+            }
+
             session.m_upgraded = true;
             m_result = true;
             return true;
@@ -533,6 +546,7 @@ public:
                 .header("Sec-WebSocket-Key", m_ws_key)
                 .header("Sec-WebSocket-Version", "13")
                 .build();
+            session.appendExtensionOffer(request);
 
             m_send_buffer = request.toString();
         }
@@ -743,13 +757,15 @@ public:
                   const WsUrl& url,
                   const WsWriterSetting& writer_setting,
                   size_t ring_buffer_size = 8192,
-                  const WsReaderSetting& reader_setting = WsReaderSetting())
+                  const WsReaderSetting& reader_setting = WsReaderSetting(),
+                  const WsDeflateConfig& deflate_config = WsDeflateConfig())
         : m_socket(socket)
         , m_url(url)
         , m_ring_buffer(ring_buffer_size)
         , m_reader(m_ring_buffer, reader_setting, socket, false, true)  // is_server=false, use_mask=true (客户端)
         , m_writer(writer_setting, socket)
         , m_upgraded(false)
+        , m_deflate_config(deflate_config)
     {
     }
 
@@ -780,6 +796,13 @@ public:
         return m_upgraded;
     }
 
+    /**
+     * @brief 获取 permessage-deflate 上下文，服务端未接受扩展时为 nullptr
+     */
+    const WsPerMessageDeflate* perMessageDeflate() const {
+        return m_deflate.get();
+    }
+
     // 便捷方法：发送文本消息
     auto sendText(const std::string& text, bool fin = true) {
         return m_writer.sendText(text, fin);
@@ -832,12 +855,50 @@ public:
     friend class WsSessionUpgraderImpl<SocketType>;
 
 private:
+    /**
+     * @brief 在升级请求中附上 permessage-deflate 提议
+     */
+    void appendExtensionOffer(HttpRequest& request) const {
+        std::string offer = formatWsDeflateOffer(m_deflate_config);
+        if (!offer.empty()) {
+            request.header().headerPairs().addHeaderPair("Sec-WebSocket-Extensions", offer);
+        }
+    }
+
+    /**
+     * @brief 校验 101 响应中的 Sec-WebSocket-Extensions 并启用压缩
+     * @return 服务端接受了未提议的扩展或参数越界时返回 kWsUpgradeFailed
+     */
+    std::expected<void, WsError> applyUpgradeExtensions(HttpResponse& response) {
+        std::string extensions;
+        if (response.header().headerPairs().hasKey("Sec-WebSocket-Extensions")) {
+            extensions = response.header().headerPairs().getValue("Sec-WebSocket-Extensions");
+        }
+        auto accepted = acceptWsDeflateResponse(extensions, m_deflate_config);
+        if (!accepted) {
+            return std::unexpected(std::move(accepted.error()));
+        }
+        if (!accepted->has_value()) {
+            return {};
+        }
+        auto deflate = WsPerMessageDeflate::create(**accepted, m_deflate_config, false);
+        if (!deflate) {
+            return std::unexpected(std::move(deflate.error()));
+        }
+        m_deflate = std::move(*deflate);
+        m_reader.setPerMessageDeflate(m_deflate.get());
+        m_writer.setPerMessageDeflate(m_deflate.get());
+        return {};
+    }
+
     SocketType& m_socket;
     const WsUrl& m_url;
     RingBuffer<galay::utils::RingBufferBackendStrategy::Mmap, std::dynamic_extent> m_ring_buffer;
     WsReaderImpl<SocketType> m_reader;
     WsWriterImpl<SocketType> m_writer;
     bool m_upgraded;
+    WsDeflateConfig m_deflate_config;
+    std::unique_ptr<WsPerMessageDeflate> m_deflate;
 };
 
 using WsSession = WsSessionImpl<AsyncTcpSocket>;
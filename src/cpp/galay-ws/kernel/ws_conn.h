@@ -104,7 +104,10 @@ struct WsEchoMachine {
         , m_writer(resolveWriterSetting(conn, writer_setting), conn->m_socket)
         , m_message(&message)
         , m_opcode(&opcode)
-        , m_preserve_message(preserve_message) {}
+        , m_preserve_message(preserve_message) {
+        m_read_state.setPerMessageDeflate(conn->m_deflate.get());
+        m_writer.setPerMessageDeflate(conn->m_deflate.get());
+    }
 
 private:
     WsEchoMachine(const WsEchoMachine&) = delete;
@@ -190,7 +193,8 @@ private:
     };
 
     MachineAction<result_type> advanceRead() {
-        if (!m_preserve_message && tryPrepareZeroCopy()) {
+        // 协商了 permessage-deflate 时回显需要重新压缩，不走原帧零拷贝
+        if (!m_preserve_message && m_conn->m_deflate == nullptr && tryPrepareZeroCopy()) {
             m_stage = Stage::kWrite;
             return advanceWrite();
         }
@@ -218,10 +222,12 @@ private:
 
         if (*m_opcode == WsOpcode::Text) {
             ++m_conn->m_echo_counters.composite_hits;
-            if (m_preserve_message) {
-                m_writer.prepareSendFrame(WsFrameParser::createTextFrame(*m_message));
-            } else {
-                m_writer.prepareSendFrame(WsFrameParser::createTextFrame(std::move(*m_message)));
+            if (!m_writer.tryPrepareDeflatedMessage(WsOpcode::Text, *m_message, true)) {
+                if (m_preserve_message) {
+                    m_writer.prepareSendFrame(WsFrameParser::createTextFrame(*m_message));
+                } else {
+                    m_writer.prepareSendFrame(WsFrameParser::createTextFrame(std::move(*m_message)));
+                }
             }
             m_stage = Stage::kWrite;
             return advanceWrite();
@@ -229,10 +235,12 @@ private:
 
         if (*m_opcode == WsOpcode::Binary) {
             ++m_conn->m_echo_counters.composite_hits;
-            if (m_preserve_message) {
-                m_writer.prepareSendFrame(WsFrameParser::createBinaryFrame(*m_message));
-            } else {
-                m_writer.prepareSendFrame(WsFrameParser::createBinaryFrame(std::move(*m_message)));
+            if (!m_writer.tryPrepareDeflatedMessage(WsOpcode::Binary, *m_message, true)) {
+                if (m_preserve_message) {
+                    m_writer.prepareSendFrame(WsFrameParser::createBinaryFrame(*m_message));
+                } else {
+                    m_writer.prepareSendFrame(WsFrameParser::createBinaryFrame(std::move(*m_message)));
+                }
             }
             m_stage = Stage::kWrite;
             return advanceWrite();
@@ -394,7 +402,10 @@ struct WsSslEchoMachine {
         , m_writer(resolveWriterSetting(conn, writer_setting), conn->m_socket)
         , m_message(&message)
         , m_opcode(&opcode)
-        , m_preserve_message(preserve_message) {}
+        , m_preserve_message(preserve_message) {
+        m_read_state.setPerMessageDeflate(conn->m_deflate.get());
+        m_writer.setPerMessageDeflate(conn->m_deflate.get());
+    }
 
 private:
     WsSslEchoMachine(const WsSslEchoMachine&) = delete;
@@ -488,7 +499,8 @@ private:
     };
 
     galay::ssl::SslMachineAction<result_type> advanceRead() {
-        if (!m_preserve_message && tryPrepareZeroCopy()) {
+        // 协商了 permessage-deflate 时回显需要重新压缩，不走原帧零拷贝
+        if (!m_preserve_message && m_conn->m_deflate == nullptr && tryPrepareZeroCopy()) {
             m_stage = Stage::kWrite;
             return advanceWrite();
         }
@@ -683,7 +695,10 @@ struct WsSslEchoLoopMachine {
                        conn->m_is_server,
                        !conn->m_is_server,
                        nullptr)
-        , m_writer(resolveWriterSetting(conn, writer_setting), conn->m_socket) {}
+        , m_writer(resolveWriterSetting(conn, writer_setting), conn->m_socket) {
+        m_read_state.setPerMessageDeflate(conn->m_deflate.get());
+        m_writer.setPerMessageDeflate(conn->m_deflate.get());
+    }
 
     WsSslEchoLoopMachine(const WsSslEchoLoopMachine&) = delete;
     WsSslEchoLoopMachine& operator=(const WsSslEchoLoopMachine&) = delete;
@@ -828,7 +843,7 @@ private:
     };
 
     galay::ssl::SslMachineAction<result_type> advanceRead() {
-        if (tryPrepareZeroCopy()) {
+        if (m_conn->m_deflate == nullptr && tryPrepareZeroCopy()) {
             m_stage = Stage::kWrite;
             m_write_mode = WriteMode::kDirect;
             return advanceWrite();
@@ -1127,7 +1142,9 @@ public:
     WsReaderImpl<SocketType> getReader(const WsReaderSetting& setting = WsReaderSetting()) {
         // use_mask: 客户端需要mask，服务器不需要
         bool use_mask = !m_is_server;
-        return WsReaderImpl<SocketType>(m_ring_buffer, setting, m_socket, m_is_server, use_mask);
+        WsReaderImpl<SocketType> reader(m_ring_buffer, setting, m_socket, m_is_server, use_mask);
+        reader.setPerMessageDeflate(m_deflate.get());
+        return reader;
     }
 
     /**
@@ -1138,9 +1155,33 @@ public:
     WsWriterImpl<SocketType> getWriter(WsWriterSetting setting) {
         // 客户端需要mask，服务器不需要
         setting.use_mask = !m_is_server;
-        return WsWriterImpl<SocketType>(setting, m_socket);
+        WsWriterImpl<SocketType> writer(setting, m_socket);
+        writer.setPerMessageDeflate(m_deflate.get());
+        return writer;
     }
 
+    /**
+     * @brief 启用 permessage-deflate
+     * @param params 握手协商结果（服务端取自 WsUpgradeResult::deflate）
+     * @param config 本端配置，需与协商时使用的一致
+     * @return 创建压缩上下文失败返回 kWsCompressionError
+     * @details 须在获取 reader / writer 或开始回显之前调用；之后创建的 reader / writer 共享同一上下文。
+     */
+    std::expected<void, WsError> enablePerMessageDeflate(const WsDeflateParams& params,
+                                                         const WsDeflateConfig& config) {
+        auto deflate = WsPerMessageDeflate::create(params, config, m_is_server);
+        if (!deflate) {
+            return std::unexpected(std::move(deflate.error()));
+        }
+        m_deflate = std::move(*deflate);
+        return {};
+    }
+
+    /**
+     * @brief 获取 permessage-deflate 上下文，未启用时为 nullptr
+     */
+    const WsPerMessageDeflate* perMessageDeflate() const { return m_deflate.get(); }
+
     /**
      * @brief 执行一次回显操作（读取并原样发送回消息）
      * @param message 消息内容引用
@@ -1248,6 +1289,7 @@ private:
     EchoCounters m_echo_counters;
     std::string m_loop_message_scratch;
     WsOpcode m_loop_opcode_scratch = WsOpcode::Close;
+    std::unique_ptr<WsPerMessageDeflate> m_deflate;   ///< permessage-deflate 上下文，未协商为空
 };
 
 // 类型别名 - WebSocket over TCP
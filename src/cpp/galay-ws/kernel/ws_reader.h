@@ -14,8 +14,10 @@
 
 #include "reader_cfg.h"
 #include "../../galay-http/common/iovec_utils.h"
+#include "../protoc/ws_deflate.h"
 #include "../protoc/ws_error.h"
 #include "../protoc/ws_frame.h"
+#include "../protoc/ws_utf8.h"
 #include "../../galay-kernel/async/async_tcp.h"
 #include "../../galay-utils/cache/bytes.hpp"
 #include "../../galay-utils/cache/ring_buffer.hpp"
@@ -157,78 +159,19 @@ inline bool wsIsValidUtf8MaskedSpan(const char* data,
 inline bool wsIsValidUtf8MaskedIovecs(const struct iovec* iovecs,
                                       size_t iovec_count,
                                       const uint8_t masking_key[4]) noexcept {
-    size_t total_length = 0;
+    // 负载在 RingBuffer 回绕处被切成两段，码点前缀由校验器跨段携带
+    WsUtf8Validator validator;
+    size_t key_offset = 0;
     for (size_t i = 0; i < iovec_count; ++i) {
-        total_length += iovecs[i].iov_len;
-    }
-
-    size_t logical_index = 0;
-    auto masked = [&](size_t absolute_index) noexcept -> uint8_t {
-        size_t cursor = absolute_index;
-        for (size_t i = 0; i < iovec_count; ++i) {
-            if (cursor < iovecs[i].iov_len) {
-                return static_cast<uint8_t>(
-                    static_cast<const char*>(iovecs[i].iov_base)[cursor]) ^
-                    masking_key[absolute_index % 4];
-            }
-            cursor -= iovecs[i].iov_len;
-        }
-        return 0;
-    };
-
-    while (logical_index < total_length) {
-        const uint8_t byte = masked(logical_index);
-        if (byte <= 0x7F) {
-            ++logical_index;
-            continue;
-        }
-
-        if ((byte & 0xE0) == 0xC0) {
-            if (logical_index + 1 >= total_length) return false;
-            const uint8_t byte2 = masked(logical_index + 1);
-            if ((byte2 & 0xC0) != 0x80) return false;
-            const uint32_t codepoint = ((byte & 0x1F) << 6) | (byte2 & 0x3F);
-            if (codepoint < 0x80) return false;
-            logical_index += 2;
-            continue;
-        }
-
-        if ((byte & 0xF0) == 0xE0) {
-            if (logical_index + 2 >= total_length) return false;
-            const uint8_t byte2 = masked(logical_index + 1);
-            const uint8_t byte3 = masked(logical_index + 2);
-            if ((byte2 & 0xC0) != 0x80) return false;
-            if ((byte3 & 0xC0) != 0x80) return false;
-            const uint32_t codepoint = ((byte & 0x0F) << 12) |
-                                       ((byte2 & 0x3F) << 6) |
-                                       (byte3 & 0x3F);
-            if (codepoint < 0x800) return false;
-            if (codepoint >= 0xD800 && codepoint <= 0xDFFF) return false;
-            logical_index += 3;
-            continue;
-        }
-
-        if ((byte & 0xF8) == 0xF0) {
-            if (logical_index + 3 >= total_length) return false;
-            const uint8_t byte2 = masked(logical_index + 1);
-            const uint8_t byte3 = masked(logical_index + 2);
-            const uint8_t byte4 = masked(logical_index + 3);
-            if ((byte2 & 0xC0) != 0x80) return false;
-            if ((byte3 & 0xC0) != 0x80) return false;
-            if ((byte4 & 0xC0) != 0x80) return false;
-            const uint32_t codepoint = ((byte & 0x07) << 18) |
-                                       ((byte2 & 0x3F) << 12) |
-                                       ((byte3 & 0x3F) << 6) |
-                                       (byte4 & 0x3F);
-            if (codepoint < 0x10000 || codepoint > 0x10FFFF) return false;
-            logical_index += 4;
-            continue;
+        if (!validator.feedMasked(static_cast<const char*>(iovecs[i].iov_base),
+                                  iovecs[i].iov_len,
+                                  masking_key,
+                                  key_offset)) {
+            return false;
         }
-
-        return false;
+        key_offset += iovecs[i].iov_len;
     }
-
-    return true;
+    return validator.finish();
 }
 
 inline void wsApplyMaskIovecsInPlace(struct iovec* iovecs,
@@ -536,11 +479,13 @@ struct WsFrameReadState {
     WsFrameReadState(RingBuffer<galay::utils::RingBufferBackendStrategy::Mmap, std::dynamic_extent>& ring_buffer,
                      const WsReaderSetting& setting,
                      WsFrame& frame,
-                     bool is_server)
+                     bool is_server,
+                     bool allow_rsv1 = false)
         : m_ring_buffer(&ring_buffer)
         , m_setting(setting)
         , m_frame(&frame)
-        , m_is_server(is_server) {}
+        , m_is_server(is_server)
+        , m_allow_rsv1(allow_rsv1) {}
 
 private:
     WsFrameReadState(const WsFrameReadState&) = delete;
@@ -559,7 +504,8 @@ public:
             read_iovecs.data(),
             read_iovecs.size(),
             *m_frame,
-            m_is_server);
+            m_is_server,
+            m_allow_rsv1);
         if (!parse_result.has_value()) {
             WsError error = parse_result.error();
                 if (error.code() == kWsIncomplete) {
@@ -658,6 +604,7 @@ public:
     WsReaderSetting m_setting;
     WsFrame* m_frame;
     bool m_is_server;
+    bool m_allow_rsv1 = false;
     size_t m_total_received = 0;
     BorrowedIovecs<2> m_write_iovecs;
     std::vector<char> m_ssl_recv_scratch;
@@ -697,6 +644,13 @@ public:
         m_opcode = &opcode;
     }
 
+    /**
+     * @brief 绑定连接的 permessage-deflate 上下文，nullptr 表示未协商
+     */
+    void setPerMessageDeflate(WsPerMessageDeflate* deflate) noexcept {
+        m_deflate = deflate;
+    }
+
     bool parseFromBuffer() {
         while (true) {
             auto read_iovecs = borrowReadIovecs(*m_ring_buffer);
@@ -704,7 +658,8 @@ public:
                 return false;
             }
 
-            if (m_enable_fast_path) {
+            // 压缩消息的后续分片 RSV1 为 0，也必须走解压路径
+            if (m_enable_fast_path && !m_compressed_message) {
                 switch (tryFastPath(read_iovecs.data(), read_iovecs.size())) {
                     case WsMessageFastPathStatus::kReturn:
                         return true;
@@ -731,7 +686,8 @@ public:
                 read_iovecs.data(),
                 read_iovecs.size(),
                 frame,
-                m_is_server);
+                m_is_server,
+                m_deflate != nullptr);
             if (!parse_result.has_value()) {
                 WsError error = parse_result.error();
                 if (error.code() == kWsIncomplete) {
@@ -765,6 +721,7 @@ public:
                 return true;
             }
 
+            size_t fragment_offset = 0;
             if (m_first_frame) {
                 if (frame.header.opcode == WsOpcode::Continuation) {
                     setParseError(WsError(kWsProtocolError, "First frame cannot be continuation"));
@@ -772,13 +729,31 @@ public:
                 }
                 *m_opcode = frame.header.opcode;
                 m_first_frame = false;
-                *m_message = std::move(frame.payload);
+                m_compressed_message = frame.header.rsv1;
+                m_utf8.reset();
+                if (m_compressed_message) {
+                    m_message->clear();
+                } else {
+                    *m_message = std::move(frame.payload);
+                }
             } else {
                 if (frame.header.opcode != WsOpcode::Continuation) {
                     setParseError(WsError(kWsProtocolError, "Expected continuation frame"));
                     return true;
                 }
-                m_message->append(frame.payload);
+                fragment_offset = m_message->size();
+                if (!m_compressed_message) {
+                    m_message->append(frame.payload);
+                }
+            }
+
+            if (m_compressed_message) {
+                auto inflated = m_deflate->inflateFrame(
+                    frame.payload, frame.header.fin, *m_message, m_setting.max_message_size);
+                if (!inflated) {
+                    setParseError(std::move(inflated.error()));
+                    return true;
+                }
             }
 
             if (m_message->size() > m_setting.max_message_size) {
@@ -786,15 +761,18 @@ public:
                 return true;
             }
 
+            // 单帧未压缩文本已由 fromIOVec 校验；其余情况逐帧校验新增的明文（压缩消息为解压结果），
+            // 码点跨帧时前缀留在 m_utf8 中，FIN 时不再整条重扫
             const bool frame_payload_utf8_validated =
-                frame.header.opcode == WsOpcode::Text && frame.header.fin;
+                frame.header.opcode == WsOpcode::Text && frame.header.fin && !m_compressed_message;
+            if (*m_opcode == WsOpcode::Text && !frame_payload_utf8_validated &&
+                (!m_utf8.feed(m_message->data() + fragment_offset, m_message->size() - fragment_offset) ||
+                 (frame.header.fin && !m_utf8.finish()))) {
+                setParseError(WsError(kWsInvalidUtf8));
+                return true;
+            }
             if (frame.header.fin) {
-                if (*m_opcode == WsOpcode::Text &&
-                    !frame_payload_utf8_validated &&
-                    !WsFrameParser::isValidUtf8(*m_message)) {
-                    setParseError(WsError(kWsInvalidUtf8));
-                    return true;
-                }
+                m_compressed_message = false;
                 return true;
             }
 
@@ -859,15 +837,23 @@ public:
             wsApplyMaskInPlace(m_message->data() + write_offset, payload_size, prefix.masking_key);
         }
 
-        bool payload_utf8_validated = false;
-        if (prefix.opcode == WsOpcode::Text &&
-            prefix.fin &&
-            !wsIsValidUtf8Span(m_message->data() + write_offset, payload_size)) {
-            m_message->resize(old_size);
+        // 文本消息边收边校验：每帧只校验本帧负载，跨帧的码点前缀由 m_utf8 携带
+        if (replace_message) {
+            m_utf8.reset();
+        }
+        const bool text_message = replace_message ? prefix.opcode == WsOpcode::Text
+                                                  : *m_opcode == WsOpcode::Text;
+        if (text_message &&
+            (!m_utf8.feed(m_message->data() + write_offset, payload_size) ||
+             (prefix.fin && !m_utf8.finish()))) {
+            if (preserve_existing_message) {
+                *m_message = std::move(previous_message);
+            } else {
+                m_message->resize(old_size);
+            }
             setParseError(WsError(kWsInvalidUtf8));
             return WsMessageFastPathStatus::kReturn;
         }
-        payload_utf8_validated = prefix.opcode == WsOpcode::Text && prefix.fin;
 
         if (replace_message) {
             if (!replace_fragment_prefix && old_size != 0 && payload_size != 0) {
@@ -886,14 +872,6 @@ public:
             return WsMessageFastPathStatus::kReturn;
         }
 
-        if (prefix.fin &&
-            *m_opcode == WsOpcode::Text &&
-            !payload_utf8_validated &&
-            !wsIsValidUtf8Span(m_message->data(), m_message->size())) {
-            setParseError(WsError(kWsInvalidUtf8));
-            return WsMessageFastPathStatus::kReturn;
-        }
-
         if (prefix.fin) {
             return WsMessageFastPathStatus::kReturn;
         }
@@ -969,6 +947,8 @@ public:
     void resetForNextMessage() {
         m_total_received = 0;
         m_first_frame = true;
+        m_compressed_message = false;
+        m_utf8.reset();
         m_fast_path_frames = 0;
         m_recv_staged = false;
         m_ws_error.reset();
@@ -993,9 +973,12 @@ public:
     bool m_use_mask;
     size_t m_total_received = 0;
     bool m_first_frame = true;
+    bool m_compressed_message = false;     ///< 当前消息首帧设置了 RSV1
+    WsUtf8Validator m_utf8;                ///< 文本消息跨帧的增量 UTF-8 校验状态
     size_t m_fast_path_frames = 0;
     ControlFrameCallback m_control_frame_callback;
     bool m_enable_fast_path = true;
+    WsPerMessageDeflate* m_deflate = nullptr;
     BorrowedIovecs<2> m_write_iovecs;
     std::vector<char> m_ssl_recv_scratch;
     bool m_recv_staged = false;
@@ -1074,7 +1057,8 @@ public:
         ++m_operation_counters.frame_awaitables_started;
         return detail::buildReadOperation(
             *m_socket,
-            std::make_shared<detail::WsFrameReadState>(*m_ring_buffer, m_setting, frame, m_is_server));
+            std::make_shared<detail::WsFrameReadState>(
+                *m_ring_buffer, m_setting, frame, m_is_server, m_deflate != nullptr));
     }
 
     /**
@@ -1085,17 +1069,26 @@ public:
      */
     auto getMessage(std::string& message, WsOpcode& opcode) {
         ++m_operation_counters.message_awaitables_started;
-        return detail::buildReadOperation(
-            *m_socket,
-            std::make_shared<detail::WsMessageReadState>(
-                *m_ring_buffer,
-                m_setting,
-                message,
-                opcode,
-                m_is_server,
-                m_use_mask,
-                nullptr,
-                messageFastPathEnabled()));
+        auto state = std::make_shared<detail::WsMessageReadState>(
+            *m_ring_buffer,
+            m_setting,
+            message,
+            opcode,
+            m_is_server,
+            m_use_mask,
+            nullptr,
+            messageFastPathEnabled());
+        state->setPerMessageDeflate(m_deflate);
+        return detail::buildReadOperation(*m_socket, std::move(state));
+    }
+
+    /**
+     * @brief 绑定 permessage-deflate 上下文
+     * @param deflate 由连接持有的上下文，nullptr 表示未协商
+     * @details getMessage 自动解压 RSV1 消息；getFrame 只放行 RSV1，返回压缩后的原始负载。
+     */
+    void setPerMessageDeflate(WsPerMessageDeflate* deflate) noexcept {
+        m_deflate = deflate;
     }
 
 private:
@@ -1108,6 +1101,7 @@ private:
     SocketType* m_socket;
     bool m_is_server;
     bool m_use_mask;
+    WsPerMessageDeflate* m_deflate = nullptr;
     OperationCounters m_operation_counters;
 };
 
@@ -7,6 +7,7 @@
  * @details 提供 WsWriterImpl 模板类，支持将文本、二进制和控制帧
  *          异步写入 AsyncTcpSocket 或 SslSocket。TCP 模式使用 writev 零拷贝，
  *          SSL 模式使用 send。内部实现快速路径优化常用帧的发送。
+ *          sendShared 直接写出已编码的 WsSharedFrame，供广播组在多个连接间共享同一份帧字节。
  */
 
 #ifndef GALAY_WS_WRITER_H
@@ -14,18 +15,22 @@
 
 #include "writer_cfg.h"
 #include "../../galay-http/common/iovec_utils.h"
+#include "../protoc/ws_deflate.h"
 #include "../protoc/ws_frame.h"
 #include "../protoc/ws_error.h"
+#include "../utils/ws_helper.h"
 #include "../../galay-kernel/core/awaitable.h"
 #include "../../galay-kernel/async/async_tcp.h"
 #include <array>
 #include <cstdint>
 #include <expected>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <sys/uio.h>
 
 #ifdef GALAY_SSL_FEATURE_ENABLED
@@ -292,7 +297,8 @@ public:
             ++m_operation_counters.send_awaitables_started;
             if constexpr (!is_tcp_socket_v<SocketType>) {
                 prepareSslMessage(WsOpcode::Text, text, fin);
-            } else if (!tryPrepareCommonTcpFrame(WsOpcode::Text, text, fin)) {
+            } else if (!tryPrepareDeflatedMessage(WsOpcode::Text, text, fin) &&
+                       !tryPrepareCommonTcpFrame(WsOpcode::Text, text, fin)) {
                 WsFrame frame = WsFrameParser::createTextFrame(text, fin);
                 prepareSendFrame(std::move(frame));
             }
@@ -305,7 +311,8 @@ public:
             ++m_operation_counters.send_awaitables_started;
             if constexpr (!is_tcp_socket_v<SocketType>) {
                 prepareSslMessage(WsOpcode::Text, std::move(text), fin);
-            } else if (!tryPrepareCommonTcpFrame(WsOpcode::Text, std::move(text), fin)) {
+            } else if (!tryPrepareDeflatedMessage(WsOpcode::Text, text, fin) &&
+                       !tryPrepareCommonTcpFrame(WsOpcode::Text, std::move(text), fin)) {
                 WsFrame frame = WsFrameBuilder().text(std::move(text), fin).buildMove();
                 prepareSendFrame(std::move(frame));
             }
@@ -318,7 +325,8 @@ public:
             ++m_operation_counters.send_awaitables_started;
             if constexpr (!is_tcp_socket_v<SocketType>) {
                 prepareSslMessage(WsOpcode::Binary, data, fin);
-            } else if (!tryPrepareCommonTcpFrame(WsOpcode::Binary, data, fin)) {
+            } else if (!tryPrepareDeflatedMessage(WsOpcode::Binary, data, fin) &&
+                       !tryPrepareCommonTcpFrame(WsOpcode::Binary, data, fin)) {
                 WsFrame frame = WsFrameParser::createBinaryFrame(data, fin);
                 prepareSendFrame(std::move(frame));
             }
@@ -331,7 +339,8 @@ public:
             ++m_operation_counters.send_awaitables_started;
             if constexpr (!is_tcp_socket_v<SocketType>) {
                 prepareSslMessage(WsOpcode::Binary, std::move(data), fin);
-            } else if (!tryPrepareCommonTcpFrame(WsOpcode::Binary, std::move(data), fin)) {
+            } else if (!tryPrepareDeflatedMessage(WsOpcode::Binary, data, fin) &&
+                       !tryPrepareCommonTcpFrame(WsOpcode::Binary, std::move(data), fin)) {
                 WsFrame frame = WsFrameBuilder().binary(std::move(data), fin).buildMove();
                 prepareSendFrame(std::move(frame));
             }
@@ -382,18 +391,62 @@ public:
         return makeSendAwaitable();
     }
 
+    /**
+     * @brief 发送已编码的共享帧
+     * @param frame WsSharedFrame::encode 的结果
+     * @details 服务端 TCP 写入器以共享缓冲直接作为 iovec，SSL 写入器直接从共享缓冲 send，
+     *          均不复制帧字节；需要掩码的写入器按 payload 重新编码。写完后释放对共享缓冲的引用。
+     */
+    auto sendShared(const WsSharedFrame& frame) {
+        if (m_remaining_bytes == 0) {
+            ++m_operation_counters.send_awaitables_started;
+            prepareSharedFrames(std::span<const WsSharedFrame>(&frame, 1));
+        }
+        return makeSendAwaitable();
+    }
+
+    /**
+     * @brief 批量发送已编码的共享帧
+     * @param frames 按顺序写出的帧，空帧被跳过
+     * @details 服务端 TCP 写入器把整批帧合并为一次 writev；SSL 与需要掩码的写入器
+     *          把整批帧拼接到内部缓冲后发送。
+     */
+    auto sendShared(std::span<const WsSharedFrame> frames) {
+        if (m_remaining_bytes == 0) {
+            ++m_operation_counters.send_awaitables_started;
+            prepareSharedFrames(frames);
+        }
+        return makeSendAwaitable();
+    }
+
     void prepareSslMessage(WsOpcode opcode, std::string_view payload, bool fin = true) {
         resetPendingState();
+        if (tryPrepareDeflatedMessage(opcode, payload, fin)) {
+            return;
+        }
         WsFrameParser::encodeMessageInto(m_buffer, opcode, payload, fin, m_setting.use_mask);
         m_remaining_bytes = m_buffer.size();
     }
 
     void prepareSslMessage(WsOpcode opcode, std::string&& payload, bool fin = true) {
         resetPendingState();
+        if (tryPrepareDeflatedMessage(opcode, payload, fin)) {
+            return;
+        }
         WsFrameParser::encodeMessageInto(m_buffer, opcode, std::move(payload), fin, m_setting.use_mask);
         m_remaining_bytes = m_buffer.size();
     }
 
+    /**
+     * @brief 绑定 permessage-deflate 上下文
+     * @param deflate 由连接持有的上下文，nullptr 表示未协商
+     * @details 之后 sendText / sendBinary 发出的完整消息（fin=true）达到压缩阈值时
+     *          以 RSV1 压缩帧发出；分片消息与控制帧保持原样。
+     */
+    void setPerMessageDeflate(WsPerMessageDeflate* deflate) noexcept {
+        m_deflate = deflate;
+    }
+
 private:
     enum class PendingWritevBuffer : uint8_t {
         kHeader,
@@ -487,7 +540,11 @@ private:
     }
 
     void moveFrom(WsWriterImpl&& other) noexcept {
-        const PendingWritevSnapshot pending_writev = snapshotPendingWritev(other);
+        // 共享帧的字节位于引用计数缓冲中，移动后地址不变，writev 游标无需重新绑定
+        PendingWritevSnapshot pending_writev;
+        if (other.m_shared_frames.empty()) {
+            pending_writev = snapshotPendingWritev(other);
+        }
 
         m_setting = other.m_setting;
         m_socket = other.m_socket;
@@ -497,6 +554,9 @@ private:
         m_remaining_bytes = other.m_remaining_bytes;
         m_operation_counters = other.m_operation_counters;
         m_fast_path_counters = other.m_fast_path_counters;
+        m_deflate = other.m_deflate;
+        m_deflate_scratch = std::move(other.m_deflate_scratch);
+        m_shared_frames = std::move(other.m_shared_frames);
         for (size_t i = 0; i < sizeof(m_masking_key); ++i) {
             m_masking_key[i] = other.m_masking_key[i];
         }
@@ -505,6 +565,94 @@ private:
         other.resetPendingState();
     }
 
+    /**
+     * @brief 压缩并准备一条 RSV1 消息帧
+     * @return 未协商、分片、低于阈值或压缩失败时返回 false，由调用方按原始帧发送
+     * @details 压缩输出写入复用的 m_deflate_scratch；TCP 与负载缓冲交换后走 writev，
+     *          两块缓冲交替使用，稳定后不再分配。
+     */
+    bool tryPrepareDeflatedMessage(WsOpcode opcode, std::string_view payload, bool fin) {
+        if (m_deflate == nullptr || !fin ||
+            (opcode != WsOpcode::Text && opcode != WsOpcode::Binary) ||
+            !m_deflate->shouldCompress(payload.size())) {
+            return false;
+        }
+        if (!m_deflate->compressMessage(payload, m_deflate_scratch)) {
+            return false;
+        }
+
+        m_buffer.clear();
+        appendWsFrameHeader(m_buffer, opcode, true, true, false, false,
+                            m_deflate_scratch.size(), m_setting.use_mask, m_masking_key);
+        if constexpr (is_tcp_socket_v<SocketType>) {
+            m_payload_buffer.swap(m_deflate_scratch);
+            finalizeWritevBuffers(false);
+        } else {
+            const size_t payload_offset = m_buffer.size();
+            m_buffer.append(m_deflate_scratch);
+            if (m_setting.use_mask) {
+                WsFrameParser::applyMaskBytes(m_buffer.data() + payload_offset,
+                                              m_deflate_scratch.size(),
+                                              m_masking_key);
+            }
+            m_remaining_bytes = m_buffer.size();
+        }
+        return true;
+    }
+
+    /**
+     * @brief 准备写出一批共享帧
+     * @details 服务端 TCP：每帧一个 iovec，引用保存在 m_shared_frames 直到写完；
+     *          服务端 SSL 单帧：直接从共享缓冲 send；其余情况拼接（必要时重新加掩码）到 m_buffer。
+     */
+    void prepareSharedFrames(std::span<const WsSharedFrame> frames) {
+        resetPendingState();
+        if constexpr (is_tcp_socket_v<SocketType>) {
+            if (!m_setting.use_mask) {
+                m_writev_cursor.reserve(frames.size());
+                for (const auto& frame : frames) {
+                    if (frame.empty()) {
+                        continue;
+                    }
+                    m_shared_frames.push_back(frame);
+                    m_writev_cursor.append({const_cast<char*>(frame.bytes().data()), frame.size()});
+                }
+                m_remaining_bytes = m_writev_cursor.remainingBytes();
+                ++m_fast_path_counters.hits;
+                return;
+            }
+        } else {
+            if (!m_setting.use_mask && frames.size() == 1 && !frames.front().empty()) {
+                m_shared_frames.push_back(frames.front());
+                m_remaining_bytes = frames.front().size();
+                return;
+            }
+        }
+
+        for (const auto& frame : frames) {
+            if (frame.empty()) {
+                continue;
+            }
+            if (!m_setting.use_mask) {
+                m_buffer.append(frame.bytes());
+                continue;
+            }
+            const std::string_view payload = frame.payload();
+            appendWsFrameHeader(m_buffer, frame.opcode(), true, false, false, false,
+                                payload.size(), true, m_masking_key);
+            const size_t payload_offset = m_buffer.size();
+            m_buffer.append(payload);
+            WsFrameParser::applyMaskBytes(m_buffer.data() + payload_offset, payload.size(), m_masking_key);
+        }
+        if constexpr (is_tcp_socket_v<SocketType>) {
+            m_writev_cursor.append({m_buffer.data(), m_buffer.size()});
+            m_remaining_bytes = m_writev_cursor.remainingBytes();
+            ++m_fast_path_counters.fallbacks;
+        } else {
+            m_remaining_bytes = m_buffer.size();
+        }
+    }
+
     static constexpr bool canUseCommonTcpFastPath(WsOpcode opcode, bool fin, bool use_mask) {
         return !use_mask &&
                fin &&
@@ -658,6 +806,7 @@ public:
     void resetPendingState() {
         m_buffer.clear();
         m_payload_buffer.clear();
+        m_shared_frames.clear();
         m_writev_cursor.clear();
         m_remaining_bytes = 0;
     }
@@ -666,6 +815,7 @@ public:
         if (bytes_sent >= m_remaining_bytes) {
             m_remaining_bytes = 0;
             m_buffer.clear();
+            m_shared_frames.clear();
         } else {
             m_remaining_bytes -= bytes_sent;
         }
@@ -677,6 +827,7 @@ public:
             m_remaining_bytes = 0;
             m_buffer.clear();
             m_payload_buffer.clear();
+            m_shared_frames.clear();
             m_writev_cursor.clear();
             return;
         }
@@ -689,10 +840,16 @@ public:
     }
 
     const char* bufferData() const {
+        if (!m_shared_frames.empty()) {
+            return m_shared_frames.front().bytes().data();
+        }
         return m_buffer.data();
     }
 
     size_t sentBytes() const {
+        if (!m_shared_frames.empty()) {
+            return m_shared_frames.front().size() - m_remaining_bytes;
+        }
         return m_buffer.size() - m_remaining_bytes;
     }
 
@@ -714,6 +871,9 @@ private:
     OperationCounters m_operation_counters;
     FastPathCounters m_fast_path_counters;
     uint8_t m_masking_key[4];
+    WsPerMessageDeflate* m_deflate = nullptr;
+    std::string m_deflate_scratch;      ///< 压缩输出，与 m_payload_buffer 交替复用
+    std::vector<WsSharedFrame> m_shared_frames; ///< 正在写出的共享帧，写完后释放引用
 
     friend struct detail::WsEchoMachine<SocketType>;
     friend struct detail::WsSslEchoMachine<SocketType>;
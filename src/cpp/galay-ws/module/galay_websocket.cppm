@@ -6,7 +6,9 @@ export module galay.websocket;
 
 export {
 #include "../builder/ws_frame_builder.h"
+#include "../protoc/ws_deflate.h"
 #include "../protoc/ws_frame.h"
+#include "../protoc/ws_utf8.h"
 #include "../utils/ws_helper.h"
 
 #include "../client/ws_client.h"
@@ -15,6 +17,7 @@ export {
 #include "../kernel/reader_cfg.h"
 #include "../client/ws_session.h"
 #include "../server/ws_upgrade.h"
+#include "../server/ws_broadcast.h"
 #include "../kernel/ws_writer.h"
 #include "../kernel/writer_cfg.h"
 }
@@ -0,0 +1,467 @@
+#include "ws_deflate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+namespace galay::websocket
+{
+
+using galay::http::HttpRawDeflateStream;
+
+namespace
+{
+
+constexpr std::string_view kDeflateTail("\x00\x00\xff\xff", 4);
+
+struct ExtensionParam
+{
+    std::string_view name;
+    std::string_view value;
+    bool has_value = false;
+};
+
+struct ExtensionElement
+{
+    std::string_view name;
+    std::vector<ExtensionParam> params;
+};
+
+std::string_view trimOws(std::string_view value)
+{
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs)
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(lhs[i])) !=
+            std::tolower(static_cast<unsigned char>(rhs[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 按分隔符切分，忽略引号内的分隔符
+ */
+std::vector<std::string_view> splitOutsideQuotes(std::string_view value, char delimiter)
+{
+    std::vector<std::string_view> parts;
+    bool quoted = false;
+    size_t begin = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '"') {
+            quoted = !quoted;
+        } else if (value[i] == delimiter && !quoted) {
+            parts.push_back(value.substr(begin, i - begin));
+            begin = i + 1;
+        }
+    }
+    parts.push_back(value.substr(begin));
+    return parts;
+}
+
+std::vector<ExtensionElement> parseExtensionList(std::string_view header)
+{
+    std::vector<ExtensionElement> elements;
+    for (std::string_view item : splitOutsideQuotes(header, ',')) {
+        item = trimOws(item);
+        if (item.empty()) {
+            continue;
+        }
+        auto pieces = splitOutsideQuotes(item, ';');
+        ExtensionElement element;
+        element.name = trimOws(pieces.front());
+        for (size_t i = 1; i < pieces.size(); ++i) {
+            const std::string_view piece = trimOws(pieces[i]);
+            ExtensionParam param;
+            const size_t eq = piece.find('=');
+            param.name = trimOws(piece.substr(0, eq));
+            if (eq != std::string_view::npos) {
+                param.has_value = true;
+                param.value = trimOws(piece.substr(eq + 1));
+                if (param.value.size() >= 2 && param.value.front() == '"' && param.value.back() == '"') {
+                    param.value = param.value.substr(1, param.value.size() - 2);
+                }
+            }
+            element.params.push_back(param);
+        }
+        elements.push_back(std::move(element));
+    }
+    return elements;
+}
+
+/**
+ * @brief 解析窗口位数：1–2 位十进制、无前导零、取值 8–15，否则返回 0
+ */
+uint8_t parseWindowBits(std::string_view value)
+{
+    if (value.empty() || value.size() > 2 || value.front() == '0') {
+        return 0;
+    }
+    unsigned bits = 0;
+    for (char ch : value) {
+        if (ch < '0' || ch > '9') {
+            return 0;
+        }
+        bits = bits * 10 + static_cast<unsigned>(ch - '0');
+    }
+    return bits >= 8 && bits <= 15 ? static_cast<uint8_t>(bits) : 0;
+}
+
+/**
+ * @brief 单个 permessage-deflate 提议 / 响应的参数
+ */
+struct DeflateParamSet
+{
+    bool server_no_context_takeover = false;
+    bool client_no_context_takeover = false;
+    uint8_t server_max_window_bits = 0;     ///< 0 表示未出现
+    bool client_max_window_bits_present = false;
+    uint8_t client_max_window_bits = 0;     ///< 0 表示未出现或不带值
+};
+
+/**
+ * @brief 校验并收集参数；未知参数、重复参数与非法取值都使整个提议无效
+ */
+std::optional<DeflateParamSet> collectDeflateParams(const ExtensionElement& element)
+{
+    DeflateParamSet set;
+    bool seen_server_bits = false;
+    for (const auto& param : element.params) {
+        if (param.name == "server_no_context_takeover") {
+            if (param.has_value || set.server_no_context_takeover) {
+                return std::nullopt;
+            }
+            set.server_no_context_takeover = true;
+        } else if (param.name == "client_no_context_takeover") {
+            if (param.has_value || set.client_no_context_takeover) {
+                return std::nullopt;
+            }
+            set.client_no_context_takeover = true;
+        } else if (param.name == "server_max_window_bits") {
+            if (!param.has_value || seen_server_bits) {
+                return std::nullopt;
+            }
+            set.server_max_window_bits = parseWindowBits(param.value);
+            if (set.server_max_window_bits == 0) {
+                return std::nullopt;
+            }
+            seen_server_bits = true;
+        } else if (param.name == "client_max_window_bits") {
+            if (set.client_max_window_bits_present) {
+                return std::nullopt;
+            }
+            set.client_max_window_bits_present = true;
+            if (param.has_value) {
+                set.client_max_window_bits = parseWindowBits(param.value);
+                if (set.client_max_window_bits == 0) {
+                    return std::nullopt;
+                }
+            }
+        } else {
+            return std::nullopt;
+        }
+    }
+    return set;
+}
+
+uint8_t clampWindowBits(uint8_t bits)
+{
+    return std::clamp(bits, kWsDeflateMinWindowBits, kWsDeflateMaxWindowBits);
+}
+
+bool fitsMemory(const WsDeflateConfig& config, uint8_t deflate_bits, uint8_t inflate_bits, int mem_level)
+{
+    return config.memory_limit == 0 ||
+           estimateWsDeflateMemory(deflate_bits, inflate_bits, mem_level) <= config.memory_limit;
+}
+
+/**
+ * @brief 在内存上限内收缩窗口：先收缩本端压缩窗口，再收缩可协商的对端窗口
+ * @return memLevel 降到 1 也放不下时返回 false
+ */
+bool shrinkToMemoryLimit(const WsDeflateConfig& config,
+                         uint8_t& own_bits,
+                         uint8_t& peer_bits,
+                         bool peer_negotiable)
+{
+    const int mem_level = std::clamp(config.mem_level, 1, 9);
+    while (!fitsMemory(config, own_bits, peer_bits, mem_level) && own_bits > kWsDeflateMinWindowBits) {
+        --own_bits;
+    }
+    while (peer_negotiable && !fitsMemory(config, own_bits, peer_bits, mem_level) &&
+           peer_bits > kWsDeflateMinWindowBits) {
+        --peer_bits;
+    }
+    return fitsMemory(config, own_bits, peer_bits, 1);
+}
+
+WsError compressionError(const galay::http::HttpError& error)
+{
+    return WsError(kWsCompressionError, error.message());
+}
+
+} // namespace
+
+size_t estimateWsDeflateMemory(uint8_t deflate_window_bits, uint8_t inflate_window_bits, int mem_level) noexcept
+{
+    return HttpRawDeflateStream::estimateMemory(HttpRawDeflateStream::Direction::Compress,
+                                                deflate_window_bits, mem_level) +
+           HttpRawDeflateStream::estimateMemory(HttpRawDeflateStream::Direction::Decompress,
+                                                inflate_window_bits, mem_level);
+}
+
+std::optional<WsDeflateParams> negotiateWsDeflate(std::string_view offers, const WsDeflateConfig& config)
+{
+    if (!config.enabled || !HttpRawDeflateStream::isSupported()) {
+        return std::nullopt;
+    }
+    for (const auto& element : parseExtensionList(offers)) {
+        if (!equalsIgnoreCase(element.name, kWsPerMessageDeflateToken)) {
+            continue;
+        }
+        auto offer = collectDeflateParams(element);
+        if (!offer) {
+            continue;
+        }
+
+        uint8_t server_bits = clampWindowBits(config.server_max_window_bits);
+        if (offer->server_max_window_bits != 0) {
+            // 客户端要求 8 位窗口时 zlib 无法满足，只能拒绝这个提议
+            if (offer->server_max_window_bits < kWsDeflateMinWindowBits) {
+                continue;
+            }
+            server_bits = std::min(server_bits, offer->server_max_window_bits);
+        }
+        // 客户端未声明 client_max_window_bits 时不能限制它的窗口
+        uint8_t client_bits = kWsDeflateMaxWindowBits;
+        if (offer->client_max_window_bits_present) {
+            client_bits = clampWindowBits(config.client_max_window_bits);
+            if (offer->client_max_window_bits != 0) {
+                client_bits = std::min(client_bits, offer->client_max_window_bits);
+            }
+        }
+        if (!shrinkToMemoryLimit(config, server_bits, client_bits, offer->client_max_window_bits_present)) {
+            continue;
+        }
+
+        WsDeflateParams params;
+        params.server_max_window_bits = server_bits;
+        params.client_max_window_bits = client_bits;
+        params.server_no_context_takeover = offer->server_no_context_takeover || config.server_no_context_takeover;
+        params.client_no_context_takeover = offer->client_no_context_takeover || config.client_no_context_takeover;
+        return params;
+    }
+    return std::nullopt;
+}
+
+std::string formatWsDeflateResponse(const WsDeflateParams& params)
+{
+    std::string value(kWsPerMessageDeflateToken);
+    if (params.server_no_context_takeover) {
+        value.append("; server_no_context_takeover");
+    }
+    if (params.client_no_context_takeover) {
+        value.append("; client_no_context_takeover");
+    }
+    // 总是回显 server_max_window_bits：提议中带了该参数时响应必须带上
+    value.append("; server_max_window_bits=");
+    value.append(std::to_string(params.server_max_window_bits));
+    if (params.client_max_window_bits < kWsDeflateMaxWindowBits) {
+        value.append("; client_max_window_bits=");
+        value.append(std::to_string(params.client_max_window_bits));
+    }
+    return value;
+}
+
+std::string formatWsDeflateOffer(const WsDeflateConfig& config)
+{
+    if (!config.enabled || !HttpRawDeflateStream::isSupported()) {
+        return {};
+    }
+    uint8_t client_bits = clampWindowBits(config.client_max_window_bits);
+    uint8_t server_bits = clampWindowBits(config.server_max_window_bits);
+    if (!shrinkToMemoryLimit(config, client_bits, server_bits, true)) {
+        return {};
+    }
+
+    std::string value(kWsPerMessageDeflateToken);
+    if (config.server_no_context_takeover) {
+        value.append("; server_no_context_takeover");
+    }
+    if (config.client_no_context_takeover) {
+        value.append("; client_no_context_takeover");
+    }
+    if (server_bits < kWsDeflateMaxWindowBits) {
+        value.append("; server_max_window_bits=");
+        value.append(std::to_string(server_bits));
+    }
+    value.append("; client_max_window_bits");
+    if (client_bits < kWsDeflateMaxWindowBits) {
+        value.push_back('=');
+        value.append(std::to_string(client_bits));
+    }
+    return value;
+}
+
+std::expected<std::optional<WsDeflateParams>, WsError>
+acceptWsDeflateResponse(std::string_view response, const WsDeflateConfig& config)
+{
+    auto elements = parseExtensionList(response);
+    if (elements.empty()) {
+        return std::optional<WsDeflateParams>{};
+    }
+    if (!config.enabled || elements.size() != 1 ||
+        !equalsIgnoreCase(elements.front().name, kWsPerMessageDeflateToken)) {
+        return std::unexpected(WsError(kWsUpgradeFailed, "Unexpected Sec-WebSocket-Extensions in response"));
+    }
+    auto accepted = collectDeflateParams(elements.front());
+    if (!accepted) {
+        return std::unexpected(WsError(kWsUpgradeFailed, "Invalid permessage-deflate response parameters"));
+    }
+
+    // 与 formatWsDeflateOffer 使用同一套收缩规则，得到实际提议出去的窗口
+    uint8_t client_bits = clampWindowBits(config.client_max_window_bits);
+    uint8_t server_bits = clampWindowBits(config.server_max_window_bits);
+    shrinkToMemoryLimit(config, client_bits, server_bits, true);
+
+    if (config.server_no_context_takeover && !accepted->server_no_context_takeover) {
+        return std::unexpected(WsError(kWsUpgradeFailed, "server_no_context_takeover not acknowledged"));
+    }
+    if (server_bits < kWsDeflateMaxWindowBits &&
+        (accepted->server_max_window_bits == 0 || accepted->server_max_window_bits > server_bits)) {
+        return std::unexpected(WsError(kWsUpgradeFailed, "server_max_window_bits exceeds the offer"));
+    }
+    if (accepted->client_max_window_bits_present) {
+        if (accepted->client_max_window_bits == 0) {
+            return std::unexpected(WsError(kWsUpgradeFailed, "client_max_window_bits requires a value"));
+        }
+        // zlib 无法产出 8 位窗口的流
+        if (accepted->client_max_window_bits < kWsDeflateMinWindowBits) {
+            return std::unexpected(WsError(kWsUpgradeFailed, "client_max_window_bits=8 is not supported"));
+        }
+        client_bits = std::min(client_bits, accepted->client_max_window_bits);
+    }
+
+    WsDeflateParams params;
+    params.server_max_window_bits = accepted->server_max_window_bits != 0
+        ? accepted->server_max_window_bits
+        : kWsDeflateMaxWindowBits;
+    params.client_max_window_bits = client_bits;
+    params.server_no_context_takeover = accepted->server_no_context_takeover;
+    params.client_no_context_takeover = accepted->client_no_context_takeover || config.client_no_context_takeover;
+    return std::optional<WsDeflateParams>(params);
+}
+
+// ==================== WsPerMessageDeflate ====================
+
+WsPerMessageDeflate::WsPerMessageDeflate(const WsDeflateParams& params,
+                                         HttpRawDeflateStream&& deflater,
+                                         HttpRawDeflateStream&& inflater,
+                                         bool reset_deflater,
+                                         bool reset_inflater,
+                                         size_t threshold,
+                                         size_t memory_bytes)
+    : m_params(params)
+    , m_deflater(std::move(deflater))
+    , m_inflater(std::move(inflater))
+    , m_reset_deflater(reset_deflater)
+    , m_reset_inflater(reset_inflater)
+    , m_threshold(threshold)
+    , m_memory_bytes(memory_bytes)
+{
+}
+
+std::expected<std::unique_ptr<WsPerMessageDeflate>, WsError>
+WsPerMessageDeflate::create(const WsDeflateParams& params, const WsDeflateConfig& config, bool is_server)
+{
+    const uint8_t own_bits = clampWindowBits(is_server ? params.server_max_window_bits
+                                                       : params.client_max_window_bits);
+    const uint8_t peer_bits = clampWindowBits(is_server ? params.client_max_window_bits
+                                                        : params.server_max_window_bits);
+    int mem_level = std::clamp(config.mem_level, 1, 9);
+    while (mem_level > 1 && !fitsMemory(config, own_bits, peer_bits, mem_level)) {
+        --mem_level;
+    }
+
+    auto deflater = HttpRawDeflateStream::createCompressor(config.level, own_bits, mem_level);
+    if (!deflater) {
+        return std::unexpected(compressionError(deflater.error()));
+    }
+    auto inflater = HttpRawDeflateStream::createDecompressor(peer_bits);
+    if (!inflater) {
+        return std::unexpected(compressionError(inflater.error()));
+    }
+    const bool reset_deflater = is_server ? params.server_no_context_takeover
+                                          : params.client_no_context_takeover;
+    const bool reset_inflater = is_server ? params.client_no_context_takeover
+                                          : params.server_no_context_takeover;
+    return std::unique_ptr<WsPerMessageDeflate>(new WsPerMessageDeflate(
+        params,
+        std::move(*deflater),
+        std::move(*inflater),
+        reset_deflater,
+        reset_inflater,
+        config.compression_threshold,
+        estimateWsDeflateMemory(own_bits, peer_bits, mem_level)));
+}
+
+std::expected<void, WsError> WsPerMessageDeflate::compressMessage(std::string_view payload, std::string& out)
+{
+    out.clear();
+    auto compressed = m_deflater.compress(payload, out);
+    if (!compressed) {
+        m_deflater.reset();
+        return std::unexpected(compressionError(compressed.error()));
+    }
+    // RFC 7692 §7.2.1：去掉同步刷新产生的 00 00 ff ff
+    if (out.size() >= kDeflateTail.size() &&
+        std::string_view(out).substr(out.size() - kDeflateTail.size()) == kDeflateTail) {
+        out.resize(out.size() - kDeflateTail.size());
+    }
+    if (m_reset_deflater) {
+        m_deflater.reset();
+    }
+    ++m_counters.messages_compressed;
+    m_counters.bytes_before += payload.size();
+    m_counters.bytes_after += out.size();
+    return {};
+}
+
+std::expected<void, WsError>
+WsPerMessageDeflate::inflateFrame(std::string_view data, bool fin, std::string& out, size_t max_output)
+{
+    auto inflated = m_inflater.decompress(data, out, max_output);
+    if (inflated && fin) {
+        // RFC 7692 §7.2.2：消息末尾补回发送端去掉的 00 00 ff ff
+        inflated = m_inflater.decompress(kDeflateTail, out, max_output);
+    }
+    if (!inflated) {
+        m_inflater.reset();
+        if (inflated.error().code() == galay::http::kRequestEntityTooLarge) {
+            return std::unexpected(WsError(kWsMessageTooLarge, "Inflated message size exceeds limit"));
+        }
+        return std::unexpected(compressionError(inflated.error()));
+    }
+    if (fin) {
+        if (m_reset_inflater) {
+            m_inflater.reset();
+        }
+        ++m_counters.messages_inflated;
+    }
+    return {};
+}
+
+} // namespace galay::websocket
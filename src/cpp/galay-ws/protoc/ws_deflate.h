@@ -0,0 +1,215 @@
+/**
+ * @file ws_deflate.h
+ * @brief WebSocket permessage-deflate 扩展（RFC 7692）
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 提供 Sec-WebSocket-Extensions 的提议 / 响应协商，以及连接级压缩上下文 WsPerMessageDeflate。
+ *          默认保留上下文（context takeover）：同一方向的消息共享 LZ77 滑动窗口，
+ *          行情、聊天等字段高度重复的 JSON 消息可以直接引用上一条消息中的片段；
+ *          协商 no_context_takeover 时每条消息独立压缩。
+ *          小于 compression_threshold 的消息不进压缩器，直接以 RSV1=0 的原始帧发出。
+ *
+ * @code
+ * WsDeflateConfig deflate;
+ * deflate.enabled = true;
+ * auto upgrade = WsUpgrade::handleUpgrade(request, deflate);
+ * // ... 发送 upgrade.response ...
+ * WsConn ws_conn = WsConn::from(std::move(conn));
+ * if (upgrade.deflate) {
+ *     ws_conn.enablePerMessageDeflate(*upgrade.deflate, deflate);
+ * }
+ * @endcode
+ */
+
+#ifndef GALAY_WEBSOCKET_DEFLATE_H
+#define GALAY_WEBSOCKET_DEFLATE_H
+
+#include "ws_error.h"
+#include "../../galay-http/common/http_compression.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace galay::websocket
+{
+
+constexpr std::string_view kWsPerMessageDeflateToken = "permessage-deflate"; ///< 扩展名
+constexpr uint8_t kWsDeflateMinWindowBits = 9;   ///< zlib 原始 deflate 支持的最小窗口
+constexpr uint8_t kWsDeflateMaxWindowBits = 15;  ///< RFC 7692 允许的最大窗口
+
+/**
+ * @brief permessage-deflate 本端配置
+ * @details 窗口位数与 no_context_takeover 是本端在协商中提出 / 接受的上限；
+ *          memory_limit 约束单连接两个方向 zlib 状态的估算内存之和，
+ *          超出时依次缩小本端压缩窗口、对端压缩窗口（可协商时）与 memLevel，仍放不下则不启用扩展。
+ */
+struct WsDeflateConfig
+{
+    bool enabled = false;                       ///< 是否提议 / 接受 permessage-deflate
+    uint8_t server_max_window_bits = 15;        ///< 服务端压缩窗口上限（9–15）
+    uint8_t client_max_window_bits = 15;        ///< 客户端压缩窗口上限（9–15）
+    bool server_no_context_takeover = false;    ///< 要求服务端每条消息重置压缩上下文
+    bool client_no_context_takeover = false;    ///< 要求客户端每条消息重置压缩上下文
+    int level = 6;                              ///< zlib 压缩级别（1–9）
+    int mem_level = 8;                          ///< zlib memLevel（1–9）
+    size_t compression_threshold = 128;         ///< 小于该长度的消息以原始帧发出
+    size_t memory_limit = 512 * 1024;           ///< 单连接 zlib 状态内存上限（字节），0 表示不限
+};
+
+/**
+ * @brief 协商结果
+ */
+struct WsDeflateParams
+{
+    uint8_t server_max_window_bits = 15;        ///< 服务端压缩使用的窗口位数
+    uint8_t client_max_window_bits = 15;        ///< 客户端压缩使用的窗口位数
+    bool server_no_context_takeover = false;    ///< 服务端每条消息重置压缩上下文
+    bool client_no_context_takeover = false;    ///< 客户端每条消息重置压缩上下文
+
+    bool operator==(const WsDeflateParams&) const = default;
+};
+
+/**
+ * @brief 估算单连接 zlib 状态内存
+ * @param deflate_window_bits 本端压缩窗口位数
+ * @param inflate_window_bits 对端压缩窗口位数（即本端解压窗口）
+ * @param mem_level 本端压缩 memLevel
+ * @return 字节数
+ */
+size_t estimateWsDeflateMemory(uint8_t deflate_window_bits, uint8_t inflate_window_bits, int mem_level) noexcept;
+
+/**
+ * @brief 服务端：从请求的 Sec-WebSocket-Extensions 中选出第一个可接受的 permessage-deflate 提议
+ * @param offers 请求头取值，可包含多个扩展与多个候选提议
+ * @param config 本端配置；未启用或当前构建没有 zlib 时返回 nullopt
+ * @return 协商结果；没有可接受的提议返回 nullopt，此时响应不应携带该扩展
+ * @details 参数非法、重复或要求 8 位窗口（zlib 无法产出）的提议整个被拒绝，继续看下一个提议。
+ */
+std::optional<WsDeflateParams> negotiateWsDeflate(std::string_view offers, const WsDeflateConfig& config);
+
+/**
+ * @brief 服务端：格式化 Sec-WebSocket-Extensions 响应值
+ * @param params negotiateWsDeflate 的结果
+ * @return 响应值，如 "permessage-deflate; server_max_window_bits=15"
+ */
+std::string formatWsDeflateResponse(const WsDeflateParams& params);
+
+/**
+ * @brief 客户端：格式化 Sec-WebSocket-Extensions 提议值
+ * @param config 本端配置
+ * @return 提议值；总是携带不带值或带值的 client_max_window_bits，表明客户端可接受服务端限制其窗口
+ */
+std::string formatWsDeflateOffer(const WsDeflateConfig& config);
+
+/**
+ * @brief 客户端：校验服务端的 Sec-WebSocket-Extensions 响应
+ * @param response 响应头取值，空串表示服务端未接受扩展
+ * @param config 发出提议时使用的配置
+ * @return 接受的参数；服务端未接受返回 nullopt；响应违反 RFC 7692 或超出提议范围返回 kWsUpgradeFailed
+ */
+std::expected<std::optional<WsDeflateParams>, WsError>
+acceptWsDeflateResponse(std::string_view response, const WsDeflateConfig& config);
+
+/**
+ * @brief 连接级 permessage-deflate 压缩上下文
+ * @details 持有本端压缩流与对端解压流。压缩时同步刷新并去掉结尾的 00 00 ff ff；
+ *          解压按帧流式进行，消息最后一帧之后补回 00 00 ff ff，分片消息无需先拼接压缩数据。
+ *          只能由连接的读写协程顺序使用；不可复制也不可移动，reader / writer 以裸指针引用。
+ */
+class WsPerMessageDeflate
+{
+public:
+    /**
+     * @brief 压缩统计
+     */
+    struct Counters
+    {
+        size_t messages_compressed = 0; ///< 压缩发出的消息数
+        size_t messages_inflated = 0;   ///< 解压完成的消息数
+        size_t bytes_before = 0;        ///< 压缩前累计字节
+        size_t bytes_after = 0;         ///< 压缩后累计字节（不含帧头）
+    };
+
+    /**
+     * @brief 创建压缩上下文
+     * @param params 协商结果
+     * @param config 本端配置（压缩级别、阈值、内存上限）
+     * @param is_server 是否为服务端；决定使用哪一侧的窗口与 no_context_takeover
+     * @return 压缩上下文；当前构建没有 zlib 或 zlib 初始化失败返回 kWsCompressionError
+     */
+    static std::expected<std::unique_ptr<WsPerMessageDeflate>, WsError>
+    create(const WsDeflateParams& params, const WsDeflateConfig& config, bool is_server);
+
+    WsPerMessageDeflate(const WsPerMessageDeflate&) = delete;
+    WsPerMessageDeflate& operator=(const WsPerMessageDeflate&) = delete;
+
+    /**
+     * @brief 消息是否值得压缩
+     * @param payload_size 消息长度
+     * @return 不小于 compression_threshold 时为 true
+     */
+    bool shouldCompress(size_t payload_size) const noexcept {
+        return payload_size >= m_threshold;
+    }
+
+    /**
+     * @brief 压缩一条完整消息
+     * @param payload 消息内容
+     * @param out 输出缓冲，函数会覆盖其现有内容（复用其容量）
+     * @return zlib 出错返回 kWsCompressionError，此时上下文已重置，可改发原始帧
+     */
+    std::expected<void, WsError> compressMessage(std::string_view payload, std::string& out);
+
+    /**
+     * @brief 解压消息的一帧
+     * @param data 该帧的负载（已解掩码）
+     * @param fin 是否为消息最后一帧
+     * @param out 消息缓冲，解压结果追加在末尾
+     * @param max_output out 的长度上限
+     * @return 超出上限返回 kWsMessageTooLarge，数据损坏返回 kWsCompressionError
+     */
+    std::expected<void, WsError> inflateFrame(std::string_view data, bool fin, std::string& out, size_t max_output);
+
+    /**
+     * @brief 获取协商结果
+     */
+    const WsDeflateParams& params() const noexcept { return m_params; }
+
+    /**
+     * @brief 获取压缩统计
+     */
+    const Counters& counters() const noexcept { return m_counters; }
+
+    /**
+     * @brief 两个方向 zlib 状态的估算内存
+     * @return 字节数
+     */
+    size_t memoryBytes() const noexcept { return m_memory_bytes; }
+
+private:
+    WsPerMessageDeflate(const WsDeflateParams& params,
+                        galay::http::HttpRawDeflateStream&& deflater,
+                        galay::http::HttpRawDeflateStream&& inflater,
+                        bool reset_deflater,
+                        bool reset_inflater,
+                        size_t threshold,
+                        size_t memory_bytes);
+
+    WsDeflateParams m_params;
+    galay::http::HttpRawDeflateStream m_deflater;
+    galay::http::HttpRawDeflateStream m_inflater;
+    bool m_reset_deflater;      ///< 本端 no_context_takeover
+    bool m_reset_inflater;      ///< 对端 no_context_takeover
+    size_t m_threshold;
+    size_t m_memory_bytes;
+    Counters m_counters;
+};
+
+} // namespace galay::websocket
+
+#endif // GALAY_WEBSOCKET_DEFLATE_H
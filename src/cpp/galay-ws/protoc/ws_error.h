@@ -44,6 +44,7 @@ enum WsErrorCode
     kWsConnectionError,          ///< 连接错误
     kWsSendError,                ///< 发送错误
     kWsUpgradeFailed,            ///< 升级失败
+    kWsCompressionError,         ///< permessage-deflate 压缩 / 解压失败
     kWsUnknownError              ///< 未知错误
 };
 
@@ -133,6 +134,7 @@ public:
 
             case kWsInvalidUtf8:
             case kWsInvalidPayloadLength:
+            case kWsCompressionError:
                 return WsCloseCode::InvalidPayload;
 
             case kWsMessageTooLarge:
@@ -186,6 +188,8 @@ private:
                 return "Send error";
             case kWsUpgradeFailed:
                 return "WebSocket upgrade failed";
+            case kWsCompressionError:
+                return "Per-message compression error";
             case kWsUnknownError:
                 return "Unknown error";
             default:
@@ -1,4 +1,5 @@
 #include "ws_frame.h"
+#include "ws_utf8.h"
 
 #include <galay/cpp/galay-ws/utils/ws_helper.h>
 
@@ -159,13 +160,14 @@ private:
 } // namespace
 
 std::expected<size_t, WsError>
-WsFrameParser::fromIOVec(const std::vector<iovec>& iovecs, WsFrame& frame, bool is_server)
+WsFrameParser::fromIOVec(const std::vector<iovec>& iovecs, WsFrame& frame, bool is_server, bool allow_rsv1)
 {
-    return fromIOVec(iovecs.data(), iovecs.size(), frame, is_server);
+    return fromIOVec(iovecs.data(), iovecs.size(), frame, is_server, allow_rsv1);
 }
 
 std::expected<size_t, WsError>
-WsFrameParser::fromIOVec(const struct iovec* iovecs, size_t iovec_count, WsFrame& frame, bool is_server)
+WsFrameParser::fromIOVec(const struct iovec* iovecs, size_t iovec_count, WsFrame& frame, bool is_server,
+                         bool allow_rsv1)
 {
     const size_t total_length = getTotalLength(iovecs, iovec_count);
     if (total_length < 2) {
@@ -187,12 +189,14 @@ WsFrameParser::fromIOVec(const struct iovec* iovecs, size_t iovec_count, WsFrame
     frame.header.rsv3 = (byte1 & 0x10) != 0;
 
     // 检查保留位（如果没有协商扩展，保留位必须为0）
-    if (frame.header.rsv1 || frame.header.rsv2 || frame.header.rsv3) {
+    // permessage-deflate 只允许消息首帧（Text / Binary）设置 RSV1
+    uint8_t opcode_value = byte1 & 0x0F;
+    const bool rsv1_allowed = allow_rsv1 && (opcode_value == 0x01 || opcode_value == 0x02);
+    if ((frame.header.rsv1 && !rsv1_allowed) || frame.header.rsv2 || frame.header.rsv3) {
         return std::unexpected(WsError(kWsReservedBitsSet));
     }
 
     // 解析操作码
-    uint8_t opcode_value = byte1 & 0x0F;
     if (opcode_value > 0x0A || (opcode_value > 0x02 && opcode_value < 0x08)) {
         return std::unexpected(WsError(kWsInvalidOpcode));
     }
@@ -309,8 +313,8 @@ WsFrameParser::fromIOVec(const struct iovec* iovecs, size_t iovec_count, WsFrame
         }
     }
 
-    // 验证文本帧的UTF-8编码
-    if (frame.header.opcode == WsOpcode::Text && frame.header.fin) {
+    // 验证文本帧的UTF-8编码（压缩帧在解压后由消息层校验）
+    if (frame.header.opcode == WsOpcode::Text && frame.header.fin && !frame.header.rsv1) {
         if (!isValidUtf8(frame.payload)) {
             return std::unexpected(WsError(kWsInvalidUtf8));
         }
@@ -402,6 +406,18 @@ void WsFrameParser::encodeMessageInto(std::string& out,
     }
 }
 
+WsSharedFrame WsSharedFrame::encode(WsOpcode opcode, std::string_view payload)
+{
+    auto bytes = std::make_shared<std::string>();
+    WsFrameParser::encodeMessageInto(*bytes, opcode, payload, true, false);
+
+    WsSharedFrame frame;
+    frame.m_header_size = bytes->size() - payload.size();
+    frame.m_opcode = opcode;
+    frame.m_bytes = std::move(bytes);
+    return frame;
+}
+
 std::string WsFrameParser::toBytesHeader(const WsFrame& frame, bool use_mask, uint8_t masking_key[4])
 {
     std::string result;
@@ -432,97 +448,7 @@ bool WsFrameParser::isValidUtf8Bytes(const char* data, size_t len)
     if (data == nullptr) {
         return len == 0;
     }
-
-    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
-    size_t i = 0;
-
-#if defined(GALAY_WS_SIMD_NEON)
-    // ARM NEON 优化：快速检测 ASCII 字符（0x00-0x7F）
-    if (len >= 16) {
-        for (; i + 16 <= len; i += 16) {
-            uint8x16_t chunk = vld1q_u8(ptr + i);
-            // 检查是否所有字节都是 ASCII (最高位为 0)
-            uint8x16_t high_bits = vandq_u8(chunk, vdupq_n_u8(0x80));
-            // 如果有任何非 ASCII 字符，跳出 SIMD 处理
-            uint64x2_t result = vreinterpretq_u64_u8(high_bits);
-            if (vgetq_lane_u64(result, 0) != 0 || vgetq_lane_u64(result, 1) != 0) {
-                break;
-            }
-        }
-    }
-#elif defined(GALAY_WS_SIMD_X86)
-    // x86 SSE2 优化：快速检测 ASCII 字符
-    if (len >= 16) {
-        __m128i high_bit_mask = _mm_set1_epi8(0x80);
-        for (; i + 16 <= len; i += 16) {
-            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
-            __m128i high_bits = _mm_and_si128(chunk, high_bit_mask);
-            // 如果有任何非 ASCII 字符，跳出 SIMD 处理
-            if (_mm_movemask_epi8(high_bits) != 0) {
-                break;
-            }
-        }
-    }
-#endif
-
-    // 标量处理剩余字节和多字节 UTF-8 序列
-    while (i < len) {
-        uint8_t byte = ptr[i];
-
-        if (byte <= 0x7F) {
-            // 单字节字符 (0xxxxxxx)
-            i++;
-        } else if ((byte & 0xE0) == 0xC0) {
-            // 双字节字符 (110xxxxx 10xxxxxx)
-            if (i + 1 >= len) return false;
-            uint8_t byte2 = ptr[i + 1];
-            if ((byte2 & 0xC0) != 0x80) return false;
-
-            // 检查过长编码：双字节序列的最小值是 0x80
-            uint32_t codepoint = ((byte & 0x1F) << 6) | (byte2 & 0x3F);
-            if (codepoint < 0x80) return false;
-
-            i += 2;
-        } else if ((byte & 0xF0) == 0xE0) {
-            // 三字节字符 (1110xxxx 10xxxxxx 10xxxxxx)
-            if (i + 2 >= len) return false;
-            uint8_t byte2 = ptr[i + 1];
-            uint8_t byte3 = ptr[i + 2];
-            if ((byte2 & 0xC0) != 0x80) return false;
-            if ((byte3 & 0xC0) != 0x80) return false;
-
-            // 检查过长编码：三字节序列的最小值是 0x800
-            uint32_t codepoint = ((byte & 0x0F) << 12) | ((byte2 & 0x3F) << 6) | (byte3 & 0x3F);
-            if (codepoint < 0x800) return false;
-
-            // 检查代理对范围 (U+D800 到 U+DFFF 是无效的)
-            if (codepoint >= 0xD800 && codepoint <= 0xDFFF) return false;
-
-            i += 3;
-        } else if ((byte & 0xF8) == 0xF0) {
-            // 四字节字符 (11110xxx 10xxxxxx 10xxxxxx 10xxxxxx)
-            if (i + 3 >= len) return false;
-            uint8_t byte2 = ptr[i + 1];
-            uint8_t byte3 = ptr[i + 2];
-            uint8_t byte4 = ptr[i + 3];
-            if ((byte2 & 0xC0) != 0x80) return false;
-            if ((byte3 & 0xC0) != 0x80) return false;
-            if ((byte4 & 0xC0) != 0x80) return false;
-
-            // 检查过长编码：四字节序列的最小值是 0x10000
-            uint32_t codepoint = ((byte & 0x07) << 18) | ((byte2 & 0x3F) << 12) |
-                                ((byte3 & 0x3F) << 6) | (byte4 & 0x3F);
-            if (codepoint < 0x10000) return false;
-
-            // 检查最大值：Unicode 最大码点是 U+10FFFF
-            if (codepoint > 0x10FFFF) return false;
-
-            i += 4;
-        } else {
-            return false;
-        }
-    }
-    return true;
+    return WsUtf8Validator::validate(data, len);
 }
 
 bool WsFrameParser::isValidUtf8MaskedBytes(const char* data,
@@ -532,96 +458,8 @@ bool WsFrameParser::isValidUtf8MaskedBytes(const char* data,
     if (data == nullptr) {
         return len == 0;
     }
-
-    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
-    size_t i = 0;
-
-#if defined(GALAY_WS_SIMD_NEON)
-    if (len >= 16) {
-        uint8_t mask_array[16];
-        for (int j = 0; j < 16; ++j) {
-            mask_array[j] = masking_key[j % 4];
-        }
-        uint8x16_t mask_vec = vld1q_u8(mask_array);
-        const uint8x16_t high_bit_mask = vdupq_n_u8(0x80);
-
-        for (; i + 16 <= len; i += 16) {
-            const uint8x16_t chunk = vld1q_u8(ptr + i);
-            const uint8x16_t unmasked = veorq_u8(chunk, mask_vec);
-            const uint8x16_t high_bits = vandq_u8(unmasked, high_bit_mask);
-            const uint64x2_t result = vreinterpretq_u64_u8(high_bits);
-            if (vgetq_lane_u64(result, 0) != 0 || vgetq_lane_u64(result, 1) != 0) {
-                break;
-            }
-        }
-    }
-#elif defined(GALAY_WS_SIMD_X86)
-    if (len >= 16) {
-        uint8_t mask_array[16];
-        for (int j = 0; j < 16; ++j) {
-            mask_array[j] = masking_key[j % 4];
-        }
-        const __m128i mask_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask_array));
-        const __m128i high_bit_mask = _mm_set1_epi8(0x80);
-
-        for (; i + 16 <= len; i += 16) {
-            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
-            const __m128i unmasked = _mm_xor_si128(chunk, mask_vec);
-            const __m128i high_bits = _mm_and_si128(unmasked, high_bit_mask);
-            if (_mm_movemask_epi8(high_bits) != 0) {
-                break;
-            }
-        }
-    }
-#endif
-
-    const auto masked = [&](size_t index) noexcept -> uint8_t {
-        return ptr[index] ^ masking_key[index % 4];
-    };
-
-    while (i < len) {
-        const uint8_t byte = masked(i);
-
-        if (byte <= 0x7F) {
-            ++i;
-        } else if ((byte & 0xE0) == 0xC0) {
-            if (i + 1 >= len) return false;
-            const uint8_t byte2 = masked(i + 1);
-            if ((byte2 & 0xC0) != 0x80) return false;
-            const uint32_t codepoint = ((byte & 0x1F) << 6) | (byte2 & 0x3F);
-            if (codepoint < 0x80) return false;
-            i += 2;
-        } else if ((byte & 0xF0) == 0xE0) {
-            if (i + 2 >= len) return false;
-            const uint8_t byte2 = masked(i + 1);
-            const uint8_t byte3 = masked(i + 2);
-            if ((byte2 & 0xC0) != 0x80) return false;
-            if ((byte3 & 0xC0) != 0x80) return false;
-            const uint32_t codepoint = ((byte & 0x0F) << 12) |
-                                       ((byte2 & 0x3F) << 6) |
-                                       (byte3 & 0x3F);
-            if (codepoint < 0x800) return false;
-            if (codepoint >= 0xD800 && codepoint <= 0xDFFF) return false;
-            i += 3;
-        } else if ((byte & 0xF8) == 0xF0) {
-            if (i + 3 >= len) return false;
-            const uint8_t byte2 = masked(i + 1);
-            const uint8_t byte3 = masked(i + 2);
-            const uint8_t byte4 = masked(i + 3);
-            if ((byte2 & 0xC0) != 0x80) return false;
-            if ((byte3 & 0xC0) != 0x80) return false;
-            if ((byte4 & 0xC0) != 0x80) return false;
-            const uint32_t codepoint = ((byte & 0x07) << 18) |
-                                       ((byte2 & 0x3F) << 12) |
-                                       ((byte3 & 0x3F) << 6) |
-                                       (byte4 & 0x3F);
-            if (codepoint < 0x10000 || codepoint > 0x10FFFF) return false;
-            i += 4;
-        } else {
-            return false;
-        }
-    }
-    return true;
+    WsUtf8Validator validator;
+    return validator.feedMasked(data, len, masking_key) && validator.finish();
 }
 
 bool WsFrameParser::isValidUtf8(const std::string& data)
@@ -14,6 +14,8 @@
 #include "ws_error.h"
 #include "../builder/ws_frame_builder.h"
 #include <expected>
+#include <memory>
+#include <string>
 #include <string_view>
 #include <sys/uio.h>
 #include <utility>
@@ -34,12 +36,13 @@ public:
      * @param iovecs 输入的iovec数组
      * @param frame 输出的帧数据
      * @param is_server 是否是服务器端（服务器端要求客户端必须使用掩码）
+     * @param allow_rsv1 已协商 permessage-deflate 时为 true，允许数据帧设置 RSV1
      * @return std::expected<size_t, WsError>
      *         - size_t: 消费的字节数
      *         - WsError: 解析错误或数据不完整
      */
     static std::expected<size_t, WsError>
-    fromIOVec(const std::vector<iovec>& iovecs, WsFrame& frame, bool is_server = true);
+    fromIOVec(const std::vector<iovec>& iovecs, WsFrame& frame, bool is_server = true, bool allow_rsv1 = false);
 
     /**
      * @brief 从原始 iovec 数组解析 WebSocket 帧（避免临时 vector 分配）
@@ -47,9 +50,11 @@ public:
      * @param iovec_count iovec 数量
      * @param frame 输出的帧数据
      * @param is_server 是否是服务器端（服务器端要求客户端必须使用掩码）
+     * @param allow_rsv1 已协商 permessage-deflate 时为 true，允许数据帧设置 RSV1
      */
     static std::expected<size_t, WsError>
-    fromIOVec(const struct iovec* iovecs, size_t iovec_count, WsFrame& frame, bool is_server = true);
+    fromIOVec(const struct iovec* iovecs, size_t iovec_count, WsFrame& frame, bool is_server = true,
+              bool allow_rsv1 = false);
 
     /**
      * @brief 将WebSocket帧编码为字节流
@@ -202,6 +207,63 @@ private:
     static size_t getTotalLength(const struct iovec* iovecs, size_t iovec_count);
 };
 
+/**
+ * @brief 只编码一次、可被多个连接共享的服务端帧
+ * @details 完整的帧字节（帧头 + 负载，FIN=1、不带掩码）放在引用计数的只读缓冲中，
+ *          复制只增加引用计数。广播时同一份字节可直接作为每个连接 writev 的 iovec，
+ *          连接写完后释放引用。客户端写入器必须加掩码，会按 payload() 重新编码。
+ */
+class WsSharedFrame
+{
+public:
+    WsSharedFrame() = default;
+
+    /**
+     * @brief 编码一条服务端消息帧
+     * @param opcode 帧类型
+     * @param payload 负载内容
+     * @return 共享帧
+     */
+    static WsSharedFrame encode(WsOpcode opcode, std::string_view payload);
+
+    /**
+     * @brief 是否为空（未编码任何帧）
+     */
+    bool empty() const noexcept { return m_bytes == nullptr; }
+
+    /**
+     * @brief 完整的帧字节
+     */
+    std::string_view bytes() const noexcept {
+        return m_bytes ? std::string_view(*m_bytes) : std::string_view();
+    }
+
+    /**
+     * @brief 帧字节数（含帧头）
+     */
+    size_t size() const noexcept { return m_bytes ? m_bytes->size() : 0; }
+
+    /**
+     * @brief 帧类型
+     */
+    WsOpcode opcode() const noexcept { return m_opcode; }
+
+    /**
+     * @brief 负载内容（不含帧头）
+     */
+    std::string_view payload() const noexcept { return bytes().substr(m_header_size); }
+
+    /**
+     * @brief 当前引用计数，用于测试与诊断
+     */
+    long useCount() const noexcept { return m_bytes.use_count(); }
+
+private:
+    std::shared_ptr<const std::string> m_bytes;
+    size_t m_header_size = 0;
+    WsOpcode m_opcode = WsOpcode::Text;
+};
+
 } // namespace galay::websocket
 
 #endif // GALAY_WEBSOCKET_FRAME_H
@@ -0,0 +1,588 @@
+#include "ws_utf8.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+// SIMD 支持检测：x86 上按函数粒度开启指令集，运行时再按 CPU 能力分派
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define GALAY_WS_UTF8_X86
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define GALAY_WS_UTF8_NEON
+#endif
+
+namespace galay::websocket
+{
+namespace {
+
+constexpr uint8_t kKernelUnresolved = 0xff;
+constexpr uint64_t kAsciiHighBits = 0x8080808080808080ULL;
+constexpr size_t kMaskedChunkSize = 512;
+
+std::atomic<uint8_t> g_kernel{kKernelUnresolved};
+
+inline bool isContinuation(uint8_t byte) noexcept
+{
+    return (byte & 0xC0) == 0x80;
+}
+
+// 码点总字节数；0 表示不可能作为首字节（续字节、0xC0/0xC1、0xF5 以上）
+inline uint8_t sequenceLength(uint8_t lead) noexcept
+{
+    if (lead < 0x80) return 1;
+    if (lead < 0xC2) return 0;
+    if (lead < 0xE0) return 2;
+    if (lead < 0xF0) return 3;
+    if (lead < 0xF5) return 4;
+    return 0;
+}
+
+// 第二字节的合法区间取决于首字节：排除过长编码、代理区（U+D800..U+DFFF）与超出 U+10FFFF
+inline bool validSecondByte(uint8_t lead, uint8_t second) noexcept
+{
+    switch (lead) {
+    case 0xE0: return second >= 0xA0 && second <= 0xBF;
+    case 0xED: return second >= 0x80 && second <= 0x9F;
+    case 0xF0: return second >= 0x90 && second <= 0xBF;
+    case 0xF4: return second >= 0x80 && second <= 0x8F;
+    default:   return isContinuation(second);
+    }
+}
+
+// 校验码点的前 size 个字节；size 等于码点长度时即完整校验
+bool validPrefix(const uint8_t* bytes, size_t size) noexcept
+{
+    const uint8_t need = sequenceLength(bytes[0]);
+    if (need == 0 || size > need) {
+        return false;
+    }
+    if (size >= 2 && !validSecondByte(bytes[0], bytes[1])) {
+        return false;
+    }
+    for (size_t i = 2; i < size; ++i) {
+        if (!isContinuation(bytes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool validateScalar(const uint8_t* ptr, size_t len) noexcept
+{
+    size_t i = 0;
+    while (i < len) {
+        const uint8_t lead = ptr[i];
+        if (lead < 0x80) {
+            // ASCII 段一次跳过 16 字节
+            for (; i + 16 <= len; i += 16) {
+                uint64_t low;
+                uint64_t high;
+                std::memcpy(&low, ptr + i, sizeof(low));
+                std::memcpy(&high, ptr + i + 8, sizeof(high));
+                if (((low | high) & kAsciiHighBits) != 0) {
+                    break;
+                }
+            }
+            while (i < len && ptr[i] < 0x80) {
+                ++i;
+            }
+            continue;
+        }
+        if (lead < 0xE0) {
+            if (lead < 0xC2 || len - i < 2 || !isContinuation(ptr[i + 1])) {
+                return false;
+            }
+            i += 2;
+        } else if (lead < 0xF0) {
+            if (len - i < 3 || !validSecondByte(lead, ptr[i + 1]) || !isContinuation(ptr[i + 2])) {
+                return false;
+            }
+            i += 3;
+        } else {
+            if (lead > 0xF4 || len - i < 4 || !validSecondByte(lead, ptr[i + 1]) ||
+                !isContinuation(ptr[i + 2]) || !isContinuation(ptr[i + 3])) {
+                return false;
+            }
+            i += 4;
+        }
+    }
+    return true;
+}
+
+/*
+ * 查表法（Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"）：
+ * 以 (前一字节高 4 位, 前一字节低 4 位, 当前字节高 4 位) 三次查表相与，非零即错误；
+ * 第三、四字节是否必须为续字节由前 2、3 个字节的首字节类型决定，与查表结果异或。
+ */
+constexpr uint8_t kTooShort = 1 << 0;   // 11______ 0_______ / 11______ 11______
+constexpr uint8_t kTooLong = 1 << 1;    // 0_______ 10______
+constexpr uint8_t kOverlong3 = 1 << 2;  // 11100000 100_____
+constexpr uint8_t kTooLarge = 1 << 3;   // 11110100 1001____ 等
+constexpr uint8_t kSurrogate = 1 << 4;  // 11101101 101_____
+constexpr uint8_t kOverlong2 = 1 << 5;  // 1100000_ 10______
+constexpr uint8_t kTooLarge1000 = 1 << 6; // 11110101 1000____ 等
+constexpr uint8_t kOverlong4 = 1 << 6;  // 11110000 1000____
+constexpr uint8_t kTwoConts = 1 << 7;   // 10______ 10______
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+alignas(16) constexpr uint8_t kByte1High[16] = {
+    kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+    kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+    kTooShort | kOverlong2,
+    kTooShort,
+    kTooShort | kOverlong3 | kSurrogate,
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+};
+
+alignas(16) constexpr uint8_t kByte1Low[16] = {
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    kCarry | kOverlong2,
+    kCarry,
+    kCarry,
+    kCarry | kTooLarge,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+};
+
+alignas(16) constexpr uint8_t kByte2High[16] = {
+    kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooShort, kTooShort, kTooShort, kTooShort,
+};
+
+// 块末 3 个字节若是 4/3/2 字节首字节，码点必然延续到下一块
+alignas(16) constexpr uint8_t kIncompleteMax[16] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+
+#if defined(GALAY_WS_UTF8_X86)
+struct Sse4State {
+    __m128i error;
+    __m128i prev_input;
+    __m128i prev_incomplete;
+};
+
+__attribute__((target("sse4.1")))
+inline void checkBlockSse4(Sse4State& state, __m128i input) noexcept
+{
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    const __m128i byte_1_high_table = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High));
+    const __m128i byte_1_low_table = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low));
+    const __m128i byte_2_high_table = _mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High));
+
+    const __m128i prev1 = _mm_alignr_epi8(input, state.prev_input, 15);
+    const __m128i byte_1_high = _mm_shuffle_epi8(
+        byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+    const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, low_nibble));
+    const __m128i byte_2_high = _mm_shuffle_epi8(
+        byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+    const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+    const __m128i prev2 = _mm_alignr_epi8(input, state.prev_input, 14);
+    const __m128i prev3 = _mm_alignr_epi8(input, state.prev_input, 13);
+    const __m128i is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m128i must_continue = _mm_and_si128(
+        _mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)));
+
+    state.error = _mm_or_si128(state.error, _mm_xor_si128(must_continue, special));
+    state.prev_incomplete = _mm_subs_epu8(
+        input, _mm_load_si128(reinterpret_cast<const __m128i*>(kIncompleteMax)));
+    state.prev_input = input;
+}
+
+__attribute__((target("sse4.1")))
+bool validateSse4(const uint8_t* ptr, size_t len) noexcept
+{
+    Sse4State state{_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()};
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i + 16));
+        const __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i + 32));
+        const __m128i b3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i + 48));
+        const __m128i any = _mm_or_si128(_mm_or_si128(b0, b1), _mm_or_si128(b2, b3));
+        if (_mm_movemask_epi8(any) == 0) {
+            // 纯 ASCII：只需确认上一块没有悬空的多字节首字节
+            state.error = _mm_or_si128(state.error, state.prev_incomplete);
+            state.prev_incomplete = _mm_setzero_si128();
+            state.prev_input = b3;
+        } else {
+            checkBlockSse4(state, b0);
+            checkBlockSse4(state, b1);
+            checkBlockSse4(state, b2);
+            checkBlockSse4(state, b3);
+        }
+        if (!_mm_testz_si128(state.error, state.error)) {
+            return false;
+        }
+    }
+    for (; i + 16 <= len; i += 16) {
+        checkBlockSse4(state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i)));
+    }
+    if (i < len) {
+        // 尾部补零成整块：补的 0x00 是 ASCII，截断的码点会被判为过短
+        alignas(16) uint8_t tail[16] = {};
+        std::memcpy(tail, ptr + i, len - i);
+        checkBlockSse4(state, _mm_load_si128(reinterpret_cast<const __m128i*>(tail)));
+    }
+    state.error = _mm_or_si128(state.error, state.prev_incomplete);
+    return _mm_testz_si128(state.error, state.error) != 0;
+}
+
+struct Avx2State {
+    __m256i error;
+    __m256i prev_input;
+    __m256i prev_incomplete;
+};
+
+__attribute__((target("avx2")))
+inline __m256i prevBytesAvx2(__m256i input, __m256i prev_input, int count) noexcept
+{
+    // 跨 128 位通道：高通道接本块低通道，低通道接上一块高通道
+    const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+    switch (count) {
+    case 1: return _mm256_alignr_epi8(input, shifted, 15);
+    case 2: return _mm256_alignr_epi8(input, shifted, 14);
+    default: return _mm256_alignr_epi8(input, shifted, 13);
+    }
+}
+
+__attribute__((target("avx2")))
+inline void checkBlockAvx2(Avx2State& state, __m256i input) noexcept
+{
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    const __m256i byte_1_high_table = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High)));
+    const __m256i byte_1_low_table = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low)));
+    const __m256i byte_2_high_table = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High)));
+
+    const __m256i prev1 = prevBytesAvx2(input, state.prev_input, 1);
+    const __m256i byte_1_high = _mm256_shuffle_epi8(
+        byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+    const __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, low_nibble));
+    const __m256i byte_2_high = _mm256_shuffle_epi8(
+        byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+    const __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    const __m256i prev2 = prevBytesAvx2(input, state.prev_input, 2);
+    const __m256i prev3 = prevBytesAvx2(input, state.prev_input, 3);
+    const __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m256i must_continue = _mm256_and_si256(
+        _mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+    state.error = _mm256_or_si256(state.error, _mm256_xor_si256(must_continue, special));
+    const __m256i incomplete_max = _mm256_setr_m128i(
+        _mm_set1_epi8(static_cast<char>(0xFF)),
+        _mm_load_si128(reinterpret_cast<const __m128i*>(kIncompleteMax)));
+    state.prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+    state.prev_input = input;
+}
+
+__attribute__((target("avx2")))
+bool validateAvx2(const uint8_t* ptr, size_t len) noexcept
+{
+    Avx2State state{_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i));
+        const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i + 32));
+        if (_mm256_movemask_epi8(_mm256_or_si256(b0, b1)) == 0) {
+            state.error = _mm256_or_si256(state.error, state.prev_incomplete);
+            state.prev_incomplete = _mm256_setzero_si256();
+            state.prev_input = b1;
+        } else {
+            checkBlockAvx2(state, b0);
+            checkBlockAvx2(state, b1);
+        }
+        if (!_mm256_testz_si256(state.error, state.error)) {
+            return false;
+        }
+    }
+    for (; i + 32 <= len; i += 32) {
+        checkBlockAvx2(state, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i)));
+    }
+    if (i < len) {
+        alignas(32) uint8_t tail[32] = {};
+        std::memcpy(tail, ptr + i, len - i);
+        checkBlockAvx2(state, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+    }
+    state.error = _mm256_or_si256(state.error, state.prev_incomplete);
+    return _mm256_testz_si256(state.error, state.error) != 0;
+}
+#endif
+
+#if defined(GALAY_WS_UTF8_NEON)
+struct NeonState {
+    uint8x16_t error;
+    uint8x16_t prev_input;
+    uint8x16_t prev_incomplete;
+};
+
+inline void checkBlockNeon(NeonState& state, uint8x16_t input) noexcept
+{
+    const uint8x16_t low_nibble = vdupq_n_u8(0x0F);
+    const uint8x16_t prev1 = vextq_u8(state.prev_input, input, 15);
+    const uint8x16_t byte_1_high = vqtbl1q_u8(vld1q_u8(kByte1High), vshrq_n_u8(prev1, 4));
+    const uint8x16_t byte_1_low = vqtbl1q_u8(vld1q_u8(kByte1Low), vandq_u8(prev1, low_nibble));
+    const uint8x16_t byte_2_high = vqtbl1q_u8(vld1q_u8(kByte2High), vshrq_n_u8(input, 4));
+    const uint8x16_t special = vandq_u8(vandq_u8(byte_1_high, byte_1_low), byte_2_high);
+
+    const uint8x16_t prev2 = vextq_u8(state.prev_input, input, 14);
+    const uint8x16_t prev3 = vextq_u8(state.prev_input, input, 13);
+    const uint8x16_t is_third_byte = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+    const uint8x16_t is_fourth_byte = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+    const uint8x16_t must_continue = vandq_u8(vorrq_u8(is_third_byte, is_fourth_byte), vdupq_n_u8(0x80));
+
+    state.error = vorrq_u8(state.error, veorq_u8(must_continue, special));
+    state.prev_incomplete = vqsubq_u8(input, vld1q_u8(kIncompleteMax));
+    state.prev_input = input;
+}
+
+bool validateNeon(const uint8_t* ptr, size_t len) noexcept
+{
+    NeonState state{vdupq_n_u8(0), vdupq_n_u8(0), vdupq_n_u8(0)};
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        const uint8x16_t b0 = vld1q_u8(ptr + i);
+        const uint8x16_t b1 = vld1q_u8(ptr + i + 16);
+        const uint8x16_t b2 = vld1q_u8(ptr + i + 32);
+        const uint8x16_t b3 = vld1q_u8(ptr + i + 48);
+        const uint8x16_t any = vorrq_u8(vorrq_u8(b0, b1), vorrq_u8(b2, b3));
+        if (vmaxvq_u8(any) < 0x80) {
+            state.error = vorrq_u8(state.error, state.prev_incomplete);
+            state.prev_incomplete = vdupq_n_u8(0);
+            state.prev_input = b3;
+        } else {
+            checkBlockNeon(state, b0);
+            checkBlockNeon(state, b1);
+            checkBlockNeon(state, b2);
+            checkBlockNeon(state, b3);
+        }
+        if (vmaxvq_u8(state.error) != 0) {
+            return false;
+        }
+    }
+    for (; i + 16 <= len; i += 16) {
+        checkBlockNeon(state, vld1q_u8(ptr + i));
+    }
+    if (i < len) {
+        uint8_t tail[16] = {};
+        std::memcpy(tail, ptr + i, len - i);
+        checkBlockNeon(state, vld1q_u8(tail));
+    }
+    state.error = vorrq_u8(state.error, state.prev_incomplete);
+    return vmaxvq_u8(state.error) == 0;
+}
+#endif
+
+bool validateComplete(const uint8_t* ptr, size_t len) noexcept
+{
+    switch (activeWsUtf8Kernel()) {
+#if defined(GALAY_WS_UTF8_X86)
+    case WsUtf8Kernel::Avx2:
+        return validateAvx2(ptr, len);
+    case WsUtf8Kernel::Sse4:
+        return validateSse4(ptr, len);
+#endif
+#if defined(GALAY_WS_UTF8_NEON)
+    case WsUtf8Kernel::Neon:
+        return validateNeon(ptr, len);
+#endif
+    default:
+        return validateScalar(ptr, len);
+    }
+}
+
+bool cpuSupports(WsUtf8Kernel kernel) noexcept
+{
+    switch (kernel) {
+    case WsUtf8Kernel::Scalar:
+        return true;
+#if defined(GALAY_WS_UTF8_X86)
+    case WsUtf8Kernel::Sse4:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.1");
+    case WsUtf8Kernel::Avx2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+#if defined(GALAY_WS_UTF8_NEON)
+    case WsUtf8Kernel::Neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+WsUtf8Kernel detectKernel() noexcept
+{
+    for (const auto kernel : {WsUtf8Kernel::Avx2, WsUtf8Kernel::Sse4, WsUtf8Kernel::Neon}) {
+        if (cpuSupports(kernel)) {
+            return kernel;
+        }
+    }
+    return WsUtf8Kernel::Scalar;
+}
+
+} // namespace
+
+WsUtf8Kernel activeWsUtf8Kernel() noexcept
+{
+    uint8_t kernel = g_kernel.load(std::memory_order_relaxed);
+    if (kernel == kKernelUnresolved) {
+        // 并发首次调用探测结果相同，重复写入无害
+        kernel = static_cast<uint8_t>(detectKernel());
+        g_kernel.store(kernel, std::memory_order_relaxed);
+    }
+    return static_cast<WsUtf8Kernel>(kernel);
+}
+
+bool isWsUtf8KernelSupported(WsUtf8Kernel kernel) noexcept
+{
+    return cpuSupports(kernel);
+}
+
+bool setWsUtf8Kernel(WsUtf8Kernel kernel) noexcept
+{
+    if (!isWsUtf8KernelSupported(kernel)) {
+        return false;
+    }
+    g_kernel.store(static_cast<uint8_t>(kernel), std::memory_order_relaxed);
+    return true;
+}
+
+std::string_view wsUtf8KernelName(WsUtf8Kernel kernel) noexcept
+{
+    switch (kernel) {
+    case WsUtf8Kernel::Scalar: return "scalar";
+    case WsUtf8Kernel::Sse4:   return "sse4";
+    case WsUtf8Kernel::Avx2:   return "avx2";
+    case WsUtf8Kernel::Neon:   return "neon";
+    }
+    return "unknown";
+}
+
+bool WsUtf8Validator::feedPending(const uint8_t*& data, size_t& len) noexcept
+{
+    while (m_pending_size < m_pending_need && len > 0) {
+        m_pending[m_pending_size++] = *data++;
+        --len;
+    }
+    if (!validPrefix(m_pending, m_pending_size)) {
+        return false;
+    }
+    if (m_pending_size == m_pending_need) {
+        m_pending_size = 0;
+        m_pending_need = 0;
+    }
+    return true;
+}
+
+bool WsUtf8Validator::feed(const char* data, size_t len) noexcept
+{
+    if (!m_valid) {
+        return false;
+    }
+    if (len == 0) {
+        return true;
+    }
+    const auto* ptr = reinterpret_cast<const uint8_t*>(data);
+    if (m_pending_size != 0 && !feedPending(ptr, len)) {
+        m_valid = false;
+        return false;
+    }
+    if (len == 0) {
+        return true;
+    }
+
+    // 末尾未完成的码点（至多 3 字节）暂存，下一次 feed 补齐后再判定
+    size_t body = len;
+    for (size_t back = 1; back <= 3 && back <= len; ++back) {
+        const uint8_t byte = ptr[len - back];
+        if (isContinuation(byte)) {
+            continue;
+        }
+        if (byte >= 0xC0 && sequenceLength(byte) > back) {
+            body = len - back;
+        }
+        break;
+    }
+    if (!validateComplete(ptr, body)) {
+        m_valid = false;
+        return false;
+    }
+    if (body != len) {
+        m_pending_size = static_cast<uint8_t>(len - body);
+        std::memcpy(m_pending, ptr + body, m_pending_size);
+        m_pending_need = sequenceLength(m_pending[0]);
+        if (!validPrefix(m_pending, m_pending_size)) {
+            m_valid = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WsUtf8Validator::feedMasked(const char* data,
+                                 size_t len,
+                                 const uint8_t masking_key[4],
+                                 size_t key_offset) noexcept
+{
+    alignas(16) char buffer[kMaskedChunkSize];
+    while (len > 0) {
+        const size_t count = std::min(len, sizeof(buffer));
+        uint8_t rotated[8];
+        for (size_t j = 0; j < sizeof(rotated); ++j) {
+            rotated[j] = masking_key[(key_offset + j) % 4];
+        }
+        uint64_t mask64;
+        std::memcpy(&mask64, rotated, sizeof(mask64));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            word ^= mask64;
+            std::memcpy(buffer + i, &word, sizeof(word));
+        }
+        for (; i < count; ++i) {
+            buffer[i] = static_cast<char>(static_cast<uint8_t>(data[i]) ^ rotated[i % 4]);
+        }
+        if (!feed(buffer, count)) {
+            return false;
+        }
+        data += count;
+        len -= count;
+        key_offset += count;
+    }
+    return m_valid;
+}
+
+bool WsUtf8Validator::validate(const char* data, size_t len) noexcept
+{
+    if (len == 0) {
+        return true;
+    }
+    return data != nullptr && validateComplete(reinterpret_cast<const uint8_t*>(data), len);
+}
+
+} // namespace galay::websocket
@@ -0,0 +1,124 @@
+/**
+ * @file ws_utf8.h
+ * @brief WebSocket 文本消息的流式 UTF-8 校验
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 校验核按 CPU 能力运行时分派（AVX2 / SSE4 / NEON / 标量），向量核采用查表法：
+ *          每个字节与前 1~3 个字节组合查表，一次判定过短、过长、过长编码、代理区与超出 U+10FFFF，
+ *          纯 ASCII 的 64 字节块只做一次高位检测即跳过。WsUtf8Validator 在分片之间与
+ *          RingBuffer 回绕处携带未完成码点的前缀，读取器可以边收边校验，不必在 FIN 后整条重扫。
+ */
+
+#ifndef GALAY_WS_UTF8_H
+#define GALAY_WS_UTF8_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace galay::websocket
+{
+
+/**
+ * @brief UTF-8 校验内核
+ */
+enum class WsUtf8Kernel : uint8_t {
+    Scalar, ///< 逐码点标量校验，8 字节一组跳过 ASCII，所有平台可用
+    Sse4,   ///< SSE4.1 查表校验，一次 16 字节
+    Avx2,   ///< AVX2 查表校验，一次 32 字节
+    Neon,   ///< ARM NEON 查表校验，一次 16 字节
+};
+
+/**
+ * @brief 当前生效的校验内核
+ * @return 首次调用时按 CPU 能力选择（AVX2 > SSE4 > NEON > 标量），之后返回缓存结果
+ */
+WsUtf8Kernel activeWsUtf8Kernel() noexcept;
+
+/**
+ * @brief 判断当前 CPU 是否支持指定内核
+ */
+bool isWsUtf8KernelSupported(WsUtf8Kernel kernel) noexcept;
+
+/**
+ * @brief 强制切换校验内核（测试与压测对照用）
+ * @return CPU 不支持时不切换并返回 false
+ */
+bool setWsUtf8Kernel(WsUtf8Kernel kernel) noexcept;
+
+/**
+ * @brief 获取校验内核名称
+ * @return "scalar" / "sse4" / "avx2" / "neon"
+ */
+std::string_view wsUtf8KernelName(WsUtf8Kernel kernel) noexcept;
+
+/**
+ * @brief 流式 UTF-8 校验器
+ * @details 每次 feed 只校验新到达的字节：末尾未完成的码点前缀（至多 3 字节）暂存到下一次 feed
+ *          继续校验，因此分片边界、RingBuffer 回绕处切开码点都不影响结果。前缀本身已不可能
+ *          合法（如 0xC0、0xED 0xA0）时立即失败，不等待后续字节。失败后状态保持无效，直到 reset()。
+ * @code
+ * WsUtf8Validator utf8;
+ * for (auto& fragment : fragments) {
+ *     if (!utf8.feed(fragment.data(), fragment.size())) { fail(); }
+ * }
+ * if (!utf8.finish()) { fail(); }   // 消息结束时仍有未完成码点
+ * @endcode
+ */
+class WsUtf8Validator
+{
+public:
+    /**
+     * @brief 回到初始状态，开始校验新消息
+     */
+    void reset() noexcept {
+        m_pending_size = 0;
+        m_pending_need = 0;
+        m_valid = true;
+    }
+
+    /**
+     * @brief 校验后续字节
+     * @return 目前为止的字节仍可能构成合法 UTF-8 时返回 true
+     */
+    bool feed(const char* data, size_t len) noexcept;
+
+    /**
+     * @brief 校验带掩码的后续字节，不修改输入
+     * @param key_offset data[0] 在整帧负载中的偏移，用于对齐 4 字节掩码
+     */
+    bool feedMasked(const char* data, size_t len, const uint8_t masking_key[4], size_t key_offset = 0) noexcept;
+
+    /**
+     * @brief 消息结束：全部字节合法且没有未完成码点时返回 true
+     */
+    bool finish() const noexcept { return m_valid && m_pending_size == 0; }
+
+    /**
+     * @brief 目前为止是否仍合法
+     */
+    bool valid() const noexcept { return m_valid; }
+
+    /**
+     * @brief 暂存的未完成码点字节数
+     */
+    size_t pendingBytes() const noexcept { return m_pending_size; }
+
+    /**
+     * @brief 一次性校验完整缓冲区
+     */
+    static bool validate(const char* data, size_t len) noexcept;
+
+private:
+    bool feedPending(const uint8_t*& data, size_t& len) noexcept;
+
+    uint8_t m_pending[4] = {0, 0, 0, 0};   ///< 未完成码点的已到达字节
+    uint8_t m_pending_size = 0;            ///< m_pending 中的字节数
+    uint8_t m_pending_need = 0;            ///< 该码点的总字节数
+    bool m_valid = true;
+};
+
+} // namespace galay::websocket
+
+#endif // GALAY_WS_UTF8_H
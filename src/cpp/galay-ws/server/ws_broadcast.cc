@@ -0,0 +1,346 @@
+/**
+ * @file ws_broadcast.cc
+ * @brief WebSocket 广播组实现
+ */
+
+#include <galay/cpp/galay-ws/server/ws_broadcast.h>
+#include <galay/cpp/galay-ws/builder/ws_frame_builder.h>
+#include <utility>
+
+namespace galay::websocket
+{
+
+namespace detail {
+
+WsBroadcastMember::WsBroadcastMember(const WsBroadcastMemberConfig& member_config)
+    : config(member_config)
+    , channel(std::max<size_t>(1, member_config.batch_size))
+    , token(channel.makeProducerToken())
+{
+}
+
+WsBroadcastMember::Offer WsBroadcastMember::offer(const WsSharedFrame& frame)
+{
+    if (closed.load(std::memory_order_relaxed)) {
+        return Offer::Closed;
+    }
+
+    if (pending.load(std::memory_order_relaxed) >= config.max_pending) {
+        switch (config.policy) {
+        case WsBackpressurePolicy::Drop:
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return Offer::Dropped;
+        case WsBackpressurePolicy::CoalesceLatest: {
+            bool wake = false;
+            {
+                std::lock_guard<std::mutex> lock(latest_mutex);
+                if (latest.empty()) {
+                    wake = true;
+                    enqueued.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    coalesced.fetch_add(1, std::memory_order_relaxed);
+                }
+                latest = frame;
+            }
+            // 暂存槽由空变满时投递一个空帧唤醒 pump；之后的覆盖只替换暂存帧
+            if (wake && !channel.send(token, WsSharedFrame())) {
+                return Offer::Closed;
+            }
+            return wake ? Offer::Enqueued : Offer::Coalesced;
+        }
+        case WsBackpressurePolicy::Disconnect:
+            closed.store(true, std::memory_order_relaxed);
+            overflowed.store(true, std::memory_order_release);
+            (void)channel.send(token, WsSharedFrame());
+            return Offer::Disconnected;
+        }
+    }
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    if (!channel.send(token, frame)) {
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        return Offer::Closed;
+    }
+    enqueued.fetch_add(1, std::memory_order_relaxed);
+    return Offer::Enqueued;
+}
+
+WsSharedFrame WsBroadcastMember::takeLatest()
+{
+    std::lock_guard<std::mutex> lock(latest_mutex);
+    return std::exchange(latest, WsSharedFrame());
+}
+
+bool WsBroadcastMember::sendDirect(WsSharedFrame frame)
+{
+    if (frame.empty() || closed.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(direct_mutex);
+        wake = direct.empty();
+        direct.push_back(std::move(frame));
+    }
+    // 与 CoalesceLatest 共用空帧唤醒，经同一 token 入队，排在此前投递的广播帧之后
+    return !wake || channel.send(token, WsSharedFrame());
+}
+
+void WsBroadcastMember::takeDirect(std::vector<WsSharedFrame>& out)
+{
+    std::lock_guard<std::mutex> lock(direct_mutex);
+    for (auto& frame : direct) {
+        out.push_back(std::move(frame));
+    }
+    direct.clear();
+}
+
+void WsBroadcastMember::close()
+{
+    closed.store(true, std::memory_order_relaxed);
+    (void)channel.close();
+}
+
+WsBroadcastCounters WsBroadcastMember::counters() const
+{
+    WsBroadcastCounters result;
+    result.enqueued = enqueued.load(std::memory_order_relaxed);
+    result.dropped = dropped.load(std::memory_order_relaxed);
+    result.coalesced = coalesced.load(std::memory_order_relaxed);
+    result.disconnected = overflowed.load(std::memory_order_relaxed) ? 1 : 0;
+    result.sent = sent.load(std::memory_order_relaxed);
+    return result;
+}
+
+void WsBroadcastState::remove(const std::shared_ptr<WsBroadcastMember>& member)
+{
+    const size_t index = member->index;
+    if (index >= members.size() || members[index] != member) {
+        return;
+    }
+    if (index + 1 != members.size()) {
+        members[index] = std::move(members.back());
+        members[index]->index = index;
+    }
+    members.pop_back();
+}
+
+} // namespace detail
+
+WsBroadcastSubscription::~WsBroadcastSubscription()
+{
+    leave();
+}
+
+WsBroadcastSubscription& WsBroadcastSubscription::operator=(WsBroadcastSubscription&& other) noexcept
+{
+    if (this != &other) {
+        leave();
+        m_state = std::move(other.m_state);
+        m_member = std::move(other.m_member);
+    }
+    return *this;
+}
+
+void WsBroadcastSubscription::leave()
+{
+    if (!m_member) {
+        return;
+    }
+    if (auto state = m_state.lock()) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->remove(m_member);
+        m_member->close();
+    } else {
+        // 组已析构，成员在析构时已被关闭
+        m_member->closed.store(true, std::memory_order_relaxed);
+    }
+    m_state.reset();
+    m_member.reset();
+}
+
+bool WsBroadcastSubscription::send(const WsSharedFrame& frame)
+{
+    if (!m_member) {
+        return false;
+    }
+    auto state = m_state.lock();
+    if (!state) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return m_member->sendDirect(frame);
+}
+
+bool WsBroadcastSubscription::sendText(std::string_view text)
+{
+    return m_member && send(WsSharedFrame::encode(WsOpcode::Text, text));
+}
+
+bool WsBroadcastSubscription::sendBinary(std::string_view data)
+{
+    return m_member && send(WsSharedFrame::encode(WsOpcode::Binary, data));
+}
+
+bool WsBroadcastSubscription::sendPing(std::string_view data)
+{
+    if (!m_member || data.size() > 125) {
+        return false;
+    }
+    return send(WsSharedFrame::encode(WsOpcode::Ping, data));
+}
+
+bool WsBroadcastSubscription::sendPong(std::string_view data)
+{
+    if (!m_member || data.size() > 125) {
+        return false;
+    }
+    return send(WsSharedFrame::encode(WsOpcode::Pong, data));
+}
+
+bool WsBroadcastSubscription::sendClose(WsCloseCode code, std::string_view reason)
+{
+    if (!m_member) {
+        return false;
+    }
+    WsFrame frame = WsFrameBuilder().close(code, std::string(reason)).buildMove();
+    const bool queued = frame.payload.size() <= 125 &&
+        send(WsSharedFrame::encode(WsOpcode::Close, frame.payload));
+    // 退出组会关闭通道，pump 写完已排队的帧（含关闭帧）后结束
+    leave();
+    return queued;
+}
+
+size_t WsBroadcastSubscription::pending() const noexcept
+{
+    if (!m_member) {
+        return 0;
+    }
+    return m_member->pending.load(std::memory_order_relaxed);
+}
+
+WsBroadcastCounters WsBroadcastSubscription::counters() const
+{
+    if (!m_member) {
+        return WsBroadcastCounters();
+    }
+    return m_member->counters();
+}
+
+WsBroadcastGroup::WsBroadcastGroup()
+    : m_state(std::make_shared<detail::WsBroadcastState>())
+{
+}
+
+WsBroadcastGroup::~WsBroadcastGroup()
+{
+    close();
+}
+
+WsBroadcastSubscription WsBroadcastGroup::join(const WsBroadcastMemberConfig& config)
+{
+    auto member = std::make_shared<detail::WsBroadcastMember>(config);
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    if (m_state->closed || !member->token.valid()) {
+        return WsBroadcastSubscription();
+    }
+    member->index = m_state->members.size();
+    m_state->members.push_back(member);
+    return WsBroadcastSubscription(m_state, std::move(member));
+}
+
+size_t WsBroadcastGroup::publishText(std::string_view text)
+{
+    return publish(WsSharedFrame::encode(WsOpcode::Text, text));
+}
+
+size_t WsBroadcastGroup::publishBinary(std::string_view data)
+{
+    return publish(WsSharedFrame::encode(WsOpcode::Binary, data));
+}
+
+size_t WsBroadcastGroup::publish(const WsSharedFrame& frame)
+{
+    if (frame.empty()) {
+        return 0;
+    }
+
+    size_t accepted = 0;
+    size_t enqueued = 0;
+    size_t dropped = 0;
+    size_t coalesced = 0;
+    size_t disconnected = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        auto& members = m_state->members;
+        for (const auto& member : members) {
+            switch (member->offer(frame)) {
+            case detail::WsBroadcastMember::Offer::Enqueued:
+                ++accepted;
+                ++enqueued;
+                break;
+            case detail::WsBroadcastMember::Offer::Coalesced:
+                ++accepted;
+                ++coalesced;
+                break;
+            case detail::WsBroadcastMember::Offer::Dropped:
+                ++dropped;
+                break;
+            case detail::WsBroadcastMember::Offer::Disconnected:
+                ++disconnected;
+                break;
+            case detail::WsBroadcastMember::Offer::Closed:
+                break;
+            }
+        }
+        // 断开的成员不再接收消息，从成员表移除；其 pump 发送关闭帧后自行结束
+        for (size_t i = 0; disconnected > 0 && i < members.size();) {
+            if (members[i]->overflowed.load(std::memory_order_relaxed)) {
+                m_state->remove(members[i]);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    m_state->published.fetch_add(1, std::memory_order_relaxed);
+    m_state->enqueued.fetch_add(enqueued, std::memory_order_relaxed);
+    m_state->dropped.fetch_add(dropped, std::memory_order_relaxed);
+    m_state->coalesced.fetch_add(coalesced, std::memory_order_relaxed);
+    m_state->disconnected.fetch_add(disconnected, std::memory_order_relaxed);
+    return accepted;
+}
+
+size_t WsBroadcastGroup::size() const
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->members.size();
+}
+
+WsBroadcastCounters WsBroadcastGroup::counters() const
+{
+    WsBroadcastCounters result;
+    result.published = m_state->published.load(std::memory_order_relaxed);
+    result.enqueued = m_state->enqueued.load(std::memory_order_relaxed);
+    result.dropped = m_state->dropped.load(std::memory_order_relaxed);
+    result.coalesced = m_state->coalesced.load(std::memory_order_relaxed);
+    result.disconnected = m_state->disconnected.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    for (const auto& member : m_state->members) {
+        result.sent += member->sent.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void WsBroadcastGroup::close()
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->closed = true;
+    for (const auto& member : m_state->members) {
+        member->close();
+    }
+    m_state->members.clear();
+}
+
+} // namespace galay::websocket
@@ -0,0 +1,418 @@
+/**
+ * @file ws_broadcast.h
+ * @brief WebSocket 广播组：一次编码，扇出到大量连接
+ * @author galay-http
+ * @version 1.0.0
+ *
+ * @details 发布时只把消息编码一次为 WsSharedFrame（引用计数的只读帧字节），
+ *          再经每个成员自己的 MPSC 通道投递引用，不复制负载。成员的写出由 pump 协程
+ *          在连接所在的 IO 调度器上完成：每批帧合并为一次 writev，写完释放引用。
+ *          发布可以来自任意线程；每个成员按 WsBackpressurePolicy 处理慢消费者。
+ *          pump 独占连接的写入器，读循环的 pong、应答与关闭帧经订阅的 send* 投递，
+ *          由同一个 pump 按入队顺序写出。
+ *
+ * @code
+ * WsBroadcastGroup group;
+ * // 连接处理协程中
+ * auto subscription = group.join(WsBroadcastMemberConfig{.policy = WsBackpressurePolicy::CoalesceLatest});
+ * auto writer = ws_conn.getWriter(WsWriterSetting::byServer());
+ * co_await subscription.pump(writer);   // 直到 leave() / 组关闭 / 写失败
+ * // 同一连接的读循环（pump 运行期间不直接使用 writer）
+ * subscription.sendPong(ping_payload);
+ * // 任意线程
+ * group.publishText(R"({"price":101.5})");
+ * @endcode
+ */
+
+#ifndef GALAY_WS_BROADCAST_H
+#define GALAY_WS_BROADCAST_H
+
+#include "../kernel/ws_writer.h"
+#include "../protoc/ws_frame.h"
+#include "../../galay-kernel/concurrency/mpsc/unbounded_channel.h"
+#include "../../galay-kernel/core/task.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace galay::websocket
+{
+
+/**
+ * @brief 慢消费者处理策略
+ * @details 成员队列中尚未写出的帧达到 max_pending 时生效。
+ */
+enum class WsBackpressurePolicy : uint8_t
+{
+    Drop,               ///< 丢弃新消息，已排队的消息照常写出
+    CoalesceLatest,     ///< 只保留最新一条，写完已排队的消息后补发（适合行情快照类消息）
+    Disconnect,         ///< 以 1008 关闭帧断开该连接
+};
+
+/**
+ * @brief 广播组成员配置
+ */
+struct WsBroadcastMemberConfig
+{
+    size_t max_pending = 256;                               ///< 排队未写出的帧数上限
+    WsBackpressurePolicy policy = WsBackpressurePolicy::Drop; ///< 达到上限后的处理策略
+    size_t batch_size = 32;                                 ///< pump 单次 writev 最多合并的帧数
+};
+
+/**
+ * @brief 广播统计
+ * @details 组级统计累计所有成员；成员级统计中 published 恒为 0。
+ */
+struct WsBroadcastCounters
+{
+    size_t published = 0;       ///< 发布调用次数
+    size_t enqueued = 0;        ///< 投递进成员队列的帧数
+    size_t dropped = 0;         ///< Drop 策略丢弃的帧数
+    size_t coalesced = 0;       ///< CoalesceLatest 策略下被更新消息覆盖、不再发出的帧数
+    size_t disconnected = 0;    ///< Disconnect 策略断开的成员数
+    size_t sent = 0;            ///< 已写出的帧数
+};
+
+namespace detail {
+
+/**
+ * @brief 单个成员的共享状态
+ * @details 生产者一侧（offer / sendDirect / close）只在组互斥量内调用，因此每个成员只需一个
+ *          ProducerToken；消费者一侧由该成员的 pump 协程独占。
+ */
+struct WsBroadcastMember
+{
+    /**
+     * @brief 投递结果
+     */
+    enum class Offer : uint8_t
+    {
+        Enqueued,
+        Coalesced,
+        Dropped,
+        Disconnected,
+        Closed,
+    };
+
+    explicit WsBroadcastMember(const WsBroadcastMemberConfig& member_config);
+
+    /**
+     * @brief 投递一帧，必须持有组互斥量
+     */
+    Offer offer(const WsSharedFrame& frame);
+
+    /**
+     * @brief 取走 CoalesceLatest 暂存的最新帧
+     */
+    WsSharedFrame takeLatest();
+
+    /**
+     * @brief 投递连接自身的帧（控制帧、应答），不计入 pending、不受背压策略影响；必须持有组互斥量
+     * @return 成员已关闭返回 false
+     * @details 暂存队列由空变非空时经 token 投递一个空帧唤醒 pump，此前投递的广播帧先写出。
+     */
+    bool sendDirect(WsSharedFrame frame);
+
+    /**
+     * @brief 把暂存的连接自身帧按投递顺序追加到 out
+     */
+    void takeDirect(std::vector<WsSharedFrame>& out);
+
+    /**
+     * @brief 关闭通道，pump 写完已排队的帧后结束；必须持有组互斥量
+     */
+    void close();
+
+    WsBroadcastCounters counters() const;
+
+    WsBroadcastMemberConfig config;
+    galay::mpsc::UnboundedChannel<WsSharedFrame> channel;
+    galay::mpsc::UnboundedChannel<WsSharedFrame>::ProducerToken token;
+    std::atomic<size_t> pending{0};         ///< 已投递未写出的帧数（不含暂存的最新帧）
+    std::atomic<bool> closed{false};        ///< 已退出组或已因背压断开
+    std::atomic<bool> overflowed{false};    ///< Disconnect 策略已触发
+    std::mutex latest_mutex;
+    WsSharedFrame latest;                   ///< CoalesceLatest 暂存的最新帧
+    std::mutex direct_mutex;
+    std::vector<WsSharedFrame> direct;      ///< 连接自身待写出的帧
+    std::atomic<size_t> enqueued{0};
+    std::atomic<size_t> dropped{0};
+    std::atomic<size_t> coalesced{0};
+    std::atomic<size_t> sent{0};
+    size_t index = 0;                       ///< 在组成员表中的位置，由组互斥量保护
+};
+
+/**
+ * @brief 广播组共享状态，成员订阅以弱引用指向它
+ */
+struct WsBroadcastState
+{
+    void remove(const std::shared_ptr<WsBroadcastMember>& member);
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<WsBroadcastMember>> members;
+    bool closed = false;
+    std::atomic<size_t> published{0};
+    std::atomic<size_t> enqueued{0};
+    std::atomic<size_t> dropped{0};
+    std::atomic<size_t> coalesced{0};
+    std::atomic<size_t> disconnected{0};
+};
+
+/**
+ * @brief 成员写出循环
+ * @details 参数按值持有成员，订阅对象在 pump 挂起期间移动或析构都不影响循环。
+ *          空帧是通道里的唤醒标记：Disconnect 触发时发送关闭帧并结束，否则依次取走
+ *          连接自身的帧与暂存的最新帧。连接自身的关闭帧写出后 pump 结束。
+ */
+template<typename SocketType>
+galay::kernel::Task<std::expected<void, WsError>>
+pumpBroadcastMember(std::shared_ptr<WsBroadcastMember> member, WsWriterImpl<SocketType>& writer)
+{
+    if (!member) {
+        co_return std::unexpected(WsError(kWsConnectionClosed, "broadcast subscription is not joined"));
+    }
+    const size_t batch_size = std::max<size_t>(1, member->config.batch_size);
+    std::vector<WsSharedFrame> batch;
+    std::vector<WsSharedFrame> outgoing;
+    std::vector<WsSharedFrame> direct;
+    batch.reserve(batch_size);
+    outgoing.reserve(batch_size + 1);
+
+    while (true) {
+        batch.clear();
+        auto received = co_await member->channel.recvBatchTo(batch, batch_size);
+        if (!received) {
+            if (galay::kernel::IOError::contains(received.error().code(), galay::kernel::kClosed)) {
+                co_return std::expected<void, WsError>();
+            }
+            co_return std::unexpected(WsError(received.error()));
+        }
+
+        outgoing.clear();
+        size_t queued = 0;
+        size_t own = 0;
+        bool overflowed = false;
+        bool closing = false;
+        for (auto& frame : batch) {
+            if (!frame.empty()) {
+                outgoing.push_back(std::move(frame));
+                ++queued;
+                continue;
+            }
+            if (member->overflowed.load(std::memory_order_acquire)) {
+                overflowed = true;
+                break;
+            }
+            direct.clear();
+            member->takeDirect(direct);
+            for (auto& reply : direct) {
+                closing = reply.opcode() == WsOpcode::Close;
+                outgoing.push_back(std::move(reply));
+                ++own;
+                if (closing) {
+                    break;
+                }
+            }
+            if (closing) {
+                break;
+            }
+            WsSharedFrame latest = member->takeLatest();
+            if (!latest.empty()) {
+                outgoing.push_back(std::move(latest));
+            }
+        }
+
+        if (overflowed) {
+            member->pending.store(0, std::memory_order_relaxed);
+            auto closed = co_await writer.sendClose(WsCloseCode::PolicyViolation, "slow consumer");
+            if (!closed) {
+                co_return std::unexpected(closed.error());
+            }
+            co_return std::unexpected(WsError(kWsSendError, "broadcast backpressure: slow consumer disconnected"));
+        }
+        if (outgoing.empty()) {
+            continue;
+        }
+
+        auto written = co_await writer.sendShared(std::span<const WsSharedFrame>(outgoing));
+        member->pending.fetch_sub(queued, std::memory_order_relaxed);
+        if (!written) {
+            co_return std::unexpected(written.error());
+        }
+        member->sent.fetch_add(outgoing.size() - own, std::memory_order_relaxed);
+        if (closing) {
+            co_return std::expected<void, WsError>();
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief 广播组成员订阅
+ * @details 由 WsBroadcastGroup::join 创建，可移动不可复制；析构时自动退出组。
+ *          退出后 pump 写完已排队的帧即返回成功。
+ */
+class WsBroadcastSubscription
+{
+public:
+    WsBroadcastSubscription() = default;
+    ~WsBroadcastSubscription();
+
+    WsBroadcastSubscription(WsBroadcastSubscription&& other) noexcept = default;
+    WsBroadcastSubscription& operator=(WsBroadcastSubscription&& other) noexcept;
+
+    WsBroadcastSubscription(const WsBroadcastSubscription&) = delete;
+    WsBroadcastSubscription& operator=(const WsBroadcastSubscription&) = delete;
+
+    /**
+     * @brief 把广播帧写入连接，直到退出组、组关闭、写失败或写出 sendClose() 的关闭帧
+     * @param writer 该连接的写入器；pump 运行期间不得在别处使用，改用 send* 投递
+     * @return 正常退出返回成功；Disconnect 策略断开或写失败返回错误
+     * @details 应在连接所在的 IO 调度器上运行。连接的读循环可以并行进行。
+     */
+    template<typename SocketType>
+    galay::kernel::Task<std::expected<void, WsError>> pump(WsWriterImpl<SocketType>& writer) {
+        return detail::pumpBroadcastMember(m_member, writer);
+    }
+
+    /**
+     * @brief 经 pump 写出连接自身的帧
+     * @param frame 已编码的帧，例如 WsSharedFrame::encode(WsOpcode::Text, reply)
+     * @return 未绑定成员、已退出组或已因背压断开时返回 false
+     * @details 此前已排队的广播帧先写出；不计入 max_pending，也不受背压策略影响。
+     *          可在任意线程调用（短暂持有组互斥量），通常由同一连接的读循环回复 pong 或发送应答。
+     */
+    bool send(const WsSharedFrame& frame);
+
+    /**
+     * @brief 经 pump 写出一条文本消息
+     */
+    bool sendText(std::string_view text);
+
+    /**
+     * @brief 经 pump 写出一条二进制消息
+     */
+    bool sendBinary(std::string_view data);
+
+    /**
+     * @brief 经 pump 写出 Ping 帧
+     * @return 负载超过 125 字节时返回 false
+     */
+    bool sendPing(std::string_view data = {});
+
+    /**
+     * @brief 经 pump 写出 Pong 帧
+     * @return 负载超过 125 字节时返回 false
+     */
+    bool sendPong(std::string_view data = {});
+
+    /**
+     * @brief 经 pump 写出关闭帧并退出广播组
+     * @return 关闭帧负载超过 125 字节或无法投递时返回 false（仍会退出组）
+     * @details 此前已排队的广播帧先写出；关闭帧写出后 pump 返回成功。
+     */
+    bool sendClose(WsCloseCode code = WsCloseCode::Normal, std::string_view reason = {});
+
+    /**
+     * @brief 退出广播组，不再接收新消息
+     */
+    void leave();
+
+    /**
+     * @brief 是否仍绑定成员
+     */
+    bool valid() const noexcept { return m_member != nullptr; }
+
+    /**
+     * @brief 已投递未写出的帧数
+     */
+    size_t pending() const noexcept;
+
+    /**
+     * @brief 成员级统计
+     */
+    WsBroadcastCounters counters() const;
+
+private:
+    friend class WsBroadcastGroup;
+
+    WsBroadcastSubscription(std::weak_ptr<detail::WsBroadcastState> state,
+                            std::shared_ptr<detail::WsBroadcastMember> member)
+        : m_state(std::move(state))
+        , m_member(std::move(member)) {}
+
+    std::weak_ptr<detail::WsBroadcastState> m_state;
+    std::shared_ptr<detail::WsBroadcastMember> m_member;
+};
+
+/**
+ * @brief WebSocket 广播组
+ * @details 线程安全：join / leave / publish 可来自任意线程。publish 在组互斥量内
+ *          遍历成员并投递引用，每个成员的开销是一次引用计数递增与一次 MPSC 入队。
+ *          组析构或 close() 后所有成员的 pump 写完已排队的帧后结束。
+ */
+class WsBroadcastGroup
+{
+public:
+    WsBroadcastGroup();
+    ~WsBroadcastGroup();
+
+    WsBroadcastGroup(const WsBroadcastGroup&) = delete;
+    WsBroadcastGroup& operator=(const WsBroadcastGroup&) = delete;
+
+    /**
+     * @brief 加入广播组
+     * @param config 成员背压配置
+     * @return 订阅；组已关闭时返回 valid()==false 的订阅
+     */
+    WsBroadcastSubscription join(const WsBroadcastMemberConfig& config = WsBroadcastMemberConfig());
+
+    /**
+     * @brief 广播文本消息
+     * @return 接收该消息的成员数（入队或暂存为最新帧）
+     */
+    size_t publishText(std::string_view text);
+
+    /**
+     * @brief 广播二进制消息
+     * @return 接收该消息的成员数
+     */
+    size_t publishBinary(std::string_view data);
+
+    /**
+     * @brief 广播已编码的共享帧
+     * @return 接收该帧的成员数
+     */
+    size_t publish(const WsSharedFrame& frame);
+
+    /**
+     * @brief 当前成员数
+     */
+    size_t size() const;
+
+    /**
+     * @brief 组级统计
+     */
+    WsBroadcastCounters counters() const;
+
+    /**
+     * @brief 关闭广播组，移除全部成员
+     */
+    void close();
+
+private:
+    std::shared_ptr<detail::WsBroadcastState> m_state;
+};
+
+} // namespace galay::websocket
+
+#endif // GALAY_WS_BROADCAST_H
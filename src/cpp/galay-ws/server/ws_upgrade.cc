@@ -231,6 +231,11 @@ HttpResponse WsUpgrade::createUpgradeResponse(
 }
 
 WsUpgradeResult WsUpgrade::handleUpgrade(HttpRequest& request)
+{
+    return handleUpgrade(request, WsDeflateConfig());
+}
+
+WsUpgradeResult WsUpgrade::handleUpgrade(HttpRequest& request, const WsDeflateConfig& deflate)
 {
     WsUpgradeResult result;
 
@@ -266,6 +271,16 @@ WsUpgradeResult WsUpgrade::handleUpgrade(HttpRequest& request)
     result.success = true;
     result.response = createUpgradeResponse(accept_key, subprotocol);
 
+    // 协商 permessage-deflate；没有可接受的提议时按未启用扩展升级
+    if (deflate.enabled && request.header().headerPairs().hasKey("Sec-WebSocket-Extensions")) {
+        result.deflate = negotiateWsDeflate(
+            request.header().headerPairs().getValue("Sec-WebSocket-Extensions"), deflate);
+        if (result.deflate) {
+            result.response.header().headerPairs().addHeaderPair(
+                "Sec-WebSocket-Extensions", formatWsDeflateResponse(*result.deflate));
+        }
+    }
+
     return result;
 }
 
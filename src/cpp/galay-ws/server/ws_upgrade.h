@@ -9,6 +9,7 @@
 #include "../../galay-http/protoc/http_request.h"
 #include "../../galay-http/protoc/http_response.h"
 #include "../../galay-http/builder/http_builder.h"
+#include "../protoc/ws_deflate.h"
 #include <string>
 #include <optional>
 
@@ -25,6 +26,7 @@ struct WsUpgradeResult
     HttpResponse response;
     std::string error_message;
     bool success = false;
+    std::optional<WsDeflateParams> deflate;     ///< 协商成功的 permessage-deflate 参数
 };
 
 /**
@@ -47,6 +49,14 @@ public:
      */
     static WsUpgradeResult handleUpgrade(HttpRequest& request);
 
+    /**
+     * @brief 验证并处理 WebSocket 升级请求，同时协商 permessage-deflate
+     * @param request HTTP 请求
+     * @param deflate 本端 permessage-deflate 配置
+     * @return WsUpgradeResult 升级结果；协商成功时 deflate 有值，响应已带上 Sec-WebSocket-Extensions
+     */
+    static WsUpgradeResult handleUpgrade(HttpRequest& request, const WsDeflateConfig& deflate);
+
     /**
      * @brief 生成 Sec-WebSocket-Accept 值
      * @param key Sec-WebSocket-Key 值
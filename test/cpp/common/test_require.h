@@ -0,0 +1,34 @@
+#ifndef GALAY_TEST_REQUIRE_H
+#define GALAY_TEST_REQUIRE_H
+
+#include <iostream>
+#include <string_view>
+
+namespace galay::test {
+
+/**
+ * @brief 输出断言失败的文件、行号与表达式
+ */
+inline void reportRequireFailure(std::string_view file, int line, const char* expression)
+{
+    const auto slash = file.find_last_of('/');
+    if (slash != std::string_view::npos) {
+        file.remove_prefix(slash + 1);
+    }
+    std::cerr << "[" << file << ":" << line << "] requirement failed: " << expression << "\n";
+}
+
+}  // namespace galay::test
+
+/**
+ * @brief 条件不成立时输出位置与表达式，并令所在的 bool 用例函数返回 false
+ */
+#define GALAY_TEST_REQUIRE(cond)                                              \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            ::galay::test::reportRequireFailure(__FILE__, __LINE__, #cond);   \
+            return false;                                                     \
+        }                                                                     \
+    } while (false)
+
+#endif
@@ -18,6 +18,7 @@
 #include <thread>
 #include <vector>
 
+#include <galay/cpp/galay-http/builder/http_builder.h>
 #include <galay/cpp/galay-http/kernel/http_conn.h>
 #include <galay/cpp/galay-http/kernel/http_reader.h>
 #include <galay/cpp/galay-http/kernel/http_session.h>
@@ -262,16 +263,11 @@ int connectWithRetry(uint16_t port)
     fail("could not connect to static HEAD test server");
 }
 
-std::string requestHead(uint16_t port)
+std::string requestRaw(uint16_t port, const std::string& request)
 {
     const int fd = connectWithRetry(port);
-    const std::string request =
-        "HEAD /static/head.txt HTTP/1.1\r\n"
-        "Host: 127.0.0.1\r\n"
-        "Connection: close\r\n"
-        "\r\n";
     check(::send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()),
-          "failed to send HEAD request");
+          "failed to send request");
 
     std::string response;
     char buffer[1024];
@@ -288,12 +284,21 @@ std::string requestHead(uint16_t port)
             break;
         }
         ::close(fd);
-        fail("recv() failed while reading HEAD response");
+        fail("recv() failed while reading response");
     }
     ::close(fd);
     return response;
 }
 
+std::string requestHead(uint16_t port)
+{
+    return requestRaw(port,
+                      "HEAD /static/head.txt HTTP/1.1\r\n"
+                      "Host: 127.0.0.1\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+}
+
 void testStaticHeadDoesNotSendBody()
 {
     namespace fs = std::filesystem;
@@ -333,6 +338,41 @@ void testStaticHeadDoesNotSendBody()
     check(body.empty(), "static HEAD response must not send a body");
 }
 
+void testServerFillsRouteParams()
+{
+    HttpRouter router;
+    router.addHandler<HttpMethod::GET>("/user/:id/post/:post",
+        [](HttpConn& conn, HttpRequest request) -> Task<void> {
+            auto response = Http1_1ResponseBuilder::ok()
+                .header("Content-Type", "text/plain")
+                .body(request.getRouteParam("id") + "|" + request.getRouteParam("post"))
+                .buildMove();
+            auto writer = conn.getWriter();
+            (void)co_await writer.sendResponse(response);
+            co_return;
+        });
+
+    const uint16_t port = reserveFreePort();
+    auto server = HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(1)
+        .build();
+    server.start(std::move(router));
+
+    const std::string response = requestRaw(port,
+                                            "GET /user/42/post/hello HTTP/1.1\r\n"
+                                            "Host: 127.0.0.1\r\n"
+                                            "Connection: close\r\n"
+                                            "\r\n");
+    server.stop();
+
+    const auto split = response.find("\r\n\r\n");
+    check(split != std::string::npos, "route param response should contain header terminator");
+    check(response.substr(split + 4) == "42|hello", "server should hand matched route params to the handler");
+}
+
 void testMountHardlyRegistersHead()
 {
     namespace fs = std::filesystem;
@@ -368,6 +408,7 @@ int main()
     testSessionRejectsOversizedResponseBody();
     testMountHardlyRegistersHead();
     testStaticHeadDoesNotSendBody();
+    testServerFillsRouteParams();
 
     std::cout << "T33-HttpProtocolBoundaries PASS\n";
     return 0;
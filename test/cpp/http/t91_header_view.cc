@@ -0,0 +1,324 @@
+/**
+ * @file t91_header_view.cc
+ * @brief 用途：验证请求头向量化扫描、整块解析路径与零拷贝 HttpRequestHeaderView。
+ * 关键覆盖点：AVX2 / SSE4.2 / SWAR 三个分隔符内核与逐字节查找结果一致、
+ * Vectorized 与 Incremental 两种 HttpRequestHeader 解析模式对合法与畸形输入结果相同、
+ * mmap RingBuffer 回绕后视图仍直接指向缓冲区、vector 后端双段输入回退拷贝、
+ * detach() 后视图脱离原缓冲区仍然有效。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-http/protoc/http_header.h>
+#include <galay/cpp/galay-http/protoc/http_header_view.h>
+#include <galay/cpp/galay-http/protoc/http_scan.h>
+#include <galay/cpp/galay-utils/cache/ring_buffer.hpp>
+#include "test/cpp/common/test_require.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace galay::http;
+using ::galay::utils::RingBuffer;
+using ::galay::utils::RingBufferBackendStrategy;
+
+namespace {
+
+constexpr std::array kKernels = {
+    detail::HeaderScanKernel::Swar,
+    detail::HeaderScanKernel::Sse42,
+    detail::HeaderScanKernel::Avx2,
+};
+
+const std::string kSampleRequest =
+    "GET /api/items?id=42&sort=desc HTTP/1.1\r\n"
+    "Host: example.com\r\n"
+    "User-Agent: galay-test/1.0\r\n"
+    "Accept: */*\r\n"
+    "X-Trace-Id:   abc-123\r\n"
+    "Content-Length: 5\r\n"
+    "\r\n"
+    "hello";
+
+struct ParseOutcome {
+    HttpErrorCode error = kNoError;
+    ssize_t consumed = 0;
+    HttpMethod method = HttpMethod::UNKNOWN;
+    std::string uri;
+    std::map<std::string, std::string> args;
+    HttpVersion version = HttpVersion::HttpVersion_Unknown;
+    std::vector<std::pair<std::string, std::string>> headers;
+
+    bool operator==(const ParseOutcome&) const = default;
+};
+
+ParseOutcome parseWith(RequestHeaderParseMode mode, HeaderPair::Mode storage,
+                       const std::string& input, size_t max_uri = 0, size_t max_count = 0)
+{
+    HttpRequestHeader header;
+    header.setParseMode(mode);
+    header.setParseLimits(max_count, 0, max_uri);
+    header.headerPairs() = HeaderPair(storage);
+    iovec iov{const_cast<char*>(input.data()), input.size()};
+    auto [error, consumed] = header.fromIOVec({iov});
+
+    ParseOutcome outcome;
+    outcome.error = error;
+    outcome.consumed = consumed;
+    if (error == kNoError && header.isHeaderComplete()) {
+        outcome.method = header.method();
+        outcome.uri = header.uri();
+        outcome.args = header.args();
+        outcome.version = header.version();
+        header.headerPairs().forEachHeader([&outcome](std::string_view key, std::string_view value) {
+            outcome.headers.emplace_back(std::string(key), std::string(value));
+        });
+        std::sort(outcome.headers.begin(), outcome.headers.end());
+    }
+    return outcome;
+}
+
+bool testKernelsAgree()
+{
+    std::mt19937 rng(91);
+    const std::string alphabet = "abcXYZ09 :\r\n\t-/";
+    const auto original = detail::activeHeaderScanKernel();
+    for (auto kernel : kKernels) {
+        if (!detail::setHeaderScanKernel(kernel)) {
+            std::cout << "[T91] kernel " << detail::headerScanKernelName(kernel) << " unsupported, skipped\n";
+            continue;
+        }
+        for (int round = 0; round < 2000; ++round) {
+            std::string text(rng() % 130, 'a');
+            for (char& ch : text) {
+                ch = (rng() % 8 == 0) ? alphabet[rng() % alphabet.size()] : 'a';
+            }
+            const size_t offset = text.empty() ? 0 : rng() % text.size();
+            const char* begin = text.data() + offset;
+            const char* end = text.data() + text.size();
+            const char* expected = std::find_if(begin, end, [](char ch) {
+                return ch == ':' || ch == '\r' || ch == '\n';
+            });
+            GALAY_TEST_REQUIRE(detail::findFirstOf(begin, end, ':', '\r', '\n') == expected);
+            const char* expected_cr = std::find(begin, end, '\r');
+            GALAY_TEST_REQUIRE(detail::findFirstOf(begin, end, '\r', '\r', '\r') == expected_cr);
+        }
+        // 高位字节不能误报
+        const std::string high(64, static_cast<char>(0x8d));
+        GALAY_TEST_REQUIRE(detail::findFirstOf(high.data(), high.data() + high.size(), '\r', '\n', ':') ==
+                           high.data() + high.size());
+    }
+    detail::setHeaderScanKernel(original);
+    return true;
+}
+
+bool testModesAgree()
+{
+    const std::vector<std::string> corpus = {
+        kSampleRequest,
+        "POST /submit HTTP/1.0\r\nContent-Type: text/plain\r\nX-Empty:\r\nX-Spaces:    \r\n\r\n",
+        "GET    /multi-space    HTTP/1.1\r\nHost: a\r\n\r\n",
+        "GET /dup HTTP/1.1\r\nX-A: 1\r\nX-A: 2\r\nCookie: a=1\r\nCookie: b=2\r\n\r\n",
+        "GET /crlf-in-value HTTP/1.1\r\nX-Bad: a\nb\r\n\r\n",
+        "GET /%E4%BD%A0 HTTP/1.1\r\nHost: a\r\n\r\n",
+        "GET /%ZZ HTTP/1.1\r\nHost: a\r\n\r\n",
+        "GET / HTTP/2.0\r\nHost: a\r\n\r\n",
+        "GET / HTTP/1.1 trailing\r\nHost: a\r\n\r\n",
+        "GET / HTTP/1.1\nHost: a\r\n\r\n",
+        "GET / HTTP/1.1\r\nNoColon\r\n\r\n",
+        "GET / HTTP/1.1\r\n:leading-colon: v\r\n\r\n",
+        "GET / HTTP/1.1\r\nHost: a\rX\r\n\r\n",
+        "GET / HTTP/1.1\r\nContent-Length: 3\r\nContent-Length: 4\r\n\r\n",
+        "GET / HTTP/1.1\r\nContent-Length: abc\r\n\r\n",
+        " GET / HTTP/1.1\r\n\r\n",
+        "BREW /pot HTTP/1.1\r\n\r\n",
+        "GET / HTTP/1.1\r\n" + std::string(257, 'k') + ": v\r\n\r\n",
+        "GET / HTTP/1.1\r\n" + std::string(256, 'k') + ": v\r\n\r\n",
+        "GET / HTTP/1.1\r\nHost: a\r\n",
+        "GET / HTTP/1.1\r\nHost: a",
+        "GET /partial",
+    };
+
+    for (auto storage : {HeaderPair::Mode::ServerSide, HeaderPair::Mode::ClientSide}) {
+        for (const auto& input : corpus) {
+            const auto incremental = parseWith(RequestHeaderParseMode::Incremental, storage, input);
+            const auto vectorized = parseWith(RequestHeaderParseMode::Vectorized, storage, input);
+            if (!(incremental == vectorized)) {
+                std::cerr << "[T91] mode mismatch for input: " << input.substr(0, 48) << "\n";
+                return false;
+            }
+        }
+    }
+
+    // 多于整块路径暂存上限的头部行回退状态机，结果仍一致
+    std::string many = "GET /many HTTP/1.1\r\n";
+    for (int i = 0; i < 100; ++i) {
+        many += "X-H" + std::to_string(i) + ": " + std::to_string(i) + "\r\n";
+    }
+    many += "\r\n";
+    const auto many_incremental = parseWith(RequestHeaderParseMode::Incremental, HeaderPair::Mode::ServerSide, many);
+    GALAY_TEST_REQUIRE(many_incremental.error == kNoError && many_incremental.headers.size() == 100);
+    GALAY_TEST_REQUIRE(many_incremental ==
+                       parseWith(RequestHeaderParseMode::Vectorized, HeaderPair::Mode::ServerSide, many));
+
+    // 解析限制
+    GALAY_TEST_REQUIRE(parseWith(RequestHeaderParseMode::Vectorized, HeaderPair::Mode::ServerSide,
+                                 kSampleRequest, 8).error == kUriTooLong);
+    GALAY_TEST_REQUIRE(parseWith(RequestHeaderParseMode::Vectorized, HeaderPair::Mode::ServerSide,
+                                 kSampleRequest, 0, 3).error == kHeaderTooLarge);
+    GALAY_TEST_REQUIRE(parseWith(RequestHeaderParseMode::Vectorized, HeaderPair::Mode::ServerSide, many, 0, 50) ==
+                       parseWith(RequestHeaderParseMode::Incremental, HeaderPair::Mode::ServerSide, many, 0, 50));
+
+    // 整块路径完成后与状态机一样拒绝重复解析，且 fromString 同样生效
+    HttpRequestHeader header;
+    auto [error, consumed] = header.fromString(kSampleRequest);
+    GALAY_TEST_REQUIRE(error == kNoError);
+    GALAY_TEST_REQUIRE(static_cast<size_t>(consumed) == kSampleRequest.size() - 5);
+    GALAY_TEST_REQUIRE(header.isHeaderComplete());
+    GALAY_TEST_REQUIRE(header.args().at("sort") == "desc");
+    GALAY_TEST_REQUIRE(header.headerPairs().getValue("x-trace-id") == "abc-123");
+    GALAY_TEST_REQUIRE(header.fromString(kSampleRequest).second == 0);
+    return true;
+}
+
+bool pointsInto(std::string_view view, const char* begin, size_t len)
+{
+    return view.data() >= begin && view.data() + view.size() <= begin + len;
+}
+
+bool testViewZeroCopyOnMmapRing()
+{
+    RingBuffer buffer(4096);
+    // 先写入并消费一段填充，使请求跨越物理回绕点
+    const std::string filler(4096 - 40, 'f');
+    GALAY_TEST_REQUIRE(buffer.tryWriteBatch(filler) == filler.size());
+    buffer.consume(filler.size());
+    GALAY_TEST_REQUIRE(buffer.tryWriteBatch(kSampleRequest) == kSampleRequest.size());
+
+    std::array<iovec, 2> raw{};
+    const size_t count = buffer.getReadIovecs(raw);
+    std::vector<iovec> iovecs(raw.begin(), raw.begin() + count);
+    const char* base = static_cast<const char*>(iovecs[0].iov_base);
+    const size_t total = iovecs[0].iov_len;
+
+    HttpRequestHeaderView view;
+    auto [error, consumed] = view.fromIOVec(iovecs);
+    GALAY_TEST_REQUIRE(error == kNoError);
+    GALAY_TEST_REQUIRE(static_cast<size_t>(consumed) == kSampleRequest.size() - 5);
+
+    const bool mmap_backend = count == 1;
+    if (mmap_backend) {
+        GALAY_TEST_REQUIRE(!view.ownsStorage());
+        GALAY_TEST_REQUIRE(pointsInto(view.target(), base, total));
+        for (const auto& field : view.fields()) {
+            GALAY_TEST_REQUIRE(pointsInto(field.name, base, total));
+            GALAY_TEST_REQUIRE(pointsInto(field.value, base, total));
+        }
+    } else {
+        GALAY_TEST_REQUIRE(view.ownsStorage());
+    }
+
+    GALAY_TEST_REQUIRE(view.method() == HttpMethod::GET);
+    GALAY_TEST_REQUIRE(view.methodText() == "GET");
+    GALAY_TEST_REQUIRE(view.path() == "/api/items");
+    GALAY_TEST_REQUIRE(view.query() == "id=42&sort=desc");
+    GALAY_TEST_REQUIRE(view.version() == HttpVersion::HttpVersion_1_1);
+    GALAY_TEST_REQUIRE(view.fields().size() == 5);
+    GALAY_TEST_REQUIRE(view.find(CommonHeaderIndex::Host) == "example.com");
+    GALAY_TEST_REQUIRE(view.find("HOST") == "example.com");
+    GALAY_TEST_REQUIRE(view.find("x-trace-id") == "abc-123");
+    GALAY_TEST_REQUIRE(view.has("Content-Length"));
+    GALAY_TEST_REQUIRE(!view.has("Cookie"));
+    GALAY_TEST_REQUIRE(view.fields()[1].common == CommonHeaderIndex::UserAgent);
+
+    // 请求生命周期超过缓冲区：detach 后覆写缓冲区，视图不受影响
+    view.detach();
+    GALAY_TEST_REQUIRE(view.ownsStorage());
+    GALAY_TEST_REQUIRE(!pointsInto(view.target(), base, total));
+    buffer.consume(buffer.readable());
+    const std::string garbage(4000, 'z');
+    GALAY_TEST_REQUIRE(buffer.tryWriteBatch(garbage) == garbage.size());
+    GALAY_TEST_REQUIRE(view.target() == "/api/items?id=42&sort=desc");
+    GALAY_TEST_REQUIRE(view.find("User-Agent") == "galay-test/1.0");
+
+    HttpRequestHeaderView moved = std::move(view);
+    GALAY_TEST_REQUIRE(moved.find(CommonHeaderIndex::Accept) == "*/*");
+    return true;
+}
+
+bool testViewCopiesAcrossIovecs()
+{
+    const size_t split = kSampleRequest.find("Accept") + 3;
+    std::string first = kSampleRequest.substr(0, split);
+    std::string second = kSampleRequest.substr(split);
+    std::vector<iovec> iovecs = {
+        {first.data(), first.size()},
+        {second.data(), second.size()},
+    };
+
+    HttpRequestHeaderView view;
+    auto [error, consumed] = view.fromIOVec(iovecs);
+    GALAY_TEST_REQUIRE(error == kNoError);
+    GALAY_TEST_REQUIRE(static_cast<size_t>(consumed) == kSampleRequest.size() - 5);
+    GALAY_TEST_REQUIRE(view.ownsStorage());
+    GALAY_TEST_REQUIRE(view.find("Accept") == "*/*");
+    first.assign(first.size(), '#');
+    second.assign(second.size(), '#');
+    GALAY_TEST_REQUIRE(view.find(CommonHeaderIndex::Host) == "example.com");
+
+    // 同一视图复用于零拷贝输入
+    GALAY_TEST_REQUIRE(view.parse(kSampleRequest).first == kNoError);
+    GALAY_TEST_REQUIRE(!view.ownsStorage());
+    GALAY_TEST_REQUIRE(pointsInto(view.path(), kSampleRequest.data(), kSampleRequest.size()));
+
+    // vector 后端回绕时给出两段视图
+    RingBuffer<RingBufferBackendStrategy::Vector, std::dynamic_extent> ring(256);
+    const std::string filler(200, 'f');
+    GALAY_TEST_REQUIRE(ring.tryWriteBatch(filler) == filler.size());
+    ring.consume(filler.size() - 10);  // 保持非空，避免后端把读写索引归零
+    GALAY_TEST_REQUIRE(ring.tryWriteBatch(kSampleRequest) == kSampleRequest.size());
+    ring.consume(10);
+    std::array<iovec, 2> raw{};
+    const size_t count = ring.getReadIovecs(raw);
+    GALAY_TEST_REQUIRE(count == 2);
+    GALAY_TEST_REQUIRE(view.fromIOVec(std::vector<iovec>(raw.begin(), raw.end())).first == kNoError);
+    GALAY_TEST_REQUIRE(view.ownsStorage());
+    GALAY_TEST_REQUIRE(view.find("X-Trace-Id") == "abc-123");
+    return true;
+}
+
+bool testViewErrors()
+{
+    HttpRequestHeaderView view;
+    GALAY_TEST_REQUIRE(view.parse("GET / HTTP/1.1\r\nHost: a\r\n").first == kIncomplete);
+    GALAY_TEST_REQUIRE(!view.isHeaderComplete());
+    GALAY_TEST_REQUIRE(view.parse("GET / HTTP/2.0\r\n\r\n").first == kVersionNotSupport);
+    GALAY_TEST_REQUIRE(view.parse("GET / HTTP/1.1\r\nNoColon\r\n\r\n").first == kBadRequest);
+    GALAY_TEST_REQUIRE(view.parse("GET / HTTP/1.1\r\nContent-Length: 1\r\ncontent-length: 2\r\n\r\n").first == kBadRequest);
+    view.setParseLimits(2, 16, 4);
+    GALAY_TEST_REQUIRE(view.parse("GET /toolong HTTP/1.1\r\n\r\n").first == kUriTooLong);
+    GALAY_TEST_REQUIRE(view.parse("GET / HTTP/1.1\r\nX-Long-Header: value\r\n\r\n").first == kHeaderTooLarge);
+    GALAY_TEST_REQUIRE(view.parse("GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n").first == kHeaderTooLarge);
+    GALAY_TEST_REQUIRE(view.parse("GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\n\r\n").first == kNoError);
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    std::cout << "[T91] active scan kernel: "
+              << detail::headerScanKernelName(detail::activeHeaderScanKernel()) << "\n";
+    if (!testKernelsAgree() ||
+        !testModesAgree() ||
+        !testViewZeroCopyOnMmapRing() ||
+        !testViewCopiesAcrossIovecs() ||
+        !testViewErrors()) {
+        return 1;
+    }
+    std::cout << "T91-HeaderView PASS\n";
+    return 0;
+}
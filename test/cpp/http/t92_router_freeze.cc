@@ -0,0 +1,268 @@
+/**
+ * @file t92_router_freeze.cc
+ * @brief 用途：验证 HttpRouter::freeze() 编译出的压缩基数树与 Trie 查找结果一致。
+ * 关键覆盖点：随机路由表（静态段共享前缀、:param、*、**、非规范精确路由）上
+ * 冻结前后对同一批请求路径返回相同处理器与参数；连续 '/'、结尾 '/' 的请求路径；
+ * 静态分支死路后回溯到参数分支；修改路由自动解冻；冻结后就地填充参数不分配内存。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-http/server/http_router.h>
+#include "test/cpp/common/test_require.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+using namespace galay::http;
+
+namespace {
+
+galay::kernel::Task<void> routeHandler(HttpConn& conn, HttpRequest request)
+{
+    co_return;
+}
+
+struct Observed {
+    HttpRouteHandler* handler = nullptr;
+    std::map<std::string, std::string> params;
+
+    bool operator==(const Observed&) const = default;
+};
+
+Observed observe(HttpRouter& router, HttpMethod method, const std::string& path)
+{
+    auto match = router.findHandler(method, path);
+    return {match.handler, match.params.toMap()};
+}
+
+std::string randomRoute(std::mt19937& rng)
+{
+    static constexpr std::array<const char*, 7> kStatic = {"a", "b", "ab", "abc", "api", "v1", "users"};
+    const size_t depth = 1 + rng() % 4;
+    std::string path;
+    size_t params = 0;
+    for (size_t i = 0; i < depth; ++i) {
+        path.push_back('/');
+        const unsigned kind = rng() % 10;
+        const bool last = i + 1 == depth;
+        if (kind < 3) {
+            path += ":p" + std::to_string(params++);
+        } else if (kind == 3 && last) {
+            path += (rng() % 2 == 0) ? "*" : "**";
+        } else {
+            path += kStatic[rng() % kStatic.size()];
+        }
+    }
+    return path;
+}
+
+std::string randomRequestPath(std::mt19937& rng)
+{
+    static constexpr std::array<const char*, 9> kSegments = {
+        "a", "b", "ab", "abc", "api", "v1", "users", "x", "123"};
+    const size_t depth = rng() % 6;
+    std::string path;
+    for (size_t i = 0; i < depth; ++i) {
+        path += (rng() % 8 == 0) ? "//" : "/";
+        path += kSegments[rng() % kSegments.size()];
+    }
+    if (path.empty() || rng() % 6 == 0) {
+        path.push_back('/');
+    }
+    return path;
+}
+
+bool testRandomTablesAgree()
+{
+    std::mt19937 rng(92);
+    for (int round = 0; round < 40; ++round) {
+        HttpRouter router;
+        for (int i = 0; i < 60; ++i) {
+            const std::string route = randomRoute(rng);
+            if (rng() % 2 == 0) {
+                router.addHandler<HttpMethod::GET>(route, routeHandler);
+            } else {
+                router.addHandler<HttpMethod::GET, HttpMethod::POST>(route, routeHandler);
+            }
+        }
+        router.addHandler<HttpMethod::GET>("/", routeHandler);
+        router.addHandler<HttpMethod::GET>("/docs/", routeHandler);
+        router.addHandler<HttpMethod::GET>("/a//b", routeHandler);
+
+        std::vector<std::string> probes = {"/", "", "/docs/", "/docs", "/a//b", "/a/b", "//"};
+        for (int i = 0; i < 400; ++i) {
+            probes.push_back(randomRequestPath(rng));
+        }
+
+        std::vector<Observed> expected;
+        for (const auto& probe : probes) {
+            expected.push_back(observe(router, HttpMethod::GET, probe));
+            expected.push_back(observe(router, HttpMethod::POST, probe));
+        }
+
+        GALAY_TEST_REQUIRE(!router.isFrozen());
+        GALAY_TEST_REQUIRE(router.freeze());
+        GALAY_TEST_REQUIRE(router.isFrozen());
+
+        size_t index = 0;
+        for (const auto& probe : probes) {
+            const Observed get = observe(router, HttpMethod::GET, probe);
+            const Observed post = observe(router, HttpMethod::POST, probe);
+            if (!(get == expected[index]) || !(post == expected[index + 1])) {
+                std::cerr << "[T92] mismatch round=" << round << " path=\"" << probe << "\"\n";
+                return false;
+            }
+            index += 2;
+        }
+        GALAY_TEST_REQUIRE(observe(router, HttpMethod::DELETE, "/a").handler == nullptr);
+    }
+    return true;
+}
+
+bool testPriorityAndBacktracking()
+{
+    HttpRouter router;
+    router.addHandler<HttpMethod::GET>("/users/list", routeHandler);
+    router.addHandler<HttpMethod::GET>("/users/:id", routeHandler);
+    router.addHandler<HttpMethod::GET>("/users/:id/posts", routeHandler);
+    router.addHandler<HttpMethod::GET>("/users/list/items/:item", routeHandler);
+    router.addHandler<HttpMethod::GET>("/files/**", routeHandler);
+    router.addHandler<HttpMethod::GET>("/static/*", routeHandler);
+    GALAY_TEST_REQUIRE(router.freeze());
+
+    auto exact = router.findHandler(HttpMethod::GET, "/users/list");
+    GALAY_TEST_REQUIRE(exact.handler != nullptr);
+    GALAY_TEST_REQUIRE(exact.params.empty());
+
+    // 静态分支 "list" 走到死路后回溯到 :id
+    auto backtrack = router.findHandler(HttpMethod::GET, "/users/list/posts");
+    GALAY_TEST_REQUIRE(backtrack.handler != nullptr);
+    GALAY_TEST_REQUIRE(backtrack.params.size() == 1);
+    GALAY_TEST_REQUIRE(*backtrack.params.find("id") == "list");
+
+    auto nested = router.findHandler(HttpMethod::GET, "//users/list/items/42/");
+    GALAY_TEST_REQUIRE(nested.handler != nullptr);
+    GALAY_TEST_REQUIRE(*nested.params.find("item") == "42");
+
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/files/a/b/c.txt").handler != nullptr);
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/files").handler == nullptr);
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/static/app.js").handler != nullptr);
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/static/a/b").handler == nullptr);
+    // 精确路由只接受与注册形式完全一致的请求路径
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/users/list/").handler ==
+                       router.findHandler(HttpMethod::GET, "/users/:id").handler);
+    return true;
+}
+
+bool testMutationUnfreezes()
+{
+    HttpRouter router;
+    router.addHandler<HttpMethod::GET>("/a", routeHandler);
+    router.addHandler<HttpMethod::GET>("/a/:id", routeHandler);
+    GALAY_TEST_REQUIRE(router.freeze());
+
+    router.addHandler<HttpMethod::GET>("/b", routeHandler);
+    GALAY_TEST_REQUIRE(!router.isFrozen());
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/b").handler != nullptr);
+
+    GALAY_TEST_REQUIRE(router.freeze());
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/b").handler != nullptr);
+    GALAY_TEST_REQUIRE(router.delHandler(HttpMethod::GET, "/b"));
+    GALAY_TEST_REQUIRE(!router.isFrozen());
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/b").handler == nullptr);
+
+    GALAY_TEST_REQUIRE(router.freeze());
+    router.clear();
+    GALAY_TEST_REQUIRE(!router.isFrozen());
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/a/1").handler == nullptr);
+
+    // 参数过多的路由保持 Trie 查找
+    std::string wide;
+    for (size_t i = 0; i <= HttpRouter::kMaxFrozenRouteParams; ++i) {
+        wide += "/:p" + std::to_string(i);
+    }
+    router.addHandler<HttpMethod::GET>(wide, routeHandler);
+    GALAY_TEST_REQUIRE(!router.freeze());
+    GALAY_TEST_REQUIRE(!router.isFrozen());
+    return true;
+}
+
+bool testFrozenMatchDoesNotAllocate()
+{
+    HttpRouter router;
+    router.addHandler<HttpMethod::GET>("/api/v1/users", routeHandler);
+    router.addHandler<HttpMethod::GET>("/api/v1/users/:userId/orders/:orderId", routeHandler);
+    router.addHandler<HttpMethod::GET>("/assets/**", routeHandler);
+    GALAY_TEST_REQUIRE(router.freeze());
+
+    const std::array<std::string, 4> paths = {
+        "/api/v1/users",
+        "/api/v1/users/alice/orders/20261017",
+        "/api/v1/users//bob/orders/7/",
+        "/assets/css/site.css",
+    };
+    RouteParams params;
+    for (const auto& path : paths) {
+        GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, path, params) != nullptr);
+    }
+
+    const size_t before = g_allocations.load(std::memory_order_relaxed);
+    size_t checksum = 0;
+    for (int i = 0; i < 1000; ++i) {
+        const std::string& path = paths[static_cast<size_t>(i) % paths.size()];
+        checksum += router.findHandler(HttpMethod::GET, path, params) != nullptr ? 1 : 0;
+        checksum += params.size();
+    }
+    const size_t allocations = g_allocations.load(std::memory_order_relaxed) - before;
+    GALAY_TEST_REQUIRE(checksum == 1000 + 1000);
+    GALAY_TEST_REQUIRE(allocations == 0);
+
+    GALAY_TEST_REQUIRE(router.findHandler(HttpMethod::GET, "/api/v1/users//bob/orders/7/", params) != nullptr);
+    GALAY_TEST_REQUIRE(*params.find("userId") == "bob");
+    GALAY_TEST_REQUIRE(*params.find("orderId") == "7");
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    if (!testRandomTablesAgree() ||
+        !testPriorityAndBacktracking() ||
+        !testMutationUnfreezes() ||
+        !testFrozenMatchDoesNotAllocate()) {
+        return 1;
+    }
+    std::cout << "T92-RouterFreeze PASS\n";
+    return 0;
+}
@@ -0,0 +1,382 @@
+/**
+ * @file t93_static_file_cache.cc
+ * @brief 用途：验证 StaticFileSetting::setEnableCache 打开的静态文件内存缓存。
+ * 关键覆盖点：分片 LRU 淘汰与容量上限、读文件期间本条目路径失效时拒绝插入而无关路径不影响插入、
+ * 按真实路径 / 链接路径失效；
+ * 通过 mount / mountHardly 真实起服务：命中后 200 / HEAD / 单范围 206 / If-None-Match 304
+ * 的响应与不经缓存时一致，文件被修改或在新建子目录中出现后 inotify 监听使缓存失效。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-http/server/http_router.h>
+#include <galay/cpp/galay-http/server/http_server.h>
+#include <galay/cpp/galay-http/server/static_file_cache.h>
+#include "test/cpp/common/test_require.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <netinet/in.h>
+#include <signal.h>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace galay::http;
+using namespace std::chrono_literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+void alarmHandler(int)
+{
+    std::cerr << "[T93] timeout\n";
+    ::_exit(2);
+}
+
+StaticFileCache::EntryPtr makeEntry(const std::string& filePath, size_t bodySize)
+{
+    auto entry = std::make_shared<StaticFileCacheEntry>();
+    entry->filePath = filePath;
+    entry->linkPath = filePath;
+    entry->body.assign(bodySize, 'x');
+    return entry;
+}
+
+uint64_t generationOf(const StaticFileCache& cache, const StaticFileCache::EntryPtr& entry)
+{
+    return cache.generation(entry->filePath, entry->linkPath);
+}
+
+bool insertFresh(StaticFileCache& cache, std::string key, const StaticFileCache::EntryPtr& entry)
+{
+    return cache.insert(std::move(key), entry, generationOf(cache, entry));
+}
+
+bool testLruAndCapacity()
+{
+    // 每个分片 2048 字节，约可容纳 6 个 300 字节的条目
+    StaticFileCache cache("/srv", StaticFileCache::kShardCount * 2048);
+    GALAY_TEST_REQUIRE(cache.admits(1024));
+    GALAY_TEST_REQUIRE(!cache.admits(4096));
+    GALAY_TEST_REQUIRE(!insertFresh(cache, "huge", makeEntry("/srv/huge", 4096)));
+
+    GALAY_TEST_REQUIRE(insertFresh(cache, "cold", makeEntry("/srv/cold", 300)));
+    GALAY_TEST_REQUIRE(insertFresh(cache, "hot", makeEntry("/srv/hot", 300)));
+    for (int i = 0; i < 600; ++i) {
+        const std::string key = "file" + std::to_string(i);
+        GALAY_TEST_REQUIRE(insertFresh(cache, key, makeEntry("/srv/" + key, 300)));
+        GALAY_TEST_REQUIRE(cache.find("hot") != nullptr);
+    }
+
+    const StaticFileCacheStats stats = cache.stats();
+    GALAY_TEST_REQUIRE(stats.evictions > 0);
+    GALAY_TEST_REQUIRE(stats.bytes <= cache.maxBytes());
+    GALAY_TEST_REQUIRE(stats.entries < 602);
+    GALAY_TEST_REQUIRE(cache.find("cold") == nullptr);
+    auto hot = cache.find("hot");
+    GALAY_TEST_REQUIRE(hot != nullptr && hot->filePath == "/srv/hot");
+
+    // 同键替换不重复计费
+    const size_t before = cache.stats().bytes;
+    GALAY_TEST_REQUIRE(insertFresh(cache, "hot", makeEntry("/srv/hot", 300)));
+    GALAY_TEST_REQUIRE(cache.stats().bytes == before);
+    return true;
+}
+
+bool testGenerationAndInvalidation()
+{
+    StaticFileCache cache("/srv", 1 << 20);
+
+    // 读文件期间本条目的路径失效：插入被拒绝
+    auto stale = makeEntry("/srv/a", 10);
+    uint64_t generation = generationOf(cache, stale);
+    GALAY_TEST_REQUIRE(cache.invalidate("/srv/a") == 0);
+    GALAY_TEST_REQUIRE(!cache.insert("a", stale, generation));
+    GALAY_TEST_REQUIRE(cache.find("a") == nullptr);
+    GALAY_TEST_REQUIRE(cache.stats().rejections == 1);
+
+    // 链接路径失效同样拒绝
+    auto via_link = std::make_shared<StaticFileCacheEntry>();
+    via_link->filePath = "/data/real.txt";
+    via_link->linkPath = "/srv/alias.txt";
+    generation = generationOf(cache, via_link);
+    GALAY_TEST_REQUIRE(cache.invalidate("/srv/alias.txt") == 0);
+    GALAY_TEST_REQUIRE(!cache.insert("alias.txt", via_link, generation));
+    GALAY_TEST_REQUIRE(cache.stats().rejections == 2);
+
+    // 其它路径持续变更（日志、上传）不影响本条目插入：路径代数按分片划分，
+    // 落在同一路径分片的变更才会让插入重试
+    bool inserted_under_churn = false;
+    for (int i = 0; i < 64 && !inserted_under_churn; ++i) {
+        auto fresh = makeEntry("/srv/a", 10);
+        generation = generationOf(cache, fresh);
+        GALAY_TEST_REQUIRE(cache.invalidate("/srv/logs/access" + std::to_string(i) + ".log") == 0);
+        if (generationOf(cache, fresh) == generation) {
+            GALAY_TEST_REQUIRE(cache.insert("a", fresh, generation));
+            inserted_under_churn = true;
+        }
+    }
+    GALAY_TEST_REQUIRE(inserted_under_churn);
+    GALAY_TEST_REQUIRE(cache.invalidate("/srv/a") == 1);
+    GALAY_TEST_REQUIRE(cache.find("a") == nullptr);
+
+    // 同一文件可能以多个键缓存（"a" 与 "./a"），按路径失效时全部移除
+    GALAY_TEST_REQUIRE(insertFresh(cache, "a", makeEntry("/srv/a", 10)));
+    GALAY_TEST_REQUIRE(insertFresh(cache, "./a", makeEntry("/srv/a", 10)));
+    auto linked = std::make_shared<StaticFileCacheEntry>();
+    linked->filePath = "/data/target.txt";
+    linked->linkPath = "/srv/link.txt";
+    linked->body = "target";
+    GALAY_TEST_REQUIRE(insertFresh(cache, "link.txt", linked));
+    GALAY_TEST_REQUIRE(cache.invalidate("/srv/a") == 2);
+    GALAY_TEST_REQUIRE(cache.find("a") == nullptr);
+    GALAY_TEST_REQUIRE(cache.find("./a") == nullptr);
+    GALAY_TEST_REQUIRE(cache.find("link.txt") != nullptr);
+
+    // 符号链接本身被替换时按链接路径失效
+    GALAY_TEST_REQUIRE(cache.invalidate("/srv/link.txt") == 1);
+    GALAY_TEST_REQUIRE(cache.find("link.txt") == nullptr);
+
+    GALAY_TEST_REQUIRE(insertFresh(cache, "b", makeEntry("/srv/b", 10)));
+    cache.invalidateAll();
+    GALAY_TEST_REQUIRE(cache.find("b") == nullptr);
+    GALAY_TEST_REQUIRE(cache.stats().entries == 0);
+    GALAY_TEST_REQUIRE(cache.stats().bytes == 0);
+    return true;
+}
+
+// ==================== 真实服务 ====================
+
+uint16_t pickFreePort()
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    uint16_t port = 0;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    ::close(fd);
+    return port;
+}
+
+std::string roundTrip(uint16_t port, const std::string& request)
+{
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return {};
+        }
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            std::this_thread::sleep_for(20ms);
+            continue;
+        }
+        timeval timeout{};
+        timeout.tv_sec = 2;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        size_t sent = 0;
+        while (sent < request.size()) {
+            const ssize_t n = ::send(fd, request.data() + sent, request.size() - sent, 0);
+            if (n <= 0) {
+                ::close(fd);
+                return {};
+            }
+            sent += static_cast<size_t>(n);
+        }
+        std::string response;
+        char buffer[8192];
+        while (true) {
+            const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                break;
+            }
+            response.append(buffer, static_cast<size_t>(n));
+        }
+        ::close(fd);
+        return response;
+    }
+    return {};
+}
+
+std::string request(const std::string& method, const std::string& path, const std::string& extra = "")
+{
+    return method + " " + path + " HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n" + extra + "\r\n";
+}
+
+std::string bodyOf(const std::string& response)
+{
+    const size_t end = response.find("\r\n\r\n");
+    return end == std::string::npos ? std::string() : response.substr(end + 4);
+}
+
+std::string headerValue(const std::string& response, const std::string& name)
+{
+    const size_t pos = response.find(name + ": ");
+    if (pos == std::string::npos) {
+        return {};
+    }
+    const size_t begin = pos + name.size() + 2;
+    return response.substr(begin, response.find("\r\n", begin) - begin);
+}
+
+void writeFile(const fs::path& path, const std::string& content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+// 监听协程在第一个请求时才启动，就绪前的请求不经缓存
+bool waitForHit(uint16_t port, const std::string& path, const std::string& expected,
+                const std::shared_ptr<const StaticFileCache>& cache)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (std::chrono::steady_clock::now() < deadline) {
+        const uint64_t hits = cache->stats().hits;
+        const std::string response = roundTrip(port, request("GET", path));
+        if (bodyOf(response) != expected) {
+            std::cerr << "[T93] unexpected response for " << path << ":\n" << response << "\n";
+            return false;
+        }
+        if (cache->stats().hits > hits) {
+            return true;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+    return false;
+}
+
+bool waitForBody(uint16_t port, const std::string& path, const std::string& expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (bodyOf(roundTrip(port, request("GET", path))) == expected) {
+            return true;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+    return false;
+}
+
+bool testServedFromCache()
+{
+    const fs::path dir = fs::temp_directory_path() / ("galay_t93_static_cache_" + std::to_string(::getpid()));
+    fs::remove_all(dir);
+    fs::create_directories(dir / "hard");
+    writeFile(dir / "a.txt", "hello-v1");
+    writeFile(dir / "hard" / "b.txt", "hard-v1");
+
+    StaticFileSetting setting;
+    setting.setEnableCache(true);
+    setting.setMaxCacheSize(1 << 20);
+
+    StaticFileSetting uncached;
+    uncached.setEnableCache(false);
+
+    HttpRouter router;
+    router.mount("/static", dir.string(), setting);
+    router.mount("/raw", dir.string(), uncached);
+    router.mountHardly("/hard", (dir / "hard").string(), setting);
+    const auto caches = router.staticFileCaches();
+    GALAY_TEST_REQUIRE(caches.size() == 2);
+
+    const uint16_t port = pickFreePort();
+    GALAY_TEST_REQUIRE(port != 0);
+    auto server = HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(1)
+        .build();
+    server.start(std::move(router));
+
+    bool ok = [&]() {
+        GALAY_TEST_REQUIRE(waitForHit(port, "/static/a.txt", "hello-v1", caches[0]));
+        GALAY_TEST_REQUIRE(waitForHit(port, "/hard/b.txt", "hard-v1", caches[1]));
+
+        // 命中响应与不经缓存的响应逐字节一致
+        GALAY_TEST_REQUIRE(roundTrip(port, request("GET", "/static/a.txt")) ==
+                           roundTrip(port, request("GET", "/raw/a.txt")));
+        GALAY_TEST_REQUIRE(roundTrip(port, request("HEAD", "/static/a.txt")) ==
+                           roundTrip(port, request("HEAD", "/raw/a.txt")));
+        const std::string range = "Range: bytes=1-4\r\n";
+        const std::string partial = roundTrip(port, request("GET", "/static/a.txt", range));
+        GALAY_TEST_REQUIRE(partial.rfind("HTTP/1.1 206", 0) == 0);
+        GALAY_TEST_REQUIRE(bodyOf(partial) == "ello");
+        GALAY_TEST_REQUIRE(headerValue(partial, "content-range") == "bytes 1-4/8");
+        GALAY_TEST_REQUIRE(partial == roundTrip(port, request("GET", "/raw/a.txt", range)));
+
+        const std::string etag = headerValue(roundTrip(port, request("GET", "/static/a.txt")), "etag");
+        GALAY_TEST_REQUIRE(!etag.empty());
+        const std::string notModified =
+            roundTrip(port, request("GET", "/static/a.txt", "If-None-Match: " + etag + "\r\n"));
+        GALAY_TEST_REQUIRE(notModified.rfind("HTTP/1.1 304", 0) == 0);
+
+        // 修改文件后监听使缓存失效，随后重新填充
+        const uint64_t invalidations = caches[0]->stats().invalidations;
+        writeFile(dir / "a.txt", "hello-v2-longer");
+        GALAY_TEST_REQUIRE(waitForBody(port, "/static/a.txt", "hello-v2-longer"));
+        GALAY_TEST_REQUIRE(caches[0]->stats().invalidations > invalidations);
+        GALAY_TEST_REQUIRE(waitForHit(port, "/static/a.txt", "hello-v2-longer", caches[0]));
+
+        // 新建子目录中的文件同样被监听
+        fs::create_directories(dir / "sub");
+        writeFile(dir / "sub" / "c.txt", "sub-v1");
+        GALAY_TEST_REQUIRE(waitForHit(port, "/static/sub/c.txt", "sub-v1", caches[0]));
+        writeFile(dir / "sub" / "c.txt", "sub-v2");
+        GALAY_TEST_REQUIRE(waitForBody(port, "/static/sub/c.txt", "sub-v2"));
+
+        // 删除后不再返回旧内容
+        fs::remove(dir / "sub" / "c.txt");
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        bool gone = false;
+        while (!gone && std::chrono::steady_clock::now() < deadline) {
+            gone = roundTrip(port, request("GET", "/static/sub/c.txt")).rfind("HTTP/1.1 404", 0) == 0;
+            std::this_thread::sleep_for(10ms);
+        }
+        GALAY_TEST_REQUIRE(gone);
+
+        writeFile(dir / "hard" / "b.txt", "hard-v2");
+        GALAY_TEST_REQUIRE(waitForBody(port, "/hard/b.txt", "hard-v2"));
+        return true;
+    }();
+
+    server.stop();
+    fs::remove_all(dir);
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    ::signal(SIGALRM, alarmHandler);
+    ::alarm(30);
+    if (!testLruAndCapacity() ||
+        !testGenerationAndInvalidation() ||
+        !testServedFromCache()) {
+        return 1;
+    }
+    ::alarm(0);
+    std::cout << "T93-StaticFileCache PASS\n";
+    return 0;
+}
@@ -0,0 +1,383 @@
+/**
+ * @file t94_proxy_upstream.cc
+ * @brief 用途：验证 HttpRouter::proxy 的多上游负载均衡、被动健康检查与 keep-alive 上游连接池。
+ * 关键覆盖点：ProxyUpstreamGroup 的轮询 / 平滑加权轮询 / 一致性哈希选择、连续失败摘除与超时后探测恢复、
+ * 一致性哈希预建环与 utils::ConsistentHash 映射一致、全部摘除时仍返回上游；真实起两个上游与一个代理：请求按轮询分摊到两个上游且复用少量上游连接，
+ * 组内有无人监听的上游时请求全部改投可用上游。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-http/server/http_router.h>
+#include <galay/cpp/galay-http/server/http_server.h>
+#include <galay/cpp/galay-http/server/proxy_upstream.h>
+#include <galay/cpp/galay-http/builder/http_builder.h>
+#include "test/cpp/common/test_require.h"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <set>
+#include <signal.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace galay::http;
+using namespace std::chrono_literals;
+
+namespace {
+
+void alarmHandler(int)
+{
+    std::cerr << "[T94] timeout\n";
+    ::_exit(2);
+}
+
+std::vector<ProxyUpstream> threeUpstreams()
+{
+    return {{"10.0.0.1", 80, 1}, {"10.0.0.2", 80, 1}, {"10.0.0.3", 80, 1}};
+}
+
+bool testRoundRobin()
+{
+    ProxyUpstreamGroup group(threeUpstreams());
+    GALAY_TEST_REQUIRE(group.size() == 3);
+    GALAY_TEST_REQUIRE(group.upstreamKey(1) == "10.0.0.2:80");
+
+    std::map<size_t, int> counts;
+    for (int i = 0; i < 30; ++i) {
+        auto index = group.select("");
+        GALAY_TEST_REQUIRE(index.has_value());
+        ++counts[*index];
+        group.reportSuccess(*index);
+    }
+    GALAY_TEST_REQUIRE(counts.size() == 3);
+    GALAY_TEST_REQUIRE(counts[0] == 10 && counts[1] == 10 && counts[2] == 10);
+    return true;
+}
+
+bool testWeighted()
+{
+    ProxyUpstreamSetting setting;
+    setting.strategy = ProxyBalanceStrategy::Weighted;
+    ProxyUpstreamGroup group({{"10.0.0.1", 80, 3}, {"10.0.0.2", 80, 1}}, setting);
+
+    std::map<size_t, int> counts;
+    for (int i = 0; i < 40; ++i) {
+        auto index = group.select("");
+        GALAY_TEST_REQUIRE(index.has_value());
+        ++counts[*index];
+        group.reportSuccess(*index);
+    }
+    GALAY_TEST_REQUIRE(counts[0] == 30);
+    GALAY_TEST_REQUIRE(counts[1] == 10);
+    return true;
+}
+
+bool testConsistentHash()
+{
+    ProxyUpstreamSetting setting;
+    setting.strategy = ProxyBalanceStrategy::ConsistentHash;
+    setting.hashHeader = "X-User";
+    ProxyUpstreamGroup group(threeUpstreams(), setting);
+
+    // 同一键始终落到同一上游，重试时顺延到另一个上游
+    auto first = group.select("user-42");
+    GALAY_TEST_REQUIRE(first.has_value());
+    for (int i = 0; i < 10; ++i) {
+        GALAY_TEST_REQUIRE(group.select("user-42") == first);
+    }
+    auto next = group.select("user-42", 1);
+    GALAY_TEST_REQUIRE(next.has_value() && *next != *first);
+
+    std::set<size_t> spread;
+    for (int i = 0; i < 200; ++i) {
+        auto index = group.select("user-" + std::to_string(i));
+        GALAY_TEST_REQUIRE(index.has_value());
+        spread.insert(*index);
+    }
+    GALAY_TEST_REQUIRE(spread.size() == 3);
+
+    // 构造时预建的环与 galay::utils::ConsistentHash 映射一致，含重试顺延
+    galay::utils::ConsistentHash reference;
+    const auto upstreams = threeUpstreams();
+    for (size_t i = 0; i < upstreams.size(); ++i) {
+        reference.addNode({std::to_string(i), "", static_cast<int>(upstreams[i].weight)});
+    }
+    ProxyUpstreamGroup fresh(threeUpstreams(), setting);
+    for (int i = 0; i < 200; ++i) {
+        const std::string key = "user-" + std::to_string(i);
+        for (size_t attempt = 0; attempt < upstreams.size(); ++attempt) {
+            const auto nodes = reference.getNodes(key, attempt + 1);
+            GALAY_TEST_REQUIRE(nodes.size() == attempt + 1);
+            GALAY_TEST_REQUIRE(fresh.select(key, attempt) == std::optional<size_t>(std::stoul(nodes.back().id)));
+        }
+    }
+
+    // 首选上游被摘除后改投其它上游
+    for (size_t i = 0; i < setting.maxFails; ++i) {
+        group.reportFailure(*first);
+    }
+    GALAY_TEST_REQUIRE(group.isEjected(*first));
+    auto fallback = group.select("user-42");
+    GALAY_TEST_REQUIRE(fallback.has_value() && *fallback != *first);
+    return true;
+}
+
+bool testEjectionAndRecovery()
+{
+    ProxyUpstreamSetting setting;
+    setting.maxFails = 2;
+    setting.failTimeout = 1s;
+    ProxyUpstreamGroup group({{"10.0.0.1", 80, 1}, {"10.0.0.2", 80, 1}}, setting);
+
+    group.reportFailure(0);
+    GALAY_TEST_REQUIRE(!group.isEjected(0));
+    group.reportSuccess(0);
+    group.reportFailure(0);
+    GALAY_TEST_REQUIRE(!group.isEjected(0));
+    group.reportFailure(0);
+    GALAY_TEST_REQUIRE(group.isEjected(0));
+
+    for (int i = 0; i < 10; ++i) {
+        auto index = group.select("");
+        GALAY_TEST_REQUIRE(index == std::optional<size_t>(1));
+        group.reportSuccess(1);
+    }
+
+    // 全部摘除时仍返回上游，不让整组流量直接失败
+    group.reportFailure(1);
+    group.reportFailure(1);
+    GALAY_TEST_REQUIRE(group.isEjected(1));
+    GALAY_TEST_REQUIRE(group.select("").has_value());
+
+    // 超时后放行一个探测请求，探测成功即恢复
+    std::this_thread::sleep_for(1100ms);
+    bool probed = false;
+    for (int i = 0; i < 4 && !probed; ++i) {
+        auto index = group.select("");
+        GALAY_TEST_REQUIRE(index.has_value());
+        if (*index == 0) {
+            probed = true;
+        }
+        group.reportSuccess(*index);
+    }
+    GALAY_TEST_REQUIRE(probed);
+    GALAY_TEST_REQUIRE(!group.isEjected(0));
+    return true;
+}
+
+uint16_t pickFreePort()
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    uint16_t port = 0;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    ::close(fd);
+    return port;
+}
+
+std::string roundTrip(uint16_t port, const std::string& path)
+{
+    const std::string request =
+        "GET " + path + " HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n";
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return {};
+        }
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            std::this_thread::sleep_for(20ms);
+            continue;
+        }
+        timeval timeout{};
+        timeout.tv_sec = 3;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        size_t sent = 0;
+        while (sent < request.size()) {
+            const ssize_t n = ::send(fd, request.data() + sent, request.size() - sent, 0);
+            if (n <= 0) {
+                ::close(fd);
+                return {};
+            }
+            sent += static_cast<size_t>(n);
+        }
+        std::string response;
+        char buffer[4096];
+        while (true) {
+            const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                break;
+            }
+            response.append(buffer, static_cast<size_t>(n));
+            // 代理转发上游的 keep-alive 响应，读到完整响应体即可
+            const size_t end = response.find("\r\n\r\n");
+            if (end != std::string::npos && response.size() >= end + 4 + 1) {
+                break;
+            }
+        }
+        ::close(fd);
+        return response;
+    }
+    return {};
+}
+
+std::string bodyOf(const std::string& response)
+{
+    const size_t end = response.find("\r\n\r\n");
+    return end == std::string::npos ? std::string() : response.substr(end + 4);
+}
+
+/**
+ * @brief 上游服务：响应体为自身名字，并记录每个请求所在连接的对端端口
+ */
+struct Upstream {
+    std::string name;
+    uint16_t port = 0;
+    std::mutex mutex;
+    std::set<uint16_t> peers;
+    size_t requests = 0;
+    std::unique_ptr<HttpServer> server;
+
+    void start()
+    {
+        HttpRouter router;
+        auto handler = [this](HttpConn& conn, HttpRequest) -> Task<void> {
+            sockaddr_in peer{};
+            socklen_t len = sizeof(peer);
+            if (::getpeername(conn.getSocket().handle().fd, reinterpret_cast<sockaddr*>(&peer), &len) == 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                peers.insert(ntohs(peer.sin_port));
+                ++requests;
+            }
+            auto response = Http1_1ResponseBuilder::ok().text(name).buildMove();
+            auto writer = conn.getWriter();
+            while (true) {
+                auto result = co_await writer.sendResponse(response);
+                if (!result || result.value()) {
+                    break;
+                }
+            }
+            co_return;
+        };
+        router.addHandler<HttpMethod::GET>("/**", handler);
+        server = std::make_unique<HttpServer>(HttpServerBuilder()
+            .host("127.0.0.1")
+            .port(port)
+            .ioSchedulerCount(1)
+            .computeSchedulerCount(1)
+            .buildConfig());
+        server->start(std::move(router));
+    }
+
+    size_t connections()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return peers.size();
+    }
+
+    size_t requestCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return requests;
+    }
+};
+
+bool testProxyBalancesAndPools()
+{
+    Upstream a;
+    Upstream b;
+    a.name = "A";
+    b.name = "B";
+    a.port = pickFreePort();
+    b.port = pickFreePort();
+    const uint16_t deadPort = pickFreePort();
+    const uint16_t port = pickFreePort();
+    GALAY_TEST_REQUIRE(a.port != 0 && b.port != 0 && deadPort != 0 && port != 0);
+    a.start();
+    b.start();
+
+    HttpRouter router;
+    router.proxy("/api",
+                 {{"127.0.0.1", a.port, 1}, {"127.0.0.1", b.port, 1}},
+                 ProxyUpstreamSetting());
+    router.proxy("/mixed", {{"127.0.0.1", deadPort, 1}, {"127.0.0.1", a.port, 1}});
+    HttpServer proxy = HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(1)
+        .build();
+    proxy.start(std::move(router));
+
+    bool ok = [&]() {
+        std::map<std::string, int> bodies;
+        for (int i = 0; i < 40; ++i) {
+            const std::string response = roundTrip(port, "/api/item");
+            GALAY_TEST_REQUIRE(response.rfind("HTTP/1.1 200", 0) == 0);
+            ++bodies[bodyOf(response)];
+        }
+        GALAY_TEST_REQUIRE(bodies["A"] == 20);
+        GALAY_TEST_REQUIRE(bodies["B"] == 20);
+        // 顺序请求下每个上游只需要一条连接
+        GALAY_TEST_REQUIRE(a.connections() <= 2);
+        GALAY_TEST_REQUIRE(b.connections() <= 2);
+
+        // 无人监听的上游连接被拒：请求改投 A，不向客户端暴露 502
+        const size_t before = a.requestCount();
+        for (int i = 0; i < 20; ++i) {
+            const std::string response = roundTrip(port, "/mixed/item");
+            GALAY_TEST_REQUIRE(response.rfind("HTTP/1.1 200", 0) == 0);
+            GALAY_TEST_REQUIRE(bodyOf(response) == "A");
+        }
+        GALAY_TEST_REQUIRE(a.requestCount() - before == 20);
+        GALAY_TEST_REQUIRE(a.connections() <= 2);
+        return true;
+    }();
+
+    proxy.stop();
+    a.server->stop();
+    b.server->stop();
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    ::signal(SIGALRM, alarmHandler);
+    ::alarm(30);
+    if (!testRoundRobin() ||
+        !testWeighted() ||
+        !testConsistentHash() ||
+        !testEjectionAndRecovery() ||
+        !testProxyBalancesAndPools()) {
+        return 1;
+    }
+    ::alarm(0);
+    std::cout << "T94-ProxyUpstream PASS\n";
+    return 0;
+}
@@ -0,0 +1,326 @@
+/**
+ * @file t95_connect_tunnel.cc
+ * @brief 用途：验证 HttpRouter::connectTunnel 的 CONNECT 隧道与 ProxyMode::Raw 的 splice 回包透传。
+ * 关键覆盖点：CONNECT 建立隧道后回复 200，紧随 CONNECT 的首包被转发到目标，
+ * 双向透传 2 MiB 数据且内容一致，客户端半关闭后隧道收尾并关闭连接；
+ * 目标端口不在白名单返回 403；Raw 模式代理把 4 MiB 上游响应原样转发给客户端。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-http/server/http_router.h>
+#include <galay/cpp/galay-http/server/http_server.h>
+#include "test/cpp/common/test_require.h"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <iostream>
+#include <netinet/in.h>
+#include <signal.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace galay::http;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t kTunnelPayloadSize = 2 * 1024 * 1024;
+constexpr size_t kRawBodySize = 4 * 1024 * 1024;
+
+void alarmHandler(int)
+{
+    std::cerr << "[T95] timeout\n";
+    ::_exit(2);
+}
+
+uint16_t pickFreePort()
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    uint16_t port = 0;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    ::close(fd);
+    return port;
+}
+
+std::string pattern(size_t size, size_t seed)
+{
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<char>('a' + (i * 7 + seed) % 26);
+    }
+    return data;
+}
+
+int listenLoopback(uint16_t port)
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    const int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 16) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int connectLoopback(uint16_t port)
+{
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            timeval timeout{};
+            timeout.tv_sec = 5;
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(20ms);
+    }
+    return -1;
+}
+
+bool sendAll(int fd, const char* data, size_t size)
+{
+    size_t sent = 0;
+    while (sent < size) {
+        const ssize_t n = ::send(fd, data + sent, size - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// 读到响应头结束；头之后多读到的字节留在 rest 中
+std::string recvHead(int fd, std::string& rest)
+{
+    std::string data;
+    char buffer[4096];
+    while (true) {
+        const size_t end = data.find("\r\n\r\n");
+        if (end != std::string::npos) {
+            rest = data.substr(end + 4);
+            return data.substr(0, end + 4);
+        }
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return {};
+        }
+        data.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+bool recvExactly(int fd, std::string& out, size_t size)
+{
+    char buffer[64 * 1024];
+    while (out.size() < size) {
+        const size_t want = std::min(sizeof(buffer), size - out.size());
+        const ssize_t n = ::recv(fd, buffer, want, 0);
+        if (n <= 0) {
+            return false;
+        }
+        out.append(buffer, static_cast<size_t>(n));
+    }
+    return true;
+}
+
+void recvToEof(int fd, std::string& out)
+{
+    char buffer[64 * 1024];
+    while (true) {
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return;
+        }
+        out.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+/**
+ * @brief 隧道目标：接受一条连接，原样回显直到对端半关闭，然后关闭
+ */
+void echoOnce(int listen_fd)
+{
+    const int fd = ::accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+        return;
+    }
+    char buffer[64 * 1024];
+    while (true) {
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0 || !sendAll(fd, buffer, static_cast<size_t>(n))) {
+            break;
+        }
+    }
+    ::close(fd);
+}
+
+/**
+ * @brief Raw 代理上游：接受一条连接，读完请求头后写出 kRawBodySize 字节的响应并关闭
+ */
+void rawUpstreamOnce(int listen_fd, const std::string& body)
+{
+    const int fd = ::accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+        return;
+    }
+    std::string rest;
+    if (!recvHead(fd, rest).empty()) {
+        const std::string head = "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n"
+                                 "Content-Length: " + std::to_string(body.size()) +
+                                 "\r\nConnection: close\r\n\r\n";
+        if (sendAll(fd, head.data(), head.size())) {
+            (void)sendAll(fd, body.data(), body.size());
+        }
+    }
+    ::close(fd);
+}
+
+bool testTunnel(uint16_t port, uint16_t target_port)
+{
+    const int fd = connectLoopback(port);
+    GALAY_TEST_REQUIRE(fd >= 0);
+
+    const std::string target = "127.0.0.1:" + std::to_string(target_port);
+    const std::string request = "CONNECT " + target + " HTTP/1.1\r\nHost: " + target + "\r\n\r\nearly";
+    GALAY_TEST_REQUIRE(sendAll(fd, request.data(), request.size()));
+
+    std::string echoed;
+    const std::string head = recvHead(fd, echoed);
+    GALAY_TEST_REQUIRE(head.rfind("HTTP/1.1 200", 0) == 0);
+    GALAY_TEST_REQUIRE(recvExactly(fd, echoed, 5));
+    GALAY_TEST_REQUIRE(echoed == "early");
+
+    const std::string payload = pattern(kTunnelPayloadSize, 3);
+    bool sent = false;
+    std::thread sender([&] {
+        sent = sendAll(fd, payload.data(), payload.size());
+        ::shutdown(fd, SHUT_WR);
+    });
+    std::string received;
+    const bool got = recvExactly(fd, received, payload.size());
+    sender.join();
+    std::string tail;
+    recvToEof(fd, tail);
+    ::close(fd);
+
+    GALAY_TEST_REQUIRE(sent);
+    GALAY_TEST_REQUIRE(got);
+    GALAY_TEST_REQUIRE(received == payload);
+    GALAY_TEST_REQUIRE(tail.empty());
+    return true;
+}
+
+bool testTunnelDenied(uint16_t port, uint16_t denied_port)
+{
+    const int fd = connectLoopback(port);
+    GALAY_TEST_REQUIRE(fd >= 0);
+    const std::string target = "127.0.0.1:" + std::to_string(denied_port);
+    const std::string request = "CONNECT " + target + " HTTP/1.1\r\nHost: " + target +
+                                "\r\nConnection: close\r\n\r\n";
+    GALAY_TEST_REQUIRE(sendAll(fd, request.data(), request.size()));
+    std::string rest;
+    const std::string head = recvHead(fd, rest);
+    ::close(fd);
+    GALAY_TEST_REQUIRE(head.rfind("HTTP/1.1 403", 0) == 0);
+    return true;
+}
+
+bool testRawProxy(uint16_t port, const std::string& body)
+{
+    const int fd = connectLoopback(port);
+    GALAY_TEST_REQUIRE(fd >= 0);
+    const std::string request = "GET /raw/big HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n";
+    GALAY_TEST_REQUIRE(sendAll(fd, request.data(), request.size()));
+    std::string received;
+    const std::string head = recvHead(fd, received);
+    recvToEof(fd, received);
+    ::close(fd);
+    GALAY_TEST_REQUIRE(head.rfind("HTTP/1.1 200", 0) == 0);
+    GALAY_TEST_REQUIRE(head.find("Content-Length: " + std::to_string(body.size())) != std::string::npos);
+    GALAY_TEST_REQUIRE(received.size() == body.size());
+    GALAY_TEST_REQUIRE(received == body);
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    ::signal(SIGALRM, alarmHandler);
+    ::signal(SIGPIPE, SIG_IGN);
+    ::alarm(30);
+
+    const uint16_t echo_port = pickFreePort();
+    const uint16_t raw_port = pickFreePort();
+    const uint16_t port = pickFreePort();
+    const int echo_fd = listenLoopback(echo_port);
+    const int raw_fd = listenLoopback(raw_port);
+    if (echo_fd < 0 || raw_fd < 0 || port == 0) {
+        std::cerr << "[T95] listen failed\n";
+        return 1;
+    }
+
+    const std::string raw_body = pattern(kRawBodySize, 11);
+    std::thread echo_thread(echoOnce, echo_fd);
+    std::thread raw_thread(rawUpstreamOnce, raw_fd, std::cref(raw_body));
+
+    HttpRouter router;
+    ConnectTunnelSetting setting;
+    setting.allowedHosts = {"127.0.0.1"};
+    setting.allowedPorts = {echo_port};
+    router.connectTunnel(setting);
+    router.proxy("/raw", "127.0.0.1", raw_port, ProxyMode::Raw);
+    HttpServer server = HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(1)
+        .build();
+    server.start(std::move(router));
+
+    const bool ok = testTunnel(port, echo_port) &&
+                    testTunnelDenied(port, raw_port) &&
+                    testRawProxy(port, raw_body);
+
+    server.stop();
+    echo_thread.join();
+    raw_thread.join();
+    ::close(echo_fd);
+    ::close(raw_fd);
+    if (!ok) {
+        return 1;
+    }
+    ::alarm(0);
+    std::cout << "T95-ConnectTunnel PASS\n";
+    return 0;
+}
@@ -0,0 +1,452 @@
+/**
+ * @file t96_compression.cc
+ * @brief 用途：验证响应压缩的协商、HttpWriter 压缩阶段与静态文件的预压缩 / 压缩变体缓存。
+ * 关键覆盖点：Accept-Encoding 的 q 值、"*"、identity;q=0 与 x-gzip 协商；
+ * gzip 一次性与流式压缩往返；policy.compression 开启后 JSON 响应被 gzip 编码并带 Vary，
+ * 未携带 Accept-Encoding 时原样返回；chunked 响应经流式压缩器输出；
+ * mount 开启预压缩时发送 ".gz" 兄弟文件；开启即时压缩时第二次请求命中压缩变体缓存。
+ * 通过条件：所有断言成立并输出 PASS；未编译 gzip 时跳过依赖编解码器的用例。
+ */
+
+#include <galay/cpp/galay-http/common/http_compression.h>
+#include <galay/cpp/galay-http/server/http_router.h>
+#include <galay/cpp/galay-http/server/http_server.h>
+#include "test/cpp/common/test_require.h"
+
+#include <arpa/inet.h>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <netinet/in.h>
+#include <signal.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace galay::http;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t kJsonSize = 16 * 1024;
+
+void alarmHandler(int)
+{
+    std::cerr << "[T96] timeout\n";
+    ::_exit(2);
+}
+
+uint16_t pickFreePort()
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    uint16_t port = 0;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    ::close(fd);
+    return port;
+}
+
+int connectLoopback(uint16_t port)
+{
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            timeval timeout{};
+            timeout.tv_sec = 5;
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(20ms);
+    }
+    return -1;
+}
+
+bool sendAll(int fd, const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+struct RawResponse {
+    std::string head;
+    std::string body;  ///< 已去掉 chunked 分帧，仍是内容编码后的字节
+};
+
+std::string lowerAscii(std::string text)
+{
+    for (char& ch : text) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return text;
+}
+
+bool decodeChunked(const std::string& wire, std::string& body)
+{
+    size_t pos = 0;
+    while (true) {
+        const size_t line_end = wire.find("\r\n", pos);
+        if (line_end == std::string::npos) {
+            return false;
+        }
+        const size_t size = std::strtoul(wire.substr(pos, line_end - pos).c_str(), nullptr, 16);
+        pos = line_end + 2;
+        if (size == 0) {
+            return true;
+        }
+        if (pos + size + 2 > wire.size()) {
+            return false;
+        }
+        body.append(wire, pos, size);
+        pos += size + 2;
+    }
+}
+
+// 发送一个 Connection: close 请求并读到 EOF
+bool roundTrip(uint16_t port, const std::string& path, const std::string& extra_headers, RawResponse& out)
+{
+    const int fd = connectLoopback(port);
+    if (fd < 0) {
+        return false;
+    }
+    const std::string request = "GET " + path + " HTTP/1.1\r\nHost: 127.0.0.1\r\n" + extra_headers +
+                                "Connection: close\r\n\r\n";
+    if (!sendAll(fd, request)) {
+        ::close(fd);
+        return false;
+    }
+    std::string wire;
+    char buffer[16 * 1024];
+    while (true) {
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            break;
+        }
+        wire.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fd);
+
+    const size_t end = wire.find("\r\n\r\n");
+    if (end == std::string::npos) {
+        return false;
+    }
+    out.head = wire.substr(0, end + 4);
+    const std::string rest = wire.substr(end + 4);
+    if (lowerAscii(out.head).find("transfer-encoding: chunked") != std::string::npos) {
+        return decodeChunked(rest, out.body);
+    }
+    out.body = rest;
+    return true;
+}
+
+// 头部名与值均按大小写不敏感比较，服务端会把部分头部名规范为小写
+bool hasHeader(const RawResponse& response, const std::string& line)
+{
+    return lowerAscii(response.head).find("\r\n" + lowerAscii(line) + "\r\n") != std::string::npos;
+}
+
+bool lacksHeader(const RawResponse& response, const std::string& name)
+{
+    return lowerAscii(response.head).find("\r\n" + lowerAscii(name) + ":") == std::string::npos;
+}
+
+std::string makeJson(size_t bytes)
+{
+    std::string json = "[";
+    while (json.size() < bytes) {
+        json += "{\"id\":42,\"name\":\"galay\",\"tags\":[\"http\",\"gzip\",\"zstd\"]},";
+    }
+    json.back() = ']';
+    return json;
+}
+
+bool testNegotiation()
+{
+    GALAY_TEST_REQUIRE(negotiateContentCoding("", true, true) == HttpContentCoding::Identity);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("gzip", true, true) == HttpContentCoding::Gzip);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("GZIP;q=0.5, zstd;q=0.9", true, true) == HttpContentCoding::Zstd);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("gzip;q=0.9, zstd;q=0.5", true, true) == HttpContentCoding::Gzip);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("gzip, zstd", true, true) == HttpContentCoding::Zstd);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("gzip, zstd", true, false) == HttpContentCoding::Gzip);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("x-gzip", true, true) == HttpContentCoding::Gzip);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("*", true, false) == HttpContentCoding::Gzip);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("*;q=0.5, gzip;q=0", true, true) == HttpContentCoding::Zstd);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("gzip;q=0", true, true) == HttpContentCoding::Identity);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("br", true, true) == HttpContentCoding::Identity);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("identity;q=1, gzip;q=0.5", true, true) == HttpContentCoding::Identity);
+
+    HttpCompressionSetting setting;
+    GALAY_TEST_REQUIRE(negotiateContentCoding("gzip", setting) == HttpContentCoding::Identity);
+    setting.setEnabled(true);
+    setting.setGzipEnabled(false);
+    GALAY_TEST_REQUIRE(negotiateContentCoding("gzip", setting) == HttpContentCoding::Identity);
+
+    GALAY_TEST_REQUIRE(isCompressibleMimeType("application/json; charset=utf-8"));
+    GALAY_TEST_REQUIRE(isCompressibleMimeType("text/html"));
+    GALAY_TEST_REQUIRE(isCompressibleMimeType("image/svg+xml"));
+    GALAY_TEST_REQUIRE(!isCompressibleMimeType("image/png"));
+    GALAY_TEST_REQUIRE(!isCompressibleMimeType("application/zip"));
+    return true;
+}
+
+bool testCodec()
+{
+    const std::string json = makeJson(64 * 1024);
+    auto compressed = compressContent(HttpContentCoding::Gzip, json, 6);
+    GALAY_TEST_REQUIRE(compressed.has_value());
+    GALAY_TEST_REQUIRE(compressed->size() < json.size() / 4);
+    auto decoded = decompressContent(HttpContentCoding::Gzip, *compressed, json.size());
+    GALAY_TEST_REQUIRE(decoded.has_value() && *decoded == json);
+    auto bomb = decompressContent(HttpContentCoding::Gzip, *compressed, json.size() / 2);
+    GALAY_TEST_REQUIRE(!bomb.has_value());
+
+    auto compressor = HttpStreamCompressor::create(HttpContentCoding::Gzip, 6);
+    GALAY_TEST_REQUIRE(compressor.has_value());
+    std::string wire;
+    for (size_t offset = 0; offset < json.size(); offset += 10000) {
+        auto piece = compressor->update(std::string_view(json).substr(offset, 10000), false);
+        GALAY_TEST_REQUIRE(piece.has_value());
+        // 每段同步刷新：到目前为止的输出即可解码出已输入的全部内容
+        wire += *piece;
+    }
+    auto tail = compressor->update({}, true);
+    GALAY_TEST_REQUIRE(tail.has_value() && compressor->finished());
+    wire += *tail;
+    auto streamed = decompressContent(HttpContentCoding::Gzip, wire, json.size());
+    GALAY_TEST_REQUIRE(streamed.has_value() && *streamed == json);
+    return true;
+}
+
+bool testDynamic(uint16_t port, const std::string& json)
+{
+    RawResponse gzip;
+    GALAY_TEST_REQUIRE(roundTrip(port, "/api/items", "Accept-Encoding: gzip;q=0.8, br\r\n", gzip));
+    GALAY_TEST_REQUIRE(gzip.head.rfind("HTTP/1.1 200", 0) == 0);
+    GALAY_TEST_REQUIRE(hasHeader(gzip, "Content-Encoding: gzip"));
+    GALAY_TEST_REQUIRE(hasHeader(gzip, "Vary: Accept-Encoding"));
+    GALAY_TEST_REQUIRE(hasHeader(gzip, "Content-Length: " + std::to_string(gzip.body.size())));
+    GALAY_TEST_REQUIRE(gzip.body.size() < json.size());
+    auto decoded = decompressContent(HttpContentCoding::Gzip, gzip.body, json.size());
+    GALAY_TEST_REQUIRE(decoded.has_value() && *decoded == json);
+
+    RawResponse plain;
+    GALAY_TEST_REQUIRE(roundTrip(port, "/api/items", "", plain));
+    GALAY_TEST_REQUIRE(lacksHeader(plain, "Content-Encoding"));
+    GALAY_TEST_REQUIRE(hasHeader(plain, "Vary: Accept-Encoding"));
+    GALAY_TEST_REQUIRE(plain.body == json);
+
+    RawResponse small;
+    GALAY_TEST_REQUIRE(roundTrip(port, "/api/small", "Accept-Encoding: gzip\r\n", small));
+    GALAY_TEST_REQUIRE(lacksHeader(small, "Content-Encoding"));
+    GALAY_TEST_REQUIRE(small.body == "{\"ok\":true}");
+
+    RawResponse stream;
+    GALAY_TEST_REQUIRE(roundTrip(port, "/api/stream", "Accept-Encoding: gzip\r\n", stream));
+    GALAY_TEST_REQUIRE(hasHeader(stream, "Content-Encoding: gzip"));
+    GALAY_TEST_REQUIRE(lacksHeader(stream, "Content-Length"));
+    auto streamed = decompressContent(HttpContentCoding::Gzip, stream.body, json.size() * 4);
+    GALAY_TEST_REQUIRE(streamed.has_value() && *streamed == json + json + json);
+    return true;
+}
+
+bool testStatic(uint16_t port,
+                const std::string& script,
+                const std::vector<std::shared_ptr<const CompressedVariantCache>>& caches)
+{
+    RawResponse pre;
+    GALAY_TEST_REQUIRE(roundTrip(port, "/pre/app.js", "Accept-Encoding: gzip\r\n", pre));
+    GALAY_TEST_REQUIRE(pre.head.rfind("HTTP/1.1 200", 0) == 0);
+    GALAY_TEST_REQUIRE(hasHeader(pre, "Content-Encoding: gzip"));
+    GALAY_TEST_REQUIRE(hasHeader(pre, "Vary: Accept-Encoding"));
+    auto decoded = decompressContent(HttpContentCoding::Gzip, pre.body, script.size());
+    GALAY_TEST_REQUIRE(decoded.has_value() && *decoded == script);
+
+    RawResponse pre_plain;
+    GALAY_TEST_REQUIRE(roundTrip(port, "/pre/app.js", "Accept-Encoding: identity\r\n", pre_plain));
+    GALAY_TEST_REQUIRE(lacksHeader(pre_plain, "Content-Encoding"));
+    GALAY_TEST_REQUIRE(hasHeader(pre_plain, "Vary: Accept-Encoding"));
+    GALAY_TEST_REQUIRE(pre_plain.body == script);
+
+    for (int round = 0; round < 2; ++round) {
+        RawResponse fly;
+        GALAY_TEST_REQUIRE(roundTrip(port, "/fly/app.js", "Accept-Encoding: gzip\r\n", fly));
+        GALAY_TEST_REQUIRE(hasHeader(fly, "Content-Encoding: gzip"));
+        GALAY_TEST_REQUIRE(lowerAscii(fly.head).find("\r\netag: w/\"") != std::string::npos);
+        auto fly_decoded = decompressContent(HttpContentCoding::Gzip, fly.body, script.size());
+        GALAY_TEST_REQUIRE(fly_decoded.has_value() && *fly_decoded == script);
+    }
+    GALAY_TEST_REQUIRE(caches.size() == 1);
+    const auto stats = caches.front()->stats();
+    GALAY_TEST_REQUIRE(stats.insertions == 1);
+    GALAY_TEST_REQUIRE(stats.hits >= 1);
+
+    RawResponse range;
+    GALAY_TEST_REQUIRE(roundTrip(port, "/fly/app.js", "Accept-Encoding: gzip\r\nRange: bytes=0-9\r\n", range));
+    GALAY_TEST_REQUIRE(range.head.rfind("HTTP/1.1 206", 0) == 0);
+    GALAY_TEST_REQUIRE(lacksHeader(range, "Content-Encoding"));
+    GALAY_TEST_REQUIRE(range.body == script.substr(0, 10));
+    return true;
+}
+
+Task<void> sendWhole(HttpConn& conn, HttpResponse response)
+{
+    auto writer = conn.getWriter();
+    while (true) {
+        auto result = co_await writer.sendResponse(response);
+        if (!result || result.value()) {
+            break;
+        }
+    }
+    co_return;
+}
+
+} // namespace
+
+int main()
+{
+    ::signal(SIGALRM, alarmHandler);
+    ::signal(SIGPIPE, SIG_IGN);
+    ::alarm(30);
+
+    if (!testNegotiation()) {
+        return 1;
+    }
+    if (!isContentCodingSupported(HttpContentCoding::Gzip)) {
+        std::cout << "T96-Compression PASS (gzip not compiled, codec cases skipped)\n";
+        return 0;
+    }
+    if (!testCodec()) {
+        return 1;
+    }
+
+    const std::string json = makeJson(kJsonSize);
+    std::string script;
+    while (script.size() < 32 * 1024) {
+        script += "export function handler(request) { return request.json(); }\n";
+    }
+
+    char dir_template[] = "/tmp/galay_t96_XXXXXX";
+    const char* dir = ::mkdtemp(dir_template);
+    if (dir == nullptr) {
+        std::cerr << "[T96] mkdtemp failed\n";
+        return 1;
+    }
+    const std::filesystem::path root(dir);
+    std::filesystem::create_directories(root / "pre");
+    std::filesystem::create_directories(root / "fly");
+    auto precompressed = compressContent(HttpContentCoding::Gzip, script, 9);
+    std::ofstream(root / "pre" / "app.js", std::ios::binary) << script;
+    std::ofstream(root / "pre" / "app.js.gz", std::ios::binary) << *precompressed;
+    std::ofstream(root / "fly" / "app.js", std::ios::binary) << script;
+
+    HttpRouter router;
+    router.addHandler<HttpMethod::GET>("/api/items", [](HttpConn& conn, HttpRequest) -> Task<void> {
+        const std::string json = makeJson(kJsonSize);
+        auto response = Http1_1ResponseBuilder().status(HttpStatusCode::OK_200)
+            .header("Content-Type", "application/json")
+            .body(json)
+            .buildMove();
+        co_await sendWhole(conn, std::move(response));
+    });
+    router.addHandler<HttpMethod::GET>("/api/small", [](HttpConn& conn, HttpRequest) -> Task<void> {
+        auto response = Http1_1ResponseBuilder().status(HttpStatusCode::OK_200)
+            .header("Content-Type", "application/json")
+            .body("{\"ok\":true}")
+            .buildMove();
+        co_await sendWhole(conn, std::move(response));
+    });
+    router.addHandler<HttpMethod::GET>("/api/stream", [](HttpConn& conn, HttpRequest) -> Task<void> {
+        const std::string json = makeJson(kJsonSize);
+        auto response = Http1_1ResponseBuilder().status(HttpStatusCode::OK_200)
+            .header("Content-Type", "text/plain")
+            .header("Transfer-Encoding", "chunked")
+            .buildMove();
+        auto writer = conn.getWriter();
+        while (true) {
+            auto result = co_await writer.sendHeader(response.header());
+            if (!result || result.value()) {
+                break;
+            }
+        }
+        for (int i = 0; i < 3; ++i) {
+            while (true) {
+                auto result = co_await writer.sendChunk(json, false);
+                if (!result || result.value()) {
+                    break;
+                }
+            }
+        }
+        while (true) {
+            auto result = co_await writer.sendChunk("", true);
+            if (!result || result.value()) {
+                break;
+            }
+        }
+        co_return;
+    });
+
+    StaticFileSetting pre_setting;
+    pre_setting.setEnablePrecompressed(true);
+    router.mount("/pre", (root / "pre").string(), pre_setting);
+
+    StaticFileSetting fly_setting;
+    HttpCompressionSetting fly_compression;
+    fly_compression.setEnabled(true);
+    fly_setting.setCompression(fly_compression);
+    fly_setting.setTransferMode(FileTransferMode::MEMORY);
+    router.mount("/fly", (root / "fly").string(), fly_setting);
+
+    HttpServerPolicy policy;
+    policy.compression.setEnabled(true);
+    const uint16_t port = pickFreePort();
+    HttpServer server = HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(1)
+        .policy(policy)
+        .build();
+    // 压缩变体缓存由 mount 创建并以 shared_ptr 共享，路由表移交给服务器后仍可读取统计
+    const auto variant_caches = router.compressedVariantCaches();
+    server.start(std::move(router));
+
+    const bool ok = testDynamic(port, json) && testStatic(port, script, variant_caches);
+    server.stop();
+    std::filesystem::remove_all(root);
+    if (!ok) {
+        return 1;
+    }
+    ::alarm(0);
+    std::cout << "T96-Compression PASS\n";
+    return 0;
+}
@@ -0,0 +1,385 @@
+/**
+ * @file t97_pipelining.cc
+ * @brief 用途：验证 HTTP/1.1 流水线的服务端响应合并与客户端 HttpSession::pipeline。
+ * 关键覆盖点：一次写入的多个请求按顺序得到响应，缓冲区中已有后续请求时响应被暂存后合并写出；
+ * 暂存响应之后的 chunked 流式响应不会越过它；Content-Length 请求体的 POST 可参与流水线；
+ * 中途 Connection: close 的请求之前的响应全部送达；HttpSession::pipeline 按深度发送并按序返回；
+ * HEAD 请求进入流水线时返回 kMethodNotAllow。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-http/client/http_client.h>
+#include <galay/cpp/galay-http/server/http_router.h>
+#include <galay/cpp/galay-http/server/http_server.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include "test/cpp/common/test_require.h"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <netinet/in.h>
+#include <signal.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace galay::http;
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t kStatsDepth = 4;
+
+std::atomic<uint64_t> g_coalesced{0};
+
+void alarmHandler(int)
+{
+    std::cerr << "[T97] timeout\n";
+    ::_exit(2);
+}
+
+uint16_t pickFreePort()
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    uint16_t port = 0;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+    ::close(fd);
+    return port;
+}
+
+int connectLoopback(uint16_t port)
+{
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            timeval timeout{};
+            timeout.tv_sec = 5;
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(20ms);
+    }
+    return -1;
+}
+
+bool sendAll(int fd, const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool decodeChunked(const std::string& wire, size_t& pos, std::string& body)
+{
+    while (true) {
+        const size_t line_end = wire.find("\r\n", pos);
+        if (line_end == std::string::npos) {
+            return false;
+        }
+        const size_t size = std::strtoul(wire.substr(pos, line_end - pos).c_str(), nullptr, 16);
+        pos = line_end + 2;
+        if (size == 0) {
+            pos += 2;
+            return pos <= wire.size();
+        }
+        if (pos + size + 2 > wire.size()) {
+            return false;
+        }
+        body.append(wire, pos, size);
+        pos += size + 2;
+    }
+}
+
+std::string get(const std::string& path, bool close = false)
+{
+    return "GET " + path + " HTTP/1.1\r\nHost: 127.0.0.1\r\n" +
+           (close ? "Connection: close\r\n" : "") + "\r\n";
+}
+
+// 把一次写入的流水线请求发给服务端，读到 EOF 后按顺序拆出各响应体
+bool pipelineRoundTrip(uint16_t port, const std::string& requests, std::vector<std::string>& bodies)
+{
+    const int fd = connectLoopback(port);
+    if (fd < 0) {
+        return false;
+    }
+    if (!sendAll(fd, requests)) {
+        ::close(fd);
+        return false;
+    }
+    std::string wire;
+    char buffer[16 * 1024];
+    while (true) {
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            break;
+        }
+        wire.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fd);
+
+    size_t pos = 0;
+    while (pos < wire.size()) {
+        const size_t end = wire.find("\r\n\r\n", pos);
+        if (end == std::string::npos || wire.compare(pos, 12, "HTTP/1.1 200") != 0) {
+            return false;
+        }
+        std::string head = wire.substr(pos, end + 4 - pos);
+        // 服务端会把部分头部名规范为小写
+        for (char& ch : head) {
+            ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        }
+        pos = end + 4;
+        std::string body;
+        const size_t length_at = head.find("content-length: ");
+        if (length_at != std::string::npos) {
+            const size_t length = std::strtoul(head.c_str() + length_at + 16, nullptr, 10);
+            if (pos + length > wire.size()) {
+                return false;
+            }
+            body = wire.substr(pos, length);
+            pos += length;
+        } else if (!decodeChunked(wire, pos, body)) {
+            return false;
+        }
+        bodies.push_back(std::move(body));
+    }
+    return true;
+}
+
+Task<void> sendWhole(HttpConn& conn, HttpResponse response)
+{
+    auto writer = conn.getWriter();
+    while (true) {
+        auto result = co_await writer.sendResponse(response);
+        if (!result || result.value()) {
+            break;
+        }
+    }
+    co_return;
+}
+
+HttpResponse textResponse(std::string body)
+{
+    return Http1_1ResponseBuilder().status(HttpStatusCode::OK_200)
+        .header("Content-Type", "text/plain")
+        .body(std::move(body))
+        .buildMove();
+}
+
+bool testOrdering(uint16_t port)
+{
+    std::string requests;
+    for (int i = 0; i < 8; ++i) {
+        requests += get("/echo/" + std::to_string(i));
+    }
+    requests += get("/echo/last", true);
+    std::vector<std::string> bodies;
+    GALAY_TEST_REQUIRE(pipelineRoundTrip(port, requests, bodies));
+    GALAY_TEST_REQUIRE(bodies.size() == 9);
+    for (int i = 0; i < 8; ++i) {
+        GALAY_TEST_REQUIRE(bodies[i] == "/echo/" + std::to_string(i));
+    }
+    GALAY_TEST_REQUIRE(bodies[8] == "/echo/last");
+    return true;
+}
+
+bool testCoalesced(uint16_t port)
+{
+    // 深度 4：前 3 个响应暂存，第 4 个随批次写出；/stats 之前至少合并了 3 个响应
+    std::string requests;
+    for (int i = 0; i < 6; ++i) {
+        requests += get("/echo/" + std::to_string(i));
+    }
+    requests += get("/stats", true);
+    std::vector<std::string> bodies;
+    GALAY_TEST_REQUIRE(pipelineRoundTrip(port, requests, bodies));
+    GALAY_TEST_REQUIRE(bodies.size() == 7);
+    GALAY_TEST_REQUIRE(std::strtoull(bodies[6].c_str(), nullptr, 10) >= kStatsDepth - 1);
+    return true;
+}
+
+bool testStreamingAfterDeferred(uint16_t port)
+{
+    const std::string requests = get("/echo/a") + get("/echo/b") + get("/stream") + get("/echo/c", true);
+    std::vector<std::string> bodies;
+    GALAY_TEST_REQUIRE(pipelineRoundTrip(port, requests, bodies));
+    GALAY_TEST_REQUIRE(bodies.size() == 4);
+    GALAY_TEST_REQUIRE(bodies[0] == "/echo/a");
+    GALAY_TEST_REQUIRE(bodies[1] == "/echo/b");
+    GALAY_TEST_REQUIRE(bodies[2] == "one-two-three");
+    GALAY_TEST_REQUIRE(bodies[3] == "/echo/c");
+    return true;
+}
+
+bool testPostAndClose(uint16_t port)
+{
+    const std::string post_body = "payload=pipelined";
+    const std::string requests =
+        get("/echo/first") +
+        "POST /upload HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Length: " +
+        std::to_string(post_body.size()) + "\r\n\r\n" + post_body +
+        get("/echo/closing", true) +
+        get("/echo/never");
+    std::vector<std::string> bodies;
+    GALAY_TEST_REQUIRE(pipelineRoundTrip(port, requests, bodies));
+    GALAY_TEST_REQUIRE(bodies.size() == 3);
+    GALAY_TEST_REQUIRE(bodies[0] == "/echo/first");
+    GALAY_TEST_REQUIRE(bodies[1] == post_body);
+    GALAY_TEST_REQUIRE(bodies[2] == "/echo/closing");
+    return true;
+}
+
+Task<bool> runSessionPipeline(uint16_t port)
+{
+    HttpClient client = HttpClientBuilder().build();
+    auto connected = co_await client.connect("http://127.0.0.1:" + std::to_string(port) + "/");
+    if (!connected) {
+        co_return false;
+    }
+    auto session_result = client.getSession();
+    if (!session_result) {
+        co_return false;
+    }
+    auto& session = *session_result.value();
+    session.setPipelineDepth(5);
+
+    std::vector<HttpRequest> requests;
+    for (int i = 0; i < 20; ++i) {
+        requests.push_back(Http1_1RequestBuilder::get("/echo/" + std::to_string(i))
+            .host("127.0.0.1")
+            .buildMove());
+    }
+    auto responses = co_await session.pipeline(std::move(requests));
+    bool ok = responses.has_value() && responses->size() == 20;
+    for (size_t i = 0; ok && i < responses->size(); ++i) {
+        ok = (*responses)[i].getBodyStr() == "/echo/" + std::to_string(i);
+    }
+
+    std::vector<HttpRequest> with_head;
+    with_head.push_back(Http1_1RequestBuilder::get("/echo/x").host("127.0.0.1").buildMove());
+    with_head.push_back(Http1_1RequestBuilder::head("/echo/y").host("127.0.0.1").buildMove());
+    auto rejected = co_await session.pipeline(std::move(with_head));
+    ok = ok && !rejected.has_value() && rejected.error().code() == kMethodNotAllow;
+
+    co_await client.close();
+    co_return ok;
+}
+
+bool testSessionPipeline(uint16_t port)
+{
+    Runtime runtime = RuntimeBuilder().ioSchedulerCount(1).computeSchedulerCount(0).build();
+    auto result = runtime.blockOn(runSessionPipeline(port));
+    runtime.stop();
+    GALAY_TEST_REQUIRE(result.has_value());
+    GALAY_TEST_REQUIRE(result.value());
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    ::signal(SIGALRM, alarmHandler);
+    ::signal(SIGPIPE, SIG_IGN);
+    ::alarm(30);
+
+    HttpRouter router;
+    router.addHandler<HttpMethod::GET>("/echo/*", [](HttpConn& conn, HttpRequest request) -> Task<void> {
+        co_await sendWhole(conn, textResponse(request.header().uri()));
+    });
+    router.addHandler<HttpMethod::POST>("/upload", [](HttpConn& conn, HttpRequest request) -> Task<void> {
+        co_await sendWhole(conn, textResponse(request.getBodyStr()));
+    });
+    router.addHandler<HttpMethod::GET>("/stats", [](HttpConn& conn, HttpRequest) -> Task<void> {
+        g_coalesced = conn.pipelineBatch().coalesced();
+        co_await sendWhole(conn, textResponse(std::to_string(g_coalesced.load())));
+    });
+    router.addHandler<HttpMethod::GET>("/stream", [](HttpConn& conn, HttpRequest) -> Task<void> {
+        auto response = Http1_1ResponseBuilder().status(HttpStatusCode::OK_200)
+            .header("Content-Type", "text/plain")
+            .header("Transfer-Encoding", "chunked")
+            .buildMove();
+        auto writer = conn.getWriter();
+        while (true) {
+            auto result = co_await writer.sendHeader(response.header());
+            if (!result || result.value()) {
+                break;
+            }
+        }
+        const std::vector<std::string> pieces = {"one-", "two-", "three"};
+        for (const std::string& piece : pieces) {
+            while (true) {
+                auto result = co_await writer.sendChunk(piece, false);
+                if (!result || result.value()) {
+                    break;
+                }
+            }
+        }
+        while (true) {
+            auto result = co_await writer.sendChunk(std::string(), true);
+            if (!result || result.value()) {
+                break;
+            }
+        }
+        co_return;
+    });
+
+    HttpServerPolicy policy;
+    policy.pipeline.enabled = true;
+    policy.pipeline.max_depth = kStatsDepth;
+    const uint16_t port = pickFreePort();
+    HttpServer server = HttpServerBuilder()
+        .host("127.0.0.1")
+        .port(port)
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(1)
+        .policy(policy)
+        .build();
+    server.start(std::move(router));
+
+    const bool ok = testOrdering(port) &&
+                    testCoalesced(port) &&
+                    testStreamingAfterDeferred(port) &&
+                    testPostAndClose(port) &&
+                    testSessionPipeline(port);
+    server.stop();
+    if (!ok) {
+        return 1;
+    }
+    ::alarm(0);
+    std::cout << "T97-Pipelining PASS\n";
+    return 0;
+}
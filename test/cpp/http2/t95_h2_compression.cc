@@ -0,0 +1,215 @@
+/**
+ * @file t95_h2_compression.cc
+ * @brief HTTP/2 流响应压缩：HEADERS 改写与 DATA 流式 / 整体压缩
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define private public
+#include <galay/cpp/galay-http2/kernel/http2_stream.h>
+#undef private
+
+using namespace galay::http2;
+using galay::http::HttpCompressionSetting;
+using galay::http::HttpContentCoding;
+
+namespace {
+
+struct ParsedFrame {
+    uint8_t type = 0;
+    uint8_t flags = 0;
+    std::string payload;
+};
+
+ParsedFrame parseFrame(const Http2OutgoingFrame& frame) {
+    const std::string bytes = frame.flatten();
+    assert(bytes.size() >= kHttp2FrameHeaderLength);
+    const auto* raw = reinterpret_cast<const uint8_t*>(bytes.data());
+    const size_t length = (static_cast<size_t>(raw[0]) << 16) |
+                          (static_cast<size_t>(raw[1]) << 8) |
+                          static_cast<size_t>(raw[2]);
+    assert(bytes.size() == kHttp2FrameHeaderLength + length);
+    return ParsedFrame{raw[3], raw[4], bytes.substr(kHttp2FrameHeaderLength)};
+}
+
+std::string headerValue(const std::vector<Http2HeaderField>& headers, const std::string& name) {
+    for (const auto& field : headers) {
+        if (field.name == name) {
+            return field.value;
+        }
+    }
+    return "";
+}
+
+bool hasHeader(const std::vector<Http2HeaderField>& headers, const std::string& name) {
+    for (const auto& field : headers) {
+        if (field.name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string makeJson(size_t bytes) {
+    std::string json = "[";
+    while (json.size() < bytes) {
+        json += "{\"id\":1,\"name\":\"galay\",\"tags\":[\"http2\",\"gzip\"]},";
+    }
+    json.back() = ']';
+    return json;
+}
+
+Http2Stream::ptr armedStream(uint32_t id,
+                             std::vector<Http2OutgoingFrame>& queue,
+                             HpackEncoder& encoder,
+                             const std::string& accept_encoding) {
+    auto stream = Http2Stream::create(id);
+    stream->attachIO(&queue, &encoder, nullptr);
+    stream->request().setCommonHeader(detail::Http2RequestCommonHeaderIndex::AcceptEncoding,
+                                      accept_encoding);
+    HttpCompressionSetting setting;
+    setting.setEnabled(true);
+    setting.setMinLength(256);
+    stream->negotiateResponseCoding(setting);
+    return stream;
+}
+
+}  // namespace
+
+int main() {
+    if (!galay::http::isContentCodingSupported(HttpContentCoding::Gzip)) {
+        std::cout << "T95-H2Compression SKIP (gzip not compiled)\n";
+        return 0;
+    }
+
+    const std::string json = makeJson(4096);
+
+    // 整体压缩：sendHeadersAndData 重写 content-length，强 ETag 弱化
+    {
+        std::vector<Http2OutgoingFrame> queue;
+        HpackEncoder encoder;
+        auto stream = armedStream(1, queue, encoder, "br;q=1, gzip;q=0.8");
+        assert(stream->responseCoding() == HttpContentCoding::Gzip);
+        stream->sendHeadersAndData({
+            {":status", "200"},
+            {"content-type", "application/json"},
+            {"content-length", std::to_string(json.size())},
+            {"etag", "\"abc\""},
+        }, json, true);
+        assert(queue.size() == 2);
+
+        HpackDecoder decoder;
+        auto headers = decoder.decode(parseFrame(queue[0]).payload);
+        assert(headers.has_value());
+        assert(headerValue(*headers, "content-encoding") == "gzip");
+        assert(headerValue(*headers, "vary") == "accept-encoding");
+        assert(headerValue(*headers, "etag") == "W/\"abc\"");
+
+        const auto data = parseFrame(queue[1]);
+        assert(data.type == static_cast<uint8_t>(Http2FrameType::Data));
+        assert(headerValue(*headers, "content-length") == std::to_string(data.payload.size()));
+        assert(data.payload.size() < json.size());
+        auto decoded = galay::http::decompressContent(HttpContentCoding::Gzip, data.payload, 1 << 20);
+        assert(decoded.has_value() && *decoded == json);
+    }
+
+    // 流式压缩：HEADERS 去掉 content-length，每个 DATA 可增量解码
+    {
+        std::vector<Http2OutgoingFrame> queue;
+        HpackEncoder encoder;
+        auto stream = armedStream(3, queue, encoder, "gzip");
+        stream->sendHeaders({
+            {":status", "200"},
+            {"content-type", "text/plain"},
+            {"content-length", "99999"},
+            {"vary", "origin"},
+        }, false);
+        stream->sendData(json.substr(0, 2000), false);
+        stream->sendData(json.substr(2000), true);
+        assert(queue.size() == 3);
+
+        HpackDecoder decoder;
+        auto headers = decoder.decode(parseFrame(queue[0]).payload);
+        assert(headers.has_value());
+        assert(!hasHeader(*headers, "content-length"));
+        assert(headerValue(*headers, "content-encoding") == "gzip");
+        assert(headerValue(*headers, "vary") == "origin, accept-encoding");
+
+        std::string wire;
+        for (size_t i = 1; i < queue.size(); ++i) {
+            const auto frame = parseFrame(queue[i]);
+            assert(frame.type == static_cast<uint8_t>(Http2FrameType::Data));
+            assert(((frame.flags & 0x1) != 0) == (i + 1 == queue.size()));
+            wire += frame.payload;
+        }
+        auto decoded = galay::http::decompressContent(HttpContentCoding::Gzip, wire, 1 << 20);
+        assert(decoded.has_value() && *decoded == json);
+        assert(!stream->m_stream_compressor.has_value());
+    }
+
+    // 不满足条件的响应原样发送：小响应、已编码、不可压缩类型、未接受 gzip
+    {
+        std::vector<Http2OutgoingFrame> queue;
+        HpackEncoder encoder;
+        auto stream = armedStream(5, queue, encoder, "gzip");
+        stream->sendHeadersAndData({
+            {":status", "200"},
+            {"content-type", "application/json"},
+        }, std::string("{}"), true);
+        HpackDecoder decoder;
+        auto headers = decoder.decode(parseFrame(queue[0]).payload);
+        assert(headers.has_value() && !hasHeader(*headers, "content-encoding"));
+        assert(parseFrame(queue[1]).payload == "{}");
+    }
+    {
+        std::vector<Http2OutgoingFrame> queue;
+        HpackEncoder encoder;
+        auto stream = armedStream(7, queue, encoder, "gzip");
+        stream->sendHeadersAndData({
+            {":status", "200"},
+            {"content-type", "image/png"},
+        }, json, true);
+        assert(parseFrame(queue[1]).payload == json);
+    }
+    {
+        std::vector<Http2OutgoingFrame> queue;
+        HpackEncoder encoder;
+        auto stream = armedStream(9, queue, encoder, "gzip;q=0, identity");
+        assert(stream->responseCoding() == HttpContentCoding::Identity);
+        stream->sendHeadersAndData({
+            {":status", "200"},
+            {"content-type", "application/json"},
+        }, json, true);
+        assert(parseFrame(queue[1]).payload == json);
+    }
+    {
+        std::vector<Http2OutgoingFrame> queue;
+        HpackEncoder encoder;
+        auto stream = armedStream(11, queue, encoder, "gzip");
+        stream->disableResponseCoding();
+        stream->sendHeadersAndData({
+            {":status", "200"},
+            {"content-type", "application/json"},
+        }, json, true);
+        assert(parseFrame(queue[1]).payload == json);
+    }
+
+    // 复用前清空压缩状态
+    {
+        std::vector<Http2OutgoingFrame> queue;
+        HpackEncoder encoder;
+        auto stream = armedStream(13, queue, encoder, "gzip");
+        stream->resetForReuse(15);
+        assert(!stream->responseCoding().has_value());
+        assert(!stream->m_response_coding_armed);
+    }
+
+    std::cout << "T95-H2Compression PASS\n";
+    return 0;
+}
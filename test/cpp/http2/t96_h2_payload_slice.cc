@@ -0,0 +1,160 @@
+/**
+ * @file t96_h2_payload_slice.cc
+ * @brief HTTP/2 refcounted DATA slice contract
+ */
+
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/uio.h>
+
+#include <galay/cpp/galay-http2/kernel/h2_core.h>
+#include <galay/cpp/galay-http2/kernel/http2_stream.h>
+#include <galay/cpp/galay-http2/kernel/out_scheduler.h>
+
+using namespace galay::http2;
+
+namespace
+{
+
+std::string flattenIovecs(const std::vector<struct iovec>& iovecs)
+{
+    std::string out;
+    for (const auto& iov : iovecs) {
+        out.append(static_cast<const char*>(iov.iov_base), iov.iov_len);
+    }
+    return out;
+}
+
+bool pointsInto(const void* ptr, const std::string& owner)
+{
+    const auto* p = static_cast<const char*>(ptr);
+    return p >= owner.data() && p < owner.data() + owner.size();
+}
+
+} // namespace
+
+int main()
+{
+    // 子切片共享所有者，不复制字节
+    auto body = std::make_shared<const std::string>("0123456789abcdef");
+    {
+        Http2PayloadSlice whole(body);
+        assert(whole.size() == body->size());
+        assert(whole.data() == body->data());
+        assert(body.use_count() == 2);
+
+        auto middle = whole.subslice(4, 6);
+        assert(middle == "456789");
+        assert(middle.data() == body->data() + 4);
+        assert(body.use_count() == 3);
+
+        assert(whole.subslice(12) == "cdef");
+        assert(whole.subslice(100).empty());
+        assert(Http2PayloadSlice(body, 10, 100) == "abcdef");
+        assert(Http2PayloadSlice(body, 100, 1).empty());
+    }
+    assert(body.use_count() == 1);
+
+    Http2PayloadSlice owned(std::string("owned"));
+    assert(owned == "owned");
+    assert(Http2PayloadSlice(std::string()).empty());
+    assert(Http2PayloadSlice(std::string()).owner() == nullptr);
+
+    // 切片调度与字节调度的线上内容一致，DATA 负载 iovec 直接指向原缓冲
+    auto make_streams = [&body]() {
+        std::vector<H2StreamSendState> streams;
+        streams.push_back(H2StreamSendState{
+            .pending = {
+                .chunks = {Http2PayloadSlice(body)},
+                .front_offset = 0,
+                .end_stream = true
+            },
+            .stream_id = 1,
+            .stream_window = 64,
+            .weight = 16
+        });
+        streams.push_back(H2StreamSendState{
+            .pending = {
+                .chunks = {"xyz"},
+                .front_offset = 0,
+                .end_stream = false
+            },
+            .stream_id = 3,
+            .stream_window = 64,
+            .weight = 16
+        });
+        return streams;
+    };
+
+    const H2OutboundBudget budget{
+        .conn_window = 64,
+        .max_frame_size = 5
+    };
+    auto byte_streams = make_streams();
+    auto bytes = Http2OutboundScheduler::pickSendableBytes(budget, byte_streams);
+    std::string expected;
+    for (const auto& frame : bytes.frames) {
+        expected.append(frame);
+    }
+
+    auto slice_streams = make_streams();
+    auto slices = Http2OutboundScheduler::pickSendableSlices(budget, slice_streams);
+    assert(slices.total_data_bytes == bytes.total_data_bytes);
+    assert(slices.frames.size() == bytes.frames.size());
+    assert(slices.wireBytes() == expected.size());
+
+    std::vector<struct iovec> iovecs;
+    assert(slices.fillIovecs(iovecs) == slices.frames.size() * 2);
+    assert(flattenIovecs(iovecs) == expected);
+    size_t body_iovecs = 0;
+    for (size_t i = 1; i < iovecs.size(); i += 2) {
+        if (pointsInto(iovecs[i].iov_base, *body)) {
+            ++body_iovecs;
+        }
+    }
+    assert(body_iovecs == 4);
+    assert(slice_streams[0].pending.chunks.empty());
+    assert(slice_streams[1].pending.chunks.empty());
+
+    // 只带 END_STREAM 的空 DATA 只有帧头
+    std::vector<H2StreamSendState> end_only;
+    end_only.push_back(H2StreamSendState{
+        .pending = {.end_stream = true},
+        .stream_id = 5,
+        .stream_window = 64,
+        .weight = 16
+    });
+    auto end_selection = Http2OutboundScheduler::pickSendableSlices(budget, end_only);
+    assert(end_selection.frames.size() == 1);
+    assert(end_selection.fillIovecs(iovecs) == 1);
+    assert(flattenIovecs(iovecs) == Http2FrameBuilder::dataBytes(5, "", true));
+
+    // 连接核心：控制帧整帧作为负载，DATA 引用入队切片
+    Http2ConnectionCore core;
+    core.enqueueData(7, Http2PayloadSlice(body, 0, 4), true);
+    auto core_selection = core.flushOutboundSlices(H2OutboundBudget{
+        .conn_window = 64,
+        .max_frame_size = 16
+    });
+    assert(core_selection.frames.size() == 1);
+    assert(core_selection.frames[0].payload.data() == body->data());
+    assert(core_selection.fillIovecs(iovecs) == 2);
+    assert(flattenIovecs(iovecs) == Http2FrameBuilder::dataBytes(7, "0123", true));
+
+    // 出站帧直接携带切片
+    const auto header = Http2FrameBuilder::dataHeaderBytes(9, 6, false);
+    auto frame = Http2OutgoingFrame::segmentedSlice(header, Http2PayloadSlice(body).subslice(2, 6));
+    assert(frame.isSegmented());
+    assert(frame.flatten() == Http2FrameBuilder::dataBytes(9, "234567", false));
+    std::array<struct iovec, 2> frame_iovecs{};
+    assert(frame.exportIovecs(frame_iovecs) == 2);
+    assert(frame_iovecs[1].iov_base == const_cast<char*>(body->data() + 2));
+    assert(frame_iovecs[1].iov_len == 6);
+
+    std::cout << "T96-H2PayloadSlice PASS\n";
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file t97_h2_priority.cc
+ * @brief RFC 9218 extensible priority contract
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <galay/cpp/galay-http2/kernel/frame_dispacher.h>
+#include <galay/cpp/galay-http2/kernel/h2_core.h>
+#include <galay/cpp/galay-http2/kernel/out_scheduler.h>
+#include <galay/cpp/galay-http2/protoc/http2_frame.h>
+#include <galay/cpp/galay-http2/protoc/http2_priority.h>
+
+using namespace galay::http2;
+
+namespace
+{
+
+uint32_t frameStreamId(const std::string& frame)
+{
+    assert(frame.size() >= kHttp2FrameHeaderLength);
+    return ((static_cast<uint32_t>(static_cast<uint8_t>(frame[5])) & 0x7fu) << 24) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(frame[6])) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(frame[7])) << 8) |
+           static_cast<uint32_t>(static_cast<uint8_t>(frame[8]));
+}
+
+std::vector<uint32_t> frameOrder(const H2OutboundBytesSelection& selection)
+{
+    std::vector<uint32_t> ids;
+    for (const auto& frame : selection.frames) {
+        ids.push_back(frameStreamId(frame));
+    }
+    return ids;
+}
+
+H2StreamSendState makeStream(uint32_t id, std::string body, Http2PriorityParam priority)
+{
+    H2StreamSendState state;
+    state.pending.chunks.push_back(Http2PayloadSlice(std::move(body)));
+    state.pending.end_stream = true;
+    state.stream_id = id;
+    state.stream_window = 1 << 20;
+    state.urgency = priority.urgency;
+    state.incremental = priority.incremental;
+    return state;
+}
+
+std::vector<H2StreamSendState> makeMixedStreams()
+{
+    std::vector<H2StreamSendState> streams;
+    streams.push_back(makeStream(1, "bulkbulk", {.urgency = 5}));
+    streams.push_back(makeStream(3, "criticl!", {.urgency = 0}));
+    streams.push_back(makeStream(5, "progres1", {.urgency = 3, .incremental = true}));
+    streams.push_back(makeStream(7, "progres2", {.urgency = 3, .incremental = true}));
+    return streams;
+}
+
+} // namespace
+
+int main()
+{
+    // priority 字段：缺省值、incremental 布尔、未知键与越界值被忽略
+    assert((parseHttp2PriorityField("") == Http2PriorityParam{}));
+    assert((parseHttp2PriorityField("u=1, i") == Http2PriorityParam{1, true}));
+    assert((parseHttp2PriorityField("i=?1,u=6") == Http2PriorityParam{6, true}));
+    assert((parseHttp2PriorityField("u=2;foo=1, i=?0") == Http2PriorityParam{2, false}));
+    assert((parseHttp2PriorityField("u=9, x=1") == Http2PriorityParam{}));
+    assert((parseHttp2PriorityField("u=12") == Http2PriorityParam{}));
+    assert((parseHttp2PriorityField("i", Http2PriorityParam{5, false}) == Http2PriorityParam{5, true}));
+    assert(formatHttp2PriorityField({}) == "");
+    assert(formatHttp2PriorityField({.urgency = 1, .incremental = true}) == "u=1, i");
+    assert(formatHttp2PriorityField({.urgency = 3, .incremental = true}) == "i");
+
+    // PRIORITY_UPDATE 帧往返
+    {
+        Http2PriorityUpdateFrame update;
+        update.setPriorityUpdate(7, "u=0, i");
+        const std::string bytes = update.serialize();
+        assert(bytes.size() == kHttp2FrameHeaderLength + 4 + 6);
+        auto parsed = Http2FrameParser::parseFrame(
+            reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+        assert(parsed.has_value());
+        assert((*parsed)->isPriorityUpdate());
+        assert((*parsed)->streamId() == 0);
+        assert((*parsed)->asPriorityUpdate()->prioritizedStreamId() == 7);
+        assert((*parsed)->asPriorityUpdate()->fieldValue() == "u=0, i");
+
+        // 负载不足 4 字节的 PRIORITY_UPDATE 是帧大小错误
+        std::string truncated = bytes.substr(0, kHttp2FrameHeaderLength + 2);
+        truncated[0] = 0;
+        truncated[1] = 0;
+        truncated[2] = 2;
+        auto bad = Http2FrameParser::parseFrame(
+            reinterpret_cast<const uint8_t*>(truncated.data()), truncated.size());
+        assert(!bad.has_value());
+
+        // 只允许出现在 0 号流
+        H2DispatcherConnectionState state;
+        Http2PriorityUpdateFrame on_stream;
+        on_stream.setPriorityUpdate(1, "u=1");
+        on_stream.header().stream_id = 1;
+        auto result = Http2FrameDispatcher::dispatch(on_stream, state);
+        assert(!result.ok);
+        assert(result.error_scope == H2DispatchErrorScope::Connection);
+    }
+
+    // 优先级桶：urgency 小的先出，同 urgency 非 incremental 先于 incremental
+    {
+        H2UrgencyBuckets<uint32_t> buckets;
+        buckets.push(1, {.urgency = 7});
+        buckets.push(3, {.urgency = 2, .incremental = true}, 5);
+        buckets.push(5, {.urgency = 2, .incremental = true}, 2);
+        buckets.push(7, {.urgency = 2});
+        buckets.arrange();
+        assert(buckets.size() == 4);
+        assert(buckets.front() == 7 && !buckets.frontIncremental());
+        buckets.popFront();
+        assert(buckets.front() == 5 && buckets.frontIncremental() && buckets.frontUrgency() == 2);
+        buckets.rotateFront();
+        assert(buckets.front() == 3);
+        buckets.popFront();
+        buckets.popFront();
+        assert(buckets.front() == 1 && buckets.frontUrgency() == 7);
+        buckets.clear();
+        assert(buckets.empty() && buckets.size() == 0);
+    }
+
+    // Extensible：urgency 优先，非 incremental 逐个发完，incremental 每帧轮转
+    const H2OutboundBudget budget{.conn_window = 1 << 20, .max_frame_size = 4};
+    const H2SchedulerConfig extensible{.mode = H2SchedulingMode::Extensible};
+    {
+        auto streams = makeMixedStreams();
+        auto selection = Http2OutboundScheduler::pickSendableBytes(budget, streams, extensible);
+        assert(selection.total_data_bytes == 32);
+        assert((frameOrder(selection) == std::vector<uint32_t>{3, 3, 5, 7, 5, 7, 1, 1}));
+        assert(selection.frames[1] == Http2FrameBuilder::dataBytes(3, "icl!", true));
+    }
+
+    // WeightedDrr 保持按权重轮转，不看 urgency
+    {
+        auto streams = makeMixedStreams();
+        auto selection = Http2OutboundScheduler::pickSendableBytes(budget, streams);
+        assert(selection.total_data_bytes == 32);
+        assert(frameOrder(selection).front() == 1);
+    }
+
+    // incremental 轮转跨调用延续：每次只有一帧的连接窗口时交替服务
+    {
+        std::vector<H2StreamSendState> streams;
+        streams.push_back(makeStream(5, "aaaaaaaa", {.urgency = 1, .incremental = true}));
+        streams.push_back(makeStream(7, "bbbbbbbb", {.urgency = 1, .incremental = true}));
+        const H2OutboundBudget one_frame{.conn_window = 4, .max_frame_size = 4};
+        std::vector<uint32_t> order;
+        for (int i = 0; i < 4; ++i) {
+            auto selection = Http2OutboundScheduler::pickSendableBytes(one_frame, streams, extensible);
+            assert(selection.frames.size() == 1);
+            order.push_back(frameStreamId(selection.frames.front()));
+        }
+        assert((order == std::vector<uint32_t>{5, 7, 5, 7}));
+    }
+
+    // 连接核心按入队时的优先级调度
+    {
+        Http2ConnectionCore core;
+        core.enqueueData(1, Http2PayloadSlice(std::string("low!")), true, Http2PriorityParam{.urgency = 7});
+        core.enqueueData(3, Http2PayloadSlice(std::string("high")), true, Http2PriorityParam{.urgency = 1});
+        auto selection = core.flushOutboundBytes(budget, extensible);
+        assert((frameOrder(selection) == std::vector<uint32_t>{3, 1}));
+    }
+
+    std::cout << "T97-H2Priority PASS\n";
+    return 0;
+}
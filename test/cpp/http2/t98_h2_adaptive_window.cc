@@ -0,0 +1,116 @@
+/**
+ * @file t98_h2_adaptive_window.cc
+ * @brief HTTP/2 BDP receive window tuner contract
+ */
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+
+#include <galay/cpp/galay-http2/kernel/flow_control.h>
+#include <galay/cpp/galay-http2/kernel/http2_conn.h>
+
+using namespace galay::http2;
+using namespace std::chrono_literals;
+
+int main()
+{
+    const auto t0 = H2RecvWindowTuner::Clock::now();
+
+    // 未开启时不探测，目标保持基线
+    {
+        H2RecvWindowTuner tuner;
+        tuner.configure(H2AdaptiveWindowConfig{}, 65535, 65535);
+        assert(!tuner.enabled());
+        assert(!tuner.onDataReceived(16384, t0));
+        assert(!tuner.probeInFlight());
+        assert(tuner.connTarget() == 65535);
+        assert(!tuner.onIdleCheck(t0 + 10s));
+    }
+
+    const H2AdaptiveWindowConfig config{
+        .enabled = true,
+        .max_window = 1024 * 1024,
+        .max_stream_window = 512 * 1024,
+        .idle_shrink_after = 1000ms,
+    };
+
+    // 一个 RTT 内收满窗口：目标翻倍，受上限约束
+    {
+        H2RecvWindowTuner tuner;
+        tuner.configure(config, 65535, 65535);
+        assert(tuner.onDataReceived(16384, t0));
+        tuner.onProbeSent(t0);
+        assert(tuner.probeInFlight());
+        const auto payload = tuner.probePayload();
+        assert(tuner.isProbeAck(payload.data()));
+
+        // 探测在途时只累计字节
+        assert(!tuner.onDataReceived(16384, t0 + 10ms));
+        assert(!tuner.onDataReceived(16384, t0 + 20ms));
+        assert(!tuner.onDataReceived(16383, t0 + 30ms));
+        assert(tuner.onProbeAck(t0 + 80ms));
+        assert(!tuner.probeInFlight());
+        assert(!tuner.isProbeAck(payload.data()));
+        assert(tuner.minRtt() == 80ms);
+        assert(tuner.smoothedRtt() == 80ms);
+        assert(tuner.bdpEstimate() == 65535);
+        assert(tuner.connTarget() == 131070);
+        assert(tuner.streamTarget() == 131070);
+
+        // 每轮翻倍直到上限，上限后不再探测
+        for (int round = 0; round < 8; ++round) {
+            const auto now = t0 + 100ms * (round + 1);
+            if (!tuner.onDataReceived(tuner.connTarget(), now)) {
+                break;
+            }
+            tuner.onProbeSent(now);
+            assert(tuner.isProbeAck(tuner.probePayload().data()) && !tuner.isProbeAck(payload.data()));
+            tuner.onProbeAck(now + 80ms);
+        }
+        assert(tuner.connTarget() == 1024 * 1024);
+        assert(tuner.streamTarget() == 512 * 1024);
+        assert(!tuner.onDataReceived(1, t0 + 2s));
+
+        // 空闲后逐步回落到基线
+        assert(!tuner.onIdleCheck(t0 + 2500ms));
+        assert(tuner.onIdleCheck(t0 + 3s));
+        assert(tuner.connTarget() == 512 * 1024);
+        assert(tuner.streamTarget() == 256 * 1024);
+        for (int i = 0; i < 8; ++i) {
+            tuner.onIdleCheck(t0 + 4s + 1s * i);
+        }
+        assert(tuner.connTarget() == 65535);
+        assert(tuner.streamTarget() == 65535);
+        assert(!tuner.onIdleCheck(t0 + 60s));
+    }
+
+    // 样本远小于窗口（应用限速而非窗口限速）：不增长
+    {
+        H2RecvWindowTuner tuner;
+        tuner.configure(config, 65535, 65535);
+        assert(tuner.onDataReceived(1000, t0));
+        tuner.onProbeSent(t0);
+        assert(!tuner.onProbeAck(t0 + 50ms));
+        assert(tuner.connTarget() == 65535);
+        tuner.onRttSample(20ms);
+        assert(tuner.minRtt() == 20ms);
+        const H2RecvWindowTuner::Clock::duration first = 50ms;
+        const H2RecvWindowTuner::Clock::duration second = 20ms;
+        assert(tuner.smoothedRtt() == first - first / 8 + second / 8);
+    }
+
+    // 运行时配置透传
+    {
+        struct Config {
+            H2AdaptiveWindowConfig adaptive_window;
+        } server_config{config};
+        Http2RuntimeConfig runtime;
+        runtime.from(server_config);
+        assert(runtime.adaptive_window.enabled);
+        assert(runtime.adaptive_window.max_window == 1024 * 1024);
+    }
+
+    std::cout << "T98-H2AdaptiveWindow PASS\n";
+    return 0;
+}
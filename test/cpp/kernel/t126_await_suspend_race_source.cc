@@ -103,8 +103,10 @@ void checkMpscAwaitSuspend(std::vector<std::string>& failures,
                     section,
                     "beginWaiterRegistration()",
                     label + " should enter the non-wakeable arming phase before the final retry");
+    // 发布失败会归还 timer 并重新 arming；只有成功发布后的 return true 不得再访问帧。
     const std::string publish_call =
-        "return channel->publishWaiter(waiterState, std::move(timeoutTimer));";
+        "if (channel->publishWaiter(waiterState, timeoutTimer)) {\n"
+        "            return true;";
     requireContains(failures,
                     path,
                     section,
@@ -374,7 +374,7 @@ int main()
                 failures,
                 publishStream,
                 "ProducerGate::kPublished",
-                "detachPublishedWaiter()",
+                "detachPublishedWaiter(stream)",
                 "published gate announcement must precede waiter arbitration");
         }
 
@@ -676,23 +676,18 @@ int main()
                 waiterReadiness,
                 "control.gate.load(std::memory_order_seq_cst)",
                 "waiter readiness must join producer notification ordering through the gate");
-            requireContains(
-                failures,
-                waiterReadiness,
-                "ProducerGate::kPublished",
-                "waiter readiness must treat a published gate as immediately readable");
-            requireContains(
+            requireNotContains(
                 failures,
                 waiterReadiness,
-                "ProducerGate::kSending",
-                "waiter readiness must identify sends that will arbitrate after arming");
+                "gate == ProducerGate::kPublished",
+                "a published gate alone must not cancel arming; its data may already be consumed");
             requireContains(
                 failures,
                 waiterReadiness,
-                "if (gate == ProducerGate::kSending) {\n"
-                "                if (stream->consumer.localConsumed !=\n"
-                "                    stream->shared.published.load(std::memory_order_acquire))",
-                "a sending stream must recheck previously published data before arming");
+                "control.gate.load(std::memory_order_seq_cst);\n"
+                "            if (stream->consumer.localConsumed !=\n"
+                "                stream->shared.published.load(std::memory_order_acquire))",
+                "every gate state must recheck the publication counter before arming");
             requireContains(
                 failures,
                 waiterReadiness,
@@ -706,6 +701,21 @@ int main()
         }
     }
 
+    if (!content.empty()) {
+        const std::string staleArbitration = extractFunction(
+            content, "TaskState* detachPublishedWaiter(\n        const ProducerStream& stream) noexcept");
+        if (staleArbitration.empty()) {
+            failures.push_back("failed to locate MPSC publish-side waiter arbitration");
+        } else {
+            requireContains(
+                failures,
+                staleArbitration,
+                "stream.consumer.consumed.load(std::memory_order_acquire) >=\n"
+                "                stream.producer.localPublished",
+                "publication already taken by the arming consumer must not wake or cancel it");
+        }
+    }
+
     if (!failures.empty()) {
         for (const std::string& failure : failures) {
             std::cerr << failure << '\n';
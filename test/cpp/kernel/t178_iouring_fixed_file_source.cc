@@ -0,0 +1,133 @@
+/**
+ * @file t178_iouring_fixed_file_source.cc
+ * @brief 用途：锁定 io_uring fixed-file 提交模式的源码边界。
+ * 关键覆盖点：稀疏 fixed file 表注册、socket SQE 改写为 `IOSQE_FIXED_FILE`、
+ * 槽位随 close 在 owner 线程经 FILES_UPDATE SQE 退役、文件 IO 不走 fixed-file、Runtime 透传配置。
+ * 通过条件：相关 token 存在且文件读写路径未调用 applyFixedFile。
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+
+std::filesystem::path projectRoot() {
+    return std::filesystem::path(GALAY_SOURCE_ROOT);
+}
+
+std::string readAll(const std::filesystem::path& path) {
+    std::ifstream input(path);
+    if (!input.is_open()) {
+        return {};
+    }
+    return std::string((std::istreambuf_iterator<char>(input)),
+                       std::istreambuf_iterator<char>());
+}
+
+bool containsText(const std::string& haystack, const std::string& needle) {
+    return haystack.find(needle) != std::string::npos;
+}
+
+std::string extractFunction(const std::string& content,
+                            const std::string& signature) {
+    const auto begin_pos = content.find(signature);
+    if (begin_pos == std::string::npos) {
+        return {};
+    }
+    const auto body_begin = content.find('{', begin_pos);
+    if (body_begin == std::string::npos) {
+        return {};
+    }
+
+    int depth = 0;
+    for (size_t index = body_begin; index < content.size(); ++index) {
+        if (content[index] == '{') {
+            ++depth;
+        } else if (content[index] == '}') {
+            --depth;
+            if (depth == 0) {
+                return content.substr(begin_pos, index - begin_pos + 1);
+            }
+        }
+    }
+    return {};
+}
+
+}  // namespace
+
+int main() {
+    const auto root = projectRoot();
+    const auto iocontroller = root / "galay-kernel" / "core" / "io_controller.hpp";
+    const auto iouring = root / "galay-kernel" / "core" / "uring_reactor.cc";
+    const auto runtime = root / "galay-kernel" / "core" / "runtime.cc";
+
+    const std::string iocontroller_text = readAll(iocontroller);
+    const std::string iouring_text = readAll(iouring);
+    const std::string runtime_text = readAll(runtime);
+    if (iocontroller_text.empty() || iouring_text.empty() || runtime_text.empty()) {
+        std::cerr << "[T178] failed to read source files\n";
+        return 1;
+    }
+
+    if (!containsText(iocontroller_text, "FixedFileSlot m_fixed_file")) {
+        std::cerr << "[T178] expected IOController to own a fixed-file slot\n";
+        return 1;
+    }
+    if (!containsText(iouring_text, "io_uring_register_files_sparse(")) {
+        std::cerr << "[T178] expected IOUringReactor to register a sparse fixed file table\n";
+        return 1;
+    }
+    if (!containsText(iouring_text, "IOSQE_FIXED_FILE")) {
+        std::cerr << "[T178] expected socket SQEs to be tagged with IOSQE_FIXED_FILE\n";
+        return 1;
+    }
+
+    const char* socket_paths[] = {
+        "int IOUringReactor::submitMultishotAccept(IOController* controller) {",
+        "int IOUringReactor::submitMultishotRecv(IOController* controller) {",
+        "int IOUringReactor::addSend(IOController* controller) {",
+        "int IOUringReactor::addWritev(IOController* controller) {",
+    };
+    for (const char* signature : socket_paths) {
+        const std::string body = extractFunction(iouring_text, signature);
+        if (body.empty() || !containsText(body, "applyFixedFile(sqe, controller)")) {
+            std::cerr << "[T178] expected fixed-file rewrite in " << signature << "\n";
+            return 1;
+        }
+    }
+
+    const char* file_paths[] = {
+        "int IOUringReactor::addFileRead(IOController* controller) {",
+        "int IOUringReactor::addFileWrite(IOController* controller) {",
+        "int IOUringReactor::addFileWatch(IOController* controller) {",
+    };
+    for (const char* signature : file_paths) {
+        const std::string body = extractFunction(iouring_text, signature);
+        if (body.empty() || containsText(body, "applyFixedFile")) {
+            std::cerr << "[T178] expected plain fd submission in " << signature << "\n";
+            return 1;
+        }
+    }
+
+    const std::string add_close = extractFunction(
+        iouring_text,
+        "int IOUringReactor::addClose(IOController* controller) {");
+    if (!containsText(add_close, "retireLocal(")) {
+        std::cerr << "[T178] expected addClose to retire the fixed-file slot on the owner thread\n";
+        return 1;
+    }
+    if (!containsText(iouring_text, "io_uring_prep_files_update(") ||
+        containsText(iouring_text, "io_uring_register_files_update(")) {
+        std::cerr << "[T178] expected fixed-file updates to ride the SQ instead of register syscalls\n";
+        return 1;
+    }
+    if (!containsText(runtime_text, "m_config.io_uring")) {
+        std::cerr << "[T178] expected Runtime to forward io_uring options to schedulers\n";
+        return 1;
+    }
+
+    std::cout << "T178-IOUringFixedFileSourceCase PASS\n";
+    return 0;
+}
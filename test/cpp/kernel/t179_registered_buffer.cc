@@ -0,0 +1,154 @@
+/**
+ * @file t179_registered_buffer.cc
+ * @brief 用途：验证文件 IO 切片 RegisteredBuffer 的所有权语义与租借回退。
+ * 关键覆盖点：槽位切片析构/移动覆盖时恰好归还一次、堆回退切片、resize 截断、
+ * 在 IO scheduler 上 co_await 租借总能得到容量足够的切片、切片在其它线程释放后槽位
+ * 仍能被再次租出、runtime 停止后才释放的切片不会触碰已关闭的池。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-kernel/core/registered_buffer.h>
+#include <array>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+using namespace galay::kernel;
+
+static_assert(!std::is_copy_constructible_v<RegisteredBuffer>,
+              "RegisteredBuffer leases a pool slot and must stay move-only");
+static_assert(std::is_nothrow_move_constructible_v<RegisteredBuffer>);
+
+namespace {
+
+struct FakePool {
+    std::array<char, 64> storage{};
+    int recycled = 0;
+    uint32_t last_index = 0;
+};
+
+void recycleFake(const std::shared_ptr<void>& owner, uint32_t index) noexcept {
+    auto* pool = static_cast<FakePool*>(owner.get());
+    ++pool->recycled;
+    pool->last_index = index;
+}
+
+RegisteredBuffer leaseFake(const std::shared_ptr<FakePool>& pool, uint32_t index) {
+    return RegisteredBuffer(std::static_pointer_cast<void>(pool),
+                            recycleFake,
+                            pool->storage.data() + index * 16,
+                            16,
+                            index);
+}
+
+Task<bool> leaseOnScheduler() {
+    RegisteredBuffer buffer = co_await RegisteredBufferLeaseAwaitable(1000);
+    co_return buffer.valid() && buffer.capacity() >= 1000 && buffer.size() == 0;
+}
+
+Task<bool> recycleFromAnotherThread() {
+    RegisteredBuffer first = co_await RegisteredBufferLeaseAwaitable(1000);
+    RegisteredBuffer second = co_await RegisteredBufferLeaseAwaitable(1000);
+    const bool pooled = first.registered() && second.registered();
+    std::thread([first = std::move(first), second = std::move(second)]() mutable {
+        first.release();
+        second.release();
+    }).join();
+    // 两个槽位都经远端队列归还，free list 耗尽时由下一次租借取回
+    RegisteredBuffer again = co_await RegisteredBufferLeaseAwaitable(1000);
+    RegisteredBuffer again_second = co_await RegisteredBufferLeaseAwaitable(1000);
+    co_return again.valid() && again_second.valid() &&
+              (!pooled || (again.registered() && again_second.registered()));
+}
+
+Task<RegisteredBuffer> leaseToKeep() {
+    co_return co_await RegisteredBufferLeaseAwaitable(1000);
+}
+
+}  // namespace
+
+int main() {
+    auto pool = std::make_shared<FakePool>();
+
+    {
+        RegisteredBuffer slot = leaseFake(pool, 2);
+        if (!slot.valid() || !slot.registered() || slot.index() != 2 || slot.owner() != pool.get()) {
+            std::cerr << "[T179] leased slot should expose pool metadata\n";
+            return 1;
+        }
+        RegisteredBuffer moved(std::move(slot));
+        if (slot.valid() || pool->recycled != 0) {
+            std::cerr << "[T179] move must transfer the slot without recycling it\n";
+            return 1;
+        }
+        moved.resize(100);
+        if (moved.size() != moved.capacity()) {
+            std::cerr << "[T179] resize should clamp to capacity\n";
+            return 1;
+        }
+    }
+    if (pool->recycled != 1 || pool->last_index != 2) {
+        std::cerr << "[T179] destroying a leased slot should recycle it exactly once\n";
+        return 1;
+    }
+
+    RegisteredBuffer first = leaseFake(pool, 0);
+    first = leaseFake(pool, 1);
+    if (pool->recycled != 2 || pool->last_index != 0) {
+        std::cerr << "[T179] move-assignment should return the overwritten slot\n";
+        return 1;
+    }
+    first.release();
+    if (pool->recycled != 3 || first.valid()) {
+        std::cerr << "[T179] release should recycle and invalidate the slice\n";
+        return 1;
+    }
+
+    RegisteredBuffer heap = RegisteredBuffer::heap(32);
+    if (!heap.valid() || heap.registered() || heap.capacity() != 32 || heap.owner() != nullptr) {
+        std::cerr << "[T179] heap fallback should be a valid unregistered slice\n";
+        return 1;
+    }
+
+    Runtime runtime = RuntimeBuilder()
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(0)
+        .ioUringRegisteredBuffers(2, 4096)
+        .build();
+    auto leased = runtime.blockOn(leaseOnScheduler());
+    if (!leased.has_value() || !*leased) {
+        std::cerr << "[T179] leasing on an IO scheduler should always yield a usable slice\n";
+        return 1;
+    }
+
+    auto cross_thread = runtime.blockOn(recycleFromAnotherThread());
+    if (!cross_thread.has_value() || !*cross_thread) {
+        std::cerr << "[T179] slots released on another thread should return to the pool\n";
+        return 1;
+    }
+
+    RegisteredBuffer survivor;
+    {
+        Runtime short_lived = RuntimeBuilder()
+            .ioSchedulerCount(1)
+            .computeSchedulerCount(0)
+            .ioUringRegisteredBuffers(1, 4096)
+            .build();
+        auto kept = short_lived.blockOn(leaseToKeep());
+        if (!kept.has_value() || !kept->valid()) {
+            std::cerr << "[T179] leasing a slice to keep should succeed\n";
+            return 1;
+        }
+        survivor = std::move(*kept);
+    }
+    std::thread([&survivor]() { survivor.release(); }).join();
+    if (survivor.valid()) {
+        std::cerr << "[T179] releasing after runtime shutdown should still invalidate the slice\n";
+        return 1;
+    }
+
+    std::cout << "T179-RegisteredBufferCase PASS\n";
+    return 0;
+}
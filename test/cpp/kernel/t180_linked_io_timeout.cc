@@ -0,0 +1,84 @@
+/**
+ * @file t180_linked_io_timeout.cc
+ * @brief 用途：验证一次性 IO `.timeout()` 在时间轮与 io_uring LINK_TIMEOUT 两条路径下语义一致。
+ * 关键覆盖点：空 socket 上 readv 到期返回 kTimeout、数据先到时正常完成、
+ * 到期后同一 socket 仍可继续收发；非 io_uring 后端两种配置都走时间轮。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/async/async_tcp.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+
+#include <sys/socket.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+
+using namespace galay::async;
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<bool> timeoutThenComplete(AsyncTcpSocket* writer, AsyncTcpSocket* reader)
+{
+    char in = 0;
+    std::array<struct iovec, 1> iovecs{{{&in, 1}}};
+
+    const auto start = std::chrono::steady_clock::now();
+    auto expired = co_await reader->readv(iovecs).timeout(20ms);
+    if (expired.has_value() || !IOError::contains(expired.error().code(), kTimeout)) {
+        std::cerr << "[T180] readv on an empty socket should time out\n";
+        co_return false;
+    }
+    if (std::chrono::steady_clock::now() - start < 15ms) {
+        std::cerr << "[T180] timeout fired before its deadline\n";
+        co_return false;
+    }
+
+    char out = 'k';
+    auto sent = co_await writer->send(&out, 1).timeout(1s);
+    if (!sent.has_value() || *sent != 1) {
+        std::cerr << "[T180] send after a timed-out readv should succeed\n";
+        co_return false;
+    }
+    auto received = co_await reader->readv(iovecs).timeout(1s);
+    if (!received.has_value() || *received != 1 || in != 'k') {
+        std::cerr << "[T180] readv with pending data should complete before its deadline\n";
+        co_return false;
+    }
+    co_return true;
+}
+
+bool runCase(bool linked)
+{
+    Runtime runtime = RuntimeBuilder()
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(0)
+        .ioUringLinkedTimeouts(linked)
+        .build();
+
+    int fds[2] = {-1, -1};
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) != 0) {
+        std::cerr << "[T180] socketpair failed\n";
+        return false;
+    }
+    AsyncTcpSocket writer(GHandle{.fd = fds[0]});
+    AsyncTcpSocket reader(GHandle{.fd = fds[1]});
+
+    auto ok = runtime.blockOn(timeoutThenComplete(&writer, &reader));
+    runtime.stop();
+    return ok.has_value() && *ok;
+}
+
+}  // namespace
+
+int main()
+{
+    if (!runCase(false) || !runCase(true)) {
+        return 1;
+    }
+    std::cout << "T180-LinkedIOTimeoutCase PASS\n";
+    return 0;
+}
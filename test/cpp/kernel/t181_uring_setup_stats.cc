@@ -0,0 +1,116 @@
+/**
+ * @file t181_uring_setup_stats.cc
+ * @brief 用途：验证 io_uring ring setup 策略与 RuntimeStats::io_uring_setups 快照。
+ * 关键覆盖点：kDefault / kSingleIssuer / kSharedSqpoll 三种策略下 socket 收发可用、
+ * 每个 IO scheduler 都有对齐的 setup 快照、共享 SQPOLL 的兄弟 ring 标记为已挂载、
+ * runtime 停止后重启（SINGLE_ISSUER 需要重建 ring）仍可继续 IO；非 io_uring 后端快照为 inactive。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/async/async_tcp.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+
+#include <sys/socket.h>
+
+#include <array>
+#include <iostream>
+
+using namespace galay::async;
+using namespace galay::kernel;
+
+namespace {
+
+Task<bool> pingPong(int writer_fd, int reader_fd)
+{
+    AsyncTcpSocket writer(GHandle{.fd = writer_fd});
+    AsyncTcpSocket reader(GHandle{.fd = reader_fd});
+    char out = 'p';
+    char in = 0;
+    std::array<struct iovec, 1> iovecs{{{&in, 1}}};
+    auto sent = co_await writer.send(&out, 1);
+    if (!sent.has_value() || *sent != 1) {
+        co_return false;
+    }
+    auto received = co_await reader.readv(iovecs);
+    co_return received.has_value() && *received == 1 && in == 'p';
+}
+
+bool roundTrip(Runtime& runtime)
+{
+    int fds[2] = {-1, -1};
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) != 0) {
+        return false;
+    }
+    auto ok = runtime.blockOn(pingPong(fds[0], fds[1]));
+    return ok.has_value() && *ok;
+}
+
+bool runCase(IOUringSetupMode mode, const char* name)
+{
+    Runtime runtime = RuntimeBuilder()
+        .ioSchedulerCount(2)
+        .computeSchedulerCount(0)
+        .ioUringSetupMode(mode)
+        .build();
+
+    if (!roundTrip(runtime)) {
+        std::cerr << "[T181] " << name << ": socket round trip failed\n";
+        return false;
+    }
+
+    const auto stats = runtime.stats();
+    if (stats.io_uring_setups.size() != 2) {
+        std::cerr << "[T181] " << name << ": expected two setup snapshots, actual="
+                  << stats.io_uring_setups.size() << "\n";
+        return false;
+    }
+    for (const auto& setup : stats.io_uring_setups) {
+#if defined(USE_IOURING)
+        if (!setup.active || setup.requested != mode) {
+            std::cerr << "[T181] " << name << ": io_uring setup snapshot should be active\n";
+            return false;
+        }
+#else
+        if (setup.active) {
+            std::cerr << "[T181] " << name << ": non io_uring backend should report inactive setup\n";
+            return false;
+        }
+#endif
+    }
+
+#if defined(USE_IOURING)
+    if (mode == IOUringSetupMode::kSharedSqpoll) {
+        const auto& anchor = stats.io_uring_setups[0];
+        const auto& sibling = stats.io_uring_setups[1];
+        if (anchor.sq_thread_shared) {
+            std::cerr << "[T181] " << name << ": first ring should own the SQPOLL thread\n";
+            return false;
+        }
+        if (!anchor.fallback && !sibling.fallback && !sibling.sq_thread_shared) {
+            std::cerr << "[T181] " << name << ": sibling ring should attach to the shared SQPOLL thread\n";
+            return false;
+        }
+    }
+#endif
+
+    runtime.stop();
+    if (!runtime.start().has_value() || !roundTrip(runtime)) {
+        std::cerr << "[T181] " << name << ": round trip after restart failed\n";
+        return false;
+    }
+    runtime.stop();
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    if (!runCase(IOUringSetupMode::kDefault, "default") ||
+        !runCase(IOUringSetupMode::kSingleIssuer, "single-issuer") ||
+        !runCase(IOUringSetupMode::kSharedSqpoll, "shared-sqpoll")) {
+        return 1;
+    }
+    std::cout << "T181-IOUringSetupStatsCase PASS\n";
+    return 0;
+}
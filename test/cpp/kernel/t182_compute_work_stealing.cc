@@ -0,0 +1,179 @@
+/**
+ * @file t182_compute_work_stealing.cc
+ * @brief 用途：验证 ComputeScheduler 池模式在倾斜负载下的窃取与停泊唤醒。
+ * 关键覆盖点：全部任务从外部线程压到同一个调度器时 sibling 能窃取执行、
+ * 池内协程派生的子任务被挤出 LIFO 槽后可被窃取、停止后重启仍能接纳任务、
+ * Runtime 开启 computeWorkStealing 后 RuntimeStats::compute_schedulers 与调度器对齐。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/core/compute_scheduler.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-kernel/core/task.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t kPoolSize = 4;
+constexpr int kSkewedTasks = 2000;
+constexpr int kSpawnedChildren = 512;
+
+struct Progress {
+    std::atomic<int> completed{0};
+};
+
+void burn(std::chrono::microseconds budget)
+{
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+}
+
+Task<void> busyTask(Progress* progress)
+{
+    burn(50us);
+    progress->completed.fetch_add(1, std::memory_order_relaxed);
+    co_return;
+}
+
+Task<void> forkTask(ComputeScheduler* owner, Progress* progress)
+{
+    for (int i = 0; i < kSpawnedChildren; ++i) {
+        (void)scheduleTask(*owner, busyTask(progress));
+    }
+    co_return;
+}
+
+bool waitFor(const Progress& progress, int expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (progress.completed.load(std::memory_order_relaxed) < expected) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+uint64_t siblingSteals(const std::vector<std::unique_ptr<ComputeScheduler>>& pool)
+{
+    uint64_t steals = 0;
+    for (size_t i = 1; i < pool.size(); ++i) {
+        steals += pool[i]->stealStats().steal_successes;
+    }
+    return steals;
+}
+
+bool testPooledScheduler()
+{
+    std::vector<std::unique_ptr<ComputeScheduler>> pool;
+    std::vector<ComputeScheduler*> view;
+    for (size_t i = 0; i < kPoolSize; ++i) {
+        pool.push_back(std::make_unique<ComputeScheduler>());
+        view.push_back(pool.back().get());
+    }
+    const std::span<ComputeScheduler* const> siblings{view.data(), view.size()};
+    for (size_t i = 0; i < siblings.size(); ++i) {
+        siblings[i]->configureStealDomain(siblings, i);
+        if (!siblings[i]->isPooled() || !siblings[i]->start().has_value()) {
+            std::cerr << "[T182] pooled scheduler failed to start\n";
+            return false;
+        }
+    }
+
+    Progress skewed;
+    for (int i = 0; i < kSkewedTasks; ++i) {
+        if (!scheduleTask(*pool[0], busyTask(&skewed))) {
+            std::cerr << "[T182] skewed submit rejected\n";
+            return false;
+        }
+    }
+    if (!waitFor(skewed, kSkewedTasks)) {
+        std::cerr << "[T182] skewed load timed out, completed=" << skewed.completed.load() << "\n";
+        return false;
+    }
+
+    Progress forked;
+    if (!scheduleTask(*pool[0], forkTask(pool[0].get(), &forked)) ||
+        !waitFor(forked, kSpawnedChildren)) {
+        std::cerr << "[T182] locally spawned children did not complete\n";
+        return false;
+    }
+
+    for (auto& scheduler : pool) {
+        scheduler->stop();
+    }
+    if (siblingSteals(pool) == 0) {
+        std::cerr << "[T182] idle siblings never stole from the loaded scheduler\n";
+        return false;
+    }
+
+    for (auto& scheduler : pool) {
+        if (!scheduler->start().has_value()) {
+            std::cerr << "[T182] pooled scheduler failed to restart\n";
+            return false;
+        }
+    }
+    Progress restarted;
+    for (int i = 0; i < 64; ++i) {
+        (void)scheduleTask(*pool[i % kPoolSize], busyTask(&restarted));
+    }
+    const bool ok = waitFor(restarted, 64);
+    for (auto& scheduler : pool) {
+        scheduler->stop();
+    }
+    if (!ok) {
+        std::cerr << "[T182] restarted pool did not drain\n";
+    }
+    return ok;
+}
+
+bool testRuntimeStats()
+{
+    Runtime runtime = RuntimeBuilder()
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(3)
+        .computeWorkStealing(true)
+        .build();
+    if (!runtime.start().has_value()) {
+        std::cerr << "[T182] runtime failed to start\n";
+        return false;
+    }
+
+    Progress progress;
+    for (int i = 0; i < 256; ++i) {
+        (void)scheduleTask(*runtime.getComputeScheduler(0), busyTask(&progress));
+    }
+    const bool drained = waitFor(progress, 256);
+    const bool pooled = runtime.getComputeScheduler(2)->isPooled();
+    runtime.stop();
+
+    const auto stats = runtime.stats();
+    if (!drained || !pooled || stats.compute_schedulers.size() != 3) {
+        std::cerr << "[T182] runtime pool mismatch: drained=" << drained << " pooled=" << pooled
+                  << " snapshots=" << stats.compute_schedulers.size() << "\n";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    if (!testPooledScheduler() || !testRuntimeStats()) {
+        return 1;
+    }
+    std::cout << "T182-ComputeWorkStealing PASS\n";
+    return 0;
+}
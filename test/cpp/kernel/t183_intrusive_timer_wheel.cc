@@ -0,0 +1,189 @@
+/**
+ * @file t183_intrusive_timer_wheel.cc
+ * @brief 用途：验证时间轮侵入式槽位的摘除、所有权与重入语义。
+ * 关键覆盖点：erase() O(1) 解链并立即释放时间轮持有的引用、同一定时器不可重复挂轮、
+ * 只能由所属时间轮摘除、到期回调中摘除同槽 sibling、跨层级联后仍可摘除、
+ * 时间轮移动后摘除仍有效、时间轮销毁时释放全部未到期定时器、
+ * sleep()/.timeout() 的定时器节点从线程帧池复用而非每次走全局堆。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/common/timer_manager.hpp>
+#include <galay/cpp/galay-kernel/common/timer_manager_mt.hpp>
+#include <galay/cpp/galay-kernel/common/sleep.hpp>
+#include <galay/cpp/galay-kernel/core/task.h>
+#include "test/cpp/common/test_require.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint64_t kTickNs = 1'000'000ULL;
+
+void tickUntil(TimingWheelTimerManager& manager, const std::atomic<int>& fired, int expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (fired.load(std::memory_order_relaxed) < expected &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+        manager.tick();
+    }
+}
+
+bool testEraseReleasesReference()
+{
+    TimingWheelTimerManager manager(kTickNs);
+    std::atomic<int> fired{0};
+    auto timer = std::make_shared<CBTimer>(20ms, [&fired]() { fired.fetch_add(1); });
+
+    GALAY_TEST_REQUIRE(manager.push(timer));
+    GALAY_TEST_REQUIRE(timer.use_count() == 2);
+    GALAY_TEST_REQUIRE(!manager.push(timer));  // 已挂轮
+    GALAY_TEST_REQUIRE(manager.size() == 1);
+
+    timer->cancel();
+    GALAY_TEST_REQUIRE(manager.erase(*timer));
+    GALAY_TEST_REQUIRE(timer.use_count() == 1);
+    GALAY_TEST_REQUIRE(manager.empty());
+    GALAY_TEST_REQUIRE(!manager.erase(*timer));
+
+    std::this_thread::sleep_for(30ms);
+    manager.tick();
+    GALAY_TEST_REQUIRE(fired.load() == 0);
+    return true;
+}
+
+bool testEraseRequiresOwningWheel()
+{
+    TimingWheelTimerManager first(kTickNs);
+    TimingWheelTimerManager second(kTickNs);
+    auto timer = std::make_shared<CBTimer>(50ms, []() {});
+
+    GALAY_TEST_REQUIRE(first.push(timer));
+    GALAY_TEST_REQUIRE(!second.push(timer));
+    GALAY_TEST_REQUIRE(!second.erase(*timer));
+    GALAY_TEST_REQUIRE(first.size() == 1);
+
+    TimingWheelTimerManager moved(std::move(first));
+    GALAY_TEST_REQUIRE(moved.erase(*timer));
+    GALAY_TEST_REQUIRE(moved.empty());
+    GALAY_TEST_REQUIRE(second.push(timer));
+    return true;
+}
+
+bool testEraseSiblingFromCallback()
+{
+    TimingWheelTimerManager manager(kTickNs);
+    std::atomic<int> fired{0};
+    std::shared_ptr<CBTimer> victim;
+    auto killer = std::make_shared<CBTimer>(5ms, [&]() {
+        fired.fetch_add(1);
+        if (victim) {
+            victim->cancel();
+            (void)manager.erase(*victim);
+        }
+    });
+    victim = std::make_shared<CBTimer>(5ms, [&fired]() { fired.fetch_add(100); });
+
+    GALAY_TEST_REQUIRE(manager.push(killer));
+    GALAY_TEST_REQUIRE(manager.push(victim));
+    tickUntil(manager, fired, 1);
+    std::this_thread::sleep_for(5ms);
+    manager.tick();
+
+    GALAY_TEST_REQUIRE(fired.load() == 1);
+    GALAY_TEST_REQUIRE(manager.empty());
+    GALAY_TEST_REQUIRE(victim.use_count() == 1);
+    return true;
+}
+
+bool testEraseAfterCascade()
+{
+    // 300 tick 落在第2层，级联进第1层后仍能被摘除。
+    TimingWheelTimerManager manager(kTickNs);
+    std::atomic<int> fired{0};
+    auto anchor = std::make_shared<CBTimer>(400ms, [&fired]() { fired.fetch_add(1); });
+    auto cascaded = std::make_shared<CBTimer>(300ms, [&fired]() { fired.fetch_add(100); });
+
+    GALAY_TEST_REQUIRE(manager.push(anchor));
+    GALAY_TEST_REQUIRE(manager.push(cascaded));
+
+    const auto deadline = std::chrono::steady_clock::now() + 280ms;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(2ms);
+        manager.tick();
+    }
+    GALAY_TEST_REQUIRE(manager.size() == 2);
+    cascaded->cancel();
+    GALAY_TEST_REQUIRE(manager.erase(*cascaded));
+
+    tickUntil(manager, fired, 1);
+    GALAY_TEST_REQUIRE(fired.load() == 1);
+    GALAY_TEST_REQUIRE(manager.empty());
+    return true;
+}
+
+bool testDestructionReleasesTimers()
+{
+    std::vector<std::weak_ptr<Timer>> watched;
+    {
+        TimingWheelTimerManager manager(kTickNs);
+        ThreadSafeTimerManager shared_manager(kTickNs);
+        for (int i = 0; i < 64; ++i) {
+            auto local = std::make_shared<CBTimer>(std::chrono::seconds(1 + i * 60), []() {});
+            auto remote = std::make_shared<CBTimer>(std::chrono::seconds(1 + i * 60), []() {});
+            watched.push_back(local);
+            watched.push_back(remote);
+            GALAY_TEST_REQUIRE(manager.push(std::move(local)));
+            GALAY_TEST_REQUIRE(shared_manager.push(std::move(remote)));
+        }
+        shared_manager.tick();
+        GALAY_TEST_REQUIRE(manager.size() == 64);
+        GALAY_TEST_REQUIRE(shared_manager.wheelSize() == 64);
+    }
+    for (const auto& timer : watched) {
+        GALAY_TEST_REQUIRE(timer.expired());
+    }
+    return true;
+}
+
+bool testTimerNodesReuseFramePool()
+{
+#ifndef GALAY_DISABLE_TASK_FRAME_POOL
+    constexpr int kRounds = 16;
+    { SleepAwaitable warm(1ms); }
+    const auto before = detail::currentThreadTaskFramePoolStats();
+    for (int i = 0; i < kRounds; ++i) {
+        SleepAwaitable sleep(1ms);
+        GALAY_TEST_REQUIRE(sleep.m_timer.use_count() == 1);
+    }
+    const auto after = detail::currentThreadTaskFramePoolStats();
+    GALAY_TEST_REQUIRE(after.hits - before.hits == static_cast<uint64_t>(kRounds));
+    GALAY_TEST_REQUIRE(after.misses == before.misses);
+#endif
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    if (!testEraseReleasesReference() ||
+        !testEraseRequiresOwningWheel() ||
+        !testEraseSiblingFromCallback() ||
+        !testEraseAfterCascade() ||
+        !testDestructionReleasesTimers() ||
+        !testTimerNodesReuseFramePool()) {
+        return 1;
+    }
+    std::cout << "T183-IntrusiveTimerWheel PASS\n";
+    return 0;
+}
@@ -0,0 +1,352 @@
+/**
+ * @file t184_udp_batch.cc
+ * @brief 用途：验证 AsyncUdpSocket::recvBatch/sendBatch 的批量语义与 GSO/GRO 辅助。
+ * 关键覆盖点：一次 recvBatch 交付多个数据报且保持边界与顺序、槽位不足时余下数据报留给下一次、
+ * 超出容量的数据报标记 truncated、sendBatch 向多个目标发送、GSO 条目按段切分到线上、
+ * UdpRecvDatagram::segment() 按 GRO 段大小原地拆分、空 span 立即返回 0。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <galay/cpp/galay-kernel/async/async_udp.h>
+#include <galay/cpp/galay-kernel/core/task.h>
+#include "test/cpp/common/stdout_log.h"
+
+#ifdef USE_KQUEUE
+#include <galay/cpp/galay-kernel/core/kqueue_scheduler.h>
+#endif
+
+#ifdef USE_EPOLL
+#include <galay/cpp/galay-kernel/core/epoll_scheduler.h>
+#endif
+
+#ifdef USE_IOURING
+#include <galay/cpp/galay-kernel/core/uring_scheduler.h>
+#endif
+
+using namespace galay::async;
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kBurst = 10;
+constexpr size_t kSlotSize = 256;
+constexpr size_t kOversize = 600;
+
+std::atomic<bool> g_done{false};
+std::string g_error;
+
+void fail(std::string message)
+{
+    if (g_error.empty()) {
+        g_error = std::move(message);
+    }
+}
+
+uint16_t socketPort(int fd)
+{
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return 0;
+    }
+    return ntohs(address.sin_port);
+}
+
+int openLoopbackSocket()
+{
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    timeval timeout{.tv_sec = 2, .tv_usec = 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+bool sendRaw(int fd, uint16_t port, const void* data, size_t length)
+{
+    sockaddr_in target{};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(port);
+    target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return ::sendto(fd, data, length, 0, reinterpret_cast<const sockaddr*>(&target), sizeof(target)) ==
+           static_cast<ssize_t>(length);
+}
+
+std::string payloadFor(int index)
+{
+    return "batch-" + std::to_string(index);
+}
+
+struct Slots {
+    explicit Slots(size_t count)
+        : storage(count * kSlotSize), datagrams(count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            datagrams[i].buffer = storage.data() + i * kSlotSize;
+            datagrams[i].capacity = kSlotSize;
+        }
+    }
+
+    std::vector<char> storage;
+    std::vector<UdpRecvDatagram> datagrams;
+};
+
+Task<void> recvBatchScenario(AsyncUdpSocket& socket, int peer_fd)
+{
+    const uint16_t port = socketPort(socket.handle().fd);
+    for (int i = 0; i < kBurst; ++i) {
+        const auto payload = payloadFor(i);
+        if (!sendRaw(peer_fd, port, payload.data(), payload.size())) {
+            fail("raw burst send failed");
+            co_return;
+        }
+    }
+    const std::string oversize(kOversize, 'x');
+    if (!sendRaw(peer_fd, port, oversize.data(), oversize.size())) {
+        fail("raw oversize send failed");
+        co_return;
+    }
+
+    // 4 个槽位：第一次必须只交付前 4 个，其余留在内核/就绪队列
+    Slots small(4);
+    auto first = co_await socket.recvBatch(small.datagrams).timeout(2s);
+    if (!first || first.value() == 0 || first.value() > small.datagrams.size()) {
+        fail("first recvBatch returned no datagrams or overflowed the span");
+        co_return;
+    }
+    int next = 0;
+    for (size_t i = 0; i < first.value(); ++i, ++next) {
+        const auto& slot = small.datagrams[i];
+        if (std::string_view(slot.buffer, slot.length) != payloadFor(next) ||
+            slot.truncated || slot.segmentCount() != 1 ||
+            ntohs(reinterpret_cast<const sockaddr_in*>(slot.from.sockAddr())->sin_port) !=
+                socketPort(peer_fd)) {
+            fail("recvBatch broke datagram boundary, order or source at index " + std::to_string(next));
+            co_return;
+        }
+    }
+
+    Slots large(16);
+    bool saw_oversize = false;
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (!saw_oversize && std::chrono::steady_clock::now() < deadline) {
+        auto more = co_await socket.recvBatch(large.datagrams).timeout(2s);
+        if (!more) {
+            fail("follow-up recvBatch failed: " + more.error().message());
+            co_return;
+        }
+        for (size_t i = 0; i < more.value(); ++i) {
+            const auto& slot = large.datagrams[i];
+            if (next < kBurst) {
+                if (std::string_view(slot.buffer, slot.length) != payloadFor(next)) {
+                    fail("follow-up recvBatch lost or reordered index " + std::to_string(next));
+                    co_return;
+                }
+                ++next;
+                continue;
+            }
+            if (slot.length != kSlotSize || !slot.truncated) {
+                fail("oversize datagram was not reported as truncated");
+                co_return;
+            }
+            saw_oversize = true;
+        }
+    }
+    if (next != kBurst || !saw_oversize) {
+        fail("recvBatch did not deliver the whole burst");
+        co_return;
+    }
+
+    auto empty = co_await socket.recvBatch(std::span<UdpRecvDatagram>{});
+    if (!empty || empty.value() != 0) {
+        fail("empty recvBatch span must complete immediately with 0");
+    }
+    co_return;
+}
+
+Task<void> sendBatchScenario(AsyncUdpSocket& socket, int first_fd, int second_fd)
+{
+    const std::array<std::string, 4> payloads{"to-a-0", "to-b-0", "to-a-1", "to-b-1"};
+    const Host first(IPType::IPV4, "127.0.0.1", socketPort(first_fd));
+    const Host second(IPType::IPV4, "127.0.0.1", socketPort(second_fd));
+    std::array<UdpSendDatagram, 4> batch{};
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].buffer = payloads[i].data();
+        batch[i].length = payloads[i].size();
+        batch[i].to = (i % 2 == 0) ? first : second;
+    }
+
+    size_t offset = 0;
+    while (offset < batch.size()) {
+        auto sent = co_await socket.sendBatch(std::span<const UdpSendDatagram>(batch).subspan(offset));
+        if (!sent || sent.value() == 0) {
+            fail("sendBatch failed");
+            co_return;
+        }
+        offset += sent.value();
+    }
+
+    char buffer[64];
+    for (const int fd : {first_fd, second_fd}) {
+        for (int round = 0; round < 2; ++round) {
+            const ssize_t bytes = ::recv(fd, buffer, sizeof(buffer), 0);
+            const auto& expected = payloads[(fd == first_fd ? 0 : 1) + round * 2];
+            if (bytes < 0 || std::string_view(buffer, static_cast<size_t>(bytes)) != expected) {
+                fail("sendBatch delivered wrong payload to " + expected);
+                co_return;
+            }
+        }
+    }
+
+#if defined(__linux__)
+    // GSO：一个 2500 字节条目按 1000 切成 1000/1000/500 三个线上数据报
+    std::string segmented(2500, '\0');
+    for (size_t i = 0; i < segmented.size(); ++i) {
+        segmented[i] = static_cast<char>('a' + i / 1000);
+    }
+    std::array<UdpSendDatagram, 1> gso{};
+    gso[0].buffer = segmented.data();
+    gso[0].length = segmented.size();
+    gso[0].to = first;
+    gso[0].segment_size = 1000;
+    auto gso_sent = co_await socket.sendBatch(gso);
+    if (!gso_sent) {
+        LogInfo("T184 GSO skipped: {}", gso_sent.error().message());
+        co_return;
+    }
+    char segment[2048];
+    for (size_t expected : {1000, 1000, 500}) {
+        const ssize_t bytes = ::recv(first_fd, segment, sizeof(segment), 0);
+        if (bytes != static_cast<ssize_t>(expected)) {
+            fail("GSO entry was not split into segment_size datagrams");
+            co_return;
+        }
+    }
+#endif
+    co_return;
+}
+
+Task<void> runScenarios()
+{
+    auto created = AsyncUdpSocket::create();
+    const int peer_fd = openLoopbackSocket();
+    const int second_fd = openLoopbackSocket();
+    if (!created || peer_fd < 0 || second_fd < 0) {
+        fail("socket setup failed");
+    } else {
+        AsyncUdpSocket socket = std::move(*created);
+        auto non_block = socket.option().handleNonBlock();
+        auto bound = socket.bind(Host(IPType::IPV4, "127.0.0.1", 0));
+        if (!non_block || !bound) {
+            fail("async socket setup failed");
+        } else {
+            co_await recvBatchScenario(socket, peer_fd);
+            if (g_error.empty()) {
+                co_await sendBatchScenario(socket, peer_fd, second_fd);
+            }
+        }
+        (void)co_await socket.close();
+    }
+    if (peer_fd >= 0) {
+        ::close(peer_fd);
+    }
+    if (second_fd >= 0) {
+        ::close(second_fd);
+    }
+    g_done.store(true, std::memory_order_release);
+    co_return;
+}
+
+bool checkSegmentViews()
+{
+    char storage[2600];
+    UdpRecvDatagram coalesced;
+    coalesced.buffer = storage;
+    coalesced.capacity = sizeof(storage);
+    coalesced.length = 2500;
+    coalesced.segment_size = 1000;
+    if (coalesced.segmentCount() != 3 ||
+        coalesced.segment(0).data() != storage ||
+        coalesced.segment(1).size() != 1000 ||
+        coalesced.segment(2).data() != storage + 2000 ||
+        coalesced.segment(2).size() != 500 ||
+        !coalesced.segment(3).empty()) {
+        return false;
+    }
+    UdpRecvDatagram plain;
+    plain.buffer = storage;
+    plain.length = 7;
+    return plain.segmentCount() == 1 && plain.segment(0).size() == 7 && plain.segment(1).empty();
+}
+
+}  // namespace
+
+int main()
+{
+    if (!checkSegmentViews()) {
+        LogError("UdpRecvDatagram segment views are wrong");
+        return 1;
+    }
+
+#ifdef USE_KQUEUE
+    KqueueScheduler scheduler;
+#elif defined(USE_EPOLL)
+    EpollScheduler scheduler;
+#elif defined(USE_IOURING)
+    IOUringScheduler scheduler;
+#else
+    LogInfo("T184-UdpBatch skipped: requires kqueue, epoll or io_uring");
+    return 0;
+#endif
+
+    auto started = scheduler.start();
+    if (!started) {
+        LogError("scheduler start failed: {}", started.error().message());
+        return 1;
+    }
+    if (!scheduleTask(scheduler, runScenarios())) {
+        scheduler.stop();
+        LogError("failed to schedule UDP batch scenarios");
+        return 1;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (!g_done.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(2ms);
+    }
+    scheduler.stop();
+
+    if (!g_done.load(std::memory_order_acquire)) {
+        LogError("UDP batch test timed out");
+        return 1;
+    }
+    if (!g_error.empty()) {
+        LogError("UDP batch test failed: {}", g_error);
+        return 1;
+    }
+    LogInfo("T184-UdpBatch PASS");
+    return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file t185_numa_runtime.cc
+ * @brief 用途：验证 NUMA 拓扑发现、同节点优先窃取与 Runtime 的 Numa 放置模式。
+ * 关键覆盖点：sysfs cpulist 解析、伪造 sysfs 目录的节点发现、
+ * 同节点 victim 存在时跨节点 worker 在退避期内不窃取、退避为 0 时跨节点窃取计入 cross_node_steals、
+ * RuntimeBuilder::numaAffinity() 后 RuntimeStats::numa_nodes 与 scheduler 放置对齐。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/core/compute_scheduler.h>
+#include <galay/cpp/galay-kernel/core/numa_topology.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-kernel/core/task.h>
+#include "test/cpp/common/test_require.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kSpawnedChildren = 512;
+
+struct Progress {
+    std::atomic<int> completed{0};
+};
+
+Task<void> busyTask(Progress* progress)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 50us;
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+    progress->completed.fetch_add(1, std::memory_order_relaxed);
+    co_return;
+}
+
+Task<void> forkTask(ComputeScheduler* owner, Progress* progress)
+{
+    for (int i = 0; i < kSpawnedChildren; ++i) {
+        (void)scheduleTask(*owner, busyTask(progress));
+    }
+    co_return;
+}
+
+bool waitFor(const Progress& progress, int expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (progress.completed.load(std::memory_order_relaxed) < expected) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+bool testParseCpuList()
+{
+    const auto cpus = NumaTopology::parseCpuList("0-3,8,10-11\n");
+    GALAY_TEST_REQUIRE((cpus == std::vector<uint32_t>{0, 1, 2, 3, 8, 10, 11}));
+    GALAY_TEST_REQUIRE((NumaTopology::parseCpuList("5,1-2,2,x,4-3") == std::vector<uint32_t>{1, 2, 5}));
+    GALAY_TEST_REQUIRE(NumaTopology::parseCpuList("\n").empty());
+    return true;
+}
+
+bool testDiscoverFromSysfs()
+{
+    const auto root = std::filesystem::temp_directory_path() /
+                      ("t185_numa_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(root);
+    const auto writeCpuList = [&root](const char* node, const char* cpulist) {
+        std::filesystem::create_directories(root / node);
+        std::ofstream(root / node / "cpulist") << cpulist;
+    };
+    writeCpuList("node1", "4-7\n");
+    writeCpuList("node0", "0-3\n");
+    writeCpuList("node2", "\n");          // 纯内存节点
+    writeCpuList("nodefoo", "8-9\n");     // 非节点目录
+    std::filesystem::create_directories(root / "possible");
+
+    const auto topology = NumaTopology::discover(root.string());
+    std::filesystem::remove_all(root);
+
+    GALAY_TEST_REQUIRE(topology.nodeCount() == 2);
+    GALAY_TEST_REQUIRE(topology.nodes()[0].id == 0);
+    GALAY_TEST_REQUIRE(topology.nodes()[1].id == 1);
+    GALAY_TEST_REQUIRE((topology.nodes()[1].cpus == std::vector<uint32_t>{4, 5, 6, 7}));
+    GALAY_TEST_REQUIRE(topology.nodeOfCpu(6) == 1u);
+    GALAY_TEST_REQUIRE(!topology.nodeOfCpu(9).has_value());
+    GALAY_TEST_REQUIRE(NumaTopology::discover("/nonexistent/t185").empty());
+
+    const auto current = NumaTopology::current(4);
+    GALAY_TEST_REQUIRE(!current.empty());
+    return true;
+}
+
+/**
+ * 三个池化 scheduler：0 与 1 在节点 0，2 在节点 1。
+ * 全部负载由 0 上的协程就地派生；backoff 为 max 时 2 永远不会越过节点，只有 1 能窃取。
+ * 第二轮把 1 也放到节点 1 且 backoff 为 0，跨节点窃取应发生并单独计数。
+ */
+bool runSkewedPool(const std::vector<uint32_t>& nodes, uint32_t backoff,
+                   std::vector<IOSchedulerStealStats>& stats)
+{
+    std::vector<std::unique_ptr<ComputeScheduler>> pool;
+    std::vector<ComputeScheduler*> view;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        pool.push_back(std::make_unique<ComputeScheduler>());
+        view.push_back(pool.back().get());
+    }
+    const std::span<ComputeScheduler* const> siblings{view.data(), view.size()};
+    for (size_t i = 0; i < siblings.size(); ++i) {
+        siblings[i]->configureStealDomain(siblings, i);
+        siblings[i]->stealWorkerState()->configureNumaStealing(nodes[i], backoff);
+        GALAY_TEST_REQUIRE(siblings[i]->start().has_value());
+    }
+
+    Progress progress;
+    GALAY_TEST_REQUIRE(scheduleTask(*pool[0], forkTask(pool[0].get(), &progress)));
+    const bool drained = waitFor(progress, kSpawnedChildren);
+    for (auto& scheduler : pool) {
+        scheduler->stop();
+    }
+    GALAY_TEST_REQUIRE(drained);
+
+    stats.clear();
+    for (auto& scheduler : pool) {
+        stats.push_back(scheduler->stealStats());
+    }
+    return true;
+}
+
+bool testSameNodePreference()
+{
+    std::vector<IOSchedulerStealStats> stats;
+    GALAY_TEST_REQUIRE(runSkewedPool({0, 0, 1}, std::numeric_limits<uint32_t>::max(), stats));
+    GALAY_TEST_REQUIRE(stats[1].numa_node == 0 && stats[2].numa_node == 1);
+    GALAY_TEST_REQUIRE(stats[1].same_node_steals > 0);
+    GALAY_TEST_REQUIRE(stats[1].cross_node_steals == 0);
+    GALAY_TEST_REQUIRE(stats[2].steal_successes == 0);
+    GALAY_TEST_REQUIRE(stats[1].steal_successes == stats[1].same_node_steals + stats[1].cross_node_steals);
+
+    GALAY_TEST_REQUIRE(runSkewedPool({0, 1}, 0, stats));
+    GALAY_TEST_REQUIRE(stats[1].cross_node_steals > 0);
+    GALAY_TEST_REQUIRE(stats[1].same_node_steals == 0);
+    return true;
+}
+
+bool testRuntimeNumaStats()
+{
+    Runtime runtime = RuntimeBuilder()
+        .ioSchedulerCount(2)
+        .computeSchedulerCount(3)
+        .computeWorkStealing(true)
+        .numaAffinity(2)
+        .build();
+    GALAY_TEST_REQUIRE(runtime.start().has_value());
+
+    Progress progress;
+    for (int i = 0; i < 256; ++i) {
+        (void)scheduleTask(*runtime.getComputeScheduler(0), busyTask(&progress));
+    }
+    const bool drained = waitFor(progress, 256);
+    runtime.stop();
+    GALAY_TEST_REQUIRE(drained);
+
+    const auto& topology = runtime.numaTopology();
+    const auto stats = runtime.stats();
+    GALAY_TEST_REQUIRE(!topology.empty());
+    GALAY_TEST_REQUIRE(stats.numa_nodes.size() == topology.nodeCount());
+
+    size_t io_total = 0;
+    size_t compute_total = 0;
+    uint64_t steals = 0;
+    for (size_t i = 0; i < stats.numa_nodes.size(); ++i) {
+        const auto& node = stats.numa_nodes[i];
+        GALAY_TEST_REQUIRE(node.node == topology.nodes()[i].id);
+        io_total += node.io_schedulers;
+        compute_total += node.compute_schedulers;
+        steals += node.same_node_steals + node.cross_node_steals;
+    }
+    GALAY_TEST_REQUIRE(io_total == 2 && compute_total == 3);
+
+    uint64_t expected_steals = 0;
+    for (size_t i = 0; i < runtime.getComputeSchedulerCount(); ++i) {
+        const auto node = runtime.getComputeScheduler(i)->numaNode();
+        GALAY_TEST_REQUIRE(node == topology.nodes()[i % topology.nodeCount()].id);
+        expected_steals += stats.compute_schedulers[i].steal_successes;
+    }
+    for (const auto& io : stats.io_schedulers) {
+        expected_steals += io.steal_successes;
+    }
+    GALAY_TEST_REQUIRE(steals == expected_steals);
+
+    Runtime plain = RuntimeBuilder().ioSchedulerCount(1).computeSchedulerCount(1).build();
+    GALAY_TEST_REQUIRE(plain.stats().numa_nodes.empty());
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    if (!testParseCpuList() ||
+        !testDiscoverFromSysfs() ||
+        !testSameNodePreference() ||
+        !testRuntimeNumaStats()) {
+        return 1;
+    }
+    std::cout << "T185-NumaRuntime PASS\n";
+    return 0;
+}
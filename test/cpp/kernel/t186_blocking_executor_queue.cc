@@ -0,0 +1,179 @@
+/**
+ * @file t186_blocking_executor_queue.cc
+ * @brief 用途：验证 BlockingExecutor 无锁分片队列、BlockingTask 小缓冲与弹性伸缩。
+ * 关键覆盖点：小闭包内联存放、大闭包退回堆、move-only 捕获可提交、
+ * 多线程突发提交超过分片容量后全部执行且只执行一次、停泊线程被复用而不超过 maxWorkers、
+ * 保活超时后收缩到 minWorkers、收缩后再次提交仍能拉起线程、析构时排空积压任务。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/core/blocking_executor.h>
+#include "test/cpp/common/test_require.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+bool waitUntil(auto&& predicate, std::chrono::milliseconds timeout = 5000ms)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+bool testBlockingTaskStorage()
+{
+    int hits = 0;
+    BlockingTask small([&hits]() { ++hits; });
+    GALAY_TEST_REQUIRE(small && small.storedInline());
+
+    std::array<char, BlockingTask::kInlineSize + 8> payload{};
+    payload[0] = 3;
+    BlockingTask large([&hits, payload]() { hits += payload[0]; });
+    GALAY_TEST_REQUIRE(large && !large.storedInline());
+
+    auto owned = std::make_unique<int>(10);
+    BlockingTask move_only([&hits, owned = std::move(owned)]() { hits += *owned; });
+    GALAY_TEST_REQUIRE(move_only.storedInline());
+
+    BlockingTask moved = std::move(large);
+    GALAY_TEST_REQUIRE(!large && moved);
+    small();
+    moved();
+    move_only();
+    GALAY_TEST_REQUIRE(hits == 14);
+
+    BlockingTask empty_function{std::function<void()>{}};
+    GALAY_TEST_REQUIRE(!empty_function);
+    void (*null_function)() = nullptr;
+    GALAY_TEST_REQUIRE(!BlockingTask(null_function));
+    return true;
+}
+
+bool testConcurrentBurst()
+{
+    constexpr int kSubmitters = 8;
+    constexpr int kPerSubmitter = 2000;  // 远超 4 个分片 * 512 槽位，覆盖溢出队列
+    constexpr size_t kMaxWorkers = 4;
+
+    std::atomic<int> executed{0};
+    std::vector<std::atomic<uint8_t>> seen(kSubmitters * kPerSubmitter);
+    std::atomic<int> duplicates{0};
+    {
+        BlockingExecutor executor(0, kMaxWorkers, 1000ms);
+        std::vector<std::thread> submitters;
+        std::atomic<int> rejected{0};
+        for (int s = 0; s < kSubmitters; ++s) {
+            submitters.emplace_back([&, s]() {
+                for (int i = 0; i < kPerSubmitter; ++i) {
+                    const int id = s * kPerSubmitter + i;
+                    auto submitted = executor.submit([&, id]() {
+                        if (seen[id].fetch_add(1, std::memory_order_relaxed) != 0) {
+                            duplicates.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        executed.fetch_add(1, std::memory_order_release);
+                    });
+                    if (!submitted) {
+                        rejected.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& submitter : submitters) {
+            submitter.join();
+        }
+        GALAY_TEST_REQUIRE(rejected.load() == 0);
+        GALAY_TEST_REQUIRE(executor.workerCount() <= kMaxWorkers);
+        GALAY_TEST_REQUIRE(waitUntil([&]() {
+            return executed.load(std::memory_order_acquire) == kSubmitters * kPerSubmitter;
+        }));
+    }
+    GALAY_TEST_REQUIRE(duplicates.load() == 0);
+    return true;
+}
+
+bool testElasticScaling()
+{
+    BlockingExecutor executor(1, 3, 50ms);
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> done{0};
+    auto sleeper = [&]() {
+        const int current = active.fetch_add(1) + 1;
+        int observed = peak.load();
+        while (observed < current && !peak.compare_exchange_weak(observed, current)) {
+        }
+        std::this_thread::sleep_for(30ms);
+        active.fetch_sub(1);
+        done.fetch_add(1, std::memory_order_release);
+    };
+
+    for (int i = 0; i < 6; ++i) {
+        GALAY_TEST_REQUIRE(executor.submit(sleeper));
+    }
+    GALAY_TEST_REQUIRE(waitUntil([&]() { return done.load(std::memory_order_acquire) == 6; }));
+    GALAY_TEST_REQUIRE(peak.load() == 3);
+
+    // 超出 minWorkers 的线程保活超时后退出，只留 1 个停泊线程
+    GALAY_TEST_REQUIRE(waitUntil([&]() {
+        return executor.workerCount() == 1 && executor.idleWorkerCount() == 1;
+    }, 2000ms));
+
+    // 停泊线程被直接复用，不额外拉起线程
+    GALAY_TEST_REQUIRE(executor.submit([&]() { done.fetch_add(1, std::memory_order_release); }));
+    GALAY_TEST_REQUIRE(waitUntil([&]() { return done.load(std::memory_order_acquire) == 7; }));
+    GALAY_TEST_REQUIRE(executor.workerCount() == 1);
+
+    // 收缩后突发提交仍能重新扩张到上限
+    peak.store(0);
+    for (int i = 0; i < 3; ++i) {
+        GALAY_TEST_REQUIRE(executor.submit(sleeper));
+    }
+    GALAY_TEST_REQUIRE(waitUntil([&]() { return done.load(std::memory_order_acquire) == 10; }));
+    GALAY_TEST_REQUIRE(peak.load() >= 2);
+    return true;
+}
+
+bool testDestructorDrainsBacklog()
+{
+    std::atomic<int> executed{0};
+    {
+        BlockingExecutor executor(0, 1, 1000ms);
+        for (int i = 0; i < 64; ++i) {
+            GALAY_TEST_REQUIRE(executor.submit([&executed]() {
+                std::this_thread::sleep_for(100us);
+                executed.fetch_add(1, std::memory_order_relaxed);
+            }));
+        }
+    }
+    GALAY_TEST_REQUIRE(executed.load() == 64);
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    if (!testBlockingTaskStorage() ||
+        !testConcurrentBurst() ||
+        !testElasticScaling() ||
+        !testDestructorDrainsBacklog()) {
+        return 1;
+    }
+    std::cout << "T186-BlockingExecutorQueue PASS\n";
+    return 0;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file t187_task_frame_pool.cc
+ * @brief 用途：验证 TaskPromise 协程帧的线程局部 size-class slab 池。
+ * 关键覆盖点：scheduler 线程上嵌套 co_await 子任务的帧被反复复用、
+ * 外部线程创建而在 scheduler 线程结束的帧经 remote-free 链回到 owner、
+ * 超出最大 size-class 的大帧退回全局堆、owner 线程先退出后跨线程归还仍安全，
+ * 以及 taskFramePoolStats() / RuntimeStats::task_frames 汇总。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/core/compute_scheduler.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-kernel/core/task.h>
+#include "test/cpp/common/test_require.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kNestedRounds = 2000;
+
+bool waitFor(const std::atomic<int>& counter, int expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (counter.load(std::memory_order_acquire) < expected) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+Task<int> leafTask(int value)
+{
+    co_return value + 1;
+}
+
+Task<int> middleTask(int value)
+{
+    auto first = co_await leafTask(value);
+    auto second = co_await leafTask(value * 2);
+    co_return first.value_or(0) + second.value_or(0);
+}
+
+Task<void> nestedRoot(TaskFramePoolStats* before, TaskFramePoolStats* after,
+                      int* sum, std::atomic<int>* done)
+{
+    *before = detail::currentThreadTaskFramePoolStats();
+    for (int i = 0; i < kNestedRounds; ++i) {
+        auto result = co_await middleTask(i);
+        *sum += result.value_or(0);
+    }
+    *after = detail::currentThreadTaskFramePoolStats();
+    done->fetch_add(1, std::memory_order_release);
+}
+
+Task<void> countTask(std::atomic<int>* done)
+{
+    done->fetch_add(1, std::memory_order_release);
+    co_return;
+}
+
+Task<void> largeFrameTask(std::atomic<int>* done)
+{
+    volatile char scratch[4096];
+    scratch[0] = 1;
+    co_await leafTask(scratch[0]);
+    scratch[sizeof(scratch) - 1] = scratch[0];
+    done->fetch_add(scratch[sizeof(scratch) - 1], std::memory_order_release);
+}
+
+bool testNestedReuseOnScheduler()
+{
+    ComputeScheduler scheduler;
+    GALAY_TEST_REQUIRE(scheduler.start().has_value());
+
+    TaskFramePoolStats before;
+    TaskFramePoolStats after;
+    int sum = 0;
+    std::atomic<int> done{0};
+    GALAY_TEST_REQUIRE(scheduleTask(scheduler, nestedRoot(&before, &after, &sum, &done)));
+    const bool finished = waitFor(done, 1);
+    scheduler.stop();
+    GALAY_TEST_REQUIRE(finished);
+
+    int expected = 0;
+    for (int i = 0; i < kNestedRounds; ++i) {
+        expected += (i + 1) + (i * 2 + 1);
+    }
+    GALAY_TEST_REQUIRE(sum == expected);
+
+    // 每轮 3 个子帧；稳态后全部命中空闲链，只有首轮各 size-class 需要切块
+    const auto hits = after.hits - before.hits;
+    const auto misses = after.misses - before.misses;
+    GALAY_TEST_REQUIRE(hits + misses == 3u * kNestedRounds);
+    GALAY_TEST_REQUIRE(misses <= 4);
+    GALAY_TEST_REQUIRE(after.bytes_reserved > 0);
+    GALAY_TEST_REQUIRE(after.bytes_cached > 0);
+    return true;
+}
+
+bool testRemoteFreeReturnsToOwner()
+{
+    constexpr int kTasks = 256;
+    ComputeScheduler scheduler;
+    GALAY_TEST_REQUIRE(scheduler.start().has_value());
+
+    // 帧在本线程分配、在 scheduler 线程结束，只能经 remote-free 链回来
+    std::atomic<int> done{0};
+    for (int i = 0; i < kTasks; ++i) {
+        GALAY_TEST_REQUIRE(scheduleTask(scheduler, countTask(&done)));
+    }
+    const bool finished = waitFor(done, kTasks);
+    scheduler.stop();  // 计数在帧销毁前递增，停机保证所有帧都已归还
+    GALAY_TEST_REQUIRE(finished);
+    GALAY_TEST_REQUIRE(scheduler.start().has_value());
+
+    const auto before = detail::currentThreadTaskFramePoolStats();
+    for (int i = 0; i < kTasks; ++i) {
+        GALAY_TEST_REQUIRE(scheduleTask(scheduler, countTask(&done)));
+    }
+    const auto after = detail::currentThreadTaskFramePoolStats();
+    const bool finished_again = waitFor(done, 2 * kTasks);
+    scheduler.stop();
+    GALAY_TEST_REQUIRE(finished_again);
+
+    GALAY_TEST_REQUIRE(after.remote_frees - before.remote_frees >= static_cast<uint64_t>(kTasks));
+    GALAY_TEST_REQUIRE(after.hits - before.hits == static_cast<uint64_t>(kTasks));
+    GALAY_TEST_REQUIRE(after.misses == before.misses);
+    return true;
+}
+
+bool testLargeFrameFallsBackToHeap()
+{
+    ComputeScheduler scheduler;
+    GALAY_TEST_REQUIRE(scheduler.start().has_value());
+
+    const auto before = detail::currentThreadTaskFramePoolStats();
+    std::atomic<int> done{0};
+    GALAY_TEST_REQUIRE(scheduleTask(scheduler, largeFrameTask(&done)));
+    const auto after = detail::currentThreadTaskFramePoolStats();
+    const bool finished = waitFor(done, 1);
+    scheduler.stop();
+    GALAY_TEST_REQUIRE(finished);
+
+    GALAY_TEST_REQUIRE(after.misses == before.misses + 1);
+    GALAY_TEST_REQUIRE(after.hits == before.hits);
+    GALAY_TEST_REQUIRE(after.bytes_reserved == before.bytes_reserved);
+    return true;
+}
+
+bool testOwnerExitsBeforeFrames()
+{
+    constexpr int kTasks = 64;
+    ComputeScheduler scheduler;
+    GALAY_TEST_REQUIRE(scheduler.start().has_value());
+
+    // 创建线程退出时帧仍未结束；最后一个跨线程归还负责回收孤儿池
+    std::atomic<int> done{0};
+    std::vector<Task<void>> pending;
+    std::thread creator([&pending, &done]() {
+        for (int i = 0; i < kTasks; ++i) {
+            pending.push_back(countTask(&done));
+        }
+    });
+    creator.join();
+
+    const auto retired_before = taskFramePoolStats();
+    for (auto& task : pending) {
+        GALAY_TEST_REQUIRE(scheduleTask(scheduler, std::move(task)));
+    }
+    const bool finished = waitFor(done, kTasks);
+    scheduler.stop();
+    GALAY_TEST_REQUIRE(finished);
+
+    const auto retired_after = taskFramePoolStats();
+    GALAY_TEST_REQUIRE(retired_after.misses >= retired_before.misses);
+    GALAY_TEST_REQUIRE(retired_before.misses >= static_cast<uint64_t>(kTasks));
+    return true;
+}
+
+bool testRuntimeStatsSurface()
+{
+    Runtime runtime = RuntimeBuilder().ioSchedulerCount(1).computeSchedulerCount(1).build();
+    GALAY_TEST_REQUIRE(runtime.start().has_value());
+    std::atomic<int> done{0};
+    for (int i = 0; i < 32; ++i) {
+        GALAY_TEST_REQUIRE(scheduleTask(*runtime.getComputeScheduler(0), countTask(&done)));
+    }
+    const bool finished = waitFor(done, 32);
+    const auto stats = runtime.stats();
+    runtime.stop();
+    GALAY_TEST_REQUIRE(finished);
+
+    const auto global = taskFramePoolStats();
+    GALAY_TEST_REQUIRE(stats.task_frames.hits + stats.task_frames.misses > 0);
+    GALAY_TEST_REQUIRE(global.hits >= stats.task_frames.hits);
+    GALAY_TEST_REQUIRE(global.bytes_reserved > 0);
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+#ifdef GALAY_DISABLE_TASK_FRAME_POOL
+    std::cout << "T187-TaskFramePool SKIP (GALAY_DISABLE_TASK_FRAME_POOL)\n";
+    return 0;
+#else
+    if (!testNestedReuseOnScheduler() ||
+        !testRemoteFreeReturnsToOwner() ||
+        !testLargeFrameFallsBackToHeap() ||
+        !testOwnerExitsBeforeFrames() ||
+        !testRuntimeStatsSurface()) {
+        return 1;
+    }
+    std::cout << "T187-TaskFramePool PASS\n";
+    return 0;
+#endif
+}
@@ -0,0 +1,368 @@
+/**
+ * @file t188_splice_relay.cc
+ * @brief 用途：验证 spliceIn/spliceOut 与 spliceRelay/spliceTunnel 的零拷贝转发语义。
+ * 关键覆盖点：单次 spliceIn/spliceOut 搬运并在 EOF 时返回 0、多 MB 单向转发逐字节一致且
+ * shutdownWrite 把 EOF 传给目标端、双向隧道两个方向各自半关闭后结束、目标端已关闭时
+ * 返回 EPIPE 而不是被 SIGPIPE 终止。Linux 后端要求走 splice 路径，kqueue 要求退回拷贝。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <galay/cpp/galay-kernel/async/splice_relay.h>
+#include <galay/cpp/galay-kernel/core/task.h>
+#include "test/cpp/common/stdout_log.h"
+
+#ifdef USE_KQUEUE
+#include <galay/cpp/galay-kernel/core/kqueue_scheduler.h>
+#endif
+
+#ifdef USE_EPOLL
+#include <galay/cpp/galay-kernel/core/epoll_scheduler.h>
+#endif
+
+#ifdef USE_IOURING
+#include <galay/cpp/galay-kernel/core/uring_scheduler.h>
+#endif
+
+using namespace galay::async;
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t kRelayBytes = 8 * 1024 * 1024;
+constexpr size_t kTunnelRequestBytes = 300 * 1024;
+constexpr size_t kTunnelReplyBytes = 2 * 1024 * 1024;
+
+#if defined(USE_KQUEUE)
+constexpr bool kExpectSplice = false;
+#else
+constexpr bool kExpectSplice = true;
+#endif
+
+std::atomic<bool> g_done{false};
+std::string g_error;
+
+void fail(std::string message)
+{
+    if (g_error.empty()) {
+        g_error = std::move(message);
+    }
+}
+
+unsigned char patternAt(size_t index, unsigned seed)
+{
+    return static_cast<unsigned char>((index * 131u + seed) & 0xffu);
+}
+
+// 用阻塞 syscall 建立一条回环 TCP 连接；a 端稍后交给 AsyncTcpSocket，b 端留给辅助线程
+bool makeTcpPair(int& a, int& b)
+{
+    a = -1;
+    b = -1;
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return false;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 1) != 0 ||
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        ::close(listener);
+        return false;
+    }
+    b = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (b < 0 || ::connect(b, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(listener);
+        return false;
+    }
+    a = ::accept(listener, nullptr, nullptr);
+    ::close(listener);
+    if (a < 0) {
+        return false;
+    }
+    const int flags = ::fcntl(a, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(a, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool writeAll(int fd, size_t bytes, unsigned seed)
+{
+    std::vector<unsigned char> chunk(64 * 1024);
+    size_t written = 0;
+    while (written < bytes) {
+        const size_t n = std::min(chunk.size(), bytes - written);
+        for (size_t i = 0; i < n; ++i) {
+            chunk[i] = patternAt(written + i, seed);
+        }
+        size_t offset = 0;
+        while (offset < n) {
+            const ssize_t rc = ::send(fd, chunk.data() + offset, n - offset, MSG_NOSIGNAL);
+            if (rc <= 0) {
+                return false;
+            }
+            offset += static_cast<size_t>(rc);
+        }
+        written += n;
+    }
+    return true;
+}
+
+// 读到 EOF 并逐字节校验，返回读到的字节数；校验失败返回 SIZE_MAX
+size_t readAllVerify(int fd, unsigned seed)
+{
+    std::vector<unsigned char> chunk(64 * 1024);
+    size_t total = 0;
+    while (true) {
+        const ssize_t rc = ::recv(fd, chunk.data(), chunk.size(), 0);
+        if (rc == 0) {
+            return total;
+        }
+        if (rc < 0) {
+            return SIZE_MAX;
+        }
+        for (ssize_t i = 0; i < rc; ++i) {
+            if (chunk[static_cast<size_t>(i)] != patternAt(total + static_cast<size_t>(i), seed)) {
+                return SIZE_MAX;
+            }
+        }
+        total += static_cast<size_t>(rc);
+    }
+}
+
+Task<void> checkPrimitives()
+{
+    int src = -1;
+    int src_peer = -1;
+    if (!makeTcpPair(src, src_peer)) {
+        fail("primitives: tcp pair failed");
+        co_return;
+    }
+    AsyncTcpSocket socket{GHandle{.fd = src}};
+    auto pipe = SplicePipe::create(16 * 1024);
+    if (!pipe) {
+        if (kExpectSplice) {
+            fail("primitives: pipe creation failed: " + pipe.error().message());
+        }
+        ::close(src_peer);
+        co_await socket.close();
+        co_return;
+    }
+
+    const char payload[] = "splice-me";
+    (void)::send(src_peer, payload, sizeof(payload) - 1, MSG_NOSIGNAL);
+    auto moved_in = co_await socket.spliceIn(pipe->writeFd(), pipe->capacity());
+    if (!moved_in || moved_in.value() != sizeof(payload) - 1) {
+        fail("primitives: spliceIn did not move the payload");
+    }
+
+    auto moved_out = co_await socket.spliceOut(pipe->readFd(), sizeof(payload) - 1);
+    if (!moved_out || moved_out.value() != sizeof(payload) - 1) {
+        fail("primitives: spliceOut did not move the payload");
+    }
+    char echoed[sizeof(payload)] = {};
+    const ssize_t echoed_bytes = ::recv(src_peer, echoed, sizeof(echoed), 0);
+    if (echoed_bytes != static_cast<ssize_t>(sizeof(payload) - 1) ||
+        std::memcmp(echoed, payload, sizeof(payload) - 1) != 0) {
+        fail("primitives: peer did not receive the spliced payload");
+    }
+
+    ::shutdown(src_peer, SHUT_WR);
+    auto eof = co_await socket.spliceIn(pipe->writeFd(), pipe->capacity());
+    if (!eof || eof.value() != 0) {
+        fail("primitives: spliceIn at EOF should return 0");
+    }
+
+    ::close(src_peer);
+    co_await socket.close();
+}
+
+Task<void> checkRelay()
+{
+    int src = -1;
+    int src_peer = -1;
+    int dst = -1;
+    int dst_peer = -1;
+    if (!makeTcpPair(src, src_peer) || !makeTcpPair(dst, dst_peer)) {
+        fail("relay: tcp pair failed");
+        co_return;
+    }
+    AsyncTcpSocket from{GHandle{.fd = src}};
+    AsyncTcpSocket to{GHandle{.fd = dst}};
+
+    std::thread writer([src_peer] {
+        (void)writeAll(src_peer, kRelayBytes, 17);
+        ::close(src_peer);
+    });
+    std::atomic<size_t> received{0};
+    std::thread reader([dst_peer, &received] {
+        received.store(readAllVerify(dst_peer, 17));
+        ::close(dst_peer);
+    });
+
+    SpliceRelayOptions options;
+    options.shutdownWrite = true;
+    auto relay = co_await spliceRelay(from, to, options);
+    writer.join();
+    reader.join();
+
+    if (!relay || !relay.value()) {
+        fail("relay: spliceRelay failed");
+    } else if (relay.value().value().bytes != kRelayBytes) {
+        fail("relay: relayed byte count mismatch");
+    } else if (relay.value().value().spliced != kExpectSplice) {
+        fail("relay: unexpected splice/copy path");
+    }
+    if (received.load() != kRelayBytes) {
+        fail("relay: receiver saw corrupted or truncated data");
+    }
+
+    co_await from.close();
+    co_await to.close();
+}
+
+Task<void> checkTunnel()
+{
+    int a = -1;
+    int client = -1;
+    int b = -1;
+    int upstream = -1;
+    if (!makeTcpPair(a, client) || !makeTcpPair(b, upstream)) {
+        fail("tunnel: tcp pair failed");
+        co_return;
+    }
+    AsyncTcpSocket downstream_side{GHandle{.fd = a}};
+    AsyncTcpSocket upstream_side{GHandle{.fd = b}};
+
+    std::atomic<size_t> client_received{0};
+    std::thread client_thread([client, &client_received] {
+        (void)writeAll(client, kTunnelRequestBytes, 3);
+        ::shutdown(client, SHUT_WR);
+        client_received.store(readAllVerify(client, 5));
+        ::close(client);
+    });
+    std::atomic<size_t> upstream_received{0};
+    std::thread upstream_thread([upstream, &upstream_received] {
+        // 上游先读完整个请求（客户端半关闭），再回包并关闭
+        upstream_received.store(readAllVerify(upstream, 3));
+        (void)writeAll(upstream, kTunnelReplyBytes, 5);
+        ::close(upstream);
+    });
+
+    auto tunnel = co_await spliceTunnel(downstream_side, upstream_side);
+    client_thread.join();
+    upstream_thread.join();
+
+    if (!tunnel || !tunnel.value()) {
+        fail("tunnel: spliceTunnel failed");
+    } else {
+        const auto& stats = tunnel.value().value();
+        if (stats.forward.bytes != kTunnelRequestBytes || stats.backward.bytes != kTunnelReplyBytes) {
+            fail("tunnel: byte counts mismatch");
+        }
+    }
+    if (upstream_received.load() != kTunnelRequestBytes ||
+        client_received.load() != kTunnelReplyBytes) {
+        fail("tunnel: peers saw corrupted or truncated data");
+    }
+
+    co_await downstream_side.close();
+    co_await upstream_side.close();
+}
+
+Task<void> checkClosedTarget()
+{
+    int src = -1;
+    int src_peer = -1;
+    int dst = -1;
+    int dst_peer = -1;
+    if (!makeTcpPair(src, src_peer) || !makeTcpPair(dst, dst_peer)) {
+        fail("closed-target: tcp pair failed");
+        co_return;
+    }
+    ::close(dst_peer);
+    AsyncTcpSocket from{GHandle{.fd = src}};
+    AsyncTcpSocket to{GHandle{.fd = dst}};
+
+    // 持续写入直到转发端报错关闭连接；写失败即停止
+    std::thread writer([src_peer] {
+        (void)writeAll(src_peer, kRelayBytes, 9);
+        ::close(src_peer);
+    });
+
+    auto relay = co_await spliceRelay(from, to);
+    co_await from.close();
+    writer.join();
+    if (!relay || relay.value()) {
+        fail("closed-target: relay to a closed peer should fail");
+    }
+    co_await to.close();
+}
+
+Task<void> runScenarios()
+{
+    co_await checkPrimitives();
+    co_await checkRelay();
+    co_await checkTunnel();
+    co_await checkClosedTarget();
+    g_done.store(true, std::memory_order_release);
+}
+
+}  // namespace
+
+int main()
+{
+#ifdef USE_KQUEUE
+    KqueueScheduler scheduler;
+#elif defined(USE_EPOLL)
+    EpollScheduler scheduler;
+#elif defined(USE_IOURING)
+    IOUringScheduler scheduler;
+#else
+    LogInfo("T188-SpliceRelay skipped: requires kqueue, epoll or io_uring");
+    return 0;
+#endif
+
+    auto started = scheduler.start();
+    if (!started) {
+        LogError("scheduler start failed: {}", started.error().message());
+        return 1;
+    }
+    if (!scheduleTask(scheduler, runScenarios())) {
+        scheduler.stop();
+        LogError("failed to schedule splice relay scenarios");
+        return 1;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + 30s;
+    while (!g_done.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(2ms);
+    }
+    scheduler.stop();
+
+    if (!g_done.load(std::memory_order_acquire)) {
+        LogError("splice relay test timed out");
+        return 1;
+    }
+    if (!g_error.empty()) {
+        LogError("splice relay test failed: {}", g_error);
+        return 1;
+    }
+    LogInfo("T188-SpliceRelay PASS");
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file t189_mpsc_unbounded_recv_rearm.cc
+ * @brief 压测 ProducerToken 突发发送与 waiter arming 并发时，recv 不会无数据恢复。
+ *
+ * @details consumer 取走数据后立即重新 arming，可能观察到同一 stream 尚未 finishSend()
+ *          的 kPublished gate，或被迟到的 producer 仲裁置为 kArmingPending。两种情况
+ *          都必须继续等待，而不是以 kTimeout 结束 recv；一半通道使用远未到期的
+ *          recv().timeout(1h)，覆盖带超时的等待。
+ */
+
+#include <galay/cpp/galay-kernel/concurrency/mpsc/unbounded_channel.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-kernel/core/scheduler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using galay::kernel::IOError;
+using galay::kernel::Runtime;
+using galay::kernel::RuntimeBuilder;
+using galay::kernel::Task;
+using namespace std::chrono_literals;
+
+#if defined(__SANITIZE_THREAD__)
+constexpr size_t kChannels = 32;
+constexpr size_t kRounds = 2;
+#else
+constexpr size_t kChannels = 512;
+constexpr size_t kRounds = 8;
+#endif
+constexpr uint64_t kMessagesPerChannel = 64;
+
+struct Member {
+    galay::mpsc::UnboundedChannel<uint64_t> channel;
+    galay::mpsc::UnboundedChannel<uint64_t>::ProducerToken token =
+        channel.makeProducerToken();
+    std::atomic<uint64_t> received{0};
+    std::atomic<bool> spurious{false};
+    bool timed = false;
+};
+
+Task<void> receiveAll(Member* member)
+{
+    while (true) {
+        auto value = member->timed ? co_await member->channel.recv().timeout(1h)
+                                   : co_await member->channel.recv();
+        if (!value) {
+            if (!IOError::contains(value.error().code(), galay::kernel::kClosed)) {
+                member->spurious.store(true, std::memory_order_release);
+            }
+            break;
+        }
+        member->received.fetch_add(1, std::memory_order_release);
+    }
+    co_return;
+}
+
+bool runRound(size_t round)
+{
+    Runtime runtime = RuntimeBuilder().ioSchedulerCount(2).computeSchedulerCount(0).build();
+    if (!runtime.start()) {
+        std::cerr << "T189 runtime start failed\n";
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Member>> members;
+    members.reserve(kChannels);
+    for (size_t i = 0; i < kChannels; ++i) {
+        members.push_back(std::make_unique<Member>());
+        members.back()->timed = (i % 2) == 1;
+        if (!members.back()->token.valid() ||
+            !scheduleTask(runtime.getNextIOScheduler(), receiveAll(members.back().get()))) {
+            std::cerr << "T189 setup failed\n";
+            runtime.stop();
+            return false;
+        }
+    }
+
+    for (uint64_t message = 0; message < kMessagesPerChannel; ++message) {
+        for (auto& member : members) {
+            (void)member->channel.send(member->token, uint64_t{message});
+        }
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    size_t incomplete = kChannels;
+    while (incomplete != 0 && std::chrono::steady_clock::now() < deadline) {
+        incomplete = 0;
+        for (const auto& member : members) {
+            if (member->received.load(std::memory_order_acquire) != kMessagesPerChannel) {
+                ++incomplete;
+            }
+        }
+        if (incomplete != 0) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    size_t spurious = 0;
+    for (const auto& member : members) {
+        if (member->spurious.load(std::memory_order_acquire)) {
+            ++spurious;
+        }
+        (void)member->channel.close();
+    }
+    std::this_thread::sleep_for(20ms);
+    runtime.stop();
+
+    if (incomplete != 0 || spurious != 0) {
+        std::cerr << "T189 round=" << round << " incomplete=" << incomplete
+                  << " spurious=" << spurious << '\n';
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    for (size_t round = 0; round < kRounds; ++round) {
+        if (!runRound(round)) {
+            return 1;
+        }
+    }
+    std::cout << "T189-MpscUnboundedRecvRearm PASS channels=" << kChannels
+              << " rounds=" << kRounds << '\n';
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file t190_iouring_fixed_file_reuse.cc
+ * @brief 用途：验证 fixed-file 槽位在连接反复关闭、重建时被正确回收与复用。
+ * 关键覆盖点：表容量远小于连接轮数时每轮数据仍发到正确的 socket、close 后对端读到 EOF
+ * （表项被清空，不再持有已关闭 socket）、在非 owner 线程析构的 socket 同样归还槽位。
+ * 非 io_uring 后端忽略 fixed-file 配置，同样应通过。
+ * 通过条件：所有断言成立并输出 PASS。
+ */
+
+#include <galay/cpp/galay-kernel/async/async_tcp.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+
+#include <sys/socket.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace galay::async;
+using namespace galay::kernel;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint32_t kFixedSlots = 2;
+constexpr int kRounds = 32;
+
+bool makePair(int fds[2])
+{
+    return ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) == 0;
+}
+
+Task<bool> exchange(AsyncTcpSocket* left, AsyncTcpSocket* right, int round)
+{
+    const std::string payload = "round-" + std::to_string(round);
+    // 第二次收发时槽位登记已完成，走 IOSQE_FIXED_FILE 提交。
+    for (int pass = 0; pass < 2; ++pass) {
+        auto sent = co_await left->send(payload.data(), payload.size()).timeout(1s);
+        if (!sent.has_value() || *sent != payload.size()) {
+            std::cerr << "[T190] send failed in round " << round << "\n";
+            co_return false;
+        }
+        char buffer[32] = {};
+        size_t received = 0;
+        while (received < payload.size()) {
+            auto got = co_await right->recv(buffer + received, sizeof(buffer) - received).timeout(1s);
+            if (!got.has_value() || *got == 0) {
+                std::cerr << "[T190] recv failed in round " << round << "\n";
+                co_return false;
+            }
+            received += *got;
+        }
+        if (std::string(buffer, received) != payload) {
+            std::cerr << "[T190] round " << round << " received data for another connection\n";
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+Task<bool> closeAndExpectEof(AsyncTcpSocket* closing, AsyncTcpSocket* peer, int round)
+{
+    auto closed = co_await closing->close();
+    if (!closed.has_value()) {
+        std::cerr << "[T190] close failed in round " << round << "\n";
+        co_return false;
+    }
+    char buffer[8];
+    auto got = co_await peer->recv(buffer, sizeof(buffer)).timeout(1s);
+    if (got.has_value() && *got == 0) {
+        co_return true;
+    }
+    if (!got.has_value() && IOError::contains(got.error().code(), kDisconnectError)) {
+        co_return true;
+    }
+    std::cerr << "[T190] peer did not observe EOF after close in round " << round << "\n";
+    co_return false;
+}
+
+Task<bool> churn()
+{
+    for (int round = 0; round < kRounds; ++round) {
+        int fds[2] = {-1, -1};
+        if (!makePair(fds)) {
+            std::cerr << "[T190] socketpair failed\n";
+            co_return false;
+        }
+        AsyncTcpSocket left(GHandle{.fd = fds[0]});
+        AsyncTcpSocket right(GHandle{.fd = fds[1]});
+        if (!co_await exchange(&left, &right, round)) {
+            co_return false;
+        }
+        if (!co_await closeAndExpectEof(&left, &right, round)) {
+            co_return false;
+        }
+        (void)co_await right.close();
+    }
+    co_return true;
+}
+
+Task<bool> expectEof(AsyncTcpSocket* peer)
+{
+    char buffer[8];
+    auto got = co_await peer->recv(buffer, sizeof(buffer)).timeout(1s);
+    co_return (got.has_value() && *got == 0) ||
+              (!got.has_value() && IOError::contains(got.error().code(), kDisconnectError));
+}
+
+bool remoteDestroyReleasesSlot(Runtime& runtime)
+{
+    int fds[2] = {-1, -1};
+    if (!makePair(fds)) {
+        std::cerr << "[T190] socketpair failed\n";
+        return false;
+    }
+    auto left = std::make_unique<AsyncTcpSocket>(GHandle{.fd = fds[0]});
+    AsyncTcpSocket right(GHandle{.fd = fds[1]});
+    auto registered = runtime.blockOn(exchange(left.get(), &right, kRounds));
+    if (!registered.has_value() || !*registered) {
+        return false;
+    }
+
+    // 在非 scheduler 线程析构 socket（析构直接关闭 fd）：槽位只能经退役队列交回 owner。
+    std::thread([&left] { left.reset(); }).join();
+
+    auto eof = runtime.blockOn(expectEof(&right));
+    if (!eof.has_value() || !*eof) {
+        std::cerr << "[T190] peer did not observe EOF after a remote destroy\n";
+        return false;
+    }
+    auto again = runtime.blockOn(churn());
+    return again.has_value() && *again;
+}
+
+}  // namespace
+
+int main()
+{
+    Runtime runtime = RuntimeBuilder()
+        .ioSchedulerCount(1)
+        .computeSchedulerCount(0)
+        .ioUringFixedFiles(kFixedSlots)
+        .build();
+
+    auto ok = runtime.blockOn(churn());
+    if (!ok.has_value() || !*ok) {
+        runtime.stop();
+        return 1;
+    }
+    if (!remoteDestroyReleasesSlot(runtime)) {
+        runtime.stop();
+        return 1;
+    }
+    runtime.stop();
+    std::cout << "T190-IOUringFixedFileReuseCase PASS\n";
+    return 0;
+}
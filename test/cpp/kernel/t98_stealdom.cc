@@ -1,21 +1,24 @@
 /**
  * @file t98_stealdom.cc
- * @brief Surface-level assertions guarding Runtime-managed IO steal domain wiring
+ * @brief Assertions guarding Runtime-managed IO steal domain wiring
  *
  * Validates:
- * - `Runtime::start()` declares `configureIOSchedulerStealDomains()` and calls it before launching IO scheduler threads
- * - The helper walks `m_io_schedulers`, configures steal domains, and leaves compute schedulers untouched
+ * - After `Runtime::start()` every IO scheduler sits at its own index in a steal domain holding exactly the runtime IO schedulers
+ * - Compute schedulers stay out of it: unpooled by default, and in a separate domain with `computeWorkStealing(true)`
  * - `IOSchedulerWorkerState` declares the steal-domain fields and helper
  */
 
+#include <galay/cpp/galay-kernel/core/runtime.h>
+
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
-#include <sstream>
 #include <string>
 #include <vector>
 
+using namespace galay::kernel;
+
 namespace {
 
 std::filesystem::path projectRoot() {
@@ -34,20 +37,6 @@ bool contains(const std::string& haystack, const std::string& needle) {
     return haystack.find(needle) != std::string::npos;
 }
 
-std::string extractSection(const std::string& content,
-                           const std::string& begin,
-                           const std::string& end) {
-    const auto begin_pos = content.find(begin);
-    if (begin_pos == std::string::npos) {
-        return {};
-    }
-    const auto end_pos = content.find(end, begin_pos + begin.size());
-    if (end_pos == std::string::npos) {
-        return content.substr(begin_pos);
-    }
-    return content.substr(begin_pos, end_pos - begin_pos);
-}
-
 std::string extractBracedSection(const std::string& content,
                                  const std::string& begin_marker) {
     const auto begin_pos = content.find(begin_marker);
@@ -90,61 +79,82 @@ std::string extractBracedSection(const std::string& content,
     return {};
 }
 
+bool checkIOSchedulerDomain(Runtime& runtime, size_t count, std::vector<std::string>& failures) {
+    for (size_t index = 0; index < count; ++index) {
+        IOScheduler* const scheduler = runtime.getIOScheduler(index);
+        IOSchedulerWorkerState* const worker = scheduler ? scheduler->stealWorkerState() : nullptr;
+        if (worker == nullptr) {
+            failures.push_back("io scheduler " + std::to_string(index) + " exposes no worker state");
+            return false;
+        }
+        if (worker->self_index != index || worker->siblings.size() != count) {
+            failures.push_back("io scheduler " + std::to_string(index) + " has a wrong steal domain");
+            return false;
+        }
+        for (size_t sibling = 0; sibling < count; ++sibling) {
+            if (worker->siblings[sibling] != runtime.getIOScheduler(sibling)) {
+                failures.push_back("io steal domain must list exactly the runtime IO schedulers");
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void checkIOStealDomains(std::vector<std::string>& failures) {
+    constexpr size_t kIOCount = 2;
+    Runtime runtime = RuntimeBuilder().ioSchedulerCount(kIOCount).computeSchedulerCount(2).build();
+    if (!runtime.start().has_value()) {
+        failures.push_back("runtime failed to start");
+        return;
+    }
+    (void)checkIOSchedulerDomain(runtime, kIOCount, failures);
+    // 未开启计算窃取时计算调度器保持原有单队列模式，不加入任何 steal-domain。
+    for (size_t index = 0; index < 2; ++index) {
+        ComputeScheduler* const scheduler = runtime.getComputeScheduler(index);
+        if (scheduler == nullptr || scheduler->isPooled()) {
+            failures.push_back("compute scheduler " + std::to_string(index) +
+                               " must stay unpooled without computeWorkStealing()");
+        }
+    }
+    runtime.stop();
+}
+
+void checkComputeStealDomains(std::vector<std::string>& failures) {
+    constexpr size_t kIOCount = 2;
+    constexpr size_t kComputeCount = 3;
+    Runtime runtime = RuntimeBuilder()
+        .ioSchedulerCount(kIOCount)
+        .computeSchedulerCount(kComputeCount)
+        .computeWorkStealing(true)
+        .build();
+    if (!runtime.start().has_value()) {
+        failures.push_back("runtime with compute stealing failed to start");
+        return;
+    }
+    // 计算池的窃取域与 IO 域相互独立。
+    (void)checkIOSchedulerDomain(runtime, kIOCount, failures);
+    for (size_t index = 0; index < kComputeCount; ++index) {
+        ComputeScheduler* const scheduler = runtime.getComputeScheduler(index);
+        if (scheduler == nullptr || !scheduler->isPooled() ||
+            scheduler->stealWorkerState()->self_index != index) {
+            failures.push_back("compute scheduler " + std::to_string(index) +
+                               " must join the compute steal domain");
+        }
+    }
+    runtime.stop();
+}
+
 }  // namespace
 
 int main() {
     const auto root = projectRoot();
-    const auto runtime = root / "galay-kernel" / "core" / "runtime.cc";
     const auto ioscheduler = root / "galay-kernel" / "core" / "io_scheduler.hpp";
 
     std::vector<std::string> failures;
 
-    const auto runtime_src = readAll(runtime);
-    if (runtime_src.empty()) {
-        failures.push_back(runtime.string() + ": failed to read runtime.cc");
-    } else {
-        const auto start_body = extractSection(
-            runtime_src,
-            "std::expected<void, RuntimeError> Runtime::start()",
-            "void Runtime::stop()");
-        if (start_body.empty()) {
-            failures.push_back(runtime.string() + ": failed to isolate Runtime::start()");
-        } else {
-            if (!contains(start_body, "configureIOSchedulerStealDomains()")) {
-                failures.push_back(runtime.string() + ": start() missing configureIOSchedulerStealDomains() call");
-            }
-            if (!contains(start_body, "for (auto& scheduler : m_io_schedulers)")) {
-                failures.push_back(runtime.string() + ": start() missing IO scheduler start loop");
-            }
-            const auto helper_call = start_body.find("configureIOSchedulerStealDomains()");
-            const auto io_loop = start_body.find("for (auto& scheduler : m_io_schedulers)");
-            if (helper_call != std::string::npos &&
-                io_loop != std::string::npos &&
-                helper_call > io_loop) {
-                failures.push_back(runtime.string() +
-                                   ": configureIOSchedulerStealDomains() must run before IO scheduler start loop");
-            }
-        }
-
-        const auto helper_section =
-            extractSection(
-                runtime_src,
-                "void Runtime::configureIOSchedulerStealDomains()",
-                "std::expected<void, RuntimeError> Runtime::start()");
-        if (helper_section.empty()) {
-            failures.push_back(runtime.string() + ": missing configureIOSchedulerStealDomains() definition");
-        } else {
-            if (!contains(helper_section, "m_io_schedulers")) {
-                failures.push_back(runtime.string() + ": helper must iterate m_io_schedulers");
-            }
-            if (!contains(helper_section, "configureStealDomain")) {
-                failures.push_back(runtime.string() + ": helper must call configureStealDomain()");
-            }
-            if (contains(helper_section, "m_compute_schedulers")) {
-                failures.push_back(runtime.string() + ": helper must avoid compute schedulers");
-            }
-        }
-    }
+    checkIOStealDomains(failures);
+    checkComputeStealDomains(failures);
 
     const auto ioscheduler_src = readAll(ioscheduler);
     if (ioscheduler_src.empty()) {
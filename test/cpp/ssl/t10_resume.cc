@@ -2,7 +2,7 @@
  * @file t10_resume.cc
  * @brief 用途：锁定 SSL send 状态机在等待读事件时，读完成必须回灌密文而不是直接写失败。
  * 关键覆盖点：`SslOperationDriver::pollSend()`、`SslOperationDriver::onRead()` 的 `OperationKind::kSend` 分支。
- * 通过条件：send 挂起后读回对端 TLS record，不会得到 `kWriteFailed`，且密文会被成功喂回引擎。
+ * 通过条件：send 挂起后读回对端 TLS record，不会得到 `kWriteFailed`，且 readv 落入输入密文环的密文会被引擎读到。
  */
 
 #include <sstream>
@@ -134,11 +134,14 @@ int main()
     driver.m_send.read_pending = true;
 
     const auto wait = driver.poll();
-    expect(wait.kind == SslOperationDriver::WaitKind::kRead, "send did not wait for read");
-    expect(wait.context == &driver.recvContext(), "send read wait used unexpected context");
-    expect(ciphertext.size() <= driver.recvContext().m_length, "ciphertext larger than recv buffer");
-
-    std::memcpy(driver.recvContext().m_buffer, ciphertext.data(), ciphertext.size());
+    expect(wait.kind == SslOperationDriver::WaitKind::kReadv, "send did not wait for read");
+    expect(wait.context == &driver.readvContext(), "send read wait used unexpected context");
+    const auto iovecs = driver.readvContext().m_iovecs;
+    expect(!iovecs.empty(), "send read wait exposed no ring space");
+    expect(ciphertext.size() <= iovecs[0].iov_len, "ciphertext larger than recv buffer");
+
+    // 模拟 readv 直接落入输入密文环
+    std::memcpy(iovecs[0].iov_base, ciphertext.data(), ciphertext.size());
     driver.onRead(static_cast<size_t>(ciphertext.size()));
 
     expect(!driver.m_send.result_set, "send read completion should not fail");
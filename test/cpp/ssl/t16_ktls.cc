@@ -0,0 +1,489 @@
+/**
+ * @file t16_ktls.cc
+ * @brief 覆盖 kTLS 密钥截获与记录序号统计
+ * @details 两个 SslEngine 在内存中完成握手，不依赖内核 tls 模块：
+ *          用截获到的发送方向 crypto_info 自行 AES-GCM 解密下一条应用数据记录，
+ *          序号或密钥有任何偏差都会导致认证失败。TLS 1.3 服务端握手后还会发送
+ *          NewSessionTicket，正好检验截获之后的记录计数。
+ *          接收方向的记录判定覆盖注入的 close_notify、致命告警与 KeyUpdate 记录；
+ *          内核带 tls 模块时再经回环 socket 的内核收发方向实际注入这些记录。
+ */
+
+#include <galay/cpp/galay-ssl/ssl/ssl_context.h>
+#include <galay/cpp/galay-ssl/ssl/ssl_engine.h>
+#include <galay/cpp/galay-ssl/ssl/ssl_ktls.h>
+
+#include <openssl/evp.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#if defined(__linux__) && __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define GALAY_TEST_HAS_KTLS 1
+#endif
+
+using namespace galay::ssl;
+
+namespace {
+
+bool expect(bool condition, const char* message)
+{
+    if (!condition) {
+        std::cerr << message << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool pump(SslEngine& from, SslEngine& to)
+{
+    char buffer[16384];
+    while (from.pendingEncryptedOutput() > 0) {
+        auto extracted = from.extractEncryptedOutput(buffer, sizeof(buffer));
+        if (!extracted) {
+            return false;
+        }
+        if (!to.feedEncryptedInput(buffer, extracted.value())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool handshake(SslEngine& client, SslEngine& server)
+{
+    for (int round = 0; round < 16; ++round) {
+        const SslIOResult client_result = client.doHandshake();
+        if (!pump(client, server)) {
+            return false;
+        }
+        const SslIOResult server_result = server.doHandshake();
+        if (!pump(server, client)) {
+            return false;
+        }
+        if (client_result == SslIOResult::Error || server_result == SslIOResult::Error) {
+            return false;
+        }
+        if (client.isHandshakeCompleted() && server.isHandshakeCompleted() &&
+            client.pendingEncryptedOutput() == 0 && server.pendingEncryptedOutput() == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string extractAll(SslEngine& engine)
+{
+    std::string out;
+    char buffer[16384];
+    while (engine.pendingEncryptedOutput() > 0) {
+        auto extracted = engine.extractEncryptedOutput(buffer, sizeof(buffer));
+        if (!extracted) {
+            return {};
+        }
+        out.append(buffer, extracted.value());
+    }
+    return out;
+}
+
+#ifdef GALAY_TEST_HAS_KTLS
+
+uint64_t loadSeq(const unsigned char* data)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+/**
+ * @brief 用 crypto_info 解密单条 AES-GCM 应用数据记录
+ */
+std::optional<std::string> decryptRecord(const std::string& info, const std::string& record, bool tls13)
+{
+    tls_crypto_info header{};
+    std::memcpy(&header, info.data(), sizeof(header));
+
+    const unsigned char* key = nullptr;
+    const unsigned char* iv = nullptr;
+    const unsigned char* salt = nullptr;
+    const unsigned char* rec_seq = nullptr;
+    const EVP_CIPHER* cipher = nullptr;
+    const auto* raw = reinterpret_cast<const unsigned char*>(info.data());
+    if (header.cipher_type == TLS_CIPHER_AES_GCM_128) {
+        key = raw + offsetof(tls12_crypto_info_aes_gcm_128, key);
+        iv = raw + offsetof(tls12_crypto_info_aes_gcm_128, iv);
+        salt = raw + offsetof(tls12_crypto_info_aes_gcm_128, salt);
+        rec_seq = raw + offsetof(tls12_crypto_info_aes_gcm_128, rec_seq);
+        cipher = EVP_aes_128_gcm();
+    } else if (header.cipher_type == TLS_CIPHER_AES_GCM_256) {
+        key = raw + offsetof(tls12_crypto_info_aes_gcm_256, key);
+        iv = raw + offsetof(tls12_crypto_info_aes_gcm_256, iv);
+        salt = raw + offsetof(tls12_crypto_info_aes_gcm_256, salt);
+        rec_seq = raw + offsetof(tls12_crypto_info_aes_gcm_256, rec_seq);
+        cipher = EVP_aes_256_gcm();
+    } else {
+        return std::nullopt;
+    }
+
+    constexpr size_t kHeader = 5;
+    constexpr size_t kTag = 16;
+    const size_t explicit_nonce = tls13 ? 0 : 8;
+    if (record.size() < kHeader + explicit_nonce + kTag) {
+        return std::nullopt;
+    }
+    const auto* rec = reinterpret_cast<const unsigned char*>(record.data());
+    const size_t cipher_len = record.size() - kHeader - explicit_nonce - kTag;
+    const uint64_t seq = loadSeq(rec_seq);
+
+    std::array<unsigned char, 12> nonce{};
+    std::memcpy(nonce.data(), salt, 4);
+    std::array<unsigned char, 13> aad{};
+    size_t aad_len = 0;
+    if (tls13) {
+        std::memcpy(nonce.data() + 4, iv, 8);
+        for (size_t i = 0; i < 8; ++i) {
+            nonce[4 + i] ^= static_cast<unsigned char>(seq >> (56 - 8 * i));
+        }
+        std::memcpy(aad.data(), rec, kHeader);
+        aad_len = kHeader;
+    } else {
+        std::memcpy(nonce.data() + 4, rec + kHeader, 8);
+        std::memcpy(aad.data(), rec_seq, 8);
+        aad[8] = rec[0];
+        aad[9] = rec[1];
+        aad[10] = rec[2];
+        aad[11] = static_cast<unsigned char>(cipher_len >> 8);
+        aad[12] = static_cast<unsigned char>(cipher_len & 0xff);
+        aad_len = 13;
+    }
+
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    std::string plain(cipher_len, '\0');
+    int out_len = 0;
+    bool ok = EVP_DecryptInit_ex(ctx, cipher, nullptr, key, nonce.data()) == 1 &&
+              EVP_DecryptUpdate(ctx, nullptr, &out_len, aad.data(), static_cast<int>(aad_len)) == 1 &&
+              EVP_DecryptUpdate(ctx, reinterpret_cast<unsigned char*>(plain.data()), &out_len,
+                                rec + kHeader + explicit_nonce, static_cast<int>(cipher_len)) == 1 &&
+              EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, static_cast<int>(kTag),
+                                  const_cast<unsigned char*>(rec + record.size() - kTag)) == 1;
+    int final_len = 0;
+    ok = ok && EVP_DecryptFinal_ex(ctx, reinterpret_cast<unsigned char*>(plain.data()) + out_len, &final_len) == 1;
+    EVP_CIPHER_CTX_free(ctx);
+    if (!ok) {
+        return std::nullopt;
+    }
+    if (tls13) {
+        // TLSInnerPlaintext：内容 ‖ ContentType ‖ 零填充
+        while (!plain.empty() && plain.back() == '\0') {
+            plain.pop_back();
+        }
+        if (plain.empty() || plain.back() != 23) {
+            return std::nullopt;
+        }
+        plain.pop_back();
+    }
+    return plain;
+}
+
+bool runCase(int version, const char* cipher_name)
+{
+    SslContext server_ctx(SslMethod::TLS_Server);
+    SslContext client_ctx(SslMethod::TLS_Client);
+    if (!expect(server_ctx.loadCertificate("certs/server.crt").has_value(), "load server cert failed") ||
+        !expect(server_ctx.loadPrivateKey("certs/server.key").has_value(), "load server key failed")) {
+        return false;
+    }
+    client_ctx.setVerifyMode(SslVerifyMode::None);
+    for (SslContext* ctx : {&server_ctx, &client_ctx}) {
+        ctx->setMinProtocolVersion(version);
+        ctx->setMaxProtocolVersion(version);
+        const bool set = version == TLS1_3_VERSION
+            ? ctx->setCiphersuites(cipher_name).has_value()
+            : ctx->setCiphers(cipher_name).has_value();
+        if (!expect(set, "set cipher failed") ||
+            !expect(ctx->setKtlsEnabled(true), "kTLS option unsupported") ||
+            !expect(ctx->isKtlsEnabled(), "kTLS option not reported")) {
+            return false;
+        }
+    }
+
+    SslEngine server(&server_ctx);
+    SslEngine client(&client_ctx);
+    if (!expect(server.initMemoryBIO().has_value() && client.initMemoryBIO().has_value(), "initMemoryBIO failed")) {
+        return false;
+    }
+    server.setAcceptState();
+    client.setConnectState();
+    if (!expect(handshake(client, server), "in-memory handshake failed")) {
+        return false;
+    }
+
+    const bool tls13 = version == TLS1_3_VERSION;
+    auto server_tx = server.ktlsCryptoInfo(SslKtlsDirection::Tx);
+    auto client_tx = client.ktlsCryptoInfo(SslKtlsDirection::Tx);
+    if (!expect(server_tx.has_value() && !server_tx->empty(), "server tx key not captured") ||
+        !expect(client_tx.has_value() && !client_tx->empty(), "client tx key not captured") ||
+        !expect(server.isKtlsPending(SslKtlsDirection::Tx), "server tx should be installable") ||
+        !expect(!server.isKtlsActive(SslKtlsDirection::Tx), "tx must stay in user space until installed")) {
+        return false;
+    }
+    if (tls13) {
+        // TLS 1.3 客户端后续还会收到 NewSessionTicket，接收方向不能交给内核
+        if (!expect(!client.isKtlsPending(SslKtlsDirection::Rx), "tls1.3 client rx must stay in user space")) {
+            return false;
+        }
+    } else {
+        // TLS 1.2 接收方向的 iv 字段不参与解密（显式 nonce 随记录携带），用对端的一条记录验证
+        auto server_rx = server.ktlsCryptoInfo(SslKtlsDirection::Rx);
+        if (!expect(server_rx.has_value() && client.isKtlsPending(SslKtlsDirection::Rx) &&
+                    server.isKtlsPending(SslKtlsDirection::Rx), "tls1.2 rx should be installable")) {
+            return false;
+        }
+        const std::string request = "client to server";
+        size_t sent = 0;
+        if (!expect(client.write(request.data(), request.size(), sent) == SslIOResult::Success, "client write failed")) {
+            return false;
+        }
+        auto received = decryptRecord(*server_rx, extractAll(client), false);
+        if (!expect(received.has_value() && *received == request, "captured server rx key failed to authenticate record")) {
+            return false;
+        }
+    }
+
+    // 内核在 server_tx 对应的序号上加密下一条记录；这里用同一份参数解密 OpenSSL 写出的记录
+    const std::string message = "ktls sequence probe";
+    size_t written = 0;
+    if (!expect(server.write(message.data(), message.size(), written) == SslIOResult::Success, "server write failed")) {
+        return false;
+    }
+    const std::string record = extractAll(server);
+    auto plain = decryptRecord(*server_tx, record, tls13);
+    if (!expect(plain.has_value(), "captured server tx key failed to authenticate record") ||
+        !expect(*plain == message, "decrypted record mismatch")) {
+        return false;
+    }
+
+    if (!client.feedEncryptedInput(record.data(), record.size())) {
+        return false;
+    }
+    // TLS 1.3 客户端先消费 NewSessionTicket（已在握手中送达），再读到应用数据
+    char buffer[64];
+    size_t read = 0;
+    if (!expect(client.read(buffer, sizeof(buffer), read) == SslIOResult::Success &&
+                std::string(buffer, read) == message, "client read failed")) {
+        return false;
+    }
+
+    // 下一条记录的序号随之前进
+    auto next_tx = server.ktlsCryptoInfo(SslKtlsDirection::Tx);
+    if (!expect(server.write(message.data(), message.size(), written) == SslIOResult::Success, "second write failed")) {
+        return false;
+    }
+    plain = decryptRecord(*next_tx, extractAll(server), tls13);
+    return expect(plain.has_value() && *plain == message, "record sequence did not advance");
+}
+
+/**
+ * @brief 建立一对回环 TCP 连接
+ */
+bool loopbackPair(int& sender, int& receiver)
+{
+    sender = receiver = -1;
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return false;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    bool ok = ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+              ::listen(listener, 1) == 0 &&
+              ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0;
+    if (ok) {
+        sender = ::socket(AF_INET, SOCK_STREAM, 0);
+        ok = sender >= 0 && ::connect(sender, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    }
+    if (ok) {
+        receiver = ::accept(listener, nullptr, nullptr);
+        ok = receiver >= 0;
+    }
+    ::close(listener);
+    return ok;
+}
+
+/**
+ * @brief 等待并读取内核接收方向的下一条记录
+ */
+ssize_t recvRecord(int fd, char* buffer, size_t length, uint8_t& type)
+{
+    pollfd pfd{fd, POLLIN, 0};
+    if (::poll(&pfd, 1, 1000) != 1) {
+        return -1;
+    }
+    return detail::recvKtlsRecord(fd, buffer, length, type);
+}
+
+/**
+ * @brief 经内核收发方向注入告警与 KeyUpdate 记录
+ * @details 两端使用同一份 TLS 1.2 AES-128-GCM 参数，发送端以 TLS_SET_RECORD_TYPE 写出各类记录，
+ *          接收端必须按记录类型逐条读出，只有 close_notify 判为有序关闭
+ */
+bool kernelRecordTypesSurviveRecv()
+{
+    int sender = -1;
+    int receiver = -1;
+    if (!expect(loopbackPair(sender, receiver), "loopback pair failed")) {
+        return false;
+    }
+    const int attach_error = detail::attachTlsUlp(sender);
+    if (attach_error != 0) {
+        ::close(sender);
+        ::close(receiver);
+        std::cout << "t16_ktls: kernel tls ULP unavailable, record injection skipped\n";
+        return true;
+    }
+
+    tls12_crypto_info_aes_gcm_128 info{};
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+    for (size_t i = 0; i < sizeof(info.key); ++i) {
+        info.key[i] = static_cast<unsigned char>(i + 1);
+    }
+    for (size_t i = 0; i < sizeof(info.salt); ++i) {
+        info.salt[i] = static_cast<unsigned char>(0x40 + i);
+    }
+    const bool installed =
+        detail::attachTlsUlp(receiver) == 0 &&
+        ::setsockopt(sender, SOL_TLS, TLS_TX, &info, sizeof(info)) == 0 &&
+        ::setsockopt(receiver, SOL_TLS, TLS_RX, &info, sizeof(info)) == 0;
+    bool ok = expect(installed, "kernel tls key install failed");
+
+    const std::string data = "before alert";
+    const unsigned char key_update[] = {24, 0, 0, 1, 0};   // KeyUpdate(update_not_requested)
+    const unsigned char fatal_alert[] = {2, 20};          // fatal bad_record_mac
+    const unsigned char close_alert[] = {1, 0};           // warning close_notify
+    ok = ok &&
+         expect(detail::sendKtlsRecord(sender, detail::kTlsRecordApplicationData, data.data(), data.size()),
+                "send data record failed") &&
+         expect(detail::sendKtlsRecord(sender, detail::kTlsRecordHandshake, key_update, sizeof(key_update)),
+                "send KeyUpdate record failed") &&
+         expect(detail::sendKtlsRecord(sender, detail::kTlsRecordAlert, fatal_alert, sizeof(fatal_alert)),
+                "send fatal alert failed") &&
+         expect(detail::sendKtlsCloseNotify(sender), "send close_notify failed");
+
+    struct Expected {
+        uint8_t type;
+        size_t length;
+        detail::SslKtlsRecordAction action;
+    };
+    const Expected expected[] = {
+        {detail::kTlsRecordApplicationData, data.size(), detail::SslKtlsRecordAction::kData},
+        {detail::kTlsRecordHandshake, sizeof(key_update), detail::SslKtlsRecordAction::kFail},
+        {detail::kTlsRecordAlert, sizeof(fatal_alert), detail::SslKtlsRecordAction::kFail},
+        {detail::kTlsRecordAlert, sizeof(close_alert), detail::SslKtlsRecordAction::kCloseNotify},
+    };
+    for (const Expected& record : expected) {
+        if (!ok) {
+            break;
+        }
+        char buffer[64];
+        uint8_t type = 0;
+        const ssize_t received = recvRecord(receiver, buffer, sizeof(buffer), type);
+        ok = expect(received == static_cast<ssize_t>(record.length), "record length mismatch") &&
+             expect(type == record.type, "record type mismatch") &&
+             expect(detail::classifyKtlsRecord(type, buffer, static_cast<size_t>(received)) == record.action,
+                    "record classification mismatch");
+    }
+    ::close(sender);
+    ::close(receiver);
+    return ok;
+}
+
+#endif
+
+bool injectedRecordsClassify()
+{
+    const char data[] = "payload";
+    const char close_notify[] = {1, 0};
+    const char fatal_alert[] = {2, 40};       // fatal handshake_failure
+    const char user_canceled[] = {1, 90};     // warning，但不是 close_notify
+    const char key_update[] = {24, 0, 0, 1, 1};
+    const char truncated_alert[] = {1};
+    using detail::SslKtlsRecordAction;
+    return detail::classifyKtlsRecord(detail::kTlsRecordApplicationData, data, sizeof(data)) ==
+               SslKtlsRecordAction::kData &&
+           detail::classifyKtlsRecord(detail::kTlsRecordApplicationData, data, 0) == SslKtlsRecordAction::kData &&
+           detail::classifyKtlsRecord(detail::kTlsRecordAlert, close_notify, sizeof(close_notify)) ==
+               SslKtlsRecordAction::kCloseNotify &&
+           detail::classifyKtlsRecord(detail::kTlsRecordAlert, fatal_alert, sizeof(fatal_alert)) ==
+               SslKtlsRecordAction::kFail &&
+           detail::classifyKtlsRecord(detail::kTlsRecordAlert, user_canceled, sizeof(user_canceled)) ==
+               SslKtlsRecordAction::kFail &&
+           detail::classifyKtlsRecord(detail::kTlsRecordAlert, truncated_alert, sizeof(truncated_alert)) ==
+               SslKtlsRecordAction::kFail &&
+           detail::classifyKtlsRecord(detail::kTlsRecordHandshake, key_update, sizeof(key_update)) ==
+               SslKtlsRecordAction::kFail;
+}
+
+bool recordCounterSplitsAcrossCalls()
+{
+    detail::SslRecordCounter counter;
+    // 两条记录：负载 3 字节与 0 字节，逐字节喂入
+    const unsigned char stream[] = {23, 3, 3, 0, 3, 'a', 'b', 'c', 21, 3, 3, 0, 0};
+    for (size_t i = 0; i < sizeof(stream); ++i) {
+        counter.consume(stream + i, 1);
+        const bool boundary = i == 7 || i == sizeof(stream) - 1;
+        if (counter.atBoundary() != boundary) {
+            return false;
+        }
+    }
+    return counter.records() == 2;
+}
+
+bool disabledContextCapturesNothing()
+{
+    SslContext client_ctx(SslMethod::TLS_Client);
+    SslEngine client(&client_ctx);
+    if (!client.initMemoryBIO().has_value()) {
+        return false;
+    }
+    return !client_ctx.isKtlsEnabled() &&
+           !client.ktlsCryptoInfo(SslKtlsDirection::Tx).has_value() &&
+           !client.isKtlsPending(SslKtlsDirection::Tx) &&
+           !client.installKtls(-1);
+}
+
+} // namespace
+
+int main()
+{
+    if (!expect(recordCounterSplitsAcrossCalls(), "record counter mismatch") ||
+        !expect(disabledContextCapturesNothing(), "kTLS must stay off by default") ||
+        !expect(injectedRecordsClassify(), "only close_notify may end a kernel rx stream")) {
+        return 1;
+    }
+#ifdef GALAY_TEST_HAS_KTLS
+    if (!runCase(TLS1_2_VERSION, "ECDHE-RSA-AES128-GCM-SHA256") ||
+        !runCase(TLS1_2_VERSION, "ECDHE-RSA-AES256-GCM-SHA384") ||
+        !runCase(TLS1_3_VERSION, "TLS_AES_128_GCM_SHA256") ||
+        !runCase(TLS1_3_VERSION, "TLS_AES_256_GCM_SHA384") ||
+        !kernelRecordTypesSurviveRecv()) {
+        return 1;
+    }
+#endif
+    std::cout << "t16_ktls OK\n";
+    return 0;
+}
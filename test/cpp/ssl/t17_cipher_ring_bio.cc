@@ -0,0 +1,288 @@
+/**
+ * @file t17_cipher_ring_bio.cc
+ * @brief 覆盖密文环与密文环 BIO 的边界
+ * @details 环在读写位置靠近尾部时会环绕：可读段与空闲段都拆成两段，
+ *          reserve() 扩容须把环绕的数据按原顺序平移到新环开头。
+ *          记录流按奇数长度分片经 writeIovecs/produce 写入、经 BIO_read 读出，
+ *          反方向经 BIO_write 写入、经 readIovecs/consume 分片取走，
+ *          两个方向都校验字节顺序、BIO_CTRL_PENDING/BIO_CTRL_EOF 与记录计数。
+ */
+
+#include <galay/cpp/galay-ssl/ssl/ssl_bio.h>
+#include <galay/cpp/galay-ssl/ssl/ssl_ktls.h>
+
+#include <sys/uio.h>
+
+#include <openssl/bio.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace galay::ssl::detail;
+
+namespace {
+
+bool expect(bool condition, const char* message)
+{
+    if (!condition) {
+        std::cerr << message << '\n';
+        return false;
+    }
+    return true;
+}
+
+/// 以递增序号生成可校验顺序的字节
+std::string sequence(size_t start, size_t length)
+{
+    std::string bytes(length, '\0');
+    for (size_t i = 0; i < length; ++i) {
+        bytes[i] = static_cast<char>((start + i) % 251);
+    }
+    return bytes;
+}
+
+size_t segmentBytes(const std::array<iovec, 2>& segments, size_t count)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += segments[i].iov_len;
+    }
+    return total;
+}
+
+/// 若干条应用数据记录首尾相连组成的密文流，负载长度各不相同
+std::string recordStream(size_t& records)
+{
+    constexpr std::array<size_t, 5> kBodies = {1, 300, 4096, 17, 16384 + 256};
+    std::string stream;
+    size_t start = 0;
+    for (size_t body : kBodies) {
+        stream.push_back(static_cast<char>(23));
+        stream.push_back(static_cast<char>(0x03));
+        stream.push_back(static_cast<char>(0x03));
+        stream.push_back(static_cast<char>((body >> 8) & 0xff));
+        stream.push_back(static_cast<char>(body & 0xff));
+        stream += sequence(start, body);
+        start += body;
+    }
+    records = kBodies.size();
+    return stream;
+}
+
+/**
+ * @brief 把读写位置推到距环尾 tail 字节处
+ * @details 环变空时读写位置会归零，所以留下一条空负载记录作为标记并返回，读出时须排在最前
+ */
+std::string parkNearEnd(SslCipherRing& ring, size_t tail)
+{
+    const std::string marker = {static_cast<char>(23), static_cast<char>(0x03), static_cast<char>(0x03), '\0', '\0'};
+    const size_t skipped = ring.capacity() - tail - marker.size();
+    const std::string filler(skipped, 'x');
+    if (!ring.append(filler.data(), filler.size()) || !ring.append(marker.data(), marker.size())) {
+        return {};
+    }
+    std::string drained(skipped, '\0');
+    if (ring.take(drained.data(), drained.size()) != skipped || ring.readable() != marker.size()) {
+        return {};
+    }
+    return marker;
+}
+
+/// 写位置靠近尾部后追加，空闲段与可读段都环绕；扩容后顺序不变
+bool wrapThenGrowKeepsOrder()
+{
+    SslCipherRing ring;
+    const size_t capacity = SslCipherRing::kInitialCapacity;
+    const std::string head = sequence(0, capacity - 100);
+    if (!ring.append(head.data(), head.size())) {
+        return false;
+    }
+    std::string drained(capacity - 200, '\0');
+    if (ring.take(drained.data(), drained.size()) != drained.size() ||
+        drained != head.substr(0, drained.size())) {
+        return false;
+    }
+
+    // 剩余 100 字节在尾部，空闲空间跨过环尾
+    std::array<iovec, 2> segments{};
+    if (ring.writeIovecs(segments.data(), segments.size()) != 2 ||
+        segmentBytes(segments, 2) != capacity - 100) {
+        return false;
+    }
+
+    const std::string wrapped = sequence(capacity - 100, 1000);
+    if (!ring.append(wrapped.data(), wrapped.size()) ||
+        ring.capacity() != capacity ||
+        ring.readIovecs(segments.data(), segments.size()) != 2 ||
+        segmentBytes(segments, 2) != 1100) {
+        return false;
+    }
+
+    // 空间不足触发扩容：两段数据须按序平移到新环开头
+    const std::string overflow = sequence(capacity + 900, capacity);
+    if (!ring.append(overflow.data(), overflow.size()) ||
+        ring.capacity() <= capacity ||
+        ring.readable() != 1100 + capacity ||
+        ring.readIovecs(segments.data(), segments.size()) != 1) {
+        return false;
+    }
+
+    std::string rest(ring.readable(), '\0');
+    if (ring.take(rest.data(), rest.size()) != rest.size()) {
+        return false;
+    }
+    return rest == sequence(capacity - 200, 1100 + capacity) && ring.readable() == 0;
+}
+
+/// reserve() 在两段空闲空间下直接返回，不会搬动数据
+bool reserveWithinFreeSpaceKeepsLayout()
+{
+    SslCipherRing ring;
+    const size_t capacity = SslCipherRing::kInitialCapacity;
+    const std::string head = sequence(0, capacity - 50);
+    std::string drained(capacity - 60, '\0');
+    if (!ring.append(head.data(), head.size()) ||
+        ring.take(drained.data(), drained.size()) != drained.size()) {
+        return false;
+    }
+    if (!ring.reserve(ring.writable()) || ring.capacity() != capacity) {
+        return false;
+    }
+    std::string rest(10, '\0');
+    return ring.take(rest.data(), rest.size()) == 10 && rest == head.substr(capacity - 60);
+}
+
+/// 网络 → OpenSSL：按奇数分片 writev 进环，BIO_read 分片读出并统计记录
+bool partialProduceThroughBio()
+{
+    size_t records = 0;
+    const std::string stream = recordStream(records);
+
+    SslCipherRing ring;
+    SslKtlsChannel channel;
+    ring.ktls = &channel;
+    BIO* bio = newCipherRingBio(&ring);
+    if (bio == nullptr) {
+        return false;
+    }
+
+    bool ok = BIO_ctrl_pending(bio) == 0 && BIO_eof(bio) == 1;
+    char probe = 0;
+    ok = ok && BIO_read(bio, &probe, 1) == -1 && BIO_should_retry(bio) && BIO_should_read(bio);
+
+    // 先把读写位置推到环尾附近，后续写入会跨过环尾
+    std::string received;
+    const std::string marker = parkNearEnd(ring, 7);
+    ok = ok && !marker.empty();
+
+    size_t produced = 0;
+    size_t step = 0;
+    constexpr std::array<size_t, 4> kProduceSteps = {7, 4099, 3, 1021};
+    constexpr std::array<size_t, 3> kReadSteps = {5, 2048, 11};
+    std::array<char, 4096> buffer{};
+    bool wrappedOnce = false;
+    while (ok && (produced < stream.size() || ring.readable() > 0)) {
+        if (produced < stream.size()) {
+            std::array<iovec, 2> segments{};
+            const size_t count = ring.writeIovecs(segments.data(), segments.size());
+            wrappedOnce = wrappedOnce || count == 2;
+            size_t chunk = std::min({kProduceSteps[step % kProduceSteps.size()],
+                                     stream.size() - produced,
+                                     segmentBytes(segments, count)});
+            size_t copied = 0;
+            for (size_t i = 0; i < count && copied < chunk; ++i) {
+                const size_t part = std::min(chunk - copied, segments[i].iov_len);
+                std::memcpy(segments[i].iov_base, stream.data() + produced + copied, part);
+                copied += part;
+            }
+            ring.produce(chunk);
+            produced += chunk;
+        }
+        ok = ok && BIO_ctrl_pending(bio) == ring.readable() && BIO_eof(bio) == (ring.readable() == 0 ? 1 : 0);
+        const int want = static_cast<int>(kReadSteps[step % kReadSteps.size()]);
+        const int read = BIO_read(bio, buffer.data(), want);
+        if (read > 0) {
+            received.append(buffer.data(), static_cast<size_t>(read));
+        } else {
+            ok = ok && ring.readable() == 0 && BIO_should_retry(bio);
+        }
+        ++step;
+    }
+
+    ok = ok && wrappedOnce && received == marker + stream &&
+         BIO_ctrl_pending(bio) == 0 && BIO_eof(bio) == 1 &&
+         channel.counter.records() == records + 1 && channel.counter.atBoundary();
+    BIO_free(bio);
+    return ok;
+}
+
+/// OpenSSL → 网络：BIO_write 追加记录并扩容，readv 式两段分片取走
+bool partialConsumeThroughBio()
+{
+    size_t records = 0;
+    const std::string stream = recordStream(records);
+
+    SslCipherRing ring;
+    SslKtlsChannel channel;
+    ring.ktls = &channel;
+    BIO* bio = newCipherRingBio(&ring);
+    if (bio == nullptr) {
+        return false;
+    }
+
+    // 与上面相同，先让数据起点落在环尾附近
+    std::string sent;
+    const std::string marker = parkNearEnd(ring, 3);
+    bool ok = !marker.empty();
+
+    size_t written = 0;
+    size_t step = 0;
+    constexpr std::array<size_t, 3> kWriteSteps = {13, 5000, 2};
+    constexpr std::array<size_t, 4> kConsumeSteps = {9, 1500, 1, 6000};
+    bool wrappedOnce = false;
+    while (ok && (written < stream.size() || ring.readable() > 0)) {
+        if (written < stream.size()) {
+            const size_t chunk = std::min(kWriteSteps[step % kWriteSteps.size()], stream.size() - written);
+            ok = ok && BIO_write(bio, stream.data() + written, static_cast<int>(chunk)) == static_cast<int>(chunk);
+            written += chunk;
+        }
+        ok = ok && BIO_ctrl_pending(bio) == ring.readable() && BIO_eof(bio) == (ring.readable() == 0 ? 1 : 0);
+
+        std::array<iovec, 2> segments{};
+        const size_t count = ring.readIovecs(segments.data(), segments.size());
+        wrappedOnce = wrappedOnce || count == 2;
+        const size_t chunk = std::min(kConsumeSteps[step % kConsumeSteps.size()], segmentBytes(segments, count));
+        size_t copied = 0;
+        for (size_t i = 0; i < count && copied < chunk; ++i) {
+            const size_t part = std::min(chunk - copied, segments[i].iov_len);
+            sent.append(static_cast<const char*>(segments[i].iov_base), part);
+            copied += part;
+        }
+        ring.consume(chunk);
+        ++step;
+    }
+
+    ok = ok && wrappedOnce && sent == marker + stream &&
+         BIO_ctrl_pending(bio) == 0 && BIO_eof(bio) == 1 &&
+         channel.counter.records() == records && channel.counter.atBoundary();
+    BIO_free(bio);
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    if (!expect(wrapThenGrowKeepsOrder(), "wrapped data lost order across ring growth") ||
+        !expect(reserveWithinFreeSpaceKeepsLayout(), "reserve within free space must not move data") ||
+        !expect(partialProduceThroughBio(), "partial produce/BIO_read stream mismatch") ||
+        !expect(partialConsumeThroughBio(), "BIO_write/partial consume stream mismatch")) {
+        return 1;
+    }
+    std::cout << "t17_cipher_ring_bio OK\n";
+    return 0;
+}
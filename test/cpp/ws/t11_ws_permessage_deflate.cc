@@ -0,0 +1,399 @@
+/**
+ * @file t11_ws_permessage_deflate.cc
+ * @brief 用途：验证 permessage-deflate（RFC 7692）的协商、压缩上下文与读写路径。
+ * 关键覆盖点：提议参数解析、非法 / 重复参数拒绝、窗口位数取较小值、内存上限下的窗口降级；
+ * 客户端对响应的校验；context takeover 下第二条同构消息更小，no_context_takeover 下大小不变；
+ * 分片消息按帧流式解压；帧解析器只在协商后放行数据帧的 RSV1；
+ * WsMessageReadState 解压单帧与分片消息并在解压后限长；writer 对超过阈值的消息输出 RSV1 帧。
+ * 通过条件：所有断言成立并输出 PASS；未编译 zlib 时只跑帧解析用例。
+ */
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace test {
+struct FakeTcpSocket {};
+}
+
+#include <galay/cpp/galay-ws/protoc/ws_deflate.h>
+#include <galay/cpp/galay-ws/protoc/ws_frame.h>
+#include <galay/cpp/galay-ws/utils/ws_helper.h>
+#include <galay/cpp/galay-utils/cache/ring_buffer.hpp>
+#include "test/cpp/common/test_require.h"
+
+#define private public
+#include <galay/cpp/galay-ws/kernel/ws_reader.h>
+#include <galay/cpp/galay-ws/kernel/ws_writer.h>
+#undef private
+
+namespace galay::websocket {
+template<>
+struct is_tcp_socket<::test::FakeTcpSocket> : std::true_type {};
+}
+
+using galay::utils::RingBuffer;
+using namespace galay::websocket;
+
+namespace {
+
+using Ring = RingBuffer<galay::utils::RingBufferBackendStrategy::Mmap, std::dynamic_extent>;
+
+std::string makeTick(size_t seq)
+{
+    return "{\"type\":\"ticker\",\"symbol\":\"BTC-USDT\",\"seq\":" + std::to_string(seq) +
+           ",\"bid\":\"64210.15\",\"ask\":\"64210.16\",\"bid_size\":\"0.42\",\"ask_size\":\"1.07\","
+           "\"exchange\":\"galay\",\"channel\":\"spot.ticker\"}";
+}
+
+std::string encodeFrame(WsOpcode opcode, std::string_view payload, bool fin, bool rsv1, bool mask)
+{
+    uint8_t key[4] = {0, 0, 0, 0};
+    std::string out;
+    appendWsFrameHeader(out, opcode, fin, rsv1, false, false, payload.size(), mask, key);
+    const size_t offset = out.size();
+    out.append(payload);
+    if (mask && !payload.empty()) {
+        WsFrameParser::applyMaskBytes(out.data() + offset, payload.size(), key);
+    }
+    return out;
+}
+
+std::expected<size_t, WsError> parseFrame(const std::string& bytes, WsFrame& frame, bool is_server, bool allow_rsv1)
+{
+    iovec iov{const_cast<char*>(bytes.data()), bytes.size()};
+    return WsFrameParser::fromIOVec(&iov, 1, frame, is_server, allow_rsv1);
+}
+
+WsDeflateConfig enabledConfig()
+{
+    WsDeflateConfig config;
+    config.enabled = true;
+    config.compression_threshold = 32;
+    return config;
+}
+
+bool testParserRsv1()
+{
+    WsFrame frame;
+    const std::string compressed_text = encodeFrame(WsOpcode::Text, "abc", true, true, true);
+    auto rejected = parseFrame(compressed_text, frame, true, false);
+    GALAY_TEST_REQUIRE(!rejected && rejected.error().code() == kWsReservedBitsSet);
+
+    // 压缩帧的负载不是明文，解析器不做 UTF-8 校验
+    const std::string binary_looking = encodeFrame(WsOpcode::Text, std::string("\xff\xfe", 2), true, true, true);
+    auto accepted = parseFrame(binary_looking, frame, true, true);
+    GALAY_TEST_REQUIRE(accepted && frame.header.rsv1 && frame.payload == std::string("\xff\xfe", 2));
+
+    const std::string compressed_ping = encodeFrame(WsOpcode::Ping, "p", true, true, true);
+    auto ping = parseFrame(compressed_ping, frame, true, true);
+    GALAY_TEST_REQUIRE(!ping && ping.error().code() == kWsReservedBitsSet);
+
+    const std::string compressed_continuation = encodeFrame(WsOpcode::Continuation, "c", true, true, true);
+    auto continuation = parseFrame(compressed_continuation, frame, true, true);
+    GALAY_TEST_REQUIRE(!continuation && continuation.error().code() == kWsReservedBitsSet);
+
+    const std::string rsv2 = std::string(1, static_cast<char>(0xA1)) + encodeFrame(WsOpcode::Text, "x", true, false, true).substr(1);
+    auto reserved = parseFrame(rsv2, frame, true, true);
+    GALAY_TEST_REQUIRE(!reserved && reserved.error().code() == kWsReservedBitsSet);
+    return true;
+}
+
+bool testNegotiation()
+{
+    const WsDeflateConfig config = enabledConfig();
+
+    auto plain = negotiateWsDeflate("permessage-deflate", config);
+    GALAY_TEST_REQUIRE(plain.has_value());
+    GALAY_TEST_REQUIRE((*plain == WsDeflateParams{}));
+    GALAY_TEST_REQUIRE(formatWsDeflateResponse(*plain) == "permessage-deflate; server_max_window_bits=15");
+
+    // 第一个提议含未知参数被跳过，第二个提议的窗口取较小值
+    auto second = negotiateWsDeflate(
+        "x-webkit-deflate-frame, permessage-deflate; foo=1, "
+        "Permessage-Deflate; server_max_window_bits=\"10\"; client_max_window_bits; client_no_context_takeover",
+        config);
+    GALAY_TEST_REQUIRE(second.has_value());
+    GALAY_TEST_REQUIRE(second->server_max_window_bits == 10);
+    GALAY_TEST_REQUIRE(second->client_max_window_bits == 15);
+    GALAY_TEST_REQUIRE(second->client_no_context_takeover && !second->server_no_context_takeover);
+    GALAY_TEST_REQUIRE(formatWsDeflateResponse(*second) ==
+                       "permessage-deflate; client_no_context_takeover; server_max_window_bits=10");
+
+    WsDeflateConfig narrow = config;
+    narrow.client_max_window_bits = 11;
+    narrow.server_no_context_takeover = true;
+    auto limited = negotiateWsDeflate("permessage-deflate; client_max_window_bits=12", narrow);
+    GALAY_TEST_REQUIRE(limited.has_value());
+    GALAY_TEST_REQUIRE(limited->client_max_window_bits == 11 && limited->server_no_context_takeover);
+    GALAY_TEST_REQUIRE(formatWsDeflateResponse(*limited) ==
+                       "permessage-deflate; server_no_context_takeover; server_max_window_bits=15; "
+                       "client_max_window_bits=11");
+    // 客户端未声明 client_max_window_bits 时不能限制它的窗口
+    auto undeclared = negotiateWsDeflate("permessage-deflate", narrow);
+    GALAY_TEST_REQUIRE(undeclared.has_value() && undeclared->client_max_window_bits == 15);
+
+    GALAY_TEST_REQUIRE(!negotiateWsDeflate("permessage-deflate; server_max_window_bits=8", config));
+    GALAY_TEST_REQUIRE(!negotiateWsDeflate("permessage-deflate; server_max_window_bits=016", config));
+    GALAY_TEST_REQUIRE(!negotiateWsDeflate("permessage-deflate; server_max_window_bits", config));
+    GALAY_TEST_REQUIRE(!negotiateWsDeflate("permessage-deflate; client_no_context_takeover; client_no_context_takeover", config));
+    GALAY_TEST_REQUIRE(!negotiateWsDeflate("permessage-deflate; server_no_context_takeover=1", config));
+    GALAY_TEST_REQUIRE(!negotiateWsDeflate("", config));
+    GALAY_TEST_REQUIRE(!negotiateWsDeflate("permessage-deflate", WsDeflateConfig{}));
+
+    // 内存上限：先缩小服务端压缩窗口，放不下时拒绝
+    WsDeflateConfig tight = config;
+    tight.memory_limit = 200 * 1024;
+    auto shrunk = negotiateWsDeflate("permessage-deflate", tight);
+    GALAY_TEST_REQUIRE(shrunk.has_value());
+    GALAY_TEST_REQUIRE(shrunk->server_max_window_bits < 15 && shrunk->client_max_window_bits == 15);
+    GALAY_TEST_REQUIRE(estimateWsDeflateMemory(shrunk->server_max_window_bits, 15, tight.mem_level) <= tight.memory_limit);
+    tight.memory_limit = 1024;
+    GALAY_TEST_REQUIRE(!negotiateWsDeflate("permessage-deflate", tight));
+    GALAY_TEST_REQUIRE(formatWsDeflateOffer(tight).empty());
+    return true;
+}
+
+bool testClientResponse()
+{
+    WsDeflateConfig config = enabledConfig();
+    GALAY_TEST_REQUIRE(formatWsDeflateOffer(config) == "permessage-deflate; client_max_window_bits");
+
+    auto none = acceptWsDeflateResponse("", config);
+    GALAY_TEST_REQUIRE(none && !none->has_value());
+
+    auto accepted = acceptWsDeflateResponse(
+        "permessage-deflate; server_max_window_bits=12; client_max_window_bits=10", config);
+    GALAY_TEST_REQUIRE(accepted && accepted->has_value());
+    GALAY_TEST_REQUIRE((*accepted)->server_max_window_bits == 12 && (*accepted)->client_max_window_bits == 10);
+
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse("permessage-deflate; client_max_window_bits=8", config));
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse("permessage-deflate; client_max_window_bits", config));
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse("permessage-deflate; mystery", config));
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse("permessage-deflate, permessage-deflate", config));
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse("x-custom-extension", config));
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse("permessage-deflate", WsDeflateConfig{}));
+
+    config.server_max_window_bits = 11;
+    config.server_no_context_takeover = true;
+    GALAY_TEST_REQUIRE(formatWsDeflateOffer(config) ==
+                       "permessage-deflate; server_no_context_takeover; server_max_window_bits=11; client_max_window_bits");
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse("permessage-deflate; server_no_context_takeover", config));
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse(
+        "permessage-deflate; server_no_context_takeover; server_max_window_bits=13", config));
+    GALAY_TEST_REQUIRE(!acceptWsDeflateResponse("permessage-deflate; server_max_window_bits=11", config));
+    auto narrow = acceptWsDeflateResponse(
+        "permessage-deflate; server_no_context_takeover; server_max_window_bits=9", config);
+    GALAY_TEST_REQUIRE(narrow && narrow->has_value() && (*narrow)->server_max_window_bits == 9);
+    return true;
+}
+
+bool testCodec()
+{
+    const WsDeflateConfig config = enabledConfig();
+    const WsDeflateParams params;
+    auto server = WsPerMessageDeflate::create(params, config, true);
+    auto client = WsPerMessageDeflate::create(params, config, false);
+    GALAY_TEST_REQUIRE(server && client);
+    GALAY_TEST_REQUIRE((*server)->memoryBytes() > 0 && (*server)->memoryBytes() <= config.memory_limit);
+    GALAY_TEST_REQUIRE(!(*server)->shouldCompress(16) && (*server)->shouldCompress(64));
+
+    // context takeover：第二条同构消息引用上一条的窗口，压缩后更小
+    std::string wire;
+    std::string inflated;
+    GALAY_TEST_REQUIRE((*server)->compressMessage(makeTick(1), wire));
+    const size_t first_size = wire.size();
+    GALAY_TEST_REQUIRE(wire.size() < makeTick(1).size());
+    GALAY_TEST_REQUIRE((*client)->inflateFrame(wire, true, inflated, 1 << 20));
+    GALAY_TEST_REQUIRE(inflated == makeTick(1));
+
+    GALAY_TEST_REQUIRE((*server)->compressMessage(makeTick(2), wire));
+    GALAY_TEST_REQUIRE(wire.size() < first_size);
+    inflated.clear();
+    GALAY_TEST_REQUIRE((*client)->inflateFrame(wire, true, inflated, 1 << 20));
+    GALAY_TEST_REQUIRE(inflated == makeTick(2));
+    GALAY_TEST_REQUIRE((*server)->counters().messages_compressed == 2);
+    GALAY_TEST_REQUIRE((*client)->counters().messages_inflated == 2);
+
+    // 分片：压缩数据切成三帧逐帧解压
+    std::string large;
+    for (size_t i = 0; i < 64; ++i) {
+        large += makeTick(100 + i);
+    }
+    GALAY_TEST_REQUIRE((*server)->compressMessage(large, wire));
+    const size_t third = wire.size() / 3;
+    inflated.clear();
+    GALAY_TEST_REQUIRE((*client)->inflateFrame(std::string_view(wire).substr(0, third), false, inflated, 1 << 20));
+    GALAY_TEST_REQUIRE((*client)->inflateFrame(std::string_view(wire).substr(third, third), false, inflated, 1 << 20));
+    GALAY_TEST_REQUIRE((*client)->inflateFrame(std::string_view(wire).substr(2 * third), true, inflated, 1 << 20));
+    GALAY_TEST_REQUIRE(inflated == large);
+
+    // 解压上限
+    GALAY_TEST_REQUIRE((*server)->compressMessage(large, wire));
+    inflated.clear();
+    auto bomb = (*client)->inflateFrame(wire, true, inflated, large.size() / 2);
+    GALAY_TEST_REQUIRE(!bomb && bomb.error().code() == kWsMessageTooLarge);
+
+    // no_context_takeover：每条消息独立压缩，同一消息两次压缩结果相同
+    WsDeflateParams isolated;
+    isolated.server_no_context_takeover = true;
+    auto iso_server = WsPerMessageDeflate::create(isolated, config, true);
+    auto iso_client = WsPerMessageDeflate::create(isolated, config, false);
+    GALAY_TEST_REQUIRE(iso_server && iso_client);
+    std::string first;
+    std::string second;
+    GALAY_TEST_REQUIRE((*iso_server)->compressMessage(makeTick(7), first));
+    GALAY_TEST_REQUIRE((*iso_server)->compressMessage(makeTick(7), second));
+    GALAY_TEST_REQUIRE(first == second);
+    inflated.clear();
+    GALAY_TEST_REQUIRE((*iso_client)->inflateFrame(first, true, inflated, 1 << 20));
+    inflated.clear();
+    GALAY_TEST_REQUIRE((*iso_client)->inflateFrame(second, true, inflated, 1 << 20));
+    GALAY_TEST_REQUIRE(inflated == makeTick(7));
+
+    // 损坏数据
+    auto corrupt = WsPerMessageDeflate::create(params, config, false);
+    GALAY_TEST_REQUIRE(corrupt);
+    inflated.clear();
+    auto broken = (*corrupt)->inflateFrame(std::string("\xff\xff\xff\xff", 4), true, inflated, 1 << 20);
+    GALAY_TEST_REQUIRE(!broken && broken.error().code() == kWsCompressionError);
+    return true;
+}
+
+bool testReader()
+{
+    const WsDeflateConfig config = enabledConfig();
+    auto server = WsPerMessageDeflate::create(WsDeflateParams{}, config, true);
+    auto client = WsPerMessageDeflate::create(WsDeflateParams{}, config, false);
+    GALAY_TEST_REQUIRE(server && client);
+
+    WsReaderSetting setting;
+    setting.max_frame_size = 1 << 20;
+    setting.max_message_size = 1 << 20;
+
+    std::string large;
+    for (size_t i = 0; i < 32; ++i) {
+        large += makeTick(i);
+    }
+    std::string single;
+    std::string fragmented;
+    GALAY_TEST_REQUIRE((*client)->compressMessage(makeTick(1), single));
+    GALAY_TEST_REQUIRE((*client)->compressMessage(large, fragmented));
+    const size_t half = fragmented.size() / 2;
+
+    Ring ring(16 * 1024);
+    std::string buffered = encodeFrame(WsOpcode::Text, single, true, true, true);
+    buffered += encodeFrame(WsOpcode::Text, std::string_view(fragmented).substr(0, half), false, true, true);
+    buffered += encodeFrame(WsOpcode::Continuation, std::string_view(fragmented).substr(half), true, false, true);
+    buffered += encodeFrame(WsOpcode::Text, "raw below threshold", true, false, true);
+    GALAY_TEST_REQUIRE(ring.tryWriteBatch(buffered.data(), buffered.size()) == buffered.size());
+
+    std::string message;
+    WsOpcode opcode = WsOpcode::Close;
+    galay::websocket::detail::WsMessageReadState state(ring, setting, message, opcode, true, false, nullptr);
+    state.setPerMessageDeflate(server->get());
+
+    GALAY_TEST_REQUIRE(state.parseFromBuffer() && state.takeResult());
+    GALAY_TEST_REQUIRE(opcode == WsOpcode::Text && message == makeTick(1));
+    state.resetForNextMessage();
+    GALAY_TEST_REQUIRE(state.parseFromBuffer() && state.takeResult());
+    GALAY_TEST_REQUIRE(message == large);
+    state.resetForNextMessage();
+    GALAY_TEST_REQUIRE(state.parseFromBuffer() && state.takeResult());
+    GALAY_TEST_REQUIRE(message == "raw below threshold");
+    GALAY_TEST_REQUIRE(ring.readable() == 0);
+    GALAY_TEST_REQUIRE((*server)->counters().messages_inflated == 2);
+
+    // 未协商时 RSV1 帧是协议错误
+    {
+        Ring plain_ring(1024);
+        const std::string frame = encodeFrame(WsOpcode::Text, single, true, true, true);
+        GALAY_TEST_REQUIRE(plain_ring.tryWriteBatch(frame.data(), frame.size()) == frame.size());
+        galay::websocket::detail::WsMessageReadState plain(plain_ring, setting, message, opcode, true, false, nullptr);
+        GALAY_TEST_REQUIRE(plain.parseFromBuffer());
+        auto result = plain.takeResult();
+        GALAY_TEST_REQUIRE(!result && result.error().code() == kWsReservedBitsSet);
+    }
+
+    // 限长作用于解压后的消息
+    {
+        std::string bomb;
+        GALAY_TEST_REQUIRE((*client)->compressMessage(std::string(64 * 1024, 'a'), bomb));
+        Ring bomb_ring(4096);
+        const std::string frame = encodeFrame(WsOpcode::Binary, bomb, true, true, true);
+        GALAY_TEST_REQUIRE(bomb_ring.tryWriteBatch(frame.data(), frame.size()) == frame.size());
+        WsReaderSetting small = setting;
+        small.max_message_size = 4096;
+        galay::websocket::detail::WsMessageReadState limited(bomb_ring, small, message, opcode, true, false, nullptr);
+        limited.setPerMessageDeflate(server->get());
+        GALAY_TEST_REQUIRE(limited.parseFromBuffer());
+        auto result = limited.takeResult();
+        GALAY_TEST_REQUIRE(!result && result.error().code() == kWsMessageTooLarge);
+    }
+    return true;
+}
+
+std::string flattenIoVecs(const WsWriterImpl<test::FakeTcpSocket>& writer)
+{
+    std::string result;
+    for (size_t i = 0; i < writer.getIovecsCount(); ++i) {
+        const auto& seg = writer.getIovecsData()[i];
+        result.append(static_cast<const char*>(seg.iov_base), seg.iov_len);
+    }
+    return result;
+}
+
+bool testWriter()
+{
+    const WsDeflateConfig config = enabledConfig();
+    auto server = WsPerMessageDeflate::create(WsDeflateParams{}, config, true);
+    auto client = WsPerMessageDeflate::create(WsDeflateParams{}, config, false);
+    GALAY_TEST_REQUIRE(server && client);
+
+    test::FakeTcpSocket socket;
+    WsWriterImpl<test::FakeTcpSocket> writer(WsWriterSetting::byServer(), socket);
+    writer.setPerMessageDeflate(server->get());
+
+    GALAY_TEST_REQUIRE(!writer.tryPrepareDeflatedMessage(WsOpcode::Text, "tiny", true));
+    GALAY_TEST_REQUIRE(!writer.tryPrepareDeflatedMessage(WsOpcode::Text, makeTick(1), false));
+    GALAY_TEST_REQUIRE(!writer.tryPrepareDeflatedMessage(WsOpcode::Ping, makeTick(1), true));
+
+    for (size_t seq = 1; seq <= 3; ++seq) {
+        GALAY_TEST_REQUIRE(writer.tryPrepareDeflatedMessage(WsOpcode::Text, makeTick(seq), true));
+        const std::string bytes = flattenIoVecs(writer);
+        GALAY_TEST_REQUIRE(bytes.size() == writer.getRemainingBytes());
+        GALAY_TEST_REQUIRE(bytes.size() < makeTick(seq).size());
+
+        WsFrame frame;
+        auto parsed = parseFrame(bytes, frame, false, true);
+        GALAY_TEST_REQUIRE(parsed && *parsed == bytes.size());
+        GALAY_TEST_REQUIRE(frame.header.rsv1 && frame.header.fin && frame.header.opcode == WsOpcode::Text);
+        std::string inflated;
+        GALAY_TEST_REQUIRE((*client)->inflateFrame(frame.payload, true, inflated, 1 << 20));
+        GALAY_TEST_REQUIRE(inflated == makeTick(seq));
+        writer.updateRemainingWritev(bytes.size());
+        GALAY_TEST_REQUIRE(writer.getRemainingBytes() == 0);
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    if (!testParserRsv1()) {
+        return 1;
+    }
+    if (!galay::http::HttpRawDeflateStream::isSupported()) {
+        std::cout << "T11-WsPerMessageDeflate PASS (zlib not compiled, codec cases skipped)\n";
+        return 0;
+    }
+    if (!testNegotiation() || !testClientResponse() || !testCodec() || !testReader() || !testWriter()) {
+        return 1;
+    }
+    std::cout << "T11-WsPerMessageDeflate PASS\n";
+    return 0;
+}
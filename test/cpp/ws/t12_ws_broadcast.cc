@@ -0,0 +1,269 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace test {
+struct FakeTcpSocket {};
+}
+
+#include <sstream>
+#include <galay/cpp/galay-kernel/concurrency/mpsc/unbounded_channel.h>
+#include <galay/cpp/galay-kernel/core/runtime.h>
+#include <galay/cpp/galay-ws/protoc/ws_frame.h>
+#include <galay/cpp/galay-ws/utils/ws_helper.h>
+
+#define private public
+#include <galay/cpp/galay-ws/kernel/ws_writer.h>
+#include <galay/cpp/galay-ws/server/ws_broadcast.h>
+#undef private
+
+namespace galay::websocket {
+template<>
+struct is_tcp_socket<test::FakeTcpSocket> : std::true_type {};
+}
+
+using namespace galay::websocket;
+using galay::async::AsyncTcpSocket;
+using galay::kernel::Runtime;
+using galay::kernel::RuntimeBuilder;
+using galay::kernel::Task;
+
+namespace {
+
+bool check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "[T12] " << message << "\n";
+        return false;
+    }
+    return true;
+}
+
+std::string flattenIoVecs(const WsWriterImpl<test::FakeTcpSocket>& writer) {
+    std::string result;
+    const auto* iovecs = writer.getIovecsData();
+    for (size_t i = 0; i < writer.getIovecsCount(); ++i) {
+        result.append(static_cast<const char*>(iovecs[i].iov_base), iovecs[i].iov_len);
+    }
+    return result;
+}
+
+std::vector<WsSharedFrame> drain(galay::websocket::detail::WsBroadcastMember& member) {
+    std::vector<WsSharedFrame> frames;
+    while (auto frame = member.channel.tryRecv()) {
+        frames.push_back(std::move(*frame));
+    }
+    return frames;
+}
+
+bool testSharedFrameEncoding() {
+    const std::string payload(300, 'p');
+    const auto shared = WsSharedFrame::encode(WsOpcode::Binary, payload);
+    const auto expected = WsFrameParser::toBytes(WsFrameParser::createBinaryFrame(payload), false);
+    bool ok = check(shared.bytes() == expected, "shared frame must match WsFrameParser::toBytes");
+    ok &= check(shared.payload() == payload, "shared frame payload view must skip the header");
+    ok &= check(shared.opcode() == WsOpcode::Binary, "shared frame must keep its opcode");
+
+    const WsSharedFrame copy = shared;
+    ok &= check(copy.bytes().data() == shared.bytes().data(), "copies must share the encoded bytes");
+    ok &= check(shared.useCount() == 2, "copy must only bump the reference count");
+    ok &= check(WsSharedFrame().empty(), "default shared frame must be empty");
+    return ok;
+}
+
+bool testWriterSharedBatch() {
+    const auto first = WsSharedFrame::encode(WsOpcode::Text, "alpha");
+    const auto second = WsSharedFrame::encode(WsOpcode::Text, std::string(200, 'b'));
+    const std::vector<WsSharedFrame> frames{first, WsSharedFrame(), second};
+
+    test::FakeTcpSocket socket;
+    WsWriterImpl<test::FakeTcpSocket> server(WsWriterSetting::byServer(), socket);
+    server.prepareSharedFrames(frames);
+    bool ok = check(server.getIovecsCount() == 2, "server batch must use one iovec per non-empty frame");
+    ok &= check(server.getIovecsData()[0].iov_base == first.bytes().data(),
+                "server iovec must point into the shared buffer");
+    ok &= check(flattenIoVecs(server) == std::string(first.bytes()) + std::string(second.bytes()),
+                "server batch must write frames back to back");
+    ok &= check(first.useCount() == 3, "writer must hold a reference while the batch is pending");
+
+    server.updateRemainingWritev(server.getRemainingBytes());
+    ok &= check(server.getRemainingBytes() == 0, "batch must complete after all bytes are written");
+    ok &= check(first.useCount() == 2, "writer must drop its reference once the batch is written");
+
+    WsWriterImpl<test::FakeTcpSocket> client(WsWriterSetting::byClient(), socket);
+    client.prepareSharedFrames(std::span<const WsSharedFrame>(&second, 1));
+    ok &= check(second.useCount() == 2, "masking writer must not retain the shared frame");
+    const std::string masked = flattenIoVecs(client);
+    WsFrame parsed;
+    const struct iovec iov{const_cast<char*>(masked.data()), masked.size()};
+    auto consumed = WsFrameParser::fromIOVec(&iov, 1, parsed, true);
+    ok &= check(consumed.has_value() && *consumed == masked.size(), "masking writer must emit a valid client frame");
+    ok &= check(parsed.header.mask && parsed.payload == second.payload(),
+                "masking writer must re-encode the shared payload with a mask");
+    return ok;
+}
+
+bool testBackpressurePolicies() {
+    WsBroadcastGroup group;
+    auto drop = group.join(WsBroadcastMemberConfig{.max_pending = 2, .policy = WsBackpressurePolicy::Drop});
+    auto coalesce = group.join(WsBroadcastMemberConfig{.max_pending = 2, .policy = WsBackpressurePolicy::CoalesceLatest});
+    auto disconnect = group.join(WsBroadcastMemberConfig{.max_pending = 2, .policy = WsBackpressurePolicy::Disconnect});
+    bool ok = check(group.size() == 3, "three members must join");
+
+    std::vector<WsSharedFrame> published;
+    for (int i = 0; i < 5; ++i) {
+        published.push_back(WsSharedFrame::encode(WsOpcode::Text, "m" + std::to_string(i)));
+        group.publish(published.back());
+    }
+    ok &= check(published[0].useCount() == 4, "each of the three queues must hold one reference, not a copy");
+
+    const auto drop_counters = drop.counters();
+    ok &= check(drop_counters.enqueued == 2 && drop_counters.dropped == 3, "drop member must keep the first two");
+    const auto drop_frames = drain(*drop.m_member);
+    ok &= check(drop_frames.size() == 2 && drop_frames[1].bytes() == published[1].bytes(),
+                "drop member must queue frames in publish order");
+
+    const auto coalesce_counters = coalesce.counters();
+    ok &= check(coalesce_counters.coalesced == 2, "coalesce member must overwrite two intermediate frames");
+    const auto coalesce_frames = drain(*coalesce.m_member);
+    ok &= check(coalesce_frames.size() == 3 && coalesce_frames[2].empty(),
+                "coalesce member must queue a single wake marker after the backlog");
+    ok &= check(coalesce.m_member->takeLatest().bytes() == published[4].bytes(),
+                "coalesce member must keep only the latest frame");
+
+    ok &= check(disconnect.counters().disconnected == 1, "disconnect member must overflow once");
+    ok &= check(group.size() == 2, "overflowed member must leave the group");
+
+    const auto counters = group.counters();
+    ok &= check(counters.published == 5 && counters.dropped == 3 && counters.disconnected == 1,
+                "group counters must aggregate member outcomes");
+
+    drop.leave();
+    ok &= check(group.size() == 1 && !drop.valid(), "leave must remove the member");
+    ok &= check(group.publishText("after") == 1, "publish must skip departed members");
+    group.close();
+    ok &= check(!group.join().valid(), "closed group must reject new members");
+    return ok;
+}
+
+Task<bool> pumpOverSocket(WsBroadcastSubscription* subscription, int fd) {
+    AsyncTcpSocket socket(GHandle{fd});
+    auto writer = WsWriter(WsWriterSetting::byServer(), socket);
+    auto result = co_await subscription->pump(writer);
+    co_return result.has_value();
+}
+
+bool testPumpWritesToSocket() {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return check(false, "socketpair failed");
+    }
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    Runtime runtime = RuntimeBuilder().ioSchedulerCount(1).computeSchedulerCount(0).build();
+    if (!runtime.start()) {
+        return check(false, "runtime must start");
+    }
+    WsBroadcastGroup group;
+    auto subscription = group.join(WsBroadcastMemberConfig{.max_pending = 1024});
+    auto handle = runtime.spawn(pumpOverSocket(&subscription, fds[0]));
+    bool ok = check(handle.has_value(), "pump must be spawned");
+
+    std::string expected;
+    for (int i = 0; i < 64; ++i) {
+        const auto frame = WsSharedFrame::encode(WsOpcode::Text, std::string(1024, static_cast<char>('a' + i % 26)));
+        expected.append(frame.bytes());
+        group.publish(frame);
+    }
+
+    std::string received;
+    char buffer[8192];
+    while (received.size() < expected.size()) {
+        const ssize_t n = ::read(fds[1], buffer, sizeof(buffer));
+        if (n <= 0) {
+            break;
+        }
+        received.append(buffer, static_cast<size_t>(n));
+    }
+    ok &= check(received == expected, "pump must write every frame in order");
+
+    subscription.leave();
+    if (handle) {
+        auto joined = handle->join();
+        ok &= check(joined.has_value() && *joined, "pump must finish cleanly after leave");
+    }
+    runtime.stop();
+    ::close(fds[1]);
+    return ok;
+}
+
+bool testPumpWritesOwnFrames() {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return check(false, "socketpair failed");
+    }
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    Runtime runtime = RuntimeBuilder().ioSchedulerCount(1).computeSchedulerCount(0).build();
+    if (!runtime.start()) {
+        return check(false, "runtime must start");
+    }
+    WsBroadcastGroup group;
+    auto subscription = group.join(WsBroadcastMemberConfig{.max_pending = 1, .policy = WsBackpressurePolicy::Drop});
+    auto handle = runtime.spawn(pumpOverSocket(&subscription, fds[0]));
+    bool ok = check(handle.has_value(), "pump must be spawned");
+
+    const auto first = WsSharedFrame::encode(WsOpcode::Text, "tick-1");
+    const auto second = WsSharedFrame::encode(WsOpcode::Text, "tick-2");
+    group.publish(first);
+    ok &= check(subscription.sendPong("hb"), "pong must be queued while the pump owns the writer");
+    ok &= check(!subscription.sendPong(std::string(126, 'x')), "oversized control payload must be rejected");
+    ok &= check(subscription.sendText("reply"), "reply must bypass the pending limit");
+    ok &= check(subscription.pending() <= 1, "own frames must not count against max_pending");
+    ok &= check(subscription.sendClose(WsCloseCode::Normal, "bye"), "close must be queued");
+    ok &= check(!subscription.valid() && group.size() == 0, "sendClose must leave the group");
+    group.publish(second);
+
+    std::string expected(first.bytes());
+    expected.append(WsFrameParser::toBytes(WsFrameParser::createPongFrame("hb"), false));
+    expected.append(WsFrameParser::toBytes(WsFrameParser::createTextFrame("reply"), false));
+    expected.append(WsFrameParser::toBytes(WsFrameParser::createCloseFrame(WsCloseCode::Normal, "bye"), false));
+
+    if (handle) {
+        auto joined = handle->join();
+        ok &= check(joined.has_value() && *joined, "pump must finish cleanly after writing the close frame");
+    }
+    std::string received;
+    char buffer[1024];
+    ::fcntl(fds[1], F_SETFL, ::fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+    while (true) {
+        const ssize_t n = ::read(fds[1], buffer, sizeof(buffer));
+        if (n <= 0) {
+            break;
+        }
+        received.append(buffer, static_cast<size_t>(n));
+    }
+    ok &= check(received == expected, "own frames must follow earlier broadcasts and stop at the close frame");
+    runtime.stop();
+    ::close(fds[1]);
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    bool ok = testSharedFrameEncoding();
+    ok &= testWriterSharedBatch();
+    ok &= testBackpressurePolicies();
+    ok &= testPumpWritesToSocket();
+    ok &= testPumpWritesOwnFrames();
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "T12-WsBroadcast PASS\n";
+    return 0;
+}
@@ -0,0 +1,361 @@
+/**
+ * @file t13_ws_utf8_validator.cc
+ * @brief 用途：验证流式 UTF-8 校验器在各内核下与逐码点参考实现一致，并能跨分片增量校验。
+ * 关键覆盖点：过长编码、代理区、超出 U+10FFFF、截断序列、C0/C1/F5+ 首字节等边界向量；
+ * 随机混合输入在标量 / SSE4 / AVX2 / NEON 内核上的判定一致；任意位置切分后 feed 与一次性校验一致；
+ * 带掩码 feed 的掩码偏移；iovec 在码点中间切开；WsMessageReadState 对跨帧码点放行、
+ * 对中间分片的非法字节在 FIN 到达前报错。
+ * 通过条件：所有断言成立并输出 PASS；CPU 不支持的内核跳过。
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <galay/cpp/galay-ws/protoc/ws_frame.h>
+#include <galay/cpp/galay-ws/protoc/ws_utf8.h>
+#include <galay/cpp/galay-ws/utils/ws_helper.h>
+#include <galay/cpp/galay-utils/cache/ring_buffer.hpp>
+#include <galay/cpp/galay-ws/kernel/ws_reader.h>
+#include "test/cpp/common/test_require.h"
+
+using galay::utils::RingBuffer;
+using namespace galay::websocket;
+
+namespace {
+
+using Ring = RingBuffer<galay::utils::RingBufferBackendStrategy::Mmap, std::dynamic_extent>;
+
+constexpr WsUtf8Kernel kKernels[] = {
+    WsUtf8Kernel::Scalar, WsUtf8Kernel::Sse4, WsUtf8Kernel::Avx2, WsUtf8Kernel::Neon,
+};
+
+// 逐码点解码的参考实现，与被测的查表法无共享代码
+bool referenceValid(std::string_view text)
+{
+    size_t i = 0;
+    while (i < text.size()) {
+        const uint8_t lead = static_cast<uint8_t>(text[i]);
+        uint32_t codepoint = 0;
+        size_t trailing = 0;
+        if (lead < 0x80) {
+            ++i;
+            continue;
+        } else if ((lead & 0xE0) == 0xC0) {
+            trailing = 1;
+            codepoint = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            trailing = 2;
+            codepoint = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            trailing = 3;
+            codepoint = lead & 0x07;
+        } else {
+            return false;
+        }
+        if (i + trailing >= text.size()) {
+            return false;
+        }
+        for (size_t k = 1; k <= trailing; ++k) {
+            const uint8_t byte = static_cast<uint8_t>(text[i + k]);
+            if ((byte & 0xC0) != 0x80) {
+                return false;
+            }
+            codepoint = (codepoint << 6) | (byte & 0x3F);
+        }
+        const uint32_t minimum = trailing == 1 ? 0x80 : (trailing == 2 ? 0x800 : 0x10000);
+        if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+            return false;
+        }
+        i += trailing + 1;
+    }
+    return true;
+}
+
+void appendCodepoint(std::string& out, uint32_t codepoint)
+{
+    if (codepoint < 0x80) {
+        out.push_back(static_cast<char>(codepoint));
+    } else if (codepoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else if (codepoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    }
+}
+
+// ASCII 长串、各长度码点与少量随机字节混合，覆盖向量块内、块边界与标量尾部
+std::string randomText(std::mt19937& rng, size_t target, bool allow_garbage)
+{
+    std::string out;
+    while (out.size() < target) {
+        const uint32_t pick = rng() % 100;
+        if (pick < 40) {
+            out.append(rng() % 80, static_cast<char>('a' + rng() % 26));
+        } else if (pick < 60) {
+            appendCodepoint(out, 0x80 + rng() % (0x800 - 0x80));
+        } else if (pick < 80) {
+            uint32_t codepoint = 0x800 + rng() % (0x10000 - 0x800);
+            if (codepoint >= 0xD800 && codepoint <= 0xDFFF) {
+                codepoint -= 0x800;
+            }
+            appendCodepoint(out, codepoint);
+        } else if (pick < 95 || !allow_garbage) {
+            appendCodepoint(out, 0x10000 + rng() % (0x110000 - 0x10000));
+        } else {
+            out.push_back(static_cast<char>(0x80 + rng() % 0x80));
+        }
+    }
+    return out;
+}
+
+bool feedInPieces(std::string_view text, const std::vector<size_t>& cuts)
+{
+    WsUtf8Validator validator;
+    size_t begin = 0;
+    for (size_t cut : cuts) {
+        validator.feed(text.data() + begin, cut - begin);
+        begin = cut;
+    }
+    validator.feed(text.data() + begin, text.size() - begin);
+    return validator.finish();
+}
+
+bool testEdgeVectors()
+{
+    const std::vector<std::string> vectors = {
+        "",
+        "plain ascii",
+        "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",
+        "\xED\x9F\xBF", "\xEE\x80\x80",
+        "\xC0\x80", "\xC1\xBF",                     // 过长的 2 字节
+        "\xE0\x80\x80", "\xE0\x9F\xBF",             // 过长的 3 字节
+        "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",     // 过长的 4 字节
+        "\xED\xA0\x80", "\xED\xBF\xBF",             // 代理区
+        "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF",
+        "\x80", "\xBF", "\xC2", "\xE4\xB8", "\xF0\x9F\x98",   // 孤立续字节 / 截断
+        "\xC2\x41", "\xE4\x41\xAD", "\xE4\xB8\x41", "\xF0\x9F\x41\x80",
+        "\xC2\x80\x80", "\xE4\xB8\xAD\x80",
+    };
+
+    std::vector<std::string> cases;
+    for (const auto& vector : vectors) {
+        cases.push_back(vector);
+        // 放到向量块内部与块边界两侧，确认前后邻块不会掩盖错误
+        for (size_t pad : {13, 14, 15, 16, 30, 31, 32, 61, 62, 63, 64, 127}) {
+            std::string padded(pad, 'x');
+            padded += vector;
+            padded.append(70, 'y');
+            cases.push_back(padded);
+            cases.push_back(std::string(pad, 'x') + vector);
+            cases.push_back(std::string(pad, 'x') + "\xE4\xB8\xAD" + vector + std::string(64, 'z'));
+        }
+    }
+
+    for (WsUtf8Kernel kernel : kKernels) {
+        if (!setWsUtf8Kernel(kernel)) {
+            continue;
+        }
+        for (const auto& text : cases) {
+            if (WsUtf8Validator::validate(text.data(), text.size()) != referenceValid(text)) {
+                std::cerr << "[T13] kernel=" << wsUtf8KernelName(kernel) << " size=" << text.size() << '\n';
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool testRandomAgainstReference()
+{
+    std::mt19937 rng(20261017);
+    for (WsUtf8Kernel kernel : kKernels) {
+        if (!setWsUtf8Kernel(kernel)) {
+            continue;
+        }
+        for (size_t round = 0; round < 3000; ++round) {
+            const size_t target = round % 10 == 0 ? 1 + rng() % 4096 : rng() % 300;
+            const std::string text = randomText(rng, target, round % 2 == 1);
+            const bool expected = referenceValid(text);
+            GALAY_TEST_REQUIRE(WsUtf8Validator::validate(text.data(), text.size()) == expected);
+
+            std::vector<size_t> cuts;
+            size_t cursor = 0;
+            while (!text.empty() && cursor < text.size()) {
+                cursor += 1 + rng() % 97;
+                if (cursor < text.size()) {
+                    cuts.push_back(cursor);
+                }
+            }
+            GALAY_TEST_REQUIRE(feedInPieces(text, cuts) == expected);
+        }
+    }
+    return true;
+}
+
+bool testEverySplit()
+{
+    std::string text = "price 价格 \xF0\x9F\x93\x88 ok ";
+    while (text.size() < 200) {
+        text += "数据 data \xC3\xA9t\xC3\xA9 ";
+    }
+    std::string broken = text;
+    broken[150] = static_cast<char>(0xC0);
+
+    for (WsUtf8Kernel kernel : kKernels) {
+        if (!setWsUtf8Kernel(kernel)) {
+            continue;
+        }
+        for (size_t cut = 0; cut <= text.size(); ++cut) {
+            GALAY_TEST_REQUIRE(feedInPieces(text, {cut}));
+            GALAY_TEST_REQUIRE(!feedInPieces(broken, {cut}));
+            // 逐字节喂入前半段，再整段喂入后半段
+            std::vector<size_t> cuts;
+            for (size_t i = 1; i <= cut && i < text.size(); ++i) {
+                cuts.push_back(i);
+            }
+            GALAY_TEST_REQUIRE(feedInPieces(text, cuts));
+        }
+    }
+
+    // 不可能合法的前缀立即失败，未完成码点只在 finish 时失败
+    WsUtf8Validator validator;
+    GALAY_TEST_REQUIRE(validator.feed("ab\xED", 3) && validator.pendingBytes() == 1);
+    GALAY_TEST_REQUIRE(!validator.feed("\xA0", 1) && !validator.valid());
+    GALAY_TEST_REQUIRE(!validator.feed("a", 1));
+    validator.reset();
+    GALAY_TEST_REQUIRE(validator.feed("\xF0\x9F", 2) && !validator.finish());
+    GALAY_TEST_REQUIRE(validator.feed("\x98\x80", 2) && validator.finish());
+    return true;
+}
+
+bool testMasked()
+{
+    const uint8_t key[4] = {0x37, 0xFA, 0x21, 0x3D};
+    std::mt19937 rng(7);
+    for (size_t round = 0; round < 200; ++round) {
+        const std::string text = randomText(rng, 1 + rng() % 1500, round % 3 == 0);
+        std::string masked = text;
+        WsFrameParser::applyMaskBytes(masked.data(), masked.size(), key);
+        const bool expected = referenceValid(text);
+
+        GALAY_TEST_REQUIRE(WsFrameParser::isValidUtf8MaskedBytes(masked.data(), masked.size(), key) == expected);
+
+        const size_t cut = rng() % (masked.size() + 1);
+        WsUtf8Validator validator;
+        validator.feedMasked(masked.data(), cut, key, 0);
+        validator.feedMasked(masked.data() + cut, masked.size() - cut, key, cut);
+        GALAY_TEST_REQUIRE(validator.finish() == expected);
+
+        // RingBuffer 回绕：负载分成两个 iovec
+        iovec iovecs[2] = {
+            {masked.data(), cut},
+            {masked.data() + cut, masked.size() - cut},
+        };
+        GALAY_TEST_REQUIRE(galay::websocket::detail::wsIsValidUtf8MaskedIovecs(iovecs, 2, key) == expected);
+    }
+    return true;
+}
+
+std::string encodeFrame(WsOpcode opcode, std::string_view payload, bool fin)
+{
+    uint8_t key[4] = {0x11, 0x22, 0x33, 0x44};
+    std::string out;
+    appendWsFrameHeader(out, opcode, fin, false, false, false, payload.size(), true, key);
+    const size_t offset = out.size();
+    out.append(payload);
+    WsFrameParser::applyMaskBytes(out.data() + offset, payload.size(), key);
+    return out;
+}
+
+bool testReader(bool fast_path)
+{
+    WsReaderSetting setting;
+    setting.max_frame_size = 1 << 20;
+    setting.max_message_size = 1 << 20;
+
+    // "中文" 的第一个码点在两帧之间切开，第二个码点的首字节落在第二帧末尾
+    const std::string text = "hello \xE4\xB8\xAD\xE6\x96\x87 world";
+    Ring ring(4096);
+    std::string buffered = encodeFrame(WsOpcode::Text, std::string_view(text).substr(0, 7), false);
+    buffered += encodeFrame(WsOpcode::Continuation, std::string_view(text).substr(7, 3), false);
+    buffered += encodeFrame(WsOpcode::Continuation, std::string_view(text).substr(10), true);
+    buffered += encodeFrame(WsOpcode::Text, "\xF0\x9F\x98\x80", true);
+    GALAY_TEST_REQUIRE(ring.tryWriteBatch(buffered.data(), buffered.size()) == buffered.size());
+
+    std::string message;
+    WsOpcode opcode = WsOpcode::Close;
+    galay::websocket::detail::WsMessageReadState state(
+        ring, setting, message, opcode, true, false, nullptr, fast_path);
+    GALAY_TEST_REQUIRE(state.parseFromBuffer() && state.takeResult());
+    GALAY_TEST_REQUIRE(opcode == WsOpcode::Text && message == text);
+    state.resetForNextMessage();
+    GALAY_TEST_REQUIRE(state.parseFromBuffer() && state.takeResult());
+    GALAY_TEST_REQUIRE(message == "\xF0\x9F\x98\x80");
+    GALAY_TEST_REQUIRE(ring.readable() == 0);
+
+    // 中间分片含非法字节：不等 FIN 帧到达就报错
+    {
+        Ring bad_ring(4096);
+        std::string frames = encodeFrame(WsOpcode::Text, "ok \xE4\xB8", false);
+        frames += encodeFrame(WsOpcode::Continuation, "\x41 tail", false);
+        GALAY_TEST_REQUIRE(bad_ring.tryWriteBatch(frames.data(), frames.size()) == frames.size());
+        galay::websocket::detail::WsMessageReadState bad(
+            bad_ring, setting, message, opcode, true, false, nullptr, fast_path);
+        GALAY_TEST_REQUIRE(bad.parseFromBuffer());
+        auto result = bad.takeResult();
+        GALAY_TEST_REQUIRE(!result && result.error().code() == kWsInvalidUtf8);
+    }
+
+    // FIN 时仍有未完成码点
+    {
+        Ring cut_ring(4096);
+        std::string frames = encodeFrame(WsOpcode::Text, "abc\xE4", false);
+        frames += encodeFrame(WsOpcode::Continuation, "\xB8", true);
+        GALAY_TEST_REQUIRE(cut_ring.tryWriteBatch(frames.data(), frames.size()) == frames.size());
+        galay::websocket::detail::WsMessageReadState cut(
+            cut_ring, setting, message, opcode, true, false, nullptr, fast_path);
+        GALAY_TEST_REQUIRE(cut.parseFromBuffer());
+        auto result = cut.takeResult();
+        GALAY_TEST_REQUIRE(!result && result.error().code() == kWsInvalidUtf8);
+    }
+
+    // 二进制消息不做 UTF-8 校验
+    {
+        Ring binary_ring(4096);
+        std::string frames = encodeFrame(WsOpcode::Binary, "\xFF\xFE", false);
+        frames += encodeFrame(WsOpcode::Continuation, "\xC0", true);
+        GALAY_TEST_REQUIRE(binary_ring.tryWriteBatch(frames.data(), frames.size()) == frames.size());
+        galay::websocket::detail::WsMessageReadState binary(
+            binary_ring, setting, message, opcode, true, false, nullptr, fast_path);
+        GALAY_TEST_REQUIRE(binary.parseFromBuffer() && binary.takeResult());
+        GALAY_TEST_REQUIRE(opcode == WsOpcode::Binary && message == "\xFF\xFE\xC0");
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    const WsUtf8Kernel detected = activeWsUtf8Kernel();
+    const bool ok = testEdgeVectors() && testRandomAgainstReference() && testEverySplit() && testMasked();
+    setWsUtf8Kernel(detected);
+    if (!ok || !testReader(true) || !testReader(false)) {
+        return 1;
+    }
+    std::cout << "T13-WsUtf8Validator PASS kernel=" << wsUtf8KernelName(detected) << '\n';
+    return 0;
+}
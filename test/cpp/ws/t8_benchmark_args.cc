@@ -53,5 +53,12 @@ int main()
     char* invalid_argv[] = {arg0, clients, duration, nodelay_invalid};
     assert(galay::benchmark::ws::resolveBenchmarkServerNoDelay(4, invalid_argv, 3));
 
+    // permessage-deflate 开关默认关闭，只有明确开启时才协商
+    assert(!galay::benchmark::ws::resolveBenchmarkServerDeflate(4, default_argv, 4));
+    assert(!galay::benchmark::ws::resolveBenchmarkServerDeflate(4, off_argv, 3));
+    assert(!galay::benchmark::ws::resolveBenchmarkServerDeflate(4, invalid_argv, 3));
+    assert(galay::benchmark::ws::resolveBenchmarkServerDeflate(4, on_argv, 3));
+    assert(galay::benchmark::ws::resolveBenchmarkServerDeflate(4, one_argv, 3));
+
     return 0;
 }